@@ -19,17 +19,19 @@ namespace common {
 
 const char* ObStoreFormat::row_store_name[MAX_ROW_STORE] = {
     "flat_row_store",
-    "reserved_row_store",
+    "encoding_row_store",
     "sparse_row_store",
 };
 
+const char* ObStoreFormat::LEGACY_ENCODING_ROW_STORE_NAME = "reserved_row_store";
+
 const ObStoreFormatItem ObStoreFormat::store_format_items[OB_STORE_FORMAT_MAX] = {
     {"", "", "", FLAT_ROW_STORE},  // OB_STORE_FORMAT_INVALID
     // mysql mode
     {"REDUNDANT", "ROW_FORMAT = REDUNDANT", "", FLAT_ROW_STORE},
     {"COMPACT", "ROW_FORMAT = COMPACT", "", FLAT_ROW_STORE},
-    {"DYNAMIC", "ROW_FORMAT = DYNAMIC", "", RESERVED_ROW_STORE},
-    {"COMPRESSED", "ROW_FORMAT = COMPRESSED", "", RESERVED_ROW_STORE},
+    {"DYNAMIC", "ROW_FORMAT = DYNAMIC", "", ENCODING_ROW_STORE},
+    {"COMPRESSED", "ROW_FORMAT = COMPRESSED", "", ENCODING_ROW_STORE},
     {"", "", "", MAX_ROW_STORE},  // reserved for mysql furture
     {"", "", "", MAX_ROW_STORE},  // reserved for mysql furture
     {"", "", "", MAX_ROW_STORE},  // reserved for mysql furture
@@ -40,8 +42,8 @@ const ObStoreFormatItem ObStoreFormat::store_format_items[OB_STORE_FORMAT_MAX] =
     {"NOCOMPRESS", "NOCOMPRESS", "none", FLAT_ROW_STORE},
     {"BASIC", "COMPRESS BASIC", "lz4_1.0", FLAT_ROW_STORE},
     {"OLTP", "COMPRESS FOR OLTP", "zstd_1.3.8", FLAT_ROW_STORE},
-    {"QUERY", "COMPRESS FOR QUERY", "", RESERVED_ROW_STORE},
-    {"ARCHIVE", "COMPRESS FOR ARCHIVE", "", RESERVED_ROW_STORE},
+    {"QUERY", "COMPRESS FOR QUERY", "", ENCODING_ROW_STORE},
+    {"ARCHIVE", "COMPRESS FOR ARCHIVE", "", ENCODING_ROW_STORE},
 };
 
 int ObStoreFormat::find_row_store_type(const ObString& row_store, ObRowStoreType& row_store_type)
@@ -58,6 +60,9 @@ int ObStoreFormat::find_row_store_type(const ObString& row_store, ObRowStoreType
         row_store_type = static_cast<ObRowStoreType>(i);
       }
     }
+    if (!is_row_store_type_valid(row_store_type) && 0 == row_store.case_compare(LEGACY_ENCODING_ROW_STORE_NAME)) {
+      row_store_type = ENCODING_ROW_STORE;
+    }
     if (!is_row_store_type_valid(row_store_type)) {
       ret = OB_ERR_UNEXPECTED;
       LOG_ERROR("Unexpected row store type", K(row_store_type), K(row_store), K(ret));
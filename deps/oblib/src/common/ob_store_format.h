@@ -20,7 +20,8 @@
 namespace oceanbase {
 namespace common {
 
-enum ObRowStoreType { FLAT_ROW_STORE = 0, RESERVED_ROW_STORE = 1, SPARSE_ROW_STORE = 2, MAX_ROW_STORE };
+// ENCODING_ROW_STORE: columnar encoded micro block, only used by major sstable.
+enum ObRowStoreType { FLAT_ROW_STORE = 0, ENCODING_ROW_STORE = 1, SPARSE_ROW_STORE = 2, MAX_ROW_STORE };
 
 enum ObStoreFormatType {
   OB_STORE_FORMAT_INVALID = 0,
@@ -59,7 +60,7 @@ private:
 public:
   static inline bool is_row_store_type_valid(const ObRowStoreType type)
   {
-    return type == FLAT_ROW_STORE || type == SPARSE_ROW_STORE;
+    return type == FLAT_ROW_STORE || type == ENCODING_ROW_STORE || type == SPARSE_ROW_STORE;
   }
   static inline const char* get_row_store_name(const ObRowStoreType type)
   {
@@ -114,6 +115,8 @@ public:
 private:
   static const ObStoreFormatItem store_format_items[OB_STORE_FORMAT_MAX];
   static const char* row_store_name[MAX_ROW_STORE];
+  // name of ENCODING_ROW_STORE before it was implemented, may be persisted in schema already.
+  static const char* LEGACY_ENCODING_ROW_STORE_NAME;
 };
 
 }  // end namespace common
@@ -60,6 +60,19 @@ public:
     return ret;
   }
 
+  // Iterate batch interface for sql static typing engine vectorized execution, the i-th row is
+  // projected to the i-th datum of the batch result expressions. At most %capacity rows are
+  // iterated, less than %capacity rows are iterated only at the end of iteration.
+  // OB_ITER_END is returned if no row iterated.
+  virtual int get_next_rows(int64_t& count, int64_t capacity)
+  {
+    UNUSED(count);
+    UNUSED(capacity);
+    int ret = common::OB_NOT_IMPLEMENT;
+    COMMON_LOG(WARN, "interface not implement", K(ret));
+    return ret;
+  }
+
   /// rewind the iterator
   virtual void reset() = 0;
   TO_STRING_EMPTY();
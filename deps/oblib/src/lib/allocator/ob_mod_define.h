@@ -909,6 +909,8 @@ LABEL_ITEM_DEF(OB_TMP_BLOCK_MANAGER, TmpBlockManager)
 LABEL_ITEM_DEF(OB_TMP_MAP, TmpMap)
 LABEL_ITEM_DEF(OB_TMP_PAGE_CACHE, TmpPageCache)
 LABEL_ITEM_DEF(OB_TMP_BLOCK_CACHE, TmpBlockCache)
+LABEL_ITEM_DEF(OB_SECONDARY_BLOCK_CACHE, SecBlockCache)
+LABEL_ITEM_DEF(OB_BLOCK_CACHE_SNAPSHOT, BlkCacheSnap)
 LABEL_ITEM_DEF(OB_SSTABLE_CREATE_INDEX, SstablCreatInde)
 LABEL_ITEM_DEF(OB_SSTABLE_LONG_OPS_MONITOR, SstaLongOpsMoni)
 LABEL_ITEM_DEF(OB_INTERM_MACRO_MGR, IntermMacroMgr)
@@ -385,7 +385,28 @@ bool ObIOQueue::ObIORequestCmp::operator()(const ObIORequest* a, const ObIOReque
 /**
  * ------------------------------------- ObIOChannel ------------------------------------
  */
-ObIOChannel::ObIOChannel() : inited_(false), context_(), submit_cnt_(0), can_submit_request_(true)
+void ObIOEngineOption::reset()
+{
+  type_ = IO_ENGINE_LIBAIO;
+  enable_sqpoll_ = false;
+  MEMSET(fixed_bufs_, 0, sizeof(fixed_bufs_));
+  fixed_buf_cnt_ = 0;
+}
+
+bool ObIOEngineOption::is_valid() const
+{
+  return type_ >= IO_ENGINE_LIBAIO && type_ < IO_ENGINE_MAX && fixed_buf_cnt_ >= 0 &&
+         fixed_buf_cnt_ <= ObIOUring::MAX_FIXED_BUFFER_CNT;
+}
+
+ObIOChannel::ObIOChannel()
+    : inited_(false),
+      engine_type_(IO_ENGINE_LIBAIO),
+      context_(),
+      ring_(),
+      sq_lock_(),
+      submit_cnt_(0),
+      can_submit_request_(true)
 {}
 
 ObIOChannel::~ObIOChannel()
@@ -393,26 +414,34 @@ ObIOChannel::~ObIOChannel()
   destroy();
 }
 
-int ObIOChannel::init(const int32_t queue_depth)
+int ObIOChannel::init(const int32_t queue_depth, const ObIOEngineOption& engine_option)
 {
   int ret = OB_SUCCESS;
+  int tmp_ret = OB_SUCCESS;
   int io_ret = 0;
   if (inited_) {
     ret = OB_INIT_TWICE;
     COMMON_LOG(WARN, "The ObIOChannel has been inited, ", K(ret));
-  } else if (queue_depth <= 0) {
+  } else if (queue_depth <= 0 || !engine_option.is_valid()) {
     ret = OB_INVALID_ARGUMENT;
-    COMMON_LOG(WARN, "invalid argument", K(ret), K(queue_depth));
+    COMMON_LOG(WARN, "invalid argument", K(ret), K(queue_depth), K(engine_option));
   } else if (OB_FAIL(queue_cond_.init(ObWaitEventIds::IO_QUEUE_LOCK_WAIT))) {
     COMMON_LOG(WARN, "Fail to init queue condition, ", K(ret));
   } else if (OB_FAIL(queue_.init(queue_depth))) {
     COMMON_LOG(WARN, "Fail to init io queue, ", K(ret));
   } else {
-    MEMSET(&context_, 0, sizeof(context_));
-    if (0 != (io_ret = ob_io_setup(MAX_AIO_EVENT_CNT, &context_))) {
-      ret = OB_IO_ERROR;
-      COMMON_LOG(ERROR, "Fail to setup io context, check config aio-max-nr of operating system", K(ret), K(io_ret));
-    } else {
+    engine_type_ = IO_ENGINE_LIBAIO;
+    if (IO_ENGINE_IO_URING == engine_option.type_ && OB_SUCCESS != (tmp_ret = init_io_uring(engine_option))) {
+      COMMON_LOG(WARN, "Fail to init io_uring, use libaio instead", K(tmp_ret), K(engine_option));
+    }
+    if (IO_ENGINE_LIBAIO == engine_type_) {
+      MEMSET(&context_, 0, sizeof(context_));
+      if (0 != (io_ret = ob_io_setup(MAX_AIO_EVENT_CNT, &context_))) {
+        ret = OB_IO_ERROR;
+        COMMON_LOG(ERROR, "Fail to setup io context, check config aio-max-nr of operating system", K(ret), K(io_ret));
+      }
+    }
+    if (OB_SUCC(ret)) {
       submit_cnt_ = 0;
       can_submit_request_ = true;
       inited_ = true;
@@ -425,10 +454,39 @@ int ObIOChannel::init(const int32_t queue_depth)
   return ret;
 }
 
+int ObIOChannel::init_io_uring(const ObIOEngineOption& engine_option)
+{
+  int ret = OB_SUCCESS;
+  int tmp_ret = OB_SUCCESS;
+  if (OB_FAIL(ring_.init(MAX_AIO_EVENT_CNT, engine_option.enable_sqpoll_))) {
+    if (engine_option.enable_sqpoll_) {
+      // sq polling needs CAP_SYS_NICE before linux 5.11, try again without it
+      COMMON_LOG(WARN, "Fail to init io_uring with sq polling, retry without it", K(ret));
+      ring_.destroy();
+      ret = ring_.init(MAX_AIO_EVENT_CNT, false);
+    }
+  }
+  if (OB_FAIL(ret)) {
+    ring_.destroy();
+  } else {
+    if (engine_option.fixed_buf_cnt_ > 0 &&
+        OB_SUCCESS != (tmp_ret = ring_.register_buffers(engine_option.fixed_bufs_, engine_option.fixed_buf_cnt_))) {
+      // fixed buffers only save the page mapping of each io, not necessary
+      COMMON_LOG(WARN, "Fail to register fixed buffers, check RLIMIT_MEMLOCK", K(tmp_ret), K(engine_option));
+    }
+    engine_type_ = IO_ENGINE_IO_URING;
+  }
+  return ret;
+}
+
 void ObIOChannel::destroy()
 {
-  ob_io_destroy(context_);
+  if (IO_ENGINE_LIBAIO == engine_type_) {
+    ob_io_destroy(context_);
+  }
   MEMSET(&context_, 0, sizeof(context_));
+  ring_.destroy();
+  engine_type_ = IO_ENGINE_LIBAIO;
   submit_cnt_ = 0;
   can_submit_request_ = false;
   queue_cond_.destroy();
@@ -523,6 +581,20 @@ int64_t ObIOChannel::get_pop_wait_timeout(const int64_t queue_deadline)
   return wait_us;
 }
 
+int ObIOChannel::try_dequeue_request(const int64_t dequeued_cnt, ObIORequest*& req)
+{
+  int ret = OB_SUCCESS;
+  ObThreadCondGuard cond_guard(queue_cond_);
+  if (OB_FAIL(cond_guard.get_ret())) {
+    COMMON_LOG(ERROR, "Fail to guard queue condition", K(ret));
+  } else if (ATOMIC_LOAD(&submit_cnt_) + dequeued_cnt >= MAX_AIO_EVENT_CNT) {
+    ret = OB_EAGAIN;
+  } else {
+    ret = queue_.pop(req);
+  }
+  return ret;
+}
+
 int ObIOChannel::clear_all_requests()
 {
   int ret = OB_SUCCESS;
@@ -570,6 +642,8 @@ void ObIOChannel::submit()
     if (OB_SUCC(ret) && !can_submit_request_) {
       clear_all_requests();
     }
+  } else if (IO_ENGINE_IO_URING == engine_type_) {
+    submit_batch();
   } else {
     if (OB_FAIL(dequeue_request(req))) {
       if (OB_EAGAIN == ret || OB_ENTRY_NOT_EXIST == ret) {
@@ -581,22 +655,82 @@ void ObIOChannel::submit()
       ret = OB_ERR_UNEXPECTED;
       COMMON_LOG(WARN, "req is null", K(ret));
     } else {
-      MasterHolder master_holder(req->master_);
-      DiskHolder disk_holder(req->get_disk());
-      ObCurTraceId::TraceId saved_trace_id = *ObCurTraceId::get_trace_id();
-      ObCurTraceId::set(req->master_->get_trace_id());
-      req->channel_ = this;
-      int sys_ret = 0;
-      if (OB_FAIL(inner_submit(*req, sys_ret))) {
-        if (OB_CANCELED != ret) {
-          COMMON_LOG(WARN, "fail to inner submit req", K(ret), K(sys_ret));
-        }
-        req->finish(ret, sys_ret);
+      submit_one(*req);
+    }
+  }
+}
+
+void ObIOChannel::submit_one(ObIORequest& req)
+{
+  int ret = OB_SUCCESS;
+  MasterHolder master_holder(req.master_);
+  DiskHolder disk_holder(req.get_disk());
+  ObCurTraceId::TraceId saved_trace_id = *ObCurTraceId::get_trace_id();
+  ObCurTraceId::set(req.master_->get_trace_id());
+  req.channel_ = this;
+  int sys_ret = 0;
+  if (OB_FAIL(inner_submit(req, sys_ret))) {
+    if (OB_CANCELED != ret) {
+      COMMON_LOG(WARN, "fail to inner submit req", K(ret), K(sys_ret));
+    }
+    req.finish(ret, sys_ret);
+  } else {
+    req.get_disk()->inc_ref();  // safe only under disk holder
+  }
+  ObCurTraceId::set(saved_trace_id);
+}
+
+// Dequeue at most MAX_URING_SUBMIT_BATCH requests and submit them to io_uring by one system call.
+void ObIOChannel::submit_batch()
+{
+  int ret = OB_SUCCESS;
+  ObIORequest* reqs[MAX_URING_SUBMIT_BATCH];
+  ObIORequest* req = NULL;
+  int64_t req_cnt = 0;
+
+  if (ring_.get_pending_cnt() > 0) {
+    // left by the failed submission of last round
+    ObSpinLockGuard guard(sq_lock_);
+    flush_uring_requests();
+  }
+  // only the first request waits for the deadline of the queue
+  if (OB_FAIL(dequeue_request(req))) {
+    if (OB_EAGAIN == ret || OB_ENTRY_NOT_EXIST == ret) {
+      ret = OB_SUCCESS;
+    } else {
+      COMMON_LOG(WARN, "Fail to pop io request from disk, ", K(ret));
+    }
+  } else {
+    reqs[req_cnt++] = req;
+    while (req_cnt < MAX_URING_SUBMIT_BATCH && OB_SUCC(try_dequeue_request(req_cnt, req))) {
+      reqs[req_cnt++] = req;
+    }
+  }
+  if (req_cnt > 0) {
+    ObSpinLockGuard guard(sq_lock_);
+    for (int64_t i = 0; i < req_cnt; ++i) {
+      if (OB_ISNULL(reqs[i])) {
+        ret = OB_ERR_UNEXPECTED;
+        COMMON_LOG(WARN, "req is null", K(ret), K(i));
       } else {
-        req->get_disk()->inc_ref();  // safe only under disk holder
+        submit_one(*reqs[i]);
       }
-      ObCurTraceId::set(saved_trace_id);
     }
+    flush_uring_requests();
+  }
+}
+
+// Caller must hold sq_lock_.
+void ObIOChannel::flush_uring_requests()
+{
+  int ret = OB_SUCCESS;
+  int64_t submitted = 0;
+  if (OB_FAIL(ring_.submit(submitted))) {
+    if (OB_EAGAIN != ret && REACH_TIME_INTERVAL(10 * 1000 * 1000)) {
+      COMMON_LOG(ERROR, "Fail to submit io_uring requests", K(ret), K_(ring), K_(submit_cnt));
+    }
+  } else {
+    COMMON_LOG(DEBUG, "Success to submit io_uring requests", K(submitted), K_(submit_cnt));
   }
 }
 
@@ -623,7 +757,18 @@ int ObIOChannel::inner_submit(ObIORequest& req, int& sys_ret)
       ATOMIC_INC(&submit_cnt_);
 
       struct iocb* iocbp = &(req.iocb_);
-      if (1 != (sys_ret = ob_io_submit(context_, 1, &iocbp))) {
+      if (IO_ENGINE_IO_URING == engine_type_) {
+        // only fill the sqe under sq_lock_, it is passed to kernel by flush_uring_requests()
+        if (OB_FAIL(ring_.prep_rw(IO_CMD_PREAD == iocbp->aio_lio_opcode,
+                iocbp->aio_fildes,
+                iocbp->u.c.buf,
+                static_cast<uint32_t>(iocbp->u.c.nbytes),
+                iocbp->u.c.offset,
+                reinterpret_cast<uint64_t>(&req)))) {
+          sys_ret = OB_EAGAIN == ret ? -EAGAIN : 0;
+          ret = OB_IO_ERROR;
+        }
+      } else if (1 != (sys_ret = ob_io_submit(context_, 1, &iocbp))) {
         ret = OB_IO_ERROR;
       }
 
@@ -643,7 +788,6 @@ void ObIOChannel::get_events()
   int ret = OB_SUCCESS;
   static __thread io_event events[MAX_AIO_EVENT_CNT];
   int32_t event_cnt = 0;
-  int32_t finish_cnt = 0;
   ObIORequest* req = NULL;
   int64_t io_finish_time = 0;
   MEMSET(events, 0, sizeof(events));
@@ -654,12 +798,13 @@ void ObIOChannel::get_events()
   if (OB_UNLIKELY(!inited_)) {
     ret = OB_NOT_INIT;
     COMMON_LOG(WARN, "The ObIOChannel has not been inited, ", K(ret));
+  } else if (IO_ENGINE_IO_URING == engine_type_) {
+    get_uring_events();
   } else {
     event_cnt = ob_io_getevents(context_, 1, MAX_AIO_EVENT_CNT, events, &timeout);
   }
   if (OB_SUCC(ret) && event_cnt > 0) {
     io_finish_time = ObTimeUtility::current_time();
-    finish_cnt = event_cnt;
     for (int64_t i = 0; i < event_cnt; ++i) {
       req = reinterpret_cast<ObIORequest*>(events[i].data);
       if (OB_ISNULL(req)) {
@@ -667,40 +812,7 @@ void ObIOChannel::get_events()
         COMMON_LOG(WARN, "req is null", K(ret));
         continue;
       }
-      const int system_errno = -static_cast<int>(events[i].res);
-      const int32_t complete_size = static_cast<int32_t>(events[i].res);
-      const int32_t res2 = static_cast<int32_t>(events[i].res2);
-
-      req->io_time_.os_return_time_ = io_finish_time;
-      if (0 == res2 && req->io_size_ == complete_size) {  // io full complete
-        COMMON_LOG(DEBUG, "Success to get io event, ", K(*req), K(complete_size), K(res2));
-        finish_flying_req(*req, OB_SUCCESS, 0);
-      } else if (0 == res2 && complete_size > 0 && complete_size < req->io_size_ &&
-                 (0 == complete_size % DIO_READ_ALIGN_SIZE)) {  // io partial complete, retry the left part
-        COMMON_LOG(WARN, "Partial execute io request, ", K(*req), K(complete_size), K(res2));
-        req->io_buf_ = req->io_buf_ + complete_size;
-        req->io_size_ -= complete_size;
-        req->io_offset_ += complete_size;
-
-        if (IO_CMD_PREAD == req->iocb_.aio_lio_opcode) {
-          io_prep_pread(&req->iocb_, req->fd_.fd_, req->io_buf_, req->io_size_, req->io_offset_);
-        } else {
-          io_prep_pwrite(&req->iocb_, req->fd_.fd_, req->io_buf_, req->io_size_, req->io_offset_);
-        }
-        req->iocb_.data = req;
-
-        int sys_ret = 0;
-        if (OB_SUCC(inner_submit(*req, sys_ret))) {
-          --finish_cnt;
-        } else {
-          finish_flying_req(*req, OB_IO_ERROR, sys_ret);
-        }
-      } else {  // io failed
-        // first print error log
-        COMMON_LOG(ERROR, "Fail to execute io request, ", K(*req), K(complete_size), K(res2));
-        // then notify
-        finish_flying_req(*req, OB_IO_ERROR, system_errno);
-      }
+      process_io_event(*req, events[i].res, events[i].res2, io_finish_time);
       ATOMIC_DEC(&submit_cnt_);
     }
   }
@@ -713,6 +825,82 @@ void ObIOChannel::get_events()
   }
 }
 
+void ObIOChannel::get_uring_events()
+{
+  int ret = OB_SUCCESS;
+  static __thread ObIOUringCqe cqes[MAX_AIO_EVENT_CNT];
+  int64_t cqe_cnt = ring_.peek_cqes(cqes, MAX_AIO_EVENT_CNT);
+  if (0 == cqe_cnt) {
+    if (OB_FAIL(ring_.wait_cqe(URING_WAIT_TIMEOUT_MS))) {
+      if (OB_TIMEOUT != ret && REACH_TIME_INTERVAL(10 * 1000 * 1000)) {
+        COMMON_LOG(ERROR, "Fail to wait io_uring completion", K(ret), K_(ring));
+      }
+    } else {
+      cqe_cnt = ring_.peek_cqes(cqes, MAX_AIO_EVENT_CNT);
+    }
+  }
+  if (cqe_cnt > 0) {
+    const int64_t io_finish_time = ObTimeUtility::current_time();
+    for (int64_t i = 0; i < cqe_cnt; ++i) {
+      ObIORequest* req = reinterpret_cast<ObIORequest*>(cqes[i].user_data_);
+      if (OB_ISNULL(req)) {
+        ret = OB_ERR_UNEXPECTED;
+        COMMON_LOG(WARN, "req is null", K(ret));
+      } else {
+        // the result of io_uring is the same as res of libaio, and there is no res2
+        process_io_event(*req, cqes[i].res_, 0, io_finish_time);
+        ATOMIC_DEC(&submit_cnt_);
+      }
+    }
+  }
+}
+
+void ObIOChannel::process_io_event(
+    ObIORequest& req, const int64_t res, const int64_t res2, const int64_t io_finish_time)
+{
+  int ret = OB_SUCCESS;
+  const int system_errno = -static_cast<int>(res);
+  const int32_t complete_size = static_cast<int32_t>(res);
+  const int32_t io_res2 = static_cast<int32_t>(res2);
+
+  req.io_time_.os_return_time_ = io_finish_time;
+  if (0 == io_res2 && req.io_size_ == complete_size) {  // io full complete
+    COMMON_LOG(DEBUG, "Success to get io event, ", K(req), K(complete_size), K(io_res2));
+    finish_flying_req(req, OB_SUCCESS, 0);
+  } else if (0 == io_res2 && complete_size > 0 && complete_size < req.io_size_ &&
+             (0 == complete_size % DIO_READ_ALIGN_SIZE)) {  // io partial complete, retry the left part
+    COMMON_LOG(WARN, "Partial execute io request, ", K(req), K(complete_size), K(io_res2));
+    req.io_buf_ = req.io_buf_ + complete_size;
+    req.io_size_ -= complete_size;
+    req.io_offset_ += complete_size;
+
+    if (IO_CMD_PREAD == req.iocb_.aio_lio_opcode) {
+      io_prep_pread(&req.iocb_, req.fd_.fd_, req.io_buf_, req.io_size_, req.io_offset_);
+    } else {
+      io_prep_pwrite(&req.iocb_, req.fd_.fd_, req.io_buf_, req.io_size_, req.io_offset_);
+    }
+    req.iocb_.data = &req;
+
+    int sys_ret = 0;
+    if (IO_ENGINE_IO_URING == engine_type_) {
+      ObSpinLockGuard guard(sq_lock_);
+      if (OB_SUCC(inner_submit(req, sys_ret))) {
+        flush_uring_requests();
+      }
+    } else {
+      ret = inner_submit(req, sys_ret);
+    }
+    if (OB_FAIL(ret)) {
+      finish_flying_req(req, OB_IO_ERROR, sys_ret);
+    }
+  } else {  // io failed
+    // first print error log
+    COMMON_LOG(ERROR, "Fail to execute io request, ", K(req), K(complete_size), K(io_res2));
+    // then notify
+    finish_flying_req(req, OB_IO_ERROR, system_errno);
+  }
+}
+
 void ObIOChannel::cancel(ObIORequest& req)
 {
   int ret = OB_SUCCESS;
@@ -720,7 +908,8 @@ void ObIOChannel::cancel(ObIORequest& req)
   int sys_ret = 0;
   bool is_cancel = false;
 
-  if (0 != req.io_time_.os_submit_time_ && 0 == req.io_time_.os_return_time_) {
+  // io_uring requests are not canceled, they finish by their completions
+  if (IO_ENGINE_LIBAIO == engine_type_ && 0 != req.io_time_.os_submit_time_ && 0 == req.io_time_.os_return_time_) {
     // Note: here if ob_io_cancel failed (possibly due to kernel not supporting io_cancel),
     // neither we or the get_events thread would call control.callback_->process(),
     // as we previously set need_callback to false.
@@ -33,6 +33,7 @@
 #include "lib/container/ob_array.h"
 #include "lib/container/ob_array_wrap.h"
 #include "lib/worker.h"
+#include "lib/io/ob_io_uring.h"
 
 namespace oceanbase {
 namespace common {
@@ -339,11 +340,29 @@ private:
   bool inited_;
 };
 
+struct ObIOEngineOption {
+public:
+  ObIOEngineOption()
+  {
+    reset();
+  }
+  void reset();
+  bool is_valid() const;
+  TO_STRING_KV("type", get_io_engine_name(type_), K_(enable_sqpoll), K_(fixed_buf_cnt));
+
+public:
+  ObIOEngineType type_;
+  bool enable_sqpoll_;
+  // memory regions registered to io_uring, io buffers inside them are read/written by READ_FIXED/WRITE_FIXED
+  struct iovec fixed_bufs_[ObIOUring::MAX_FIXED_BUFFER_CNT];
+  int64_t fixed_buf_cnt_;
+};
+
 class ObIOChannel {
 public:
   ObIOChannel();
   virtual ~ObIOChannel();
-  int init(const int32_t queue_depth);
+  int init(const int32_t queue_depth, const ObIOEngineOption& engine_option = ObIOEngineOption());
   void destroy();
   int enqueue_request(ObIORequest& req);
   int dequeue_request(ObIORequest*& req);
@@ -355,9 +374,20 @@ public:
   {
     can_submit_request_ = false;
   }
-  TO_STRING_KV(K_(inited), K_(submit_cnt), K_(can_submit_request));
+  ObIOEngineType get_engine_type() const
+  {
+    return engine_type_;
+  }
+  TO_STRING_KV(K_(inited), "engine_type", get_io_engine_name(engine_type_), K_(submit_cnt), K_(can_submit_request));
 
 private:
+  int init_io_uring(const ObIOEngineOption& engine_option);
+  int try_dequeue_request(const int64_t dequeued_cnt, ObIORequest*& req);
+  void submit_one(ObIORequest& req);
+  void submit_batch();
+  void flush_uring_requests();
+  void get_uring_events();
+  void process_io_event(ObIORequest& req, const int64_t res, const int64_t res2, const int64_t io_finish_time);
   int inner_submit(ObIORequest& req, int& sys_ret);
   void finish_flying_req(ObIORequest& req, int io_ret, int system_errno);
   int64_t get_pop_wait_timeout(const int64_t queue_deadline);
@@ -366,9 +396,14 @@ private:
   static const int32_t MAX_AIO_EVENT_CNT = 512;
   static const int64_t DISK_WAIT_PERIOD_US = 1000;
   static const int64_t AIO_TIMEOUT_NS = 1000L * 10000L;  // 10ms
+  static const int64_t URING_WAIT_TIMEOUT_MS = 10;
   static const int64_t DEFAULT_SUBMIT_WAIT_US = 10 * 1000;
+  static const int64_t MAX_URING_SUBMIT_BATCH = 32;
   bool inited_;
+  ObIOEngineType engine_type_;
   io_context_t context_;
+  ObIOUring ring_;
+  ObSpinLock sq_lock_;  // protect the submission queue of ring_
   int64_t submit_cnt_;
   ObIOQueue queue_;
   ObThreadCond queue_cond_;
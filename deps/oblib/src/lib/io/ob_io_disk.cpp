@@ -145,8 +145,8 @@ ObDisk::~ObDisk()
   destroy();
 }
 
-int ObDisk::init(
-    const ObDiskFd& fd, const int64_t sys_io_percent, const int64_t channel_count, const int32_t queue_depth)
+int ObDisk::init(const ObDiskFd& fd, const int64_t sys_io_percent, const int64_t channel_count,
+    const int32_t queue_depth, const ObIOEngineOption& engine_option)
 {
   int ret = OB_SUCCESS;
   if (inited_) {
@@ -167,8 +167,8 @@ int ObDisk::init(
     ref_cnt_ = 0;
     channel_count_ = channel_count;
     for (int64_t i = 0; OB_SUCC(ret) && i < MAX_DISK_CHANNEL_CNT; ++i) {
-      if (OB_FAIL(channels_[i].init(queue_depth))) {
-        COMMON_LOG(WARN, "fail to init channel", K(ret), K(i), K(queue_depth));
+      if (OB_FAIL(channels_[i].init(queue_depth, engine_option))) {
+        COMMON_LOG(WARN, "fail to init channel", K(ret), K(i), K(queue_depth), K(engine_option));
       }
     }
 
@@ -675,26 +675,29 @@ void ObIOFaultDetector::handle(void* t)
 /**
  *-------------------------------------------- ObDiskManager ---------------------------------------
  */
-ObDiskManager::ObDiskManager() : inited_(false), disk_count_(0), disk_number_limit_(0), resource_mgr_(NULL)
+ObDiskManager::ObDiskManager()
+    : inited_(false), disk_count_(0), disk_number_limit_(0), resource_mgr_(NULL), engine_option_()
 {}
 
 ObDiskManager::~ObDiskManager()
 {}
 
-int ObDiskManager::init(const int32_t disk_number_limit, ObIOResourceManager* resource_mgr)
+int ObDiskManager::init(
+    const int32_t disk_number_limit, ObIOResourceManager* resource_mgr, const ObIOEngineOption& engine_option)
 {
   int ret = OB_SUCCESS;
   if (inited_) {
     ret = OB_INIT_TWICE;
     COMMON_LOG(WARN, "init twice", K(ret));
-  } else if (disk_number_limit <= 0 || OB_ISNULL(resource_mgr)) {
+  } else if (disk_number_limit <= 0 || OB_ISNULL(resource_mgr) || !engine_option.is_valid()) {
     ret = OB_INVALID_ARGUMENT;
-    COMMON_LOG(WARN, "invalid arguments", K(ret), K(disk_number_limit), KP(resource_mgr));
+    COMMON_LOG(WARN, "invalid arguments", K(ret), K(disk_number_limit), KP(resource_mgr), K(engine_option));
   } else if (OB_FAIL(io_fault_detector_.init())) {
     COMMON_LOG(WARN, "Fail to init io fault detector, ", K(ret));
   } else {
     disk_number_limit_ = disk_number_limit;
     resource_mgr_ = resource_mgr;
+    engine_option_ = engine_option;
     inited_ = true;
   }
 
@@ -719,6 +722,7 @@ void ObDiskManager::destroy()
 
   disk_number_limit_ = 0;
   resource_mgr_ = NULL;
+  engine_option_.reset();
   inited_ = false;
 }
 
@@ -756,7 +760,7 @@ int ObDiskManager::add_disk(
       }
     }
     if (OB_SUCC(ret)) {
-      if (OB_FAIL(disk_array_[free_pos].init(fd, sys_io_percent, channel_count, queue_depth))) {
+      if (OB_FAIL(disk_array_[free_pos].init(fd, sys_io_percent, channel_count, queue_depth, engine_option_))) {
         COMMON_LOG(WARN, "disk init failed", K(ret), K(fd), K(sys_io_percent));
       } else {
         ATOMIC_INC(&disk_count_);
@@ -93,7 +93,8 @@ public:
   static const int64_t MINI_MODE_DISK_CHANNEL_CNT = 2;
   ObDisk();
   virtual ~ObDisk();
-  int init(const ObDiskFd& fd, const int64_t sys_io_percent, const int64_t channel_count, const int32_t queue_depth);
+  int init(const ObDiskFd& fd, const int64_t sys_io_percent, const int64_t channel_count, const int32_t queue_depth,
+      const ObIOEngineOption& engine_option = ObIOEngineOption());
   void destroy();
   void run1() override;
   // delayed delete, wait for ref_cnt decrease to 0
@@ -237,7 +238,8 @@ public:
       common::OB_MAX_DISK_NUMBER;  // replace MAX_DISK_NUM with disk_number_limit_ in cpp
   ObDiskManager();
   virtual ~ObDiskManager();
-  int init(const int32_t disk_number_limit, ObIOResourceManager* resource_mgr);
+  int init(const int32_t disk_number_limit, ObIOResourceManager* resource_mgr,
+      const ObIOEngineOption& engine_option = ObIOEngineOption());
   void destroy();
 
   // add or delete disk
@@ -274,6 +276,7 @@ private:
   lib::ObMutex admin_mutex_;
   ObIOFaultDetector io_fault_detector_;
   ObIOResourceManager* resource_mgr_;
+  ObIOEngineOption engine_option_;  // used by the channels of all disks
 };
 
 } /* namespace common */
@@ -426,20 +426,29 @@ ObIOManager& ObIOManager::get_instance()
   return instance;
 }
 
-int ObIOManager::init(const int64_t mem_limit, const int32_t disk_number_limit, const int32_t queue_depth)
+int ObIOManager::init(const int64_t mem_limit, const int32_t disk_number_limit, const int32_t queue_depth,
+    const ObIOEngineType io_engine, const bool enable_sqpoll)
 {
   int ret = OB_SUCCESS;
+  ObIOEngineOption engine_option;
+  engine_option.type_ = io_engine;
+  engine_option.enable_sqpoll_ = enable_sqpoll;
   if (inited_) {
     ret = OB_INIT_TWICE;
     COMMON_LOG(WARN, "init twice", K(ret));
   } else if (mem_limit < OB_MALLOC_BIG_BLOCK_SIZE || disk_number_limit <= 0 ||
              disk_number_limit > ObDiskManager::MAX_DISK_NUM ||
-             disk_number_limit > ObIOResourceManager::MAX_CHANNEL_CNT || queue_depth <= 0) {
+             disk_number_limit > ObIOResourceManager::MAX_CHANNEL_CNT || queue_depth <= 0 ||
+             io_engine < IO_ENGINE_LIBAIO || io_engine >= IO_ENGINE_MAX) {
     ret = OB_INVALID_ARGUMENT;
-    COMMON_LOG(WARN, "invalid arguments", K(ret), K(mem_limit), K(disk_number_limit), K(queue_depth));
+    COMMON_LOG(WARN, "invalid arguments", K(ret), K(mem_limit), K(disk_number_limit), K(queue_depth), K(io_engine));
   } else if (OB_FAIL(resource_mgr_.init(mem_limit))) {
     COMMON_LOG(WARN, "fail to init resource manager", K(ret));
-  } else if (OB_FAIL(disk_mgr_.init(disk_number_limit, &resource_mgr_))) {
+  } else if (IO_ENGINE_IO_URING == io_engine &&
+             OB_FAIL(resource_mgr_.get_allocator()->get_fixed_buffers(
+                 engine_option.fixed_bufs_, ObIOUring::MAX_FIXED_BUFFER_CNT, engine_option.fixed_buf_cnt_))) {
+    COMMON_LOG(WARN, "fail to get fixed buffers of io allocator", K(ret));
+  } else if (OB_FAIL(disk_mgr_.init(disk_number_limit, &resource_mgr_, engine_option))) {
     COMMON_LOG(WARN, "fail to init disk manager", K(ret));
   } else if (OB_FAIL(callback_mgr_.init(queue_depth))) {
     COMMON_LOG(WARN, "fail to init callback runner", K(ret));
@@ -454,7 +463,7 @@ int ObIOManager::init(const int64_t mem_limit, const int32_t disk_number_limit,
       COMMON_LOG(WARN, "Fail to create io thread, ", K(ret));
     } else {
       is_working_ = true;
-      LOG_INFO("succeed to init io manager", K(disk_number_limit), K(queue_depth));
+      LOG_INFO("succeed to init io manager", K(disk_number_limit), K(queue_depth), K(engine_option));
     }
   }
   if (!inited_) {
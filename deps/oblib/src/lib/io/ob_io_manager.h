@@ -103,10 +103,12 @@ public:
    * require:
    *          1. disk_number <= MAX_DISK_NUM, otherwise we will return OB_INVALID_ARGUMENT.
    *          2. disk_number <= submit_thread_cnt, otherwise we will increase submit_thread_cnt automatically.
+   * io_engine: the system io interface of disk channels, a channel falls back to libaio if io_uring is not available.
    */
   int init(const int64_t mem_limit = DEFAULT_IO_MANAGER_MEMORY_LIMIT,
       const int32_t disk_number_limit = ObDiskManager::MAX_DISK_NUM,
-      const int32_t queue_depth = DEFAULT_IO_QUEUE_DEPTH);
+      const int32_t queue_depth = DEFAULT_IO_QUEUE_DEPTH, const ObIOEngineType io_engine = IO_ENGINE_LIBAIO,
+      const bool enable_sqpoll = false);
   void destroy();
   void set_no_working()
   {
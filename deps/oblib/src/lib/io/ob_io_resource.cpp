@@ -312,6 +312,25 @@ int64_t ObIOAllocator::allocated()
   return allocator_.allocated();
 }
 
+int ObIOAllocator::get_fixed_buffers(struct iovec* iovs, const int64_t max_cnt, int64_t& cnt) const
+{
+  int ret = OB_SUCCESS;
+  cnt = 0;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "io allocator not init", K(ret));
+  } else if (OB_ISNULL(iovs) || OB_UNLIKELY(max_cnt < 2)) {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "invalid argument", K(ret), KP(iovs), K(max_cnt));
+  } else {
+    iovs[cnt].iov_base = micro_pool_.get_begin_ptr();
+    iovs[cnt++].iov_len = micro_pool_.get_total_size();
+    iovs[cnt].iov_base = macro_pool_.get_begin_ptr();
+    iovs[cnt++].iov_len = macro_pool_.get_total_size();
+  }
+  return ret;
+}
+
 /**
  * ---------------------------------------- ObIOPool -------------------------------
  */
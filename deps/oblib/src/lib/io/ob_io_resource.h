@@ -42,6 +42,15 @@ public:
   {
     return SIZE;
   }
+  // the contiguous memory of all blocks
+  char* get_begin_ptr() const
+  {
+    return begin_ptr_;
+  }
+  int64_t get_total_size() const
+  {
+    return capacity_ * SIZE;
+  }
 
 private:
   int init_bitmap(const int64_t block_count, ObIAllocator& allocator);
@@ -68,6 +77,8 @@ public:
   void* alloc(const int64_t size);
   void free(void* ptr);
   int64_t allocated();
+  // memory of the micro and macro pools, used as fixed buffers of io_uring
+  int get_fixed_buffers(struct iovec* iovs, const int64_t max_cnt, int64_t& cnt) const;
 
 private:
   static const int64_t MICRO_POOL_BLOCK_SIZE = 16L * 1024L + 2 * DIO_READ_ALIGN_SIZE;
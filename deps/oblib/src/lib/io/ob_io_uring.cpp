@@ -0,0 +1,430 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX COMMON
+#include "lib/io/ob_io_uring.h"
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include "lib/ob_errno.h"
+#include "lib/oblog/ob_log.h"
+#include "lib/utility/ob_macro_utils.h"
+
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+#ifndef __NR_io_uring_register
+#define __NR_io_uring_register 427
+#endif
+
+namespace oceanbase {
+namespace common {
+
+namespace {
+const uint8_t URING_OP_READ_FIXED = 4;
+const uint8_t URING_OP_WRITE_FIXED = 5;
+const uint8_t URING_OP_READ = 22;
+const uint8_t URING_OP_WRITE = 23;
+const uint32_t URING_SETUP_SQPOLL = 1U << 1;
+const uint32_t URING_FEAT_SINGLE_MMAP = 1U << 0;
+const uint32_t URING_FEAT_RW_CUR_POS = 1U << 3;  // since 5.6, the same version as IORING_OP_READ/WRITE
+const uint32_t URING_SQ_NEED_WAKEUP = 1U << 0;
+const uint32_t URING_ENTER_GETEVENTS = 1U << 0;
+const uint32_t URING_ENTER_SQ_WAKEUP = 1U << 1;
+const uint32_t URING_REGISTER_BUFFERS = 0;
+const uint32_t URING_REGISTER_EVENTFD = 4;
+const int64_t URING_OFF_SQ_RING = 0LL;
+const int64_t URING_OFF_CQ_RING = 0x8000000LL;
+const int64_t URING_OFF_SQES = 0x10000000LL;
+
+STATIC_ASSERT(64 == sizeof(ObIOUringSqe), "invalid io_uring sqe size");
+STATIC_ASSERT(16 == sizeof(ObIOUringCqe), "invalid io_uring cqe size");
+STATIC_ASSERT(120 == sizeof(ObIOUringParams), "invalid io_uring params size");
+
+int sys_io_uring_setup(const uint32_t entries, ObIOUringParams* params)
+{
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int sys_io_uring_enter(const int fd, const uint32_t to_submit, const uint32_t min_complete, const uint32_t flags)
+{
+  return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, NULL, 0));
+}
+
+int sys_io_uring_register(const int fd, const uint32_t opcode, const void* arg, const uint32_t nr_args)
+{
+  return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+}  // namespace
+
+const char* get_io_engine_name(const ObIOEngineType type)
+{
+  const char* name = "unknown";
+  switch (type) {
+    case IO_ENGINE_LIBAIO:
+      name = "libaio";
+      break;
+    case IO_ENGINE_IO_URING:
+      name = "io_uring";
+      break;
+    default:
+      break;
+  }
+  return name;
+}
+
+ObIOEngineType get_io_engine_type(const char* name)
+{
+  ObIOEngineType type = IO_ENGINE_MAX;
+  if (OB_ISNULL(name)) {
+    // do nothing
+  } else if (0 == STRCASECMP(name, "libaio")) {
+    type = IO_ENGINE_LIBAIO;
+  } else if (0 == STRCASECMP(name, "io_uring")) {
+    type = IO_ENGINE_IO_URING;
+  }
+  return type;
+}
+
+ObIOUring::ObIOUring()
+    : is_inited_(false),
+      ring_fd_(-1),
+      event_fd_(-1),
+      is_sqpoll_(false),
+      sq_ring_ptr_(MAP_FAILED),
+      sq_ring_size_(0),
+      sq_head_(NULL),
+      sq_tail_(NULL),
+      sq_flags_(NULL),
+      sq_array_(NULL),
+      sq_mask_(0),
+      sq_entries_(0),
+      sqes_(static_cast<ObIOUringSqe*>(MAP_FAILED)),
+      sqes_size_(0),
+      sqe_tail_(0),
+      cq_ring_ptr_(MAP_FAILED),
+      cq_ring_size_(0),
+      cq_head_(NULL),
+      cq_tail_(NULL),
+      cq_mask_(0),
+      cq_entries_(0),
+      cqes_(NULL),
+      fixed_buf_cnt_(0)
+{
+  MEMSET(fixed_bufs_, 0, sizeof(fixed_bufs_));
+}
+
+ObIOUring::~ObIOUring()
+{
+  destroy();
+}
+
+int ObIOUring::init(const uint32_t entries, const bool enable_sqpoll)
+{
+  int ret = OB_SUCCESS;
+  ObIOUringParams params;
+  MEMSET(&params, 0, sizeof(params));
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    COMMON_LOG(WARN, "io_uring has been inited", K(ret));
+  } else if (OB_UNLIKELY(0 == entries)) {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "invalid argument", K(ret), K(entries));
+  } else {
+    if (enable_sqpoll) {
+      params.flags_ |= URING_SETUP_SQPOLL;
+      params.sq_thread_idle_ = SQPOLL_IDLE_MS;
+    }
+    if ((ring_fd_ = sys_io_uring_setup(entries, &params)) < 0) {
+      ret = ENOSYS == errno ? OB_NOT_SUPPORTED : OB_IO_ERROR;
+      COMMON_LOG(WARN, "fail to setup io_uring", K(ret), K(errno), K(entries), K(enable_sqpoll));
+    } else if (0 == (params.features_ & URING_FEAT_RW_CUR_POS)) {
+      ret = OB_NOT_SUPPORTED;
+      COMMON_LOG(WARN, "io_uring of the kernel is too old, need linux 5.6 or later", K(ret), K(params.features_));
+    } else if (OB_FAIL(mmap_rings(params))) {
+      COMMON_LOG(WARN, "fail to mmap io_uring", K(ret));
+    } else if ((event_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)) < 0) {
+      ret = OB_IO_ERROR;
+      COMMON_LOG(WARN, "fail to create eventfd", K(ret), K(errno));
+    } else if (0 != sys_io_uring_register(ring_fd_, URING_REGISTER_EVENTFD, &event_fd_, 1)) {
+      ret = OB_IO_ERROR;
+      COMMON_LOG(WARN, "fail to register eventfd to io_uring", K(ret), K(errno));
+    } else {
+      is_sqpoll_ = enable_sqpoll;
+      sqe_tail_ = *sq_tail_;
+      is_inited_ = true;
+      COMMON_LOG(INFO, "succ to init io_uring", K(*this), K(params.features_));
+    }
+  }
+  if (OB_FAIL(ret) && OB_INIT_TWICE != ret) {
+    destroy();
+  }
+  return ret;
+}
+
+int ObIOUring::mmap_rings(const ObIOUringParams& params)
+{
+  int ret = OB_SUCCESS;
+  sq_ring_size_ = params.sq_off_.array_ + params.sq_entries_ * sizeof(uint32_t);
+  cq_ring_size_ = params.cq_off_.cqes_ + params.cq_entries_ * sizeof(ObIOUringCqe);
+  sqes_size_ = params.sq_entries_ * sizeof(ObIOUringSqe);
+  const bool single_mmap = 0 != (params.features_ & URING_FEAT_SINGLE_MMAP);
+  if (single_mmap) {
+    sq_ring_size_ = MAX(sq_ring_size_, cq_ring_size_);
+    cq_ring_size_ = sq_ring_size_;
+  }
+  sq_ring_ptr_ =
+      ::mmap(NULL, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, URING_OFF_SQ_RING);
+  if (MAP_FAILED == sq_ring_ptr_) {
+    ret = OB_IO_ERROR;
+    COMMON_LOG(WARN, "fail to mmap io_uring sq ring", K(ret), K(errno), K_(sq_ring_size));
+  } else {
+    cq_ring_ptr_ = single_mmap ? sq_ring_ptr_
+                               : ::mmap(NULL,
+                                     cq_ring_size_,
+                                     PROT_READ | PROT_WRITE,
+                                     MAP_SHARED | MAP_POPULATE,
+                                     ring_fd_,
+                                     URING_OFF_CQ_RING);
+    if (MAP_FAILED == cq_ring_ptr_) {
+      ret = OB_IO_ERROR;
+      COMMON_LOG(WARN, "fail to mmap io_uring cq ring", K(ret), K(errno), K_(cq_ring_size));
+    } else {
+      sqes_ = static_cast<ObIOUringSqe*>(
+          ::mmap(NULL, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, URING_OFF_SQES));
+      if (MAP_FAILED == static_cast<void*>(sqes_)) {
+        ret = OB_IO_ERROR;
+        COMMON_LOG(WARN, "fail to mmap io_uring sqes", K(ret), K(errno), K_(sqes_size));
+      }
+    }
+  }
+  if (OB_SUCC(ret)) {
+    char* sq_ptr = static_cast<char*>(sq_ring_ptr_);
+    char* cq_ptr = static_cast<char*>(cq_ring_ptr_);
+    sq_head_ = reinterpret_cast<uint32_t*>(sq_ptr + params.sq_off_.head_);
+    sq_tail_ = reinterpret_cast<uint32_t*>(sq_ptr + params.sq_off_.tail_);
+    sq_flags_ = reinterpret_cast<uint32_t*>(sq_ptr + params.sq_off_.flags_);
+    sq_array_ = reinterpret_cast<uint32_t*>(sq_ptr + params.sq_off_.array_);
+    sq_mask_ = *reinterpret_cast<uint32_t*>(sq_ptr + params.sq_off_.ring_mask_);
+    sq_entries_ = *reinterpret_cast<uint32_t*>(sq_ptr + params.sq_off_.ring_entries_);
+    cq_head_ = reinterpret_cast<uint32_t*>(cq_ptr + params.cq_off_.head_);
+    cq_tail_ = reinterpret_cast<uint32_t*>(cq_ptr + params.cq_off_.tail_);
+    cq_mask_ = *reinterpret_cast<uint32_t*>(cq_ptr + params.cq_off_.ring_mask_);
+    cq_entries_ = *reinterpret_cast<uint32_t*>(cq_ptr + params.cq_off_.ring_entries_);
+    cqes_ = reinterpret_cast<ObIOUringCqe*>(cq_ptr + params.cq_off_.cqes_);
+  }
+  return ret;
+}
+
+void ObIOUring::destroy()
+{
+  if (MAP_FAILED != static_cast<void*>(sqes_)) {
+    ::munmap(sqes_, sqes_size_);
+  }
+  if (MAP_FAILED != cq_ring_ptr_ && cq_ring_ptr_ != sq_ring_ptr_) {
+    ::munmap(cq_ring_ptr_, cq_ring_size_);
+  }
+  if (MAP_FAILED != sq_ring_ptr_) {
+    ::munmap(sq_ring_ptr_, sq_ring_size_);
+  }
+  if (ring_fd_ >= 0) {
+    ::close(ring_fd_);  // the registered buffers and eventfd are released by the kernel
+  }
+  if (event_fd_ >= 0) {
+    ::close(event_fd_);
+  }
+  is_inited_ = false;
+  ring_fd_ = -1;
+  event_fd_ = -1;
+  is_sqpoll_ = false;
+  sq_ring_ptr_ = MAP_FAILED;
+  sq_ring_size_ = 0;
+  sq_head_ = NULL;
+  sq_tail_ = NULL;
+  sq_flags_ = NULL;
+  sq_array_ = NULL;
+  sq_mask_ = 0;
+  sq_entries_ = 0;
+  sqes_ = static_cast<ObIOUringSqe*>(MAP_FAILED);
+  sqes_size_ = 0;
+  sqe_tail_ = 0;
+  cq_ring_ptr_ = MAP_FAILED;
+  cq_ring_size_ = 0;
+  cq_head_ = NULL;
+  cq_tail_ = NULL;
+  cq_mask_ = 0;
+  cq_entries_ = 0;
+  cqes_ = NULL;
+  MEMSET(fixed_bufs_, 0, sizeof(fixed_bufs_));
+  fixed_buf_cnt_ = 0;
+}
+
+int ObIOUring::register_buffers(const struct iovec* iovs, const int64_t iov_cnt)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "io_uring not init", K(ret));
+  } else if (OB_ISNULL(iovs) || OB_UNLIKELY(iov_cnt <= 0 || iov_cnt > MAX_FIXED_BUFFER_CNT)) {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "invalid argument", K(ret), KP(iovs), K(iov_cnt));
+  } else if (OB_UNLIKELY(fixed_buf_cnt_ > 0)) {
+    ret = OB_INIT_TWICE;
+    COMMON_LOG(WARN, "fixed buffers have been registered", K(ret), K_(fixed_buf_cnt));
+  } else if (0 != sys_io_uring_register(ring_fd_, URING_REGISTER_BUFFERS, iovs, static_cast<uint32_t>(iov_cnt))) {
+    // usually ENOMEM for RLIMIT_MEMLOCK
+    ret = OB_IO_ERROR;
+    COMMON_LOG(WARN, "fail to register fixed buffers", K(ret), K(errno), K(iov_cnt));
+  } else {
+    MEMCPY(fixed_bufs_, iovs, iov_cnt * sizeof(struct iovec));
+    fixed_buf_cnt_ = iov_cnt;
+  }
+  return ret;
+}
+
+int ObIOUring::get_fixed_buf_index(const void* buf, const uint32_t size) const
+{
+  int buf_index = -1;
+  const char* begin = static_cast<const char*>(buf);
+  for (int64_t i = 0; buf_index < 0 && i < fixed_buf_cnt_; ++i) {
+    const char* fixed_begin = static_cast<const char*>(fixed_bufs_[i].iov_base);
+    if (begin >= fixed_begin && begin + size <= fixed_begin + fixed_bufs_[i].iov_len) {
+      buf_index = static_cast<int>(i);
+    }
+  }
+  return buf_index;
+}
+
+int ObIOUring::prep_rw(const bool is_read, const int fd, void* buf, const uint32_t size, const int64_t offset,
+    const uint64_t user_data)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "io_uring not init", K(ret));
+  } else if (sqe_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >= sq_entries_) {
+    ret = OB_EAGAIN;
+  } else {
+    const uint32_t idx = sqe_tail_ & sq_mask_;
+    const int buf_index = get_fixed_buf_index(buf, size);
+    ObIOUringSqe& sqe = sqes_[idx];
+    MEMSET(&sqe, 0, sizeof(sqe));
+    if (buf_index >= 0) {
+      sqe.opcode_ = is_read ? URING_OP_READ_FIXED : URING_OP_WRITE_FIXED;
+      sqe.buf_index_ = static_cast<uint16_t>(buf_index);
+    } else {
+      sqe.opcode_ = is_read ? URING_OP_READ : URING_OP_WRITE;
+    }
+    sqe.fd_ = fd;
+    sqe.off_ = static_cast<uint64_t>(offset);
+    sqe.addr_ = reinterpret_cast<uint64_t>(buf);
+    sqe.len_ = size;
+    sqe.user_data_ = user_data;
+    sq_array_[idx] = idx;
+    ++sqe_tail_;
+  }
+  return ret;
+}
+
+int ObIOUring::submit(int64_t& submitted)
+{
+  int ret = OB_SUCCESS;
+  submitted = 0;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "io_uring not init", K(ret));
+  } else {
+    // publish the prepared sqes, the kernel consumes them from *sq_head_ to *sq_tail_
+    __atomic_store_n(sq_tail_, sqe_tail_, __ATOMIC_RELEASE);
+    const uint32_t to_submit = sqe_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    if (0 == to_submit) {
+      // do nothing
+    } else if (is_sqpoll_) {
+      // the poll thread consumes the sqes by itself, wake it up only if it is sleeping
+      __atomic_thread_fence(__ATOMIC_SEQ_CST);
+      if (0 != (__atomic_load_n(sq_flags_, __ATOMIC_RELAXED) & URING_SQ_NEED_WAKEUP) &&
+          sys_io_uring_enter(ring_fd_, 0, 0, URING_ENTER_SQ_WAKEUP) < 0) {
+        ret = OB_IO_ERROR;
+        COMMON_LOG(WARN, "fail to wake up io_uring sq thread", K(ret), K(errno));
+      } else {
+        submitted = to_submit;
+      }
+    } else {
+      const int sys_ret = sys_io_uring_enter(ring_fd_, to_submit, 0, 0);
+      if (sys_ret < 0) {
+        // the sqes stay in the ring and are submitted in next round
+        ret = (EAGAIN == errno || EBUSY == errno || EINTR == errno) ? OB_EAGAIN : OB_IO_ERROR;
+      } else {
+        submitted = sys_ret;
+      }
+    }
+  }
+  return ret;
+}
+
+int64_t ObIOUring::peek_cqes(ObIOUringCqe* cqes, const int64_t max_cnt)
+{
+  int64_t cnt = 0;
+  if (OB_LIKELY(is_inited_) && OB_NOT_NULL(cqes)) {
+    const uint32_t head = *cq_head_;
+    const uint32_t tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    cnt = MIN(static_cast<int64_t>(tail - head), max_cnt);
+    for (int64_t i = 0; i < cnt; ++i) {
+      cqes[i] = cqes_[(head + i) & cq_mask_];
+    }
+    if (cnt > 0) {
+      __atomic_store_n(cq_head_, head + static_cast<uint32_t>(cnt), __ATOMIC_RELEASE);
+    }
+  }
+  return cnt;
+}
+
+int ObIOUring::wait_cqe(const int64_t timeout_ms)
+{
+  int ret = OB_SUCCESS;
+  struct pollfd pfd;
+  pfd.fd = event_fd_;
+  pfd.events = POLLIN;
+  pfd.revents = 0;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "io_uring not init", K(ret));
+  } else {
+    // the eventfd counter keeps the notifications posted before poll, so no wakeup is lost
+    const int poll_ret = ::poll(&pfd, 1, static_cast<int>(timeout_ms));
+    if (poll_ret < 0) {
+      ret = EINTR == errno ? OB_TIMEOUT : OB_IO_ERROR;
+    } else if (0 == poll_ret) {
+      ret = OB_TIMEOUT;
+    } else {
+      uint64_t value = 0;
+      if (sizeof(value) != ::read(event_fd_, &value, sizeof(value))) {
+        // EAGAIN, cleared by another reader, ignore
+      }
+    }
+  }
+  return ret;
+}
+
+int64_t ObIOUring::get_pending_cnt() const
+{
+  return is_inited_ ? static_cast<int64_t>(sqe_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE)) : 0;
+}
+
+}  // end namespace common
+}  // end namespace oceanbase
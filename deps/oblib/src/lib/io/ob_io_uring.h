@@ -0,0 +1,166 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OB_IO_URING_H
+#define OB_IO_URING_H
+
+#include <stdint.h>
+#include <sys/uio.h>
+#include "lib/utility/ob_print_utils.h"
+
+namespace oceanbase {
+namespace common {
+
+enum ObIOEngineType {
+  IO_ENGINE_LIBAIO = 0,
+  IO_ENGINE_IO_URING = 1,
+  IO_ENGINE_MAX
+};
+
+const char* get_io_engine_name(const ObIOEngineType type);
+ObIOEngineType get_io_engine_type(const char* name);
+
+/*
+ * The kernel abi of io_uring (linux 5.6+), declared here so that the build does not depend on
+ * the version of the kernel headers or liburing.
+ */
+struct ObIOUringSqe {
+  uint8_t opcode_;
+  uint8_t flags_;
+  uint16_t ioprio_;
+  int32_t fd_;
+  uint64_t off_;
+  uint64_t addr_;
+  uint32_t len_;
+  uint32_t rw_flags_;
+  uint64_t user_data_;
+  uint16_t buf_index_;
+  uint16_t personality_;
+  int32_t splice_fd_in_;
+  uint64_t pad_[2];
+};
+
+struct ObIOUringCqe {
+  uint64_t user_data_;
+  int32_t res_;
+  uint32_t flags_;
+};
+
+struct ObIOUringSqOffsets {
+  uint32_t head_;
+  uint32_t tail_;
+  uint32_t ring_mask_;
+  uint32_t ring_entries_;
+  uint32_t flags_;
+  uint32_t dropped_;
+  uint32_t array_;
+  uint32_t resv1_;
+  uint64_t resv2_;
+};
+
+struct ObIOUringCqOffsets {
+  uint32_t head_;
+  uint32_t tail_;
+  uint32_t ring_mask_;
+  uint32_t ring_entries_;
+  uint32_t overflow_;
+  uint32_t cqes_;
+  uint32_t flags_;
+  uint32_t resv1_;
+  uint64_t resv2_;
+};
+
+struct ObIOUringParams {
+  uint32_t sq_entries_;
+  uint32_t cq_entries_;
+  uint32_t flags_;
+  uint32_t sq_thread_cpu_;
+  uint32_t sq_thread_idle_;
+  uint32_t features_;
+  uint32_t wq_fd_;
+  uint32_t resv_[3];
+  ObIOUringSqOffsets sq_off_;
+  ObIOUringCqOffsets cq_off_;
+};
+
+/*
+ * A single io_uring instance used by one ObIOChannel.
+ * prep_rw() and submit() must be serialized by the caller, peek_cqes() and wait_cqe() must be
+ * called by a single thread, the two sides can run concurrently.
+ */
+class ObIOUring {
+public:
+  static const int64_t MAX_FIXED_BUFFER_CNT = 4;
+  static const uint32_t SQPOLL_IDLE_MS = 10;
+
+public:
+  ObIOUring();
+  ~ObIOUring();
+  int init(const uint32_t entries, const bool enable_sqpoll);
+  void destroy();
+  // register the memory regions for READ_FIXED/WRITE_FIXED, the buffers are pinned by the kernel
+  int register_buffers(const struct iovec* iovs, const int64_t iov_cnt);
+  // fill a sqe, return OB_EAGAIN if the submission queue is full
+  int prep_rw(const bool is_read, const int fd, void* buf, const uint32_t size, const int64_t offset,
+      const uint64_t user_data);
+  // pass all prepared sqes to the kernel with at most one system call
+  int submit(int64_t& submitted);
+  // copy and consume at most %max_cnt completions, never blocks
+  int64_t peek_cqes(ObIOUringCqe* cqes, const int64_t max_cnt);
+  // wait until a completion arrives or timeout
+  int wait_cqe(const int64_t timeout_ms);
+  int64_t get_pending_cnt() const;
+  bool is_inited() const
+  {
+    return is_inited_;
+  }
+  TO_STRING_KV(K_(is_inited), K_(ring_fd), K_(event_fd), K_(sq_entries), K_(cq_entries), K_(is_sqpoll),
+      K_(fixed_buf_cnt), K_(sqe_tail));
+
+private:
+  int mmap_rings(const ObIOUringParams& params);
+  int get_fixed_buf_index(const void* buf, const uint32_t size) const;
+
+private:
+  bool is_inited_;
+  int ring_fd_;
+  int event_fd_;
+  bool is_sqpoll_;
+  // submission queue
+  void* sq_ring_ptr_;
+  int64_t sq_ring_size_;
+  uint32_t* sq_head_;
+  uint32_t* sq_tail_;
+  uint32_t* sq_flags_;
+  uint32_t* sq_array_;
+  uint32_t sq_mask_;
+  uint32_t sq_entries_;
+  ObIOUringSqe* sqes_;
+  int64_t sqes_size_;
+  uint32_t sqe_tail_;  // tail of the prepared sqes, published to sq_tail_ by submit()
+  // completion queue
+  void* cq_ring_ptr_;
+  int64_t cq_ring_size_;
+  uint32_t* cq_head_;
+  uint32_t* cq_tail_;
+  uint32_t cq_mask_;
+  uint32_t cq_entries_;
+  ObIOUringCqe* cqes_;
+  // registered buffers
+  struct iovec fixed_bufs_[MAX_FIXED_BUFFER_CNT];
+  int64_t fixed_buf_cnt_;
+};
+
+}  // end namespace common
+}  // end namespace oceanbase
+
+#endif  // OB_IO_URING_H
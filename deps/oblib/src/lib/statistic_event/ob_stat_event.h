@@ -532,6 +532,8 @@ STAT_EVENT_ADD_DEF(BANDWIDTH_OUT_SLEEP_US, "bandwidth out sleep us", ObStatClass
 
 STAT_EVENT_ADD_DEF(MEMSTORE_WRITE_LOCK_WAIT_TIMEOUT_COUNT, "memstore write lock wait timeout count",
     ObStatClassIds::STORAGE, "memstore write wait timeout count", 60083, true, true)
+STAT_EVENT_ADD_DEF(MEMSTORE_HOT_ROW_LOCK_WAIT_COUNT, "memstore hot row lock wait count", ObStatClassIds::STORAGE,
+    "memstore hot row lock wait count", 60084, true, true)
 
 // backup & restore
 STAT_EVENT_ADD_DEF(
@@ -29,6 +29,7 @@ ObLockWaitNode::ObLockWaitNode()
       block_sessid_(0),
       sessid_version_(0),
       ctx_desc_(0),
+      holder_ctx_desc_(0),
       run_ts_(0),
       is_standalone_task_(false),
       total_update_cnt_(0)
@@ -44,6 +45,7 @@ void ObLockWaitNode::set(void* addr, int64_t hash, int64_t lock_seq, int64_t tim
   abs_timeout_ = timeout;
   table_id_ = table_id;  // used for gv$lock_wait_stat
   ctx_desc_ = ctx_desc;  // used for deadlock detection
+  holder_ctx_desc_ = 0;
   total_update_cnt_ = total_trans_node_cnt;
 
   snprintf(key_, sizeof(key_), "%s", key);
@@ -80,9 +80,14 @@ struct ObLockWaitNode : public common::SpHashNode {
   {
     block_sessid_ = block_sessid;
   }
+  // the ctx descriptor of the transaction holding the lock, 0 if unknown
+  void set_holder_ctx_desc(const uint32_t holder_ctx_desc)
+  {
+    holder_ctx_desc_ = holder_ctx_desc;
+  }
 
   TO_STRING_KV(KP(this), KP_(addr), K_(hash), K_(lock_ts), K_(abs_timeout), K_(key), K_(sessid), K_(sessid_version),
-      K_(block_sessid), K_(run_ts), K_(ctx_desc), K_(is_standalone_task));
+      K_(block_sessid), K_(run_ts), K_(ctx_desc), K_(holder_ctx_desc), K_(is_standalone_task));
   uint64_t hold_key_;
   ObLink retire_link_;
   bool need_wait_;
@@ -97,6 +102,7 @@ struct ObLockWaitNode : public common::SpHashNode {
   uint32_t block_sessid_;
   uint32_t sessid_version_;
   uint32_t ctx_desc_;
+  uint32_t holder_ctx_desc_;
 
   char key_[400];
   int64_t run_ts_;
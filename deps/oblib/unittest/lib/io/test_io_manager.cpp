@@ -475,6 +475,48 @@ TEST_F(TestIOManager, normal)
   //  ASSERT_NE(OB_SUCCESS, ret);
 }
 
+TEST_F(TestIOManager, io_uring)
+{
+  int ret = OB_SUCCESS;
+  ObIOInfo io_info;
+  ObIOHandle io_handle;
+  const int64_t data_size = 4096;
+  char data[data_size] = "test io_uring manager";
+
+  // the channels fall back to libaio if io_uring is not supported by the kernel
+  ObIOManager::get_instance().destroy();
+  ASSERT_EQ(OB_SUCCESS,
+      ObIOManager::get_instance().init(ObIOManager::DEFAULT_IO_MANAGER_MEMORY_LIMIT,
+          ObDiskManager::MAX_DISK_NUM,
+          ObIOManager::DEFAULT_IO_QUEUE_DEPTH,
+          IO_ENGINE_IO_URING));
+  ASSERT_EQ(OB_SUCCESS, ObIOManager::get_instance().add_disk(fd_, 2));
+
+  io_info.batch_count_ = 1;
+  ObIOPoint& io_point = io_info.io_points_[0];
+  io_point.fd_ = fd_;
+  io_point.size_ = data_size;
+  io_point.offset_ = 0;
+  io_point.write_buf_ = data;
+  io_info.size_ = io_point.size_;
+  io_info.io_desc_.category_ = USER_IO;
+
+  io_info.io_desc_.mode_ = ObIOMode::IO_MODE_WRITE;
+  ret = ObIOManager::get_instance().write(io_info, DEFAULT_IO_WAIT_TIME_MS);
+  ASSERT_EQ(OB_SUCCESS, ret);
+
+  io_info.io_desc_.mode_ = ObIOMode::IO_MODE_READ;
+  for (int64_t i = 0; i < 16; ++i) {
+    ret = ObIOManager::get_instance().aio_read(io_info, io_handle);
+    ASSERT_EQ(OB_SUCCESS, ret);
+    ret = io_handle.wait(DEFAULT_IO_WAIT_TIME_MS);
+    ASSERT_EQ(OB_SUCCESS, ret);
+    ret = strncmp(data, io_handle.get_buffer(), strlen(data));
+    ASSERT_EQ(0, ret);
+    io_handle.reset();
+  }
+}
+
 TEST_F(TestIOManager, multi)
 {
   static const int64_t MULTI_CNT = 1024;
@@ -0,0 +1,128 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "ob_clog_group_commit_ctrl.h"
+#include "lib/atomic/ob_atomic.h"
+#include "ob_clog_config.h"
+
+namespace oceanbase {
+namespace clog {
+
+int64_t ObClogGroupCommitCtrl::fsync_latency_ = 0;
+
+void ObClogGroupCommitCtrl::reset()
+{
+  last_arrival_ts_ = 0;
+  arrival_interval_ = 0;
+  log_size_ = 0;
+  flush_window_ = 0;
+  delay_count_ = 0;
+  immediate_count_ = 0;
+}
+
+int64_t ObClogGroupCommitCtrl::update_avg(const int64_t avg, const int64_t sample)
+{
+  // exponential moving average with weight 1/8
+  return 0 == avg ? sample : (avg + (sample - avg) / 8);
+}
+
+void ObClogGroupCommitCtrl::record_arrival(const int64_t cur_ts, const int64_t size)
+{
+  const int64_t last_ts = ATOMIC_TAS(&last_arrival_ts_, cur_ts);
+  if (last_ts > 0) {
+    int64_t interval = cur_ts - last_ts;
+    if (interval < 0) {
+      interval = 0;
+    } else if (interval > MAX_ARRIVAL_INTERVAL) {
+      interval = MAX_ARRIVAL_INTERVAL;
+    }
+    ATOMIC_STORE(&arrival_interval_, update_avg(ATOMIC_LOAD(&arrival_interval_), interval));
+  }
+  if (size > 0) {
+    ATOMIC_STORE(&log_size_, update_avg(ATOMIC_LOAD(&log_size_), size));
+  }
+}
+
+int64_t ObClogGroupCommitCtrl::calc_flush_window(const int64_t latency_slo)
+{
+  const int64_t fsync_latency = get_fsync_latency();
+  const int64_t arrival_interval = ATOMIC_LOAD(&arrival_interval_);
+  const int64_t log_size = ATOMIC_LOAD(&log_size_);
+  const int64_t budget = (latency_slo < MAX_FLUSH_WINDOW ? latency_slo : MAX_FLUSH_WINDOW) - fsync_latency;
+  int64_t window = 0;
+  if (budget <= 0 || arrival_interval <= 0 || arrival_interval >= budget) {
+    window = 0;
+  } else {
+    window = fsync_latency > arrival_interval ? fsync_latency : arrival_interval;
+    if (log_size > 0) {
+      const int64_t fill_time = arrival_interval * (AGGRE_BUFFER_LIMIT / log_size);
+      if (fill_time < window) {
+        window = fill_time;
+      }
+    }
+    if (budget < window) {
+      window = budget;
+    }
+  }
+  ATOMIC_STORE(&flush_window_, window);
+  if (window > 0) {
+    ATOMIC_INC(&delay_count_);
+  } else {
+    ATOMIC_INC(&immediate_count_);
+  }
+  return window;
+}
+
+int64_t ObClogGroupCommitCtrl::get_arrival_interval() const
+{
+  return ATOMIC_LOAD(&arrival_interval_);
+}
+
+int64_t ObClogGroupCommitCtrl::get_log_size() const
+{
+  return ATOMIC_LOAD(&log_size_);
+}
+
+int64_t ObClogGroupCommitCtrl::get_flush_window() const
+{
+  return ATOMIC_LOAD(&flush_window_);
+}
+
+int64_t ObClogGroupCommitCtrl::get_delay_count() const
+{
+  return ATOMIC_LOAD(&delay_count_);
+}
+
+int64_t ObClogGroupCommitCtrl::get_immediate_count() const
+{
+  return ATOMIC_LOAD(&immediate_count_);
+}
+
+void ObClogGroupCommitCtrl::record_fsync_latency(const int64_t io_time)
+{
+  if (io_time >= 0) {
+    ATOMIC_STORE(&fsync_latency_, update_avg(ATOMIC_LOAD(&fsync_latency_), io_time));
+  }
+}
+
+int64_t ObClogGroupCommitCtrl::get_fsync_latency()
+{
+  return ATOMIC_LOAD(&fsync_latency_);
+}
+
+void ObClogGroupCommitCtrl::reset_fsync_latency()
+{
+  ATOMIC_STORE(&fsync_latency_, 0);
+}
+
+}  // namespace clog
+}  // namespace oceanbase
@@ -0,0 +1,85 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_CLOG_OB_CLOG_GROUP_COMMIT_CTRL_
+#define OCEANBASE_CLOG_OB_CLOG_GROUP_COMMIT_CTRL_
+
+#include "lib/utility/ob_print_utils.h"
+
+namespace oceanbase {
+namespace clog {
+
+// Adaptive group commit of the clog aggregation buffer of a partition.
+//
+// When a log of the partition is flushed, the aggregation buffer collecting the following small logs is frozen
+// after a flush window. Waiting longer packs more logs into one disk write, at the cost of commit latency. The
+// window is sized in the style of Nagle with a latency target %latency_slo:
+//  - the fsync latency of the clog writer, shared by the server, is taken out of the target first, if nothing
+//    is left the buffer is frozen at once;
+//  - if the next log is not expected to arrive within the remaining budget, waiting does not help and the buffer
+//    is frozen at once;
+//  - otherwise we wait about one fsync latency, which bounds the extra latency by the disk write that has to be
+//    paid anyway, but not less than one arrival interval and not longer than the budget or the time to fill up
+//    the buffer.
+//
+// Both the arrival interval and the fsync latency are moving averages, updated without locks, lost updates under
+// contention are acceptable.
+class ObClogGroupCommitCtrl {
+public:
+  // an idle gap longer than this is counted as this
+  static const int64_t MAX_ARRIVAL_INTERVAL = 1000 * 1000;
+  static const int64_t MAX_FLUSH_WINDOW = 100 * 1000;
+
+public:
+  ObClogGroupCommitCtrl()
+  {
+    reset();
+  }
+  ~ObClogGroupCommitCtrl()
+  {}
+  void reset();
+  // a log of %size bytes is appended to the aggregation buffer at %cur_ts
+  void record_arrival(const int64_t cur_ts, const int64_t size);
+  // flush window in us of the aggregation buffer, 0 means freezing the buffer at once
+  int64_t calc_flush_window(const int64_t latency_slo);
+  int64_t get_arrival_interval() const;
+  int64_t get_log_size() const;
+  int64_t get_flush_window() const;
+  int64_t get_delay_count() const;
+  int64_t get_immediate_count() const;
+
+  // fsync latency of the clog writer, updated by the writer thread after each flush
+  static void record_fsync_latency(const int64_t io_time);
+  static int64_t get_fsync_latency();
+  static void reset_fsync_latency();
+
+  TO_STRING_KV(K_(last_arrival_ts), K_(arrival_interval), K_(log_size), K_(flush_window), K_(delay_count),
+      K_(immediate_count));
+
+private:
+  static int64_t update_avg(const int64_t avg, const int64_t sample);
+
+private:
+  static int64_t fsync_latency_;
+  int64_t last_arrival_ts_;
+  int64_t arrival_interval_;
+  int64_t log_size_;
+  // the last decision
+  int64_t flush_window_;
+  int64_t delay_count_;
+  int64_t immediate_count_;
+};
+
+}  // namespace clog
+}  // namespace oceanbase
+
+#endif  // OCEANBASE_CLOG_OB_CLOG_GROUP_COMMIT_CTRL_
@@ -25,6 +25,7 @@
 #include "clog/ob_log_define.h"
 #include "clog/ob_log_file_trailer.h"
 #include "clog/ob_clog_file_writer.h"
+#include "clog/ob_clog_group_commit_ctrl.h"
 #include "observer/ob_server_struct.h"
 #include "election/ob_election.h"
 
@@ -276,6 +277,7 @@ void ObCLogWriter::process_log_items(common::ObIBaseLogItem** items, const int64
       if (CLOG_WRITE_POOL == type_) {
         EVENT_INC(CLOG_WRITE_COUNT);
         EVENT_ADD(CLOG_WRITE_TIME, io_time);
+        ObClogGroupCommitCtrl::record_fsync_latency(io_time);
       } else if (ILOG_WRITE_POOL == type_) {
         EVENT_INC(ILOG_WRITE_COUNT);
         EVENT_ADD(ILOG_WRITE_TIME, io_time);
@@ -88,6 +88,7 @@ ObLogSlidingWindow::ObLogSlidingWindow()
       next_submit_aggre_buffer_(0),
       aggre_buffer_start_id_(0),
       leader_max_unconfirmed_log_cnt_(DEFAULT_LEADER_MAX_UNCONFIRMED_LOG_COUNT),
+      group_commit_ctrl_(),
       last_archive_checkpoint_log_id_(OB_INVALID_ID),
       last_archive_checkpoint_ts_(0),
       last_update_archive_checkpoint_time_(OB_INVALID_TIMESTAMP),
@@ -224,6 +225,7 @@ int ObLogSlidingWindow::leader_active()
     for (int64_t i = 0; i < aggre_buffer_cnt_; i++) {
       aggre_buffer_[i].reuse(aggre_buffer_start_id_ + i);
     }
+    group_commit_ctrl_.reset();
   }
   if (OB_SUCC(ret)) {
     const int64_t now = ObClockGenerator::getClock();
@@ -746,7 +748,12 @@ int ObLogSlidingWindow::submit_freeze_aggre_buffer_task_(const uint64_t log_id)
   int64_t flush_interval = 0;
   omt::ObTenantConfigGuard tenant_config(TENANT_CONF(tenant_id_));
   if (tenant_config.is_valid()) {
-    flush_interval = tenant_config->_flush_clog_aggregation_buffer_timeout;
+    const int64_t latency_slo = tenant_config->_clog_group_commit_latency_slo;
+    if (latency_slo > 0) {
+      flush_interval = group_commit_ctrl_.calc_flush_window(latency_slo);
+    } else {
+      flush_interval = tenant_config->_flush_clog_aggregation_buffer_timeout;
+    }
   }
   if (flush_interval <= 0) {
     inc_update(next_submit_aggre_buffer_, log_id + 1);
@@ -940,6 +947,9 @@ int ObLogSlidingWindow::submit_log(const ObLogType& log_type, const char* buff,
         cb->submit_timestamp_ = tmp_submit_timestamp;
         ret = fill_aggre_buffer_(tmp_log_id, tmp_offset, buff, size, tmp_submit_timestamp, cb);
       }
+      if (OB_SUCC(ret)) {
+        group_commit_ctrl_.record_arrival(ObClockGenerator::getClock(), size + AGGRE_LOG_RESERVED_SIZE);
+      }
       if (OB_SUCC(ret)) {
         if (OB_SUCCESS != (tmp_ret = try_freeze_aggre_buffer_(next_submit_aggre_buffer_))) {
           CLOG_LOG(ERROR, "try_freeze_aggre_buffer_ failed", K(ret), K(partition_key_));
@@ -24,6 +24,7 @@
 #include "ob_max_log_meta_info.h"
 #include "ob_log_flush_task.h"
 #include "ob_log_req.h"
+#include "ob_clog_group_commit_ctrl.h"
 
 namespace oceanbase {
 namespace common {
@@ -530,6 +531,10 @@ public:
   }
   int check_if_all_log_replayed(bool& has_replayed) const;
   int try_freeze_aggre_buffer();
+  const ObClogGroupCommitCtrl& get_group_commit_ctrl() const
+  {
+    return group_commit_ctrl_;
+  }
 
 private:
   int alloc_log_id_ts_(const int64_t base_timestamp, uint64_t& log_id, int64_t& submit_timestamp);
@@ -681,6 +686,7 @@ private:
   uint64_t next_submit_aggre_buffer_;
   uint64_t aggre_buffer_start_id_;
   uint64_t leader_max_unconfirmed_log_cnt_;
+  ObClogGroupCommitCtrl group_commit_ctrl_;
 
   uint64_t last_archive_checkpoint_log_id_;
   int64_t last_archive_checkpoint_ts_;  // default value is 0 rather than OB_INVALID_TIMESTAMP to guarantee
@@ -381,5 +381,62 @@ uint64_t ObClogVirtualStat::get_next_replay_ts_delta() const
   return next_replay_ts_delta;
 }
 
+int64_t ObClogVirtualStat::get_fsync_latency() const
+{
+  return ObClogGroupCommitCtrl::get_fsync_latency();
+}
+
+int64_t ObClogVirtualStat::get_log_arrival_interval() const
+{
+  int ret = OB_SUCCESS;
+  int64_t interval = 0;
+  if (NULL == sw_ || !is_inited_) {
+    ret = OB_NOT_INIT;
+    SERVER_LOG(WARN, "ObClogVirtualStat not init", K(ret), K_(partition_key), KP_(sw), K_(is_inited));
+  } else {
+    interval = sw_->get_group_commit_ctrl().get_arrival_interval();
+  }
+  return interval;
+}
+
+int64_t ObClogVirtualStat::get_group_commit_window() const
+{
+  int ret = OB_SUCCESS;
+  int64_t window = 0;
+  if (NULL == sw_ || !is_inited_) {
+    ret = OB_NOT_INIT;
+    SERVER_LOG(WARN, "ObClogVirtualStat not init", K(ret), K_(partition_key), KP_(sw), K_(is_inited));
+  } else {
+    window = sw_->get_group_commit_ctrl().get_flush_window();
+  }
+  return window;
+}
+
+int64_t ObClogVirtualStat::get_group_commit_delay_count() const
+{
+  int ret = OB_SUCCESS;
+  int64_t count = 0;
+  if (NULL == sw_ || !is_inited_) {
+    ret = OB_NOT_INIT;
+    SERVER_LOG(WARN, "ObClogVirtualStat not init", K(ret), K_(partition_key), KP_(sw), K_(is_inited));
+  } else {
+    count = sw_->get_group_commit_ctrl().get_delay_count();
+  }
+  return count;
+}
+
+int64_t ObClogVirtualStat::get_group_commit_immediate_count() const
+{
+  int ret = OB_SUCCESS;
+  int64_t count = 0;
+  if (NULL == sw_ || !is_inited_) {
+    ret = OB_NOT_INIT;
+    SERVER_LOG(WARN, "ObClogVirtualStat not init", K(ret), K_(partition_key), KP_(sw), K_(is_inited));
+  } else {
+    count = sw_->get_group_commit_ctrl().get_immediate_count();
+  }
+  return count;
+}
+
 }  // namespace clog
 }  // namespace oceanbase
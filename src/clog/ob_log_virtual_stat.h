@@ -53,6 +53,11 @@ public:
   int64_t get_quorum() const;
   bool is_need_rebuild() const;
   uint64_t get_next_replay_ts_delta() const;
+  int64_t get_fsync_latency() const;
+  int64_t get_log_arrival_interval() const;
+  int64_t get_group_commit_window() const;
+  int64_t get_group_commit_delay_count() const;
+  int64_t get_group_commit_immediate_count() const;
 
 private:
   bool is_inited_;
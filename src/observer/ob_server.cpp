@@ -50,6 +50,7 @@
 #include "sql/dtl/ob_dtl.h"
 #include "sql/ob_sql_init.h"
 #include "storage/blocksstable/ob_block_sstable_struct.h"
+#include "storage/blocksstable/ob_storage_cache_suite.h"
 #include "storage/ob_i_store.h"
 #include "storage/ob_long_ops_monitor.h"
 #include "share/partition_table/ob_partition_info.h"
@@ -538,6 +539,15 @@ int ObServer::start()
   }
   LOG_INFO("[NOTICE] check if timezone usable", K(ret), K(stop_), K(timezone_usable));
 
+  if (OB_SUCC(ret) && !stop_) {
+    // warm up the block cache before serving, a failure only leaves the block cache cold
+    int tmp_ret = OB_SUCCESS;
+    if (OB_SUCCESS != (tmp_ret = OB_STORE_CACHE.load_block_cache_snapshot())) {
+      LOG_WARN("fail to load block cache snapshot", K(tmp_ret));
+    }
+    LOG_INFO("[NOTICE] load block cache snapshot", K(tmp_ret));
+  }
+
   if (OB_SUCC(ret)) {
     if (stop_) {
       ret = OB_SERVER_IS_STOPPING;
@@ -1049,7 +1059,9 @@ int ObServer::init_io()
     static const double IO_MEMORY_RATIO = 0.2;
     if (OB_FAIL(ObIOManager::get_instance().init(GCONF.get_reserved_server_memory() * IO_MEMORY_RATIO,
             ObDiskManager::MAX_DISK_NUM,
-            ObIOManager::DEFAULT_IO_QUEUE_DEPTH))) {
+            ObIOManager::DEFAULT_IO_QUEUE_DEPTH,
+            get_io_engine_type(GCONF._io_engine.str()),
+            GCONF._io_uring_sqpoll))) {
       LOG_ERROR("init io manager fail, ", K(ret));
     } else {
       ObIOConfig io_config;
@@ -1650,6 +1662,9 @@ int ObServer::init_storage()
     storage_env_.clog_cache_priority_ = config_.clog_cache_priority;
     storage_env_.index_clog_cache_priority_ = config_.index_clog_cache_priority;
     storage_env_.bf_cache_miss_count_threshold_ = config_.bf_cache_miss_count_threshold;
+    storage_env_.secondary_block_cache_file_ = config_._secondary_block_cache_file;
+    storage_env_.secondary_block_cache_size_ = config_._secondary_block_cache_size;
+    storage_env_.block_cache_snapshot_file_ = config_._block_cache_snapshot_file;
 
     storage_env_.ethernet_speed_ = ethernet_speed_;
     storage_env_.disk_type_ = ObIOBenchmark::get_instance().get_disk_type();
@@ -203,6 +203,26 @@ int ObAllVirtualClogStat::inner_get_next_row(common::ObNewRow*& row)
               cur_row_.cells_[i].set_uint64(clog_stat->get_next_replay_ts_delta());
               break;
             }
+            case OB_APP_MIN_COLUMN_ID + 26: {
+              cur_row_.cells_[i].set_int(clog_stat->get_fsync_latency());
+              break;
+            }
+            case OB_APP_MIN_COLUMN_ID + 27: {
+              cur_row_.cells_[i].set_int(clog_stat->get_log_arrival_interval());
+              break;
+            }
+            case OB_APP_MIN_COLUMN_ID + 28: {
+              cur_row_.cells_[i].set_int(clog_stat->get_group_commit_window());
+              break;
+            }
+            case OB_APP_MIN_COLUMN_ID + 29: {
+              cur_row_.cells_[i].set_int(clog_stat->get_group_commit_delay_count());
+              break;
+            }
+            case OB_APP_MIN_COLUMN_ID + 30: {
+              cur_row_.cells_[i].set_int(clog_stat->get_group_commit_immediate_count());
+              break;
+            }
             default: {
               ret = OB_ERR_UNEXPECTED;
             }
@@ -24,6 +24,10 @@ using namespace memtable;
 void ObAllVirtualDeadlockStat::reset()
 {
   ObVirtualTableScannerIterator::reset();
+  start_to_read_ = false;
+  cycle_offset_ = 0;
+  cur_id_ = -1;
+  end_id_ = 0;
 }
 
 void ObAllVirtualDeadlockStat::destroy()
@@ -31,10 +35,119 @@ void ObAllVirtualDeadlockStat::destroy()
   ObVirtualTableScannerIterator::reset();
 }
 
+int ObAllVirtualDeadlockStat::get_next_cycle()
+{
+  int ret = OB_SUCCESS;
+  bool found = false;
+  while (OB_SUCC(ret) && !found) {
+    if (++cur_id_ >= end_id_) {
+      ret = OB_ITER_END;
+    } else if (OB_SUCCESS == get_global_deadlock_checker().get_cycle(cur_id_, cycle_)) {
+      found = (cycle_.edge_count_ > 0);
+      cycle_offset_ = 0;
+    } else {
+      // overwritten by newer cycles
+    }
+  }
+  return ret;
+}
+
 int ObAllVirtualDeadlockStat::inner_get_next_row(ObNewRow*& row)
 {
-  UNUSED(row);
-  return OB_NOT_SUPPORTED;
+  int ret = OB_SUCCESS;
+  if (!start_to_read_) {
+    int64_t start_id = 0;
+    int64_t end_id = 0;
+    get_global_deadlock_checker().get_cycle_id_range(start_id, end_id);
+    cur_id_ = static_cast<int32_t>(start_id) - 1;
+    end_id_ = static_cast<int32_t>(end_id);
+    cycle_offset_ = 0;
+    cycle_.edge_count_ = 0;
+    start_to_read_ = true;
+  }
+  if (OB_ISNULL(allocator_) || OB_ISNULL(cur_row_.cells_)) {
+    ret = OB_ERR_UNEXPECTED;
+    SERVER_LOG(ERROR, "invalid argument", K(ret), KP(allocator_), KP(cur_row_.cells_));
+  } else if (cycle_offset_ >= cycle_.edge_count_ && OB_FAIL(get_next_cycle())) {
+    if (OB_ITER_END != ret) {
+      SERVER_LOG(WARN, "get next cycle failed", K(ret));
+    }
+  } else {
+    const ObDeadLockEdge& edge = cycle_.edges_[cycle_offset_];
+    const int64_t col_count = output_column_ids_.count();
+    ObString ipstr;
+    for (int64_t i = 0; OB_SUCC(ret) && i < col_count; ++i) {
+      uint64_t col_id = output_column_ids_.at(i);
+      switch (col_id) {
+        case SVR_IP: {
+          ipstr.reset();
+          if (OB_FAIL(ObServerUtils::get_server_ip(allocator_, ipstr))) {
+            SERVER_LOG(ERROR, "get server ip failed", K(ret));
+          } else {
+            cur_row_.cells_[i].set_varchar(ipstr);
+            cur_row_.cells_[i].set_collation_type(ObCharset::get_default_collation(ObCharset::get_default_charset()));
+          }
+          break;
+        }
+        case SVR_PORT:
+          cur_row_.cells_[i].set_int(GCTX.self_addr_.get_port());
+          break;
+        case CYCLE_ID:
+          cur_row_.cells_[i].set_uint64(static_cast<uint64_t>(cycle_.cycle_id_));
+          break;
+        case CYCLE_SEQ:
+          cur_row_.cells_[i].set_int(cycle_offset_);
+          break;
+        case SESSION_ID:
+          cur_row_.cells_[i].set_int(edge.sessid_);
+          break;
+        case TABLE_ID:
+          cur_row_.cells_[i].set_int(edge.table_id_);
+          break;
+        case ROW_KEY: {
+          ObString row_key;
+          if (OB_FAIL(ob_write_string(*allocator_, ObString(edge.row_key_), row_key))) {
+            SERVER_LOG(WARN, "fail to deep copy row key", K(ret), K(edge));
+          } else {
+            cur_row_.cells_[i].set_varchar(row_key);
+            cur_row_.cells_[i].set_collation_type(ObCharset::get_default_collation(ObCharset::get_default_charset()));
+          }
+          break;
+        }
+        case WAITER_TRANS_ID:
+        case HOLDER_TRANS_ID: {
+          ObString trans_id;
+          const ObTransID& id = (WAITER_TRANS_ID == col_id ? edge.waiter_ : edge.holder_);
+          if (OB_FAIL(ob_write_string(*allocator_, ObString(to_cstring(id)), trans_id))) {
+            SERVER_LOG(WARN, "fail to deep copy trans id", K(ret), K(edge));
+          } else {
+            cur_row_.cells_[i].set_varchar(trans_id);
+            cur_row_.cells_[i].set_collation_type(ObCharset::get_default_collation(ObCharset::get_default_charset()));
+          }
+          break;
+        }
+        case DEADLOCK_ROLLBACKED:
+          // the waiter of the first edge is the victim
+          cur_row_.cells_[i].set_tinyint(0 == cycle_offset_ ? 1 : 0);
+          break;
+        case CYCLE_DETECT_TS:
+          cur_row_.cells_[i].set_int(cycle_.detect_ts_);
+          break;
+        case LOCK_WAIT_TS:
+          cur_row_.cells_[i].set_int(edge.lock_ts_);
+          break;
+        default:
+          ret = OB_ERR_UNEXPECTED;
+          SERVER_LOG(WARN, "invalid col_id", K(ret), K(col_id));
+          break;
+      }
+    }
+    if (OB_SUCC(ret)) {
+      ++cycle_offset_;
+      row = &cur_row_;
+    }
+  }
+  return ret;
 }
 
 }  // namespace observer
@@ -14,12 +14,13 @@
 #define OB_ALL_VIRTUAL_DEADLOCK_STAT_H_
 
 #include "share/ob_virtual_table_scanner_iterator.h"
+#include "storage/memtable/ob_deadlock_checker.h"
 
 namespace oceanbase {
 namespace observer {
 class ObAllVirtualDeadlockStat : public common::ObVirtualTableScannerIterator {
 public:
-  ObAllVirtualDeadlockStat() : start_to_read_(false), cycle_offset_(0), cur_id_(-1), end_id_(0)
+  ObAllVirtualDeadlockStat() : start_to_read_(false), cycle_offset_(0), cur_id_(-1), end_id_(0), cycle_()
   {}
   virtual ~ObAllVirtualDeadlockStat()
   {
@@ -31,6 +32,10 @@ public:
   virtual void reset();
   virtual void destroy();
 
+private:
+  // fetch the next cycle kept in the history of the deadlock checker
+  int get_next_cycle();
+
 private:
   enum {
     SVR_IP = common::OB_APP_MIN_COLUMN_ID,
@@ -52,6 +57,7 @@ private:
   uint32_t cycle_offset_;
   int32_t cur_id_;
   int32_t end_id_;
+  memtable::ObDeadLockCycle cycle_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(ObAllVirtualDeadlockStat);
@@ -56,7 +56,10 @@ private:
     TOTAL_PUT_CNT,
     TOTAL_HIT_CNT,
     TOTAL_MISS_CNT,
-    HOLD_SIZE
+    HOLD_SIZE,
+    TOTAL_ADMIT_CNT,
+    TOTAL_PROBATION_CNT,
+    TOTAL_PROMOTE_CNT
   };
   common::ObAddr* addr_;
   common::ObString ipstr_;
@@ -18,6 +18,8 @@
 #include "lib/allocator/ob_malloc.h"
 #include "lib/hash/ob_hashutils.h"
 #include "lib/container/ob_fixed_array.h"
+#include "lib/atomic/ob_atomic.h"
+#include "lib/utility/utility.h"
 
 namespace oceanbase {
 namespace common {
@@ -551,6 +553,171 @@ void ObSimpleFixedArray<T>::destroy()
   local_allocator_.reset();
   inited_ = false;
 }
+
+// count-min sketch with 4-bit counters, estimates the access frequency of cache keys for kvcache admission.
+// All counters are halved every sample_size_ increments, so that the frequency reflects recent accesses.
+class ObFrequencySketch {
+public:
+  static const int64_t MAX_FREQUENCY = 15;
+  static const int64_t MIN_TABLE_SIZE = 64;
+  static const int64_t MAX_TABLE_SIZE = 1L << 20;  // 8MB
+  static const int64_t SAMPLE_FACTOR = 10;
+
+public:
+  ObFrequencySketch();
+  virtual ~ObFrequencySketch();
+  int init(const int64_t capacity, const char* label);
+  void destroy();
+  void increment(const uint64_t hash);
+  int64_t frequency(const uint64_t hash) const;
+  TO_STRING_KV(K_(inited), K_(table_size), K_(sample_size), K_(size));
+
+private:
+  static uint64_t spread(const uint64_t hash);
+  int64_t index_of(const uint64_t hash, const int64_t i) const;
+  bool increment_at(const int64_t idx, const int64_t offset);
+  void halve();
+
+private:
+  static const uint64_t RESET_MASK = 0x7777777777777777ULL;
+  bool inited_;
+  common::ObArenaAllocator allocator_;
+  uint64_t* table_;
+  int64_t table_size_;
+  int64_t sample_size_;
+  int64_t size_;
+};
+
+inline ObFrequencySketch::ObFrequencySketch()
+    : inited_(false), allocator_(), table_(NULL), table_size_(0), sample_size_(0), size_(0)
+{}
+
+inline ObFrequencySketch::~ObFrequencySketch()
+{
+  destroy();
+}
+
+inline int ObFrequencySketch::init(const int64_t capacity, const char* label)
+{
+  int ret = common::OB_SUCCESS;
+  if (inited_) {
+    ret = common::OB_INIT_TWICE;
+    SHARE_LOG(WARN, "init twice", K(ret));
+  } else if (capacity <= 0 || nullptr == label) {
+    ret = common::OB_INVALID_ARGUMENT;
+    SHARE_LOG(WARN, "invalid arguments", K(ret), K(capacity), K(label));
+  } else {
+    const int64_t table_size = std::min(MAX_TABLE_SIZE, next_pow2(std::max(MIN_TABLE_SIZE, capacity)));
+    allocator_.set_label(label);
+    if (OB_ISNULL(table_ = static_cast<uint64_t*>(allocator_.alloc(sizeof(uint64_t) * table_size)))) {
+      ret = common::OB_ALLOCATE_MEMORY_FAILED;
+      SHARE_LOG(WARN, "alloc memory failed", K(ret), K(table_size));
+    } else {
+      MEMSET(table_, 0, sizeof(uint64_t) * table_size);
+      table_size_ = table_size;
+      sample_size_ = SAMPLE_FACTOR * table_size;
+      size_ = 0;
+      inited_ = true;
+    }
+  }
+  return ret;
+}
+
+inline void ObFrequencySketch::destroy()
+{
+  if (inited_) {
+    allocator_.free(table_);
+    allocator_.reset();
+    table_ = NULL;
+    table_size_ = 0;
+    sample_size_ = 0;
+    size_ = 0;
+    inited_ = false;
+  }
+}
+
+inline void ObFrequencySketch::increment(const uint64_t hash)
+{
+  if (inited_) {
+    const uint64_t h = spread(hash);
+    // each hash function uses a different counter of its word
+    const int64_t start = static_cast<int64_t>(h & 3) << 2;
+    bool added = false;
+    for (int64_t i = 0; i < 4; ++i) {
+      added |= increment_at(index_of(h, i), (start + i) << 2);
+    }
+    if (added && sample_size_ == ATOMIC_AAF(&size_, 1)) {
+      halve();
+      (void)ATOMIC_SAF(&size_, sample_size_ / 2);
+    }
+  }
+}
+
+inline int64_t ObFrequencySketch::frequency(const uint64_t hash) const
+{
+  int64_t freq = 0;
+  if (inited_) {
+    const uint64_t h = spread(hash);
+    const int64_t start = static_cast<int64_t>(h & 3) << 2;
+    freq = MAX_FREQUENCY;
+    for (int64_t i = 0; i < 4; ++i) {
+      const int64_t offset = (start + i) << 2;
+      const int64_t count = static_cast<int64_t>((ATOMIC_LOAD(&table_[index_of(h, i)]) >> offset) & 0xfULL);
+      freq = std::min(freq, count);
+    }
+  }
+  return freq;
+}
+
+inline uint64_t ObFrequencySketch::spread(const uint64_t hash)
+{
+  uint64_t h = hash;
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+inline int64_t ObFrequencySketch::index_of(const uint64_t hash, const int64_t i) const
+{
+  static const uint64_t SEEDS[4] = {
+      0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL, 0x9ae16a3b2f90404fULL, 0xcbf29ce484222325ULL};
+  uint64_t h = (hash + SEEDS[i]) * SEEDS[i];
+  h += h >> 32;
+  return static_cast<int64_t>(h & (table_size_ - 1));
+}
+
+inline bool ObFrequencySketch::increment_at(const int64_t idx, const int64_t offset)
+{
+  bool added = false;
+  const uint64_t mask = 0xfULL << offset;
+  uint64_t old_value = ATOMIC_LOAD(&table_[idx]);
+  while ((old_value & mask) != mask) {
+    const uint64_t cur_value = ATOMIC_VCAS(&table_[idx], old_value, old_value + (1ULL << offset));
+    if (cur_value == old_value) {
+      added = true;
+      break;
+    }
+    old_value = cur_value;
+  }
+  return added;
+}
+
+inline void ObFrequencySketch::halve()
+{
+  for (int64_t i = 0; i < table_size_; ++i) {
+    uint64_t old_value = ATOMIC_LOAD(&table_[i]);
+    while (true) {
+      const uint64_t cur_value = ATOMIC_VCAS(&table_[i], old_value, (old_value >> 1) & RESET_MASK);
+      if (cur_value == old_value) {
+        break;
+      }
+      old_value = cur_value;
+    }
+  }
+}
 }  // end namespace common
 }  // end namespace oceanbase
 
@@ -283,7 +283,12 @@ int ObKVGlobalCache::put(ObIKVCacheStore<MBWrapper>& store, const int64_t cache_
     COMMON_LOG(WARN, "The inst is NULL, ", K(ret));
   } else if (!overwrite && (OB_SUCC(map_.get(cache_id, key, pvalue, mb_handle)))) {
     ret = OB_ENTRY_EXIST;
-  } else if (OB_FAIL(store.store(*inst_handle.get_inst(), key, value, kvpair, mb_wrapper))) {
+  } else if (OB_FAIL(store.store(*inst_handle.get_inst(),
+                 key,
+                 value,
+                 kvpair,
+                 mb_wrapper,
+                 get_admit_policy(*inst_handle.get_inst(), key)))) {
     COMMON_LOG(WARN, "Fail to store kvpair to store, ", K(ret));
   } else {
     mb_handle = mb_wrapper->get_mb_handle();
@@ -306,13 +311,15 @@ int ObKVGlobalCache::put(ObIKVCacheStore<MBWrapper>& store, const int64_t cache_
 }
 
 int ObKVGlobalCache::alloc(const int64_t cache_id, const uint64_t tenant_id, const int64_t key_size,
-    const int64_t value_size, ObKVCachePair*& kvpair, ObKVMemBlockHandle*& mb_handle, ObKVCacheInstHandle& inst_handle)
+    const int64_t value_size, ObKVCachePair*& kvpair, ObKVMemBlockHandle*& mb_handle, ObKVCacheInstHandle& inst_handle,
+    const ObIKVCacheKey* key)
 {
-  return alloc(store_, cache_id, tenant_id, key_size, value_size, kvpair, mb_handle, inst_handle);
+  return alloc(store_, cache_id, tenant_id, key_size, value_size, kvpair, mb_handle, inst_handle, key);
 }
 
 int ObKVGlobalCache::alloc(ObWorkingSet* working_set, const uint64_t tenant_id, const int64_t key_size,
-    const int64_t value_size, ObKVCachePair*& kvpair, ObKVMemBlockHandle*& mb_handle, ObKVCacheInstHandle& inst_handle)
+    const int64_t value_size, ObKVCachePair*& kvpair, ObKVMemBlockHandle*& mb_handle, ObKVCacheInstHandle& inst_handle,
+    const ObIKVCacheKey* key)
 {
   int ret = OB_SUCCESS;
   if (OB_ISNULL(working_set)) {
@@ -325,7 +332,8 @@ int ObKVGlobalCache::alloc(ObWorkingSet* working_set, const uint64_t tenant_id,
                  value_size,
                  kvpair,
                  mb_handle,
-                 inst_handle))) {
+                 inst_handle,
+                 key))) {
     COMMON_LOG(WARN, "failed to alloc kvpair", K(ret));
   }
   return ret;
@@ -334,11 +342,12 @@ int ObKVGlobalCache::alloc(ObWorkingSet* working_set, const uint64_t tenant_id,
 template <typename MBWrapper>
 int ObKVGlobalCache::alloc(ObIKVCacheStore<MBWrapper>& store, const int64_t cache_id, const uint64_t tenant_id,
     const int64_t key_size, const int64_t value_size, ObKVCachePair*& kvpair, ObKVMemBlockHandle*& mb_handle,
-    ObKVCacheInstHandle& inst_handle)
+    ObKVCacheInstHandle& inst_handle, const ObIKVCacheKey* key)
 {
   int ret = OB_SUCCESS;
   ObKVCacheInstKey inst_key(cache_id, tenant_id);
   MBWrapper* mb_wrapper = nullptr;
+  enum ObKVCachePolicy policy = LRU;
   if (OB_UNLIKELY(!inited_)) {
     ret = OB_NOT_INIT;
     COMMON_LOG(WARN, "The ObKVCache has not been inited, ", K(ret));
@@ -347,7 +356,9 @@ int ObKVGlobalCache::alloc(ObIKVCacheStore<MBWrapper>& store, const int64_t cach
   } else if (OB_ISNULL(inst_handle.get_inst())) {
     ret = OB_ERR_UNEXPECTED;
     COMMON_LOG(WARN, "The inst is NULL, ", K(ret));
-  } else if (OB_FAIL(store.alloc_kvpair(*inst_handle.get_inst(), key_size, value_size, kvpair, mb_wrapper))) {
+  } else if (FALSE_IT(policy = (NULL == key) ? LRU : get_admit_policy(*inst_handle.get_inst(), *key))) {
+  } else if (OB_FAIL(
+                 store.alloc_kvpair(*inst_handle.get_inst(), key_size, value_size, kvpair, mb_wrapper, policy))) {
     COMMON_LOG(WARN, "Fail to store kvpair, ", K(ret));
   } else {
     mb_handle = mb_wrapper->get_mb_handle();
@@ -355,6 +366,15 @@ int ObKVGlobalCache::alloc(ObIKVCacheStore<MBWrapper>& store, const int64_t cach
   return ret;
 }
 
+enum ObKVCachePolicy ObKVGlobalCache::get_admit_policy(ObKVCacheInst& inst, const ObIKVCacheKey& key)
+{
+  enum ObKVCachePolicy policy = LRU;
+  if (GCONF._enable_kvcache_admission) {
+    policy = map_.get_admit_policy(inst, key);
+  }
+  return policy;
+}
+
 int ObKVGlobalCache::get(
     const int64_t cache_id, const ObIKVCacheKey& key, const ObIKVCacheValue*& pvalue, ObKVMemBlockHandle*& mb_handle)
 {
@@ -364,7 +384,7 @@ int ObKVGlobalCache::get(
     COMMON_LOG(WARN, "The ObKVGlobalCache has not been inited, ", K(ret));
   } else {
     revert(mb_handle);
-    if (OB_FAIL(map_.get(cache_id, key, pvalue, mb_handle))) {
+    if (OB_FAIL(map_.get(cache_id, key, pvalue, mb_handle, GCONF._enable_kvcache_admission))) {
       if (OB_ENTRY_NOT_EXIST != ret) {
         COMMON_LOG(WARN, "fail to get value from map, ", K(ret));
       }
@@ -525,6 +545,7 @@ void ObKVGlobalCache::deregister_cache(const int64_t cache_id)
   } else {
     lib::ObMutexGuard guard(mutex_);
     configs_[cache_id].is_valid_ = false;
+    ATOMIC_STORE(&configs_[cache_id].wash_callback_, NULL);
   }
 
   if (OB_SUCC(ret)) {
@@ -589,6 +610,22 @@ int ObKVGlobalCache::set_priority(const int64_t cache_id, const int64_t priority
   return ret;
 }
 
+int ObKVGlobalCache::set_wash_callback(const int64_t cache_id, ObIKVCacheWashCallback* callback)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!inited_)) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "The ObKVGlobalCache has not been inited, ", K(ret));
+  } else if (OB_UNLIKELY(cache_id < 0) || OB_UNLIKELY(cache_id >= MAX_CACHE_NUM)) {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "Invalid argument, ", K(cache_id), K(ret));
+  } else {
+    lib::ObMutexGuard guard(mutex_);
+    ATOMIC_STORE(&configs_[cache_id].wash_callback_, callback);
+  }
+  return ret;
+}
+
 void ObKVGlobalCache::wash()
 {
   if (inited_ && !start_destory_) {
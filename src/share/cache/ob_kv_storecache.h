@@ -40,8 +40,9 @@ public:
       const Key& key, const Value& value, const Value*& pvalue, ObKVCacheHandle& handle, bool overwrite = true) = 0;
   virtual int get(const Key& key, const Value*& pvalue, ObKVCacheHandle& handle) = 0;
   virtual int erase(const Key& key) = 0;
+  // %key is passed to the admission policy of kvcache if not NULL
   virtual int alloc(const uint64_t tenant_id, const int64_t key_size, const int64_t value_size, ObKVCachePair*& kvpair,
-      ObKVCacheHandle& handle, ObKVCacheInstHandle& inst_handle) = 0;
+      ObKVCacheHandle& handle, ObKVCacheInstHandle& inst_handle, const Key* key = NULL) = 0;
   virtual int put_kvpair(
       ObKVCacheInstHandle& inst_handle, ObKVCachePair* kvpair, ObKVCacheHandle& handle, bool overwrite = true);
 };
@@ -54,6 +55,8 @@ public:
   int init(const char* cache_name, const int64_t priority = 1);
   void destroy();
   int set_priority(const int64_t priority);
+  // %callback is notified of the kv pairs of this cache washed out of memory, NULL to unset
+  int set_wash_callback(ObIKVCacheWashCallback* callback);
   virtual int put(const Key& key, const Value& value, bool overwrite = true) override;
   virtual int put_and_fetch(const Key& key, const Value& value, const Value*& pvalue, ObKVCacheHandle& handle,
       bool overwrite = true) override;
@@ -61,7 +64,7 @@ public:
   int get_iterator(ObKVCacheIterator& iter);
   virtual int erase(const Key& key) override;
   virtual int alloc(const uint64_t tenant_id, const int64_t key_size, const int64_t value_size, ObKVCachePair*& kvpair,
-      ObKVCacheHandle& handle, ObKVCacheInstHandle& inst_handle) override;
+      ObKVCacheHandle& handle, ObKVCacheInstHandle& inst_handle, const Key* key = NULL) override;
   int64_t size(const uint64_t tenant_id = OB_SYS_TENANT_ID) const;
   int64_t count(const uint64_t tenant_id = OB_SYS_TENANT_ID) const;
   int64_t get_hit_cnt(const uint64_t tenant_id = OB_SYS_TENANT_ID) const;
@@ -103,7 +106,7 @@ public:
     return working_set_->get_limit();
   }
   virtual int alloc(const uint64_t tenant_id, const int64_t key_size, const int64_t value_size, ObKVCachePair*& kvpair,
-      ObKVCacheHandle& handle, ObKVCacheInstHandle& inst_handle) override;
+      ObKVCacheHandle& handle, ObKVCacheInstHandle& inst_handle, const Key* key = NULL) override;
 
 private:
   bool inited_;
@@ -154,6 +157,7 @@ private:
   int create_working_set(const ObKVCacheInstKey& inst_key, ObWorkingSet*& working_set);
   int delete_working_set(ObWorkingSet* working_set);
   int set_priority(const int64_t cache_id, const int64_t priority);
+  int set_wash_callback(const int64_t cache_id, ObIKVCacheWashCallback* callback);
   int put(const int64_t cache_id, const ObIKVCacheKey& key, const ObIKVCacheValue& value,
       const ObIKVCacheValue*& pvalue, ObKVMemBlockHandle*& mb_handle, bool overwrite = true);
   int put(ObWorkingSet* working_set, const ObIKVCacheKey& key, const ObIKVCacheValue& value,
@@ -162,14 +166,17 @@ private:
   int put(ObIKVCacheStore<MBWrapper>& store, const int64_t cache_id, const ObIKVCacheKey& key,
       const ObIKVCacheValue& value, const ObIKVCacheValue*& pvalue, ObKVMemBlockHandle*& mb_handle,
       bool overwrite = true);
+  // %key is only used by the admission policy, kv pairs allocated without key are admitted to LRU directly
   int alloc(const int64_t cache_id, const uint64_t tenant_id, const int64_t key_size, const int64_t value_size,
-      ObKVCachePair*& kvpair, ObKVMemBlockHandle*& mb_handle, ObKVCacheInstHandle& inst_handle);
+      ObKVCachePair*& kvpair, ObKVMemBlockHandle*& mb_handle, ObKVCacheInstHandle& inst_handle,
+      const ObIKVCacheKey* key = NULL);
   int alloc(ObWorkingSet* working_set, const uint64_t tenant_id, const int64_t key_size, const int64_t value_size,
-      ObKVCachePair*& kvpair, ObKVMemBlockHandle*& mb_handle, ObKVCacheInstHandle& inst_handle);
+      ObKVCachePair*& kvpair, ObKVMemBlockHandle*& mb_handle, ObKVCacheInstHandle& inst_handle,
+      const ObIKVCacheKey* key = NULL);
   template <typename MBWrapper>
   int alloc(ObIKVCacheStore<MBWrapper>& store, const int64_t cache_id, const uint64_t tenant_id, const int64_t key_size,
       const int64_t value_size, ObKVCachePair*& kvpair, ObKVMemBlockHandle*& mb_handle,
-      ObKVCacheInstHandle& inst_handle);
+      ObKVCacheInstHandle& inst_handle, const ObIKVCacheKey* key);
   int get(
       const int64_t cache_id, const ObIKVCacheKey& key, const ObIKVCacheValue*& pvalue, ObKVMemBlockHandle*& mb_handle);
   int erase(const int64_t cache_id, const ObIKVCacheKey& key);
@@ -178,6 +185,9 @@ private:
   void replace_map();
   int get_cache_id(const char* cache_name, int64_t& cache_id);
 
+private:
+  enum ObKVCachePolicy get_admit_policy(ObKVCacheInst& inst, const ObIKVCacheKey& key);
+
 private:
   static const int64_t DEFAULT_BUCKET_NUM = 10000000L;
   static const int64_t DEFAULT_MAX_CACHE_SIZE = 1024L * 1024L * 1024L * 1024L;  // 1T
@@ -276,6 +286,9 @@ public:
    */
   template <class Key, class Value>
   int get_next_kvpair(const Key*& key, const Value*& value, ObKVCacheHandle& handle);
+  // same as above, and %get_cnt is the number of gets of the kvpair since it was put
+  template <class Key, class Value>
+  int get_next_kvpair(const Key*& key, const Value*& value, int64_t& get_cnt, ObKVCacheHandle& handle);
   void reset();
 
 private:
@@ -370,6 +383,19 @@ int ObKVCache<Key, Value>::set_priority(const int64_t priority)
   return ret;
 }
 
+template <class Key, class Value>
+int ObKVCache<Key, Value>::set_wash_callback(ObIKVCacheWashCallback* callback)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!inited_)) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "The ObKVCache has not been inited, ", K(ret));
+  } else if (OB_FAIL(ObKVGlobalCache::get_instance().set_wash_callback(cache_id_, callback))) {
+    COMMON_LOG(WARN, "Fail to set wash callback, ", K(ret));
+  }
+  return ret;
+}
+
 template <class Key, class Value>
 int64_t ObKVCache<Key, Value>::size(const uint64_t tenant_id) const
 {
@@ -537,14 +563,14 @@ int ObKVCache<Key, Value>::erase(const Key& key)
 
 template <class Key, class Value>
 int ObKVCache<Key, Value>::alloc(const uint64_t tenant_id, const int64_t key_size, const int64_t value_size,
-    ObKVCachePair*& kvpair, ObKVCacheHandle& handle, ObKVCacheInstHandle& inst_handle)
+    ObKVCachePair*& kvpair, ObKVCacheHandle& handle, ObKVCacheInstHandle& inst_handle, const Key* key)
 {
   int ret = OB_SUCCESS;
   if (OB_UNLIKELY(!inited_)) {
     ret = OB_NOT_INIT;
     COMMON_LOG(WARN, "The ObKVCache has not been inited, ", K(ret));
   } else if (OB_FAIL(ObKVGlobalCache::get_instance().alloc(
-                 cache_id_, tenant_id, key_size, value_size, kvpair, handle.mb_handle_, inst_handle))) {
+                 cache_id_, tenant_id, key_size, value_size, kvpair, handle.mb_handle_, inst_handle, key))) {
     COMMON_LOG(WARN, "failed to alloc", K(ret));
   }
 
@@ -573,6 +599,13 @@ int64_t ObKVCache<Key, Value>::store_size(const uint64_t tenant_id) const
  */
 template <class Key, class Value>
 int ObKVCacheIterator::get_next_kvpair(const Key*& key, const Value*& value, ObKVCacheHandle& handle)
+{
+  int64_t get_cnt = 0;
+  return get_next_kvpair(key, value, get_cnt, handle);
+}
+
+template <class Key, class Value>
+int ObKVCacheIterator::get_next_kvpair(const Key*& key, const Value*& value, int64_t& get_cnt, ObKVCacheHandle& handle)
 {
   int ret = OB_SUCCESS;
   ObKVCacheMap::Node node;
@@ -604,6 +637,7 @@ int ObKVCacheIterator::get_next_kvpair(const Key*& key, const Value*& value, ObK
     handle.reset();
     key = reinterpret_cast<const Key*>(node.key_);
     value = reinterpret_cast<const Value*>(node.value_);
+    get_cnt = node.get_cnt_;
     handle.mb_handle_ = node.mb_handle_;
   }
   return ret;
@@ -743,14 +777,14 @@ int ObCacheWorkingSet<Key, Value>::erase(const Key& key)
 
 template <class Key, class Value>
 int ObCacheWorkingSet<Key, Value>::alloc(const uint64_t tenant_id, const int64_t key_size, const int64_t value_size,
-    ObKVCachePair*& kvpair, ObKVCacheHandle& handle, ObKVCacheInstHandle& inst_handle)
+    ObKVCachePair*& kvpair, ObKVCacheHandle& handle, ObKVCacheInstHandle& inst_handle, const Key* key)
 {
   int ret = common::OB_SUCCESS;
   if (!inited_) {
     ret = OB_NOT_INIT;
     COMMON_LOG(WARN, "ObCacheWorkingSet is not inited", K(ret));
   } else if (OB_FAIL(ObKVGlobalCache::get_instance().alloc(
-                 working_set_, tenant_id, key_size, value_size, kvpair, handle.mb_handle_, inst_handle))) {
+                 working_set_, tenant_id, key_size, value_size, kvpair, handle.mb_handle_, inst_handle, key))) {
     COMMON_LOG(WARN, "failed to alloc", K(ret));
   }
   return ret;
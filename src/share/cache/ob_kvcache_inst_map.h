@@ -107,7 +107,7 @@ struct ObKVCacheInst {
   {
     return 1 == ATOMIC_LOAD(&ref_cnt_) && 0 == ATOMIC_LOAD(&status_.kv_cnt_) &&
            0 == ATOMIC_LOAD(&status_.store_size_) && 0 == ATOMIC_LOAD(&status_.lru_mb_cnt_) &&
-           0 == ATOMIC_LOAD(&status_.lfu_mb_cnt_);
+           0 == ATOMIC_LOAD(&status_.lfu_mb_cnt_) && 0 == ATOMIC_LOAD(&status_.probation_mb_cnt_);
   }
   void reset()
   {
@@ -35,6 +35,8 @@ int ObKVCacheMap::init(const int64_t bucket_num, ObKVCacheStore* store)
     COMMON_LOG(WARN, "Invalid arguments, ", K(bucket_num), K(store), K(ret));
   } else if (OB_FAIL(bucket_lock_.init(bucket_num, ObLatchIds::KV_CACHE_BUCKET_LOCK, ObNewModIds::OB_KVSTORE_CACHE))) {
     COMMON_LOG(WARN, "Fail to init bucket lock, ", K(bucket_num), K(ret));
+  } else if (OB_FAIL(sketch_.init(bucket_num, ObModIds::OB_KVSTORE_CACHE))) {
+    COMMON_LOG(WARN, "Fail to init frequency sketch, ", K(bucket_num), K(ret));
   } else {
     const int64_t bucket_cnt =
         bucket_num % Bucket::BUCKET_SIZE == 0 ? bucket_num / Bucket::BUCKET_SIZE : bucket_num / Bucket::BUCKET_SIZE + 1;
@@ -94,6 +96,7 @@ void ObKVCacheMap::destroy()
     buckets_ = NULL;
   }
   bucket_lock_.destroy();
+  sketch_.destroy();
   bucket_num_ = 0;
   store_ = NULL;
   is_inited_ = false;
@@ -200,8 +203,8 @@ int ObKVCacheMap::put(ObKVCacheInst& inst, const ObIKVCacheKey& key, const ObKVC
   return ret;
 }
 
-int ObKVCacheMap::get(
-    const int64_t cache_id, const ObIKVCacheKey& key, const ObIKVCacheValue*& pvalue, ObKVMemBlockHandle*& out_handle)
+int ObKVCacheMap::get(const int64_t cache_id, const ObIKVCacheKey& key, const ObIKVCacheValue*& pvalue,
+    ObKVMemBlockHandle*& out_handle, const bool record_access)
 {
   int ret = OB_SUCCESS;
 
@@ -211,6 +214,7 @@ int ObKVCacheMap::get(
   } else {
     const uint64_t tenant_id = key.get_tenant_id();
     bool need_modify = false;
+    bool need_record = false;
     uint64_t hash_code = key.hash() + cache_id;
     uint64_t bucket_pos = hash_code % bucket_num_;
     Node* iter = NULL;
@@ -247,9 +251,13 @@ int ObKVCacheMap::get(
             out_handle = iter->mb_handle_;
             if (LRU == out_handle->policy_) {
               need_modify = need_modify_cache(iter->get_cnt_, out_handle->get_cnt_, out_handle->kv_cnt_);
+            } else if (PROBATION == out_handle->policy_) {
+              need_modify = true;
             }
             out_handle->get_cnt_++;
             out_handle->recent_get_cnt_++;
+            // the first hit is always counted, so a pair hit once before being washed is admitted on reload
+            need_record = record_access && 0 == (iter->get_cnt_ & (HIT_SAMPLE_RATE - 1));
             iter->get_cnt_++;
           }
         } else {
@@ -260,6 +268,9 @@ int ObKVCacheMap::get(
 
     if (OB_SUCC(ret)) {
       out_handle->inst_->status_.total_hit_cnt_.inc();
+      if (need_record) {
+        sketch_.increment(hash_code);
+      }
       if (need_modify) {
         // need add write lock and do some modification
         ObBucketWLockGuard wr_guard(bucket_lock_, bucket_pos);
@@ -280,7 +291,7 @@ int ObKVCacheMap::get(
                   internal_map_replace(prev, iter, bucket_pos);
                 }
 
-                if (iter->mb_handle_ == out_handle && LRU == out_handle->policy_) {
+                if (iter->mb_handle_ == out_handle && LFU != out_handle->policy_) {
                   if (hash_code == iter->hash_code_ && key == *(iter->key_)) {
                     move_node = iter;
                   }
@@ -294,7 +305,12 @@ int ObKVCacheMap::get(
             }
 
             if (OB_NOT_NULL(move_node)) {
-              internal_data_move(move_node, LFU);
+              if (PROBATION == out_handle->policy_) {
+                internal_data_move(move_node, LRU);
+                out_handle->inst_->status_.total_promote_cnt_.inc();
+              } else {
+                internal_data_move(move_node, LFU);
+              }
             }
           }
         }
@@ -305,6 +321,22 @@ int ObKVCacheMap::get(
   return ret;
 }
 
+enum ObKVCachePolicy ObKVCacheMap::get_admit_policy(ObKVCacheInst& inst, const ObIKVCacheKey& key)
+{
+  enum ObKVCachePolicy policy = LRU;
+  if (OB_LIKELY(is_inited_)) {
+    const uint64_t hash_code = key.hash() + inst.cache_id_;
+    sketch_.increment(hash_code);
+    if (sketch_.frequency(hash_code) >= ADMIT_FREQUENCY) {
+      inst.status_.total_admit_cnt_.inc();
+    } else {
+      policy = PROBATION;
+      inst.status_.total_probation_cnt_.inc();
+    }
+  }
+  return policy;
+}
+
 int ObKVCacheMap::erase(ObKVCacheInst& inst, const ObIKVCacheKey& key)
 {
   int ret = OB_SUCCESS;
@@ -15,6 +15,7 @@
 
 #include "lib/allocator/ob_malloc.h"
 #include "lib/lock/ob_bucket_lock.h"
+#include "share/cache/ob_cache_utils.h"
 #include "share/cache/ob_kvcache_struct.h"
 #include "share/cache/ob_kvcache_store.h"
 
@@ -35,9 +36,14 @@ public:
   int replace_fragment_node(int64_t& start_pos, const int64_t replace_num);
   int put(ObKVCacheInst& inst, const ObIKVCacheKey& key, const ObKVCachePair* kvpair, ObKVMemBlockHandle* mb_handle,
       bool overwrite = true);
+  // %record_access: count the hit in the admission sketch, only one of every HIT_SAMPLE_RATE hits of a
+  // kv pair is counted to keep the sketch update off the hot path of frequently accessed pairs
   int get(const int64_t cache_id, const ObIKVCacheKey& key, const ObIKVCacheValue*& pvalue,
-      ObKVMemBlockHandle*& out_handle);
+      ObKVMemBlockHandle*& out_handle, const bool record_access = false);
   int erase(ObKVCacheInst& inst, const ObIKVCacheKey& key);
+  // record a put of %key and decide which memblock it should be stored in, kv pairs whose key has not been
+  // accessed recently go to PROBATION and are promoted to LRU on their first hit
+  enum ObKVCachePolicy get_admit_policy(ObKVCacheInst& inst, const ObIKVCacheKey& key);
 
 private:
   friend class ObKVCacheIterator;
@@ -79,12 +85,15 @@ private:
   Node*& get_bucket_node(const int64_t idx);
 
 private:
+  static const int64_t ADMIT_FREQUENCY = 2;
+  static const int64_t HIT_SAMPLE_RATE = 8;
   bool is_inited_;
   ObMalloc bucket_allocator_;
   int64_t bucket_num_;
   Bucket** buckets_;
   ObBucketLock bucket_lock_;
   ObKVCacheStore* store_;
+  ObFrequencySketch sketch_;
 };
 
 }  // end namespace common
@@ -600,8 +600,10 @@ int ObKVCacheStore::alloc_mbhandle(
       (void)ATOMIC_AAF(&inst.status_.store_size_, block_size);
       if (LRU == policy) {
         (void)ATOMIC_AAF(&inst.status_.lru_mb_cnt_, 1);
-      } else {
+      } else if (LFU == policy) {
         (void)ATOMIC_AAF(&inst.status_.lfu_mb_cnt_, 1);
+      } else {
+        (void)ATOMIC_AAF(&inst.status_.probation_mb_cnt_, 1);
       }
       mb_handle->inst_ = &inst;
       mb_handle->policy_ = policy;
@@ -859,8 +861,17 @@ int ObKVCacheStore::do_wash_mb(ObKVMemBlockHandle* mb_handle, void*& buf, int64_
           mb_handle->mem_block_->get_payload_size() + sizeof(ObKVStoreMemBlock));
       if (mb_handle->policy_ == LRU) {
         (void)ATOMIC_SAF(&mb_handle->inst_->status_.lru_mb_cnt_, 1);
-      } else {
+      } else if (mb_handle->policy_ == LFU) {
         (void)ATOMIC_SAF(&mb_handle->inst_->status_.lfu_mb_cnt_, 1);
+      } else {
+        (void)ATOMIC_SAF(&mb_handle->inst_->status_.probation_mb_cnt_, 1);
+      }
+      // no one refers to the memblock now, every kv pair in it is complete
+      if (NULL != mb_handle->inst_->status_.config_) {
+        ObIKVCacheWashCallback* wash_callback = ATOMIC_LOAD(&mb_handle->inst_->status_.config_->wash_callback_);
+        if (NULL != wash_callback) {
+          mb_handle->mem_block_->notify_wash(*wash_callback);
+        }
       }
     }
     buf = mb_handle->mem_block_;
@@ -17,7 +17,7 @@ namespace common {
 /**
  * ------------------------------------------------------------ObKVCacheConfig---------------------------------------------------------
  */
-ObKVCacheConfig::ObKVCacheConfig() : is_valid_(false), priority_(0)
+ObKVCacheConfig::ObKVCacheConfig() : is_valid_(false), priority_(0), wash_callback_(NULL)
 {
   MEMSET(cache_name_, 0, MAX_CACHE_NAME_LENGTH);
 }
@@ -27,6 +27,7 @@ void ObKVCacheConfig::reset()
   is_valid_ = false;
   priority_ = 0;
   MEMSET(cache_name_, 0, MAX_CACHE_NAME_LENGTH);
+  wash_callback_ = NULL;
 }
 
 /**
@@ -56,8 +57,12 @@ void ObKVCacheStatus::reset()
   map_size_ = 0;
   lru_mb_cnt_ = 0;
   lfu_mb_cnt_ = 0;
+  probation_mb_cnt_ = 0;
   total_put_cnt_.reset();
   total_hit_cnt_.reset();
+  total_admit_cnt_.reset();
+  total_probation_cnt_.reset();
+  total_promote_cnt_.reset();
   total_miss_cnt_ = 0;
   last_hit_cnt_ = 0;
   base_mb_score_ = 0;
@@ -100,6 +105,22 @@ void ObKVStoreMemBlock::reuse()
   atomic_pos_.pairs = 0;
 }
 
+void ObKVStoreMemBlock::notify_wash(ObIKVCacheWashCallback& callback) const
+{
+  if (NULL != buffer_) {
+    int64_t pos = 0;
+    const ObKVCachePair* kvpair = NULL;
+
+    for (uint32_t i = 0; i < atomic_pos_.pairs; ++i) {
+      kvpair = reinterpret_cast<const ObKVCachePair*>(buffer_ + pos);
+      if (NULL != kvpair->key_ && NULL != kvpair->value_) {
+        callback.on_wash(*kvpair->key_, *kvpair->value_);
+      }
+      pos += kvpair->size_;
+    }
+  }
+}
+
 int64_t ObKVStoreMemBlock::upper_align(int64_t input, int64_t align)
 {
   return (input + align - 1) & ~(align - 1);
@@ -308,7 +329,9 @@ int ObKVMemBlockHandle::alloc(
 
 void ObKVMemBlockHandle::set_full(const double base_mb_score)
 {
-  score_ += base_mb_score;
+  if (PROBATION != policy_) {
+    score_ += base_mb_score;
+  }
   ATOMIC_STORE((uint32_t*)(&status_), FULL);
 }
 }  // end namespace common
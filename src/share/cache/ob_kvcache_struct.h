@@ -54,6 +54,18 @@ public:
   virtual int deep_copy(char* buf, const int64_t buf_len, ObIKVCacheValue*& value) const = 0;
 };
 
+// Notified of the kv pairs of a cache when the memblock holding them is freed, the pairs are only valid
+// during the call. Implementations are invoked by whichever thread drops the last reference of the memblock,
+// so they must not block.
+class ObIKVCacheWashCallback {
+public:
+  ObIKVCacheWashCallback()
+  {}
+  virtual ~ObIKVCacheWashCallback()
+  {}
+  virtual void on_wash(const ObIKVCacheKey& key, const ObIKVCacheValue& value) = 0;
+};
+
 struct ObKVCachePair {
   uint32_t magic_;
   int32_t size_;
@@ -64,7 +76,8 @@ struct ObKVCachePair {
   {}
 };
 
-enum ObKVCachePolicy { LRU = 0, LFU = 1, MAX_POLICY = 2 };
+// PROBATION holds the kv pairs rejected by the admission filter, its memblocks are washed before LRU and LFU ones
+enum ObKVCachePolicy { LRU = 0, LFU = 1, PROBATION = 2, MAX_POLICY = 3 };
 
 class ObKVStoreMemBlock {
 public:
@@ -76,6 +89,7 @@ public:
   static int64_t get_align_size(const int64_t key_size, const int64_t value_size);
   int store(const ObIKVCacheKey& key, const ObIKVCacheValue& value, ObKVCachePair*& kvpair);
   int alloc(const int64_t key_size, const int64_t value_size, const int64_t align_kv_size, ObKVCachePair*& kvpair);
+  void notify_wash(ObIKVCacheWashCallback& callback) const;
   inline int64_t get_payload_size() const
   {
     return payload_size_;
@@ -185,6 +199,7 @@ public:
   bool is_valid_;
   int64_t priority_;
   char cache_name_[MAX_CACHE_NAME_LENGTH];
+  ObIKVCacheWashCallback* wash_callback_;
 };
 
 struct ObKVCacheStatus {
@@ -201,16 +216,21 @@ public:
     return ATOMIC_LOAD(&hold_size_);
   }
   void reset();
-  TO_STRING_KV(KP_(config), K_(kv_cnt), K_(store_size), K_(map_size), K_(lru_mb_cnt), K_(lfu_mb_cnt), K_(base_mb_score),
-      K_(hold_size));
+  TO_STRING_KV(KP_(config), K_(kv_cnt), K_(store_size), K_(map_size), K_(lru_mb_cnt), K_(lfu_mb_cnt),
+      K_(probation_mb_cnt), K_(base_mb_score), K_(hold_size));
 
   const ObKVCacheConfig* config_;
   ObPCNonAtomicCounter total_put_cnt_;
   ObPCNonAtomicCounter total_hit_cnt_;
+  // kv pairs admitted to LRU directly, put to PROBATION, and promoted from PROBATION by hits
+  ObPCNonAtomicCounter total_admit_cnt_;
+  ObPCNonAtomicCounter total_probation_cnt_;
+  ObPCNonAtomicCounter total_promote_cnt_;
   int64_t kv_cnt_;
   int64_t store_size_;
   int64_t lru_mb_cnt_;
   int64_t lfu_mb_cnt_;
+  int64_t probation_mb_cnt_;
   int64_t map_size_;
   int64_t last_hit_cnt_;
   int64_t total_miss_cnt_;
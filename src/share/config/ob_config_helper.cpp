@@ -17,6 +17,7 @@
 #include "lib/utility/ob_macro_utils.h"
 #include "lib/compress/ob_compressor_pool.h"
 #include "lib/resource/achunk_mgr.h"
+#include "lib/io/ob_io_uring.h"
 #include "rpc/obrpc/ob_rpc_packet.h"
 #include "common/ob_store_format.h"
 #include "common/ob_smart_var.h"
@@ -153,6 +154,11 @@ bool ObConfigRowFormatChecker::check(const ObConfigItem& t) const
   return is_valid;
 }
 
+bool ObConfigIOEngineChecker::check(const ObConfigItem& t) const
+{
+  return IO_ENGINE_MAX != get_io_engine_type(t.str());
+}
+
 bool ObConfigCompressOptionChecker::check(const ObConfigItem& t) const
 {
   bool is_valid = false;
@@ -231,6 +231,18 @@ private:
   DISALLOW_COPY_AND_ASSIGN(ObConfigRowFormatChecker);
 };
 
+class ObConfigIOEngineChecker : public ObConfigChecker {
+public:
+  ObConfigIOEngineChecker()
+  {}
+  virtual ~ObConfigIOEngineChecker()
+  {}
+  bool check(const ObConfigItem& t) const;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObConfigIOEngineChecker);
+};
+
 class ObConfigCompressOptionChecker : public ObConfigChecker {
 public:
   ObConfigCompressOptionChecker()
@@ -42,6 +42,11 @@ SQL_MONITOR_STATNAME_DEF(
   DTL_SEND_RECV_COUNT, "the count of buffer received or sended", "the count of dtl buffer that received or sended")
 SQL_MONITOR_STATNAME_DEF(
   EXCHANGE_EOF_TIMESTAMP, "the timestamp of send eof or receive eof", "the timestamp of send eof or receive eof")
+// GROUP BY
+SQL_MONITOR_STATNAME_DEF(GROUP_BY_SAMPLE_GROUP_PERCENT, "sample group percent",
+  "percent of groups to rows sampled by pushed down group by")
+SQL_MONITOR_STATNAME_DEF(
+  GROUP_BY_BY_PASS_ROW_COUNT, "by pass row count", "total row passed through by pushed down group by")
 //end
 
 SQL_MONITOR_STATNAME_DEF(MONITOR_STATNAME_END, "monitor end", "monitor stat name end")
@@ -5170,6 +5170,9 @@ def_table_schema(
   ('total_hit_cnt', 'int', 'false'),
   ('total_miss_cnt', 'int', 'false'),
   ('hold_size', 'int', 'false'),
+  ('total_admit_cnt', 'int', 'false'),
+  ('total_probation_cnt', 'int', 'false'),
+  ('total_promote_cnt', 'int', 'false'),
   ],
   partition_columns = ['svr_ip', 'svr_port'],
 )
@@ -6095,6 +6098,11 @@ def_table_schema(
   ('quorum', 'int'),
   ('is_need_rebuild', 'bool'),
   ('next_replay_ts_delta', 'uint'),
+  ('fsync_latency', 'int', 'false', '0'),
+  ('log_arrival_interval', 'int', 'false', '0'),
+  ('group_commit_window', 'int', 'false', '0'),
+  ('group_commit_delay_count', 'int', 'false', '0'),
+  ('group_commit_immediate_count', 'int', 'false', '0'),
   ],
 
   partition_columns = ['svr_ip', 'svr_port'],
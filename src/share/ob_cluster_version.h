@@ -94,6 +94,9 @@ uint64_t cal_version(const uint64_t major, const uint64_t minor, const uint64_t
 // FIXME If you update the above version, please update me, CLUSTER_CURRENT_VERSION & ObUpgradeChecker!!!!!!
 //!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 #define CLUSTER_CURRENT_VERSION CLUSTER_VERSION_3100
+// on-disk formats which are written only after the whole cluster runs a version newer than
+// CLUSTER_CURRENT_VERSION, so that replicas of one major version never disagree on them
+#define CLUSTER_VERSION_3200 (oceanbase::common::cal_version(3, 2, 0))
 #define GET_MIN_CLUSTER_VERSION() (oceanbase::common::ObClusterVersion::get_instance().get_cluster_version())
 #define GET_UNIS_CLUSTER_VERSION() (::oceanbase::lib::get_unis_compat_version() ?: GET_MIN_CLUSTER_VERSION())
 
@@ -453,12 +453,20 @@ const int64_t OB_STATUS_LENGTH = 64;
 
 ///////////////////////////
 //// used for replay
+// default number of replay task queues of a partition, see _replay_task_queue_count
 const int64_t REPLAY_TASK_QUEUE_SIZE = 4;
+const int64_t MAX_REPLAY_TASK_QUEUE_SIZE = 16;
 inline int64_t& get_replay_queue_index()
 {
   static __thread int64_t replay_queue_index = -1;
   return replay_queue_index;
 }
+// number of replay task queues of the partition being replayed by this thread
+inline int64_t& get_replay_queue_count()
+{
+  static __thread int64_t replay_queue_count = 0;
+  return replay_queue_count;
+}
 ///////////////////////////////////
 
 // schema id
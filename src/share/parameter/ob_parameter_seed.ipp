@@ -247,6 +247,11 @@ DEF_BOOL(enable_sql_operator_dump, OB_CLUSTER_PARAMETER, "True",
 DEF_CAP(_chunk_row_store_mem_limit, OB_CLUSTER_PARAMETER, "0B", "[0,]",
     "the maximum size of memory used by ChunkRowStore, 0 means follow operator's setting. Range: [0, +∞)",
     ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_STR_WITH_CHECKER(_temp_store_compress_func, OB_CLUSTER_PARAMETER, "none",
+    common::ObConfigPerfCompressFuncChecker,
+    "compressor used for blocks of sql operator (sort/hash join/hash group by/...) written to temporary file. "
+    "Values: none, lz4_1.0, zstd_1.0, zstd_1.3.8",
+    ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_STR_WITH_CHECKER(tableapi_transport_compress_func, OB_CLUSTER_PARAMETER, "none",
     common::ObConfigCompressFuncChecker,
     "compressor used for tableAPI query result. Values: none, lz4_1.0, snappy_1.0, zlib_1.0, zstd_1.0 zstd 1.3.8",
@@ -398,10 +403,21 @@ DEF_INT(_enable_hash_join_processor, OB_TENANT_PARAMETER, "7", "[1, 7]",
     "which path to process for hash join, default 7 to auto choose "
     "1: nest loop, 2: recursive, 4: in-memory",
     ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_px_shared_hash_join, OB_TENANT_PARAMETER, "False",
+    "build the hash table of broadcast hash join once for all PX workers of the same server "
+    "Value:  True:turned on  False: turned off",
+    ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_BOOL(_enable_filter_push_down_storage, OB_TENANT_PARAMETER, "False",
     "Enable filter push down to storage"
     "Value:  True:turned on  False: turned off",
     ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_rowsets_enabled, OB_TENANT_PARAMETER, "False",
+    "Enable vectorized batch execution of static typing engine"
+    "Value:  True:turned on  False: turned off",
+    ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_rowsets_max_rows, OB_TENANT_PARAMETER, "256", "[1, 1024]",
+    "max rows of one batch in vectorized execution. Range: [1, 1024]",
+    ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_WORK_AREA_POLICY(workarea_size_policy, OB_TENANT_PARAMETER, "AUTO",
     "policy used to size SQL working areas (MANUAL/AUTO)",
     ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
@@ -766,6 +782,15 @@ DEF_TIME(_ob_trans_rpc_timeout, OB_CLUSTER_PARAMETER, "3s", "[0s, 3600s]",
 DEF_BOOL(enable_early_lock_release, OB_TENANT_PARAMETER, "False", "enable early lock release",
     ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
+DEF_INT(_replay_task_queue_count, OB_CLUSTER_PARAMETER, "4", "[1, 16]",
+    "the number of replay task queues of a partition, logs of different transactions of a partition are replayed "
+    "in parallel over them. It takes effect after the server restarts. Range: [1, 16]",
+    ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
+DEF_INT(_trans_ctx_map_shard_count, OB_CLUSTER_PARAMETER, "1", "[1, 8]",
+    "the number of trans ctx maps the contexts of a partition are spread over, more maps lower the contention "
+    "of a hot partition but make each scan of the partition visit all of them. "
+    "It takes effect on the partitions created or loaded afterwards. Range: [1, 8]",
+    ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_BOOL(__enable_block_receiving_clog, OB_CLUSTER_PARAMETER, "True",
     "If this option is set to true, block receiving clog for slave replicas when too much clog is waiting for beening "
     "submited to replaying. The default is true",
@@ -908,6 +933,15 @@ DEF_INT_WITH_CHECKER(disk_io_thread_count, OB_CLUSTER_PARAMETER, "8", common::Ob
 DEF_INT(_io_callback_thread_count, OB_CLUSTER_PARAMETER, "8", "[1,64]",
     "The number of io callback threads. The default value is 8. Range: [1,64] in integer",
     ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_STR_WITH_CHECKER(_io_engine, OB_CLUSTER_PARAMETER, "libaio", common::ObConfigIOEngineChecker,
+    "the system io interface of disk io threads, io_uring needs linux 5.6 or later and falls back to libaio "
+    "if not available. Value: libaio, io_uring",
+    ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
+DEF_BOOL(_io_uring_sqpoll, OB_CLUSTER_PARAMETER, "False",
+    "specifies whether io_uring uses a kernel thread to poll the submission queue, "
+    "which saves the system call of submission at the cost of cpu. "
+    "Value: True:turned on;  False: turned off",
+    ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
 DEF_INT(_large_query_io_percentage, OB_CLUSTER_PARAMETER, "0", "[0,100]",
     "the max percentage of io resource for big queries. Range: [0,100] in integer. Especially, 0 means unlimited. The "
     "default value is 0.",
@@ -1030,6 +1064,39 @@ DEF_INT(_migrate_block_verify_level, OB_CLUSTER_PARAMETER, "1", "[0,2]",
 
 DEF_TIME(_cache_wash_interval, OB_CLUSTER_PARAMETER, "200ms", "[1ms, 1m]", "specify interval of cache background wash",
     ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_kvcache_admission, OB_CLUSTER_PARAMETER, "False",
+    "specifies whether kv pairs not accessed recently are put into the probation memblocks of kvcache, "
+    "so that one-off scans do not wash out frequently accessed data. "
+    "Value:  True:turned on;  False: turned off",
+    ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_STR(_secondary_block_cache_file, OB_CLUSTER_PARAMETER, "",
+    "the file on local SSD holding the micro blocks washed out of the block cache, empty means disabled",
+    ObParameterAttr(Section::SSTABLE, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
+DEF_CAP(_secondary_block_cache_size, OB_CLUSTER_PARAMETER, "0", "[0M,)",
+    "size of the secondary block cache file, 0 means disabled. Range: [0, +∞)",
+    ObParameterAttr(Section::SSTABLE, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
+DEF_STR(_block_cache_snapshot_file, OB_CLUSTER_PARAMETER, "",
+    "the local file holding the keys of the hottest micro blocks of the block cache, which are read back into "
+    "the block cache when the observer restarts, empty means disabled",
+    ObParameterAttr(Section::SSTABLE, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
+DEF_TIME(_block_cache_snapshot_interval, OB_CLUSTER_PARAMETER, "10m", "[1m,)",
+    "the interval of writing the block cache snapshot. Range: [1m, +∞)",
+    ObParameterAttr(Section::SSTABLE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_block_cache_snapshot_max_block_count, OB_CLUSTER_PARAMETER, "100000", "[1, 10000000]",
+    "the max number of micro blocks kept in the block cache snapshot. Range: [1, 10000000]",
+    ObParameterAttr(Section::SSTABLE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_block_cache_snapshot_load_parallelism, OB_CLUSTER_PARAMETER, "32", "[1, 1024]",
+    "the max number of reads in flight when loading the block cache snapshot at startup. Range: [1, 1024]",
+    ObParameterAttr(Section::SSTABLE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_sstable_read_ahead_macro_block_count, OB_CLUSTER_PARAMETER, "4", "[0,)",
+    "range scans covering at least this many macro blocks of an sstable read ahead with coalesced reads of up to "
+    "a macro block, whose depth adapts to the scan speed and io latency, 0 means disabled. Range: [0, +∞)",
+    ObParameterAttr(Section::SSTABLE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_memtable_art_index, OB_CLUSTER_PARAMETER, "False",
+    "specifies whether tables of memtables created afterwards in mysql tenants are indexed by adaptive radix trees "
+    "instead of hash tables and b-trees when their rowkeys are of integer, temporal, binary or utf8mb4_bin types. "
+    "Value: True: use adaptive radix trees; False: use hash tables and b-trees",
+    ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
 DEF_INT(_max_partition_cnt_per_server, OB_CLUSTER_PARAMETER, "500000", "[10000, 500000]",
     "specify max partition count on one observer",
@@ -1084,6 +1151,22 @@ DEF_INT(migrate_concurrency, OB_CLUSTER_PARAMETER, "10", "[0,64]",
     ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(_max_elr_dependent_trx_count, OB_CLUSTER_PARAMETER, "0", "[0,)", "max elr dependent transaction count",
     ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_hot_row_conflict_threshold, OB_CLUSTER_PARAMETER, "0", "[0,)",
+    "lock conflicts on a row within 100ms from which the row is treated as a hot row, writers of a hot row in "
+    "transactions with early lock release, whose read snapshot covers the prepared lock holder, wait for the row "
+    "lock in place instead of retrying the statement. 0 means disabled. Range: [0, +∞)",
+    ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_TIME(_hot_row_lock_wait_time, OB_CLUSTER_PARAMETER, "5ms", "[0ms, 100ms]",
+    "max time a writer waits in place for the lock of a hot row. Range: [0ms, 100ms]",
+    ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_deadlock_detect, OB_CLUSTER_PARAMETER, "False",
+    "specifies whether lock waits are checked for deadlocks, the youngest transaction of a deadlock fails its "
+    "statement with a deadlock error instead of waiting until the lock wait timeout. Value: True: turned on; "
+    "False: turned off",
+    ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_TIME(_deadlock_detect_interval, OB_CLUSTER_PARAMETER, "20ms", "[1ms, 10s]",
+    "the interval of deadlock detection, lock waits longer than it are checked for deadlocks. Range: [1ms, 10s]",
+    ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
 ERRSIM_DEF_INT(skip_report_pg_backup_task_table_id, OB_CLUSTER_PARAMETER, "0", "[0,)",
     "skip_report_pg_backup_task table id"
@@ -1359,6 +1442,11 @@ DEF_TIME(_schema_history_recycle_interval, OB_CLUSTER_PARAMETER, "0s", "[0s,]",
 DEF_TIME(_flush_clog_aggregation_buffer_timeout, OB_TENANT_PARAMETER, "0ms", "[0ms, 100ms]",
     "the timeout for flushing clog aggregation buffer. Range: [0ms, 100ms]",
     ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_TIME(_clog_group_commit_latency_slo, OB_TENANT_PARAMETER, "0ms", "[0ms, 100ms]",
+    "the commit latency target of clog aggregation, the flush window of clog aggregation buffer is sized from "
+    "the observed fsync latency and log arrival rate within it, 0 means using "
+    "_flush_clog_aggregation_buffer_timeout. Range: [0ms, 100ms]",
+    ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_BOOL(_enable_oracle_priv_check, OB_CLUSTER_PARAMETER, "False", "whether turn on oracle privilege check ",
     ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 // for pl/sql compiler
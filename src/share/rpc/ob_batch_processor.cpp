@@ -16,6 +16,7 @@
 #include "clog/ob_clog_mgr.h"
 #include "sql/ob_sql.h"
 #include "sql/ob_sql_task.h"
+#include "storage/memtable/ob_deadlock_checker.h"
 #include "observer/omt/ob_th_worker.h"
 #include "observer/omt/ob_tenant.h"
 #include "lib/utility/serialization.h"
@@ -98,6 +99,12 @@ int ObBatchP::process()
               handle_sql_req(sender, msg_type, pkey, buf + pos, req->size_ - (int32_t)pos);
             }
             break;
+          case DEADLOCK_BATCH_REQ:
+            // the partition key is a placeholder, deadlock messages are not bound to any partition
+            if (OB_SUCCESS == pkey.deserialize(buf, req->size_, pos)) {
+              handle_deadlock_req(sender, msg_type, buf + pos, req->size_ - (int32_t)pos);
+            }
+            break;
           default:
             RPC_LOG(ERROR, "unknown batch req type", K(req->type_));
             break;
@@ -205,5 +212,11 @@ int ObBatchP::handle_sql_req(
   }
   return ret;
 }
+
+int ObBatchP::handle_deadlock_req(common::ObAddr& sender, int type, const char* buf, int32_t size)
+{
+  UNUSED(sender);
+  return memtable::get_global_deadlock_checker().handle_msg(type, buf, size);
+}
 };  // namespace obrpc
 };  // end namespace oceanbase
@@ -41,6 +41,7 @@ protected:
   int handle_election_group_req(common::ObAddr& sender, int type, const char* buf, int32_t size);
   int handle_trx_req(common::ObAddr& sender, int type, common::ObPartitionKey& pkey, const char* buf, int32_t size);
   int handle_sql_req(common::ObAddr& sender, int type, common::ObPartitionKey& pkey, const char* buf, int32_t size);
+  int handle_deadlock_req(common::ObAddr& sender, int type, const char* buf, int32_t size);
 
 private:
   storage::ObPartitionService* ps_;
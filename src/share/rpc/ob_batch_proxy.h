@@ -32,24 +32,26 @@ enum {
   SQL_BATCH_REQ_NODELAY2 = 6,
   CLOG_BATCH_REQ_NODELAY2 = 7,
   TRX_BATCH_REQ = 8,
-  BATCH_REQ_TYPE_COUNT = 9
+  DEADLOCK_BATCH_REQ = 9,
+  BATCH_REQ_TYPE_COUNT = 10
 };
 
 inline int64_t get_batch_delay_us(const int batch_type)
 {
-  int64_t delay[BATCH_REQ_TYPE_COUNT] = {2 * 1000, 2 * 1000, 1 * 1000, 0, 20, 0, 0, 0, 5 * 1000};
+  int64_t delay[BATCH_REQ_TYPE_COUNT] = {2 * 1000, 2 * 1000, 1 * 1000, 0, 20, 0, 0, 0, 5 * 1000, 1 * 1000};
   return (batch_type >= 0 && batch_type < BATCH_REQ_TYPE_COUNT) ? delay[batch_type] : 0;
 }
 
 inline int64_t get_batch_buffer_size(const int batch_type)
 {
-  int64_t batch_buffer_size_k[BATCH_REQ_TYPE_COUNT] = {256, 256, 2048, 2048, 256, 256, 256, 2048, 256};
+  int64_t batch_buffer_size_k[BATCH_REQ_TYPE_COUNT] = {256, 256, 2048, 2048, 256, 256, 256, 2048, 256, 256};
   return batch_buffer_size_k[batch_type] * 1024;
 }
 
 inline bool is_hp_rpc(const int batch_type)
 {
-  static const bool hp_rpc_map[BATCH_REQ_TYPE_COUNT] = {true, true, false, false, false, false, false, false, false};
+  static const bool hp_rpc_map[BATCH_REQ_TYPE_COUNT] = {
+      true, true, false, false, false, false, false, false, false, false};
   return (batch_type >= 0 && batch_type < BATCH_REQ_TYPE_COUNT) ? hp_rpc_map[batch_type] : false;
 }
 
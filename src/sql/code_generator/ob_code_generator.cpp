@@ -16,6 +16,14 @@
 #include "sql/code_generator/ob_code_generator_impl.h"
 #include "sql/code_generator/ob_static_engine_expr_cg.h"
 #include "sql/code_generator/ob_static_engine_cg.h"
+#include "sql/optimizer/ob_log_plan.h"
+#include "sql/optimizer/ob_log_table_scan.h"
+#include "sql/optimizer/ob_log_limit.h"
+#include "sql/optimizer/ob_log_sort.h"
+#include "sql/optimizer/ob_log_group_by.h"
+#include "sql/optimizer/ob_log_join.h"
+#include "sql/session/ob_sql_session_info.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 
 namespace oceanbase {
 namespace sql {
@@ -28,9 +36,12 @@ int ObCodeGenerator::generate(const ObLogPlan& log_plan, ObPhysicalPlan& phy_pla
       LOG_WARN("fail to generate old plan", K(ret));
     }
   } else {
-    if (OB_FAIL(generate_exprs(log_plan, phy_plan))) {
+    int64_t batch_size = 0;
+    if (OB_FAIL(detect_batch_size(log_plan, batch_size))) {
+      LOG_WARN("detect batch size failed", K(ret));
+    } else if (OB_FAIL(generate_exprs(log_plan, phy_plan, batch_size))) {
       LOG_WARN("fail to get all raw exprs", K(ret));
-    } else if (OB_FAIL(generate_operators(log_plan, phy_plan))) {
+    } else if (OB_FAIL(generate_operators(log_plan, phy_plan, batch_size))) {
       LOG_WARN("fail to generate plan", K(ret));
     }
   }
@@ -49,10 +60,11 @@ int ObCodeGenerator::generate_old_plan(const ObLogPlan& log_plan, ObPhysicalPlan
   return ret;
 }
 
-int ObCodeGenerator::generate_exprs(const ObLogPlan& log_plan, ObPhysicalPlan& phy_plan)
+int ObCodeGenerator::generate_exprs(const ObLogPlan& log_plan, ObPhysicalPlan& phy_plan, const int64_t batch_size)
 {
   int ret = OB_SUCCESS;
   ObStaticEngineExprCG expr_cg(phy_plan.get_allocator(), param_store_);
+  expr_cg.set_batch_size(batch_size);
   // init ctx for operator cg
   expr_cg.init_operator_cg_ctx(log_plan.get_optimizer_context().get_exec_ctx());
   ObRawExprUniqueSet all_raw_exprs(phy_plan.get_allocator());
@@ -69,10 +81,11 @@ int ObCodeGenerator::generate_exprs(const ObLogPlan& log_plan, ObPhysicalPlan& p
   return ret;
 }
 
-int ObCodeGenerator::generate_operators(const ObLogPlan& log_plan, ObPhysicalPlan& phy_plan)
+int ObCodeGenerator::generate_operators(const ObLogPlan& log_plan, ObPhysicalPlan& phy_plan, const int64_t batch_size)
 {
   int ret = OB_SUCCESS;
   ObStaticEngineCG static_engin_cg(min_cluster_version_);
+  static_engin_cg.set_batch_size(batch_size);
   if (OB_FAIL(static_engin_cg.generate(log_plan, phy_plan))) {
     LOG_WARN("fail to code generate", K(ret));
   }
@@ -80,6 +93,76 @@ int ObCodeGenerator::generate_operators(const ObLogPlan& log_plan, ObPhysicalPla
   return ret;
 }
 
+int ObCodeGenerator::detect_batch_size(const ObLogPlan& log_plan, int64_t& batch_size)
+{
+  int ret = OB_SUCCESS;
+  batch_size = 0;
+  const ObSQLSessionInfo* session = log_plan.get_optimizer_context().get_session_info();
+  ObSEArray<const ObLogPlan*, 4> plans;
+  if (OB_ISNULL(session)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("session is NULL", K(ret));
+  } else {
+    omt::ObTenantConfigGuard tenant_config(TENANT_CONF(session->get_effective_tenant_id()));
+    if (!tenant_config.is_valid() || !tenant_config->_rowsets_enabled) {
+      // vectorized execution disabled
+    } else if (OB_FAIL(get_all_log_plan(&log_plan, plans))) {
+      LOG_WARN("get all log plan failed", K(ret));
+    } else if (plans.count() > 1) {
+      // subplan filter (or subplan scan) is not supported in vectorized execution
+    } else if (is_vectorize_supported(log_plan.get_plan_root())) {
+      batch_size = tenant_config->_rowsets_max_rows;
+    }
+  }
+  LOG_TRACE("detect batch size", K(batch_size));
+  return ret;
+}
+
+bool ObCodeGenerator::is_vectorize_supported(const ObLogicalOperator* op) const
+{
+  bool supported = NULL != op;
+  if (supported) {
+    switch (op->get_type()) {
+      case log_op_def::LOG_TABLE_SCAN: {
+        auto tsc = const_cast<ObLogTableScan*>(static_cast<const ObLogTableScan*>(op));
+        supported = !tsc->get_is_fake_cte_table() && !tsc->is_sample_scan() &&
+                    !tsc->get_is_multi_part_table_scan() && !tsc->is_for_update() &&
+                    !is_virtual_table(tsc->get_ref_table_id());
+        break;
+      }
+      case log_op_def::LOG_LIMIT: {
+        auto limit = const_cast<ObLogLimit*>(static_cast<const ObLogLimit*>(op));
+        bool need_calc_found_rows = false;
+        supported = !limit->is_fetch_with_ties() && NULL == limit->get_limit_percent() &&
+                    OB_SUCCESS == limit->need_calc_found_rows(need_calc_found_rows) && !need_calc_found_rows;
+        break;
+      }
+      case log_op_def::LOG_SORT: {
+        auto sort = const_cast<ObLogSort*>(static_cast<const ObLogSort*>(op));
+        supported = !sort->is_prefix_sort() && NULL == sort->get_topn_count() &&
+                    NULL == sort->get_topk_limit_count() && !sort->is_local_merge_sort();
+        break;
+      }
+      case log_op_def::LOG_GROUP_BY: {
+        supported = HASH_AGGREGATE == static_cast<const ObLogGroupBy*>(op)->get_algo();
+        break;
+      }
+      case log_op_def::LOG_JOIN: {
+        supported = HASH_JOIN == static_cast<const ObLogJoin*>(op)->get_join_algo();
+        break;
+      }
+      default: {
+        supported = false;
+        break;
+      }
+    }
+  }
+  for (int64_t i = 0; supported && i < op->get_num_of_child(); i++) {
+    supported = is_vectorize_supported(op->get_child(i));
+  }
+  return supported;
+}
+
 int ObCodeGenerator::get_plan_all_exprs(const ObLogPlan& plan, ObRawExprUniqueSet& exprs)
 {
   int ret = OB_SUCCESS;
@@ -45,9 +45,15 @@ public:
 
 private:
   int generate_old_plan(const ObLogPlan& log_plan, ObPhysicalPlan& phy_plan);
-  int generate_exprs(const ObLogPlan& log_plan, ObPhysicalPlan& phy_plan);
+  int generate_exprs(const ObLogPlan& log_plan, ObPhysicalPlan& phy_plan, const int64_t batch_size);
 
-  int generate_operators(const ObLogPlan& log_plan, ObPhysicalPlan& phy_plan);
+  int generate_operators(const ObLogPlan& log_plan, ObPhysicalPlan& phy_plan, const int64_t batch_size);
+
+  // Detect max batch size of vectorized execution, 0 returned if plan can not be vectorized.
+  // Plan is vectorized only when _rowsets_enabled is on and all operators support batch interface,
+  // no subplan and no exchange operator allowed.
+  int detect_batch_size(const ObLogPlan& log_plan, int64_t& batch_size);
+  bool is_vectorize_supported(const ObLogicalOperator* op) const;
 
   // get all raw exprs of logical plan (include the subplans)
   int get_plan_all_exprs(const ObLogPlan& plan, ObRawExprUniqueSet& exprs);
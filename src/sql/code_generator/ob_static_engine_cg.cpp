@@ -429,6 +429,7 @@ int ObStaticEngineCG::generate_spec_basic(ObLogicalOperator& op, ObOpSpec& spec,
   spec.width_ = op.get_width();
   spec.plan_depth_ = op.get_plan_depth();
   spec.px_est_size_factor_ = op.get_px_est_size_factor();
+  spec.max_batch_size_ = batch_size_;
 
   OZ(generate_rt_exprs(op.get_startup_exprs(), spec.startup_filters_));
 
@@ -3509,6 +3510,7 @@ int ObStaticEngineCG::generate_spec(ObLogGroupBy& op, ObHashGroupBySpec& spec, c
     LOG_ERROR("wrong number of children", K(ret), K(op.get_num_of_child()));
   } else {
     spec.set_est_group_cnt(op.get_distinct_card());
+    spec.by_pass_enabled_ = op.is_push_down();
   }
 
   // 1. add group columns
@@ -4420,6 +4422,10 @@ int ObStaticEngineCG::generate_join_spec(ObLogJoin& op, ObJoinSpec& spec)
           LOG_WARN("failed to append join keys", K(ret));
         } else if (OB_FAIL(append(hj_spec.all_hash_funcs_, right_hash_funcs))) {
           LOG_WARN("failed to append join keys", K(ret));
+        } else if (OB_FAIL(generate_join_filter(op, hj_spec))) {
+          LOG_WARN("failed to generate join filter", K(ret));
+        } else {
+          hj_spec.is_shared_ht_ = op.is_shared_hash_table();
         }
       }
     }
@@ -4770,6 +4776,94 @@ bool ObStaticEngineCG::enable_pushdown_filter_to_storage(const ObLogTableScan& o
   return pd_filter;
 }
 
+bool ObStaticEngineCG::enable_join_filter(const ObLogJoin& op)
+{
+  bool enable = false;
+  const ObLogicalOperator* right = op.get_child(ObLogicalOperator::second_child);
+  ObBasicSessionInfo* session_info = op.get_plan()->get_optimizer_context().get_session_info();
+  if (OB_ISNULL(right) || OB_ISNULL(op.get_stmt()) || OB_ISNULL(session_info)) {
+  } else {
+    // PX_JOIN_FILTER/NO_PX_JOIN_FILTER hint of probe side tables first, then the tenant config.
+    const ObStmtHint& hint = op.get_stmt()->get_stmt_hint();
+    bool hint_enable = false;
+    bool hint_disable = false;
+    FOREACH_CNT(ids, hint.px_join_filter_idxs_)
+    {
+      hint_enable = hint_enable || (!ids->is_empty() && right->get_table_set().is_superset(*ids));
+    }
+    FOREACH_CNT(ids, hint.no_px_join_filter_idxs_)
+    {
+      hint_disable = hint_disable || (!ids->is_empty() && right->get_table_set().is_superset(*ids));
+    }
+    if (hint_enable) {
+      enable = true;
+    } else if (!hint_disable) {
+      omt::ObTenantConfigGuard tenant_config(TENANT_CONF(session_info->get_effective_tenant_id()));
+      if (tenant_config.is_valid()) {
+        enable = tenant_config->_bloom_filter_enabled;
+      }
+    }
+  }
+  return enable;
+}
+
+// Runtime join filter is generated when:
+// 1. all equal join conditions are not null safe equal and probe rows not matched can be discarded.
+// 2. the right child is table scan through PX exchange (not in the same DFO with hash join)
+//    and granule iterator, and right join keys are output of the table scan.
+int ObStaticEngineCG::generate_join_filter(const ObLogJoin& op, ObHashJoinSpec& spec)
+{
+  int ret = OB_SUCCESS;
+  const ObJoinType join_type = op.get_join_type();
+  bool can_filter = (INNER_JOIN == join_type || LEFT_OUTER_JOIN == join_type || LEFT_SEMI_JOIN == join_type ||
+                     LEFT_ANTI_JOIN == join_type || RIGHT_SEMI_JOIN == join_type);
+  const int64_t key_cnt = spec.equal_join_conds_.count();
+  for (int64_t i = 0; can_filter && i < key_cnt; i++) {
+    can_filter = (T_OP_EQ == spec.equal_join_conds_.at(i)->type_);
+  }
+  const ObOpSpec* child = spec.get_right();
+  int64_t receive_cnt = 0;
+  while (can_filter && NULL != child && 1 == child->get_child_cnt() &&
+         (PHY_PX_FIFO_RECEIVE == child->type_ || PHY_PX_MERGE_SORT_RECEIVE == child->type_ ||
+             IS_PX_TRANSMIT(child->type_) || IS_PX_GI(child->type_))) {
+    if (IS_PX_RECEIVE(child->type_)) {
+      receive_cnt++;
+    }
+    child = child->get_child(0);
+  }
+  can_filter = can_filter && receive_cnt > 0 && NULL != child && PHY_TABLE_SCAN == child->type_;
+  ObTableScanSpec* tsc = can_filter ? const_cast<ObTableScanSpec*>(static_cast<const ObTableScanSpec*>(child)) : NULL;
+  if (can_filter) {
+    can_filter = !tsc->has_join_filter() && !tsc->is_vt_mapping_ && !tsc->batch_scan_flag_;
+    for (int64_t i = 0; can_filter && i < key_cnt; i++) {
+      can_filter = has_exist_in_array(tsc->output_, spec.all_join_keys_.at(key_cnt + i));
+    }
+  }
+  if (can_filter && enable_join_filter(op)) {
+    const ObLogicalOperator* left = op.get_child(ObLogicalOperator::first_child);
+    const int64_t left_rows = NULL == left ? 0 : static_cast<int64_t>(left->get_card());
+    if (OB_FAIL(tsc->join_filter_keys_.init(key_cnt))) {
+      LOG_WARN("init fixed array failed", K(ret));
+    } else if (OB_FAIL(tsc->join_filter_hash_funcs_.init(key_cnt))) {
+      LOG_WARN("init fixed array failed", K(ret));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < key_cnt; i++) {
+      if (OB_FAIL(tsc->join_filter_keys_.push_back(spec.all_join_keys_.at(key_cnt + i)))) {
+        LOG_WARN("array push back failed", K(ret));
+      } else if (OB_FAIL(tsc->join_filter_hash_funcs_.push_back(spec.all_hash_funcs_.at(key_cnt + i)))) {
+        LOG_WARN("array push back failed", K(ret));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      spec.has_join_bf_ = true;
+      spec.join_filter_bit_cnt_ = ObPxBloomFilter::calc_bit_cnt(left_rows);
+      tsc->join_filter_id_ = spec.id_;
+      LOG_TRACE("generate join filter", K(spec.id_), K(tsc->id_), K(left_rows), K(spec.join_filter_bit_cnt_));
+    }
+  }
+  return ret;
+}
+
 int ObStaticEngineCG::generate_tsc_filter(const ObLogTableScan& op, ObTableScanSpec& spec)
 {
   int ret = OB_SUCCESS;
@@ -4811,7 +4905,12 @@ int ObStaticEngineCG::generate_tsc_filter(const ObLogTableScan& op, ObTableScanS
         }
       }
     }
-    if (OB_SUCC(ret) && !is_virtual_table(op.get_ref_table_id()) && PHY_TABLE_SCAN == spec.type_ && !filters.empty()) {
+    // Vectorized scan keeps the filters to evaluate them batch by batch, unless storage filters blocks
+    // or applies the pushed down limit, which must see the filtered rows.
+    const bool batch_filter = batch_size_ > 0 && !enable_pushdown_filter_to_storage(op) &&
+                              NULL == op.get_limit_expr() && NULL == op.get_offset_expr();
+    if (OB_SUCC(ret) && !is_virtual_table(op.get_ref_table_id()) && PHY_TABLE_SCAN == spec.type_ && !filters.empty() &&
+        !batch_filter) {
       // non virtual table table scan push down filter to storage
       OZ(generate_rt_exprs(filters, spec.pushdown_filters_));
       if (OB_SUCC(ret)) {
@@ -121,11 +121,17 @@ public:
   template <int TYPE>
   friend class GenSpecHelper;
 
-  ObStaticEngineCG(uint64_t min_cluster_version) : ObCodeGeneratorImpl(min_cluster_version)
+  ObStaticEngineCG(uint64_t min_cluster_version) : ObCodeGeneratorImpl(min_cluster_version), batch_size_(0)
   {}
   // generate physical plan
   int generate(const ObLogPlan& log_plan, ObPhysicalPlan& phy_plan) override;
 
+  // max batch size of vectorized plan, set to ObOpSpec::max_batch_size_
+  void set_batch_size(const int64_t batch_size)
+  {
+    batch_size_ = batch_size;
+  }
+
   // Dangerous: there is a dragon!!!
   int generate_rt_expr(const ObRawExpr& raw_expr, ObExpr*& rt_expr);
   int generate_rt_exprs(const common::ObIArray<ObRawExpr*>& src, common::ObIArray<ObExpr*>& dst);
@@ -232,6 +238,9 @@ private:
   int generate_spec(ObLogJoin& op, ObMergeJoinSpec& spec, const bool in_root_job);
 
   int generate_join_spec(ObLogJoin& op, ObJoinSpec& spec);
+  // runtime join filter of hash join, built in hash join and applied in the probe side table scan.
+  bool enable_join_filter(const ObLogJoin& op);
+  int generate_join_filter(const ObLogJoin& op, ObHashJoinSpec& spec);
 
   int set_optimization_info(ObLogTableScan& op, ObTableScanSpec& spec);
   int set_partition_range_info(ObLogTableScan& op, ObTableScanSpec& spec);
@@ -409,6 +418,8 @@ private:
   // all self_produced exprs of current operator
   ObSEArray<ObRawExpr*, 8> cur_op_self_produced_exprs_;
   common::ObSEArray<uint64_t, 10> fake_cte_tables_;
+  // max batch size of vectorized plan, 0 for non vectorized plan.
+  int64_t batch_size_;
 };
 
 }  // end namespace sql
@@ -129,6 +129,8 @@ int ObStaticEngineExprCG::cg_exprs(const ObIArray<ObRawExpr*>& raw_exprs, ObExpr
       LOG_WARN("fail to init expr data layout", K(ret), K(raw_exprs));
     } else if (OB_FAIL(alloc_so_check_exprs(raw_exprs, expr_info))) {
       LOG_WARN("alloc stack overflow check exprs failed", K(ret));
+    } else {
+      expr_info.max_batch_size_ = batch_size_;
     }
   }
 
@@ -308,6 +310,15 @@ int ObStaticEngineExprCG::cg_expr_by_operator(const ObIArray<ObRawExpr*>& raw_ex
             KP(rt_expr->eval_func_),
             K(*raw_expr),
             K(*rt_expr));
+      } else if (OB_INVALID_INDEX ==
+                 ObFuncSerialization::get_serialize_index(reinterpret_cast<void*>(rt_expr->eval_batch_func_))) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("batch evaluate function not serializable, "
+                 "may be you should add the function into ob_expr_eval_functions",
+            K(ret),
+            KP(rt_expr->eval_batch_func_),
+            K(*raw_expr),
+            K(*rt_expr));
       } else if (rt_expr->inner_func_cnt_ > 0) {
         if (OB_ISNULL(rt_expr->inner_functions_)) {
           ret = OB_ERR_UNEXPECTED;
@@ -522,6 +533,15 @@ int ObStaticEngineExprCG::cg_dynamic_frame_layout(
 int ObStaticEngineExprCG::cg_datum_frame_layout(
     const ObIArray<ObRawExpr*>& exprs, int64_t& frame_index_pos, ObIArray<ObFrameInfo>& frame_info_arr)
 {
+  if (batch_size_ > 0) {
+    // only expressions in datum frame are evaluated row by row, mark them batch result
+    // for vectorized plan.
+    for (int64_t i = 0; i < exprs.count(); i++) {
+      ObExpr* rt_expr = get_rt_expr(*exprs.at(i));
+      rt_expr->batch_result_ = true;
+      rt_expr->batch_idx_mask_ = UINT64_MAX;
+    }
+  }
   const bool reserve_empty_string = false;
   // const bool continuous_datum = false;
   const bool continuous_datum = true;
@@ -559,8 +579,8 @@ int ObStaticEngineExprCG::cg_frame_layout(const ObIArray<ObRawExpr*>& exprs, con
   }
   for (int64_t expr_idx = 0; OB_SUCC(ret) && expr_idx < exprs.count(); expr_idx++) {
     ObExpr* rt_expr = get_rt_expr(*exprs.at(expr_idx));
-    const int64_t datum_size = DATUM_EVAL_INFO_SIZE + reserve_data_consume(*rt_expr);
-    if (frame_size + datum_size <= MAX_FRAME_SIZE) {
+    const int64_t datum_size = frame_consume(*rt_expr);
+    if (frame_size + datum_size <= MAX_FRAME_SIZE || 0 == frame_expr_cnt) {
       frame_size += datum_size;
       frame_expr_cnt++;
     } else {
@@ -611,18 +631,40 @@ int ObStaticEngineExprCG::arrange_datum_data(
 {
   int ret = OB_SUCCESS;
   if (continuous_datum) {
-    int64_t data_off = frame.expr_cnt_ * DATUM_EVAL_INFO_SIZE;
+    // datum area: [datum, eval info] for non batch result expression,
+    // [datum * batch_size, eval info, evaluated flags] for batch result expression.
+    int64_t data_off = 0;
+    for (int64_t i = 0; i < exprs.count(); i++) {
+      ObExpr* e = get_rt_expr(*exprs.at(i));
+      data_off += e->batch_result_ ? batch_header_consume(*e) : DATUM_EVAL_INFO_SIZE;
+    }
+    int64_t datum_off = 0;
     for (int64_t i = 0; OB_SUCC(ret) && i < exprs.count(); i++) {
       ObExpr* e = get_rt_expr(*exprs.at(i));
       e->frame_idx_ = frame.frame_idx_;
-      e->datum_off_ = i * DATUM_EVAL_INFO_SIZE;
-      e->eval_info_off_ = e->datum_off_ + sizeof(ObDatum);
+      e->datum_off_ = datum_off;
       const int64_t consume_size = reserve_data_consume(*e);
-      if (consume_size > 0) {
-        data_off += consume_size;
-        e->res_buf_off_ = data_off - e->res_buf_len_;
+      if (e->batch_result_) {
+        e->eval_info_off_ = e->datum_off_ + batch_size_ * sizeof(ObDatum);
+        e->eval_flags_off_ = e->eval_info_off_ + sizeof(ObEvalInfo);
+        e->res_buf_stride_ = consume_size;
+        datum_off += batch_header_consume(*e);
+        if (consume_size > 0) {
+          // point to reserved buffer of the first row
+          e->res_buf_off_ = data_off + consume_size - e->res_buf_len_;
+          data_off += batch_size_ * consume_size;
+        } else {
+          e->res_buf_off_ = 0;
+        }
       } else {
-        e->res_buf_off_ = 0;
+        e->eval_info_off_ = e->datum_off_ + sizeof(ObDatum);
+        datum_off += DATUM_EVAL_INFO_SIZE;
+        if (consume_size > 0) {
+          data_off += consume_size;
+          e->res_buf_off_ = data_off - e->res_buf_len_;
+        } else {
+          e->res_buf_off_ = 0;
+        }
       }
     }
     CK(data_off == frame.frame_size_);
@@ -49,7 +49,7 @@ public:
   static const int64_t DATUM_EVAL_INFO_SIZE = sizeof(ObDatum) + sizeof(ObEvalInfo);
   friend class ObRawExpr;
   ObStaticEngineExprCG(common::ObIAllocator& allocator, DatumParamStore* param_store)
-      : allocator_(allocator), param_store_(param_store), op_cg_ctx_(), flying_param_cnt_(0)
+      : allocator_(allocator), param_store_(param_store), op_cg_ctx_(), flying_param_cnt_(0), batch_size_(0)
   {}
   virtual ~ObStaticEngineExprCG()
   {}
@@ -81,6 +81,13 @@ public:
     return op_cg_ctx_;
   }
 
+  // set max batch size for vectorized plan, datums of batch result expression
+  // are arranged for %batch_size rows.
+  void set_batch_size(const int64_t batch_size)
+  {
+    batch_size_ = batch_size;
+  }
+
 private:
   static ObExpr* get_rt_expr(const ObRawExpr& raw_expr);
   int construct_exprs(const common::ObIArray<ObRawExpr*>& raw_exprs, common::ObIArray<ObExpr>& rt_exprs);
@@ -141,6 +148,21 @@ private:
     return expr.res_buf_len_ + (need_dyn_buf && expr.res_buf_len_ > 0 ? sizeof(ObDynReserveBuf) : 0);
   }
 
+  // frame memory consumed by expr, include datum, eval info, per row evaluated flags
+  // (batch result only) and reserved buffers.
+  int64_t frame_consume(const ObExpr& expr)
+  {
+    return expr.batch_result_ ? batch_header_consume(expr) + batch_size_ * reserve_data_consume(expr)
+                              : DATUM_EVAL_INFO_SIZE + reserve_data_consume(expr);
+  }
+
+  // datums, eval info and per row evaluated flags of batch result expression
+  int64_t batch_header_consume(const ObExpr& expr)
+  {
+    UNUSED(expr);
+    return batch_size_ * sizeof(ObDatum) + sizeof(ObEvalInfo) + ObBitVector::memory_size(batch_size_);
+  }
+
   int arrange_datum_data(common::ObIArray<ObRawExpr*>& exprs, const ObFrameInfo& frame, const bool continuous_datum);
 
   int inner_generate_calculable_exprs(
@@ -156,6 +178,8 @@ private:
   ObExprCGCtx op_cg_ctx_;
   // Count of param store in generating, for calculable expressions CG.
   int64_t flying_param_cnt_;
+  // max batch size of vectorized plan, 0 for non vectorized plan.
+  int64_t batch_size_;
 };
 
 }  // end namespace sql
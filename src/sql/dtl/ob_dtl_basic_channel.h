@@ -74,6 +74,8 @@ static DtlWriterType msg_writer_map[] = {
     CONTROL_WRITER,      // DH_BARRIER_WHOLE_MSG,
     CONTROL_WRITER,      // DH_WINBUF_PIECE_MSG,
     CONTROL_WRITER,      // DH_WINBUF_WHOLE_MSG,
+    CONTROL_WRITER,      // DH_JOIN_FILTER_PIECE_MSG,
+    CONTROL_WRITER,      // DH_JOIN_FILTER_WHOLE_MSG,
 };
 
 static_assert(ARRAYSIZEOF(msg_writer_map) == ObDtlMsgType::MAX, "invalid ms_writer_map size");
@@ -691,6 +691,73 @@ int ObAggregateProcessor::process(GroupRow& group_row)
   return ret;
 }
 
+bool ObAggregateProcessor::can_inv_process(const ObAggrInfo& aggr_info)
+{
+  bool can_inv = false;
+  if (!aggr_info.has_distinct_ && !aggr_info.is_implicit_first_aggr()) {
+    const ObItemType aggr_fun = aggr_info.get_expr_type();
+    if (T_FUN_COUNT == aggr_fun) {
+      can_inv = true;
+    } else if (T_FUN_SUM == aggr_fun || T_FUN_AVG == aggr_fun) {
+      const ObObjTypeClass tc = ob_obj_type_class(aggr_info.get_first_child_type());
+      can_inv = (ObIntTC == tc || ObUIntTC == tc || ObNumberTC == tc);
+    }
+  }
+  return can_inv;
+}
+
+int ObAggregateProcessor::inv_process(GroupRow& group_row)
+{
+  int ret = OB_SUCCESS;
+  for (int64_t i = 0; OB_SUCC(ret) && i < group_row.n_cells_; ++i) {
+    const ObAggrInfo& aggr_info = aggr_infos_.at(i);
+    AggrCell& aggr_cell = group_row.aggr_cells_[i];
+    if (OB_UNLIKELY(!can_inv_process(aggr_info))) {
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("aggregate function can not be inverse processed", K(ret), K(aggr_info));
+    } else if (OB_FAIL(aggr_info.eval_aggr(aggr_cell.curr_row_results_, eval_ctx_))) {
+      LOG_WARN("fail to eval", K(ret));
+    } else if (OB_FAIL(inv_process_aggr_result(*aggr_cell.curr_row_results_.get_store_row(), aggr_cell, aggr_info))) {
+      LOG_WARN("failed to inverse process aggr cell", K(ret));
+    }
+    OX(LOG_DEBUG("finish inverse process", K(aggr_cell), K(aggr_cell.curr_row_results_)));
+  }
+  return ret;
+}
+
+int ObAggregateProcessor::inv_process_aggr_result(
+    const ObChunkDatumStore::StoredRow& stored_row, AggrCell& aggr_cell, const ObAggrInfo& aggr_info)
+{
+  int ret = OB_SUCCESS;
+  const ObItemType aggr_fun = aggr_info.get_expr_type();
+  if (T_FUN_COUNT == aggr_fun) {
+    bool has_null = false;
+    for (int64_t i = 0; !has_null && i < stored_row.cnt_; ++i) {
+      has_null = stored_row.cells()[i].is_null();
+    }
+    if (!has_null) {
+      aggr_cell.dec_row_count();
+    }
+  } else if (OB_UNLIKELY(stored_row.cnt_ != 1)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("curr_row_results count is not 1", K(stored_row));
+  } else if (stored_row.cells()[0].is_null()) {
+    // null is not aggregated
+  } else if (OB_UNLIKELY(aggr_cell.get_row_count() <= 0)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("no row to remove", K(ret), K(aggr_cell));
+  } else {
+    aggr_cell.dec_row_count();
+    if (0 == aggr_cell.get_row_count()) {
+      // sum and avg of no row is null
+      aggr_cell.reuse_result();
+    } else if (OB_FAIL(sub_calc(stored_row.cells()[0], aggr_cell, aggr_info))) {
+      LOG_WARN("sub calc failed", K(ret));
+    }
+  }
+  return ret;
+}
+
 int ObAggregateProcessor::collect(const int64_t group_id /*= 0*/, const ObExpr* diff_expr /*= NULL*/)
 {
   int ret = OB_SUCCESS;
@@ -1275,6 +1342,7 @@ int ObAggregateProcessor::prepare_aggr_result(const ObChunkDatumStore::StoredRow
           ret = OB_INVALID_ARGUMENT;
           LOG_WARN("curr_row_results count is not 1", K(stored_row));
         } else if (!stored_row.cells()[0].is_null()) {
+          aggr_cell.inc_row_count();
           ret = prepare_add_calc(stored_row.cells()[0], aggr_cell, aggr_info);
         }
         break;
@@ -1436,6 +1504,7 @@ int ObAggregateProcessor::process_aggr_result(const ObChunkDatumStore::StoredRow
           ret = OB_INVALID_ARGUMENT;
           LOG_WARN("curr_row_results count is not 1", K(stored_row));
         } else if (!stored_row.cells()[0].is_null()) {
+          aggr_cell.inc_row_count();
           ret = add_calc(stored_row.cells()[0], aggr_cell, aggr_info);
         }
         break;
@@ -2570,6 +2639,95 @@ int ObAggregateProcessor::add_calc(const ObDatum& iter_value, AggrCell& aggr_cel
   return ret;
 }
 
+// Result of integer sum is tiny num plus the number iter result, the difference is kept in
+// tiny num if not overflow, otherwise merged to the number.
+int ObAggregateProcessor::sub_calc(const ObDatum& iter_value, AggrCell& aggr_cell, const ObAggrInfo& aggr_info)
+{
+  int ret = OB_SUCCESS;
+  const ObObjTypeClass column_tc = ob_obj_type_class(aggr_info.get_first_child_type());
+  ObDatum& result_datum = aggr_cell.get_iter_result();
+  switch (column_tc) {
+    case ObIntTC:
+    case ObUIntTC: {
+      bool overflow = false;
+      if (ObIntTC == column_tc) {
+        const int64_t left_int = aggr_cell.get_tiny_num_int();
+        const int64_t right_int = iter_value.get_int();
+        const int64_t diff_int = left_int - right_int;
+        // overflow if operands have different signs and the sign of result differs from the left
+        overflow = ((left_int ^ right_int) & (left_int ^ diff_int)) < 0;
+        if (!overflow) {
+          aggr_cell.set_tiny_num_int(diff_int);
+        }
+      } else {
+        const uint64_t left_uint = aggr_cell.get_tiny_num_uint();
+        const uint64_t right_uint = iter_value.get_uint();
+        overflow = left_uint < right_uint;
+        if (!overflow) {
+          aggr_cell.set_tiny_num_uint(left_uint - right_uint);
+        }
+      }
+      if (overflow) {
+        LOG_DEBUG("tiny num sub overflow, will use number", K(aggr_cell), K(iter_value));
+        char buf_alloc[ObNumber::MAX_CALC_BYTE_LEN * 4];
+        ObDataBuffer allocator(buf_alloc, sizeof(buf_alloc));
+        ObNumber result_nmb;
+        ObNumber left_nmb;
+        ObNumber right_nmb;
+        ObNumber diff_nmb;
+        ObNumber sum_nmb;
+        if (!result_datum.is_null()) {
+          ObCompactNumber& cnum = const_cast<ObCompactNumber&>(result_datum.get_number());
+          result_nmb.assign(cnum.desc_.desc_, cnum.digits_ + 0);
+        }
+        if (ObIntTC == column_tc) {
+          OZ(left_nmb.from(aggr_cell.get_tiny_num_int(), allocator));
+          OZ(right_nmb.from(iter_value.get_int(), allocator));
+        } else {
+          OZ(left_nmb.from(aggr_cell.get_tiny_num_uint(), allocator));
+          OZ(right_nmb.from(iter_value.get_uint(), allocator));
+        }
+        if (OB_FAIL(ret)) {
+          LOG_WARN("number from int failed", K(ret));
+        } else if (OB_FAIL(left_nmb.sub_v3(right_nmb, diff_nmb, allocator, false))) {
+          LOG_WARN("number sub failed", K(ret));
+        } else if (OB_FAIL(result_nmb.add_v3(diff_nmb, sum_nmb, allocator, false))) {
+          LOG_WARN("number add failed", K(ret));
+        } else if (OB_FAIL(clone_number_cell(sum_nmb, result_datum))) {
+          LOG_WARN("clone_number_cell failed", K(ret));
+        } else {
+          aggr_cell.set_tiny_num_int(0);
+        }
+      }
+      break;
+    }
+    case ObNumberTC: {
+      if (OB_UNLIKELY(result_datum.is_null())) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("sub from null result", K(ret), K(aggr_cell));
+      } else {
+        char buf_alloc[ObNumber::MAX_CALC_BYTE_LEN];
+        ObDataBuffer allocator(buf_alloc, ObNumber::MAX_CALC_BYTE_LEN);
+        const bool strict_mode = false;  // this is tmp allocator, so we can ues non-strinct mode
+        ObNumber left_nmb(result_datum.get_number());
+        ObNumber right_nmb(iter_value.get_number());
+        ObNumber result_nmb;
+        if (OB_FAIL(left_nmb.sub_v3(right_nmb, result_nmb, allocator, strict_mode))) {
+          LOG_WARN("number sub failed", K(ret), K(left_nmb), K(right_nmb));
+        } else {
+          ret = clone_number_cell(result_nmb, result_datum);
+        }
+      }
+      break;
+    }
+    default: {
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("bot support now", K(column_tc));
+    }
+  }
+  return ret;
+}
+
 int ObAggregateProcessor::rollup_add_number_calc(ObDatum& aggr_result, ObDatum& rollup_result)
 {
   int ret = OB_SUCCESS;
@@ -2865,15 +3023,73 @@ int ObGroupRowHashTable::init(ObIAllocator* allocator, lib::ObMemAttr& mem_attr,
     const common::ObIArray<ObCmpFunc>* cmp_funcs, int64_t initial_size)
 {
   int ret = OB_SUCCESS;
-  if (OB_FAIL(ObExtendHashTable<ObGroupRowItem>::init(allocator, mem_attr, initial_size))) {
-    LOG_WARN("failed to init extended hash table", K(ret));
+  if (initial_size < 2) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(initial_size));
   } else {
-    eval_ctx_ = eval_ctx;
-    cmp_funcs_ = cmp_funcs;
+    mem_attr_ = mem_attr;
+    allocator_.set_allocator(allocator);
+    allocator_.set_label(mem_attr.label_);
+    void* buckets_buf = NULL;
+    if (OB_ISNULL(buckets_buf = allocator_.alloc(sizeof(BucketArray), mem_attr))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("failed to allocate memory", K(ret));
+    } else {
+      buckets_ = new (buckets_buf) BucketArray(allocator_);
+      initial_bucket_num_ = common::next_pow2(initial_size * SIZE_BUCKET_SCALE);
+      size_ = 0;
+      eval_ctx_ = eval_ctx;
+      cmp_funcs_ = cmp_funcs;
+    }
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(extend())) {
+      LOG_WARN("extend failed", K(ret));
+    }
   }
   return ret;
 }
 
+void ObGroupRowHashTable::reuse()
+{
+  int ret = OB_SUCCESS;
+  if (nullptr != buckets_) {
+    int64_t bucket_num = get_bucket_num();
+    buckets_->reuse();
+    if (OB_FAIL(buckets_->init(bucket_num))) {
+      LOG_ERROR("resize bucket array failed", K(size_), K(bucket_num), K(get_bucket_num()));
+    }
+  }
+  size_ = 0;
+}
+
+int ObGroupRowHashTable::resize(ObIAllocator* allocator, int64_t bucket_num)
+{
+  int ret = OB_SUCCESS;
+  if (bucket_num < get_bucket_num() / 2) {
+    ObEvalCtx* eval_ctx = eval_ctx_;
+    const common::ObIArray<ObCmpFunc>* cmp_funcs = cmp_funcs_;
+    destroy();
+    if (OB_FAIL(init(allocator, mem_attr_, eval_ctx, cmp_funcs, bucket_num))) {
+      LOG_WARN("failed to reuse with bucket", K(bucket_num), K(ret));
+    }
+  } else {
+    reuse();
+  }
+  return ret;
+}
+
+void ObGroupRowHashTable::destroy()
+{
+  if (NULL != buckets_) {
+    buckets_->destroy();
+    allocator_.free(buckets_);
+    buckets_ = NULL;
+  }
+  allocator_.set_allocator(nullptr);
+  size_ = 0;
+  initial_bucket_num_ = 0;
+}
+
 bool ObGroupRowHashTable::compare(const ObGroupRowItem& left, const ObGroupRowItem& right) const
 {
   int ret = OB_SUCCESS;
@@ -2902,19 +3118,97 @@ const ObGroupRowItem* ObGroupRowHashTable::get(const ObGroupRowItem& item) const
   if (OB_UNLIKELY(NULL == buckets_)) {
     // do nothing
   } else {
+    // buckets are at most half filled, always stopped by an empty bucket.
     const uint64_t hash_val = item.hash();
-    ObGroupRowItem* bucket = buckets_->at(hash_val & (get_bucket_num() - 1));
-    while (NULL != bucket) {
-      if (hash_val == bucket->hash() && compare(*bucket, item)) {
-        res = bucket;
+    const int64_t mask = get_bucket_num() - 1;
+    for (int64_t idx = hash_val & mask;; idx = (idx + 1) & mask) {
+      const Bucket& bucket = buckets_->at(idx);
+      if (NULL == bucket.item_) {
+        break;
+      } else if (hash_val == bucket.hash_ && compare(*bucket.item_, item)) {
+        res = bucket.item_;
         break;
       }
-      bucket = bucket->next();
     }
   }
   return res;
 }
 
+void ObGroupRowHashTable::insert(BucketArray& buckets, const uint64_t hash_val, ObGroupRowItem* item)
+{
+  const int64_t mask = buckets.count() - 1;
+  int64_t idx = hash_val & mask;
+  while (NULL != buckets.at(idx).item_) {
+    idx = (idx + 1) & mask;
+  }
+  Bucket& bucket = buckets.at(idx);
+  bucket.hash_ = hash_val;
+  bucket.item_ = item;
+}
+
+int ObGroupRowHashTable::set(ObGroupRowItem& item)
+{
+  int ret = OB_SUCCESS;
+  if ((size_ + 1) * SIZE_BUCKET_SCALE > get_bucket_num()) {
+    if (OB_FAIL(extend())) {
+      LOG_WARN("extend failed", K(ret));
+    }
+  }
+  if (OB_FAIL(ret)) {
+    // do nothing
+  } else if (OB_ISNULL(buckets_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(buckets_));
+  } else {
+    insert(*buckets_, item.hash(), &item);
+    size_ += 1;
+  }
+  return ret;
+}
+
+int ObGroupRowHashTable::extend()
+{
+  int ret = OB_SUCCESS;
+  const int64_t new_bucket_num =
+      0 == get_bucket_num() ? (0 == initial_bucket_num_ ? INITIAL_SIZE : initial_bucket_num_) : get_bucket_num() * 2;
+  BucketArray* new_buckets = NULL;
+  void* buckets_buf = NULL;
+  if (OB_ISNULL(buckets_buf = allocator_.alloc(sizeof(BucketArray), mem_attr_))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to allocate memory", K(ret));
+  } else {
+    new_buckets = new (buckets_buf) BucketArray(allocator_);
+  }
+  if (OB_FAIL(ret)) {
+    // do nothing
+  } else if (OB_ISNULL(buckets_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(buckets_));
+  } else if (OB_FAIL(new_buckets->init(new_bucket_num))) {
+    LOG_WARN("resize bucket array failed", K(ret), K(new_bucket_num));
+  } else {
+    for (int64_t i = 0; i < get_bucket_num(); i++) {
+      const Bucket& bucket = buckets_->at(i);
+      if (NULL != bucket.item_) {
+        insert(*new_buckets, bucket.hash_, bucket.item_);
+      }
+    }
+    buckets_->destroy();
+    allocator_.free(buckets_);
+    buckets_ = new_buckets;
+  }
+  if (OB_FAIL(ret)) {
+    if (buckets_ == new_buckets) {
+      LOG_ERROR("unexpected status: failed allocate new bucket", K(ret));
+    } else if (nullptr != new_buckets) {
+      new_buckets->destroy();
+      allocator_.free(new_buckets);
+      new_buckets = nullptr;
+    }
+  }
+  return ret;
+}
+
 int ObAggregateCalcFunc::add_calc(const ObDatum& left_value, const ObDatum& right_value, ObDatum& result_datum,
     const ObObjTypeClass type, ObIAllocator& out_allocator)
 {
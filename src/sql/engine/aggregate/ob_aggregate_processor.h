@@ -242,6 +242,10 @@ public:
     {
       ++row_count_;
     }
+    void dec_row_count()
+    {
+      --row_count_;
+    }
     int64_t get_row_count()
     {
       return row_count_;
@@ -313,6 +317,14 @@ public:
       }
       curr_row_results_.reset();
     }
+    // reset the aggregated result to the initial state (no row aggregated)
+    inline void reuse_result()
+    {
+      row_count_ = 0;
+      tiny_num_int_ = 0;
+      is_tiny_num_used_ = false;
+      iter_result_.set_null();
+    }
     inline void set_allocator(common::ObIAllocator* alloc)
     {
       alloc_ = alloc;
@@ -323,7 +335,7 @@ public:
     ObChunkDatumStore::ShadowStoredRow<> curr_row_results_;
 
   private:
-    // for avg/count
+    // for avg/count/sum, row count of sum is used by inverse processing only
     int64_t row_count_;
 
     // for int fast path
@@ -383,6 +395,9 @@ public:
 
   int prepare(GroupRow& group_row);
   int process(GroupRow& group_row);
+  // Remove the current row from the aggregated result, the inverse of process().
+  // Only aggregate functions of can_inv_process() supported, used by sliding window function frames.
+  int inv_process(GroupRow& group_row);
   int collect(const int64_t group_id = 0, const ObExpr* diff_expr = NULL);
 
   // used by ScalarAggregate operator when there's no input rows
@@ -427,6 +442,9 @@ public:
   }
   int clone_cell(ObDatum& target_cell, const ObDatum& src_cell, const bool is_number = false);
   static int get_llc_size();
+  // count, sum and avg of exact numeric types are removable, floating point types are excluded
+  // because the result of removal is not the same as aggregating the remaining rows.
+  static bool can_inv_process(const ObAggrInfo& aggr_info);
 
 private:
   int extend_concat_str_buf(const ObString& pad_str, const int64_t pos, const int64_t group_concat_cur_row_num,
@@ -446,6 +464,9 @@ private:
   int min_calc(ObDatum& base, const ObDatum& other, common::ObDatumCmpFuncType cmp_func, const bool is_number);
   int prepare_add_calc(const ObDatum& iter_value, AggrCell& aggr_cell, const ObAggrInfo& aggr_info);
   int add_calc(const ObDatum& iter_value, AggrCell& aggr_cell, const ObAggrInfo& aggr_info);
+  int inv_process_aggr_result(
+      const ObChunkDatumStore::StoredRow& stored_row, AggrCell& aggr_cell, const ObAggrInfo& aggr_info);
+  int sub_calc(const ObDatum& iter_value, AggrCell& aggr_cell, const ObAggrInfo& aggr_info);
   int rollup_add_calc(AggrCell& aggr_cell, AggrCell& rollup_cell, const ObAggrInfo& aggr_info);
   int search_op_expr(ObExpr* upper_expr, const ObItemType dst_op, ObExpr*& res_expr);
   int linear_inter_calc(const ObAggrInfo& aggr_info, const ObDatum& prev_datum, const ObDatum& curr_datum,
@@ -509,7 +530,7 @@ private:
 // Used for calc hash for columns
 class ObGroupRowItem {
 public:
-  ObGroupRowItem() : group_id_(0), group_row_ptr_(NULL), groupby_datums_hash_(0), next_(NULL)
+  ObGroupRowItem() : group_id_(0), group_row_ptr_(NULL), groupby_datums_hash_(0)
   {}
 
   ~ObGroupRowItem()
@@ -518,12 +539,8 @@ public:
   {
     return groupby_datums_hash_;
   }
-  ObGroupRowItem*& next()
-  {
-    return *reinterpret_cast<ObGroupRowItem**>(&next_);
-  };
 
-  TO_STRING_KV(K_(group_id), KPC_(group_row), K_(groupby_datums_hash), KP_(group_exprs), KP_(next));
+  TO_STRING_KV(K_(group_id), KPC_(group_row), K_(groupby_datums_hash), KP_(group_exprs));
 
 public:
   int64_t group_id_;
@@ -533,22 +550,88 @@ public:
     ExprFixedArray* group_exprs_;
   };
   uint64_t groupby_datums_hash_;
-  void* next_;
 };
 
-class ObGroupRowHashTable : public ObExtendHashTable<ObGroupRowItem> {
+// Open addressing (linear probing) hash table of group rows, buckets are doubled when half filled.
+//
+// Hash value is stored in bucket together with the item pointer, group row is accessed only
+// when hash values are equal. Most probes are finished in one cache line of the bucket array,
+// while probing chained buckets costs one cache miss for each item of the chain.
+class ObGroupRowHashTable {
 public:
-  ObGroupRowHashTable() : ObExtendHashTable(), eval_ctx_(nullptr), cmp_funcs_(nullptr)
+  struct Bucket {
+    uint64_t hash_;
+    ObGroupRowItem* item_;  // NULL for empty bucket
+  };
+  const static int64_t INITIAL_SIZE = 128;
+  const static int64_t SIZE_BUCKET_SCALE = 2;
+  const static int64_t BUCKET_SIZE = sizeof(Bucket);
+
+  ObGroupRowHashTable()
+      : initial_bucket_num_(0), size_(0), buckets_(NULL), allocator_(NULL), eval_ctx_(nullptr), cmp_funcs_(nullptr)
   {}
+  ~ObGroupRowHashTable()
+  {
+    destroy();
+  }
 
-  const ObGroupRowItem* get(const ObGroupRowItem& item) const;
   int init(ObIAllocator* allocator, lib::ObMemAttr& mem_attr, ObEvalCtx* eval_ctx,
       const common::ObIArray<ObCmpFunc>* cmp_funcs, int64_t initial_size = INITIAL_SIZE);
+  bool is_inited() const
+  {
+    return NULL != buckets_;
+  }
+  // return the item which equal to, NULL for none exist.
+  const ObGroupRowItem* get(const ObGroupRowItem& item) const;
+  // Add item to hash table, extend buckets if needed.
+  // (Do not check item is exist or not)
+  int set(ObGroupRowItem& item);
+  int64_t size() const
+  {
+    return size_;
+  }
+  void reuse();
+  int resize(ObIAllocator* allocator, int64_t bucket_num);
+  void destroy();
+  int64_t mem_used() const
+  {
+    return NULL == buckets_ ? 0 : buckets_->mem_used();
+  }
+  inline int64_t get_bucket_num() const
+  {
+    return NULL == buckets_ ? 0 : buckets_->count();
+  }
+  template <typename CB>
+  int foreach (CB& cb) const
+  {
+    int ret = common::OB_SUCCESS;
+    if (OB_ISNULL(buckets_)) {
+      ret = OB_INVALID_ARGUMENT;
+      SQL_ENG_LOG(WARN, "invalid null buckets", K(ret), K(buckets_));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < get_bucket_num(); i++) {
+      ObGroupRowItem* item = buckets_->at(i).item_;
+      if (NULL != item && OB_FAIL(cb(*item))) {
+        SQL_ENG_LOG(WARN, "call back failed", K(ret));
+      }
+    }
+    return ret;
+  }
 
 private:
+  using BucketArray = common::ObSegmentArray<Bucket, OB_MALLOC_BIG_BLOCK_SIZE, common::ModulePageAllocator>;
+  int extend();
+  // add to %buckets which has empty bucket
+  static void insert(BucketArray& buckets, const uint64_t hash_val, ObGroupRowItem* item);
   bool compare(const ObGroupRowItem& left, const ObGroupRowItem& right) const;
+  DISALLOW_COPY_AND_ASSIGN(ObGroupRowHashTable);
 
 private:
+  lib::ObMemAttr mem_attr_;
+  int64_t initial_bucket_num_;
+  int64_t size_;
+  BucketArray* buckets_;
+  common::ModulePageAllocator allocator_;
   ObEvalCtx* eval_ctx_;
   const common::ObIArray<ObCmpFunc>* cmp_funcs_;
 };
@@ -22,7 +22,7 @@ using namespace common::hash;
 
 namespace sql {
 
-OB_SERIALIZE_MEMBER((ObHashGroupBySpec, ObGroupBySpec), group_exprs_, cmp_funcs_, est_group_cnt_);
+OB_SERIALIZE_MEMBER((ObHashGroupBySpec, ObGroupBySpec), group_exprs_, cmp_funcs_, est_group_cnt_, by_pass_enabled_);
 
 DEF_TO_STRING(ObHashGroupBySpec)
 {
@@ -32,7 +32,7 @@ DEF_TO_STRING(ObHashGroupBySpec)
   J_COLON();
   pos += ObGroupBySpec::to_string(buf + pos, buf_len - pos);
   J_COMMA();
-  J_KV(K_(group_exprs));
+  J_KV(K_(group_exprs), K_(by_pass_enabled));
   J_OBJ_END();
   return pos;
 }
@@ -57,6 +57,10 @@ void ObHashGroupByOp::reset()
   sql_mem_processor_.reset();
   destroy_all_parts();
   group_store_.reset();
+  by_pass_ = false;
+  by_pass_group_row_ = NULL;
+  by_pass_groupby_row_.reset();
+  by_pass_row_cnt_ = 0;
 }
 
 int ObHashGroupByOp::inner_open()
@@ -108,6 +112,7 @@ int ObHashGroupByOp::inner_open()
       group_store_.set_dir_id(sql_mem_processor_.get_dir_id());
       group_store_.set_callback(&sql_mem_processor_);
       group_store_.set_allocator(mem_context_->get_malloc_allocator());
+      by_pass_groupby_row_.reuse_ = true;
       op_monitor_info_.otherstat_1_value_ = init_size;
       op_monitor_info_.otherstat_1_id_ = ObSqlMonitorStatIds::HASH_INIT_BUCKET_COUNT;
       LOG_TRACE("trace init hash table",
@@ -210,7 +215,21 @@ int ObHashGroupByOp::inner_get_next_row()
 
   if (OB_SUCC(ret)) {
     if (OB_UNLIKELY(curr_group_id_ >= local_group_rows_.size())) {
-      if (dumped_group_parts_.is_empty()) {
+      if (by_pass_) {
+        // groups aggregated before by pass are all returned, pass through the remaining child rows.
+        if (OB_FAIL(by_pass_next_row())) {
+          if (OB_ITER_END != ret) {
+            LOG_WARN("get by pass row failed", K(ret));
+          } else {
+            op_monitor_info_.otherstat_2_value_ = agged_group_cnt_;
+            op_monitor_info_.otherstat_2_id_ = ObSqlMonitorStatIds::HASH_ROW_COUNT;
+            op_monitor_info_.otherstat_5_value_ += by_pass_row_cnt_;
+            op_monitor_info_.otherstat_5_id_ = ObSqlMonitorStatIds::GROUP_BY_BY_PASS_ROW_COUNT;
+            iter_end_ = true;
+            reset();
+          }
+        }
+      } else if (dumped_group_parts_.is_empty()) {
         op_monitor_info_.otherstat_2_value_ = agged_group_cnt_;
         op_monitor_info_.otherstat_2_id_ = ObSqlMonitorStatIds::HASH_ROW_COUNT;
         op_monitor_info_.otherstat_3_value_ =
@@ -254,9 +273,18 @@ int ObHashGroupByOp::inner_get_next_row()
   return ret;
 }
 
+// Group rows are stored in hash table memory which is released after all groups iterated
+// (or reused for dumped partition), output datums are deep copied to the reserved buffer.
+int ObHashGroupByOp::inner_get_next_batch(const int64_t max_row_cnt)
+{
+  return fill_batch_by_row(max_row_cnt);
+}
+
 int ObHashGroupByOp::load_data()
 {
   int ret = OB_SUCCESS;
+  // child rows are iterated by changing batch index, restore it after loaded.
+  ObEvalCtx::BatchInfoScopeGuard batch_info_guard(eval_ctx_);
   ObChunkDatumStore::Iterator row_store_iter;
   DatumStoreLinkPartition* cur_part = NULL;
   int64_t part_id = 0;
@@ -315,7 +343,25 @@ int ObHashGroupByOp::load_data()
   ObGbyBloomFilter* bloom_filter = NULL;
   const ObChunkDatumStore::StoredRow* srow = NULL;
 
+  // Sample the reduction of the first rows for pushed down group by. Groups are returned
+  // and the remaining rows are passed through if aggregation doesn't reduce rows.
+  const bool check_by_pass = MY_SPEC.by_pass_enabled_ && NULL == cur_part &&
+                             !(aggr_processor_.has_distinct() || aggr_processor_.has_order_by());
+
   for (int64_t loop_cnt = 0; OB_SUCC(ret); ++loop_cnt) {
+    if (check_by_pass && BY_PASS_SAMPLE_ROWS == loop_cnt && NULL == bloom_filter) {
+      int64_t group_percent = 0;
+      by_pass_ = need_by_pass(loop_cnt, local_group_rows_.size(), group_percent);
+      op_monitor_info_.otherstat_4_value_ = group_percent;
+      op_monitor_info_.otherstat_4_id_ = ObSqlMonitorStatIds::GROUP_BY_SAMPLE_GROUP_PERCENT;
+      if (by_pass_) {
+        LOG_TRACE("aggregation doesn't reduce rows, pass through child rows",
+            K(loop_cnt),
+            K(local_group_rows_.size()),
+            K(group_percent));
+        break;
+      }
+    }
     if (NULL == cur_part) {
       ret = child_->get_next_row();
     } else {
@@ -423,6 +469,53 @@ int ObHashGroupByOp::load_data()
   return ret;
 }
 
+bool ObHashGroupByOp::need_by_pass(const int64_t sample_row_cnt, const int64_t group_cnt, int64_t& group_percent)
+{
+  group_percent = sample_row_cnt > 0 ? group_cnt * 100 / sample_row_cnt : 0;
+  return sample_row_cnt >= BY_PASS_SAMPLE_ROWS && group_percent >= BY_PASS_GROUP_PERCENT;
+}
+
+// Get next child row and aggregate it to the by pass group, which is
+// the group after all groups of hash table.
+int ObHashGroupByOp::by_pass_next_row()
+{
+  int ret = OB_SUCCESS;
+  curr_group_id_ = local_group_rows_.size();
+  if (NULL == by_pass_group_row_) {
+    if (OB_FAIL(aggr_processor_.init_one_group(curr_group_id_))) {
+      LOG_WARN("failed to init one group", K(curr_group_id_), K(ret));
+    } else if (OB_FAIL(aggr_processor_.get_group_row(curr_group_id_, by_pass_group_row_))) {
+      LOG_WARN("failed to get group_row", K(curr_group_id_), K(ret));
+    } else if (OB_ISNULL(by_pass_group_row_)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("group_row is null", K(curr_group_id_), K(ret));
+    }
+  }
+  if (OB_SUCC(ret)) {
+    // child rows are iterated by changing batch index, restore it after aggregated.
+    ObEvalCtx::BatchInfoScopeGuard batch_info_guard(eval_ctx_);
+    if (OB_FAIL(child_->get_next_row())) {
+      if (OB_ITER_END != ret) {
+        LOG_WARN("get input row failed", K(ret));
+      }
+    } else if (FALSE_IT(clear_evaluated_flag())) {
+    } else if (OB_FAIL(aggr_processor_.reuse_group(curr_group_id_))) {
+      LOG_WARN("failed to reuse group", K(curr_group_id_), K(ret));
+    } else if (OB_FAIL(aggr_processor_.prepare(*by_pass_group_row_))) {
+      LOG_WARN("fail to prepare row", K(ret), KPC(by_pass_group_row_));
+    } else if (OB_FAIL(by_pass_groupby_row_.save_store_row(MY_SPEC.group_exprs_, eval_ctx_))) {
+      LOG_WARN("failed to save group by row", K(ret));
+    } else {
+      by_pass_group_row_->groupby_store_row_ = by_pass_groupby_row_.store_row_;
+      ++by_pass_row_cnt_;
+      if (by_pass_row_cnt_ % 1024 == 1023 && OB_FAIL(ctx_.check_status())) {
+        LOG_WARN("check status failed", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
 int ObHashGroupByOp::init_group_row_item(const ObGroupRowItem& curr_item, ObGroupRowItem*& gr_row_item)
 {
   int ret = common::OB_SUCCESS;
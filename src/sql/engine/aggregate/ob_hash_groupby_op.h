@@ -27,7 +27,7 @@ class ObHashGroupBySpec : public ObGroupBySpec {
 
 public:
   ObHashGroupBySpec(common::ObIAllocator& alloc, const ObPhyOperatorType type)
-      : ObGroupBySpec(alloc, type), group_exprs_(alloc), cmp_funcs_(alloc), est_group_cnt_(0)
+      : ObGroupBySpec(alloc, type), group_exprs_(alloc), cmp_funcs_(alloc), est_group_cnt_(0), by_pass_enabled_(false)
   {}
 
   DECLARE_VIRTUAL_TO_STRING;
@@ -49,6 +49,9 @@ public:
   ExprFixedArray group_exprs_;  // group by column
   ObCmpFuncs cmp_funcs_;
   int64_t est_group_cnt_;
+  // pushed down (partial) group by of parallel aggregation, which can pass through child rows
+  // when aggregation doesn't reduce rows.
+  bool by_pass_enabled_;
 };
 
 // input rows is already sorted by groupby columns
@@ -73,6 +76,10 @@ public:
   static constexpr const double MAX_PART_MEM_RATIO = 0.5;
   static constexpr const double EXTRA_MEM_RATIO = 0.25;
   static const int64_t FIX_SIZE_PER_PART = sizeof(DatumStoreLinkPartition) + ObChunkRowStore::BLOCK_SIZE;
+  // Pass through child rows if the groups of the first BY_PASS_SAMPLE_ROWS rows
+  // exceed BY_PASS_GROUP_PERCENT percent of the rows.
+  static const int64_t BY_PASS_SAMPLE_ROWS = 10000;
+  static const int64_t BY_PASS_GROUP_PERCENT = 90;
 
 public:
   ObHashGroupByOp(ObExecContext& exec_ctx, const ObOpSpec& spec, ObOpInput* input)
@@ -84,7 +91,11 @@ public:
         agged_dumped_cnt_(0),
         profile_(ObSqlWorkAreaType::HASH_WORK_AREA),
         sql_mem_processor_(profile_),
-        iter_end_(false)
+        iter_end_(false),
+        by_pass_(false),
+        by_pass_group_row_(NULL),
+        by_pass_groupby_row_(aggr_processor_.get_aggr_alloc()),
+        by_pass_row_cnt_(0)
   {}
   void reset();
   virtual int inner_open() override;
@@ -92,8 +103,12 @@ public:
   virtual int rescan() override;
   virtual int switch_iterator() override;
   virtual int inner_get_next_row() override;
+  virtual int inner_get_next_batch(const int64_t max_row_cnt) override;
   virtual void destroy() override;
   int load_data();
+  // whether the groups of sampled rows exceed BY_PASS_GROUP_PERCENT percent of the rows
+  static bool need_by_pass(const int64_t sample_row_cnt, const int64_t group_cnt, int64_t& group_percent);
+  int by_pass_next_row();
 
   int check_same_group(int64_t& diff_pos);
   int restore_groupby_datum(const int64_t diff_pos);
@@ -138,7 +153,7 @@ public:
   }
   OB_INLINE int64_t estimate_hash_bucket_size(const int64_t bucket_cnt) const
   {
-    return next_pow2(ObGroupRowHashTable::SIZE_BUCKET_SCALE * bucket_cnt) * sizeof(void*);
+    return next_pow2(ObGroupRowHashTable::SIZE_BUCKET_SCALE * bucket_cnt) * ObGroupRowHashTable::BUCKET_SIZE;
   }
   OB_INLINE int64_t estimate_hash_bucket_cnt_by_mem_size(
       const int64_t bucket_cnt, const int64_t max_mem_size, const double extra_ratio) const
@@ -150,7 +165,7 @@ public:
         mem_size >>= 1;
       }
     }
-    return (mem_size / sizeof(void*) / ObGroupRowHashTable::SIZE_BUCKET_SCALE);
+    return (mem_size / ObGroupRowHashTable::BUCKET_SIZE / ObGroupRowHashTable::SIZE_BUCKET_SCALE);
   }
   int update_mem_status_periodically(
       const int64_t nth_cnt, const int64_t input_row, int64_t& est_part_cnt, bool& need_dump);
@@ -189,6 +204,13 @@ private:
   ObSqlWorkAreaProfile profile_;
   ObSqlMemMgrProcessor sql_mem_processor_;
   bool iter_end_;
+
+  // pass through child rows after the groups in hash table returned,
+  // each child row is aggregated to a single row group.
+  bool by_pass_;
+  ObAggregateProcessor::GroupRow* by_pass_group_row_;
+  ObChunkDatumStore::LastStoredRow<> by_pass_groupby_row_;
+  int64_t by_pass_row_cnt_;
 };
 
 }  // end namespace sql
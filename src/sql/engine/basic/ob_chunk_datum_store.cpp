@@ -18,6 +18,7 @@
 #include "lib/container/ob_se_array_iterator.h"
 #include "lib/utility/ob_tracepoint.h"
 #include "share/config/ob_server_config.h"
+#include "lib/compress/ob_compressor_pool.h"
 
 namespace oceanbase {
 using namespace common;
@@ -407,7 +408,10 @@ ObChunkDatumStore::ObChunkDatumStore(common::ObIAllocator* alloc /* = NULL */)
       mem_used_(0),
       allocator_(NULL == alloc ? &inner_allocator_ : alloc),
       row_extend_size_(0),
-      callback_(nullptr)
+      callback_(nullptr),
+      compressor_(NULL),
+      compress_buf_(NULL),
+      compress_buf_size_(0)
 {
   io_.fd_ = -1;
   io_.dir_id_ = -1;
@@ -452,6 +456,13 @@ void ObChunkDatumStore::reset()
   }
   file_size_ = 0;
   n_block_in_file_ = 0;
+  compressor_ = NULL;
+  if (NULL != compress_buf_) {
+    callback_free(compress_buf_size_);
+    allocator_->free(compress_buf_);
+    compress_buf_ = NULL;
+  }
+  compress_buf_size_ = 0;
 
   while (!blocks_.is_empty()) {
     Block* item = blocks_.remove_first();
@@ -652,6 +663,14 @@ inline int ObChunkDatumStore::dump_one_block(BlockBuffer* item)
   item->block->magic_ = Block::MAGIC;
   if (OB_FAIL(item->get_block()->unswizzling())) {
     LOG_WARN("convert block to copyable failed", K(ret));
+  } else if (!is_file_open() && OB_FAIL(init_compressor())) {
+    LOG_WARN("init compressor failed", K(ret));
+  } else if (NULL != compressor_) {
+    if (OB_FAIL(write_compressed_block(item))) {
+      LOG_WARN("write compressed block to file failed", K(ret));
+    } else {
+      n_block_in_file_++;
+    }
   } else if (OB_FAIL(write_file(item->data(), item->capacity()))) {
     LOG_WARN("write block to file failed");
   } else {
@@ -661,6 +680,73 @@ inline int ObChunkDatumStore::dump_one_block(BlockBuffer* item)
   return ret;
 }
 
+int ObChunkDatumStore::init_compressor()
+{
+  int ret = OB_SUCCESS;
+  ObCompressorType type = NONE_COMPRESSOR;
+  compressor_ = NULL;
+  if (OB_FAIL(ObCompressorPool::get_instance().get_compressor_type(GCONF._temp_store_compress_func.str(), type))) {
+    LOG_WARN("get compressor type failed", K(ret), "compress_func", GCONF._temp_store_compress_func.str());
+  } else if (ObCompressorPool::need_common_compress(type) &&
+             OB_FAIL(ObCompressorPool::get_instance().get_compressor(type, compressor_))) {
+    LOG_WARN("get compressor failed", K(ret), K(type));
+  }
+  return ret;
+}
+
+int ObChunkDatumStore::reserve_compress_buf(char*& buf, int64_t& buf_size, const int64_t size)
+{
+  int ret = OB_SUCCESS;
+  if (size > buf_size) {
+    if (NULL != buf) {
+      callback_free(buf_size);
+      allocator_->free(buf);
+      buf = NULL;
+      buf_size = 0;
+    }
+    const int64_t alloc_size = next_pow2(size);
+    if (OB_ISNULL(buf = static_cast<char*>(alloc_blk_mem(alloc_size, true)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("alloc memory failed", K(ret), K(alloc_size));
+    } else {
+      buf_size = alloc_size;
+    }
+  }
+  return ret;
+}
+
+int ObChunkDatumStore::write_compressed_block(BlockBuffer* item)
+{
+  int ret = OB_SUCCESS;
+  const int64_t head_size = sizeof(CompressedBlockHead);
+  const int64_t data_size = item->data_size();
+  int64_t max_overflow_size = 0;
+  int64_t compressed_size = 0;
+  if (OB_FAIL(compressor_->get_max_overflow_size(data_size, max_overflow_size))) {
+    LOG_WARN("get max overflow size failed", K(ret), K(data_size));
+  } else if (OB_FAIL(reserve_compress_buf(
+                 compress_buf_, compress_buf_size_, head_size + data_size + max_overflow_size))) {
+    LOG_WARN("reserve compress buffer failed", K(ret), K(data_size), K(max_overflow_size));
+  } else if (OB_FAIL(compressor_->compress(item->data(),
+                 data_size,
+                 compress_buf_ + head_size,
+                 compress_buf_size_ - head_size,
+                 compressed_size))) {
+    LOG_WARN("compress block failed", K(ret), K(data_size));
+  } else {
+    CompressedBlockHead* head = new (compress_buf_) CompressedBlockHead();
+    head->blk_size_ = item->capacity();
+    head->data_size_ = data_size;
+    head->compressed_size_ = compressed_size;
+    if (OB_FAIL(write_file(compress_buf_, head_size + compressed_size))) {
+      LOG_WARN("write block to file failed", K(ret), KPC(head));
+    } else {
+      LOG_DEBUG("RowStore dumped compressed block", K_(item->block->rows), KPC(head));
+    }
+  }
+  return ret;
+}
+
 int ObChunkDatumStore::clean_block(Block* clean_block)
 {
   int ret = OB_SUCCESS;
@@ -1308,6 +1394,12 @@ int ObChunkDatumStore::load_next_block(ChunkIterator& it)
   } else if (it.cur_nth_blk_ < -1 || it.cur_nth_blk_ >= n_blocks_) {
     ret = OB_INVALID_ARGUMENT;
     LOG_WARN("row should be saved", K(ret), K_(it.cur_nth_blk), K_(n_blocks));
+  } else if (is_file_open() && !it.read_file_iter_end() && NULL != compressor_) {
+    if (OB_FAIL(load_next_compressed_block(it))) {
+      if (OB_ITER_END != ret) {
+        LOG_WARN("RowStore iter load next compressed block failed", K(ret));
+      }
+    }
   } else if (is_file_open() && !it.read_file_iter_end()) {
     LOG_DEBUG("debug read size", K(it.chunk_read_size_), K(this->max_blk_size_));
     bool enable_aio = false;
@@ -1500,6 +1592,86 @@ int ObChunkDatumStore::load_next_block(ChunkIterator& it)
   return ret;
 }
 
+int ObChunkDatumStore::load_next_compressed_block(ChunkIterator& it)
+{
+  int ret = OB_SUCCESS;
+  CompressedBlockHead head;
+  const int64_t head_size = sizeof(head);
+  int64_t data_size = 0;
+  if (it.cur_iter_pos_ >= file_size_) {
+    ret = OB_ITER_END;
+  } else if (OB_FAIL(read_file(&head, head_size, it.cur_iter_pos_, it.aio_read_handle_))) {
+    if (OB_ITER_END != ret) {
+      LOG_WARN("read compressed block head from file failed", K(ret), K_(it.cur_iter_pos));
+    }
+  } else if (!head.magic_check() || head.data_size_ > head.blk_size_ || head.compressed_size_ <= 0) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("StoreRow load compressed block head check failed", K(ret), K(head), K(it), K(io_));
+  } else if (OB_FAIL(reserve_compress_buf(it.compressed_buf_, it.compressed_buf_size_, head.compressed_size_))) {
+    LOG_WARN("reserve compress buffer failed", K(ret), K(head));
+  } else if (OB_FAIL(read_file(
+                 it.compressed_buf_, head.compressed_size_, it.cur_iter_pos_ + head_size, it.aio_read_handle_))) {
+    LOG_WARN("read compressed block from file failed", K(ret), K_(it.cur_iter_pos), K(head));
+  } else {
+    if (NULL != it.cur_iter_blk_ && it.cur_iter_blk_buf_->capacity() < head.blk_size_) {
+      callback_free(it.cur_iter_blk_buf_->mem_size());
+      allocator_->free(it.cur_iter_blk_);
+      it.cur_iter_blk_ = NULL;
+      it.cur_iter_blk_buf_ = NULL;
+    }
+    if (NULL != it.cur_iter_blk_) {
+    } else if (OB_FAIL(alloc_block_buffer(it.cur_iter_blk_, head.blk_size_ + sizeof(BlockBuffer), true))) {
+      LOG_WARN("alloc block failed", K(ret), K(head));
+    } else {
+      it.cur_iter_blk_buf_ = it.cur_iter_blk_->get_buffer();
+    }
+  }
+
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(compressor_->decompress(it.compressed_buf_,
+                 head.compressed_size_,
+                 it.cur_iter_blk_buf_->data(),
+                 it.cur_iter_blk_buf_->capacity(),
+                 data_size))) {
+    LOG_WARN("decompress block failed", K(ret), K(head));
+  } else if (data_size != head.data_size_ || !it.cur_iter_blk_->magic_check()) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("StoreRow load compressed block check failed", K(ret), K(data_size), K(head), K(*it.cur_iter_blk_));
+  } else if (OB_FAIL(it.cur_iter_blk_->swizzling(NULL))) {
+    LOG_WARN("swizzling failed after read block from file", K(ret), K(it));
+  } else if (0 == it.cur_iter_blk_->rows_) {
+    ret = OB_INNER_STAT_ERROR;
+    LOG_WARN("read file failed", K(ret), K(head), K(*it.cur_iter_blk_));
+  } else {
+    it.cur_iter_pos_ += head_size + head.compressed_size_;
+    it.cur_nth_blk_++;
+    it.cur_chunk_n_blocks_ = 1;
+    it.cur_iter_blk_->next_ = NULL;
+    it.chunk_n_rows_ = it.cur_iter_blk_->rows_;
+    LOG_TRACE("StoreRow read compressed block succ", K(head), K_(it.cur_iter_blk), K_(it.cur_iter_pos));
+  }
+
+  if (OB_FAIL(ret)) {
+    if (OB_ITER_END == ret) {
+      it.set_read_file_iter_end();
+    }
+    // read memory data after disk data, free the block and buffer of reading file
+    if (NULL != it.cur_iter_blk_) {
+      callback_free(it.cur_iter_blk_buf_->mem_size());
+      allocator_->free(it.cur_iter_blk_);
+      it.cur_iter_blk_ = NULL;
+      it.cur_iter_blk_buf_ = NULL;
+    }
+    if (NULL != it.compressed_buf_) {
+      callback_free(it.compressed_buf_size_);
+      allocator_->free(it.compressed_buf_);
+      it.compressed_buf_ = NULL;
+      it.compressed_buf_size_ = 0;
+    }
+  }
+  return ret;
+}
+
 int ObChunkDatumStore::get_store_row(RowIterator& it, const StoredRow*& sr)
 {
   int ret = OB_SUCCESS;
@@ -1577,7 +1749,9 @@ ObChunkDatumStore::ChunkIterator::ChunkIterator()
       chunk_read_size_(0),
       chunk_mem_(NULL),
       chunk_n_rows_(0),
-      iter_end_flag_(IterEndState::PROCESSING)
+      iter_end_flag_(IterEndState::PROCESSING),
+      compressed_buf_(NULL),
+      compressed_buf_size_(0)
 {}
 
 int ObChunkDatumStore::ChunkIterator::init(ObChunkDatumStore* store, int64_t chunk_read_size)
@@ -1607,6 +1781,13 @@ void ObChunkDatumStore::ChunkIterator::reset_cursor(const int64_t file_size)
     }
   }
 
+  if (NULL != compressed_buf_) {
+    store_->callback_free(compressed_buf_size_);
+    store_->allocator_->free(compressed_buf_);
+    compressed_buf_ = NULL;
+  }
+  compressed_buf_size_ = 0;
+
   next_iter_end_ = false;
   aio_read_handle_.reset();
   swap_aio_read_handle_.reset();
@@ -24,6 +24,7 @@
 #include "sql/engine/expr/ob_expr.h"
 #include "storage/blocksstable/ob_tmp_file.h"
 #include "sql/engine/basic/ob_sql_mem_callback.h"
+#include "lib/compress/ob_compressor.h"
 
 namespace oceanbase {
 namespace sql {
@@ -441,6 +442,25 @@ public:
     char payload_[0];
   } __attribute__((packed));
 
+  /* block dumped with compression:
+   * |CompressedBlockHead|compressed data of block (Block head and rows)|
+   * blocks are read one by one, chunk read and aio read are not supported.
+   */
+  struct CompressedBlockHead {
+    static const int64_t MAGIC = 0x3d5c2e8a91f04b67;
+    CompressedBlockHead() : magic_(MAGIC), blk_size_(0), data_size_(0), compressed_size_(0)
+    {}
+    inline bool magic_check() const
+    {
+      return MAGIC == magic_;
+    }
+    TO_STRING_KV(K_(magic), K_(blk_size), K_(data_size), K_(compressed_size));
+    int64_t magic_;
+    int64_t blk_size_;         // Block::blk_size_ before compression
+    int64_t data_size_;        // uncompressed data size
+    int64_t compressed_size_;  // compressed data size (head excluded)
+  };
+
   struct BlockList {
   public:
     BlockList() : head_(NULL), last_(NULL), size_(0)
@@ -723,6 +743,9 @@ public:
     char* chunk_mem_;
     int64_t chunk_n_rows_;
     int32_t iter_end_flag_;
+    // buffer for compressed block read from file
+    char* compressed_buf_;
+    int64_t compressed_buf_size_;
   };
 
   class Iterator {
@@ -918,6 +941,10 @@ public:
 
   int update_iterator(Iterator& org_it);
   int clean_block(Block* clean_block);
+  bool is_compressed() const
+  {
+    return NULL != compressor_;
+  }
 
 private:
   OB_INLINE int add_row(
@@ -942,6 +969,11 @@ private:
     mem_used_ += used;
   }
   inline int dump_one_block(BlockBuffer* item);
+  // compressor is decided by _temp_store_compress_func when file opened
+  int init_compressor();
+  int write_compressed_block(BlockBuffer* item);
+  int load_next_compressed_block(ChunkIterator& it);
+  int reserve_compress_buf(char*& buf, int64_t& buf_size, const int64_t size);
 
   int write_file(void* buf, int64_t size);
   int read_file(void* buf, const int64_t size, const int64_t offset, blocksstable::ObTmpFileIOHandle& handle);
@@ -1007,6 +1039,11 @@ private:
   uint32_t row_extend_size_;
   ObSqlMemoryCallback* callback_;
 
+  // compressor of dumped blocks, NULL if blocks are dumped without compression.
+  common::ObCompressor* compressor_;
+  char* compress_buf_;
+  int64_t compress_buf_size_;
+
   DISALLOW_COPY_AND_ASSIGN(ObChunkDatumStore);
 };
 
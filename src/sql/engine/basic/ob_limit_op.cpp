@@ -200,6 +200,53 @@ int ObLimitOp::inner_get_next_row()
   return ret;
 }
 
+// Only simple limit offset (without percent, ties and found rows calculation) is vectorized,
+// rows of child batch are passed through with rows out of [offset, offset + limit) skipped.
+int ObLimitOp::inner_get_next_batch(const int64_t max_row_cnt)
+{
+  int ret = OB_SUCCESS;
+  const ObBatchRows* child_brs = NULL;
+  bool got_rows = false;
+  while (OB_SUCC(ret) && !got_rows && !brs_.end_) {
+    if (0 == limit_ || (limit_ > 0 && output_cnt_ >= limit_)) {
+      brs_.size_ = 0;
+      brs_.end_ = true;
+    } else if (OB_FAIL(child_->get_next_batch(max_row_cnt, child_brs))) {
+      LOG_WARN("child_op failed to get next batch", K(ret), K_(limit), K_(offset), K_(input_cnt), K_(output_cnt));
+    } else {
+      brs_.size_ = child_brs->size_;
+      brs_.end_ = child_brs->end_;
+      brs_.skip_->deep_copy(*child_brs->skip_, child_brs->size_);
+      for (int64_t i = 0; i < brs_.size_; i++) {
+        if (brs_.skip_->at(i)) {
+          // skipped by child
+        } else if (input_cnt_ < offset_) {
+          ++input_cnt_;
+          brs_.skip_->set(i);
+        } else if (limit_ < 0 || output_cnt_ < limit_) {
+          ++output_cnt_;
+          got_rows = true;
+        } else {
+          brs_.skip_->set(i);
+          brs_.end_ = true;
+        }
+      }
+    }
+  }
+  if (OB_SUCC(ret) && brs_.end_ && MY_SPEC.is_top_limit_) {
+    total_cnt_ = output_cnt_ + input_cnt_;
+    ObPhysicalPlanCtx* plan_ctx = NULL;
+    if (OB_ISNULL(plan_ctx = ctx_.get_physical_plan_ctx())) {
+      ret = OB_ERR_NULL_VALUE;
+      LOG_WARN("get physical plan context failed");
+    } else {
+      NG_TRACE_EXT(found_rows, OB_ID(total_count), total_cnt_, OB_ID(input_count), input_cnt_);
+      plan_ctx->set_found_rows(total_cnt_);
+    }
+  }
+  return ret;
+}
+
 int ObLimitOp::is_row_order_by_item_value_equal(bool& is_equal)
 {
   int ret = OB_SUCCESS;
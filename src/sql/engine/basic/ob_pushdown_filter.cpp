@@ -41,7 +41,7 @@ OB_SERIALIZE_MEMBER(ObPushdownFilterNode, type_, n_child_, col_ids_);
 OB_SERIALIZE_MEMBER((ObPushdownAndFilterNode, ObPushdownFilterNode));
 OB_SERIALIZE_MEMBER((ObPushdownOrFilterNode, ObPushdownFilterNode));
 OB_SERIALIZE_MEMBER((ObPushdownBlackFilterNode, ObPushdownFilterNode), column_exprs_, filter_exprs_);
-OB_SERIALIZE_MEMBER((ObPushdownWhiteFilterNode, ObPushdownFilterNode));
+OB_SERIALIZE_MEMBER((ObPushdownWhiteFilterNode, ObPushdownFilterNode), op_type_, column_expr_, param_exprs_);
 
 int ObPushdownBlackFilterNode::merge(ObIArray<ObPushdownFilterNode*>& merged_node)
 {
@@ -119,6 +119,210 @@ int ObPushdownFilterConstructor::create_black_filter_node(ObRawExpr* raw_expr, O
   return ret;
 }
 
+// Column types can be compared by storage with the stored value directly. Fixed length char
+// is excluded since trailing spaces are trimmed in storage and padded after scan.
+static bool is_white_column_type(const ObObjType type)
+{
+  bool ret_bool = false;
+  switch (ob_obj_type_class(type)) {
+    case ObIntTC:
+    case ObUIntTC:
+    case ObFloatTC:
+    case ObDoubleTC:
+    case ObNumberTC:
+    case ObDateTimeTC:
+    case ObDateTC:
+    case ObTimeTC:
+    case ObYearTC: {
+      ret_bool = true;
+      break;
+    }
+    case ObStringTC: {
+      ret_bool = ObCharType != type && ObNCharType != type;
+      break;
+    }
+    default: {
+      break;
+    }
+  }
+  return ret_bool;
+}
+
+bool ObPushdownFilterConstructor::is_white_param(const ObRawExpr* col_expr, const ObRawExpr* param_expr)
+{
+  bool ret_bool = false;
+  if (OB_ISNULL(col_expr) || OB_ISNULL(param_expr)) {
+  } else if (!param_expr->is_const_expr() || param_expr->has_flag(IS_EXEC_PARAM) ||
+             param_expr->has_flag(CNT_EXEC_PARAM)) {
+    // operands are evaluated only once when table scan opened, exec params are changed in rescan.
+  } else {
+    const ObExprResType& col_type = col_expr->get_result_type();
+    const ObExprResType& param_type = param_expr->get_result_type();
+    if (param_type.is_null()) {
+      // compare with null is never true
+      ret_bool = true;
+    } else if (col_type.get_type_class() != param_type.get_type_class()) {
+    } else if (ob_is_int_tc(col_type.get_type()) || ob_is_uint_tc(col_type.get_type())) {
+      ret_bool = true;
+    } else if (col_type.get_type() != param_type.get_type()) {
+    } else if (ob_is_string_tc(col_type.get_type())) {
+      ret_bool = col_type.get_collation_type() == param_type.get_collation_type();
+    } else {
+      ret_bool = true;
+    }
+  }
+  return ret_bool;
+}
+
+// White filter: column [=, <=, <, >=, >] constant, column BETWEEN constant AND constant,
+// column IN (constants), column IS NULL.
+// No cast can be added to the column and the constant, otherwise the child of the filter is
+// not column and constant directly.
+bool ObPushdownFilterConstructor::is_white_mode(const ObRawExpr* raw_expr)
+{
+  bool ret_bool = false;
+  const ObRawExpr* col_expr = nullptr;
+  if (OB_ISNULL(raw_expr) || raw_expr->get_param_count() < 1 || OB_ISNULL(col_expr = raw_expr->get_param_expr(0))) {
+  } else if (!col_expr->is_column_ref_expr() ||
+             static_cast<const ObColumnRefRawExpr*>(col_expr)->is_generated_column() ||
+             !is_white_column_type(col_expr->get_result_type().get_type())) {
+  } else {
+    const int64_t param_cnt = raw_expr->get_param_count();
+    switch (raw_expr->get_expr_type()) {
+      case T_OP_EQ:
+      case T_OP_LE:
+      case T_OP_LT:
+      case T_OP_GE:
+      case T_OP_GT: {
+        ret_bool = 2 == param_cnt && is_white_param(col_expr, raw_expr->get_param_expr(1));
+        break;
+      }
+      case T_OP_BTW: {
+        ret_bool = 3 == param_cnt && is_white_param(col_expr, raw_expr->get_param_expr(1)) &&
+                   is_white_param(col_expr, raw_expr->get_param_expr(2));
+        break;
+      }
+      case T_OP_IN: {
+        const ObRawExpr* row_expr = raw_expr->get_param_expr(1);
+        if (2 == param_cnt && OB_NOT_NULL(row_expr) && T_OP_ROW == row_expr->get_expr_type() &&
+            0 < row_expr->get_param_count()) {
+          ret_bool = true;
+          for (int64_t i = 0; ret_bool && i < row_expr->get_param_count(); ++i) {
+            ret_bool = is_white_param(col_expr, row_expr->get_param_expr(i));
+          }
+        }
+        break;
+      }
+      case T_OP_IS: {
+        ret_bool = 3 == param_cnt && OB_NOT_NULL(raw_expr->get_param_expr(1)) &&
+                   T_NULL == raw_expr->get_param_expr(1)->get_expr_type();
+        break;
+      }
+      default: {
+        break;
+      }
+    }
+  }
+  return ret_bool;
+}
+
+int ObPushdownFilterConstructor::create_white_filter_node(ObRawExpr* raw_expr, ObPushdownFilterNode*& filter_node)
+{
+  int ret = OB_SUCCESS;
+  ObRawExpr* col_raw_expr = nullptr;
+  ObSEArray<ObRawExpr*, 4> param_raw_exprs;
+  ObWhiteFilterOperatorType op_type = WHITE_OP_MAX;
+  ObPushdownWhiteFilterNode* white_filter_node = nullptr;
+  if (OB_ISNULL(raw_expr) || OB_ISNULL(col_raw_expr = raw_expr->get_param_expr(0))) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid null raw expr", K(ret), KP(raw_expr));
+  } else {
+    switch (raw_expr->get_expr_type()) {
+      case T_OP_EQ:
+        op_type = WHITE_OP_EQ;
+        break;
+      case T_OP_LE:
+        op_type = WHITE_OP_LE;
+        break;
+      case T_OP_LT:
+        op_type = WHITE_OP_LT;
+        break;
+      case T_OP_GE:
+        op_type = WHITE_OP_GE;
+        break;
+      case T_OP_GT:
+        op_type = WHITE_OP_GT;
+        break;
+      case T_OP_BTW:
+        op_type = WHITE_OP_BT;
+        break;
+      case T_OP_IN:
+        op_type = WHITE_OP_IN;
+        break;
+      case T_OP_IS:
+        op_type = WHITE_OP_NU;
+        break;
+      default:
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("unexpected white filter expr", K(ret), K(raw_expr->get_expr_type()));
+        break;
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (WHITE_OP_IN == op_type) {
+    ObRawExpr* row_expr = raw_expr->get_param_expr(1);
+    if (OB_ISNULL(row_expr)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("row expr is null", K(ret));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < row_expr->get_param_count(); ++i) {
+      if (OB_FAIL(param_raw_exprs.push_back(row_expr->get_param_expr(i)))) {
+        LOG_WARN("failed to push back param expr", K(ret));
+      }
+    }
+  } else if (WHITE_OP_NU != op_type) {
+    for (int64_t i = 1; OB_SUCC(ret) && i < raw_expr->get_param_count(); ++i) {
+      if (OB_FAIL(param_raw_exprs.push_back(raw_expr->get_param_expr(i)))) {
+        LOG_WARN("failed to push back param expr", K(ret));
+      }
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(factory_.alloc(PushdownFilterType::WHITE_FILTER, 0, filter_node))) {
+    LOG_WARN("failed t o alloc pushdown filter", K(ret));
+  } else if (OB_ISNULL(filter_node)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("white filter node is null", K(ret));
+  } else if (FALSE_IT(white_filter_node = static_cast<ObPushdownWhiteFilterNode*>(filter_node))) {
+  } else if (OB_FAIL(white_filter_node->col_ids_.init(1))) {
+    LOG_WARN("failed to init column ids", K(ret));
+  } else if (OB_FAIL(white_filter_node->col_ids_.push_back(
+                 static_cast<ObColumnRefRawExpr*>(col_raw_expr)->get_column_id()))) {
+    LOG_WARN("failed to push back column id", K(ret));
+  } else if (OB_FAIL(static_cg_.generate_rt_expr(*col_raw_expr, white_filter_node->column_expr_))) {
+    LOG_WARN("failed to generate rt expr", K(ret));
+  } else if (0 < param_raw_exprs.count() && OB_FAIL(white_filter_node->param_exprs_.init(param_raw_exprs.count()))) {
+    LOG_WARN("failed to init param exprs", K(ret));
+  } else {
+    white_filter_node->op_type_ = op_type;
+    for (int64_t i = 0; OB_SUCC(ret) && i < param_raw_exprs.count(); ++i) {
+      ObExpr* param_expr = nullptr;
+      if (OB_ISNULL(param_raw_exprs.at(i))) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("param expr is null", K(ret), K(i));
+      } else if (OB_FAIL(static_cg_.generate_rt_expr(*param_raw_exprs.at(i), param_expr))) {
+        LOG_WARN("failed to generate rt expr", K(ret));
+      } else if (OB_FAIL(white_filter_node->param_exprs_.push_back(param_expr))) {
+        LOG_WARN("failed to push back param expr", K(ret));
+      }
+    }
+  }
+  if (OB_SUCC(ret)) {
+    LOG_DEBUG("debug white_filter_node", K(*raw_expr), K(op_type), K(white_filter_node->col_ids_));
+  }
+  return ret;
+}
+
 int ObPushdownFilterConstructor::merge_filter_node(
     ObPushdownFilterNode* dst, ObPushdownFilterNode* other, ObIArray<ObPushdownFilterNode*>& merged_node, bool& merged)
 {
@@ -183,12 +387,9 @@ int ObPushdownFilterConstructor::apply(ObRawExpr* raw_expr, ObPushdownFilterNode
     ret = OB_NOT_SUPPORTED;
     LOG_WARN("not supported", K(ret));
   } else if (is_white_mode(raw_expr)) {
-    // create white filter
-    // if (OB_FAIL(factory_.alloc(PushdownFilterType::WHITE, filter_node))) {
-    //   LOG_WARN("failed t o alloc pushdown filter", K(ret));
-    // }
-    ret = OB_NOT_SUPPORTED;
-    LOG_WARN("not supported", K(ret));
+    if (OB_FAIL(create_white_filter_node(raw_expr, filter_node))) {
+      LOG_WARN("failed t o alloc pushdown filter", K(ret));
+    }
   } else {
     if (OB_FAIL(create_black_filter_node(raw_expr, filter_node))) {
       LOG_WARN("failed t o alloc pushdown filter", K(ret));
@@ -541,8 +742,155 @@ int ObBlackFilterExecutor::filter(bool& filtered)
 int ObWhiteFilterExecutor::filter(bool& filtered)
 {
   int ret = OB_SUCCESS;
-  UNUSED(filtered);
-  ret = OB_NOT_SUPPORTED;
+  ObDatum* datum = NULL;
+  ObObj obj;
+  ObExpr* column_expr = get_white_filter_node().column_expr_;
+  if (OB_ISNULL(eval_ctx_) || OB_ISNULL(column_expr)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("eval ctx or column expr is null", K(ret), KP(eval_ctx_), KP(column_expr));
+  } else if (OB_FAIL(column_expr->eval(*eval_ctx_, datum))) {
+    LOG_WARN("failed to eval column expr", K(ret));
+  } else if (OB_FAIL(datum->to_obj(obj, column_expr->obj_meta_, column_expr->obj_datum_map_))) {
+    LOG_WARN("failed to convert datum to obj", K(ret));
+  } else if (OB_FAIL(filter(obj, filtered))) {
+    LOG_WARN("failed to filter", K(ret), K(obj));
+  }
+  return ret;
+}
+
+int ObWhiteFilterExecutor::filter(const ObObj& obj, bool& filtered) const
+{
+  int ret = OB_SUCCESS;
+  const ObWhiteFilterOperatorType op_type = static_cast<ObPushdownWhiteFilterNode&>(filter_).get_op_type();
+  int cmp = 0;
+  filtered = true;
+  if (obj.is_nop_value()) {
+    // column not exists in storage, value is filled later, can not be filtered here.
+    filtered = false;
+  } else if (obj.is_null()) {
+    filtered = WHITE_OP_NU != op_type;
+  } else if (WHITE_OP_NU == op_type) {
+  } else if (WHITE_OP_IN == op_type) {
+    for (int64_t i = 0; OB_SUCC(ret) && filtered && i < params_.count(); ++i) {
+      if (params_.at(i).is_null()) {
+      } else if (OB_FAIL(compare(obj, params_.at(i), cmp))) {
+        LOG_WARN("failed to compare", K(ret), K(obj), K(params_.at(i)));
+      } else {
+        filtered = 0 != cmp;
+      }
+    }
+  } else if (WHITE_OP_BT == op_type) {
+    if (OB_UNLIKELY(2 != params_.count())) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("unexpected param count", K(ret), K(params_));
+    } else if (params_.at(0).is_null() || params_.at(1).is_null()) {
+    } else if (OB_FAIL(compare(obj, params_.at(0), cmp))) {
+      LOG_WARN("failed to compare", K(ret), K(obj), K(params_.at(0)));
+    } else if (cmp < 0) {
+    } else if (OB_FAIL(compare(obj, params_.at(1), cmp))) {
+      LOG_WARN("failed to compare", K(ret), K(obj), K(params_.at(1)));
+    } else {
+      filtered = cmp > 0;
+    }
+  } else if (OB_UNLIKELY(1 != params_.count())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected param count", K(ret), K(op_type), K(params_));
+  } else if (params_.at(0).is_null()) {
+  } else if (OB_FAIL(compare(obj, params_.at(0), cmp))) {
+    LOG_WARN("failed to compare", K(ret), K(obj), K(params_.at(0)));
+  } else {
+    switch (op_type) {
+      case WHITE_OP_EQ:
+        filtered = 0 != cmp;
+        break;
+      case WHITE_OP_LE:
+        filtered = cmp > 0;
+        break;
+      case WHITE_OP_LT:
+        filtered = cmp >= 0;
+        break;
+      case WHITE_OP_GE:
+        filtered = cmp < 0;
+        break;
+      case WHITE_OP_GT:
+        filtered = cmp <= 0;
+        break;
+      default:
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("unexpected white filter operator type", K(ret), K(op_type));
+        break;
+    }
+  }
+  return ret;
+}
+
+int ObWhiteFilterExecutor::filter_range(const ObObj& min, const ObObj& max, bool& filtered) const
+{
+  int ret = OB_SUCCESS;
+  const ObWhiteFilterOperatorType op_type = static_cast<ObPushdownWhiteFilterNode&>(filter_).get_op_type();
+  int min_cmp = 0;
+  int max_cmp = 0;
+  filtered = true;
+  if (OB_UNLIKELY(min.is_null() || max.is_null() || min.is_nop_value() || max.is_nop_value())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(min), K(max));
+  } else if (WHITE_OP_NU == op_type) {
+  } else if (WHITE_OP_IN == op_type) {
+    for (int64_t i = 0; OB_SUCC(ret) && filtered && i < params_.count(); ++i) {
+      if (params_.at(i).is_null()) {
+      } else if (OB_FAIL(compare(min, params_.at(i), min_cmp))) {
+        LOG_WARN("failed to compare", K(ret), K(min), K(params_.at(i)));
+      } else if (min_cmp > 0) {
+      } else if (OB_FAIL(compare(max, params_.at(i), max_cmp))) {
+        LOG_WARN("failed to compare", K(ret), K(max), K(params_.at(i)));
+      } else {
+        filtered = max_cmp < 0;
+      }
+    }
+  } else if (WHITE_OP_BT == op_type) {
+    if (OB_UNLIKELY(2 != params_.count())) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("unexpected param count", K(ret), K(params_));
+    } else if (params_.at(0).is_null() || params_.at(1).is_null()) {
+    } else if (OB_FAIL(compare(max, params_.at(0), max_cmp))) {
+      LOG_WARN("failed to compare", K(ret), K(max), K(params_.at(0)));
+    } else if (max_cmp < 0) {
+    } else if (OB_FAIL(compare(min, params_.at(1), min_cmp))) {
+      LOG_WARN("failed to compare", K(ret), K(min), K(params_.at(1)));
+    } else {
+      filtered = min_cmp > 0;
+    }
+  } else if (OB_UNLIKELY(1 != params_.count())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected param count", K(ret), K(op_type), K(params_));
+  } else if (params_.at(0).is_null()) {
+  } else if (OB_FAIL(compare(min, params_.at(0), min_cmp))) {
+    LOG_WARN("failed to compare", K(ret), K(min), K(params_.at(0)));
+  } else if (OB_FAIL(compare(max, params_.at(0), max_cmp))) {
+    LOG_WARN("failed to compare", K(ret), K(max), K(params_.at(0)));
+  } else {
+    switch (op_type) {
+      case WHITE_OP_EQ:
+        filtered = min_cmp > 0 || max_cmp < 0;
+        break;
+      case WHITE_OP_LE:
+        filtered = min_cmp > 0;
+        break;
+      case WHITE_OP_LT:
+        filtered = min_cmp >= 0;
+        break;
+      case WHITE_OP_GE:
+        filtered = max_cmp < 0;
+        break;
+      case WHITE_OP_GT:
+        filtered = max_cmp <= 0;
+        break;
+      default:
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("unexpected white filter operator type", K(ret), K(op_type));
+        break;
+    }
+  }
   return ret;
 }
 // end for test filter
@@ -674,10 +1022,35 @@ int ObWhiteFilterExecutor::init_evaluated_datums(
     ObIAllocator& alloc, const ObIArray<ObExpr*>& calc_exprs, ObEvalCtx* eval_ctx)
 {
   int ret = OB_SUCCESS;
-  UNUSED(alloc);
   UNUSED(calc_exprs);
-  UNUSED(eval_ctx);
-  ret = OB_NOT_SUPPORTED;
+  ObPushdownWhiteFilterNode& node = get_white_filter_node();
+  eval_ctx_ = eval_ctx;
+  if (OB_ISNULL(eval_ctx) || OB_ISNULL(node.column_expr_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("eval ctx or column expr is null", K(ret), KP(eval_ctx), KP(node.column_expr_));
+  } else if (0 < node.param_exprs_.count() && OB_FAIL(params_.init(node.param_exprs_.count()))) {
+    LOG_WARN("failed to init params", K(ret));
+  } else {
+    cs_type_ = node.column_expr_->obj_meta_.get_collation_type();
+    for (int64_t i = 0; OB_SUCC(ret) && i < node.param_exprs_.count(); ++i) {
+      ObExpr* param_expr = node.param_exprs_.at(i);
+      ObDatum* datum = NULL;
+      ObObj obj;
+      ObObj param;
+      if (OB_ISNULL(param_expr)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("param expr is null", K(ret), K(i));
+      } else if (OB_FAIL(param_expr->eval(*eval_ctx, datum))) {
+        LOG_WARN("failed to eval param expr", K(ret));
+      } else if (OB_FAIL(datum->to_obj(obj, param_expr->obj_meta_, param_expr->obj_datum_map_))) {
+        LOG_WARN("failed to convert datum to obj", K(ret));
+      } else if (OB_FAIL(deep_copy_obj(alloc, obj, param))) {
+        LOG_WARN("failed to deep copy obj", K(ret), K(obj));
+      } else if (OB_FAIL(params_.push_back(param))) {
+        LOG_WARN("failed to push back param", K(ret));
+      }
+    }
+  }
   return ret;
 }
 
@@ -44,6 +44,19 @@ enum FilterExecutorType {
   MAX_EXECUTOR_TYPE
 };
 
+// operators of white filter: <column> <op> <constants>
+enum ObWhiteFilterOperatorType {
+  WHITE_OP_EQ,  // =
+  WHITE_OP_LE,  // <=
+  WHITE_OP_LT,  // <
+  WHITE_OP_GE,  // >=
+  WHITE_OP_GT,  // >
+  WHITE_OP_BT,  // between
+  WHITE_OP_IN,  // in
+  WHITE_OP_NU,  // is null
+  WHITE_OP_MAX
+};
+
 class ObPushdownFilterUtils {
 public:
   static bool is_pushdown_storage(int32_t pd_storage_flag)
@@ -132,14 +145,27 @@ public:
   ObExpr* tmp_expr_;
 };
 
+// Filter of one column compared with constants, can be evaluated by storage directly on
+// the stored column value, see ObPushdownFilterConstructor::is_white_mode().
 class ObPushdownWhiteFilterNode : public ObPushdownFilterNode {
   OB_UNIS_VERSION_V(1);
 
 public:
-  ObPushdownWhiteFilterNode(common::ObIAllocator& alloc) : ObPushdownFilterNode(alloc)
+  ObPushdownWhiteFilterNode(common::ObIAllocator& alloc)
+      : ObPushdownFilterNode(alloc), op_type_(WHITE_OP_MAX), column_expr_(nullptr), param_exprs_(alloc)
   {}
   ~ObPushdownWhiteFilterNode()
   {}
+  ObWhiteFilterOperatorType get_op_type() const
+  {
+    return op_type_;
+  }
+
+public:
+  ObWhiteFilterOperatorType op_type_;
+  ObExpr* column_expr_;
+  // constant operands, empty for IS NULL, value list for IN, [low, high] for BETWEEN.
+  ExprFixedArray param_exprs_;
 };
 
 class ObPushdownFilterExecutor;
@@ -184,16 +210,14 @@ private:
       common::ObIArray<ObPushdownFilterNode*>& merged_node, bool& merged);
   int deduplicate_filter_node(common::ObIArray<ObPushdownFilterNode*>& filter_nodes, uint32_t& n_node);
   int create_black_filter_node(ObRawExpr* raw_expr, ObPushdownFilterNode*& filter_tree);
+  int create_white_filter_node(ObRawExpr* raw_expr, ObPushdownFilterNode*& filter_tree);
   bool can_split_or(ObRawExpr* raw_expr)
   {
     UNUSED(raw_expr);
     return false;
   }
-  bool is_white_mode(ObRawExpr* raw_expr)
-  {
-    UNUSED(raw_expr);
-    return false;
-  }
+  bool is_white_mode(const ObRawExpr* raw_expr);
+  bool is_white_param(const ObRawExpr* col_expr, const ObRawExpr* param_expr);
 
 private:
   common::ObIAllocator* alloc_;
@@ -429,17 +453,36 @@ OB_INLINE void ObBlackFilterExecutor::clear_evaluated_datums()
 class ObWhiteFilterExecutor : public ObPushdownFilterExecutor {
 public:
   ObWhiteFilterExecutor(common::ObIAllocator& alloc, ObPushdownWhiteFilterNode& filter)
-      : ObPushdownFilterExecutor(alloc, filter)
+      : ObPushdownFilterExecutor(alloc, filter), params_(alloc), cs_type_(common::CS_TYPE_INVALID), eval_ctx_(nullptr)
   {}
   ~ObWhiteFilterExecutor()
   {}
 
+  // filter by the column value of one row, %filtered is true if the row is not selected.
+  int filter(const common::ObObj& obj, bool& filtered) const;
+  // filter by the value range [%min, %max] of the non-null values of a column, %filtered is true if none of the
+  // values in the range is selected. Null values are not covered and must be checked by the caller.
+  int filter_range(const common::ObObj& min, const common::ObObj& max, bool& filtered) const;
   virtual int filter(bool& filtered) override;
+  // evaluate the constant operands, which are kept during the whole scan.
   virtual int init_evaluated_datums(
       common::ObIAllocator& alloc, const common::ObIArray<ObExpr*>& calc_exprs, ObEvalCtx* eval_ctx) override;
-  INHERIT_TO_STRING_KV("ObPushdownFilterExecutor", ObPushdownFilterExecutor, K_(filter));
+  OB_INLINE ObPushdownWhiteFilterNode& get_white_filter_node()
+  {
+    return static_cast<ObPushdownWhiteFilterNode&>(filter_);
+  }
+  INHERIT_TO_STRING_KV("ObPushdownFilterExecutor", ObPushdownFilterExecutor, K_(filter), K_(params), K_(cs_type));
 
 private:
+  OB_INLINE int compare(const common::ObObj& obj, const common::ObObj& param, int& cmp) const
+  {
+    return obj.compare(param, cs_type_, cmp);
+  }
+
+private:
+  common::ObFixedArray<common::ObObj, common::ObIAllocator> params_;
+  common::ObCollationType cs_type_;
+  ObEvalCtx* eval_ctx_;
 };
 
 class ObAndFilterExecutor : public ObPushdownFilterExecutor {
@@ -0,0 +1,486 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+
+#include "sql/engine/expr/ob_batch_eval_util.h"
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace oceanbase {
+using namespace common;
+namespace sql {
+
+namespace {
+
+// Scalar kernels, integer operations are performed in unsigned to wrap around on overflow.
+struct AddIntOp {
+  static int64_t calc(const int64_t l, const int64_t r)
+  {
+    return static_cast<int64_t>(static_cast<uint64_t>(l) + static_cast<uint64_t>(r));
+  }
+};
+struct SubIntOp {
+  static int64_t calc(const int64_t l, const int64_t r)
+  {
+    return static_cast<int64_t>(static_cast<uint64_t>(l) - static_cast<uint64_t>(r));
+  }
+};
+struct MulIntOp {
+  static int64_t calc(const int64_t l, const int64_t r)
+  {
+    return static_cast<int64_t>(static_cast<uint64_t>(l) * static_cast<uint64_t>(r));
+  }
+};
+struct AddDoubleOp {
+  static double calc(const double l, const double r)
+  {
+    return l + r;
+  }
+};
+struct SubDoubleOp {
+  static double calc(const double l, const double r)
+  {
+    return l - r;
+  }
+};
+struct MulDoubleOp {
+  static double calc(const double l, const double r)
+  {
+    return l * r;
+  }
+};
+
+template <typename Op, typename T>
+void scalar_arith(const T* l, const T* r, T* res, const int64_t cnt)
+{
+  for (int64_t i = 0; i < cnt; i++) {
+    res[i] = Op::calc(l[i], r[i]);
+  }
+}
+
+// same with ObDatumCmpHelperByTC::cmp() and get_cmp_ret()
+template <ObCmpOp cmp_op, typename T>
+OB_INLINE int64_t scalar_cmp(const T l, const T r)
+{
+  int64_t res = 0;
+  const bool eq = (l == r);
+  const bool lt = (l < r);
+  switch (cmp_op) {
+    case CO_EQ:
+      res = eq;
+      break;
+    case CO_NE:
+      res = !eq;
+      break;
+    case CO_LT:
+      res = lt;
+      break;
+    case CO_LE:
+      res = eq || lt;
+      break;
+    case CO_GT:
+      res = !eq && !lt;
+      break;
+    case CO_GE:
+      res = !lt;
+      break;
+    default:
+      break;
+  }
+  return res;
+}
+
+template <ObCmpOp cmp_op, typename T>
+void scalar_cmp_kernel(const T* l, const T* r, int64_t* res, const int64_t start, const int64_t cnt)
+{
+  for (int64_t i = start; i < cnt; i++) {
+    res[i] = scalar_cmp<cmp_op>(l[i], r[i]);
+  }
+}
+
+#if defined(__x86_64__)
+
+#define AVX2_FUNC __attribute__((target("avx2")))
+
+AVX2_FUNC void avx2_add_int(const int64_t* l, const int64_t* r, int64_t* res, const int64_t cnt)
+{
+  int64_t i = 0;
+  for (; i + 4 <= cnt; i += 4) {
+    const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(l + i));
+    const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(res + i), _mm256_add_epi64(a, b));
+  }
+  scalar_arith<AddIntOp>(l + i, r + i, res + i, cnt - i);
+}
+
+AVX2_FUNC void avx2_sub_int(const int64_t* l, const int64_t* r, int64_t* res, const int64_t cnt)
+{
+  int64_t i = 0;
+  for (; i + 4 <= cnt; i += 4) {
+    const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(l + i));
+    const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(res + i), _mm256_sub_epi64(a, b));
+  }
+  scalar_arith<SubIntOp>(l + i, r + i, res + i, cnt - i);
+}
+
+AVX2_FUNC void avx2_add_double(const double* l, const double* r, double* res, const int64_t cnt)
+{
+  int64_t i = 0;
+  for (; i + 4 <= cnt; i += 4) {
+    _mm256_storeu_pd(res + i, _mm256_add_pd(_mm256_loadu_pd(l + i), _mm256_loadu_pd(r + i)));
+  }
+  scalar_arith<AddDoubleOp>(l + i, r + i, res + i, cnt - i);
+}
+
+AVX2_FUNC void avx2_sub_double(const double* l, const double* r, double* res, const int64_t cnt)
+{
+  int64_t i = 0;
+  for (; i + 4 <= cnt; i += 4) {
+    _mm256_storeu_pd(res + i, _mm256_sub_pd(_mm256_loadu_pd(l + i), _mm256_loadu_pd(r + i)));
+  }
+  scalar_arith<SubDoubleOp>(l + i, r + i, res + i, cnt - i);
+}
+
+AVX2_FUNC void avx2_mul_double(const double* l, const double* r, double* res, const int64_t cnt)
+{
+  int64_t i = 0;
+  for (; i + 4 <= cnt; i += 4) {
+    _mm256_storeu_pd(res + i, _mm256_mul_pd(_mm256_loadu_pd(l + i), _mm256_loadu_pd(r + i)));
+  }
+  scalar_arith<MulDoubleOp>(l + i, r + i, res + i, cnt - i);
+}
+
+// Compare masks (all bits set for true) of 64 bit integers.
+template <ObCmpOp cmp_op>
+AVX2_FUNC OB_INLINE __m256i avx2_cmp_int_mask(const __m256i a, const __m256i b)
+{
+  const __m256i all_set = _mm256_set1_epi64x(-1);
+  __m256i mask = _mm256_setzero_si256();
+  switch (cmp_op) {
+    case CO_EQ:
+      mask = _mm256_cmpeq_epi64(a, b);
+      break;
+    case CO_NE:
+      mask = _mm256_xor_si256(_mm256_cmpeq_epi64(a, b), all_set);
+      break;
+    case CO_LT:
+      mask = _mm256_cmpgt_epi64(b, a);
+      break;
+    case CO_LE:
+      mask = _mm256_xor_si256(_mm256_cmpgt_epi64(a, b), all_set);
+      break;
+    case CO_GT:
+      mask = _mm256_cmpgt_epi64(a, b);
+      break;
+    case CO_GE:
+      mask = _mm256_xor_si256(_mm256_cmpgt_epi64(b, a), all_set);
+      break;
+    default:
+      break;
+  }
+  return mask;
+}
+
+template <ObCmpOp cmp_op>
+AVX2_FUNC void avx2_cmp_int(const int64_t* l, const int64_t* r, int64_t* res, const int64_t cnt)
+{
+  int64_t i = 0;
+  const __m256i zero = _mm256_setzero_si256();
+  for (; i + 4 <= cnt; i += 4) {
+    const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(l + i));
+    const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r + i));
+    // mask is -1 for true, negate to 1.
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(res + i), _mm256_sub_epi64(zero, avx2_cmp_int_mask<cmp_op>(a, b)));
+  }
+  scalar_cmp_kernel<cmp_op>(l, r, res, i, cnt);
+}
+
+// Ordered predicates for EQ/LT/LE and unordered for NE/GT/GE, to treat NaN
+// as greater than any other value, the same with scalar_cmp().
+template <ObCmpOp cmp_op>
+struct Avx2DoubleCmpPredicate {
+  const static int value_ = _CMP_FALSE_OQ;
+};
+template <>
+struct Avx2DoubleCmpPredicate<CO_EQ> {
+  const static int value_ = _CMP_EQ_OQ;
+};
+template <>
+struct Avx2DoubleCmpPredicate<CO_NE> {
+  const static int value_ = _CMP_NEQ_UQ;
+};
+template <>
+struct Avx2DoubleCmpPredicate<CO_LT> {
+  const static int value_ = _CMP_LT_OQ;
+};
+template <>
+struct Avx2DoubleCmpPredicate<CO_LE> {
+  const static int value_ = _CMP_LE_OQ;
+};
+template <>
+struct Avx2DoubleCmpPredicate<CO_GT> {
+  const static int value_ = _CMP_NLE_UQ;
+};
+template <>
+struct Avx2DoubleCmpPredicate<CO_GE> {
+  const static int value_ = _CMP_NLT_UQ;
+};
+
+template <ObCmpOp cmp_op>
+AVX2_FUNC void avx2_cmp_double(const double* l, const double* r, int64_t* res, const int64_t cnt)
+{
+  int64_t i = 0;
+  const __m256i zero = _mm256_setzero_si256();
+  for (; i + 4 <= cnt; i += 4) {
+    const __m256d mask =
+        _mm256_cmp_pd(_mm256_loadu_pd(l + i), _mm256_loadu_pd(r + i), Avx2DoubleCmpPredicate<cmp_op>::value_);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(res + i), _mm256_sub_epi64(zero, _mm256_castpd_si256(mask)));
+  }
+  scalar_cmp_kernel<cmp_op>(l, r, res, i, cnt);
+}
+
+#undef AVX2_FUNC
+
+#endif  // __x86_64__
+
+template <ObCmpOp cmp_op>
+void cmp_int_kernel(const int64_t* l, const int64_t* r, int64_t* res, const int64_t cnt)
+{
+#if defined(__x86_64__)
+  if (ObBatchKernel::avx2_supported()) {
+    avx2_cmp_int<cmp_op>(l, r, res, cnt);
+  } else {
+    scalar_cmp_kernel<cmp_op>(l, r, res, 0, cnt);
+  }
+#else
+  scalar_cmp_kernel<cmp_op>(l, r, res, 0, cnt);
+#endif
+}
+
+template <ObCmpOp cmp_op>
+void cmp_double_kernel(const double* l, const double* r, int64_t* res, const int64_t cnt)
+{
+#if defined(__x86_64__)
+  if (ObBatchKernel::avx2_supported()) {
+    avx2_cmp_double<cmp_op>(l, r, res, cnt);
+  } else {
+    scalar_cmp_kernel<cmp_op>(l, r, res, 0, cnt);
+  }
+#else
+  scalar_cmp_kernel<cmp_op>(l, r, res, 0, cnt);
+#endif
+}
+
+}  // end namespace
+
+bool ObBatchKernel::avx2_supported()
+{
+#if defined(__x86_64__)
+  static const bool supported = (__builtin_cpu_init(), __builtin_cpu_supports("avx2"));
+  return supported;
+#else
+  return false;
+#endif
+}
+
+#if defined(__x86_64__)
+#define DISPATCH_ARITH_KERNEL(avx2_func, scalar_op) \
+  if (avx2_supported()) {                           \
+    avx2_func(l, r, res, cnt);                      \
+  } else {                                          \
+    scalar_arith<scalar_op>(l, r, res, cnt);        \
+  }
+#else
+#define DISPATCH_ARITH_KERNEL(avx2_func, scalar_op) scalar_arith<scalar_op>(l, r, res, cnt);
+#endif
+
+void ObBatchKernel::add_int(const int64_t* l, const int64_t* r, int64_t* res, const int64_t cnt)
+{
+  DISPATCH_ARITH_KERNEL(avx2_add_int, AddIntOp);
+}
+
+void ObBatchKernel::sub_int(const int64_t* l, const int64_t* r, int64_t* res, const int64_t cnt)
+{
+  DISPATCH_ARITH_KERNEL(avx2_sub_int, SubIntOp);
+}
+
+void ObBatchKernel::mul_int(const int64_t* l, const int64_t* r, int64_t* res, const int64_t cnt)
+{
+  // AVX2 has no 64 bit integer multiply instruction, scalar loop is vectorized by compiler
+  // if possible.
+  scalar_arith<MulIntOp>(l, r, res, cnt);
+}
+
+void ObBatchKernel::add_double(const double* l, const double* r, double* res, const int64_t cnt)
+{
+  DISPATCH_ARITH_KERNEL(avx2_add_double, AddDoubleOp);
+}
+
+void ObBatchKernel::sub_double(const double* l, const double* r, double* res, const int64_t cnt)
+{
+  DISPATCH_ARITH_KERNEL(avx2_sub_double, SubDoubleOp);
+}
+
+void ObBatchKernel::mul_double(const double* l, const double* r, double* res, const int64_t cnt)
+{
+  DISPATCH_ARITH_KERNEL(avx2_mul_double, MulDoubleOp);
+}
+
+#undef DISPATCH_ARITH_KERNEL
+
+#define DISPATCH_CMP_KERNEL(kernel)       \
+  switch (cmp_op) {                       \
+    case CO_EQ:                           \
+      kernel<CO_EQ>(l, r, res, cnt);      \
+      break;                              \
+    case CO_NE:                           \
+      kernel<CO_NE>(l, r, res, cnt);      \
+      break;                              \
+    case CO_LT:                           \
+      kernel<CO_LT>(l, r, res, cnt);      \
+      break;                              \
+    case CO_LE:                           \
+      kernel<CO_LE>(l, r, res, cnt);      \
+      break;                              \
+    case CO_GT:                           \
+      kernel<CO_GT>(l, r, res, cnt);      \
+      break;                              \
+    case CO_GE:                           \
+      kernel<CO_GE>(l, r, res, cnt);      \
+      break;                              \
+    default:                              \
+      MEMSET(res, 0, cnt * sizeof(*res)); \
+      break;                              \
+  }
+
+void ObBatchKernel::cmp_int(const ObCmpOp cmp_op, const int64_t* l, const int64_t* r, int64_t* res, const int64_t cnt)
+{
+  DISPATCH_CMP_KERNEL(cmp_int_kernel);
+}
+
+void ObBatchKernel::cmp_double(const ObCmpOp cmp_op, const double* l, const double* r, int64_t* res, const int64_t cnt)
+{
+  DISPATCH_CMP_KERNEL(cmp_double_kernel);
+}
+
+#undef DISPATCH_CMP_KERNEL
+
+int ObBatchEvalUtil::eval_binary_args(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size,
+    const bool skip_right_if_left_null)
+{
+  int ret = OB_SUCCESS;
+  const ObExpr& left = *expr.args_[0];
+  const ObExpr& right = *expr.args_[1];
+  if (OB_FAIL(left.eval_batch(ctx, skip, size))) {
+    LOG_WARN("evaluate left failed", K(ret));
+  } else if (!skip_right_if_left_null) {
+    if (OB_FAIL(right.eval_batch(ctx, skip, size))) {
+      LOG_WARN("evaluate right failed", K(ret));
+    }
+  } else {
+    uint64_t right_skip_buf[MAX_SKIP_WORDS];
+    ObBitVector& right_skip = *to_bit_vector(right_skip_buf);
+    right_skip.deep_copy(skip, size);
+    const ObDatum* datums = left.locate_batch_datums(ctx);
+    const uint64_t mask = left.batch_idx_mask_;
+    for (int64_t i = 0; i < size; i++) {
+      if (!right_skip.at(i) && datums[i & mask].is_null()) {
+        right_skip.set(i);
+      }
+    }
+    if (right_skip.is_all_true(size)) {
+      // all left are null, no need to evaluate right
+    } else if (OB_FAIL(right.eval_batch(ctx, right_skip, size))) {
+      LOG_WARN("evaluate right failed", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObBatchEvalUtil::eval_row_of_batch(const ObExpr& expr, ObEvalCtx& ctx, const int64_t idx)
+{
+  int ret = OB_SUCCESS;
+  ObEvalCtx::BatchInfoScopeGuard batch_info_guard(ctx);
+  batch_info_guard.set_batch_idx(idx);
+  ObDatum& datum = expr.locate_datum_for_write(ctx);
+  if (OB_FAIL(expr.eval_func_(expr, ctx, datum))) {
+    LOG_WARN("evaluate row failed", K(ret), K(idx));
+    datum.set_null();
+  }
+  return ret;
+}
+
+int ObBatchEvalUtil::logic_eval_batch(
+    const bool is_and, const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size)
+{
+  int ret = OB_SUCCESS;
+  // Rows with result decided: false for AND, true for OR.
+  uint64_t decided_buf[MAX_SKIP_WORDS];
+  // Rows with null argument, the result is null if not decided.
+  uint64_t null_buf[MAX_SKIP_WORDS];
+  uint64_t arg_skip_buf[MAX_SKIP_WORDS];
+  ObBitVector& decided = *to_bit_vector(decided_buf);
+  ObBitVector& nulls = *to_bit_vector(null_buf);
+  ObBitVector& arg_skip = *to_bit_vector(arg_skip_buf);
+  decided.reset(size);
+  nulls.reset(size);
+  arg_skip.deep_copy(skip, size);
+  for (int64_t arg_idx = 0; OB_SUCC(ret) && arg_idx < expr.arg_cnt_; arg_idx++) {
+    const ObExpr& arg = *expr.args_[arg_idx];
+    if (arg_idx > 0) {
+      // short circuit: skip rows already decided
+      arg_skip.bit_or(decided, size);
+      if (arg_skip.is_all_true(size)) {
+        break;
+      }
+    }
+    if (OB_FAIL(arg.eval_batch(ctx, arg_skip, size))) {
+      LOG_WARN("evaluate argument failed", K(ret), K(arg_idx));
+    } else {
+      const ObDatum* datums = arg.locate_batch_datums(ctx);
+      const uint64_t mask = arg.batch_idx_mask_;
+      for (int64_t i = 0; i < size; i++) {
+        if (!arg_skip.at(i)) {
+          const ObDatum& datum = datums[i & mask];
+          if (datum.is_null()) {
+            nulls.set(i);
+          } else if (datum.get_bool() != is_and) {
+            decided.set(i);
+          }
+        }
+      }
+    }
+  }
+  if (OB_SUCC(ret)) {
+    ObDatum* datums = expr.locate_batch_datums(ctx);
+    for (int64_t i = 0; i < size; i++) {
+      if (!skip.at(i)) {
+        ObDatum& datum = datums[i];
+        datum.ptr_ = expr.get_batch_res_buf(ctx, i);
+        if (decided.at(i)) {
+          datum.set_bool(!is_and);
+        } else if (nulls.at(i)) {
+          datum.set_null();
+        } else {
+          datum.set_bool(is_and);
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+}  // end namespace sql
+}  // end namespace oceanbase
@@ -0,0 +1,276 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_EXPR_OB_BATCH_EVAL_UTIL_H_
+#define OCEANBASE_EXPR_OB_BATCH_EVAL_UTIL_H_
+
+#include "lib/number/ob_number_v2.h"
+#include "common/data_buffer.h"
+#include "common/object/ob_obj_compare.h"
+#include "sql/engine/expr/ob_expr.h"
+
+namespace oceanbase {
+namespace sql {
+
+// Vectorized kernels on contiguous value arrays, AVX2 instructions are used if supported
+// by CPU (detected at runtime), fallback to scalar loop otherwise.
+struct ObBatchKernel {
+  // integer add/sub/mul are wrapped around on overflow, overflow is checked by caller.
+  static void add_int(const int64_t* l, const int64_t* r, int64_t* res, const int64_t cnt);
+  static void sub_int(const int64_t* l, const int64_t* r, int64_t* res, const int64_t cnt);
+  static void mul_int(const int64_t* l, const int64_t* r, int64_t* res, const int64_t cnt);
+  static void add_double(const double* l, const double* r, double* res, const int64_t cnt);
+  static void sub_double(const double* l, const double* r, double* res, const int64_t cnt);
+  static void mul_double(const double* l, const double* r, double* res, const int64_t cnt);
+
+  // Compare result (1 for true, 0 for false) of %cmp_op, the same with
+  // ObDatumCmpHelperByTC::cmp() (NaN is greater than any other double value).
+  static void cmp_int(
+      const common::ObCmpOp cmp_op, const int64_t* l, const int64_t* r, int64_t* res, const int64_t cnt);
+  static void cmp_double(
+      const common::ObCmpOp cmp_op, const double* l, const double* r, int64_t* res, const int64_t cnt);
+
+  static bool avx2_supported();
+};
+
+class ObBatchEvalUtil {
+public:
+  // values are gathered and calculated in chunk to limit the stack memory used.
+  const static int64_t CHUNK_SIZE = 256;
+  const static int64_t MAX_SKIP_WORDS = ObExpr::MAX_EVAL_BATCH_SIZE / ObBitVector::WORD_BITS;
+
+  // Evaluate the two arguments of binary operator in batch, the right argument is not
+  // evaluated for rows with null left if %skip_right_if_left_null is true, to keep the
+  // same behaviour with row evaluation. e.g.: ObArithExprOperator::get_arith_operand()
+  static int eval_binary_args(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size,
+      const bool skip_right_if_left_null);
+
+  // Evaluate row %idx of batch by ObExpr::eval_func_, used to report the same error with
+  // row evaluation. (e.g.: integer overflow detected in batch evaluation)
+  static int eval_row_of_batch(const ObExpr& expr, ObEvalCtx& ctx, const int64_t idx);
+
+  // Arithmetic operation of integer or double type in batch:
+  //   1. evaluate arguments in batch
+  //   2. gather not null operands to contiguous arrays
+  //   3. calculate with vectorized kernel (ArithOp::kernel)
+  //   4. scatter results to result datums, rows failed in ArithOp::is_valid() are evaluated
+  //      again by row evaluate function to report error.
+  //
+  // ArithOp interface:
+  //   typedef xxx ValueType;
+  //   static ValueType get(const ObDatum&);
+  //   static void set(ObDatum&, const ValueType);
+  //   static void kernel(const ValueType* l, const ValueType* r, ValueType* res, const int64_t cnt);
+  //   static bool is_valid(const ObExpr&, const ValueType l, const ValueType r, const ValueType res);
+  template <typename ArithOp>
+  static int arith_eval_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size);
+
+  // Arithmetic operation of number type in batch, no vectorized kernel for number, but the
+  // arguments dispatching and evaluating are performed only once for the batch.
+  //
+  // NumberOp interface:
+  //   static int calc(const ObNumber& l, const ObNumber& r, ObNumber& res, ObIAllocator& alloc);
+  template <typename NumberOp>
+  static int number_eval_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size);
+
+  // Compare integer or double types in batch, NULL if any operand is NULL.
+  template <typename ValueType>
+  static int cmp_eval_batch(const common::ObCmpOp cmp_op, const ObExpr& expr, ObEvalCtx& ctx,
+      const ObBitVector& skip, const int64_t size);
+
+  // Evaluate N-ary AND/OR in batch, the result is calculated with bitmap word operations in
+  // three-valued logic. Arguments are short-circuit evaluated (not evaluated for rows
+  // already false for AND, already true for OR).
+  static int logic_eval_batch(
+      const bool is_and, const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size);
+
+private:
+  template <typename ValueType>
+  struct CmpKernel;
+
+  template <typename ArithOp>
+  static int arith_flush(const ObExpr& expr, ObEvalCtx& ctx, const typename ArithOp::ValueType* l,
+      const typename ArithOp::ValueType* r, typename ArithOp::ValueType* res, const uint16_t* idx, const int64_t cnt);
+};
+
+template <>
+struct ObBatchEvalUtil::CmpKernel<int64_t> {
+  static int64_t get(const common::ObDatum& d)
+  {
+    return d.get_int();
+  }
+  static void kernel(const common::ObCmpOp op, const int64_t* l, const int64_t* r, int64_t* res, const int64_t cnt)
+  {
+    ObBatchKernel::cmp_int(op, l, r, res, cnt);
+  }
+};
+
+template <>
+struct ObBatchEvalUtil::CmpKernel<double> {
+  static double get(const common::ObDatum& d)
+  {
+    return d.get_double();
+  }
+  static void kernel(const common::ObCmpOp op, const double* l, const double* r, int64_t* res, const int64_t cnt)
+  {
+    ObBatchKernel::cmp_double(op, l, r, res, cnt);
+  }
+};
+
+template <typename ArithOp>
+int ObBatchEvalUtil::arith_flush(const ObExpr& expr, ObEvalCtx& ctx, const typename ArithOp::ValueType* l,
+    const typename ArithOp::ValueType* r, typename ArithOp::ValueType* res, const uint16_t* idx, const int64_t cnt)
+{
+  int ret = common::OB_SUCCESS;
+  ArithOp::kernel(l, r, res, cnt);
+  common::ObDatum* datums = expr.locate_batch_datums(ctx);
+  for (int64_t i = 0; OB_SUCC(ret) && i < cnt; i++) {
+    if (OB_LIKELY(ArithOp::is_valid(expr, l[i], r[i], res[i]))) {
+      common::ObDatum& datum = datums[idx[i]];
+      datum.ptr_ = expr.get_batch_res_buf(ctx, idx[i]);
+      ArithOp::set(datum, res[i]);
+    } else if (OB_FAIL(eval_row_of_batch(expr, ctx, idx[i]))) {
+      SQL_LOG(WARN, "evaluate row failed", K(ret), K(idx[i]));
+    }
+  }
+  return ret;
+}
+
+template <typename ArithOp>
+int ObBatchEvalUtil::arith_eval_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size)
+{
+  int ret = common::OB_SUCCESS;
+  typedef typename ArithOp::ValueType ValueType;
+  if (OB_FAIL(eval_binary_args(expr, ctx, skip, size, lib::is_oracle_mode()))) {
+    SQL_LOG(WARN, "evaluate arguments failed", K(ret));
+  } else {
+    ValueType l[CHUNK_SIZE];
+    ValueType r[CHUNK_SIZE];
+    ValueType res[CHUNK_SIZE];
+    uint16_t idx[CHUNK_SIZE];
+    int64_t cnt = 0;
+    const common::ObDatum* l_datums = expr.args_[0]->locate_batch_datums(ctx);
+    const common::ObDatum* r_datums = expr.args_[1]->locate_batch_datums(ctx);
+    const uint64_t l_mask = expr.args_[0]->batch_idx_mask_;
+    const uint64_t r_mask = expr.args_[1]->batch_idx_mask_;
+    common::ObDatum* datums = expr.locate_batch_datums(ctx);
+    for (int64_t i = 0; OB_SUCC(ret) && i < size; i++) {
+      if (!skip.at(i)) {
+        const common::ObDatum& left = l_datums[i & l_mask];
+        if (left.is_null() || r_datums[i & r_mask].is_null()) {
+          datums[i].set_null();
+        } else {
+          l[cnt] = ArithOp::get(left);
+          r[cnt] = ArithOp::get(r_datums[i & r_mask]);
+          idx[cnt] = static_cast<uint16_t>(i);
+          cnt += 1;
+          if (CHUNK_SIZE == cnt) {
+            ret = arith_flush<ArithOp>(expr, ctx, l, r, res, idx, cnt);
+            cnt = 0;
+          }
+        }
+      }
+    }
+    if (OB_SUCC(ret) && cnt > 0) {
+      ret = arith_flush<ArithOp>(expr, ctx, l, r, res, idx, cnt);
+    }
+  }
+  return ret;
+}
+
+template <typename NumberOp>
+int ObBatchEvalUtil::number_eval_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size)
+{
+  int ret = common::OB_SUCCESS;
+  if (OB_FAIL(eval_binary_args(expr, ctx, skip, size, lib::is_oracle_mode()))) {
+    SQL_LOG(WARN, "evaluate arguments failed", K(ret));
+  } else {
+    const common::ObDatum* l_datums = expr.args_[0]->locate_batch_datums(ctx);
+    const common::ObDatum* r_datums = expr.args_[1]->locate_batch_datums(ctx);
+    const uint64_t l_mask = expr.args_[0]->batch_idx_mask_;
+    const uint64_t r_mask = expr.args_[1]->batch_idx_mask_;
+    common::ObDatum* datums = expr.locate_batch_datums(ctx);
+    char local_buff[common::number::ObNumber::MAX_BYTE_LEN];
+    common::ObDataBuffer local_alloc(local_buff, common::number::ObNumber::MAX_BYTE_LEN);
+    for (int64_t i = 0; OB_SUCC(ret) && i < size; i++) {
+      if (!skip.at(i)) {
+        const common::ObDatum& left = l_datums[i & l_mask];
+        const common::ObDatum& right = r_datums[i & r_mask];
+        if (left.is_null() || right.is_null()) {
+          datums[i].set_null();
+        } else {
+          common::number::ObNumber l_nmb(left.get_number());
+          common::number::ObNumber r_nmb(right.get_number());
+          common::number::ObNumber res_nmb;
+          local_alloc.free();
+          if (OB_FAIL(NumberOp::calc(l_nmb, r_nmb, res_nmb, local_alloc))) {
+            SQL_LOG(WARN, "calculate number failed", K(ret), K(left), K(right));
+          } else {
+            datums[i].ptr_ = expr.get_batch_res_buf(ctx, i);
+            datums[i].set_number(res_nmb);
+          }
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+template <typename ValueType>
+int ObBatchEvalUtil::cmp_eval_batch(const common::ObCmpOp cmp_op, const ObExpr& expr, ObEvalCtx& ctx,
+    const ObBitVector& skip, const int64_t size)
+{
+  int ret = common::OB_SUCCESS;
+  // same with ObRelationalExprOperator::get_comparator_operands()
+  if (OB_FAIL(eval_binary_args(expr, ctx, skip, size, true))) {
+    SQL_LOG(WARN, "evaluate arguments failed", K(ret));
+  } else {
+    ValueType l[CHUNK_SIZE];
+    ValueType r[CHUNK_SIZE];
+    int64_t res[CHUNK_SIZE];
+    uint16_t idx[CHUNK_SIZE];
+    int64_t cnt = 0;
+    const common::ObDatum* l_datums = expr.args_[0]->locate_batch_datums(ctx);
+    const common::ObDatum* r_datums = expr.args_[1]->locate_batch_datums(ctx);
+    const uint64_t l_mask = expr.args_[0]->batch_idx_mask_;
+    const uint64_t r_mask = expr.args_[1]->batch_idx_mask_;
+    common::ObDatum* datums = expr.locate_batch_datums(ctx);
+    for (int64_t i = 0; i < size; i++) {
+      if (!skip.at(i)) {
+        const common::ObDatum& left = l_datums[i & l_mask];
+        if (left.is_null() || r_datums[i & r_mask].is_null()) {
+          datums[i].set_null();
+        } else {
+          l[cnt] = CmpKernel<ValueType>::get(left);
+          r[cnt] = CmpKernel<ValueType>::get(r_datums[i & r_mask]);
+          idx[cnt] = static_cast<uint16_t>(i);
+          cnt += 1;
+        }
+      }
+      if (cnt > 0 && (CHUNK_SIZE == cnt || size - 1 == i)) {
+        CmpKernel<ValueType>::kernel(cmp_op, l, r, res, cnt);
+        for (int64_t j = 0; j < cnt; j++) {
+          common::ObDatum& datum = datums[idx[j]];
+          datum.ptr_ = expr.get_batch_res_buf(ctx, idx[j]);
+          datum.set_int(res[j]);
+        }
+        cnt = 0;
+      }
+    }
+  }
+  return ret;
+}
+
+}  // end namespace sql
+}  // end namespace oceanbase
+
+#endif  // OCEANBASE_EXPR_OB_BATCH_EVAL_UTIL_H_
@@ -31,7 +31,12 @@ STATIC_ASSERT(sizeof(ObPrecision) == sizeof(ObLengthSemantics), "size of ObPreci
 OB_SERIALIZE_MEMBER(ObDatumMeta, type_, cs_type_, scale_, precision_);
 
 ObEvalCtx::ObEvalCtx(ObExecContext& exec_ctx, ObArenaAllocator& res_alloc, ObArenaAllocator& tmp_alloc)
-    : frames_(exec_ctx.get_frames()), exec_ctx_(exec_ctx), expr_res_alloc_(res_alloc), tmp_alloc_(tmp_alloc)
+    : frames_(exec_ctx.get_frames()),
+      batch_idx_(0),
+      max_batch_size_(exec_ctx.get_max_batch_size()),
+      exec_ctx_(exec_ctx),
+      expr_res_alloc_(res_alloc),
+      tmp_alloc_(tmp_alloc)
 
 {}
 
@@ -39,7 +44,7 @@ DEF_TO_STRING(ObEvalInfo)
 {
   int64_t pos = 0;
   J_OBJ_START();
-  J_KV(K_(evaluated), K_(projected), K_(notnull), K_(point_to_frame), K_(cnt));
+  J_KV(K_(evaluated), K_(projected), K_(notnull), K_(point_to_frame), K_(eval_flags_valid), K_(cnt));
   J_OBJ_END();
   return pos;
 }
@@ -76,6 +81,7 @@ OB_DEF_SERIALIZE(ObExpr)
   }
 
   LST_DO_CODE(OB_UNIS_ENCODE, eval_info_off_);
+  LST_DO_CODE(OB_UNIS_ENCODE, batch_result_, eval_flags_off_, res_buf_stride_, ser_eval_batch_func_);
 
   return ret;
 }
@@ -117,6 +123,8 @@ OB_DEF_DESERIALIZE(ObExpr)
     // compatible with 3.0, ObExprDatum::flag_ is ObEvalInfo
     eval_info_off_ = datum_off_ + sizeof(ObDatum);
   }
+  LST_DO_CODE(OB_UNIS_DECODE, batch_result_, eval_flags_off_, res_buf_stride_, ser_eval_batch_func_);
+  batch_idx_mask_ = batch_result_ ? UINT64_MAX : 0;
 
   if (OB_SUCC(ret)) {
     basic_funcs_ = ObDatumFuncs::get_basic_func(datum_meta_.type_, datum_meta_.cs_type_);
@@ -154,6 +162,7 @@ OB_DEF_SERIALIZE_SIZE(ObExpr)
   }
 
   LST_DO_CODE(OB_UNIS_ADD_LEN, eval_info_off_);
+  LST_DO_CODE(OB_UNIS_ADD_LEN, batch_result_, eval_flags_off_, res_buf_stride_, ser_eval_batch_func_);
 
   return len;
 }
@@ -166,6 +175,7 @@ ObExpr::ObExpr()
       max_length_(UINT32_MAX),
       obj_datum_map_(OBJ_DATUM_NULL),
       eval_func_(NULL),
+      eval_batch_func_(NULL),
       inner_functions_(NULL),
       inner_func_cnt_(0),
       args_(NULL),
@@ -179,7 +189,11 @@ ObExpr::ObExpr()
       res_buf_len_(0),
       expr_ctx_id_(INVALID_EXP_CTX_ID),
       extra_(0),
-      basic_funcs_(NULL)
+      basic_funcs_(NULL),
+      batch_result_(false),
+      batch_idx_mask_(0),
+      eval_flags_off_(0),
+      res_buf_stride_(0)
 {}
 
 char* ObExpr::alloc_str_res_mem(ObEvalCtx& ctx, const int64_t size) const
@@ -189,8 +203,7 @@ char* ObExpr::alloc_str_res_mem(ObEvalCtx& ctx, const int64_t size) const
   if (OB_UNLIKELY(!ObDynReserveBuf::supported(datum_meta_.type_))) {
     LOG_ERROR("unexpected alloc string result memory called", K(size), K(*this));
   } else {
-    ObDynReserveBuf* drb =
-        reinterpret_cast<ObDynReserveBuf*>(ctx.frames_[frame_idx_] + res_buf_off_ - sizeof(ObDynReserveBuf));
+    ObDynReserveBuf* drb = reinterpret_cast<ObDynReserveBuf*>(get_res_buf(ctx) - sizeof(ObDynReserveBuf));
     if (OB_LIKELY(drb->len_ >= size)) {
       mem = drb->mem_;
     } else {
@@ -223,13 +236,23 @@ int ObExpr::eval_enumset(ObEvalCtx& ctx, const common::ObIArray<common::ObString
   int ret = common::OB_SUCCESS;
   char* frame = ctx.frames_[frame_idx_];
   OB_ASSERT(NULL != frame);
-  datum = (ObDatum*)(frame + datum_off_);
+  datum = &locate_expr_datum(ctx);
   ObEvalInfo* eval_info = (ObEvalInfo*)(frame + eval_info_off_);
+  bool evaluated = eval_info->evaluated_;
+  if (!evaluated && batch_result_) {
+    ObBitVector& eval_flags = get_evaluated_flags(ctx);
+    if (!eval_info->eval_flags_valid_) {
+      eval_flags.reset(ctx.max_batch_size_);
+      eval_info->eval_flags_valid_ = true;
+    }
+    evaluated = eval_flags.at(ctx.batch_idx_);
+  }
 
   // do nothing for const/column reference expr or already evaluated expr
-  if (!eval_info->evaluated_) {
-    if (datum->ptr_ != frame + res_buf_off_) {
-      datum->ptr_ = frame + res_buf_off_;
+  if (!evaluated) {
+    char* res_buf = get_res_buf(ctx);
+    if (datum->ptr_ != res_buf) {
+      datum->ptr_ = res_buf;
     }
     const common::ObObjTypeClass in_tc = args_[0]->obj_meta_.get_type_class();
     EvalEnumSetFunc eval_func;
@@ -239,10 +262,75 @@ int ObExpr::eval_enumset(ObEvalCtx& ctx, const common::ObIArray<common::ObString
       ret = eval_func(*this, str_values, cast_mode, ctx, *datum);
     }
 
-    if (OB_LIKELY(common::OB_SUCCESS == ret)) {
+    if (OB_UNLIKELY(common::OB_SUCCESS != ret)) {
+      datum->set_null();
+    } else if (batch_result_) {
+      get_evaluated_flags(ctx).set(ctx.batch_idx_);
+    } else {
       eval_info->evaluated_ = true;
+    }
+  }
+  return ret;
+}
+
+int ObExpr::eval_one_datum_of_batch(ObEvalCtx& ctx, common::ObDatum& datum) const
+{
+  int ret = common::OB_SUCCESS;
+  char* frame = ctx.frames_[frame_idx_];
+  ObEvalInfo* eval_info = (ObEvalInfo*)(frame + eval_info_off_);
+  ObBitVector& eval_flags = get_evaluated_flags(ctx);
+  if (!eval_info->eval_flags_valid_) {
+    eval_flags.reset(ctx.max_batch_size_);
+    eval_info->eval_flags_valid_ = true;
+  }
+  if (!eval_flags.at(ctx.batch_idx_)) {
+    char* res_buf = frame + res_buf_off_ + ctx.batch_idx_ * res_buf_stride_;
+    if (datum.ptr_ != res_buf) {
+      datum.ptr_ = res_buf;
+    }
+    ret = eval_func_(*this, ctx, datum);
+    if (OB_LIKELY(common::OB_SUCCESS == ret)) {
+      eval_flags.set(ctx.batch_idx_);
     } else {
-      datum->set_null();
+      datum.set_null();
+    }
+  }
+  return ret;
+}
+
+int ObExpr::eval_batch(ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size) const
+{
+  int ret = common::OB_SUCCESS;
+  if (!batch_result_) {
+    // const, param or non batch evaluate expression, evaluate once.
+    common::ObDatum* datum = NULL;
+    if (OB_FAIL(eval(ctx, datum))) {
+      LOG_WARN("evaluate expression failed", K(ret));
+    }
+  } else if (NULL == eval_func_ || get_eval_info(ctx).evaluated_) {
+    // column reference or all rows are projected
+  } else if (NULL != eval_batch_func_ && !get_eval_info(ctx).eval_flags_valid_ && size <= MAX_EVAL_BATCH_SIZE) {
+    // Batch evaluate function evaluates all rows not skipped, only used when no row evaluated,
+    // rows evaluated before are no need to evaluate again otherwise.
+    ObEvalInfo& eval_info = get_eval_info(ctx);
+    if (OB_FAIL(eval_batch_func_(*this, ctx, skip, size))) {
+      LOG_WARN("evaluate batch failed", K(ret), K(size));
+    } else {
+      ObBitVector& eval_flags = get_evaluated_flags(ctx);
+      eval_flags.reset(ctx.max_batch_size_);
+      eval_flags.bit_not(skip, size);
+      eval_info.eval_flags_valid_ = true;
+    }
+  } else {
+    ObEvalCtx::BatchInfoScopeGuard batch_info_guard(ctx);
+    common::ObDatum* datum = NULL;
+    for (int64_t i = 0; OB_SUCC(ret) && i < size; i++) {
+      if (!skip.at(i)) {
+        batch_info_guard.set_batch_idx(i);
+        if (OB_FAIL(eval(ctx, datum))) {
+          LOG_WARN("evaluate expression failed", K(ret), K(i));
+        }
+      }
     }
   }
   return ret;
@@ -17,6 +17,7 @@
 #include "lib/allocator/ob_allocator.h"
 #include "share/datum/ob_datum.h"
 #include "sql/engine/ob_serializable_function.h"
+#include "sql/engine/ob_bit_vector.h"
 #include "sql/parser/ob_item_type.h"
 
 namespace oceanbase {
@@ -80,8 +81,9 @@ public:
 struct ObEvalInfo {
   void clear_evaluated_flag()
   {
-    if (evaluated_) {
+    if (evaluated_ || eval_flags_valid_) {
       evaluated_ = false;
+      eval_flags_valid_ = false;
     }
   }
   DECLARE_TO_STRING;
@@ -98,6 +100,9 @@ struct ObEvalInfo {
       uint16_t notnull_ : 1;
       // pointer is point to reserved buffer in frame.
       uint16_t point_to_frame_ : 1;
+      // per row evaluated flags of batch result are valid,
+      // (flags are reset when first row of batch evaluated)
+      uint16_t eval_flags_valid_ : 1;
     };
     uint16_t flag_;
   };
@@ -110,6 +115,38 @@ struct ObEvalCtx {
   friend class ObExpr;
   ObEvalCtx(ObExecContext& exec_ctx, common::ObArenaAllocator& res_alloc, common::ObArenaAllocator& tmp_alloc);
 
+  int64_t get_batch_idx() const
+  {
+    return batch_idx_;
+  }
+  void set_batch_idx(const int64_t batch_idx)
+  {
+    batch_idx_ = batch_idx;
+  }
+  int64_t get_max_batch_size() const
+  {
+    return max_batch_size_;
+  }
+
+  // Save batch index and restore it when guard destruct.
+  class BatchInfoScopeGuard {
+  public:
+    explicit BatchInfoScopeGuard(ObEvalCtx& eval_ctx) : eval_ctx_(eval_ctx), batch_idx_(eval_ctx.batch_idx_)
+    {}
+    ~BatchInfoScopeGuard()
+    {
+      eval_ctx_.batch_idx_ = batch_idx_;
+    }
+    void set_batch_idx(const int64_t batch_idx)
+    {
+      eval_ctx_.batch_idx_ = batch_idx;
+    }
+
+  private:
+    ObEvalCtx& eval_ctx_;
+    int64_t batch_idx_;
+  };
+
   common::ObArenaAllocator& get_reset_tmp_alloc()
   {
 #ifndef NDEBUG
@@ -131,6 +168,10 @@ private:
 
 public:
   char** frames_;
+  // current row index of batch, used to locate datum of batch result expression.
+  int64_t batch_idx_;
+  // max batch size of batch result expression (0 for non vectorized plan).
+  int64_t max_batch_size_;
   ObExecContext& exec_ctx_;
 
 private:
@@ -196,7 +237,36 @@ public:
   ObDatum& locate_expr_datum(ObEvalCtx& ctx) const
   {
     // performance critical, do not check pointer validity.
-    return *reinterpret_cast<ObDatum*>(ctx.frames_[frame_idx_] + datum_off_);
+    return reinterpret_cast<ObDatum*>(ctx.frames_[frame_idx_] + datum_off_)[get_datum_idx(ctx)];
+  }
+
+  // datums of all rows in batch, only one datum for non batch result expression.
+  ObDatum* locate_batch_datums(ObEvalCtx& ctx) const
+  {
+    return reinterpret_cast<ObDatum*>(ctx.frames_[frame_idx_] + datum_off_);
+  }
+
+  // per row evaluated flags of batch result expression
+  ObBitVector& get_evaluated_flags(ObEvalCtx& ctx) const
+  {
+    return *to_bit_vector(ctx.frames_[frame_idx_] + eval_flags_off_);
+  }
+
+  OB_INLINE int64_t get_datum_idx(const ObEvalCtx& ctx) const
+  {
+    return ctx.batch_idx_ & batch_idx_mask_;
+  }
+
+  // reserved buffer of current row
+  OB_INLINE char* get_res_buf(ObEvalCtx& ctx) const
+  {
+    return ctx.frames_[frame_idx_] + res_buf_off_ + get_datum_idx(ctx) * res_buf_stride_;
+  }
+
+  // reserved buffer of the %idx row of batch result
+  OB_INLINE char* get_batch_res_buf(ObEvalCtx& ctx, const int64_t idx) const
+  {
+    return ctx.frames_[frame_idx_] + res_buf_off_ + (idx & batch_idx_mask_) * res_buf_stride_;
   }
 
   ObEvalInfo& get_eval_info(ObEvalCtx& ctx) const
@@ -215,9 +285,13 @@ public:
   // Dynamic allocated memory is allocated if reserved buffer if not enough.
   char* get_str_res_mem(ObEvalCtx& ctx, const int64_t size) const
   {
-    return OB_LIKELY(size <= res_buf_len_) ? ctx.frames_[frame_idx_] + res_buf_off_ : alloc_str_res_mem(ctx, size);
+    return OB_LIKELY(size <= res_buf_len_) ? get_res_buf(ctx) : alloc_str_res_mem(ctx, size);
   }
 
+  // Evaluate the rows not skipped of batch, the results are located by locate_batch_datums().
+  // eval_batch_func_ is used if available, row by row evaluation is performed otherwise.
+  int eval_batch(ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size) const;
+
   // Evaluate all parameters, assign the first sizeof...(args) parameters to %args.
   //
   // e.g.:
@@ -246,18 +320,26 @@ public:
   }
 
   TO_STRING_KV("type", get_type_name(type_), K_(datum_meta), K_(obj_meta), K_(obj_datum_map), KP_(eval_func),
-      KP_(inner_functions), K_(inner_func_cnt), K_(arg_cnt), K_(parent_cnt), K_(frame_idx), K_(datum_off),
-      K_(res_buf_off), K_(res_buf_len), K_(expr_ctx_id), K_(extra), KP(this));
+      KP_(eval_batch_func), KP_(inner_functions), K_(inner_func_cnt), K_(arg_cnt), K_(parent_cnt), K_(frame_idx),
+      K_(datum_off), K_(res_buf_off), K_(res_buf_len), K_(expr_ctx_id), K_(extra), K_(batch_result),
+      K_(eval_flags_off), K_(res_buf_stride), KP(this));
 
 private:
   char* alloc_str_res_mem(ObEvalCtx& ctx, const int64_t size) const;
+  int eval_one_datum_of_batch(ObEvalCtx& ctx, common::ObDatum& datum) const;
 
 public:
   typedef int (*EvalFunc)(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& expr_datum);
+  // Evaluate the rows not skipped of batch (size less than MAX_EVAL_BATCH_SIZE), set result
+  // to datums located by locate_batch_datums().
+  typedef int (*EvalBatchFunc)(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size);
   typedef int (*EvalEnumSetFunc)(const ObExpr& expr, const common::ObIArray<common::ObString>& str_values,
       const uint64_t cast_mode, ObEvalCtx& ctx, ObDatum& expr_datum);
 
   const static uint64_t MAGIC_NUM = 0x6367614D72707845L;  // string of "ExprMagc"
+  // max batch size supported by eval_batch_func_ (same with the upper bound of _rowsets_max_rows),
+  // batch evaluate function can use stack memory for temporary bitmaps.
+  const static int64_t MAX_EVAL_BATCH_SIZE = 1024;
   uint64_t magic_;
   ObExprOperatorType type_;
   // meta data of datum
@@ -275,6 +357,12 @@ public:
     // helper union member for eval_func_ serialize && deserialize
     sql::serializable_function ser_eval_func_;
   };
+  // batch evaluate function, NULL if not supported.
+  union {
+    EvalBatchFunc eval_batch_func_;
+    // helper union member for eval_batch_func_ serialize && deserialize
+    sql::serializable_function ser_eval_batch_func_;
+  };
   // aux evaluate functions for eval_func_, array of any function pointers, which interpreted
   // by eval_func_.
   // mysql row operand use the inner function array
@@ -311,6 +399,16 @@ public:
     ObIExprExtraInfo* extra_info_;
   };
   ObExprBasicFuncs* basic_funcs_;
+  // Batch result expression: datums and reserved buffers are arranged for
+  // ObEvalCtx::max_batch_size_ rows, row is located by ObEvalCtx::batch_idx_.
+  bool batch_result_;
+  // mask of ObEvalCtx::batch_idx_, UINT64_MAX for batch result expression, 0 otherwise.
+  // (derived from batch_result_, not serialized)
+  uint64_t batch_idx_mask_;
+  // offset of per row evaluated flags (ObBitVector) of batch result
+  uint32_t eval_flags_off_;
+  // distance of reserved buffers of adjacent rows (including ObDynReserveBuf) of batch result
+  uint32_t res_buf_stride_;
 };
 
 // helper template to access ObExpr::extra_
@@ -567,9 +665,11 @@ OB_INLINE ObDatum& ObExpr::locate_datum_for_write(ObEvalCtx& ctx) const
   // performance critical, do not check pointer validity.
   char* frame = ctx.frames_[frame_idx_];
   OB_ASSERT(NULL != frame);
-  ObDatum* expr_datum = (ObDatum*)(frame + datum_off_);
-  if (expr_datum->ptr_ != frame + res_buf_off_) {
-    expr_datum->ptr_ = frame + res_buf_off_;
+  const int64_t idx = get_datum_idx(ctx);
+  ObDatum* expr_datum = (ObDatum*)(frame + datum_off_) + idx;
+  char* res_buf = frame + res_buf_off_ + idx * res_buf_stride_;
+  if (expr_datum->ptr_ != res_buf) {
+    expr_datum->ptr_ = res_buf;
   }
   return *expr_datum;
 }
@@ -598,7 +698,14 @@ OB_INLINE int ObExpr::eval(ObEvalCtx& ctx, common::ObDatum*& datum) const
   ObEvalInfo* eval_info = (ObEvalInfo*)(frame + eval_info_off_);
 
   // do nothing for const/column reference expr or already evaluated expr
-  if (NULL != eval_func_ && !eval_info->evaluated_) {
+  if (OB_UNLIKELY(batch_result_)) {
+    // evaluated_ of batch result is set when all rows of batch are projected (or evaluated),
+    // per row evaluated flags are checked otherwise.
+    datum += ctx.batch_idx_;
+    if (NULL != eval_func_ && !eval_info->evaluated_) {
+      ret = eval_one_datum_of_batch(ctx, *datum);
+    }
+  } else if (NULL != eval_func_ && !eval_info->evaluated_) {
     if (datum->ptr_ != frame + res_buf_off_) {
       datum->ptr_ = frame + res_buf_off_;
     }
@@ -18,6 +18,7 @@
 #include "sql/resolver/expr/ob_raw_expr.h"
 #include "sql/engine/ob_exec_context.h"
 #include "sql/code_generator/ob_static_engine_expr_cg.h"
+#include "sql/engine/expr/ob_batch_eval_util.h"
 namespace oceanbase {
 using namespace common;
 using namespace common::number;
@@ -405,6 +406,7 @@ int ObExprAdd::cg_expr(ObExprCGCtx& op_cg_ctx, const ObRawExpr& raw_expr, ObExpr
     LOG_WARN("child is null", K(ret), K(rt_expr.args_[0]), K(rt_expr.args_[1]));
   } else {
     rt_expr.eval_func_ = NULL;
+    rt_expr.eval_batch_func_ = NULL;
     const ObObjType left_type = rt_expr.args_[0]->datum_meta_.type_;
     const ObObjType right_type = rt_expr.args_[1]->datum_meta_.type_;
     const ObObjType result_type = rt_expr.datum_meta_.type_;
@@ -413,6 +415,7 @@ int ObExprAdd::cg_expr(ObExprCGCtx& op_cg_ctx, const ObRawExpr& raw_expr, ObExpr
     switch (result_type) {
       case ObIntType:
         rt_expr.eval_func_ = ObExprAdd::add_int_int;
+        rt_expr.eval_batch_func_ = ObExprAdd::add_int_int_batch;
         break;
       case ObUInt64Type:
         if (ObIntTC == left_tc && ObUIntTC == right_tc) {
@@ -523,10 +526,12 @@ int ObExprAdd::cg_expr(ObExprCGCtx& op_cg_ctx, const ObRawExpr& raw_expr, ObExpr
         break;
       case ObDoubleType:
         rt_expr.eval_func_ = ObExprAdd::add_double_double;
+        rt_expr.eval_batch_func_ = ObExprAdd::add_double_double_batch;
         break;
       case ObUNumberType:
       case ObNumberType:
         rt_expr.eval_func_ = ObExprAdd::add_number_number;
+        rt_expr.eval_batch_func_ = ObExprAdd::add_number_number_batch;
         break;
       default:
         break;
@@ -712,6 +717,68 @@ int ObExprAdd::add_number_number(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& ex
   return ret;
 }
 
+struct ObAddIntIntBatchOp {
+  typedef int64_t ValueType;
+  static int64_t get(const ObDatum& datum)
+  {
+    return datum.get_int();
+  }
+  static void set(ObDatum& datum, const int64_t v)
+  {
+    datum.set_int(v);
+  }
+  static void kernel(const int64_t* l, const int64_t* r, int64_t* res, const int64_t cnt)
+  {
+    ObBatchKernel::add_int(l, r, res, cnt);
+  }
+  static bool is_valid(const ObExpr&, const int64_t l, const int64_t r, const int64_t res)
+  {
+    return !ObExprAdd::is_int_int_out_of_range(l, r, res);
+  }
+};
+
+struct ObAddDoubleBatchOp {
+  typedef double ValueType;
+  static double get(const ObDatum& datum)
+  {
+    return datum.get_double();
+  }
+  static void set(ObDatum& datum, const double v)
+  {
+    datum.set_double(v);
+  }
+  static void kernel(const double* l, const double* r, double* res, const int64_t cnt)
+  {
+    ObBatchKernel::add_double(l, r, res, cnt);
+  }
+  static bool is_valid(const ObExpr& expr, const double, const double, const double res)
+  {
+    return !ObArithExprOperator::is_double_out_of_range(res) || T_OP_AGG_ADD == expr.type_;
+  }
+};
+
+struct ObAddNumberBatchOp {
+  static int calc(const ObNumber& l, const ObNumber& r, ObNumber& res, ObIAllocator& alloc)
+  {
+    return l.add_v3(r, res, alloc);
+  }
+};
+
+int ObExprAdd::add_int_int_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size)
+{
+  return ObBatchEvalUtil::arith_eval_batch<ObAddIntIntBatchOp>(expr, ctx, skip, size);
+}
+
+int ObExprAdd::add_double_double_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size)
+{
+  return ObBatchEvalUtil::arith_eval_batch<ObAddDoubleBatchOp>(expr, ctx, skip, size);
+}
+
+int ObExprAdd::add_number_number_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size)
+{
+  return ObBatchEvalUtil::number_eval_batch<ObAddNumberBatchOp>(expr, ctx, skip, size);
+}
+
 // 1.interval can calc with different types such as date, timestamp, interval.
 // the params do not need to do cast
 // 2.left and right must have the same type. both IntervalYM or both IntervalDS
@@ -111,6 +111,9 @@ public:
   static int add_float_float(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& expr_datum);
   static int add_double_double(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& expr_datum);
   static int add_number_number(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& expr_datum);
+  static int add_int_int_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size);
+  static int add_double_double_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size);
+  static int add_number_number_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size);
 
   static int add_intervalym_intervalym(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& expr_datum);
   static int add_intervalym_datetime_common(
@@ -17,6 +17,7 @@
 #include "share/datum/ob_datum_cmp_func_def.h"
 #include "share/datum/ob_datum_funcs.h"
 #include "sql/engine/expr/ob_expr_operator.h"
+#include "sql/engine/expr/ob_batch_eval_util.h"
 
 namespace oceanbase {
 namespace sql {
@@ -119,6 +120,38 @@ struct ObRelationalStrExprEvalFunc : public ObDatumStrCmpCore<cs_type, calc_with
   }
 };
 
+template <typename ValueType, ObCmpOp cmp_op>
+struct ObRelationalExprEvalBatchFunc {
+  static int eval_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size)
+  {
+    return ObBatchEvalUtil::cmp_eval_batch<ValueType>(cmp_op, expr, ctx, skip, size);
+  }
+};
+
+// batch compare functions of [ObIntTC, ObDoubleTC][cmp_op]
+static ObExpr::EvalBatchFunc EVAL_BATCH_CMP_FUNCS[2][CO_MAX] = {
+    {
+        ObRelationalExprEvalBatchFunc<int64_t, CO_EQ>::eval_batch,
+        ObRelationalExprEvalBatchFunc<int64_t, CO_LE>::eval_batch,
+        ObRelationalExprEvalBatchFunc<int64_t, CO_LT>::eval_batch,
+        ObRelationalExprEvalBatchFunc<int64_t, CO_GE>::eval_batch,
+        ObRelationalExprEvalBatchFunc<int64_t, CO_GT>::eval_batch,
+        ObRelationalExprEvalBatchFunc<int64_t, CO_NE>::eval_batch,
+        NULL, /* CO_CMP */
+    },
+    {
+        ObRelationalExprEvalBatchFunc<double, CO_EQ>::eval_batch,
+        ObRelationalExprEvalBatchFunc<double, CO_LE>::eval_batch,
+        ObRelationalExprEvalBatchFunc<double, CO_LT>::eval_batch,
+        ObRelationalExprEvalBatchFunc<double, CO_GE>::eval_batch,
+        ObRelationalExprEvalBatchFunc<double, CO_GT>::eval_batch,
+        ObRelationalExprEvalBatchFunc<double, CO_NE>::eval_batch,
+        NULL, /* CO_CMP */
+    },
+};
+static_assert(0 == CO_EQ && 1 == CO_LE && 2 == CO_LT && 3 == CO_GE && 4 == CO_GT && 5 == CO_NE && 7 == CO_MAX,
+    "unexpected compare operator");
+
 static ObExpr::EvalFunc EVAL_CMP_FUNCS[ObMaxType][ObMaxType][CO_MAX];
 static ObDatumCmpFuncType DATUM_CMP_FUNCS[ObMaxType][ObMaxType];
 static ObExpr::EvalFunc EVAL_STR_CMP_FUNCS[CS_TYPE_MAX][CO_MAX][2];
@@ -195,6 +228,22 @@ ObExpr::EvalFunc ObExprCmpFuncsHelper::get_eval_expr_cmp_func(const ObObjType ty
   return func_ptr;
 }
 
+ObExpr::EvalBatchFunc ObExprCmpFuncsHelper::get_eval_batch_expr_cmp_func(
+    const ObObjType type1, const ObObjType type2, const ObCmpOp cmp_op)
+{
+  ObExpr::EvalBatchFunc func_ptr = NULL;
+  const ObObjTypeClass tc1 = ob_obj_type_class(type1);
+  const ObObjTypeClass tc2 = ob_obj_type_class(type2);
+  if (OB_UNLIKELY(ob_is_invalid_cmp_op(cmp_op)) || tc1 != tc2) {
+    func_ptr = NULL;
+  } else if (ObIntTC == tc1) {
+    func_ptr = EVAL_BATCH_CMP_FUNCS[0][cmp_op];
+  } else if (ObDoubleTC == tc1) {
+    func_ptr = EVAL_BATCH_CMP_FUNCS[1][cmp_op];
+  }
+  return func_ptr;
+}
+
 DatumCmpFunc ObExprCmpFuncsHelper::get_datum_expr_cmp_func(
     const ObObjType type1, const ObObjType type2, const bool is_oracle_mode, const ObCollationType cs_type)
 {
@@ -236,5 +285,8 @@ REG_SER_FUNC_ARRAY(OB_SFA_RELATION_EXPR_EVAL_STR, EVAL_STR_CMP_FUNCS, sizeof(EVA
 static_assert(CS_TYPE_MAX * 2 == sizeof(DATUM_STR_CMP_FUNCS) / sizeof(void*), "unexpected size");
 REG_SER_FUNC_ARRAY(OB_SFA_DATUM_CMP_STR, DATUM_STR_CMP_FUNCS, sizeof(DATUM_STR_CMP_FUNCS) / sizeof(void*));
 
+REG_SER_FUNC_ARRAY(
+    OB_SFA_RELATION_EXPR_EVAL_BATCH, EVAL_BATCH_CMP_FUNCS, sizeof(EVAL_BATCH_CMP_FUNCS) / sizeof(void*));
+
 }  // namespace sql
 }  // end namespace oceanbase
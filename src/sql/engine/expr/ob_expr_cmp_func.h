@@ -29,6 +29,10 @@ public:
   static sql::ObExpr::EvalFunc get_eval_expr_cmp_func(const common::ObObjType type1, const common::ObObjType type2,
       const common::ObCmpOp cmp_op, const bool is_oracle_mode, const common::ObCollationType cs_type);
 
+  // batch evaluate function, only integer and double compare supported, return NULL otherwise.
+  static sql::ObExpr::EvalBatchFunc get_eval_batch_expr_cmp_func(
+      const common::ObObjType type1, const common::ObObjType type2, const common::ObCmpOp cmp_op);
+
   static DatumCmpFunc get_datum_expr_cmp_func(const common::ObObjType type1, const common::ObObjType type2,
       const bool is_oracle_mode, const common::ObCollationType cs_type);
 };
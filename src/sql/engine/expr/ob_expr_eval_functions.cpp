@@ -223,6 +223,8 @@ extern int calc_log_expr_double(const ObExpr&, ObEvalCtx&, ObDatum&);
 extern int calc_log_expr_number(const ObExpr&, ObEvalCtx&, ObDatum&);
 extern int calc_not_between_expr(const ObExpr&, ObEvalCtx&, ObDatum&);
 extern int calc_or_exprN(const ObExpr&, ObEvalCtx&, ObDatum&);
+extern int calc_and_exprN_batch(const ObExpr&, ObEvalCtx&, const ObBitVector&, const int64_t);
+extern int calc_or_exprN_batch(const ObExpr&, ObEvalCtx&, const ObBitVector&, const int64_t);
 extern int calc_power_expr_oracle(const ObExpr&, ObEvalCtx&, ObDatum&);
 extern int calc_right_expr(const ObExpr&, ObEvalCtx&, ObDatum&);
 extern int calc_sign_expr(const ObExpr&, ObEvalCtx&, ObDatum&);
@@ -671,5 +673,23 @@ static ObExpr::EvalFunc g_expr_eval_functions[] = {
 
 REG_SER_FUNC_ARRAY(OB_SFA_SQL_EXPR_EVAL, g_expr_eval_functions, ARRAYSIZEOF(g_expr_eval_functions));
 
+// batch evaluate functions, append only like g_expr_eval_functions.
+static ObExpr::EvalBatchFunc g_expr_eval_batch_functions[] = {
+    ObExprAdd::add_int_int_batch,             /* 0 */
+    ObExprAdd::add_double_double_batch,       /* 1 */
+    ObExprAdd::add_number_number_batch,       /* 2 */
+    ObExprMinus::minus_int_int_batch,         /* 3 */
+    ObExprMinus::minus_double_double_batch,   /* 4 */
+    ObExprMinus::minus_number_number_batch,   /* 5 */
+    ObExprMul::mul_int_int_batch,             /* 6 */
+    ObExprMul::mul_double_batch,              /* 7 */
+    ObExprMul::mul_number_batch,              /* 8 */
+    calc_and_exprN_batch,                     /* 9 */
+    calc_or_exprN_batch                       /* 10 */
+};
+
+REG_SER_FUNC_ARRAY(
+    OB_SFA_SQL_EXPR_EVAL_BATCH, g_expr_eval_batch_functions, ARRAYSIZEOF(g_expr_eval_batch_functions));
+
 }  // end namespace sql
 }  // end namespace oceanbase
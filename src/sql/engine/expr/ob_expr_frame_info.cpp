@@ -38,6 +38,7 @@ int ObExprFrameInfo::pre_alloc_exec_memory(ObExecContext& exec_ctx) const
   } else {
     exec_ctx.set_frame_cnt(frame_cnt);
     exec_ctx.set_frames(frames);
+    exec_ctx.set_max_batch_size(max_batch_size_);
   }
 
   return ret;
@@ -96,6 +97,7 @@ int ObPreCalcExprFrameInfo::assign(const ObPreCalcExprFrameInfo& other, common::
 {
   int ret = OB_SUCCESS;
   need_ctx_cnt_ = other.need_ctx_cnt_;
+  max_batch_size_ = other.max_batch_size_;
 
   if (OB_FAIL(rt_exprs_.assign(other.rt_exprs_))) {
     LOG_WARN("failed to copy rt exprs", K(ret));
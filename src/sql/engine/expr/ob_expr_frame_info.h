@@ -44,6 +44,7 @@ struct ObExprFrameInfo {
   static const int64_t EXPR_CNT_PER_FRAME = common::MAX_FRAME_SIZE / (sizeof(ObDatum) + sizeof(ObEvalInfo));
   ObExprFrameInfo(common::ObIAllocator& allocator)
       : need_ctx_cnt_(0),
+        max_batch_size_(0),
         rt_exprs_(0, common::ModulePageAllocator(allocator)),
         const_frame_ptrs_(allocator),
         const_frame_(allocator),
@@ -59,11 +60,13 @@ struct ObExprFrameInfo {
   int alloc_frame(
       common::ObIAllocator& exec_allocator, ObPhysicalPlanCtx& phy_ctx, uint64_t& frame_cnt, char**& frames) const;
 
-  TO_STRING_KV(K_(const_frame_ptrs), K_(const_frame), K_(dynamic_frame), K_(datum_frame));
+  TO_STRING_KV(K_(max_batch_size), K_(const_frame_ptrs), K_(const_frame), K_(dynamic_frame), K_(datum_frame));
 
 public:
   // count of expression need context. exec_ctx pre allocate memory according to it.
   int64_t need_ctx_cnt_;
+  // batch size of batch result expressions, 0 if no batch result expression.
+  int64_t max_batch_size_;
   // all physical expressions generated by expe_code_generator
   common::ObArray<ObExpr> rt_exprs_;
   common::ObFixedArray<char*, common::ObIAllocator> const_frame_ptrs_;
@@ -20,6 +20,7 @@
 #include "sql/session/ob_sql_session_info.h"
 #include "sql/engine/ob_exec_context.h"
 #include "sql/code_generator/ob_static_engine_expr_cg.h"
+#include "sql/engine/expr/ob_batch_eval_util.h"
 
 namespace oceanbase {
 using namespace common;
@@ -510,6 +511,7 @@ int ObExprMinus::cg_expr(ObExprCGCtx& op_cg_ctx, const ObRawExpr& raw_expr, ObEx
     LOG_WARN("child is null", K(ret), K(rt_expr.args_[0]), K(rt_expr.args_[1]));
   } else {
     rt_expr.eval_func_ = NULL;
+    rt_expr.eval_batch_func_ = NULL;
     const ObObjType left_type = rt_expr.args_[0]->datum_meta_.type_;
     const ObObjType right_type = rt_expr.args_[1]->datum_meta_.type_;
     const ObObjType result_type = rt_expr.datum_meta_.type_;
@@ -519,6 +521,7 @@ int ObExprMinus::cg_expr(ObExprCGCtx& op_cg_ctx, const ObRawExpr& raw_expr, ObEx
     switch (result_type) {
       case ObIntType:
         rt_expr.eval_func_ = ObExprMinus::minus_int_int;
+        rt_expr.eval_batch_func_ = ObExprMinus::minus_int_int_batch;
         break;
       case ObUInt64Type:
         if (ObIntTC == left_tc && ObUIntTC == right_tc) {
@@ -576,6 +579,7 @@ int ObExprMinus::cg_expr(ObExprCGCtx& op_cg_ctx, const ObRawExpr& raw_expr, ObEx
         break;
       case ObDoubleType:
         rt_expr.eval_func_ = ObExprMinus::minus_double_double;
+        rt_expr.eval_batch_func_ = ObExprMinus::minus_double_double_batch;
         break;
       case ObUNumberType:
       case ObNumberType:
@@ -583,6 +587,7 @@ int ObExprMinus::cg_expr(ObExprCGCtx& op_cg_ctx, const ObRawExpr& raw_expr, ObEx
           rt_expr.eval_func_ = ObExprMinus::minus_datetime_datetime_oracle;
         } else {
           rt_expr.eval_func_ = ObExprMinus::minus_number_number;
+          rt_expr.eval_batch_func_ = ObExprMinus::minus_number_number_batch;
         }
         break;
       default:
@@ -767,6 +772,72 @@ int ObExprMinus::minus_number_number(const ObExpr& expr, ObEvalCtx& ctx, ObDatum
   return ret;
 }
 
+struct ObMinusIntIntBatchOp {
+  typedef int64_t ValueType;
+  static int64_t get(const ObDatum& datum)
+  {
+    return datum.get_int();
+  }
+  static void set(ObDatum& datum, const int64_t v)
+  {
+    datum.set_int(v);
+  }
+  static void kernel(const int64_t* l, const int64_t* r, int64_t* res, const int64_t cnt)
+  {
+    ObBatchKernel::sub_int(l, r, res, cnt);
+  }
+  static bool is_valid(const ObExpr&, const int64_t l, const int64_t r, const int64_t res)
+  {
+    // same with ObExprMinus::is_int_int_out_of_range(): overflow if operands have different
+    // signs and the sign of result differs from the left operand.
+    return ((l ^ r) & (l ^ res)) >= 0;
+  }
+};
+
+struct ObMinusDoubleBatchOp {
+  typedef double ValueType;
+  static double get(const ObDatum& datum)
+  {
+    return datum.get_double();
+  }
+  static void set(ObDatum& datum, const double v)
+  {
+    datum.set_double(v);
+  }
+  static void kernel(const double* l, const double* r, double* res, const int64_t cnt)
+  {
+    ObBatchKernel::sub_double(l, r, res, cnt);
+  }
+  static bool is_valid(const ObExpr& expr, const double, const double, const double res)
+  {
+    return !ObArithExprOperator::is_double_out_of_range(res) || T_OP_AGG_MINUS == expr.type_;
+  }
+};
+
+struct ObMinusNumberBatchOp {
+  static int calc(const ObNumber& l, const ObNumber& r, ObNumber& res, ObIAllocator& alloc)
+  {
+    return l.sub_v3(r, res, alloc);
+  }
+};
+
+int ObExprMinus::minus_int_int_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size)
+{
+  return ObBatchEvalUtil::arith_eval_batch<ObMinusIntIntBatchOp>(expr, ctx, skip, size);
+}
+
+int ObExprMinus::minus_double_double_batch(
+    const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size)
+{
+  return ObBatchEvalUtil::arith_eval_batch<ObMinusDoubleBatchOp>(expr, ctx, skip, size);
+}
+
+int ObExprMinus::minus_number_number_batch(
+    const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size)
+{
+  return ObBatchEvalUtil::number_eval_batch<ObMinusNumberBatchOp>(expr, ctx, skip, size);
+}
+
 // interval can calc with different types such as date, timestamp, interval.
 // the params do not need to do cast
 
@@ -63,6 +63,11 @@ public:
   static int minus_float_float(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& expr_datum);
   static int minus_double_double(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& expr_datum);
   static int minus_number_number(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& expr_datum);
+  static int minus_int_int_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size);
+  static int minus_double_double_batch(
+      const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size);
+  static int minus_number_number_batch(
+      const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size);
 
   static int minus_intervalym_intervalym(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& expr_datum);
   static int minus_intervalds_intervalds(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& expr_datum);
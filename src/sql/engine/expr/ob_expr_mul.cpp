@@ -15,6 +15,7 @@
 #include "sql/engine/expr/ob_expr_mul.h"
 #include "sql/engine/expr/ob_expr_result_type_util.h"
 #include "sql/session/ob_sql_session_info.h"
+#include "sql/engine/expr/ob_batch_eval_util.h"
 
 using namespace oceanbase::common;
 
@@ -614,6 +615,70 @@ int ObExprMul::mul_number(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& datum)
   return ret;
 }
 
+struct ObMulIntIntBatchOp {
+  typedef int64_t ValueType;
+  static int64_t get(const ObDatum& datum)
+  {
+    return datum.get_int();
+  }
+  static void set(ObDatum& datum, const int64_t v)
+  {
+    datum.set_int(v);
+  }
+  static void kernel(const int64_t* l, const int64_t* r, int64_t* res, const int64_t cnt)
+  {
+    ObBatchKernel::mul_int(l, r, res, cnt);
+  }
+  static bool is_valid(const ObExpr&, const int64_t l, const int64_t r, const int64_t)
+  {
+    // same with is_multi_overflow64(), without division.
+    int64_t res = 0;
+    return !__builtin_mul_overflow(l, r, &res);
+  }
+};
+
+struct ObMulDoubleBatchOp {
+  typedef double ValueType;
+  static double get(const ObDatum& datum)
+  {
+    return datum.get_double();
+  }
+  static void set(ObDatum& datum, const double v)
+  {
+    datum.set_double(v);
+  }
+  static void kernel(const double* l, const double* r, double* res, const int64_t cnt)
+  {
+    ObBatchKernel::mul_double(l, r, res, cnt);
+  }
+  static bool is_valid(const ObExpr& expr, const double, const double, const double res)
+  {
+    return !ObArithExprOperator::is_double_out_of_range(res) || T_OP_AGG_MUL == expr.type_;
+  }
+};
+
+struct ObMulNumberBatchOp {
+  static int calc(const ObNumber& l, const ObNumber& r, ObNumber& res, ObIAllocator& alloc)
+  {
+    return l.mul_v3(r, res, alloc);
+  }
+};
+
+int ObExprMul::mul_int_int_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size)
+{
+  return ObBatchEvalUtil::arith_eval_batch<ObMulIntIntBatchOp>(expr, ctx, skip, size);
+}
+
+int ObExprMul::mul_double_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size)
+{
+  return ObBatchEvalUtil::arith_eval_batch<ObMulDoubleBatchOp>(expr, ctx, skip, size);
+}
+
+int ObExprMul::mul_number_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size)
+{
+  return ObBatchEvalUtil::number_eval_batch<ObMulNumberBatchOp>(expr, ctx, skip, size);
+}
+
 int ObExprMul::mul_intervalym_number_common(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& datum, const bool number_left)
 {
   int ret = OB_SUCCESS;
@@ -742,10 +807,12 @@ int ObExprMul::cg_expr(ObExprCGCtx& op_cg_ctx, const ObRawExpr& raw_expr, ObExpr
   OB_ASSERT(right == input_types_[1].get_calc_type());
 
   rt_expr.inner_functions_ = NULL;
+  rt_expr.eval_batch_func_ = NULL;
   LOG_DEBUG("arrive here cg_expr", K(ret), K(rt_expr));
   switch (rt_expr.datum_meta_.type_) {
     case ObIntType: {
       rt_expr.eval_func_ = ObExprMul::mul_int_int;
+      rt_expr.eval_batch_func_ = ObExprMul::mul_int_int_batch;
       break;
     }
     case ObUInt64Type: {
@@ -768,11 +835,13 @@ int ObExprMul::cg_expr(ObExprCGCtx& op_cg_ctx, const ObRawExpr& raw_expr, ObExpr
     }
     case ObDoubleType: {
       rt_expr.eval_func_ = ObExprMul::mul_double;
+      rt_expr.eval_batch_func_ = ObExprMul::mul_double_batch;
       break;
     }
     case ObUNumberType:
     case ObNumberType: {
       rt_expr.eval_func_ = ObExprMul::mul_number;
+      rt_expr.eval_batch_func_ = ObExprMul::mul_number_batch;
       break;
     }
     case ObIntervalYMType: {
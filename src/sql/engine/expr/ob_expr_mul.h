@@ -37,6 +37,9 @@ public:
   static int mul_float(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& expr_datum);
   static int mul_double(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& expr_datum);
   static int mul_number(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& expr_datum);
+  static int mul_int_int_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size);
+  static int mul_double_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size);
+  static int mul_number_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size);
   static int mul_intervalym_number_common(
       const ObExpr& expr, ObEvalCtx& ctx, ObDatum& expr_datum, const bool number_left);
   static int mul_intervalds_number_common(
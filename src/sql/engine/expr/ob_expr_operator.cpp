@@ -4746,6 +4746,7 @@ int ObRelationalExprOperator::cg_datum_cmp_expr(
       rt_expr.eval_func_ = ObExprCmpFuncsHelper::get_eval_expr_cmp_func(
           input_type1, input_type2, cmp_op, lib::is_oracle_mode(), cs_type);
       CK(NULL != rt_expr.eval_func_);
+      rt_expr.eval_batch_func_ = ObExprCmpFuncsHelper::get_eval_batch_expr_cmp_func(input_type1, input_type2, cmp_op);
     }
   }
   return ret;
@@ -16,6 +16,7 @@
 #include "share/object/ob_obj_cast.h"
 //#include "sql/engine/expr/ob_expr_promotion_util.h"
 #include "sql/session/ob_sql_session_info.h"
+#include "sql/engine/expr/ob_batch_eval_util.h"
 
 namespace oceanbase {
 using namespace common;
@@ -224,6 +225,22 @@ int calc_or_exprN(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& res_datum)
   return ret;
 }
 
+int calc_or_exprN_batch(const ObExpr& expr, ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size)
+{
+  int ret = ObBatchEvalUtil::logic_eval_batch(false /* is_and */, expr, ctx, skip, size);
+  if (OB_ERR_TRUNCATED_WRONG_VALUE_FOR_FIELD == ret) {
+    // empty string cast failure is handled specially in calc_or_exprN(),
+    // evaluate row by row to get the same result.
+    ret = OB_SUCCESS;
+    for (int64_t i = 0; OB_SUCC(ret) && i < size; i++) {
+      if (!skip.at(i) && OB_FAIL(ObBatchEvalUtil::eval_row_of_batch(expr, ctx, i))) {
+        LOG_WARN("evaluate row failed", K(ret), K(i));
+      }
+    }
+  }
+  return ret;
+}
+
 int ObExprOr::cg_expr(ObExprCGCtx& expr_cg_ctx, const ObRawExpr& raw_expr, ObExpr& rt_expr) const
 {
   int ret = OB_SUCCESS;
@@ -234,6 +251,7 @@ int ObExprOr::cg_expr(ObExprCGCtx& expr_cg_ctx, const ObRawExpr& raw_expr, ObExp
     LOG_WARN("args_ is NULL or arg_cnt_ is invalid or raw_expr is invalid", K(ret), K(rt_expr), K(raw_expr));
   } else {
     rt_expr.eval_func_ = calc_or_exprN;
+    rt_expr.eval_batch_func_ = calc_or_exprN_batch;
   }
   return ret;
 }
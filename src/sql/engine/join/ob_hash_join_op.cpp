@@ -13,6 +13,7 @@
 #define USING_LOG_PREFIX SQL_ENG
 
 #include "sql/engine/join/ob_hash_join_op.h"
+#include "sql/engine/ob_operator_reg.h"
 #include "sql/engine/px/ob_px_util.h"
 #include "observer/omt/ob_tenant_config_mgr.h"
 #include "sql/engine/ob_exec_context.h"
@@ -20,6 +21,8 @@
 #include "observer/omt/ob_tenant_config_mgr.h"
 #include "sql/engine/px/ob_px_util.h"
 #include "share/diagnosis/ob_sql_monitor_statname.h"
+#include "sql/engine/px/ob_px_sqc_handler.h"
+#include "sql/engine/px/datahub/components/ob_dh_join_filter.h"
 
 namespace oceanbase {
 using namespace omt;
@@ -31,10 +34,31 @@ ObHashJoinSpec::ObHashJoinSpec(common::ObIAllocator& alloc, const ObPhyOperatorT
       equal_join_conds_(alloc),
       all_join_keys_(alloc),
       all_hash_funcs_(alloc),
-      has_join_bf_(false)
+      has_join_bf_(false),
+      join_filter_bit_cnt_(0),
+      is_shared_ht_(false)
 {}
 
-OB_SERIALIZE_MEMBER((ObHashJoinSpec, ObJoinSpec), equal_join_conds_, all_join_keys_, all_hash_funcs_, has_join_bf_);
+OB_SERIALIZE_MEMBER((ObHashJoinSpec, ObJoinSpec), equal_join_conds_, all_join_keys_, all_hash_funcs_, has_join_bf_,
+    join_filter_bit_cnt_, is_shared_ht_);
+
+OB_SERIALIZE_MEMBER(ObHashJoinInput, shared_hj_info_);
+
+int ObHashJoinInput::init_shared_hj_info(ObIAllocator& alloc, const int64_t task_cnt)
+{
+  int ret = OB_SUCCESS;
+  void* buf = NULL;
+  if (OB_UNLIKELY(task_cnt <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid task count", K(ret), K(task_cnt));
+  } else if (OB_ISNULL(buf = alloc.alloc(sizeof(ObHashJoinSharedTableInfo)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate memory failed", K(ret));
+  } else {
+    shared_hj_info_ = reinterpret_cast<uint64_t>(new (buf) ObHashJoinSharedTableInfo(task_cnt));
+  }
+  return ret;
+}
 
 int ObHashJoinOp::PartHashJoinTable::init(ObIAllocator& alloc)
 {
@@ -112,6 +136,8 @@ ObHashJoinOp::ObHashJoinOp(ObExecContext& ctx_, const ObOpSpec& spec, ObOpInput*
       alloc_(nullptr),
       bloom_filter_alloc_(nullptr),
       bloom_filter_(nullptr),
+      join_filter_(),
+      join_filter_published_(false),
       nth_right_row_(-1),
       ltb_size_(INIT_LTB_SIZE),
       l2_cache_size_(INIT_L2_CACHE_SIZE),
@@ -148,10 +174,14 @@ ObHashJoinOp::ObHashJoinOp(ObExecContext& ctx_, const ObOpSpec& spec, ObOpInput*
       cur_right_hist_(nullptr),
       cur_probe_row_idx_(0),
       max_right_bucket_idx_(0),
+      left_brs_(),
+      right_brs_(),
       probe_cnt_(0),
       bitset_filter_cnt_(0),
       hash_link_cnt_(0),
-      hash_equal_cnt_(0)
+      hash_equal_cnt_(0),
+      shared_info_(nullptr),
+      sync_step_(0)
 {
   /*
                         read_left_row -> build_hash_table
@@ -267,6 +297,10 @@ int ObHashJoinOp::inner_open()
   } else if (OB_FAIL(hash_table_.init(*alloc_))) {
     LOG_WARN("fail to init hash table", K(ret));
   } else {
+    if (MY_SPEC.is_shared_ht_ && nullptr != input_) {
+      shared_info_ = MY_INPUT.get_shared_hj_info();
+      sync_step_ = ObHashJoinSharedTableInfo::SYNC_ROW_CNT;
+    }
     init_system_parameters();
     tenant_id_ = session->get_effective_tenant_id();
     first_get_row_ = true;
@@ -337,6 +371,13 @@ int ObHashJoinOp::inner_open()
       LOG_WARN("failed to init right last row", K(ret));
     }
   }
+  if (OB_SUCC(ret) && MY_SPEC.is_vectorized()) {
+    if (OB_FAIL(init_child_batch_rows(*left_, left_brs_))) {
+      LOG_WARN("init left batch rows failed", K(ret));
+    } else if (OB_FAIL(init_child_batch_rows(*right_, right_brs_))) {
+      LOG_WARN("init right batch rows failed", K(ret));
+    }
+  }
   return ret;
 }
 
@@ -454,12 +495,18 @@ int ObHashJoinOp::part_rescan(bool reset_all)
 int ObHashJoinOp::rescan()
 {
   int ret = OB_SUCCESS;
-  if (OB_FAIL(part_rescan(true))) {
+  if (is_shared_ht()) {
+    // tasks sharing the hash table can not rescan separately
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("rescan shared hash join not supported", K(ret));
+  } else if (OB_FAIL(part_rescan(true))) {
     LOG_WARN("part rescan failed", K(ret));
   } else if (OB_FAIL(ObJoinOp::rescan())) {
     LOG_WARN("join rescan failed", K(ret));
   } else {
     iter_end_ = false;
+    left_brs_.reset();
+    right_brs_.reset();
   }
   LOG_TRACE("hash join rescan", K(ret));
   return ret;
@@ -481,7 +528,9 @@ int ObHashJoinOp::next()
       func = FT_ITER_END;
       ret = OB_SUCCESS;
     } else if (OB_FAIL(ret)) {
-      LOG_WARN("failed state operation", K(ret), K(state));
+      if (OB_ITER_STOP != ret) {
+        LOG_WARN("failed state operation", K(ret), K(state));
+      }
     } else {
       func = FT_ITER_GOING;
     }
@@ -522,12 +571,18 @@ int ObHashJoinOp::inner_get_next_row()
           ret = OB_SUCCESS;
         } else if (OB_SUCCESS == ret) {
           exit_while = true;
-        } else {
+        } else if (OB_ITER_STOP != ret) {
           LOG_WARN("fail to get next row", K(ret));
         }
         break;
       }
       case ObHashJoinOp::HJState::NEXT_BATCH: {
+        if (MY_SPEC.is_vectorized() && eval_ctx_.get_batch_idx() > 0) {
+          // rows of current batch may reference to the memory of partition batches,
+          // stop current batch before they are released.
+          ret = OB_ITER_STOP;
+          break;
+        }
         batch_mgr_->remove_undumped_batch();
         if (left_batch_ != NULL) {
           left_batch_->close();
@@ -580,11 +635,115 @@ int ObHashJoinOp::inner_get_next_row()
   return ret;
 }
 
+int ObHashJoinOp::inner_get_next_batch(const int64_t max_row_cnt)
+{
+  int ret = OB_SUCCESS;
+  bool stop = false;
+  ObEvalCtx::BatchInfoScopeGuard batch_info_guard(eval_ctx_);
+  for (int64_t i = 0; OB_SUCC(ret) && !stop && i < max_row_cnt; i++) {
+    batch_info_guard.set_batch_idx(i);
+    if (i > 0) {
+      inherit_prev_batch_row(left_->get_spec().output_, i);
+      inherit_prev_batch_row(right_->get_spec().output_, i);
+    }
+    if (OB_FAIL(inner_get_next_row())) {
+      if (OB_ITER_STOP == ret) {
+        ret = OB_SUCCESS;
+        stop = true;
+      } else if (OB_ITER_END != ret) {
+        LOG_WARN("get next row failed", K(ret));
+      }
+    } else if (NULL != right_batch_ && has_fill_right_row_ &&
+               OB_FAIL(deep_copy_batch_row(right_->get_spec().output_))) {
+      // right rows of partition are read by chunk store iterator, memory may be reused.
+      LOG_WARN("deep copy batch row failed", K(ret));
+    } else {
+      brs_.size_ = i + 1;
+    }
+  }
+  if (OB_ITER_END == ret) {
+    ret = OB_SUCCESS;
+    brs_.end_ = true;
+  }
+  return ret;
+}
+
+int ObHashJoinOp::init_child_batch_rows(const ObOperator& child, ChildBatchRows& rows)
+{
+  int ret = OB_SUCCESS;
+  rows.reset();
+  if (NULL == rows.datums_) {
+    const int64_t size = sizeof(ObDatum) * child.get_spec().output_.count() * MY_SPEC.max_batch_size_;
+    void* mem = NULL;
+    if (size > 0 && OB_ISNULL(mem = ctx_.get_allocator().alloc(size))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("allocate memory failed", K(ret), K(size));
+    } else {
+      rows.datums_ = static_cast<ObDatum*>(mem);
+    }
+  }
+  return ret;
+}
+
+int ObHashJoinOp::get_next_child_batch_row(ObOperator& child, ChildBatchRows& rows)
+{
+  int ret = OB_SUCCESS;
+  const ExprFixedArray& exprs = child.get_spec().output_;
+  const int64_t max_batch_size = MY_SPEC.max_batch_size_;
+  bool got_row = false;
+  while (OB_SUCC(ret) && !got_row) {
+    if (NULL != rows.brs_ && rows.cur_idx_ < rows.brs_->size_) {
+      if (!rows.brs_->skip_->at(rows.cur_idx_)) {
+        for (int64_t i = 0; i < exprs.count(); i++) {
+          if (exprs.at(i)->batch_result_) {
+            exprs.at(i)->locate_expr_datum(eval_ctx_) = rows.datums_[i * max_batch_size + rows.cur_idx_];
+          }
+        }
+        got_row = true;
+      }
+      rows.cur_idx_++;
+    } else if (NULL != rows.brs_ && rows.brs_->end_) {
+      ret = OB_ITER_END;
+    } else if (eval_ctx_.get_batch_idx() > 0) {
+      // rows of current batch may reference to the child batch, which is overwritten
+      // by the next child batch, stop current batch first.
+      ret = OB_ITER_STOP;
+    } else {
+      rows.cur_idx_ = 0;
+      if (OB_FAIL(child.get_next_batch(max_batch_size, rows.brs_))) {
+        LOG_WARN("get next batch failed", K(ret));
+      }
+      for (int64_t i = 0; OB_SUCC(ret) && i < exprs.count(); i++) {
+        ObExpr* expr = exprs.at(i);
+        if (OB_FAIL(expr->eval_batch(eval_ctx_, *rows.brs_->skip_, rows.brs_->size_))) {
+          LOG_WARN("expr evaluate failed", K(ret), KPC(expr));
+        } else if (expr->batch_result_) {
+          MEMCPY(rows.datums_ + i * max_batch_size, expr->locate_batch_datums(eval_ctx_),
+              sizeof(ObDatum) * rows.brs_->size_);
+          expr->get_eval_info(eval_ctx_).evaluated_ = true;
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+void ObHashJoinOp::inherit_prev_batch_row(const ExprFixedArray& exprs, const int64_t batch_idx)
+{
+  for (int64_t i = 0; i < exprs.count(); i++) {
+    if (exprs.at(i)->batch_result_) {
+      ObDatum* datums = exprs.at(i)->locate_batch_datums(eval_ctx_);
+      datums[batch_idx] = datums[batch_idx - 1];
+    }
+  }
+}
+
 void ObHashJoinOp::destroy()
 {
   if (OB_LIKELY(nullptr != alloc_)) {
     alloc_ = nullptr;
   }
+  join_filter_.reset();
   if (OB_LIKELY(NULL != mem_context_)) {
     DESTROY_CONTEXT(mem_context_);
     mem_context_ = NULL;
@@ -595,6 +754,8 @@ void ObHashJoinOp::destroy()
 int ObHashJoinOp::inner_close()
 {
   int ret = OB_SUCCESS;
+  // wait tasks sharing hash table before release rows and buckets
+  close_shared_hash_table();
   sql_mem_processor_.unregister_profile();
   reset();
   tmp_hash_funcs_.reset();
@@ -617,6 +778,7 @@ int ObHashJoinOp::inner_close()
     hash_table_.free(alloc_);
     alloc_->reset();
   }
+  join_filter_.reset();
   if (nullptr != mem_context_) {
     mem_context_->reuse();
   }
@@ -624,6 +786,26 @@ int ObHashJoinOp::inner_close()
   return ret;
 }
 
+// The build rows received by this task are part of the shared hash table, build it before
+// draining even if the join is never pulled, e.g. the parent reached iter end early.
+int ObHashJoinOp::drain_exch()
+{
+  int ret = OB_SUCCESS;
+  bool need_not_read_right = false;
+  if (OB_FAIL(try_open())) {
+    LOG_WARN("fail to open operator", K(ret));
+  } else if (!is_shared_ht() || ObHashJoinSharedTableInfo::SYNC_ROW_CNT != sync_step_) {
+  } else if (OB_FAIL(adaptive_process(need_not_read_right))) {
+    LOG_WARN("failed to build shared hash table", K(ret));
+  } else {
+    first_get_row_ = false;
+  }
+  if (OB_SUCC(ret) && OB_FAIL(ObJoinOp::drain_exch())) {
+    LOG_WARN("drain exch failed", K(ret));
+  }
+  return ret;
+}
+
 int ObHashJoinOp::join_end_operate()
 {
   return OB_ITER_END;
@@ -649,8 +831,13 @@ int ObHashJoinOp::get_next_left_row()
   int ret = common::OB_SUCCESS;
   left_row_joined_ = false;
   if (left_batch_ == NULL) {
-    if (OB_FAIL(OB_I(t1) left_->get_next_row())) {
-      if (OB_ITER_END != ret) {
+    if (MY_SPEC.is_vectorized()) {
+      ret = get_next_child_batch_row(*left_, left_brs_);
+    } else {
+      ret = OB_I(t1) left_->get_next_row();
+    }
+    if (OB_FAIL(ret)) {
+      if (OB_ITER_END != ret && OB_ITER_STOP != ret) {
         LOG_WARN("get left row from child failed", K(ret));
       }
     }
@@ -1398,6 +1585,10 @@ int ObHashJoinOp::split_partition(int64_t& num_left_rows)
   uint64_t hash_value = 0;
   ObHashJoinStoredJoinRow* stored_row = nullptr;
   int64_t row_count_on_disk = 0;
+  const bool build_join_filter = MY_SPEC.has_join_bf_ && top_part_level() && !join_filter_published_;
+  // rows of shared hash table are referenced by other tasks, can not be dumped, the optimizer shares
+  // the hash table only if the estimated build size fits in the hash work area.
+  const bool enable_dump = GCONF.is_sql_operator_dump_enabled() && !is_shared_ht();
   if (nullptr != left_batch_) {
     // read all data, use default iterator
     if (OB_FAIL(left_batch_->set_iterator(false))) {
@@ -1406,6 +1597,11 @@ int ObHashJoinOp::split_partition(int64_t& num_left_rows)
       row_count_on_disk = left_batch_->get_row_count_on_disk();
     }
   }
+  if (OB_SUCC(ret) && build_join_filter) {
+    if (OB_FAIL(join_filter_.init(MY_SPEC.join_filter_bit_cnt_, mem_context_->get_malloc_allocator()))) {
+      LOG_WARN("init join filter failed", K(ret), K(MY_SPEC.join_filter_bit_cnt_));
+    }
+  }
   num_left_rows = 0;
   while (OB_SUCC(ret)) {
     clear_evaluated_flag();
@@ -1422,13 +1618,18 @@ int ObHashJoinOp::split_partition(int64_t& num_left_rows)
         hash_value = left_read_row_->get_hash_value();
       }
     }
+    if (OB_SUCC(ret) && build_join_filter) {
+      if (OB_FAIL(add_join_filter_row(hash_value))) {
+        LOG_WARN("add row to join filter failed", K(ret));
+      }
+    }
     if (OB_SUCC(ret)) {
       ++num_left_rows;
       const int64_t part_idx = get_part_idx(hash_value);
       if (OB_FAIL(hj_part_array_[part_idx].add_row(left_->get_spec().output_, &eval_ctx_, stored_row))) {
         // if oom, then dump and add row again
         if (OB_ALLOCATE_MEMORY_FAILED == ret) {
-          if (GCONF.is_sql_operator_dump_enabled()) {
+          if (enable_dump) {
             ret = OB_SUCCESS;
             if (OB_FAIL(force_dump(true))) {
               LOG_WARN("fail to dump", K(ret));
@@ -1445,7 +1646,7 @@ int ObHashJoinOp::split_partition(int64_t& num_left_rows)
       if (OB_SUCC(ret)) {
         stored_row->set_is_match(false);
         stored_row->set_hash_value(hash_value);
-        if (GCONF.is_sql_operator_dump_enabled()) {
+        if (enable_dump) {
           if (OB_FAIL(dump_build_table(num_left_rows))) {
             LOG_WARN("fail to dump", K(ret));
           }
@@ -1459,7 +1660,7 @@ int ObHashJoinOp::split_partition(int64_t& num_left_rows)
     if (nullptr != left_batch_) {
       left_batch_->rescan();
     }
-    if (sql_mem_processor_.is_auto_mgr()) {
+    if (sql_mem_processor_.is_auto_mgr() && !is_shared_ht()) {
       // last stage for dump build table
       if (OB_FAIL(calc_basic_info())) {
         LOG_WARN("failed to calc basic info", K(ret));
@@ -1468,7 +1669,7 @@ int ObHashJoinOp::split_partition(int64_t& num_left_rows)
       }
     }
     if (OB_FAIL(ret)) {
-    } else if (top_part_level() && force_hash_join_spill_) {
+    } else if (top_part_level() && force_hash_join_spill_ && !is_shared_ht()) {
       // force partition dump
       if (OB_FAIL(force_dump(true))) {
         LOG_WARN("fail to finish dump", K(ret));
@@ -1494,10 +1695,80 @@ int ObHashJoinOp::split_partition(int64_t& num_left_rows)
       LOG_WARN("expect read all data", K(ret), K(num_left_rows), K(row_count_on_disk));
     }
   }
+  if (OB_SUCC(ret) && build_join_filter) {
+    if (OB_FAIL(publish_join_filter())) {
+      LOG_WARN("publish join filter failed", K(ret));
+    }
+  }
   LOG_TRACE("trace split partition", K(ret), K(num_left_rows), K(row_count_on_disk));
   return ret;
 }
 
+int ObHashJoinOp::add_join_filter_row(const uint64_t hash_value)
+{
+  int ret = OB_SUCCESS;
+  if (tmp_hash_funcs_.empty()) {
+    join_filter_.put(hash_value);
+  } else {
+    // The probe side calculate hash value with the default murmur hash functions of spec,
+    // recalculate if wyhash or xxhash is used.
+    const int64_t cnt = left_join_keys_.count();
+    ObArrayHelper<ObHashFunc> hash_funcs(cnt, const_cast<ObHashFunc*>(&MY_SPEC.all_hash_funcs_.at(0)), cnt);
+    uint64_t filter_hash = 0;
+    if (OB_FAIL(calc_join_filter_hash(left_join_keys_, hash_funcs, eval_ctx_, filter_hash))) {
+      LOG_WARN("calc join filter hash failed", K(ret));
+    } else {
+      join_filter_.put(filter_hash);
+    }
+  }
+  return ret;
+}
+
+int ObHashJoinOp::calc_join_filter_hash(const ObIArray<ObExpr*>& keys, const ObIArray<ObHashFunc>& hash_funcs,
+    ObEvalCtx& eval_ctx, uint64_t& hash_value)
+{
+  int ret = OB_SUCCESS;
+  hash_value = HASH_SEED;
+  ObDatum* datum = nullptr;
+  for (int64_t idx = 0; OB_SUCC(ret) && idx < keys.count(); ++idx) {
+    if (OB_FAIL(keys.at(idx)->eval(eval_ctx, datum))) {
+      LOG_WARN("failed to eval datum", K(ret));
+    } else {
+      hash_value = hash_funcs.at(idx).hash_func_(*datum, hash_value);
+    }
+  }
+  hash_value = hash_value & ObHashJoinStoredJoinRow::HASH_VAL_MASK;
+  return ret;
+}
+
+int ObHashJoinOp::publish_join_filter()
+{
+  int ret = OB_SUCCESS;
+  ObPxSqcHandler* handler = ctx_.get_sqc_handler();
+  if (OB_ISNULL(handler)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("join filter only supported in parallel execution mode", K(ret));
+  } else {
+    ObPxSQCProxy& proxy = handler->get_sqc_proxy();
+    ObJoinFilterPieceMsg piece;
+    piece.op_id_ = MY_SPEC.id_;
+    piece.thread_id_ = GETTID();
+    piece.dfo_id_ = proxy.get_dfo_id();
+    piece.is_request_ = false;
+    if (OB_FAIL(piece.filter_.assign(join_filter_, mem_context_->get_malloc_allocator()))) {
+      LOG_WARN("assign join filter failed", K(ret));
+    } else if (OB_FAIL(
+                   proxy.send_dh_piece_msg(piece, ctx_.get_physical_plan_ctx()->get_timeout_timestamp()))) {
+      LOG_WARN("send join filter piece msg failed", K(ret));
+    } else {
+      join_filter_published_ = true;
+      join_filter_.reset();
+      LOG_TRACE("join filter published", K(piece));
+    }
+  }
+  return ret;
+}
+
 void ObHashJoinOp::free_bloom_filter()
 {
   if (nullptr != bloom_filter_) {
@@ -1644,8 +1915,10 @@ bool ObHashJoinOp::can_use_cache_aware_opt()
     }
     ret = OB_SUCCESS;
   }
+  // cache aware processor materializes right rows by batch, which is not supported in
+  // vectorized execution.
   enable_cache_aware = ((enable_cache_aware && total_partition_cnt >= CACHE_AWARE_PART_CNT) || force_enable) &&
-                       INNER_JOIN == MY_SPEC.join_type_;
+                       INNER_JOIN == MY_SPEC.join_type_ && !MY_SPEC.is_vectorized();
   LOG_TRACE("trace check cache aware opt",
       K(total_memory_size),
       K(total_row_count),
@@ -1816,8 +2089,16 @@ int ObHashJoinOp::build_hash_table_for_recursive()
             }
             tuple = &(hash_table.all_cells_->at(cell_index));
             tuple->stored_row_ = const_cast<ObHashJoinStoredJoinRow*>(stored_row);
-            tuple->next_tuple_ = hash_table.buckets_->at(bucket_id);
-            hash_table.buckets_->at(bucket_id) = tuple;
+            if (is_shared_ht()) {
+              // buckets are shared by tasks, insert to bucket head lock free
+              HashTableCell*& head = hash_table.buckets_->at(bucket_id);
+              do {
+                tuple->next_tuple_ = ATOMIC_LOAD(&head);
+              } while (!ATOMIC_BCAS(&head, tuple->next_tuple_, tuple));
+            } else {
+              tuple->next_tuple_ = hash_table.buckets_->at(bucket_id);
+              hash_table.buckets_->at(bucket_id) = tuple;
+            }
 
             // HashTableCell *first_tuple = hash_table.buckets_->at(bucket_id);
             // if (nullptr == first_tuple) {
@@ -1830,7 +2111,9 @@ int ObHashJoinOp::build_hash_table_for_recursive()
             //   first_tuple->next_tuple_ = tuple;
             //   tuple->next_tuple_ = nullptr;
             // }
-            hash_table.inc_collision(bucket_id);
+            if (!is_shared_ht()) {
+              hash_table.inc_collision(bucket_id);
+            }
             ++cell_index;
             ++nth_row;
           }
@@ -1847,7 +2130,7 @@ int ObHashJoinOp::build_hash_table_for_recursive()
     }
   }
   is_last_chunk_ = true;
-  if (OB_SUCC(ret)) {
+  if (OB_SUCC(ret) && !is_shared_ht()) {
     trace_hash_table_collision(total_row_count);
   }
   LOG_TRACE("trace to finish build hash table for recursive",
@@ -2381,7 +2664,8 @@ void ObHashJoinOp::init_system_parameters()
   l2_cache_size_ = INIT_L2_CACHE_SIZE;
   max_partition_count_per_level_ = ltb_size_ << 1;
   // enable_bloom_filter_ = !MY_SPEC.has_join_bf_;
-  enable_bloom_filter_ = true;
+  // bloom filter of task only contains rows of the task, not usable for shared hash table
+  enable_bloom_filter_ = !is_shared_ht();
 }
 
 int ObHashJoinOp::recursive_postprocess()
@@ -2392,6 +2676,10 @@ int ObHashJoinOp::recursive_postprocess()
     if (OB_FAIL(partition_and_build_histograms())) {
       LOG_WARN("failed to prepare cache aware histogram", K(ret));
     }
+  } else if (is_shared_ht()) {
+    if (OB_FAIL(build_shared_hash_table())) {
+      LOG_WARN("failed to build shared hash table", K(ret));
+    }
   } else {
     if (OB_FAIL(prepare_hash_table())) {
       LOG_WARN("failed to prepare hash table", K(ret));
@@ -2410,6 +2698,13 @@ int ObHashJoinOp::split_partition_and_build_hash_table(int64_t& num_left_rows)
   num_left_rows = 0;
   if (OB_FAIL(split_partition(num_left_rows))) {
     LOG_WARN("failed split partition", K(ret), K(part_level_));
+  } else if (is_shared_ht()) {
+    // build with other tasks eagerly, empty right side of this task is not known to the others
+    if (OB_FAIL(recursive_postprocess())) {
+      LOG_WARN("failed to post process left", K(ret));
+    } else {
+      num_left_rows = ATOMIC_LOAD(&shared_info_->row_cnt_);
+    }
   } else {
     can_use_cache_aware_opt();
     if (0 == num_left_rows && OB_FAIL(recursive_postprocess())) {
@@ -2419,6 +2714,125 @@ int ObHashJoinOp::split_partition_and_build_hash_table(int64_t& num_left_rows)
   return ret;
 }
 
+template <typename COND>
+int ObHashJoinOp::wait_shared_hash_table(COND cond)
+{
+  int ret = OB_SUCCESS;
+  bool done = false;
+  // error is set before arriving, check it after the condition reached too
+  while (OB_SUCC(ret) && !done) {
+    done = cond();
+    if (OB_FAIL(shared_info_->get_error())) {
+      LOG_WARN("other task of shared hash join failed", K(ret));
+    } else if (done) {
+    } else if (OB_FAIL(check_status())) {
+      LOG_WARN("check status failed", K(ret));
+    } else {
+      usleep(SHARED_HT_WAIT_INTERVAL_US);
+    }
+  }
+  return ret;
+}
+
+int ObHashJoinOp::sync_shared_hash_table(const ObHashJoinSharedTableInfo::SyncStep step)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(step != sync_step_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected sync step", K(ret), K(step), K(sync_step_));
+  } else {
+    shared_info_->arrive(step);
+    sync_step_ = step + 1;
+    if (OB_FAIL(wait_shared_hash_table([&]() { return shared_info_->all_arrived(step); }))) {
+      LOG_WARN("wait tasks of shared hash join failed", K(ret), K(step));
+    }
+  }
+  return ret;
+}
+
+// Build the hash table with the other tasks of SQC:
+//   1. sync build row count of all tasks
+//   2. the first task allocates buckets for all rows, the others attach to the buckets
+//   3. insert rows of this task to buckets, wait all tasks inserted.
+int ObHashJoinOp::build_shared_hash_table()
+{
+  int ret = OB_SUCCESS;
+  PartHashJoinTable& hash_table = hash_table_;
+  hash_table.buckets_->reuse();
+  hash_table.collision_cnts_->reuse();
+  hash_table.all_cells_->reuse();
+  if (OB_FAIL(calc_basic_info())) {
+    LOG_WARN("failed to calc basic info", K(ret));
+  } else {
+    hash_table.row_count_ = profile_.get_row_count();
+    ATOMIC_AAF(&shared_info_->row_cnt_, hash_table.row_count_);
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(sync_shared_hash_table(ObHashJoinSharedTableInfo::SYNC_ROW_CNT))) {
+    LOG_WARN("sync row count failed", K(ret));
+  } else if (1 == ATOMIC_AAF(&shared_info_->builder_cnt_, 1)) {
+    const int64_t nbuckets = calc_bucket_number(ATOMIC_LOAD(&shared_info_->row_cnt_));
+    if (OB_FAIL(hash_table.buckets_->init(nbuckets))) {
+      LOG_WARN("alloc bucket array failed", K(ret), K(nbuckets));
+    } else {
+      hash_table.nbuckets_ = nbuckets;
+      ATOMIC_STORE(&shared_info_->nbuckets_, nbuckets);
+      ATOMIC_STORE(&shared_info_->buckets_, static_cast<void*>(hash_table.buckets_));
+    }
+  } else if (OB_FAIL(wait_shared_hash_table([&]() { return NULL != ATOMIC_LOAD(&shared_info_->buckets_); }))) {
+    LOG_WARN("wait shared buckets failed", K(ret));
+  } else {
+    hash_table.attach_buckets(ATOMIC_LOAD(&shared_info_->buckets_), ATOMIC_LOAD(&shared_info_->nbuckets_));
+  }
+  if (OB_FAIL(ret)) {
+  } else if (0 < hash_table.row_count_ && OB_FAIL(hash_table.all_cells_->init(hash_table.row_count_))) {
+    LOG_WARN("alloc hash cell failed", K(ret), K(hash_table.row_count_));
+  } else if (OB_FAIL(sql_mem_processor_.update_used_mem_size(get_mem_used()))) {
+    LOG_WARN("failed to update used mem size", K(ret));
+  } else if (OB_FAIL(build_hash_table_for_recursive())) {
+    LOG_WARN("failed to build hash table", K(ret));
+  } else if (OB_FAIL(sync_shared_hash_table(ObHashJoinSharedTableInfo::SYNC_BUILD))) {
+    LOG_WARN("sync build hash table failed", K(ret));
+  }
+  if (OB_FAIL(ret)) {
+    shared_info_->set_error(ret);
+  }
+  LOG_TRACE("trace build shared hash table",
+      K(ret),
+      K(hash_table.row_count_),
+      K(hash_table.nbuckets_),
+      K(sync_step_),
+      K(*shared_info_));
+  return ret;
+}
+
+void ObHashJoinOp::close_shared_hash_table()
+{
+  if (is_shared_ht()) {
+    // The shared buckets and rows of this task are referenced by the other tasks
+    // after all tasks arrived at SYNC_ROW_CNT, wait them closed.
+    const bool referenced = sync_step_ > ObHashJoinSharedTableInfo::SYNC_ROW_CNT;
+    if (!referenced) {
+      // build rows of this task are not inserted, the others can not probe without them
+      shared_info_->set_error(OB_ERR_UNEXPECTED);
+      LOG_WARN("task closed without building shared hash table", K(*shared_info_));
+    }
+    for (; sync_step_ < ObHashJoinSharedTableInfo::SYNC_STEP_CNT; ++sync_step_) {
+      shared_info_->arrive(static_cast<ObHashJoinSharedTableInfo::SyncStep>(sync_step_));
+    }
+    if (referenced && shared_info_->all_arrived(ObHashJoinSharedTableInfo::SYNC_ROW_CNT)) {
+      // interrupt is ignored, the others are closing too
+      const ObPhysicalPlanCtx* plan_ctx = ctx_.get_physical_plan_ctx();
+      while (!shared_info_->all_arrived(ObHashJoinSharedTableInfo::SYNC_CLOSE) && nullptr != plan_ctx &&
+             !plan_ctx->is_timeout()) {
+        usleep(SHARED_HT_WAIT_INTERVAL_US);
+      }
+    }
+    LOG_TRACE("trace close shared hash table", K(referenced), K(*shared_info_));
+    shared_info_ = nullptr;
+  }
+}
+
 int ObHashJoinOp::recursive_process(bool& need_not_read_right)
 {
   int ret = OB_SUCCESS;
@@ -2493,8 +2907,13 @@ int ObHashJoinOp::get_next_right_row()
   if (right_batch_ == NULL) {
     has_fill_right_row_ = true;
     clear_evaluated_flag();
-    if (OB_FAIL(OB_I(t1) right_->get_next_row())) {
-      if (OB_ITER_END != ret) {
+    if (MY_SPEC.is_vectorized()) {
+      ret = get_next_child_batch_row(*right_, right_brs_);
+    } else {
+      ret = OB_I(t1) right_->get_next_row();
+    }
+    if (OB_FAIL(ret)) {
+      if (OB_ITER_END != ret && OB_ITER_STOP != ret) {
         LOG_WARN("get right row from child failed", K(ret));
       }
     }
@@ -2842,7 +3261,11 @@ int ObHashJoinOp::get_next_right_row_for_batch(NextFunc next_func)
 int ObHashJoinOp::read_right_operate()
 {
   int ret = OB_SUCCESS;
-  if (first_get_row_) {
+  if (first_get_row_ && MY_SPEC.is_vectorized() && eval_ctx_.get_batch_idx() > 0) {
+    // hash table is built (or reused for next chunk) in first get row, which may release
+    // the memory referenced by rows of current batch, stop current batch first.
+    ret = OB_ITER_STOP;
+  } else if (first_get_row_) {
     int tmp_ret = OB_SUCCESS;
     bool need_not_read_right = false;
     if (HJProcessor::NEST_LOOP == hj_processor_) {
@@ -2905,7 +3328,7 @@ int ObHashJoinOp::read_right_operate()
           }
         }
       }
-    } else if (OB_FAIL(get_next_right_row()) && OB_ITER_END != ret) {
+    } else if (OB_FAIL(get_next_right_row()) && OB_ITER_END != ret && OB_ITER_STOP != ret) {
       LOG_WARN("failed to get next right row", K(ret));
     }
   }
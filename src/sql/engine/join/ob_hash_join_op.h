@@ -20,10 +20,95 @@
 #include "sql/engine/ob_sql_mem_mgr_processor.h"
 #include "lib/container/ob_2d_array.h"
 #include "sql/engine/aggregate/ob_exec_hash_struct.h"
+#include "sql/engine/px/ob_px_bloom_filter.h"
 
 namespace oceanbase {
 namespace sql {
 
+// Hash table shared by the hash join tasks of one SQC (shared hash join).
+//
+// Build rows are broadcast to hosts (BC2HOST), each task keeps the build rows it received in its
+// own memory. After all tasks finished reading build rows, one task allocates the bucket array
+// for the rows of all tasks, then every task inserts its rows into the buckets (lock free) and
+// probes the buckets read only after all rows are inserted. Build rows are referenced by all tasks,
+// memory of the tasks is released after all tasks closed.
+//
+// Allocated by SQC and passed to tasks by operator input, all tasks of SQC must reach the sync
+// steps in order. Task closed without building the hash table fails the others, since its build
+// rows are missing in the shared buckets.
+class ObHashJoinSharedTableInfo {
+public:
+  enum SyncStep { SYNC_ROW_CNT = 0, SYNC_BUILD, SYNC_CLOSE, SYNC_STEP_CNT };
+
+  explicit ObHashJoinSharedTableInfo(const int64_t task_cnt)
+      : task_cnt_(task_cnt), row_cnt_(0), builder_cnt_(0), buckets_(NULL), nbuckets_(0), ret_(common::OB_SUCCESS)
+  {
+    MEMSET(sync_cnts_, 0, sizeof(sync_cnts_));
+  }
+
+  void arrive(const SyncStep step)
+  {
+    ATOMIC_AAF(&sync_cnts_[step], 1);
+  }
+  bool all_arrived(const SyncStep step) const
+  {
+    return ATOMIC_LOAD(&sync_cnts_[step]) >= task_cnt_;
+  }
+  // the first error of tasks, tasks waiting for sync steps quit with this error.
+  void set_error(const int ret)
+  {
+    ATOMIC_BCAS(&ret_, common::OB_SUCCESS, ret);
+  }
+  int get_error() const
+  {
+    return ATOMIC_LOAD(&ret_);
+  }
+
+  TO_STRING_KV(K_(task_cnt), "sync_cnts", common::ObArrayWrap<int64_t>(sync_cnts_, SYNC_STEP_CNT), K_(row_cnt),
+      K_(builder_cnt), KP_(buckets), K_(nbuckets), K_(ret));
+
+public:
+  int64_t task_cnt_;
+  int64_t sync_cnts_[SYNC_STEP_CNT];
+  int64_t row_cnt_;      // build rows of all tasks
+  int64_t builder_cnt_;  // the first task increased it allocates the buckets
+  void* buckets_;        // bucket array of the builder task, set before SYNC_BUILD
+  int64_t nbuckets_;
+  int ret_;
+};
+
+class ObHashJoinInput : public ObOpInput {
+  OB_UNIS_VERSION_V(1);
+
+public:
+  ObHashJoinInput(ObExecContext& ctx, const ObOpSpec& spec) : ObOpInput(ctx, spec), shared_hj_info_(0)
+  {}
+  virtual ~ObHashJoinInput()
+  {}
+  virtual int init(ObTaskInfo& task_info) override
+  {
+    UNUSED(task_info);
+    return common::OB_SUCCESS;
+  }
+  virtual void reset() override
+  {
+    shared_hj_info_ = 0;
+  }
+  // called by SQC, the shared table info lives as long as SQC.
+  int init_shared_hj_info(common::ObIAllocator& alloc, const int64_t task_cnt);
+  ObHashJoinSharedTableInfo* get_shared_hj_info() const
+  {
+    return reinterpret_cast<ObHashJoinSharedTableInfo*>(shared_hj_info_);
+  }
+
+public:
+  // address of ObHashJoinSharedTableInfo, tasks run in the same process with SQC.
+  uint64_t shared_hj_info_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObHashJoinInput);
+};
+
 class ObHashJoinSpec : public ObJoinSpec {
   OB_UNIS_VERSION_V(1);
 
@@ -33,7 +118,11 @@ public:
   ExprFixedArray equal_join_conds_;
   ExprFixedArray all_join_keys_;
   common::ObHashFuncs all_hash_funcs_;
+  // build runtime join filter for the probe side table scan (in another DFO)
   bool has_join_bf_;
+  int64_t join_filter_bit_cnt_;
+  // build the hash table with other tasks of SQC, see ObHashJoinSharedTableInfo
+  bool is_shared_ht_;
 };
 
 // hash join has no expression result overwrite problem:
@@ -80,10 +169,12 @@ private:
           nbuckets_(0),
           row_count_(0),
           inited_(false),
-          ht_alloc_(nullptr)
+          ht_alloc_(nullptr),
+          local_buckets_(nullptr)
     {}
     void reset()
     {
+      detach_buckets();
       if (OB_NOT_NULL(buckets_)) {
         buckets_->reset();
       }
@@ -122,6 +213,23 @@ private:
       }
       inited_ = false;
     }
+    // use buckets of another table (shared hash table), the buckets are not reset or freed
+    // by this table.
+    void attach_buckets(void* buckets, const int64_t nbuckets)
+    {
+      if (OB_ISNULL(local_buckets_)) {
+        local_buckets_ = buckets_;
+      }
+      buckets_ = static_cast<BucketArray*>(buckets);
+      nbuckets_ = nbuckets;
+    }
+    void detach_buckets()
+    {
+      if (OB_NOT_NULL(local_buckets_)) {
+        buckets_ = local_buckets_;
+        local_buckets_ = nullptr;
+      }
+    }
     void inc_collision(int64_t bucket_id)
     {
       if (255 > collision_cnts_->at(bucket_id)) {
@@ -168,6 +276,7 @@ private:
     int64_t row_count_;
     bool inited_;
     ModulePageAllocator* ht_alloc_;
+    BucketArray* local_buckets_;  // buckets of this table when attached to another one
   };
 
   struct HistItem {
@@ -367,12 +476,38 @@ private:
     int64_t total_row_count_;
   };
 
+  // Rows of child batch for vectorized hash join. Output rows of hash join are not located
+  // in the same batch index with child rows, datums of child output are saved after batch
+  // fetched and restored to the current batch index row by row.
+  struct ChildBatchRows {
+    ChildBatchRows() : brs_(NULL), datums_(NULL), cur_idx_(0)
+    {}
+    void reset()
+    {
+      brs_ = NULL;
+      cur_idx_ = 0;
+    }
+    TO_STRING_KV(KPC_(brs), KP_(datums), K_(cur_idx));
+
+    const ObBatchRows* brs_;
+    // saved datums: [output expr count][max batch size]
+    common::ObDatum* datums_;
+    int64_t cur_idx_;
+  };
+
 public:
   virtual int inner_open() override;
   virtual int rescan() override;
   virtual int inner_get_next_row() override;
+  virtual int inner_get_next_batch(const int64_t max_row_cnt) override;
   virtual void destroy() override;
   virtual int inner_close() override;
+  virtual int drain_exch() override;
+
+  // Hash value of runtime join filter, equal to the hash value of build rows
+  // when the default murmur hash functions are used.
+  static int calc_join_filter_hash(const common::ObIArray<ObExpr*>& keys,
+      const common::ObIArray<common::ObHashFunc>& hash_funcs, ObEvalCtx& eval_ctx, uint64_t& hash_value);
 
 private:
   void calc_cache_aware_partition_count();
@@ -442,6 +577,8 @@ private:
   int update_remain_data_memory_size_periodically(int64_t row_count, bool& need_dump);
   int dump_build_table(int64_t row_count);
   int split_partition(int64_t& num_left_rows);
+  int add_join_filter_row(const uint64_t hash_value);
+  int publish_join_filter();
   int prepare_hash_table();
   void trace_hash_table_collision(int64_t row_cnt);
   int build_hash_table_for_recursive();
@@ -480,6 +617,12 @@ private:
   int get_match_row(bool& is_matched);
   int get_next_right_row_for_batch(NextFunc next_func);
 
+  int init_child_batch_rows(const ObOperator& child, ChildBatchRows& rows);
+  int get_next_child_batch_row(ObOperator& child, ChildBatchRows& rows);
+  // output datums of previous batch row are inherited, since they are not refilled
+  // for every row (e.g.: right row is filled once for all matched left rows).
+  void inherit_prev_batch_row(const ExprFixedArray& exprs, const int64_t batch_idx);
+
 private:
   OB_INLINE int64_t get_part_idx(const uint64_t hash_value)
   {
@@ -585,6 +728,16 @@ private:
       bool is_build_side);
   int get_next_probe_partition();
 
+  bool is_shared_ht() const
+  {
+    return nullptr != shared_info_;
+  }
+  template <typename COND>
+  int wait_shared_hash_table(COND cond);
+  int sync_shared_hash_table(const ObHashJoinSharedTableInfo::SyncStep step);
+  int build_shared_hash_table();
+  void close_shared_hash_table();
+
 private:
   typedef int (ObHashJoinOp::*ReadFunc)();
   typedef int (ObHashJoinOp::*state_function_func_type)();
@@ -625,6 +778,8 @@ private:
   // about 120M
   static const int64_t MAX_NEST_LOOP_RIGHT_ROW_COUNT = 1000000000;
   static bool TEST_NEST_LOOP_TO_RECURSIVE;
+  // sleep interval of waiting tasks sharing hash table
+  static const int64_t SHARED_HT_WAIT_INTERVAL_US = 1000;
 
   // make PART_COUNT and MAX_PAGE_COUNT configurable by unittest
   static int64_t PART_COUNT;
@@ -671,6 +826,9 @@ private:
   common::ObIAllocator* alloc_;  // for buckets
   ModulePageAllocator* bloom_filter_alloc_;
   ObGbyBloomFilter* bloom_filter_;
+  // runtime join filter of build rows, published once (not rebuild in rescan).
+  ObPxBloomFilter join_filter_;
+  bool join_filter_published_;
   common::ObBitSet<common::OB_DEFAULT_BITSET_SIZE, common::ModulePageAllocator, true> right_bit_set_;
   int64_t nth_right_row_;
   int64_t ltb_size_;
@@ -709,12 +867,19 @@ private:
   HashJoinHistogram* cur_right_hist_;
   int64_t cur_probe_row_idx_;
   int64_t max_right_bucket_idx_;
+  ChildBatchRows left_brs_;
+  ChildBatchRows right_brs_;
 
   // statistics
   int64_t probe_cnt_;
   int64_t bitset_filter_cnt_;
   int64_t hash_link_cnt_;
   int64_t hash_equal_cnt_;
+
+  // shared hash table of SQC, NULL if hash table is not shared
+  ObHashJoinSharedTableInfo* shared_info_;
+  // the next step to sync with the other tasks
+  int64_t sync_step_;
 };
 
 inline int ObHashJoinOp::init_mem_context(uint64_t tenant_id)
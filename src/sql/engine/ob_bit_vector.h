@@ -0,0 +1,139 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_ENGINE_OB_BIT_VECTOR_H_
+#define OCEANBASE_ENGINE_OB_BIT_VECTOR_H_
+
+#include <limits.h>
+#include "lib/ob_define.h"
+#include "lib/alloc/alloc_assist.h"
+
+namespace oceanbase {
+namespace sql {
+
+// Bit vector overlaid on raw memory, has no member except the data. Used as skip bitmap
+// of batch rows and per row evaluated flags of batch expression result.
+//
+// Memory of bit vector is allocated by caller, with the size of memory_size(), e.g.:
+//
+//   void* mem = alloc.alloc(ObBitVector::memory_size(batch_size));
+//   ObBitVector* skip = to_bit_vector(mem);
+//   skip->reset(batch_size);
+//
+struct ObBitVector {
+  typedef uint64_t WordType;
+  const static int64_t WORD_BITS = sizeof(WordType) * CHAR_BIT;
+
+  static int64_t word_count(const int64_t size)
+  {
+    return (size + WORD_BITS - 1) / WORD_BITS;
+  }
+  static int64_t memory_size(const int64_t size)
+  {
+    return word_count(size) * sizeof(WordType);
+  }
+
+  OB_INLINE bool at(const int64_t idx) const
+  {
+    return data_[idx / WORD_BITS] & (1LU << (idx % WORD_BITS));
+  }
+  OB_INLINE bool contain(const int64_t idx) const
+  {
+    return at(idx);
+  }
+  OB_INLINE void set(const int64_t idx)
+  {
+    data_[idx / WORD_BITS] |= (1LU << (idx % WORD_BITS));
+  }
+  OB_INLINE void unset(const int64_t idx)
+  {
+    data_[idx / WORD_BITS] &= ~(1LU << (idx % WORD_BITS));
+  }
+
+  void reset(const int64_t size)
+  {
+    MEMSET(data_, 0, memory_size(size));
+  }
+  void set_all(const int64_t size)
+  {
+    MEMSET(data_, 0xFF, memory_size(size));
+  }
+  void deep_copy(const ObBitVector& src, const int64_t size)
+  {
+    MEMCPY(data_, src.data_, memory_size(size));
+  }
+  // bit or with %src
+  void bit_or(const ObBitVector& src, const int64_t size)
+  {
+    for (int64_t i = 0; i < word_count(size); i++) {
+      data_[i] |= src.data_[i];
+    }
+  }
+  // assign with bit not of %src, bits beyond %size of the last word are cleared.
+  void bit_not(const ObBitVector& src, const int64_t size)
+  {
+    const int64_t cnt = word_count(size);
+    for (int64_t i = 0; i < cnt; i++) {
+      data_[i] = ~src.data_[i];
+    }
+    if (size % WORD_BITS > 0) {
+      data_[cnt - 1] &= (1LU << (size % WORD_BITS)) - 1;
+    }
+  }
+
+  // all bits in [0, size) are set.
+  bool is_all_true(const int64_t size) const
+  {
+    bool all_true = true;
+    const int64_t full_words = size / WORD_BITS;
+    for (int64_t i = 0; all_true && i < full_words; i++) {
+      all_true = (~data_[i] == 0);
+    }
+    if (all_true && size % WORD_BITS > 0) {
+      const WordType mask = (1LU << (size % WORD_BITS)) - 1;
+      all_true = ((data_[full_words] & mask) == mask);
+    }
+    return all_true;
+  }
+
+  // count of set bits in [0, size)
+  int64_t accumulate_bit_cnt(const int64_t size) const
+  {
+    int64_t cnt = 0;
+    const int64_t full_words = size / WORD_BITS;
+    for (int64_t i = 0; i < full_words; i++) {
+      cnt += __builtin_popcountl(data_[i]);
+    }
+    if (size % WORD_BITS > 0) {
+      const WordType mask = (1LU << (size % WORD_BITS)) - 1;
+      cnt += __builtin_popcountl(data_[full_words] & mask);
+    }
+    return cnt;
+  }
+
+  WordType data_[0];
+};
+
+inline ObBitVector* to_bit_vector(void* mem)
+{
+  return static_cast<ObBitVector*>(mem);
+}
+
+inline const ObBitVector* to_bit_vector(const void* mem)
+{
+  return static_cast<const ObBitVector*>(mem);
+}
+
+}  // end namespace sql
+}  // end namespace oceanbase
+
+#endif  // OCEANBASE_ENGINE_OB_BIT_VECTOR_H_
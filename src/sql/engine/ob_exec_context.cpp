@@ -148,6 +148,7 @@ ObExecContext::ObExecContext(ObIAllocator& allocator)
       sqc_handler_(nullptr),
       frames_(NULL),
       frame_cnt_(0),
+      max_batch_size_(0),
       op_kit_store_(),
       eval_res_mem_(NULL),
       eval_tmp_mem_(NULL),
@@ -209,6 +210,7 @@ ObExecContext::ObExecContext()
       sqc_handler_(nullptr),
       frames_(NULL),
       frame_cnt_(0),
+      max_batch_size_(0),
       eval_res_mem_(NULL),
       eval_tmp_mem_(NULL),
       eval_ctx_(NULL),
@@ -485,6 +487,7 @@ int ObExecContext::init_eval_ctx()
   } else {
     // set frames to eval ctx
     eval_ctx_->frames_ = frames_;
+    eval_ctx_->max_batch_size_ = max_batch_size_;
   }
   return ret;
 }
@@ -591,6 +591,14 @@ public:
   {
     frame_cnt_ = frame_cnt;
   }
+  int64_t get_max_batch_size() const
+  {
+    return max_batch_size_;
+  }
+  void set_max_batch_size(const int64_t max_batch_size)
+  {
+    max_batch_size_ = max_batch_size;
+  }
 
   ObOperatorKit* get_operator_kit(const uint64_t id) const
   {
@@ -784,6 +792,8 @@ protected:
   // data frames and count
   char** frames_;
   uint64_t frame_cnt_;
+  // max batch size of batch result expressions in frames (0 for non vectorized plan)
+  int64_t max_batch_size_;
 
   ObOpKitStore op_kit_store_;
 
@@ -87,14 +87,15 @@ ObOpSpec::ObOpSpec(ObIAllocator& alloc, const ObPhyOperatorType type)
       rows_(0),
       width_(0),
       px_est_size_factor_(),
-      plan_depth_(0)
+      plan_depth_(0),
+      max_batch_size_(0)
 {}
 
 ObOpSpec::~ObOpSpec()
 {}
 
 OB_SERIALIZE_MEMBER(ObOpSpec, id_, output_, startup_filters_, filters_, calc_exprs_, cost_, rows_, width_,
-    px_est_size_factor_, plan_depth_);
+    px_est_size_factor_, plan_depth_, max_batch_size_);
 
 DEF_TO_STRING(ObOpSpec)
 {
@@ -111,7 +112,8 @@ DEF_TO_STRING(ObOpSpec)
       startup_filters_.count(),
       "calc_exprs_cnt",
       calc_exprs_.count(),
-      K_(rows));
+      K_(rows),
+      K_(max_batch_size));
   J_OBJ_END();
   return pos;
 }
@@ -369,7 +371,9 @@ ObOperator::ObOperator(ObExecContext& exec_ctx, const ObOpSpec& spec, ObOpInput*
       opened_(false),
       startup_passed_(spec_.startup_filters_.empty()),
       exch_drained_(false),
-      got_first_row_(false)
+      got_first_row_(false),
+      brs_(),
+      batch_row_idx_(0)
 {}
 
 ObOperator::~ObOperator()
@@ -449,6 +453,8 @@ int ObOperator::open()
       case OPEN_SELF_ONLY: {
         if (OB_FAIL(init_evaluated_flags())) {
           LOG_WARN("init evaluate flags failed", K(ret));
+        } else if (OB_FAIL(init_batch_rows())) {
+          LOG_WARN("init batch rows failed", K(ret));
         } else if (OB_FAIL(inner_open())) {
           if (OB_TRY_LOCK_ROW_CONFLICT != ret && OB_TRANSACTION_SET_VIOLATION != ret) {
             LOG_WARN("Open this operator failed", K(ret), "op_type", op_name());
@@ -488,6 +494,27 @@ int ObOperator::init_evaluated_flags()
   return ret;
 }
 
+int ObOperator::init_batch_rows()
+{
+  int ret = OB_SUCCESS;
+  if (spec_.is_vectorized() && NULL == brs_.skip_) {
+    void* mem = ctx_.get_allocator().alloc(ObBitVector::memory_size(spec_.max_batch_size_));
+    if (OB_ISNULL(mem)) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("allocate memory failed", K(ret));
+    } else {
+      brs_.skip_ = to_bit_vector(mem);
+      brs_.skip_->reset(spec_.max_batch_size_);
+      // max batch size of expression frame is not serialized with remote plan,
+      // make sure the evaluated flags of batch cover the operator's batch.
+      if (eval_ctx_.max_batch_size_ < spec_.max_batch_size_) {
+        eval_ctx_.max_batch_size_ = spec_.max_batch_size_;
+      }
+    }
+  }
+  return ret;
+}
+
 // copy from ob_phy_operator.cpp
 int ObOperator::rescan()
 {
@@ -499,6 +526,9 @@ int ObOperator::rescan()
   int ret = OB_SUCCESS;
 
   startup_passed_ = spec_.startup_filters_.empty();
+  brs_.size_ = 0;
+  brs_.end_ = false;
+  batch_row_idx_ = 0;
 
   for (int64_t i = 0; OB_SUCC(ret) && i < child_cnt_; ++i) {
     if (OB_FAIL(children_[i]->rescan())) {
@@ -580,6 +610,14 @@ int ObOperator::close()
 int ObOperator::get_next_row()
 {
   int ret = OB_SUCCESS;
+  if (spec_.is_vectorized()) {
+    if (OB_FAIL(get_next_row_from_batch())) {
+      if (OB_ITER_END != ret) {
+        LOG_WARN("get next row from batch failed", K(ret), "type", spec_.type_, "op", op_name());
+      }
+    }
+    return ret;
+  }
   if (OB_UNLIKELY(!startup_passed_)) {
     bool filtered = false;
     if (OB_FAIL(startup_filter(filtered))) {
@@ -632,6 +670,185 @@ int ObOperator::get_next_row()
   return ret;
 }
 
+// Return rows of batch one by one, the current row is located by ObEvalCtx::batch_idx_.
+int ObOperator::get_next_row_from_batch()
+{
+  int ret = OB_SUCCESS;
+  bool got_row = false;
+  while (OB_SUCC(ret) && !got_row) {
+    if (batch_row_idx_ < brs_.size_) {
+      if (!brs_.skip_->at(batch_row_idx_)) {
+        eval_ctx_.set_batch_idx(batch_row_idx_);
+        got_row = true;
+      }
+      batch_row_idx_++;
+    } else if (brs_.end_) {
+      ret = OB_ITER_END;
+    } else {
+      const ObBatchRows* brs = NULL;
+      batch_row_idx_ = 0;
+      if (OB_FAIL(get_next_batch(spec_.max_batch_size_, brs))) {
+        LOG_WARN("get next batch failed", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObOperator::get_next_batch(const int64_t max_row_cnt, const ObBatchRows*& batch_rows)
+{
+  int ret = OB_SUCCESS;
+  batch_rows = &brs_;
+  if (!spec_.is_vectorized()) {
+    // return one row batch for non vectorized operator.
+    if (NULL == brs_.skip_) {
+      void* mem = ctx_.get_allocator().alloc(ObBitVector::memory_size(1));
+      if (OB_ISNULL(mem)) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("allocate memory failed", K(ret));
+      } else {
+        brs_.skip_ = to_bit_vector(mem);
+      }
+    }
+    if (OB_SUCC(ret)) {
+      brs_.skip_->reset(1);
+      brs_.size_ = 1;
+      if (OB_FAIL(get_next_row())) {
+        if (OB_ITER_END == ret) {
+          ret = OB_SUCCESS;
+          brs_.size_ = 0;
+          brs_.end_ = true;
+        } else {
+          LOG_WARN("get next row failed", K(ret));
+        }
+      }
+    }
+  } else {
+    brs_.size_ = 0;
+    if (OB_UNLIKELY(!startup_passed_) && !brs_.end_) {
+      bool filtered = false;
+      if (OB_FAIL(startup_filter(filtered))) {
+        LOG_WARN("do startup filter failed", K(ret), "op", op_name());
+      } else if (filtered) {
+        brs_.end_ = true;
+      } else {
+        startup_passed_ = true;
+      }
+    }
+    if (OB_SUCC(ret) && !brs_.end_) {
+      clear_evaluated_flag();
+      brs_.skip_->reset(spec_.max_batch_size_);
+      if (OB_FAIL(inner_get_next_batch(std::min(max_row_cnt, spec_.max_batch_size_)))) {
+        LOG_WARN("inner get next batch failed", K(ret), "type", spec_.type_, "op", op_name());
+      } else if (brs_.size_ > 0 && !spec_.filters_.empty()) {
+        if (OB_FAIL(filter_batch_rows(spec_.filters_, *brs_.skip_, brs_.size_))) {
+          LOG_WARN("filter batch rows failed", K(ret), "type", spec_.type_, "op", op_name());
+        }
+      }
+    }
+    if (OB_SUCC(ret)) {
+      const int64_t row_cnt = brs_.size_ - brs_.skip_->accumulate_bit_cnt(brs_.size_);
+      op_monitor_info_.output_row_count_ += row_cnt;
+      if (row_cnt > 0 && !got_first_row_) {
+        op_monitor_info_.first_row_time_ = oceanbase::common::ObClockGenerator::getClock();
+        got_first_row_ = true;
+      }
+      if (brs_.end_) {
+        int tmp_ret = drain_exch();
+        if (OB_SUCCESS != tmp_ret) {
+          LOG_WARN("drain exchange data failed", K(tmp_ret));
+        }
+        if (got_first_row_) {
+          op_monitor_info_.last_row_time_ = oceanbase::common::ObClockGenerator::getClock();
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObOperator::filter_batch_rows(const common::ObIArray<ObExpr*>& exprs, ObBitVector& skip, const int64_t size)
+{
+  int ret = OB_SUCCESS;
+  FOREACH_CNT_X(e, exprs, OB_SUCC(ret))
+  {
+    OB_ASSERT(NULL != *e);
+    if (OB_FAIL((*e)->eval_batch(eval_ctx_, skip, size))) {
+      LOG_WARN("expr evaluate failed", K(ret), "expr", *e);
+    } else {
+      OB_ASSERT(ob_is_int_tc((*e)->datum_meta_.type_));
+      const ObDatum* datums = (*e)->locate_batch_datums(eval_ctx_);
+      const bool batch_result = (*e)->batch_result_;
+      for (int64_t i = 0; i < size; i++) {
+        if (!skip.at(i)) {
+          const ObDatum& datum = datums[batch_result ? i : 0];
+          if (datum.null_ || 0 == *datum.int_) {
+            skip.set(i);
+          }
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObOperator::deep_copy_batch_row(const common::ObIArray<ObExpr*>& exprs)
+{
+  int ret = OB_SUCCESS;
+  ObDatum* datum = NULL;
+  FOREACH_CNT_X(e, exprs, OB_SUCC(ret))
+  {
+    if ((*e)->batch_result_) {
+      if (OB_FAIL((*e)->eval(eval_ctx_, datum))) {
+        LOG_WARN("expr evaluate failed", K(ret), "expr", *e);
+      } else if (!datum->null_ && datum->ptr_ != (*e)->get_res_buf(eval_ctx_)) {
+        char* buf = (*e)->get_str_res_mem(eval_ctx_, datum->len_);
+        if (OB_ISNULL(buf)) {
+          ret = OB_ALLOCATE_MEMORY_FAILED;
+          LOG_WARN("allocate memory failed", K(ret), K(datum->len_));
+        } else {
+          MEMMOVE(buf, datum->ptr_, datum->len_);
+          datum->ptr_ = buf;
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObOperator::fill_batch_by_row(const int64_t max_row_cnt)
+{
+  int ret = OB_SUCCESS;
+  ObEvalCtx::BatchInfoScopeGuard batch_info_guard(eval_ctx_);
+  for (int64_t i = 0; OB_SUCC(ret) && i < max_row_cnt; i++) {
+    batch_info_guard.set_batch_idx(i);
+    if (OB_FAIL(inner_get_next_row())) {
+      if (OB_ITER_END != ret) {
+        LOG_WARN("get next row failed", K(ret));
+      }
+    } else if (OB_FAIL(deep_copy_batch_row(spec_.output_))) {
+      LOG_WARN("deep copy batch row failed", K(ret));
+    } else {
+      brs_.size_ = i + 1;
+    }
+  }
+  if (OB_ITER_END == ret) {
+    ret = OB_SUCCESS;
+    brs_.end_ = true;
+  }
+  if (OB_SUCC(ret)) {
+    // all rows of output are evaluated and copied, avoid re-evaluation in parent
+    // (evaluated flags may be cleared by the following rows of batch).
+    FOREACH_CNT(e, spec_.output_)
+    {
+      if ((*e)->batch_result_) {
+        (*e)->get_eval_info(eval_ctx_).evaluated_ = true;
+      }
+    }
+  }
+  return ret;
+}
+
 int ObOperator::filter(const common::ObIArray<ObExpr*>& exprs, bool& filtered)
 {
   ObDatum* datum = NULL;
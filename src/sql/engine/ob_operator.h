@@ -61,6 +61,21 @@ public:
   TO_STRING_KV(K_(param_idx), K_(src), K_(dst));
 };
 
+// Rows of batch returned by ObOperator::get_next_batch().
+// Row %i of batch is skipped if skip_->at(i) is true (filtered or not exist).
+struct ObBatchRows {
+  ObBatchRows() : skip_(NULL), size_(0), end_(false)
+  {}
+
+  TO_STRING_KV(KP_(skip), K_(size), K_(end));
+
+  ObBitVector* skip_;
+  // row count of batch (including skipped rows)
+  int64_t size_;
+  // no more rows after this batch
+  bool end_;
+};
+
 class ObOpSpecVisitor;
 // Physical operator specification, immutable in execution.
 // (same with the old ObPhyOperator)
@@ -191,6 +206,11 @@ public:
   {
     return plan_depth_;
   }
+  // Operator is executed in batch (get_next_batch() implemented).
+  bool is_vectorized() const
+  {
+    return max_batch_size_ > 0;
+  }
 
   // find all specs of the DFO (stop when reach receive)
   template <typename T, typename FILTER>
@@ -248,6 +268,8 @@ public:
   int64_t width_;
   PxOpSizeFactor px_est_size_factor_;
   int64_t plan_depth_;
+  // max row count of batch, 0 for non vectorized operator.
+  int64_t max_batch_size_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(ObOpSpec);
@@ -308,6 +330,19 @@ public:
   virtual int get_next_row();
   virtual int inner_get_next_row() = 0;
 
+  // fetch next batch rows, at most %max_row_cnt rows returned.
+  // rows are located by ObEvalCtx::batch_idx_ of output expressions.
+  //
+  // Never return OB_ITER_END, check ObBatchRows::end_ instead. Operator not vectorized
+  // returns one row batch (by get_next_row()).
+  int get_next_batch(const int64_t max_row_cnt, const ObBatchRows*& batch_rows);
+  // Fill brs_ with at most %max_row_cnt rows, skip bitmap is reset before called.
+  virtual int inner_get_next_batch(const int64_t max_row_cnt)
+  {
+    UNUSED(max_row_cnt);
+    return common::OB_NOT_IMPLEMENT;
+  }
+
   // close operator, cascading close child operators
   virtual int close();
   // close operator, not including child operators.
@@ -377,6 +412,9 @@ public:
 
 protected:
   int init_evaluated_flags();
+  // allocate skip bitmap of batch rows for vectorized operator
+  int init_batch_rows();
+  int get_next_row_from_batch();
   // Execute filter
   // Calc buffer does not reset internally, you need to reset it appropriately.
   int filter(const common::ObIArray<ObExpr*>& exprs, bool& filtered);
@@ -389,6 +427,14 @@ protected:
   {
     return filter(spec_.filters_, filtered);
   }
+  // Execute filter of batch, set skip bit of filtered rows.
+  int filter_batch_rows(const common::ObIArray<ObExpr*>& exprs, ObBitVector& skip, const int64_t size);
+
+  // Deep copy datums of %exprs to reserved buffer of current batch row, for rows which
+  // memory is owned by operator and may be overwritten in next row (e.g.: sorted rows).
+  int deep_copy_batch_row(const common::ObIArray<ObExpr*>& exprs);
+  // Fill batch by inner_get_next_row() row by row, with output deep copied.
+  int fill_batch_by_row(const int64_t max_row_cnt);
 
   // try open operator
   int try_open()
@@ -426,6 +472,10 @@ protected:
   bool got_first_row_;
   // gv$sql_plan_monitor
   ObMonitorNode op_monitor_info_;
+  // batch rows of vectorized operator
+  ObBatchRows brs_;
+  // next row of brs_ to return in get_next_row() of vectorized operator
+  int64_t batch_row_idx_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(ObOperator);
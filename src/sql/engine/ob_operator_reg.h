@@ -341,7 +341,8 @@ REGISTER_OPERATOR(ObLogJoin, PHY_NESTED_LOOP_CONNECT_BY, ObNLConnectBySpec, ObNL
 class ObLogJoin;
 class ObHashJoinSpec;
 class ObHashJoinOp;
-REGISTER_OPERATOR(ObLogJoin, PHY_HASH_JOIN, ObHashJoinSpec, ObHashJoinOp);
+class ObHashJoinInput;
+REGISTER_OPERATOR(ObLogJoin, PHY_HASH_JOIN, ObHashJoinSpec, ObHashJoinOp, ObHashJoinInput);
 
 class ObNestedLoopJoinSpec;
 class ObNestedLoopJoinOp;
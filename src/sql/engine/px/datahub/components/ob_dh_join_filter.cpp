@@ -0,0 +1,172 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+#include "sql/engine/px/datahub/components/ob_dh_join_filter.h"
+#include "sql/engine/px/ob_dfo.h"
+#include "sql/engine/ob_exec_context.h"
+
+using namespace oceanbase::sql;
+using namespace oceanbase::common;
+
+OB_DEF_SERIALIZE(ObJoinFilterPieceMsg)
+{
+  int ret = OB_SUCCESS;
+  ret = ObDatahubPieceMsg::serialize(buf, buf_len, pos);
+  if (OB_SUCC(ret)) {
+    LST_DO_CODE(OB_UNIS_ENCODE, is_request_, sqc_id_);
+    if (!is_request_) {
+      LST_DO_CODE(OB_UNIS_ENCODE, filter_);
+    }
+  }
+  return ret;
+}
+
+OB_DEF_DESERIALIZE(ObJoinFilterPieceMsg)
+{
+  int ret = OB_SUCCESS;
+  ret = ObDatahubPieceMsg::deserialize(buf, data_len, pos);
+  if (OB_SUCC(ret)) {
+    LST_DO_CODE(OB_UNIS_DECODE, is_request_, sqc_id_);
+    if (!is_request_) {
+      LST_DO_CODE(OB_UNIS_DECODE, filter_);
+    }
+  }
+  return ret;
+}
+
+OB_DEF_SERIALIZE_SIZE(ObJoinFilterPieceMsg)
+{
+  int64_t len = 0;
+  len += ObDatahubPieceMsg::get_serialize_size();
+  LST_DO_CODE(OB_UNIS_ADD_LEN, is_request_, sqc_id_);
+  if (!is_request_) {
+    LST_DO_CODE(OB_UNIS_ADD_LEN, filter_);
+  }
+  return len;
+}
+
+OB_SERIALIZE_MEMBER((ObJoinFilterWholeMsg, ObDatahubWholeMsg), filter_);
+
+int ObJoinFilterWholeMsg::assign(const ObJoinFilterWholeMsg& other)
+{
+  int ret = OB_SUCCESS;
+  op_id_ = other.op_id_;
+  if (OB_FAIL(filter_.assign(other.filter_, assign_allocator_))) {
+    LOG_WARN("assign bloom filter failed", K(ret));
+  }
+  return ret;
+}
+
+int ObJoinFilterPieceMsgListener::on_message(
+    ObJoinFilterPieceMsgCtx& ctx, common::ObIArray<ObPxSqcMeta*>& sqcs, const ObJoinFilterPieceMsg& pkt)
+{
+  int ret = OB_SUCCESS;
+  if (pkt.op_id_ != ctx.op_id_) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected piece msg", K(pkt), K(ctx));
+  } else if (pkt.is_request_) {
+    // request from probe side, %sqcs are SQCs of the probe side DFO.
+    ObPxSqcMeta* sqc = NULL;
+    for (int64_t i = 0; NULL == sqc && i < sqcs.count(); i++) {
+      if (OB_NOT_NULL(sqcs.at(i)) && sqcs.at(i)->get_sqc_id() == pkt.sqc_id_) {
+        sqc = sqcs.at(i);
+      }
+    }
+    if (OB_ISNULL(sqc)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("requester sqc not found", K(ret), K(pkt));
+    } else if (has_exist_in_array(ctx.requesters_, sqc)) {
+      // already requested by other task of the same SQC
+    } else if (OB_FAIL(ctx.requesters_.push_back(sqc))) {
+      LOG_WARN("array push back failed", K(ret));
+    } else if (ctx.is_ready() && OB_FAIL(send_whole_msg(ctx, *sqc))) {
+      LOG_WARN("send join filter whole msg failed", K(ret));
+    }
+  } else {
+    // build piece, %sqcs are SQCs of the hash join DFO.
+    if (0 == ctx.task_cnt_) {
+      ARRAY_FOREACH_X(sqcs, idx, cnt, OB_SUCC(ret))
+      {
+        ctx.task_cnt_ += sqcs.at(idx)->get_task_count();
+      }
+    }
+    if (OB_FAIL(ret)) {
+    } else if (ctx.received_ >= ctx.task_cnt_) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("should not receive any more pkt. already get all pkt expected", K(pkt), K(ctx));
+    } else if (!ctx.whole_msg_.filter_.is_inited() &&
+               OB_FAIL(ctx.whole_msg_.filter_.init(pkt.filter_.get_bit_cnt(), ctx.allocator_))) {
+      LOG_WARN("init bloom filter failed", K(ret), K(pkt));
+    } else if (OB_FAIL(ctx.whole_msg_.filter_.merge(pkt.filter_))) {
+      LOG_WARN("merge bloom filter failed", K(ret), K(pkt));
+    } else {
+      ctx.received_++;
+      LOG_TRACE("got a join filter piece msg", "all_got", ctx.received_, "expected", ctx.task_cnt_);
+    }
+    // all piece received, send whole to SQCs requested.
+    if (OB_SUCC(ret) && ctx.is_ready()) {
+      ctx.whole_msg_.op_id_ = ctx.op_id_;
+      ARRAY_FOREACH_X(ctx.requesters_, idx, cnt, OB_SUCC(ret))
+      {
+        if (OB_FAIL(send_whole_msg(ctx, *ctx.requesters_.at(idx)))) {
+          LOG_WARN("send join filter whole msg failed", K(ret));
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObJoinFilterPieceMsgListener::send_whole_msg(ObJoinFilterPieceMsgCtx& ctx, ObPxSqcMeta& sqc)
+{
+  int ret = OB_SUCCESS;
+  dtl::ObDtlChannel* ch = sqc.get_qc_channel();
+  if (OB_ISNULL(ch)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("null expected", K(ret));
+  } else if (OB_FAIL(ch->send(ctx.whole_msg_, ctx.timeout_ts_))) {
+    LOG_WARN("fail push data to channel", K(ret));
+  } else if (OB_FAIL(ch->flush(true, false))) {
+    LOG_WARN("fail flush dtl data", K(ret));
+  } else {
+    LOG_TRACE("dispatched join filter whole msg", K(ctx), K(sqc.get_sqc_id()));
+  }
+  if (OB_FAIL(ret)) {
+    // join filter is only an optimization, the requester SQC may finished already.
+    LOG_TRACE("send join filter failed, ignore", K(ret), K(sqc.get_sqc_id()));
+    ret = OB_SUCCESS;
+  }
+  return ret;
+}
+
+int ObJoinFilterPieceMsgCtx::alloc_piece_msg_ctx(
+    const ObJoinFilterPieceMsg& pkt, ObExecContext& ctx, int64_t task_cnt, ObPieceMsgCtx*& msg_ctx)
+{
+  int ret = OB_SUCCESS;
+  // The first piece may be request from probe side, %task_cnt is task count of the DFO of
+  // the first piece, can not be used. Task count is set when the first build piece received.
+  UNUSED(task_cnt);
+  if (OB_ISNULL(ctx.get_physical_plan_ctx())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("physical plan ctx is null", K(ret));
+  } else {
+    void* buf = ctx.get_allocator().alloc(sizeof(ObJoinFilterPieceMsgCtx));
+    if (OB_ISNULL(buf)) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+    } else {
+      msg_ctx = new (buf) ObJoinFilterPieceMsgCtx(
+          pkt.op_id_, ctx.get_physical_plan_ctx()->get_timeout_timestamp(), ctx.get_allocator());
+    }
+  }
+  return ret;
+}
@@ -0,0 +1,136 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef __OB_SQL_ENG_PX_DH_JOIN_FILTER_H__
+#define __OB_SQL_ENG_PX_DH_JOIN_FILTER_H__
+
+#include "sql/engine/px/datahub/ob_dh_msg.h"
+#include "sql/engine/px/datahub/ob_dh_dtl_proc.h"
+#include "sql/engine/px/datahub/ob_dh_msg_ctx.h"
+#include "sql/engine/px/datahub/ob_dh_msg_provider.h"
+#include "sql/engine/px/ob_px_bloom_filter.h"
+
+namespace oceanbase {
+namespace sql {
+
+// Runtime join filter:
+//
+// Each hash join task sends the bloom filter of its build rows to QC (build piece),
+// QC merges all the build pieces of the join. The probe side table scan tasks (in another DFO)
+// send a request piece to QC, QC sends the merged filter to the SQC of the requester
+// after all build pieces received. The probe side never waits for the filter, rows are not
+// filtered until the filter arrived.
+//
+// op_id_ of the messages is the id of the hash join operator.
+
+class ObJoinFilterPieceMsg;
+class ObJoinFilterWholeMsg;
+typedef ObPieceMsgP<ObJoinFilterPieceMsg> ObJoinFilterPieceMsgP;
+typedef ObWholeMsgP<ObJoinFilterWholeMsg> ObJoinFilterWholeMsgP;
+class ObJoinFilterPieceMsgListener;
+class ObJoinFilterPieceMsgCtx;
+
+class ObJoinFilterPieceMsg : public ObDatahubPieceMsg<dtl::ObDtlMsgType::DH_JOIN_FILTER_PIECE_MSG> {
+  OB_UNIS_VERSION_V(1);
+
+public:
+  using PieceMsgListener = ObJoinFilterPieceMsgListener;
+  using PieceMsgCtx = ObJoinFilterPieceMsgCtx;
+
+public:
+  ObJoinFilterPieceMsg() : is_request_(false), sqc_id_(common::OB_INVALID_ID), deseria_allocator_(), filter_()
+  {
+    filter_.set_allocator(&deseria_allocator_);
+  }
+  ~ObJoinFilterPieceMsg() = default;
+  void reset()
+  {
+    filter_.reset();
+  }
+  INHERIT_TO_STRING_KV("meta", ObDatahubPieceMsg<dtl::ObDtlMsgType::DH_JOIN_FILTER_PIECE_MSG>, K_(op_id),
+      K_(is_request), K_(sqc_id), K_(filter));
+
+public:
+  bool is_request_;  // request from probe side, %filter_ is empty.
+  int64_t sqc_id_;   // sqc id of requester
+  // declared before %filter_, filter memory is freed by filter's destructor
+  common::ObArenaAllocator deseria_allocator_;
+  ObPxBloomFilter filter_;
+  DISALLOW_COPY_AND_ASSIGN(ObJoinFilterPieceMsg);
+};
+
+class ObJoinFilterWholeMsg : public ObDatahubWholeMsg<dtl::ObDtlMsgType::DH_JOIN_FILTER_WHOLE_MSG> {
+  OB_UNIS_VERSION_V(1);
+
+public:
+  using WholeMsgProvider = ObWholeMsgProvider<ObJoinFilterWholeMsg>;
+
+public:
+  ObJoinFilterWholeMsg() : assign_allocator_(), filter_()
+  {
+    filter_.set_allocator(&assign_allocator_);
+  }
+  ~ObJoinFilterWholeMsg() = default;
+  int assign(const ObJoinFilterWholeMsg& other);
+  void reset()
+  {
+    filter_.reset();
+    assign_allocator_.reset();
+  }
+  VIRTUAL_TO_STRING_KV(K_(op_id), K_(filter));
+  common::ObArenaAllocator assign_allocator_;
+  ObPxBloomFilter filter_;
+};
+
+class ObJoinFilterPieceMsgCtx : public ObPieceMsgCtx {
+public:
+  ObJoinFilterPieceMsgCtx(uint64_t op_id, int64_t timeout_ts, common::ObIAllocator& allocator)
+      : ObPieceMsgCtx(op_id, 0, timeout_ts),
+        received_(0),
+        allocator_(allocator),
+        requesters_(common::OB_MALLOC_NORMAL_BLOCK_SIZE, common::ModulePageAllocator(allocator)),
+        whole_msg_()
+  {}
+  ~ObJoinFilterPieceMsgCtx() = default;
+  bool is_ready() const
+  {
+    return task_cnt_ > 0 && received_ >= task_cnt_;
+  }
+  INHERIT_TO_STRING_KV("meta", ObPieceMsgCtx, K_(received), "requester_cnt", requesters_.count());
+  static int alloc_piece_msg_ctx(
+      const ObJoinFilterPieceMsg& pkt, ObExecContext& ctx, int64_t task_cnt, ObPieceMsgCtx*& msg_ctx);
+  int64_t received_;  // build pieces received
+  common::ObIAllocator& allocator_;
+  // SQCs of the probe side, the filter is sent once to each SQC.
+  common::ObSEArray<ObPxSqcMeta*, 8, common::ModulePageAllocator, true> requesters_;
+  ObJoinFilterWholeMsg whole_msg_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObJoinFilterPieceMsgCtx);
+};
+
+class ObJoinFilterPieceMsgListener {
+public:
+  ObJoinFilterPieceMsgListener() = default;
+  ~ObJoinFilterPieceMsgListener() = default;
+  static int on_message(
+      ObJoinFilterPieceMsgCtx& ctx, common::ObIArray<ObPxSqcMeta*>& sqcs, const ObJoinFilterPieceMsg& pkt);
+
+private:
+  static int send_whole_msg(ObJoinFilterPieceMsgCtx& ctx, ObPxSqcMeta& sqc);
+  DISALLOW_COPY_AND_ASSIGN(ObJoinFilterPieceMsgListener);
+};
+
+}  // namespace sql
+}  // namespace oceanbase
+#endif /* __OB_SQL_ENG_PX_DH_JOIN_FILTER_H__ */
+//// end of header file
@@ -0,0 +1,144 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+
+#include "sql/engine/px/ob_px_bloom_filter.h"
+#include "lib/utility/utility.h"
+
+namespace oceanbase {
+namespace sql {
+using namespace common;
+
+int ObPxBloomFilter::init(const int64_t bit_cnt, ObIAllocator& allocator)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(bit_cnt < WORD_BITS || 0 != (bit_cnt & (bit_cnt - 1)))) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("bit count must be power of 2 and not less than word bits", K(ret), K(bit_cnt));
+  } else {
+    reset();
+    allocator_ = &allocator;
+    if (OB_ISNULL(bits_ = static_cast<uint64_t*>(allocator.alloc(bit_cnt / CHAR_BIT)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("allocate memory failed", K(ret), K(bit_cnt));
+    } else {
+      bit_cnt_ = bit_cnt;
+      MEMSET(bits_, 0, bit_cnt / CHAR_BIT);
+    }
+  }
+  return ret;
+}
+
+void ObPxBloomFilter::reset()
+{
+  if (NULL != bits_ && NULL != allocator_) {
+    allocator_->free(bits_);
+  }
+  bits_ = NULL;
+  bit_cnt_ = 0;
+}
+
+int ObPxBloomFilter::merge(const ObPxBloomFilter& other)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited() || !other.is_inited() || bit_cnt_ != other.bit_cnt_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("can not merge bloom filter", K(ret), K(*this), K(other));
+  } else {
+    const int64_t cnt = word_cnt();
+    for (int64_t i = 0; i < cnt; i++) {
+      bits_[i] |= other.bits_[i];
+    }
+  }
+  return ret;
+}
+
+int ObPxBloomFilter::assign(const ObPxBloomFilter& other, ObIAllocator& allocator)
+{
+  int ret = OB_SUCCESS;
+  if (!other.is_inited()) {
+    reset();
+  } else if (OB_FAIL(init(other.bit_cnt_, allocator))) {
+    LOG_WARN("init bloom filter failed", K(ret), K(other));
+  } else {
+    MEMCPY(bits_, other.bits_, bit_cnt_ / CHAR_BIT);
+  }
+  return ret;
+}
+
+int64_t ObPxBloomFilter::calc_bit_cnt(const int64_t row_cnt)
+{
+  int64_t bit_cnt = MIN_BIT_CNT;
+  if (row_cnt > MIN_BIT_CNT / BITS_PER_KEY) {
+    bit_cnt = std::min(next_pow2(row_cnt * BITS_PER_KEY), MAX_BIT_CNT);
+  }
+  return bit_cnt;
+}
+
+OB_DEF_SERIALIZE(ObPxBloomFilter)
+{
+  int ret = OB_SUCCESS;
+  OB_UNIS_ENCODE(bit_cnt_);
+  if (OB_SUCC(ret) && bit_cnt_ > 0) {
+    const int64_t size = bit_cnt_ / CHAR_BIT;
+    if (buf_len - pos < size) {
+      ret = OB_SIZE_OVERFLOW;
+      LOG_WARN("buffer not enough", K(ret), K(buf_len), K(pos), K(size));
+    } else {
+      MEMCPY(buf + pos, bits_, size);
+      pos += size;
+    }
+  }
+  return ret;
+}
+
+OB_DEF_DESERIALIZE(ObPxBloomFilter)
+{
+  int ret = OB_SUCCESS;
+  int64_t bit_cnt = 0;
+  OB_UNIS_DECODE(bit_cnt);
+  if (OB_FAIL(ret)) {
+  } else if (bit_cnt <= 0) {
+    reset();
+  } else {
+    // Reuse the bits memory if bit count not changed, the object may be reused to
+    // deserialize messages of the same filter (e.g.: packet of dtl processor).
+    const int64_t size = bit_cnt / CHAR_BIT;
+    if (OB_ISNULL(allocator_)) {
+      ret = OB_NOT_INIT;
+      LOG_WARN("allocator not set", K(ret));
+    } else if (data_len - pos < size) {
+      ret = OB_DESERIALIZE_ERROR;
+      LOG_WARN("data not enough", K(ret), K(data_len), K(pos), K(size));
+    } else if (bit_cnt != bit_cnt_ && OB_FAIL(init(bit_cnt, *allocator_))) {
+      LOG_WARN("init bloom filter failed", K(ret), K(bit_cnt));
+    } else {
+      MEMCPY(bits_, buf + pos, size);
+      pos += size;
+    }
+  }
+  return ret;
+}
+
+OB_DEF_SERIALIZE_SIZE(ObPxBloomFilter)
+{
+  int64_t len = 0;
+  OB_UNIS_ADD_LEN(bit_cnt_);
+  if (bit_cnt_ > 0) {
+    len += bit_cnt_ / CHAR_BIT;
+  }
+  return len;
+}
+
+}  // end namespace sql
+}  // end namespace oceanbase
@@ -0,0 +1,107 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_SQL_ENGINE_PX_OB_PX_BLOOM_FILTER_H_
+#define OCEANBASE_SQL_ENGINE_PX_OB_PX_BLOOM_FILTER_H_
+
+#include "lib/ob_define.h"
+#include "lib/allocator/ob_allocator.h"
+#include "lib/utility/ob_unify_serialize.h"
+#include "lib/utility/ob_print_utils.h"
+
+namespace oceanbase {
+namespace sql {
+
+// Bloom filter of join key hash values, built by hash join tasks and sent to the probe side
+// scan through datahub (runtime join filter). Filters with the same bit count can be merged,
+// the merged filter of all build tasks is a filter of the whole build side.
+//
+// Two bits are set for each hash value: the low and the high 32 bits of the hash value
+// are used as the two independent hash values.
+class ObPxBloomFilter {
+  OB_UNIS_VERSION(1);
+
+public:
+  const static int64_t BITS_PER_KEY = 8;
+  const static int64_t MIN_BIT_CNT = 1L << 13;
+  const static int64_t MAX_BIT_CNT = 1L << 24;
+
+  ObPxBloomFilter() : bits_(NULL), bit_cnt_(0), allocator_(NULL)
+  {}
+  ~ObPxBloomFilter()
+  {
+    reset();
+  }
+
+  // %bit_cnt must be power of 2
+  int init(const int64_t bit_cnt, common::ObIAllocator& allocator);
+  void reset();
+  bool is_inited() const
+  {
+    return NULL != bits_;
+  }
+  // allocator for deserialization
+  void set_allocator(common::ObIAllocator* allocator)
+  {
+    allocator_ = allocator;
+  }
+
+  OB_INLINE void put(const uint64_t hash)
+  {
+    const uint64_t h1 = hash & (bit_cnt_ - 1);
+    const uint64_t h2 = (hash >> 32) & (bit_cnt_ - 1);
+    bits_[h1 / WORD_BITS] |= (1LU << (h1 % WORD_BITS));
+    bits_[h2 / WORD_BITS] |= (1LU << (h2 % WORD_BITS));
+  }
+
+  OB_INLINE bool might_contain(const uint64_t hash) const
+  {
+    const uint64_t h1 = hash & (bit_cnt_ - 1);
+    const uint64_t h2 = (hash >> 32) & (bit_cnt_ - 1);
+    return (bits_[h1 / WORD_BITS] & (1LU << (h1 % WORD_BITS))) && (bits_[h2 / WORD_BITS] & (1LU << (h2 % WORD_BITS)));
+  }
+
+  // bit or with %other, bit count must be the same.
+  int merge(const ObPxBloomFilter& other);
+  // deep copy
+  int assign(const ObPxBloomFilter& other, common::ObIAllocator& allocator);
+
+  int64_t get_bit_cnt() const
+  {
+    return bit_cnt_;
+  }
+
+  // bit count for %row_cnt distinct keys: BITS_PER_KEY bits per key,
+  // rounded up to power of 2 and limited to [MIN_BIT_CNT, MAX_BIT_CNT].
+  static int64_t calc_bit_cnt(const int64_t row_cnt);
+
+  TO_STRING_KV(KP_(bits), K_(bit_cnt));
+
+private:
+  const static int64_t WORD_BITS = 64;
+  int64_t word_cnt() const
+  {
+    return bit_cnt_ / WORD_BITS;
+  }
+
+private:
+  uint64_t* bits_;
+  int64_t bit_cnt_;
+  common::ObIAllocator* allocator_;
+
+  DISALLOW_COPY_AND_ASSIGN(ObPxBloomFilter);
+};
+
+}  // end namespace sql
+}  // end namespace oceanbase
+
+#endif  // OCEANBASE_SQL_ENGINE_PX_OB_PX_BLOOM_FILTER_H_
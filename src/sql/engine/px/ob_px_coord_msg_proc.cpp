@@ -77,3 +77,8 @@ int ObPxSubCoordMsgProc::on_whole_msg(const ObWinbufWholeMsg& pkt) const
   ObDhWholeeMsgProc<ObWinbufWholeMsg> proc;
   return proc.on_whole_msg(sqc_ctx_, pkt);
 }
+int ObPxSubCoordMsgProc::on_whole_msg(const ObJoinFilterWholeMsg& pkt) const
+{
+  ObDhWholeeMsgProc<ObJoinFilterWholeMsg> proc;
+  return proc.on_whole_msg(sqc_ctx_, pkt);
+}
@@ -76,6 +76,7 @@ int ObPxSQCProxy::setup_loop_proc(ObSqcCtx& sqc_ctx) const
         .register_processor(sqc_ctx.transmit_data_ch_msg_proc_)
         .register_processor(sqc_ctx.barrier_whole_msg_proc_)
         .register_processor(sqc_ctx.winbuf_whole_msg_proc_)
+        .register_processor(sqc_ctx.join_filter_whole_msg_proc_)
         .register_interrupt_processor(sqc_ctx.interrupt_proc_);
   }
   return ret;
@@ -437,6 +438,23 @@ bool ObPxSQCProxy::need_receive_channel_map_via_dtl(int64_t child_dfo_id)
   return !via_sqc;
 }
 
+int ObPxSQCProxy::send_dh_piece_msg(const ObDtlMsg& piece, int64_t timeout_ts)
+{
+  int ret = OB_SUCCESS;
+  ObLockGuard<ObSpinLock> lock_guard(dtl_lock_);
+  // TODO: LOCK sqc channel
+  ObDtlChannel* ch = sqc_arg_.sqc_.get_sqc_channel();
+  if (OB_ISNULL(ch)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("empty channel", K(ret));
+  } else if (OB_FAIL(ch->send(piece, timeout_ts))) {
+    LOG_WARN("fail push data to channel", K(ret));
+  } else if (OB_FAIL(ch->flush())) {
+    LOG_WARN("fail flush dtl data", K(ret));
+  }
+  return ret;
+}
+
 int ObPxSQCProxy::get_whole_msg_provider(uint64_t op_id, ObPxDatahubDataProvider*& provider)
 {
   int ret = OB_SUCCESS;
@@ -36,6 +36,7 @@
 #include "sql/engine/basic/ob_temp_table_access.h"
 #include "sql/engine/basic/ob_temp_table_insert_op.h"
 #include "sql/engine/basic/ob_temp_table_access_op.h"
+#include "sql/engine/join/ob_hash_join_op.h"
 #include "sql/engine/px/ob_px_sqc_handler.h"
 #include "sql/executor/ob_task_spliter.h"
 #include "share/ob_rpc_share.h"
@@ -588,6 +589,17 @@ int ObPxSubCoord::setup_op_input(ObExecContext& ctx, ObOpSpec& root, ObSqcCtx& s
         access_input->closed_count_ = reinterpret_cast<uint64_t>(closed_count_ptr);
       }
     }
+  } else if (root.get_type() == PHY_HASH_JOIN && static_cast<ObHashJoinSpec&>(root).is_shared_ht_) {
+    // hash table shared by tasks of this SQC
+    ObPxSqcMeta& sqc = sqc_arg_.sqc_;
+    ObOperatorKit* kit = ctx.get_operator_kit(root.id_);
+    if (OB_ISNULL(kit) || OB_ISNULL(kit->input_)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("operator is NULL", K(ret), KP(kit));
+    } else if (OB_FAIL(static_cast<ObHashJoinInput*>(kit->input_)->init_shared_hj_info(
+                   ctx.get_allocator(), sqc.get_task_count()))) {
+      LOG_WARN("init shared hash join info failed", K(ret));
+    }
   } else if (root.get_type() == PHY_TEMP_TABLE_INSERT) {
     ObPxSqcMeta& sqc = sqc_arg_.sqc_;
     for (int64_t i = 0; OB_SUCC(ret) && i < sqc.get_task_count(); i++) {
@@ -293,6 +293,8 @@ int ObSortOp::inner_get_next_row()
       sort_impl_.set_exec_ctx(&ctx_);
     }
     if (OB_SUCC(ret)) {
+      // child rows are iterated by changing batch index, restore it after sort.
+      ObEvalCtx::BatchInfoScopeGuard batch_info_guard(eval_ctx_);
       if (OB_FAIL(process_sort())) {  // process sort
         if (OB_ITER_END != ret) {
           LOG_WARN("process sort failed", K(ret));
@@ -318,5 +320,12 @@ int ObSortOp::inner_get_next_row()
   return ret;
 }
 
+// Sorted rows are stored in sort memory (or dumped blocks) which may be reused,
+// output datums are deep copied to the reserved buffer of batch row.
+int ObSortOp::inner_get_next_batch(const int64_t max_row_cnt)
+{
+  return fill_batch_by_row(max_row_cnt);
+}
+
 }  // end namespace sql
 }  // end namespace oceanbase
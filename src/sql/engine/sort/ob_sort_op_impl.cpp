@@ -15,11 +15,128 @@
 #include "ob_sort_op_impl.h"
 #include "sql/engine/ob_operator.h"
 #include "sql/engine/ob_tenant_sql_memory_manager.h"
+#include "lib/charset/ob_charset.h"
 
 namespace oceanbase {
 using namespace common;
 namespace sql {
 
+/************************************* start ObSortKeyEncoder *********************************/
+void ObSortKeyEncoder::init(const ObSortFieldCollation& sort_collation, const ObDatumMeta& meta)
+{
+  type_ = KEY_NONE;
+  cs_type_ = sort_collation.cs_type_;
+  is_ascending_ = sort_collation.is_ascending_;
+  null_pos_ = sort_collation.null_pos_;
+  switch (ob_obj_type_class(meta.type_)) {
+    case ObIntTC:
+    case ObDateTimeTC:
+    case ObTimeTC:
+      type_ = KEY_INT;
+      break;
+    case ObDateTC:
+      type_ = KEY_INT32;
+      break;
+    case ObUIntTC:
+      type_ = KEY_UINT;
+      break;
+    case ObYearTC:
+      type_ = KEY_UINT8;
+      break;
+    case ObNumberTC:
+      type_ = KEY_NUMBER;
+      break;
+    case ObStringTC:
+      // Trailing spaces are ignored in comparison (except binary collation) in mysql mode,
+      // the key is padded with spaces, which is not right in oracle mode.
+      if (!lib::is_oracle_mode() && (CS_TYPE_UTF8MB4_GENERAL_CI == cs_type_ || CS_TYPE_UTF8MB4_BIN == cs_type_ ||
+                                        CS_TYPE_BINARY == cs_type_)) {
+        type_ = KEY_STRING;
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+bool ObSortKeyEncoder::encode(const ObDatum& datum, uint64_t& key) const
+{
+  bool encoded = true;
+  const uint64_t SIGN_BIT = 1UL << 63;
+  if (datum.is_null()) {
+    key = NULL_FIRST == null_pos_ ? 0 : UINT64_MAX;
+  } else {
+    switch (type_) {
+      case KEY_INT:
+        key = static_cast<uint64_t>(datum.get_int()) ^ SIGN_BIT;
+        break;
+      case KEY_INT32:
+        key = static_cast<uint64_t>(static_cast<int64_t>(datum.get_date())) ^ SIGN_BIT;
+        break;
+      case KEY_UINT:
+        key = datum.get_uint64();
+        break;
+      case KEY_UINT8:
+        key = datum.get_year();
+        break;
+      case KEY_NUMBER: {
+        // Same order with ObNumber::compare(): sign and exponent byte first, then the digits,
+        // digits of negative number are in reverse order. Digit is less than 10^9 (30 bits),
+        // the first digit and the high 26 bits of the second digit are kept.
+        const uint64_t MANTISSA_MASK = (1UL << 56) - 1;
+        const number::ObNumber::Desc& desc = datum.get_number_desc();
+        const uint32_t* digits = datum.get_number_digits();
+        const uint64_t d0 = desc.len_ > 0 ? digits[0] : 0;
+        const uint64_t d1 = desc.len_ > 1 ? digits[1] : 0;
+        uint64_t mantissa = (d0 << 26) | (d1 >> 4);
+        if (number::ObNumber::NEGATIVE == desc.sign_) {
+          mantissa = ~mantissa & MANTISSA_MASK;
+        }
+        key = (static_cast<uint64_t>(desc.se_) << 56) | mantissa;
+        break;
+      }
+      case KEY_STRING:
+        encoded = encode_string(datum, key);
+        break;
+      default:
+        encoded = false;
+        break;
+    }
+  }
+  if (encoded && !is_ascending_) {
+    key = ~key;
+  }
+  return encoded;
+}
+
+bool ObSortKeyEncoder::encode_string(const ObDatum& datum, uint64_t& key) const
+{
+  bool encoded = true;
+  // Weight of one more character is generated to make sure the leading bytes of the key are
+  // not truncated in the middle of a character.
+  const int64_t KEY_BUF_LEN = sizeof(key) + 4;
+  char buf[KEY_BUF_LEN];
+  int64_t len = 0;
+  if (CS_TYPE_BINARY == cs_type_) {
+    len = MIN(datum.len_, sizeof(key));
+    MEMCPY(buf, datum.ptr_, len);
+  } else if (datum.len_ > 0) {
+    bool is_valid_unicode = true;
+    len = ObCharset::sortkey(cs_type_, datum.ptr_, datum.len_, buf, KEY_BUF_LEN, is_valid_unicode);
+    encoded = is_valid_unicode;
+  }
+  if (encoded) {
+    if (len < static_cast<int64_t>(sizeof(key))) {
+      MEMSET(buf + len, CS_TYPE_BINARY == cs_type_ ? 0 : ' ', sizeof(key) - len);
+    }
+    key = 0;
+    for (int64_t i = 0; i < static_cast<int64_t>(sizeof(key)); i++) {
+      key = (key << 8) | static_cast<uint8_t>(buf[i]);
+    }
+  }
+  return encoded;
+}
+
 /************************************* start ObSortOpImpl *********************************/
 ObSortOpImpl::Compare::Compare() : ret_(OB_SUCCESS), sort_collations_(nullptr), sort_cmp_funs_(nullptr)
 {}
@@ -262,6 +379,7 @@ void ObSortOpImpl::reset()
   sorted_ = false;
   got_first_row_ = false;
   comp_.reset();
+  key_encoder_.reset();
   if (NULL != mem_context_) {
     if (NULL != imms_heap_) {
       imms_heap_->~IMMSHeap();
@@ -432,6 +550,10 @@ int ObSortOpImpl::add_row(const T& exprs, const ObChunkDatumStore::StoredRow*& s
       LOG_WARN("update sort column idx failed", K(ret));
     } else {
       got_first_row_ = true;
+      if (sort_collations_->count() > 0 && sort_collations_->at(0).field_idx_ < exprs.count()) {
+        const ObSortFieldCollation& first_collation = sort_collations_->at(0);
+        key_encoder_.init(first_collation, exprs.at(first_collation.field_idx_)->datum_meta_);
+      }
       int64_t size = OB_INVALID_ID == input_rows_ ? 0 : input_rows_ * input_width_;
       if (OB_FAIL(sql_mem_processor_.init(
               &mem_context_->get_malloc_allocator(), tenant_id_, size, op_type_, op_id_, exec_ctx_))) {
@@ -826,10 +948,8 @@ int ObSortOpImpl::sort_inmem_data()
           }
         }
       }
-      std::sort(&rows_.at(begin), &rows_.at(0) + rows_.count(), CopyableComparer(comp_));
-      if (OB_SUCCESS != comp_.ret_) {
-        ret = comp_.ret_;
-        LOG_WARN("compare failed", K(ret));
+      if (OB_FAIL(sort_rows(begin))) {
+        LOG_WARN("sort rows failed", K(ret), K(begin));
       }
     }
     if (OB_SUCC(ret) && need_imms()) {
@@ -870,6 +990,58 @@ int ObSortOpImpl::sort_inmem_data()
   return ret;
 }
 
+// sort rows_[begin, count)
+int ObSortOpImpl::sort_rows(const int64_t begin)
+{
+  int ret = OB_SUCCESS;
+  bool sorted = false;
+  if (key_encoder_.is_valid() && rows_.count() - begin >= NORMALIZED_KEY_SORT_MIN_ROWS &&
+      OB_FAIL(sort_rows_by_key(begin, sorted))) {
+    LOG_WARN("sort rows by normalized key failed", K(ret));
+  } else if (!sorted) {
+    std::sort(&rows_.at(begin), &rows_.at(0) + rows_.count(), CopyableComparer(comp_));
+  }
+  if (OB_SUCC(ret) && OB_SUCCESS != comp_.ret_) {
+    ret = comp_.ret_;
+    LOG_WARN("compare failed", K(ret));
+  }
+  return ret;
+}
+
+// Sort the (normalized key, row) pairs, which is much cache friendly than dereference rows
+// and call compare functions of each sort column. %sorted is false if some row can not be
+// encoded, rows are not touched in this case.
+int ObSortOpImpl::sort_rows_by_key(const int64_t begin, bool& sorted)
+{
+  int ret = OB_SUCCESS;
+  sorted = false;
+  const int64_t cnt = rows_.count() - begin;
+  const int64_t key_idx = sort_collations_->at(0).field_idx_;
+  SortKeyItem* items = static_cast<SortKeyItem*>(mem_context_->get_malloc_allocator().alloc(sizeof(SortKeyItem) * cnt));
+  if (OB_ISNULL(items)) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate memory failed", K(ret), K(cnt));
+  } else {
+    bool encoded = true;
+    for (int64_t i = 0; encoded && i < cnt; i++) {
+      ObChunkDatumStore::StoredRow* row = rows_.at(begin + i);
+      items[i].row_ = row;
+      encoded = key_encoder_.encode(row->cells()[key_idx], items[i].key_);
+    }
+    if (encoded) {
+      std::sort(items, items + cnt, SortKeyComparer(comp_));
+      for (int64_t i = 0; i < cnt; i++) {
+        rows_.at(begin + i) = items[i].row_;
+      }
+      sorted = true;
+    } else {
+      LOG_TRACE("row can not be encoded to normalized key", K(key_encoder_), K(cnt));
+    }
+    mem_context_->get_malloc_allocator().free(items);
+  }
+  return ret;
+}
+
 int ObSortOpImpl::sort()
 {
   int ret = OB_SUCCESS;
@@ -35,6 +35,54 @@ private:
   DISALLOW_COPY_AND_ASSIGN(ObSortOpChunk);
 };
 
+// Normalized key of the first sort column: an unsigned integer compares the same way as the
+// column value (a < b => key(a) <= key(b)), including the null position and sort direction.
+// In-memory rows are sorted by the normalized key first, all the sort columns are compared
+// only when the keys are equal.
+//
+// Supported: integer, unsigned integer, date/time, number and string with
+// utf8mb4_general_ci/utf8mb4_bin/binary collations. Number keeps the sign, exponent and
+// the leading digits, string keeps the leading 8 bytes of the collation weight.
+class ObSortKeyEncoder {
+public:
+  enum KeyType {
+    KEY_NONE = 0,
+    KEY_INT,
+    KEY_INT32,
+    KEY_UINT,
+    KEY_UINT8,
+    KEY_NUMBER,
+    KEY_STRING,
+  };
+
+  ObSortKeyEncoder()
+      : type_(KEY_NONE), cs_type_(common::CS_TYPE_INVALID), is_ascending_(true), null_pos_(common::NULL_LAST)
+  {}
+  // %type_ is set to KEY_NONE if the column type is not supported.
+  void init(const ObSortFieldCollation& sort_collation, const ObDatumMeta& meta);
+  void reset()
+  {
+    type_ = KEY_NONE;
+  }
+  bool is_valid() const
+  {
+    return KEY_NONE != type_;
+  }
+  // return false if %datum can not be encoded (e.g.: invalid unicode)
+  bool encode(const common::ObDatum& datum, uint64_t& key) const;
+
+  TO_STRING_KV(K_(type), K_(cs_type), K_(is_ascending), K_(null_pos));
+
+private:
+  bool encode_string(const common::ObDatum& datum, uint64_t& key) const;
+
+private:
+  KeyType type_;
+  common::ObCollationType cs_type_;
+  bool is_ascending_;
+  common::ObCmpNullPos null_pos_;
+};
+
 /*
  * Sort rows, do in memory sort if memory can hold all rows, otherwise do disk sort.
  * Prefix sorting is not supported it can be implemented by by simply wrapping ObSortOpImpl.
@@ -70,6 +118,8 @@ public:
   static const int64_t EXTEND_MULTIPLE = 2;
   static const int64_t MAX_MERGE_WAYS = 256;
   static const int64_t INMEMORY_MERGE_SORT_WARN_WAYS = 10000;
+  // sort by normalized key when in-memory rows not less than this
+  static const int64_t NORMALIZED_KEY_SORT_MIN_ROWS = 256;
 
   ObSortOpImpl();
   virtual ~ObSortOpImpl();
@@ -209,6 +259,23 @@ public:
     Compare& compare_;
   };
 
+  struct SortKeyItem {
+    uint64_t key_;
+    ObChunkDatumStore::StoredRow* row_;
+  };
+
+  // compare normalized key first, compare rows on key ties.
+  class SortKeyComparer {
+  public:
+    SortKeyComparer(Compare& compare) : compare_(compare)
+    {}
+    bool operator()(const SortKeyItem& l, const SortKeyItem& r)
+    {
+      return l.key_ < r.key_ || (l.key_ == r.key_ && compare_(l.row_, r.row_));
+    }
+    Compare& compare_;
+  };
+
 protected:
   class MemEntifyFreeGuard {
   public:
@@ -247,6 +314,8 @@ protected:
     return rows_.count() > datum_store_.get_row_cnt();
   }
   int sort_inmem_data();
+  int sort_rows(const int64_t begin);
+  int sort_rows_by_key(const int64_t begin, bool& sorted);
   int do_dump();
   template <typename Input>
   int build_chunk(const int64_t level, Input& input);
@@ -289,6 +358,8 @@ protected:
   const ObIArray<ObSortCmpFunc>* sort_cmp_funs_;
   ObEvalCtx* eval_ctx_;
   Compare comp_;
+  // normalized key of the first sort column, set when the first row added.
+  ObSortKeyEncoder key_encoder_;
   ObChunkDatumStore datum_store_;
   ObChunkDatumStore::Iterator iter_;
   int64_t inmem_row_size_;
@@ -20,6 +20,9 @@
 #include "storage/ob_table_scan_iterator.h"
 #include "observer/ob_server_struct.h"
 #include "observer/ob_server.h"
+#include "sql/engine/join/ob_hash_join_op.h"
+#include "sql/engine/px/ob_px_sqc_handler.h"
+#include "sql/engine/px/datahub/components/ob_dh_join_filter.h"
 
 namespace oceanbase {
 using namespace common;
@@ -225,7 +228,10 @@ ObTableScanSpec::ObTableScanSpec(ObIAllocator& alloc, const ObPhyOperatorType ty
       batch_scan_flag_(false),
       pd_storage_flag_(false),
       pd_storage_filters_(alloc),
-      pd_storage_index_back_filters_(alloc)
+      pd_storage_index_back_filters_(alloc),
+      join_filter_id_(OB_INVALID_ID),
+      join_filter_keys_(alloc),
+      join_filter_hash_funcs_(alloc)
 {}
 
 OB_SERIALIZE_MEMBER((ObTableScanSpec, ObOpSpec), ref_table_id_, index_id_, table_location_key_, is_index_global_,
@@ -238,7 +244,7 @@ OB_SERIALIZE_MEMBER((ObTableScanSpec, ObOpSpec), ref_table_id_, index_id_, table
     gi_above_, expected_part_id_, need_scn_, batch_scan_flag_, part_dep_cols_, subpart_dep_cols_, is_vt_mapping_,
     use_real_tenant_id_, has_tenant_id_col_, vt_table_id_, real_schema_version_, mapping_exprs_, output_row_types_,
     key_types_, key_with_tenant_ids_, has_extra_tenant_ids_, org_output_column_ids_, pd_storage_flag_,
-    pd_storage_filters_, pd_storage_index_back_filters_);
+    pd_storage_filters_, pd_storage_index_back_filters_, join_filter_id_, join_filter_keys_, join_filter_hash_funcs_);
 
 DEF_TO_STRING(ObTableScanSpec)
 {
@@ -268,11 +274,36 @@ DEF_TO_STRING(ObTableScanSpec)
       K(schema_version_),
       K(gi_above_),
       K(need_scn_),
-      K(batch_scan_flag_));
+      K(batch_scan_flag_),
+      K(join_filter_id_));
   J_OBJ_END();
   return pos;
 }
 
+int ObTableScanSpec::register_to_datahub(ObExecContext& ctx) const
+{
+  int ret = OB_SUCCESS;
+  if (has_join_filter()) {
+    if (OB_ISNULL(ctx.get_sqc_handler())) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("null unexpected", K(ret));
+    } else {
+      void* buf = ctx.get_allocator().alloc(sizeof(ObJoinFilterWholeMsg::WholeMsgProvider));
+      if (OB_ISNULL(buf)) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+      } else {
+        ObJoinFilterWholeMsg::WholeMsgProvider* provider = new (buf) ObJoinFilterWholeMsg::WholeMsgProvider();
+        ObSqcCtx& sqc_ctx = ctx.get_sqc_handler()->get_sqc_ctx();
+        // keyed by id of the hash join, which is the op id of join filter messages.
+        if (OB_FAIL(sqc_ctx.add_whole_msg_provider(join_filter_id_, *provider))) {
+          LOG_WARN("fail add whole msg provider", K(ret));
+        }
+      }
+    }
+  }
+  return ret;
+}
+
 int ObTableScanSpec::set_est_row_count_record(const ObIArray<ObEstRowCountRecord>& est_records)
 {
   int ret = OB_SUCCESS;
@@ -414,7 +445,12 @@ ObTableScanOp::ObTableScanOp(ObExecContext& exec_ctx, const ObOpSpec& spec, ObOp
           exec_ctx.get_my_session()->get_effective_tenant_id()),
       filter_executor_(nullptr),
       index_back_filter_executor_(nullptr),
-      cur_trace_id_(nullptr)
+      cur_trace_id_(nullptr),
+      join_filter_(NULL),
+      join_filter_requested_(false),
+      join_filter_check_rows_(0),
+      join_filter_check_ts_(0),
+      join_filter_filtered_rows_(0)
 {
   scan_param_.partition_guard_ = &partition_guard_;
 }
@@ -816,6 +852,8 @@ int ObTableScanOp::inner_open()
     }
   } else if (MY_SPEC.is_vt_mapping_ && OB_FAIL(init_converter())) {
     LOG_WARN("failed to init converter", K(ret));
+  } else if (MY_SPEC.has_join_filter() && OB_FAIL(request_join_filter())) {
+    LOG_WARN("request join filter failed", K(ret));
   } else if (MY_SPEC.gi_above_) {
     if (OB_FAIL(get_gi_task_and_restart())) {
       LOG_WARN("fail to get gi task and scan", K(ret));
@@ -1313,26 +1351,12 @@ int ObTableScanOp::inner_get_next_row()
     LOG_WARN("table scan result is not init", K(ret));
   } else if (0 == (++iterated_rows_ % CHECK_STATUS_ROWS_INTERVAL) && OB_FAIL(ctx_.check_status())) {
     LOG_WARN("check physical plan status failed", K(ret));
-  } else if (OB_FAIL(get_next_row_with_mode())) {
+  } else if (OB_FAIL(join_filter_requested_ ? get_next_row_with_join_filter() : get_next_row_with_mode())) {
     if (OB_ITER_END != ret) {
       LOG_WARN("fail to get next row from ObNewRowIterator", K(ret));
     } else {
-      if (MY_SPEC.is_top_table_scan_ && (scan_param_.limit_param_.offset_ > 0)) {
-        if (output_row_count_ < 0) {
-          ret = OB_ERR_UNEXPECTED;
-          LOG_WARN("invalid output_row_count_", K(output_row_count_), K(ret));
-        } else if (output_row_count_ > 0) {
-          int64_t total_count = output_row_count_ + scan_param_.limit_param_.offset_;
-          ObPhysicalPlanCtx* plan_ctx = GET_PHY_PLAN_CTX(ctx_);
-          NG_TRACE_EXT(found_rows, OB_ID(total_count), total_count, OB_ID(offset), scan_param_.limit_param_.offset_);
-          plan_ctx->set_found_rows(total_count);
-        }
-      }
-      if (MY_SPEC.for_update_ && share::is_oracle_mode()) {
-        // we get affected rows here now, but we need get it in for_update operator in future.
-        ObPhysicalPlanCtx* plan_ctx = GET_PHY_PLAN_CTX(ctx_);
-        plan_ctx->set_affected_rows(output_row_count_);
-      }
+      int tmp_ret = on_storage_iter_end();
+      ret = OB_SUCCESS == tmp_ret ? ret : tmp_ret;
     }
   } else {
     output_row_count_++;
@@ -1343,21 +1367,197 @@ int ObTableScanOp::inner_get_next_row()
     }
   }
   if (OB_UNLIKELY(OB_ITER_END == ret)) {
-    ObIPartitionGroup* partition = NULL;
-    ObIPartitionGroupGuard* guard = scan_param_.partition_guard_;
-    if (OB_ISNULL(guard)) {
-    } else if (OB_ISNULL(partition = guard->get_partition_group())) {
-    } else if (scan_param_.main_table_scan_stat_.bf_access_cnt_ > 0) {
-      partition->feedback_scan_access_stat(scan_param_);
-    }
-    ObTableScanStat& table_scan_stat = GET_PHY_PLAN_CTX(ctx_)->get_table_scan_stat();
-    fill_table_scan_stat(scan_param_.main_table_scan_stat_, table_scan_stat);
-    if (MY_SPEC.should_scan_index() && scan_param_.scan_flag_.index_back_) {
-      fill_table_scan_stat(scan_param_.idx_table_scan_stat_, table_scan_stat);
-    }
-    scan_param_.main_table_scan_stat_.reset_cache_stat();
-    scan_param_.idx_table_scan_stat_.reset_cache_stat();
-    iter_end_ = true;
+    on_iter_end();
+  }
+  return ret;
+}
+
+int ObTableScanOp::on_storage_iter_end()
+{
+  int ret = OB_SUCCESS;
+  if (MY_SPEC.is_top_table_scan_ && (scan_param_.limit_param_.offset_ > 0)) {
+    if (output_row_count_ < 0) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("invalid output_row_count_", K(output_row_count_), K(ret));
+    } else if (output_row_count_ > 0) {
+      int64_t total_count = output_row_count_ + scan_param_.limit_param_.offset_;
+      ObPhysicalPlanCtx* plan_ctx = GET_PHY_PLAN_CTX(ctx_);
+      NG_TRACE_EXT(found_rows, OB_ID(total_count), total_count, OB_ID(offset), scan_param_.limit_param_.offset_);
+      plan_ctx->set_found_rows(total_count);
+    }
+  }
+  if (MY_SPEC.for_update_ && share::is_oracle_mode()) {
+    // we get affected rows here now, but we need get it in for_update operator in future.
+    ObPhysicalPlanCtx* plan_ctx = GET_PHY_PLAN_CTX(ctx_);
+    plan_ctx->set_affected_rows(output_row_count_);
+  }
+  return ret;
+}
+
+void ObTableScanOp::on_iter_end()
+{
+  ObIPartitionGroup* partition = NULL;
+  ObIPartitionGroupGuard* guard = scan_param_.partition_guard_;
+  if (OB_ISNULL(guard)) {
+  } else if (OB_ISNULL(partition = guard->get_partition_group())) {
+  } else if (scan_param_.main_table_scan_stat_.bf_access_cnt_ > 0) {
+    partition->feedback_scan_access_stat(scan_param_);
+  }
+  ObTableScanStat& table_scan_stat = GET_PHY_PLAN_CTX(ctx_)->get_table_scan_stat();
+  fill_table_scan_stat(scan_param_.main_table_scan_stat_, table_scan_stat);
+  if (MY_SPEC.should_scan_index() && scan_param_.scan_flag_.index_back_) {
+    fill_table_scan_stat(scan_param_.idx_table_scan_stat_, table_scan_stat);
+  }
+  scan_param_.main_table_scan_stat_.reset_cache_stat();
+  scan_param_.idx_table_scan_stat_.reset_cache_stat();
+  iter_end_ = true;
+  if (join_filter_requested_) {
+    LOG_TRACE("join filter statistics", K(MY_SPEC.join_filter_id_), KP(join_filter_), K(join_filter_filtered_rows_));
+  }
+}
+
+int ObTableScanOp::request_join_filter()
+{
+  int ret = OB_SUCCESS;
+  ObPxSqcHandler* handler = ctx_.get_sqc_handler();
+  if (join_filter_requested_) {
+    // requested already, e.g.: reopen
+  } else if (OB_ISNULL(handler)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("join filter only supported in parallel execution mode", K(ret));
+  } else {
+    ObPxSQCProxy& proxy = handler->get_sqc_proxy();
+    ObJoinFilterPieceMsg piece;
+    piece.op_id_ = MY_SPEC.join_filter_id_;
+    piece.thread_id_ = GETTID();
+    piece.dfo_id_ = proxy.get_dfo_id();
+    piece.is_request_ = true;
+    piece.sqc_id_ = proxy.get_sqc_id();
+    if (OB_FAIL(proxy.send_dh_piece_msg(piece, ctx_.get_physical_plan_ctx()->get_timeout_timestamp()))) {
+      LOG_WARN("send join filter request failed", K(ret));
+    } else {
+      join_filter_requested_ = true;
+      join_filter_check_ts_ = ObTimeUtility::current_time();
+    }
+  }
+  return ret;
+}
+
+// Never wait for the join filter, check whether the filter arrived periodically.
+int ObTableScanOp::try_get_join_filter()
+{
+  int ret = OB_SUCCESS;
+  const int64_t cur_time = ObTimeUtility::current_time();
+  if (cur_time - join_filter_check_ts_ >= JOIN_FILTER_CHECK_TIME_INTERVAL) {
+    join_filter_check_ts_ = cur_time;
+    ObPxSQCProxy& proxy = ctx_.get_sqc_handler()->get_sqc_proxy();
+    const ObJoinFilterWholeMsg* whole = NULL;
+    if (OB_FAIL(proxy.poll_dh_msg(
+            MY_SPEC.join_filter_id_, whole, ctx_.get_physical_plan_ctx()->get_timeout_timestamp()))) {
+      if (OB_EAGAIN == ret) {
+        ret = OB_SUCCESS;
+      } else {
+        LOG_WARN("poll join filter failed", K(ret));
+      }
+    } else if (OB_ISNULL(whole)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("whole msg is unexpected", K(ret));
+    } else if (whole->filter_.is_inited()) {
+      join_filter_ = &whole->filter_;
+      LOG_TRACE("join filter arrived", K(MY_SPEC.join_filter_id_), K(iterated_rows_), K(whole->filter_));
+    }
+  }
+  return ret;
+}
+
+int ObTableScanOp::get_next_row_with_join_filter()
+{
+  int ret = OB_SUCCESS;
+  bool filtered = true;
+  while (OB_SUCC(ret) && filtered) {
+    filtered = false;
+    if (OB_FAIL(get_next_row_with_mode())) {
+      if (OB_ITER_END != ret) {
+        LOG_WARN("get next row failed", K(ret));
+      }
+    } else if (NULL == join_filter_) {
+      if (0 == (++join_filter_check_rows_ % JOIN_FILTER_CHECK_ROWS_INTERVAL) && OB_FAIL(try_get_join_filter())) {
+        LOG_WARN("try get join filter failed", K(ret));
+      }
+    } else {
+      uint64_t hash_value = 0;
+      if (OB_FAIL(ObHashJoinOp::calc_join_filter_hash(
+              MY_SPEC.join_filter_keys_, MY_SPEC.join_filter_hash_funcs_, eval_ctx_, hash_value))) {
+        LOG_WARN("calc join filter hash failed", K(ret));
+      } else if (!join_filter_->might_contain(hash_value)) {
+        filtered = true;
+        join_filter_filtered_rows_++;
+        clear_evaluated_flag();
+        if (0 == (++iterated_rows_ % CHECK_STATUS_ROWS_INTERVAL) && OB_FAIL(ctx_.check_status())) {
+          LOG_WARN("check physical plan status failed", K(ret));
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+// Virtual table rows are converted after iterated, join filter is checked for each row, and the
+// rows of range array (array binding) are switched by the parent, they are filled row by row.
+bool ObTableScanOp::is_storage_batch_supported() const
+{
+  return !MY_SPEC.is_vt_mapping_ && !join_filter_requested_ && NULL != result_ &&
+         common::ObNewRowIterator::ObTableScanIterator == result_->get_type() &&
+         scan_param_.range_array_pos_.count() <= 1;
+}
+
+// Storage projects the rows of batch to the batch datums of output expressions directly (strings
+// are copied to the result memory of each row), the filters are evaluated for the whole batch by
+// ObOperator::get_next_batch().
+int ObTableScanOp::inner_get_next_batch(const int64_t max_row_cnt)
+{
+  int ret = OB_SUCCESS;
+  int64_t count = 0;
+  if (OB_UNLIKELY(is_partition_list_empty_ || 0 == scan_param_.limit_param_.limit_)) {
+    ret = OB_ITER_END;
+  } else if (iter_end_) {
+    ret = OB_ITER_END;
+  } else if (OB_ISNULL(result_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("table scan result is not init", K(ret));
+  } else if (!is_storage_batch_supported()) {
+    if (OB_FAIL(fill_batch_by_row(max_row_cnt))) {
+      LOG_WARN("fill batch by row failed", K(ret));
+    }
+  } else if (OB_FAIL(ctx_.check_status())) {
+    LOG_WARN("check physical plan status failed", K(ret));
+  } else if (OB_FAIL(result_->get_next_rows(count, max_row_cnt))) {
+    if (OB_ITER_END != ret) {
+      LOG_WARN("fail to get next rows from ObNewRowIterator", K(ret), K(max_row_cnt));
+    } else {
+      int tmp_ret = on_storage_iter_end();
+      ret = OB_SUCCESS == tmp_ret ? ret : tmp_ret;
+    }
+  } else {
+    brs_.size_ = count;
+    output_row_count_ += count;
+    iterated_rows_ += count;
+    // less rows than requested are iterated only at the end, do not touch the ended storage iterator again
+    if (count < max_row_cnt) {
+      if (OB_FAIL(on_storage_iter_end())) {
+        LOG_WARN("handle storage iterate end failed", K(ret));
+      } else {
+        on_iter_end();
+        brs_.end_ = true;
+      }
+    }
+  }
+  if (OB_ITER_END == ret) {
+    ret = OB_SUCCESS;
+    if (!iter_end_) {
+      on_iter_end();
+    }
+    brs_.end_ = true;
   }
   return ret;
 }
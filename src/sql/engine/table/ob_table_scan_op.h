@@ -24,6 +24,7 @@
 #include "share/ob_i_sql_expression.h"
 #include "sql/ob_sql_mock_schema_utils.h"
 #include "sql/engine/basic/ob_pushdown_filter.h"
+#include "sql/engine/px/ob_px_bloom_filter.h"
 
 namespace oceanbase {
 namespace common {
@@ -133,6 +134,12 @@ public:
   {
     return ObPushdownFilterUtils::is_pushdown_storage_index_back(pd_storage_flag_);
   }
+  bool has_join_filter() const
+  {
+    return common::OB_INVALID_ID != join_filter_id_;
+  }
+
+  virtual int register_to_datahub(ObExecContext& ctx) const override;
 
   DECLARE_VIRTUAL_TO_STRING;
 
@@ -234,11 +241,20 @@ public:
   int32_t pd_storage_flag_;
   ObPushdownFilter pd_storage_filters_;
   ObPushdownFilter pd_storage_index_back_filters_;
+
+  // runtime join filter published by hash join (in another DFO) through datahub.
+  // %join_filter_id_ is the hash join operator id, OB_INVALID_ID if no join filter.
+  uint64_t join_filter_id_;
+  ExprFixedArray join_filter_keys_;
+  common::ObHashFuncs join_filter_hash_funcs_;
 };
 
 class ObTableScanOp : public ObOperator {
 public:
   static constexpr int64_t CHECK_STATUS_ROWS_INTERVAL = 1 << 13;
+  // check arrival of join filter every 1024 rows, at most once every 100ms.
+  static constexpr int64_t JOIN_FILTER_CHECK_ROWS_INTERVAL = 1 << 10;
+  static constexpr int64_t JOIN_FILTER_CHECK_TIME_INTERVAL = 100 * 1000;
 
   ObTableScanOp(ObExecContext& exec_ctx, const ObOpSpec& spec, ObOpInput* input);
   ~ObTableScanOp();
@@ -248,6 +264,7 @@ public:
   int switch_iterator() override;
   int bnl_switch_iterator();
   int inner_get_next_row() override;
+  int inner_get_next_batch(const int64_t max_row_cnt) override;
   int inner_close() override;
   void destroy() override;
 
@@ -322,6 +339,13 @@ protected:
 
 private:
   int get_next_row_with_mode();
+  // found rows and affected rows are set when storage reaches end
+  int on_storage_iter_end();
+  void on_iter_end();
+  bool is_storage_batch_supported() const;
+  int request_join_filter();
+  int try_get_join_filter();
+  int get_next_row_with_join_filter();
 
 protected:
   common::ObNewRowIterator* result_;
@@ -354,6 +378,13 @@ protected:
   ObPushdownFilterExecutor* index_back_filter_executor_;
 
   const uint64_t* cur_trace_id_;
+
+  // runtime join filter, NULL before arrived.
+  const ObPxBloomFilter* join_filter_;
+  bool join_filter_requested_;
+  int64_t join_filter_check_rows_;
+  int64_t join_filter_check_ts_;
+  int64_t join_filter_filtered_rows_;
 };
 
 }  // end namespace sql
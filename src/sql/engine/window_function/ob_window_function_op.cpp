@@ -82,6 +82,113 @@ int ObWindowFunctionOp::AggrCell::trans_self(const ObRADatumStore::StoredRow& ro
   return ret;
 }
 
+int ObWindowFunctionOp::AggrCell::inv_trans_self(const ObRADatumStore::StoredRow& row)
+{
+  int ret = OB_SUCCESS;
+  ObAggregateProcessor::GroupRow* group_row = NULL;
+  if (OB_UNLIKELY(!finish_prepared_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("remove row from aggregation not prepared", K(ret), K(row));
+  } else if (OB_FAIL(aggr_processor_.get_group_row(0, group_row))) {
+    LOG_WARN("failed to get_group_row", K(ret));
+  } else if (OB_ISNULL(group_row)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("group_row is null", K(ret));
+  } else if (OB_FAIL(aggr_processor_.inv_process(*group_row))) {
+    LOG_WARN("fail to inverse process the aggr func", K(ret), K(row));
+  } else {
+    got_result_ = false;
+  }
+  return ret;
+}
+
+int ObWindowFunctionOp::MinMaxSegTree::build(
+    ObWindowFunctionOp& op, const WinFuncInfo& wf_info, const Frame& part_frame)
+{
+  int ret = OB_SUCCESS;
+  reset();
+  row_base_ = part_frame.head_;
+  leaf_cnt_ = part_frame.tail_ - part_frame.head_ + 1;
+  ObExpr* param = wf_info.aggr_info_.param_exprs_.count() > 0 ? wf_info.aggr_info_.param_exprs_.at(0) : NULL;
+  if (OB_UNLIKELY(leaf_cnt_ <= 0) || OB_ISNULL(param)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(part_frame), KP(param));
+  } else if (OB_ISNULL(nodes_ = static_cast<int64_t*>(alloc_.alloc(sizeof(int64_t) * leaf_cnt_ * 2))) ||
+             OB_ISNULL(values_ = static_cast<ObDatum*>(alloc_.alloc(sizeof(ObDatum) * leaf_cnt_)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate memory failed", K(ret), K_(leaf_cnt));
+  } else {
+    const ObRADatumStore::StoredRow* row = NULL;
+    ObDatum* datum = NULL;
+    for (int64_t i = 0; OB_SUCC(ret) && i < leaf_cnt_; i++) {
+      new (&values_[i]) ObDatum();
+      if (OB_FAIL(op.rows_store_.get_row(row_base_ + i, row))) {
+        LOG_WARN("get row failed", K(ret), K(i), K_(row_base));
+      } else if (FALSE_IT(op.clear_evaluated_flag())) {
+      } else if (OB_FAIL(row->to_expr(op.get_all_expr(), op.eval_ctx_))) {
+        LOG_WARN("Failed to to_expr", K(ret));
+      } else if (OB_FAIL(param->eval(op.eval_ctx_, datum))) {
+        LOG_WARN("eval aggregate param failed", K(ret));
+      } else if (OB_FAIL(values_[i].deep_copy(*datum, alloc_))) {
+        LOG_WARN("deep copy datum failed", K(ret));
+      } else {
+        nodes_[leaf_cnt_ + i] = datum->is_null() ? -1 : i;
+      }
+    }
+    for (int64_t i = leaf_cnt_ - 1; OB_SUCC(ret) && i > 0; i--) {
+      nodes_[i] = select(wf_info, nodes_[2 * i], nodes_[2 * i + 1]);
+    }
+    if (OB_SUCC(ret)) {
+      built_ = true;
+    }
+  }
+  return ret;
+}
+
+int ObWindowFunctionOp::MinMaxSegTree::query(const WinFuncInfo& wf_info, const Frame& frame, ObDatum& val) const
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!built_ || frame.head_ < row_base_ || frame.tail_ >= row_base_ + leaf_cnt_ ||
+                  frame.head_ > frame.tail_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid frame", K(ret), K(frame), K(*this));
+  } else {
+    int64_t res = -1;
+    int64_t l = frame.head_ - row_base_ + leaf_cnt_;
+    int64_t r = frame.tail_ - row_base_ + leaf_cnt_ + 1;
+    for (; l < r; l >>= 1, r >>= 1) {
+      if (l & 1) {
+        res = select(wf_info, res, nodes_[l++]);
+      }
+      if (r & 1) {
+        res = select(wf_info, res, nodes_[--r]);
+      }
+    }
+    if (res < 0) {
+      val.set_null();
+    } else {
+      val = values_[res];
+    }
+  }
+  return ret;
+}
+
+int64_t ObWindowFunctionOp::MinMaxSegTree::select(const WinFuncInfo& wf_info, const int64_t l, const int64_t r) const
+{
+  int64_t res = l;
+  if (l < 0) {
+    res = r;
+  } else if (r >= 0) {
+    const int cmp = wf_info.aggr_info_.expr_->basic_funcs_->null_first_cmp_(values_[l], values_[r]);
+    if (T_FUN_MAX == wf_info.func_type_) {
+      res = cmp >= 0 ? l : r;
+    } else {
+      res = cmp <= 0 ? l : r;
+    }
+  }
+  return res;
+}
+
 int ObWindowFunctionOp::AggrCell::final(ObDatum& val)
 {
   int ret = OB_SUCCESS;
@@ -699,11 +806,24 @@ int ObWindowFunctionOp::init()
     local_allocator_.set_tenant_id(tenant_id);
     local_allocator_.set_label(ObModIds::OB_SQL_WINDOW_LOCAL);
     local_allocator_.set_ctx_id(ObCtxIds::WORK_AREA);
+    if (NULL == mem_context_) {
+      lib::ContextParam param;
+      param.set_mem_attr(tenant_id, ObModIds::OB_SQL_WINDOW_LOCAL, ObCtxIds::WORK_AREA)
+          .set_properties(lib::USE_TL_PAGE_OPTIONAL);
+      if (OB_FAIL(CURRENT_CONTEXT->CREATE_CONTEXT(mem_context_, param))) {
+        LOG_WARN("create memory context failed", K(ret));
+      } else if (OB_ISNULL(mem_context_)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("null memory context returned", K(ret));
+      }
+    }
     FuncAllocer func_alloc;
     func_alloc.local_allocator_ = &local_allocator_;
 
     WFInfoFixedArray& wf_infos = *const_cast<WFInfoFixedArray*>(&MY_SPEC.wf_infos_);
-    ret = curr_row_collect_values_.prepare_allocate(wf_infos.count());
+    if (OB_SUCC(ret)) {
+      ret = curr_row_collect_values_.prepare_allocate(wf_infos.count());
+    }
     for (int64_t i = 0; i < wf_infos.count() && OB_SUCC(ret); ++i) {
       WinFuncInfo& wf_info = wf_infos.at(i);
       WinFuncCell* wf_cell = NULL;
@@ -884,6 +1004,9 @@ int ObWindowFunctionOp::inner_close()
   }
   wf_list_.reset();
   local_allocator_.reset();
+  if (NULL != mem_context_) {
+    mem_context_->reuse();
+  }
   return ObOperator::inner_close();
 }
 
@@ -892,6 +1015,10 @@ void ObWindowFunctionOp::destroy()
   rows_store_.~RowsStore();
   wf_list_.~WinFuncCellList();
   local_allocator_.~ObArenaAllocator();
+  if (NULL != mem_context_) {
+    DESTROY_CONTEXT(mem_context_);
+    mem_context_ = NULL;
+  }
   ObOperator::destroy();
 }
 
@@ -987,7 +1114,17 @@ int ObWindowFunctionOp::compute(RowsReader& row_reader, WinFuncCell& wf_cell, co
       if (wf_cell.is_aggr()) {
         AggrCell* aggr_func = static_cast<AggrCell*>(&wf_cell);
         const ObRADatumStore::StoredRow* cur_row = NULL;
-        if (!Frame::same_frame(last_valid_frame, new_frame)) {
+        if (aggr_func->use_seg_tree_) {
+          // min/max of sliding frame, no need to maintain the aggregate result.
+          if (!aggr_func->seg_tree_.is_built() &&
+              OB_FAIL(aggr_func->seg_tree_.build(*this, aggr_func->wf_info_, part_frame))) {
+            LOG_WARN("build segment tree failed", K(ret), K(part_frame));
+          } else if (OB_FAIL(aggr_func->seg_tree_.query(aggr_func->wf_info_, new_frame, val))) {
+            LOG_WARN("query segment tree failed", K(ret), K(new_frame));
+          } else {
+            last_valid_frame = new_frame;
+          }
+        } else if (!Frame::same_frame(last_valid_frame, new_frame)) {
           if (!Frame::need_restart_aggr(aggr_func->can_inv(), last_valid_frame, new_frame)) {
             bool use_trans = new_frame.head_ < last_valid_frame.head_;
             int64_t b = min(new_frame.head_, last_valid_frame.head_);
@@ -1033,7 +1170,7 @@ int ObWindowFunctionOp::compute(RowsReader& row_reader, WinFuncCell& wf_cell, co
           LOG_DEBUG("use last value");
           // reuse last result, invoke final directly...
         }
-        if (OB_SUCC(ret)) {
+        if (OB_SUCC(ret) && !aggr_func->use_seg_tree_) {
           if (OB_FAIL(aggr_func->final(val))) {
             LOG_WARN("final failed", K(ret));
           } else {
@@ -278,6 +278,54 @@ public:
     Frame last_valid_frame_;
   };
 
+  // Segment tree of MIN/MAX values of partition rows, for frames with sliding head
+  // (not UNBOUNDED PRECEDING) which can not be aggregated incrementally. Each frame is
+  // answered in O(log n) instead of aggregating all rows of the frame. Built for each
+  // partition when first used, pages are allocated from the mem context of the operator.
+  class MinMaxSegTree {
+  public:
+    explicit MinMaxSegTree(common::ObIAllocator& page_alloc)
+        : alloc_(page_alloc),
+          row_base_(0),
+          leaf_cnt_(0),
+          nodes_(NULL),
+          values_(NULL),
+          built_(false)
+    {}
+    ~MinMaxSegTree()
+    {
+      reset();
+    }
+    void reset()
+    {
+      row_base_ = 0;
+      leaf_cnt_ = 0;
+      nodes_ = NULL;
+      values_ = NULL;
+      built_ = false;
+      alloc_.reset();
+    }
+    bool is_built() const
+    {
+      return built_;
+    }
+    int build(ObWindowFunctionOp& op, const WinFuncInfo& wf_info, const Frame& part_frame);
+    int query(const WinFuncInfo& wf_info, const Frame& frame, common::ObDatum& val) const;
+    TO_STRING_KV(K_(row_base), K_(leaf_cnt), K_(built));
+
+  private:
+    // index of the MIN/MAX value of leaf %l and %r, -1 for null
+    int64_t select(const WinFuncInfo& wf_info, const int64_t l, const int64_t r) const;
+
+  private:
+    common::ObArenaAllocator alloc_;
+    int64_t row_base_;  // row index of the first leaf
+    int64_t leaf_cnt_;
+    int64_t* nodes_;  // node i has children 2i and 2i+1, leaves start from %leaf_cnt_
+    common::ObDatum* values_;
+    bool built_;
+  };
+
   class AggrCell : public WinFuncCell {
   public:
     AggrCell(WinFuncInfo& wf_info, ObWindowFunctionOp& op, ObIArray<ObAggrInfo>& aggr_infos)
@@ -285,7 +333,11 @@ public:
           finish_prepared_(false),
           aggr_processor_(op_.eval_ctx_, aggr_infos),
           result_(),
-          got_result_(false)
+          got_result_(false),
+          can_inv_(ObAggregateProcessor::can_inv_process(wf_info.aggr_info_)),
+          use_seg_tree_((T_FUN_MIN == wf_info.func_type_ || T_FUN_MAX == wf_info.func_type_) &&
+                        !wf_info.upper_.is_unbounded_ && 1 == wf_info.aggr_info_.param_exprs_.count()),
+          seg_tree_(op.mem_context_->get_malloc_allocator())
     {}
     virtual ~AggrCell()
     {
@@ -297,7 +349,7 @@ public:
     }
     virtual bool can_inv() const
     {
-      return false;
+      return can_inv_;
     }
     int inv_trans(const ObRADatumStore::StoredRow& row)
     {
@@ -323,19 +375,14 @@ public:
 
   protected:
     virtual int trans_self(const ObRADatumStore::StoredRow& row);
-    virtual int inv_trans_self(const ObRADatumStore::StoredRow& row)
-    {
-      UNUSED(row);
-      int ret = common::OB_SUCCESS;
-      ret = common::OB_NOT_SUPPORTED;
-      return ret;
-    }
+    virtual int inv_trans_self(const ObRADatumStore::StoredRow& row);
     virtual void reset_for_restart_self() override
     {
       finish_prepared_ = false;
       aggr_processor_.reuse();
       result_.reset();
       got_result_ = false;
+      seg_tree_.reset();
     }
 
   public:
@@ -343,6 +390,11 @@ public:
     ObAggregateProcessor aggr_processor_;
     ObDatum result_;
     bool got_result_;
+    // count/sum/avg: rows sliding out of frame are removed from the result (inverse aggregation)
+    bool can_inv_;
+    // min/max with sliding frame head: computed by segment tree
+    bool use_seg_tree_;
+    MinMaxSegTree seg_tree_;
   };
 
   class NonAggrCell : public WinFuncCell {
@@ -425,6 +477,7 @@ public:
   ObWindowFunctionOp(ObExecContext& exec_ctx, const ObOpSpec& spec, ObOpInput* input)
       : ObOperator(exec_ctx, spec, input),
         local_allocator_(),
+        mem_context_(nullptr),
         rows_store_(),
         wf_list_(),
         next_row_(),
@@ -490,6 +543,8 @@ private:
 
 private:
   common::ObArenaAllocator local_allocator_;
+  // work area memory of partition computing, e.g. segment tree of MIN/MAX
+  lib::MemoryContext mem_context_;
 
   RowsStore rows_store_;
   WinFuncCellList wf_list_;
@@ -50,6 +50,7 @@ int ObLogGroupBy::copy_without_child(ObLogicalOperator*& out)
     group_by->rollup_exprs_ = rollup_exprs_;
     group_by->distinct_card_ = distinct_card_;
     group_by->from_pivot_ = from_pivot_;
+    group_by->is_push_down_ = is_push_down_;
     out = static_cast<ObLogicalOperator*>(group_by);
   }
   return ret;
@@ -257,6 +258,9 @@ int ObLogGroupBy::allocate_groupby_below(const ObIArray<ObRawExpr*>& distinct_ex
              OB_FAIL(child_group_by->set_expected_ordering(child_expected_ordering))) {
     LOG_WARN("failed to set expected ordering", K(ret));
   } else {
+    // child group by only pre-aggregates rows for the group by above exchange,
+    // it's not needed to aggregate completely if distinct is not involved.
+    child_group_by->set_push_down(distinct_exprs.empty());
     if (SCALAR_AGGREGATE == get_algo() || get_algo() == child_group_algo) {
       child_group_by->set_card(get_card());
       child_group_by->set_op_cost(get_op_cost());
@@ -22,6 +22,7 @@
 #include "sql/optimizer/ob_optimizer_util.h"
 #include "sql/optimizer/ob_log_granule_iterator.h"
 #include "sql/rewrite/ob_transform_utils.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 
 using namespace oceanbase;
 using namespace sql;
@@ -67,6 +68,7 @@ int ObLogJoin::copy_without_child(ObLogicalOperator*& out)
       join->set_late_mat(late_mat_);
       join->set_join_distributed_method(join_dist_algo_);
       join->set_anti_or_semi_sel(anti_or_semi_sel_);
+      join->set_shared_hash_table(is_shared_ht_);
       out = join;
     }
   }
@@ -112,6 +114,7 @@ int ObLogJoin::allocate_exchange_post(AllocExchContext* ctx)
   } else if (OB_FAIL(choose_best_distribution_method(
                  *ctx, candidate_method, pq_map_hint_, join_dist_algo_, slave_mapping_type_))) {
     LOG_WARN("failed to choose best distribution method", K(ret));
+  } else if (FALSE_IT(is_shared_ht_ = can_use_shared_hash_table(*left_child, *right_child))) {
   } else if (OB_FAIL(compute_sharding_and_allocate_exchange(ctx,
                  sharding_input_esets,
                  hash_left_join_keys,
@@ -144,6 +147,50 @@ int ObLogJoin::allocate_exchange_post(AllocExchContext* ctx)
   return ret;
 }
 
+// The build side of broadcast hash join is shared by the tasks of the same SQC when enabled,
+// only inner join supported since the match flags of build rows are not maintained.
+// Tasks sharing the hash table can not rescan separately, rescanned joins are excluded.
+// The shared hash table can not be dumped (its rows are referenced by the other tasks), it is used
+// only if the estimated build size fits in the hash work area, otherwise the build rows are broadcast
+// to each task to build the spillable hash table of the task.
+bool ObLogJoin::can_use_shared_hash_table(const ObLogicalOperator& left_child, const ObLogicalOperator& right_child)
+{
+  bool can_use = false;
+  const ObSQLSessionInfo* session = NULL;
+  if (HASH_JOIN == join_algo_ && INNER_JOIN == join_type_ && DIST_BROADCAST_NONE == join_dist_algo_ &&
+      SM_NONE == slave_mapping_type_ && right_child.get_sharding_info().is_sharding() && !is_rescanned() &&
+      NULL != get_plan() && NULL != (session = get_plan()->get_optimizer_context().get_session_info())) {
+    omt::ObTenantConfigGuard tenant_config(TENANT_CONF(session->get_effective_tenant_id()));
+    if (tenant_config.is_valid()) {
+      const double build_size = left_child.get_card() * left_child.get_width();
+      const int64_t hash_area_size = tenant_config->_hash_area_size;
+      can_use = tenant_config->_px_shared_hash_join && build_size <= static_cast<double>(hash_area_size);
+      LOG_TRACE("check shared hash table", K(can_use), K(build_size), K(hash_area_size));
+    }
+  }
+  return can_use;
+}
+
+// Whether this join may be rescanned by an ancestor: the right side of nested loop join
+// (including connect by) or the subquery children of subplan filter.
+bool ObLogJoin::is_rescanned()
+{
+  bool is_rescanned = false;
+  ObLogicalOperator* child = this;
+  ObLogicalOperator* parent = get_parent();
+  while (!is_rescanned && NULL != parent) {
+    if (LOG_SUBPLAN_FILTER == parent->get_type()) {
+      is_rescanned = parent->get_child(first_child) != child;
+    } else if (LOG_JOIN == parent->get_type()) {
+      is_rescanned = NESTED_LOOP_JOIN == static_cast<ObLogJoin*>(parent)->get_join_algo() &&
+                     parent->get_child(second_child) == child;
+    }
+    child = parent;
+    parent = parent->get_parent();
+  }
+  return is_rescanned;
+}
+
 int ObLogJoin::build_gi_partition_pruning()
 {
   int ret = OB_SUCCESS;
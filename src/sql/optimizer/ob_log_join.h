@@ -39,7 +39,8 @@ public:
         partition_id_expr_(nullptr),
         slave_mapping_type_(SM_NONE),
         join_filter_selectivitiy_(0),
-        connect_by_extra_exprs_()
+        connect_by_extra_exprs_(),
+        is_shared_ht_(false)
   {}
   virtual ~ObLogJoin()
   {}
@@ -290,6 +291,14 @@ public:
   {
     return connect_by_extra_exprs_.assign(exprs);
   }
+  inline void set_shared_hash_table(const bool is_shared_ht)
+  {
+    is_shared_ht_ = is_shared_ht;
+  }
+  inline bool is_shared_hash_table() const
+  {
+    return is_shared_ht_;
+  }
 
 private:
   inline bool can_enable_gi_partition_pruning()
@@ -335,6 +344,8 @@ private:
   {
     return SM_NONE != slave_mapping_type_;
   }
+  bool can_use_shared_hash_table(const ObLogicalOperator& left_child, const ObLogicalOperator& right_child);
+  bool is_rescanned();
 
 private:
   // all join predicates
@@ -365,6 +376,9 @@ private:
 
   double join_filter_selectivitiy_;
   ObSEArray<ObRawExpr*, 8, common::ModulePageAllocator, true> connect_by_extra_exprs_;
+  // hash join of broadcast build side, the hash table is built once and shared by the tasks of SQC,
+  // build rows are broadcast to hosts (BC2HOST) instead of tasks.
+  bool is_shared_ht_;
   DISALLOW_COPY_AND_ASSIGN(ObLogJoin);
 };
 
@@ -503,11 +503,11 @@ public:
   {
     return filter_before_index_back_;
   }
-  inline ObRawExpr* get_limit_expr()
+  inline ObRawExpr* get_limit_expr() const
   {
     return limit_count_expr_;
   }
-  inline ObRawExpr* get_offset_expr()
+  inline ObRawExpr* get_offset_expr() const
   {
     return limit_offset_expr_;
   }
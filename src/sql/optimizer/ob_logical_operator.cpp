@@ -3403,7 +3403,11 @@ int ObLogicalOperator::compute_sharding_and_allocate_exchange(AllocExchContext*
       if (OB_FAIL(sharding_info.copy_with_part_keys(right_child.get_sharding_info()))) {
         LOG_WARN("failed to assign sharding info", K(ret));
       } else if (right_child.get_sharding_info().is_sharding()) {
-        l_exch_info.dist_method_ = ObPQDistributeMethod::BROADCAST;
+        // build rows of shared hash join are shared by tasks of the same host
+        l_exch_info.dist_method_ =
+            (LOG_JOIN == get_type() && static_cast<ObLogJoin*>(this)->is_shared_hash_table())
+                ? ObPQDistributeMethod::BC2HOST
+                : ObPQDistributeMethod::BROADCAST;
       } else {
         l_exch_info.dist_method_ = ObPQDistributeMethod::MAX_VALUE;
       }
@@ -202,7 +202,7 @@ int ObBlockCacheWorkingSet::create_working_set_if_need()
 }
 
 int ObBlockCacheWorkingSet::alloc(const uint64_t tenant_id, const int64_t key_size, const int64_t value_size,
-    ObKVCachePair*& kvpair, ObKVCacheHandle& handle, ObKVCacheInstHandle& inst_handle)
+    ObKVCachePair*& kvpair, ObKVCacheHandle& handle, ObKVCacheInstHandle& inst_handle, const ObMicroBlockCacheKey* key)
 {
   int ret = OB_SUCCESS;
   BaseBlockCache* cache = nullptr;
@@ -211,7 +211,7 @@ int ObBlockCacheWorkingSet::alloc(const uint64_t tenant_id, const int64_t key_si
     LOG_WARN("not init", K(ret));
   } else if (OB_FAIL(get_cache(cache))) {
     LOG_WARN("get_cache failed", K(ret));
-  } else if (OB_FAIL(cache->alloc(tenant_id, key_size, value_size, kvpair, handle, inst_handle))) {
+  } else if (OB_FAIL(cache->alloc(tenant_id, key_size, value_size, kvpair, handle, inst_handle, key))) {
     LOG_WARN("cache put failed", K(ret));
   } else {
     const int64_t put_size = ObKVStoreMemBlock::get_align_size(key_size, value_size);
@@ -44,7 +44,7 @@ public:
   virtual int get(const Key& key, const Value*& pvalue, common::ObKVCacheHandle& handle) override;
   virtual int erase(const Key& key) override;
   virtual int alloc(const uint64_t tenant_id, const int64_t key_size, const int64_t value_size, ObKVCachePair*& kvpair,
-      ObKVCacheHandle& handle, ObKVCacheInstHandle& inst_handle) override;
+      ObKVCacheHandle& handle, ObKVCacheInstHandle& inst_handle, const Key* key = NULL) override;
 
 private:
   int create_working_set_if_need();
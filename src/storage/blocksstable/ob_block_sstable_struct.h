@@ -246,6 +246,9 @@ struct ObStorageEnv {
   int64_t clog_cache_priority_;
   int64_t index_clog_cache_priority_;
   int64_t bf_cache_miss_count_threshold_;
+  const char* secondary_block_cache_file_;
+  int64_t secondary_block_cache_size_;
+  const char* block_cache_snapshot_file_;
 
   int64_t ethernet_speed_;
   common::ObDiskType disk_type_;
@@ -259,6 +262,7 @@ struct ObStorageEnv {
       K_(redundancy_level), K_(log_spec), K_(clog_dir), K_(ilog_dir), K_(clog_shm_path), K_(ilog_shm_path),
       K_(index_cache_priority), K_(user_block_cache_priority), K_(user_row_cache_priority), K_(fuse_row_cache_priority),
       K_(bf_cache_priority), K_(clog_cache_priority), K_(index_clog_cache_priority), K_(bf_cache_miss_count_threshold),
+      K_(secondary_block_cache_file), K_(secondary_block_cache_size), K_(block_cache_snapshot_file),
       K_(ethernet_speed));
 };
 
@@ -1678,7 +1682,7 @@ public:
   }
   inline int32_t get_endkey_size() const
   {
-    return 0 == micro_block_mark_deletion_offset_ ? occupy_size_ - micro_block_endkey_offset_
+    return 0 == micro_block_mark_deletion_offset_ ? get_block_index_end() - micro_block_endkey_offset_
                                                   : micro_block_mark_deletion_offset_ - micro_block_endkey_offset_;
   }
   inline int32_t get_micro_block_mark_deletion_size() const
@@ -1687,7 +1691,16 @@ public:
   }
   inline int32_t get_micro_block_delta_size() const
   {
-    return 0 == micro_block_delta_offset_ ? 0 : occupy_size_ - micro_block_delta_offset_;
+    return 0 == micro_block_delta_offset_ ? 0 : get_block_index_end() - micro_block_delta_offset_;
+  }
+  inline int32_t get_micro_block_zone_map_size() const
+  {
+    return 0 == micro_block_zone_map_offset_ ? 0 : occupy_size_ - micro_block_zone_map_offset_;
+  }
+  // end of the sections before the optional zone map section
+  inline int32_t get_block_index_end() const
+  {
+    return 0 == micro_block_zone_map_offset_ ? occupy_size_ : micro_block_zone_map_offset_;
   }
   NEED_SERIALIZE_AND_DESERIALIZE;
   OB_INLINE bool is_data_block() const
@@ -1775,6 +1788,7 @@ public:
   char encrypt_key_[share::OB_MAX_TABLESPACE_ENCRYPT_KEY_LENGTH];
   bool contain_uncommitted_row_;
   int64_t max_merged_trans_version_;
+  int32_t micro_block_zone_map_offset_;  // zone_map_size = occupy_size - micro_block_zone_map_offset, 0 for none
 };
 
 struct ObFullMacroBlockMeta final {
@@ -0,0 +1,166 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_BLOCKSSTABLE_OB_COLUMN_ENCODING_H_
+#define OCEANBASE_BLOCKSSTABLE_OB_COLUMN_ENCODING_H_
+
+#include "lib/ob_define.h"
+#include "lib/utility/ob_print_utils.h"
+#include "common/object/ob_object.h"
+
+namespace oceanbase {
+namespace blocksstable {
+
+// Encoded micro block (ENCODING_ROW_STORE), values of the same column are stored together:
+//
+//  |- ObMicroBlockHeader       row_index_offset_ is the offset of row meta
+//  |- ObColumnEncodingHeader   one for each column
+//  |- row meta                 int8 all same flag, followed by one ObEncodedRowMeta if all same,
+//                              or one ObEncodedRowMeta for each row.
+//  |- column data              located by offset_ and length_ of the column header
+//
+// Column data of each encoding type (n is row count of the block):
+//  RAW:           int32 offsets[n + 1] | serialized ObObj of each row
+//  CONST:         serialized ObObj
+//  DICT:          int32 offsets[count_ + 1] | serialized ObObj of each distinct value | packed refs[n]
+//  RLE:           dictionary same as DICT | int32 run starts[run_count_] | packed refs[run_count_]
+//  INTEGER:       int64 base | null bitmap (if has_null_) | packed (value - base)[n]
+//  STRING_PREFIX: prefix (count_ bytes) | null bitmap (if has_null_) | int32 offsets[n + 1] | suffixes
+//
+// INTEGER and STRING_PREFIX are used only when the non-null values of the column have the same meta,
+// which is stored in meta_ of the column header.
+enum ObColumnEncodingType {
+  OB_COLUMN_ENCODING_RAW = 0,
+  OB_COLUMN_ENCODING_CONST = 1,
+  OB_COLUMN_ENCODING_DICT = 2,
+  OB_COLUMN_ENCODING_RLE = 3,
+  OB_COLUMN_ENCODING_INTEGER = 4,
+  OB_COLUMN_ENCODING_STRING_PREFIX = 5,
+  OB_COLUMN_ENCODING_MAX
+};
+
+struct ObColumnEncodingHeader {
+  uint8_t type_;      // ObColumnEncodingType
+  uint8_t width_;     // bit width of packed values
+  uint8_t has_null_;  // null bitmap exists
+  uint8_t reserved_;
+  int32_t offset_;  // offset of column data from the beginning of the block
+  int32_t length_;
+  int32_t count_;      // dictionary count of DICT and RLE, prefix length of STRING_PREFIX
+  int32_t run_count_;  // run count of RLE
+  common::ObObjMeta meta_;
+
+  ObColumnEncodingHeader()
+  {
+    reset();
+  }
+  void reset()
+  {
+    MEMSET(this, 0, sizeof(*this));
+  }
+  bool is_valid() const
+  {
+    return type_ < OB_COLUMN_ENCODING_MAX && width_ <= 64 && offset_ > 0 && length_ >= 0 && count_ >= 0 &&
+           run_count_ >= 0;
+  }
+  TO_STRING_KV(K_(type), K_(width), K_(has_null), K_(offset), K_(length), K_(count), K_(run_count), K_(meta));
+} __attribute__((packed));
+
+struct ObEncodedRowMeta {
+  int8_t flag_;
+  int8_t dml_;
+  int8_t row_type_flag_;
+
+  ObEncodedRowMeta() : flag_(0), dml_(0), row_type_flag_(0)
+  {}
+  bool operator==(const ObEncodedRowMeta& other) const
+  {
+    return flag_ == other.flag_ && dml_ == other.dml_ && row_type_flag_ == other.row_type_flag_;
+  }
+  bool operator!=(const ObEncodedRowMeta& other) const
+  {
+    return !(*this == other);
+  }
+  TO_STRING_KV(K_(flag), K_(dml), K_(row_type_flag));
+} __attribute__((packed));
+
+// Fixed width bit packing, values are stored little endian from the lowest bit.
+// Packed area is padded with PADDING bytes, so that values can be read by unaligned 8 bytes load.
+class ObBitPacking {
+public:
+  static const int64_t PADDING = 9;
+
+  static OB_INLINE int64_t get_width(const uint64_t max_value)
+  {
+    return 0 == max_value ? 0 : 64 - __builtin_clzll(max_value);
+  }
+  static OB_INLINE int64_t get_packed_size(const int64_t count, const int64_t width)
+  {
+    return (count * width + 7) / 8 + PADDING;
+  }
+  // %buf must be zeroed before packing.
+  static OB_INLINE void pack(char* buf, const int64_t idx, const int64_t width, const uint64_t value)
+  {
+    if (width > 0) {
+      const int64_t bit_pos = idx * width;
+      const int64_t shift = bit_pos & 7;
+      unsigned char* p = reinterpret_cast<unsigned char*>(buf) + (bit_pos >> 3);
+      uint64_t v = 0;
+      MEMCPY(&v, p, sizeof(v));
+      v |= value << shift;
+      MEMCPY(p, &v, sizeof(v));
+      if (shift + width > 64) {
+        p[8] = static_cast<unsigned char>(p[8] | (value >> (64 - shift)));
+      }
+    }
+  }
+  static OB_INLINE uint64_t unpack(const char* buf, const int64_t idx, const int64_t width)
+  {
+    uint64_t v = 0;
+    if (width > 0) {
+      const int64_t bit_pos = idx * width;
+      const int64_t shift = bit_pos & 7;
+      const unsigned char* p = reinterpret_cast<const unsigned char*>(buf) + (bit_pos >> 3);
+      MEMCPY(&v, p, sizeof(v));
+      v >>= shift;
+      if (shift + width > 64) {
+        v |= static_cast<uint64_t>(p[8]) << (64 - shift);
+      }
+      if (width < 64) {
+        v &= (1UL << width) - 1;
+      }
+    }
+    return v;
+  }
+};
+
+// Null bitmap of INTEGER and STRING_PREFIX encoding, bit set for null.
+class ObNullBitmap {
+public:
+  static OB_INLINE int64_t get_size(const int64_t count)
+  {
+    return (count + 7) / 8;
+  }
+  static OB_INLINE void set(char* bitmap, const int64_t idx)
+  {
+    bitmap[idx >> 3] = static_cast<char>(bitmap[idx >> 3] | (1 << (idx & 7)));
+  }
+  static OB_INLINE bool test(const char* bitmap, const int64_t idx)
+  {
+    return 0 != (bitmap[idx >> 3] & (1 << (idx & 7)));
+  }
+};
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
+
+#endif  // OCEANBASE_BLOCKSSTABLE_OB_COLUMN_ENCODING_H_
@@ -32,6 +32,14 @@ namespace memtable {
 class ObIMvccCtx;
 }
 
+namespace sql {
+class ObWhiteFilterExecutor;
+}
+
+namespace common {
+class ObBitmap;
+}
+
 namespace blocksstable {
 
 class ObColumnMap;
@@ -257,6 +265,18 @@ public:
   int locate_rowkey(const common::ObStoreRowkey& rowkey, int64_t& row_idx);
   int locate_range(const common::ObStoreRange& range, const bool is_left_border, const bool is_right_border,
       int64_t& begin_idx, int64_t& end_idx);
+  // Evaluate white filter on column %col_idx (index of column map) of rows [begin_index, begin_index + row_count),
+  // set the bit (begin_index as bit 0) of rows not filtered in %result_bitmap.
+  virtual int filter_pushdown_filter(const sql::ObWhiteFilterExecutor& filter, const int64_t col_idx,
+      const int64_t begin_index, const int64_t row_count, common::ObBitmap& result_bitmap)
+  {
+    UNUSED(filter);
+    UNUSED(col_idx);
+    UNUSED(begin_index);
+    UNUSED(row_count);
+    UNUSED(result_bitmap);
+    return common::OB_NOT_SUPPORTED;
+  }
 
   inline bool is_inited() const
   {
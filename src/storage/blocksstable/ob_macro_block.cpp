@@ -48,8 +48,14 @@ int ObDataStoreDesc::cal_row_store_type(const share::schema::ObTableSchema& tabl
     } else {
       row_store_type_ = FLAT_ROW_STORE;
     }
+  } else if (ENCODING_ROW_STORE == table_schema.get_row_store_type() &&
+             !is_trans_table_id(table_schema.get_table_id()) && !has_lob_column_ && !need_index_tree_ &&
+             major_working_cluster_version_ >= CLUSTER_VERSION_3200) {
+    // encoded micro block for major sstable of table with encoding store format,
+    // lob column and index tree are written by flat row only. Decided only by the cluster
+    // version of the freeze, so that replicas of the same major version agree on it.
+    row_store_type_ = ENCODING_ROW_STORE;
   } else {
-    // major merge support flat only
     row_store_type_ = FLAT_ROW_STORE;
   }
   STORAGE_LOG(DEBUG, "row store type", K(row_store_type_), K(merge_type));
@@ -172,12 +178,12 @@ int ObDataStoreDesc::init(const ObTableSchema& table_schema, const int64_t data_
     }
 
     if (OB_FAIL(ret)) {
-    } else if (OB_FAIL(cal_row_store_type(table_schema, merge_type))) {
-      STORAGE_LOG(WARN, "Failed to make the row store type", K(ret));
     } else if (OB_FAIL(table_schema.has_lob_column(has_lob_column_, true))) {
       STORAGE_LOG(WARN, "Failed to check lob column in table schema", K(ret));
     } else if (is_major_ && OB_FAIL(get_major_working_cluster_version())) {
       STORAGE_LOG(WARN, "Failed to get major working cluster version", K(ret));
+    } else if (OB_FAIL(cal_row_store_type(table_schema, merge_type))) {
+      STORAGE_LOG(WARN, "Failed to make the row store type", K(ret));
     } else {
       ObSEArray<ObColDesc, OB_DEFAULT_SE_ARRAY_COUNT> column_list;
       if (OB_NOT_NULL(multi_version_row_info) && multi_version_row_info->is_valid()) {
@@ -210,6 +216,20 @@ int ObDataStoreDesc::init(const ObTableSchema& table_schema, const int64_t data_
           }
         }
       }
+
+      // zone maps are only built for flat and encoded rows of major sstables. Older binaries read the
+      // trailing zone map into the endkeys, so they are written only from the cluster version of the
+      // freeze on, and the column count depends only on the schema.
+      if (OB_SUCC(ret) && is_major_ && !is_multi_version_minor_sstable() && !enable_sparse_format() &&
+          major_working_cluster_version_ >= CLUSTER_VERSION_3200) {
+        zone_map_column_count_ =
+            std::min(row_column_count_, static_cast<int64_t>(ObMicroBlockZoneMapBuilder::DEFAULT_COLUMN_COUNT));
+        if (zone_map_column_count_ > 0) {
+          micro_block_size_limit_ -= ObMicroBlockZoneMapWriter::get_fixed_size(zone_map_column_count_) +
+                                     sizeof(int32_t) /*entry offset*/ +
+                                     ObMicroBlockZoneMapBuilder::get_max_entry_size(zone_map_column_count_);
+        }
+      }
     }
   }
   return ret;
@@ -263,6 +283,7 @@ void ObDataStoreDesc::reset()
   need_check_order_ = true;
   progressive_merge_round_ = 0;
   major_working_cluster_version_ = 0;
+  zone_map_column_count_ = 0;
 }
 
 int ObDataStoreDesc::assign(const ObDataStoreDesc& desc)
@@ -302,6 +323,7 @@ int ObDataStoreDesc::assign(const ObDataStoreDesc& desc)
   pg_key_ = desc.pg_key_;
   need_check_order_ = desc.need_check_order_;
   major_working_cluster_version_ = desc.major_working_cluster_version_;
+  zone_map_column_count_ = desc.zone_map_column_count_;
   if (OB_FAIL(file_handle_.assign(desc.file_handle_))) {
     STORAGE_LOG(WARN, "failed to assign file handle", K(ret), K(desc.file_handle_));
   }
@@ -429,6 +451,7 @@ void ObMicroBlockDesc::reset()
   column_checksums_ = NULL;
   max_merged_trans_version_ = 0;
   contain_uncommitted_row_ = false;
+  zone_map_.reset();
 }
 
 /**
@@ -439,6 +462,7 @@ ObMacroBlock::ObMacroBlock()
       row_reader_(NULL),
       data_(0, "MacrBlocData"),
       index_(),
+      zone_map_writer_(),
       header_(NULL),
       column_ids_(NULL),
       column_types_(NULL),
@@ -467,7 +491,8 @@ ObMacroBlock::~ObMacroBlock()
 int ObMacroBlock::init_row_reader(const ObRowStoreType row_store_type)
 {
   int ret = OB_SUCCESS;
-  if (FLAT_ROW_STORE == row_store_type) {
+  if (FLAT_ROW_STORE == row_store_type || ENCODING_ROW_STORE == row_store_type) {
+    // rowkeys of encoded micro blocks are written by flat row
     row_reader_ = &flat_row_reader_;
   } else if (SPARSE_ROW_STORE == row_store_type) {
     row_reader_ = &sparse_row_reader_;
@@ -494,6 +519,9 @@ int ObMacroBlock::init(ObDataStoreDesc& spec)
     STORAGE_LOG(WARN, "fail to get pg file", K(ret), K(spec.file_handle_));
   } else if (OB_FAIL(init_row_reader(spec.row_store_type_))) {
     STORAGE_LOG(WARN, "macro block fail to init row reader.", K(ret));
+  } else if (spec.zone_map_column_count_ > 0 &&
+             OB_FAIL(zone_map_writer_.init(spec.column_ids_, spec.zone_map_column_count_))) {
+    STORAGE_LOG(WARN, "macro block fail to init zone map writer.", K(ret), K(spec.zone_map_column_count_));
   } else {
     is_multi_version_ = spec.is_multi_version_minor_sstable();
     need_calc_column_checksum_ = spec.need_calc_column_checksum_;
@@ -561,7 +589,10 @@ int ObMacroBlock::write_micro_block(const ObMicroBlockDesc& micro_block_desc, in
         spec_->store_micro_block_column_checksum_ ? RECORD_HEADER_VERSION_V3 : RECORD_HEADER_VERSION_V2;
     const int64_t record_header_size =
         ObRecordHeaderV3::get_serialize_size(header_version, micro_block_desc.column_count_);
-    if (micro_block_desc.buf_size_ + entry_size + record_header_size + micro_block_desc.last_rowkey_.length() >
+    const int64_t zone_map_size =
+        zone_map_writer_.is_enabled() ? micro_block_desc.zone_map_.length() + sizeof(int32_t) /*entry offset*/ : 0;
+    if (micro_block_desc.buf_size_ + entry_size + record_header_size + micro_block_desc.last_rowkey_.length() +
+            zone_map_size >
         get_remain_size()) {
       ret = OB_BUF_NOT_ENOUGH;
     }
@@ -582,6 +613,8 @@ int ObMacroBlock::write_micro_block(const ObMicroBlockDesc& micro_block_desc, in
           K(data_offset),
           K(micro_block_desc.can_mark_deletion_),
           K(micro_block_desc.row_count_delta_));
+    } else if (zone_map_writer_.is_enabled() && OB_FAIL(zone_map_writer_.add_entry(micro_block_desc.zone_map_))) {
+      STORAGE_LOG(WARN, "fail to add zone map entry", K(ret), K(micro_block_desc));
     } else if (OB_FAIL(write_micro_record_header(micro_block_desc))) {
       STORAGE_LOG(WARN, "fail to write micro record header", K(ret), K(micro_block_desc));
     } else {
@@ -703,6 +736,8 @@ int ObMacroBlock::merge(const ObMacroBlock& macro_block)
     ret = OB_BUF_NOT_ENOUGH;
   } else if (OB_FAIL(index_.merge(prev_data_offset, macro_block.index_))) {
     STORAGE_LOG(WARN, "current macro block index data out of index buffer.", K(ret));
+  } else if (OB_FAIL(zone_map_writer_.merge(macro_block.zone_map_writer_))) {
+    STORAGE_LOG(WARN, "macro block fail to merge zone map.", K(ret));
   } else if (OB_FAIL(data_.write(macro_block.get_micro_block_data_ptr(), macro_block.get_micro_block_data_size()))) {
     STORAGE_LOG(WARN,
         "macro block fail to writer micro block data.",
@@ -748,6 +783,7 @@ void ObMacroBlock::reset()
 {
   data_.reuse();
   index_.reset();
+  zone_map_writer_.reuse();
   header_ = NULL;
   column_ids_ = NULL;
   column_types_ = NULL;
@@ -906,6 +942,11 @@ int ObMacroBlock::build_index()
           index_.get_delta().length());
     }
   }
+  if (OB_SUCC(ret) && zone_map_writer_.is_enabled()) {
+    if (OB_FAIL(zone_map_writer_.build(data_))) {
+      STORAGE_LOG(WARN, "macro block fail to build zone map.", K(ret), K_(zone_map_writer));
+    }
+  }
   return ret;
 }
 
@@ -962,6 +1003,8 @@ int ObMacroBlock::build_macro_meta(ObFullMacroBlockMeta& full_meta)
     mbi.progressive_merge_round_ = spec_->progressive_merge_round_;
     mbi.max_merged_trans_version_ = max_merged_trans_version_;
     mbi.contain_uncommitted_row_ = contain_uncommitted_row_;
+    mbi.micro_block_zone_map_offset_ =
+        zone_map_writer_.is_enabled() ? header_->occupy_size_ - static_cast<int32_t>(zone_map_writer_.get_size()) : 0;
 
     schema.column_number_ = static_cast<int16_t>(header_->column_count_);
     schema.rowkey_column_number_ = static_cast<int16_t>(header_->rowkey_column_count_);
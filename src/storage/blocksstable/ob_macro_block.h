@@ -16,6 +16,7 @@
 #include "lib/compress/ob_compressor.h"
 #include "storage/ob_multi_version_col_desc_generate.h"
 #include "ob_micro_block_index_writer.h"
+#include "ob_micro_block_zone_map.h"
 #include "ob_block_sstable_struct.h"
 #include "storage/ob_tenant_file_struct.h"
 #include "ob_block_mark_deletion_maker.h"
@@ -73,6 +74,8 @@ struct ObDataStoreDesc {
   // major_working_cluster_version_ == 0 means upgrade from old cluster
   // which still use freezeinfo without cluster version
   int64_t major_working_cluster_version_;
+  // number of leading columns with min/max zone map of each micro block, 0 for none
+  int64_t zone_map_column_count_;
   ObDataStoreDesc()
   {
     reset();
@@ -100,7 +103,7 @@ struct ObDataStoreDesc {
       K_(store_micro_block_column_checksum), K_(snapshot_version), K_(need_calc_physical_checksum), K_(need_index_tree),
       K_(need_prebuild_bloomfilter), K_(bloomfilter_rowkey_prefix), KP_(rowkey_helper), "column_types",
       common::ObArrayWrap<common::ObObjMeta>(column_types_, row_column_count_), K_(pg_key), K_(file_handle),
-      K_(need_check_order), K_(need_index_tree), K_(major_working_cluster_version));
+      K_(need_check_order), K_(need_index_tree), K_(major_working_cluster_version), K_(zone_map_column_count));
 
 private:
   int cal_row_store_type(const share::schema::ObTableSchema& table_schema, const storage::ObMergeType merge_type);
@@ -139,6 +142,7 @@ struct ObMicroBlockDesc {
   int64_t* column_checksums_;
   int64_t max_merged_trans_version_;
   bool contain_uncommitted_row_;
+  common::ObString zone_map_;  // zone map entry, empty if not built
 
   ObMicroBlockDesc()
   {
@@ -150,7 +154,7 @@ struct ObMicroBlockDesc {
   // last_rowkey is byte stream, don't print it
   TO_STRING_KV(K_(last_rowkey), KP_(buf), K_(buf_size), K_(data_size), K_(row_count), K_(column_count),
       K_(row_count_delta), K_(can_mark_deletion), KP_(column_checksums), K_(max_merged_trans_version),
-      K_(contain_uncommitted_row));
+      K_(contain_uncommitted_row), "zone_map_size", zone_map_.length());
 };
 
 class ObMacroBlock {
@@ -169,7 +173,7 @@ public:
   }
   OB_INLINE int64_t get_data_size() const
   {
-    return data_.length() + index_.get_block_size();
+    return data_.length() + index_.get_block_size() + zone_map_writer_.get_size();
   }
   OB_INLINE int32_t get_row_count() const
   {
@@ -215,7 +219,7 @@ private:
 private:
   OB_INLINE int64_t get_remain_size() const
   {
-    return data_.remain() - index_.get_block_size();
+    return data_.remain() - index_.get_block_size() - zone_map_writer_.get_size();
   }
   OB_INLINE const char* get_micro_block_data_ptr() const
   {
@@ -227,7 +231,8 @@ private:
   }
   OB_INLINE int64_t get_raw_data_size() const
   {
-    return get_micro_block_data_size() + index_.get_block_size() - ObMicroBlockIndexWriter::INDEX_ENTRY_SIZE;
+    return get_micro_block_data_size() + index_.get_block_size() - ObMicroBlockIndexWriter::INDEX_ENTRY_SIZE +
+           zone_map_writer_.get_size();
   }
 
 private:
@@ -237,6 +242,7 @@ private:
   ObSparseRowReader sparse_row_reader_;
   ObSelfBufferWriter data_;  // micro header + data blocks;
   ObMicroBlockIndexWriter index_;
+  ObMicroBlockZoneMapWriter zone_map_writer_;
   ObSSTableMacroBlockHeader* header_;  // macro header store in head of data_;
   uint16_t* column_ids_;
   common::ObObjMeta* column_types_;
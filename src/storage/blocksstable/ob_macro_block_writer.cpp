@@ -39,6 +39,7 @@ ObMacroBlockWriter::ObMacroBlockWriter()
       compressor_(),
       micro_writer_(&flat_writer_),
       flat_writer_(),
+      encoder_(),
       row_writer_(),
       flat_reader_(),
       sstable_index_writer_(NULL),
@@ -59,6 +60,7 @@ ObMacroBlockWriter::ObMacroBlockWriter()
       allocator_("MacrBlocWriter"),
       macro_reader_(),
       micro_rowkey_hashs_(),
+      zone_map_builder_(),
       rowkey_helper_(nullptr)
 {
   // macro_blocks_
@@ -87,7 +89,9 @@ void ObMacroBlockWriter::reset()
   // block_size_spec_
   micro_writer_ = &flat_writer_;
   flat_writer_.reuse();
+  encoder_.reuse();
   flat_reader_.reset();
+  decoder_.reset();
   sstable_index_writer_ = NULL;
   task_index_writer_ = NULL;
   macro_blocks_[0].reset();
@@ -109,7 +113,9 @@ void ObMacroBlockWriter::reset()
   lob_writer_.reset();
   check_flat_reader_.reset();
   check_sparse_reader_.reset();
+  check_decoder_.reset();
   micro_rowkey_hashs_.reset();
+  zone_map_builder_.reset();
   rowkey_helper_ = nullptr;
   allocator_.reuse();
 }
@@ -184,7 +190,16 @@ int ObMacroBlockWriter::open(ObDataStoreDesc& data_store_desc, const ObMacroData
       } else if (OB_FAIL(build_column_map(index_store_desc_, index_column_map_))) {
         STORAGE_LOG(WARN, "failed to build index column map", K(data_store_desc), K(ret));
       }
-      if (OB_SUCC(ret)) {
+      if (OB_FAIL(ret)) {
+      } else if (ENCODING_ROW_STORE == data_store_desc_->row_store_type_) {
+        if (OB_FAIL(encoder_.init(data_store_desc_->micro_block_size_limit_,
+                data_store_desc_->rowkey_column_count_,
+                data_store_desc_->row_column_count_))) {
+          STORAGE_LOG(WARN, "Fail to init micro block encoder, ", K(ret));
+        } else {
+          micro_writer_ = &encoder_;
+        }
+      } else {
         if (OB_FAIL(flat_writer_.init(data_store_desc_->micro_block_size_limit_,
                 data_store_desc_->rowkey_column_count_,
                 data_store_desc_->row_column_count_))) {
@@ -215,6 +230,12 @@ int ObMacroBlockWriter::open(ObDataStoreDesc& data_store_desc, const ObMacroData
         }
       }
 
+      if (OB_SUCC(ret) && data_store_desc_->zone_map_column_count_ > 0) {
+        if (OB_FAIL(zone_map_builder_.init(data_store_desc_->zone_map_column_count_))) {
+          STORAGE_LOG(WARN, "Fail to init zone map builder", K(ret), K(data_store_desc_->zone_map_column_count_));
+        }
+      }
+
       if (OB_SUCC(ret) && data_store_desc_->need_prebuild_bloomfilter_ && data_store_desc_->bloomfilter_size_ > 0) {
         if (OB_FAIL(open_bf_cache_writer(*data_store_desc_))) {
           STORAGE_LOG(WARN, "Failed to open bloomfilter cache writer, ", K(ret));
@@ -290,6 +311,8 @@ int ObMacroBlockWriter::append_row(const ObStoreRow& row, const int64_t split_si
           STORAGE_LOG(ERROR, "Fail to append row to micro block, ", K(ret), K(row));
         } else if (data_store_desc_->need_calc_column_checksum_ && OB_FAIL(add_row_checksum(row_to_append->row_val_))) {
           STORAGE_LOG(WARN, "fail to add column checksum", K(ret));
+        } else if (zone_map_builder_.is_inited() && OB_FAIL(zone_map_builder_.update(row_to_append->row_val_))) {
+          STORAGE_LOG(WARN, "fail to update zone map", K(ret));
         }
         if (OB_SUCC(ret) && data_store_desc_->need_prebuild_bloomfilter_) {
           const ObStoreRowkey rowkey(row_to_append->row_val_.cells_, data_store_desc_->bloomfilter_rowkey_prefix_);
@@ -313,6 +336,8 @@ int ObMacroBlockWriter::append_row(const ObStoreRow& row, const int64_t split_si
       }
       if (data_store_desc_->need_calc_column_checksum_ && OB_FAIL(add_row_checksum(row_to_append->row_val_))) {
         STORAGE_LOG(WARN, "fail to add column checksum", K(ret));
+      } else if (zone_map_builder_.is_inited() && OB_FAIL(zone_map_builder_.update(row_to_append->row_val_))) {
+        STORAGE_LOG(WARN, "fail to update zone map", K(ret));
       } else if (micro_writer_->get_block_size() >= split_size) {
         if (OB_FAIL(build_micro_block())) {
           STORAGE_LOG(WARN, "Fail to build micro block, ", K(ret));
@@ -915,10 +940,13 @@ int ObMacroBlockWriter::build_micro_block(const bool force_split)
       micro_block_desc.max_merged_trans_version_ = micro_writer_->get_max_merged_trans_version();
       micro_block_desc.contain_uncommitted_row_ = micro_writer_->is_contain_uncommitted_row();
     }
-    if (OB_FAIL(write_micro_block(micro_block_desc, force_split))) {
+    if (zone_map_builder_.is_inited() && OB_FAIL(zone_map_builder_.build(micro_block_desc.zone_map_))) {
+      STORAGE_LOG(WARN, "Fail to build zone map", K(ret), K_(zone_map_builder));
+    } else if (OB_FAIL(write_micro_block(micro_block_desc, force_split))) {
       STORAGE_LOG(WARN, "build_micro_block failed", K(micro_block_desc), K(force_split), K(ret));
     } else {
       micro_writer_->reuse();
+      zone_map_builder_.reuse();
       if (data_store_desc_->need_prebuild_bloomfilter_ && micro_rowkey_hashs_.count() > 0) {
         micro_rowkey_hashs_.reuse();
       }
@@ -1501,6 +1529,10 @@ OB_INLINE ObIMicroBlockReader* ObMacroBlockWriter::get_micro_block_reader(const
       reader = &sparse_reader_;
       break;
     }
+    case ENCODING_ROW_STORE: {
+      reader = &decoder_;
+      break;
+    }
     default:
       STORAGE_LOG(WARN, "invalid store type", K(row_store_type));
       break;
@@ -1564,6 +1596,10 @@ int ObMacroBlockWriter::prepare_micro_block_reader(
       micro_reader = static_cast<ObIMicroBlockReader*>(&check_sparse_reader_);
       read_out_type = SPARSE_ROW_STORE;  // read row type is sparse row
       column_map_ptr = nullptr;          // make reader read full sparse row
+    } else if (ENCODING_ROW_STORE == data_store_desc_->row_store_type_) {
+      micro_reader = static_cast<ObIMicroBlockReader*>(&check_decoder_);
+      read_out_type = FLAT_ROW_STORE;
+      column_map_ptr = &column_map_;
     } else {
       ret = OB_NOT_SUPPORTED;
       STORAGE_LOG(WARN, "Unexpeceted row store type", K(ret), K(data_store_desc_->row_store_type_));
@@ -30,6 +30,8 @@
 #include "storage/blocksstable/ob_store_file_system.h"
 #include "storage/blocksstable/ob_macro_block_reader.h"
 #include "storage/blocksstable/ob_sparse_micro_block_reader.h"
+#include "storage/blocksstable/ob_micro_block_encoder.h"
+#include "storage/blocksstable/ob_micro_block_decoder.h"
 #include "storage/ob_pg_mgr.h"
 #include "ob_block_index_intermediate.h"
 
@@ -178,10 +180,12 @@ private:
   IndexMicroBlockDescList task_top_block_descs_;
   ObIMicroBlockWriter* micro_writer_;
   ObMicroBlockWriter flat_writer_;
+  ObMicroBlockEncoder encoder_;
   ObRowWriter row_writer_;
   char rowkey_buf_[common::OB_MAX_ROW_KEY_LENGTH];
   ObMicroBlockReader flat_reader_;
   ObSparseMicroBlockReader sparse_reader_;
+  ObMicroBlockDecoder decoder_;
   ObMacroBlockWriter* sstable_index_writer_;
   ObMacroBlockWriter* task_index_writer_;
   ObMacroBlock macro_blocks_[2];
@@ -211,7 +215,9 @@ private:
                                                                                     // NOT use same buf of data row
   ObMicroBlockReader check_flat_reader_;
   ObSparseMicroBlockReader check_sparse_reader_;
+  ObMicroBlockDecoder check_decoder_;
   common::ObArray<uint32_t> micro_rowkey_hashs_;
+  ObMicroBlockZoneMapBuilder zone_map_builder_;
   storage::ObSSTableRowkeyHelper* rowkey_helper_;
   ObSSTableMacroBlockChecker macro_block_checker_;
   common::SpinRWLock lock_;
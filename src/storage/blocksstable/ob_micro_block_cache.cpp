@@ -17,6 +17,7 @@
 #include "lib/stat/ob_diagnose_info.h"
 #include "storage/ob_sstable.h"
 #include "storage/ob_partition_service.h"
+#include "ob_storage_cache_suite.h"
 
 namespace oceanbase {
 using namespace common;
@@ -266,7 +267,13 @@ int ObIMicroBlockCache::prefetch(const uint64_t table_id, const ObMacroBlockCtx&
     common::align_offset_size(offset, size, read_info.offset_, read_info.size_);
 
     macro_handle.set_file(pg_file);
-    if (OB_FAIL(callback.table_handle_.set_table(block_ctx.sstable_))) {
+    const ObMicroBlockCacheKey key(table_id, callback.block_id_, callback.file_id_, offset, size);
+    ObMicroBlockSecondaryCache& secondary_cache = OB_STORE_CACHE.get_secondary_block_cache();
+    if (secondary_cache.is_inited() &&
+        OB_SUCCESS == prefetch_secondary(secondary_cache, key, read_info.io_desc_, flag, macro_handle)) {
+      EVENT_INC(ObStatEventIds::IO_READ_PREFETCH_MICRO_COUNT);
+      EVENT_ADD(ObStatEventIds::IO_READ_PREFETCH_MICRO_BYTES, size);
+    } else if (OB_FAIL(callback.table_handle_.set_table(block_ctx.sstable_))) {
       STORAGE_LOG(WARN, "fail to set table", K(ret));
     } else if (OB_FAIL(pg_file->async_read_block(read_info, macro_handle))) {
       STORAGE_LOG(WARN, "Fail to async read block, ", K(ret));
@@ -278,6 +285,21 @@ int ObIMicroBlockCache::prefetch(const uint64_t table_id, const ObMacroBlockCtx&
   return ret;
 }
 
+int ObIMicroBlockCache::prefetch_secondary(ObMicroBlockSecondaryCache& secondary_cache,
+    const ObMicroBlockCacheKey& key, const ObIODesc& io_desc, const ObQueryFlag& flag, ObMacroBlockHandle& macro_handle)
+{
+  int ret = OB_SUCCESS;
+  // the io handle of the data file is not used, the macro block needs no reference
+  macro_handle.reuse();
+  if (OB_FAIL(
+          secondary_cache.prefetch(key, io_desc, flag.is_use_block_cache(), *this, macro_handle.get_io_handle()))) {
+    if (OB_ENTRY_NOT_EXIST != ret) {
+      STORAGE_LOG(WARN, "fail to prefetch from secondary block cache", K(ret), K(key));
+    }
+  }
+  return ret;
+}
+
 int ObIMicroBlockCache::prefetch(const uint64_t table_id, const ObMacroBlockCtx& block_ctx,
     const ObMultiBlockIOParam& io_param, const ObQueryFlag& flag, ObStorageFile* pg_file,
     ObMacroBlockHandle& macro_handle)
@@ -493,7 +515,8 @@ int ObIMicroBlockCache::ObIMicroBlockIOCallback::put_cache_and_fetch(const ObFul
                  value_size,
                  kvpair,
                  handle,
-                 inst_handle))) {
+                 inst_handle,
+                 &key))) {
     LOG_WARN("failed to alloc cache buf", K(ret));
   } else {
     char* block_buf = reinterpret_cast<char*>(kvpair->value_) + sizeof(ObMicroBlockCacheValue);
@@ -503,6 +526,8 @@ int ObIMicroBlockCache::ObIMicroBlockIOCallback::put_cache_and_fetch(const ObFul
     if (OB_FAIL(reader.decompress_data_with_prealloc_buf(
             meta.schema_->compressor_, payload_buf, payload_size, block_buf, common_header->data_length_))) {
       LOG_WARN("failed to decompress_data_with_prealloc_buf", K(ret));
+      // the abandoned kv pair must not be passed to the wash callback
+      cache_value->get_block_data().reset();
     } else {
       micro_block = cache_value;
       if (OB_FAIL(cache_->put_kvpair(inst_handle, kvpair, handle, overwrite))) {
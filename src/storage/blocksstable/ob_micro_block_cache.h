@@ -23,6 +23,9 @@
 
 namespace oceanbase {
 namespace blocksstable {
+class ObMicroBlockSecondaryCache;
+class ObMicroBlockCacheSnapshot;
+
 class ObMicroBlockCacheKey : public common::ObIKVCacheKey {
 public:
   ObMicroBlockCacheKey(const uint64_t table_id, const MacroBlockId& block_id, const int64_t file_id,
@@ -40,6 +43,8 @@ public:
   TO_STRING_KV(K_(table_id), K_(block_id), K_(file_id), K_(offset), K_(size));
 
 private:
+  friend class ObMicroBlockSecondaryCache;
+  friend class ObMicroBlockCacheSnapshot;
   uint64_t table_id_;
   MacroBlockId block_id_;
   int64_t file_id_;
@@ -170,6 +175,10 @@ public:
   virtual int get_cache(BaseBlockCache*& cache) = 0;
   virtual int get_allocator(common::ObIAllocator*& allocator) = 0;
 
+private:
+  int prefetch_secondary(ObMicroBlockSecondaryCache& secondary_cache, const ObMicroBlockCacheKey& key,
+      const common::ObIODesc& io_desc, const common::ObQueryFlag& flag, ObMacroBlockHandle& macro_handle);
+
 public:
   class ObIMicroBlockIOCallback : public common::ObIOCallback {
   public:
@@ -0,0 +1,540 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+#include "ob_micro_block_cache_snapshot.h"
+#include <fcntl.h>
+#include <algorithm>
+#include "lib/checksum/ob_crc64.h"
+#include "observer/ob_server_struct.h"
+#include "share/config/ob_server_config.h"
+#include "ob_macro_block_common_header.h"
+#include "ob_store_file_system.h"
+
+namespace oceanbase {
+using namespace common;
+namespace blocksstable {
+
+static bool compare_by_hotness(const ObBlockCacheSnapshotItem& left, const ObBlockCacheSnapshotItem& right)
+{
+  return left.get_cnt_ > right.get_cnt_;
+}
+
+static bool compare_by_location(const ObBlockCacheSnapshotItem& left, const ObBlockCacheSnapshotItem& right)
+{
+  return left.block_id_ < right.block_id_ || (left.block_id_ == right.block_id_ && left.offset_ < right.offset_);
+}
+
+ObBlockCacheSnapshotHeader::ObBlockCacheSnapshotHeader()
+    : magic_(SNAPSHOT_MAGIC), version_(SNAPSHOT_VERSION), item_cnt_(0), items_checksum_(0), snapshot_ts_(0)
+{}
+
+ObMicroBlockCacheSnapshot::ObMicroBlockCacheSnapshot()
+    : is_inited_(false),
+      is_started_(false),
+      block_cache_(NULL),
+      reader_(),
+      last_dump_ts_(0),
+      load_cnt_(0),
+      skip_cnt_(0),
+      dump_cnt_(0)
+{
+  file_path_[0] = '\0';
+}
+
+ObMicroBlockCacheSnapshot::~ObMicroBlockCacheSnapshot()
+{
+  destroy();
+}
+
+int ObMicroBlockCacheSnapshot::init(const char* file_path, ObMicroBlockCache& block_cache)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("block cache snapshot has been inited", K(ret));
+  } else if (OB_ISNULL(file_path) || OB_UNLIKELY('\0' == file_path[0]) ||
+             OB_UNLIKELY(STRLEN(file_path) >= sizeof(file_path_))) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(file_path));
+  } else {
+    STRNCPY(file_path_, file_path, sizeof(file_path_));
+    block_cache_ = &block_cache;
+    is_inited_ = true;
+    LOG_INFO("succeed to init block cache snapshot", K(*this));
+  }
+  return ret;
+}
+
+void ObMicroBlockCacheSnapshot::destroy()
+{
+  int ret = OB_SUCCESS;
+  if (is_started_) {
+    lib::ThreadPool::stop();
+    lib::ThreadPool::wait();
+    // keep the latest hot blocks for the next start
+    if (OB_FAIL(dump())) {
+      LOG_WARN("fail to dump block cache snapshot", K(ret));
+    }
+    is_started_ = false;
+  }
+  is_inited_ = false;
+  block_cache_ = NULL;
+  file_path_[0] = '\0';
+  last_dump_ts_ = 0;
+}
+
+int ObMicroBlockCacheSnapshot::load()
+{
+  int ret = OB_SUCCESS;
+  ObBlockCacheSnapshotItem* items = NULL;
+  int64_t item_cnt = 0;
+  const int64_t start_ts = ObTimeUtility::current_time();
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("block cache snapshot has not been inited", K(ret));
+  } else if (OB_UNLIKELY(is_started_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("block cache snapshot has been loaded", K(ret));
+  } else if (OB_FAIL(read_file(items, item_cnt))) {
+    if (OB_ENTRY_NOT_EXIST == ret) {
+      LOG_INFO("block cache snapshot does not exist", K_(file_path));
+    } else {
+      LOG_WARN("fail to read block cache snapshot, ignore it", K(ret), K_(file_path));
+    }
+    ret = OB_SUCCESS;
+  } else {
+    const int64_t read_cnt = GCONF._block_cache_snapshot_load_parallelism;
+    const ObMemAttr attr(OB_SERVER_TENANT_ID, ObModIds::OB_BLOCK_CACHE_SNAPSHOT);
+    LoadRead* reads = NULL;
+    void* buf = NULL;
+    if (OB_ISNULL(buf = ob_malloc(sizeof(LoadRead) * read_cnt, attr))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to allocate reads", K(ret), K(read_cnt));
+    } else {
+      reads = new (buf) LoadRead[read_cnt];
+      for (int64_t i = 0; OB_SUCC(ret) && i < item_cnt; i += LOAD_BATCH_SIZE) {
+        if (OB_FAIL(load_batch(items + i, min(LOAD_BATCH_SIZE, item_cnt - i), reads, read_cnt, start_ts))) {
+          LOG_WARN("stop loading block cache snapshot", K(ret), K(i), K(item_cnt));
+        }
+      }
+      for (int64_t i = 0; i < read_cnt; ++i) {
+        reads[i].~LoadRead();
+      }
+      ob_free(buf);
+    }
+    LOG_INFO("finish loading block cache snapshot",
+        K(ret),
+        K(item_cnt),
+        K_(load_cnt),
+        K_(skip_cnt),
+        "cost_us",
+        ObTimeUtility::current_time() - start_ts);
+    // the block cache is warmed up as much as possible, the rest is filled by queries
+    ret = OB_SUCCESS;
+  }
+  if (NULL != items) {
+    ob_free(items);
+    items = NULL;
+  }
+
+  if (OB_SUCC(ret)) {
+    last_dump_ts_ = ObTimeUtility::current_time();
+    if (OB_FAIL(lib::ThreadPool::start())) {
+      LOG_WARN("fail to start block cache snapshot thread", K(ret));
+    } else {
+      is_started_ = true;
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockCacheSnapshot::load_batch(ObBlockCacheSnapshotItem* items, const int64_t item_cnt, LoadRead* reads,
+    const int64_t read_cnt, const int64_t start_ts)
+{
+  int ret = OB_SUCCESS;
+  char compressor_name[OB_MAX_HEADER_COMPRESSOR_NAME_LENGTH];
+  bool is_block_valid = false;
+  uint64_t block_table_id = OB_INVALID_ID;
+  // reads in [head, tail) are in flight
+  int64_t head = 0;
+  int64_t tail = 0;
+  // read each macro block header once and the micro blocks in ascending offset
+  std::sort(items, items + item_cnt, compare_by_location);
+  for (int64_t i = 0; OB_SUCC(ret) && i < item_cnt; ++i) {
+    const ObBlockCacheSnapshotItem& item = items[i];
+    const ObMicroBlockCacheKey key(item.table_id_, item.block_id_, item.file_id_, item.offset_, item.size_);
+    const ObMicroBlockCacheValue* value = NULL;
+    ObKVCacheHandle handle;
+    if (ObTimeUtility::current_time() - start_ts > MAX_LOAD_TIME_US) {
+      ret = OB_TIMEOUT;
+      LOG_WARN("loading block cache snapshot takes too long", K(ret), K(start_ts));
+    } else if (observer::SS_STOPPING == GCTX.status_ || observer::SS_STOPPED == GCTX.status_) {
+      ret = OB_SERVER_IS_STOPPING;
+      LOG_WARN("server is stopping", K(ret));
+    } else {
+      if (0 == i || item.block_id_ != items[i - 1].block_id_) {
+        is_block_valid = OB_SUCCESS == read_compressor(item.block_id_, block_table_id, compressor_name);
+      }
+      if (!is_block_valid || item.table_id_ != block_table_id) {
+        // the macro block has been freed or reused by another table
+        ++skip_cnt_;
+      } else if (OB_SUCCESS == block_cache_->get(key, value, handle)) {
+        // already cached
+      } else {
+        if (tail - head >= read_cnt) {
+          (void)finish_read(reads[head % read_cnt]);
+          ++head;
+        }
+        LoadRead& read = reads[tail % read_cnt];
+        if (OB_FAIL(async_read(item.block_id_, item.offset_, item.size_, read.io_handle_))) {
+          LOG_WARN("fail to read micro block", K(ret), K(item));
+          ++skip_cnt_;
+          ret = OB_SUCCESS;
+        } else {
+          read.item_ = &item;
+          STRNCPY(read.compressor_name_, compressor_name, sizeof(read.compressor_name_));
+          ++tail;
+        }
+      }
+    }
+  }
+  for (; head < tail; ++head) {
+    (void)finish_read(reads[head % read_cnt]);
+  }
+  return ret;
+}
+
+int ObMicroBlockCacheSnapshot::read_compressor(
+    const MacroBlockId& block_id, uint64_t& table_id, char* compressor_name)
+{
+  int ret = OB_SUCCESS;
+  ObIOHandle io_handle;
+  ObMacroBlockCommonHeader common_header;
+  int64_t pos = 0;
+  table_id = OB_INVALID_ID;
+  if (!is_block_in_use(block_id)) {
+    ret = OB_ENTRY_NOT_EXIST;
+  } else if (OB_FAIL(async_read(block_id, 0, MACRO_HEADER_READ_SIZE, io_handle))) {
+    LOG_WARN("fail to read macro block header", K(ret), K(block_id));
+  } else if (OB_FAIL(io_handle.wait(IO_TIMEOUT_MS))) {
+    LOG_WARN("fail to wait macro block header", K(ret), K(block_id));
+  } else if (OB_FAIL(common_header.deserialize(io_handle.get_buffer(), io_handle.get_data_size(), pos))) {
+    LOG_WARN("fail to deserialize common header", K(ret), K(block_id));
+  } else if (!common_header.is_sstable_data_block() ||
+             pos + static_cast<int64_t>(sizeof(ObSSTableMacroBlockHeader)) > io_handle.get_data_size()) {
+    ret = OB_ENTRY_NOT_EXIST;
+  } else {
+    const ObSSTableMacroBlockHeader* sstable_header =
+        reinterpret_cast<const ObSSTableMacroBlockHeader*>(io_handle.get_buffer() + pos);
+    if (SSTABLE_DATA_HEADER_MAGIC != sstable_header->magic_) {
+      ret = OB_ENTRY_NOT_EXIST;
+    } else {
+      table_id = sstable_header->table_id_;
+      STRNCPY(compressor_name, sstable_header->compressor_name_, OB_MAX_HEADER_COMPRESSOR_NAME_LENGTH);
+      compressor_name[OB_MAX_HEADER_COMPRESSOR_NAME_LENGTH - 1] = '\0';
+    }
+  }
+  return ret;
+}
+
+bool ObMicroBlockCacheSnapshot::is_block_in_use(const MacroBlockId& block_id)
+{
+  bool is_free = true;
+  const int64_t block_index = block_id.block_index();
+  if (block_index < ObStoreFileSystem::RESERVED_MACRO_BLOCK_INDEX ||
+      block_index >= OB_FILE_SYSTEM.get_total_macro_block_count()) {
+    is_free = true;
+  } else if (OB_SUCCESS != OB_STORE_FILE.is_free_block(block_index, is_free)) {
+    is_free = true;
+  }
+  return !is_free;
+}
+
+int ObMicroBlockCacheSnapshot::async_read(
+    const MacroBlockId& block_id, const int64_t offset, const int64_t size, ObIOHandle& io_handle)
+{
+  int ret = OB_SUCCESS;
+  // the blocks are not read through an sstable, only the macro block id of the context is used
+  ObMacroBlockCtx block_ctx;
+  ObStoreFileReadInfo read_info;
+  block_ctx.sstable_block_id_.macro_block_id_ = block_id;
+  read_info.macro_block_ctx_ = &block_ctx;
+  read_info.offset_ = offset;
+  read_info.size_ = size;
+  read_info.io_desc_.category_ = PREWARM_IO;
+  read_info.io_desc_.wait_event_no_ = ObWaitEventIds::DB_FILE_DATA_READ;
+  if (OB_FAIL(OB_FILE_SYSTEM.async_read(read_info, io_handle))) {
+    LOG_WARN("fail to async read", K(ret), K(block_id), K(offset), K(size));
+  }
+  return ret;
+}
+
+int ObMicroBlockCacheSnapshot::finish_read(LoadRead& read)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(read.item_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("read item is null", K(ret));
+  } else if (OB_FAIL(read.io_handle_.wait(IO_TIMEOUT_MS))) {
+    LOG_WARN("fail to wait micro block", K(ret), K(*read.item_));
+  } else if (OB_UNLIKELY(read.io_handle_.get_data_size() < read.item_->size_)) {
+    ret = OB_IO_ERROR;
+    LOG_WARN("micro block is not completely read", K(ret), K(*read.item_), "size", read.io_handle_.get_data_size());
+  } else if (OB_FAIL(put_block(*read.item_, read.compressor_name_, read.io_handle_.get_buffer()))) {
+    LOG_WARN("fail to put micro block", K(ret), K(*read.item_));
+  }
+  if (OB_SUCC(ret)) {
+    ++load_cnt_;
+  } else {
+    ++skip_cnt_;
+  }
+  read.io_handle_.reset();
+  read.item_ = NULL;
+  return ret;
+}
+
+int ObMicroBlockCacheSnapshot::put_block(
+    const ObBlockCacheSnapshotItem& item, const char* compressor_name, const char* buf)
+{
+  int ret = OB_SUCCESS;
+  const ObMicroBlockCacheKey key(item.table_id_, item.block_id_, item.file_id_, item.offset_, item.size_);
+  const char* payload_buf = NULL;
+  int64_t payload_size = 0;
+  if (OB_FAIL(ObRecordHeaderV3::deserialize_and_check_record(
+          buf, item.size_, MICRO_BLOCK_HEADER_MAGIC, payload_buf, payload_size))) {
+    // not an error, the macro block may have been rewritten since the snapshot
+    LOG_WARN("micro block does not match the snapshot", K(ret), K(item));
+  } else {
+    const int64_t data_length = reinterpret_cast<const ObRecordHeaderV3::ObRecordCommonHeader*>(buf)->data_length_;
+    ObKVCachePair* kvpair = NULL;
+    ObKVCacheHandle handle;
+    ObKVCacheInstHandle inst_handle;
+    const bool overwrite = false;
+    // the blocks of the snapshot are known to be hot, bypass the admission policy
+    if (OB_FAIL(block_cache_->alloc(key.get_tenant_id(),
+            sizeof(ObMicroBlockCacheKey),
+            sizeof(ObMicroBlockCacheValue) + data_length,
+            kvpair,
+            handle,
+            inst_handle))) {
+      LOG_WARN("failed to alloc cache buf", K(ret));
+    } else {
+      char* block_buf = reinterpret_cast<char*>(kvpair->value_) + sizeof(ObMicroBlockCacheValue);
+      new (kvpair->key_) ObMicroBlockCacheKey(key);
+      ObMicroBlockCacheValue* cache_value = new (kvpair->value_) ObMicroBlockCacheValue(block_buf, data_length);
+      if (OB_FAIL(reader_.decompress_data_with_prealloc_buf(
+              compressor_name, payload_buf, payload_size, block_buf, data_length))) {
+        LOG_WARN("failed to decompress_data_with_prealloc_buf", K(ret), K(item));
+        // the abandoned kv pair must not be passed to the wash callback
+        cache_value->get_block_data().reset();
+      } else if (OB_FAIL(block_cache_->put_kvpair(inst_handle, kvpair, handle, overwrite))) {
+        if (OB_ENTRY_EXIST != ret) {
+          LOG_WARN("failed to put micro block cache", K(ret));
+        } else {
+          ret = OB_SUCCESS;
+        }
+      } else {
+        const int64_t put_size = ObKVStoreMemBlock::get_align_size(key, *cache_value);
+        if (OB_FAIL(block_cache_->add_put_size(put_size))) {
+          LOG_WARN("add_put_size failed", K(ret), K(put_size));
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockCacheSnapshot::dump()
+{
+  int ret = OB_SUCCESS;
+  const int64_t start_ts = ObTimeUtility::current_time();
+  const int64_t max_cnt = GCONF._block_cache_snapshot_max_block_count;
+  const ObMemAttr attr(OB_SERVER_TENANT_ID, ObModIds::OB_BLOCK_CACHE_SNAPSHOT);
+  ObBlockCacheSnapshotItem* items = NULL;
+  int64_t item_cnt = 0;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("block cache snapshot has not been inited", K(ret));
+  } else if (OB_ISNULL(items = static_cast<ObBlockCacheSnapshotItem*>(
+                           ob_malloc(sizeof(ObBlockCacheSnapshotItem) * max_cnt * 2, attr)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to allocate snapshot items", K(ret), K(max_cnt));
+  } else if (OB_FAIL(collect_items(max_cnt, items, item_cnt))) {
+    LOG_WARN("fail to collect snapshot items", K(ret));
+  } else if (OB_FAIL(write_file(items, item_cnt))) {
+    LOG_WARN("fail to write block cache snapshot", K(ret), K_(file_path));
+  } else {
+    ++dump_cnt_;
+    LOG_INFO("succeed to dump block cache snapshot",
+        K(item_cnt),
+        K_(dump_cnt),
+        K_(file_path),
+        "cost_us",
+        ObTimeUtility::current_time() - start_ts);
+  }
+  if (NULL != items) {
+    ob_free(items);
+    items = NULL;
+  }
+  return ret;
+}
+
+int ObMicroBlockCacheSnapshot::collect_items(
+    const int64_t max_cnt, ObBlockCacheSnapshotItem* items, int64_t& item_cnt)
+{
+  int ret = OB_SUCCESS;
+  ObKVCacheIterator iter;
+  item_cnt = 0;
+  if (OB_FAIL(block_cache_->get_iterator(iter))) {
+    LOG_WARN("fail to get block cache iterator", K(ret));
+  }
+  while (OB_SUCC(ret)) {
+    const ObMicroBlockCacheKey* key = NULL;
+    const ObMicroBlockCacheValue* value = NULL;
+    int64_t get_cnt = 0;
+    ObKVCacheHandle handle;
+    if (OB_FAIL(iter.get_next_kvpair(key, value, get_cnt, handle))) {
+      if (OB_ITER_END != ret) {
+        LOG_WARN("fail to get next kvpair", K(ret));
+      }
+    } else {
+      ObBlockCacheSnapshotItem& item = items[item_cnt++];
+      item.table_id_ = key->table_id_;
+      item.block_id_ = key->block_id_;
+      item.file_id_ = key->file_id_;
+      item.offset_ = key->offset_;
+      item.size_ = key->size_;
+      item.get_cnt_ = get_cnt;
+      handle.reset();
+      if (item_cnt >= max_cnt * 2) {
+        // keep the hottest half
+        std::nth_element(items, items + max_cnt, items + item_cnt, compare_by_hotness);
+        item_cnt = max_cnt;
+      }
+    }
+  }
+  if (OB_ITER_END == ret) {
+    ret = OB_SUCCESS;
+    if (item_cnt > max_cnt) {
+      std::nth_element(items, items + max_cnt, items + item_cnt, compare_by_hotness);
+      item_cnt = max_cnt;
+    }
+    std::sort(items, items + item_cnt, compare_by_hotness);
+  }
+  return ret;
+}
+
+int ObMicroBlockCacheSnapshot::write_file(const ObBlockCacheSnapshotItem* items, const int64_t item_cnt)
+{
+  int ret = OB_SUCCESS;
+  char tmp_path[OB_MAX_FILE_NAME_LENGTH];
+  ObBlockCacheSnapshotHeader header;
+  const int64_t items_size = sizeof(ObBlockCacheSnapshotItem) * item_cnt;
+  int fd = -1;
+  header.item_cnt_ = item_cnt;
+  header.items_checksum_ = static_cast<int64_t>(ob_crc64(items, items_size));
+  header.snapshot_ts_ = ObTimeUtility::current_time();
+  if (OB_FAIL(databuff_printf(tmp_path, sizeof(tmp_path), "%s.tmp", file_path_))) {
+    LOG_WARN("snapshot file path is too long", K(ret), K_(file_path));
+  } else if ((fd = ::open(tmp_path, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR | S_IRGRP)) < 0) {
+    ret = OB_IO_ERROR;
+    LOG_WARN("fail to create snapshot file", K(ret), K(tmp_path), KERRMSG);
+  } else {
+    if (static_cast<int64_t>(sizeof(header)) != ::write(fd, &header, sizeof(header))) {
+      ret = OB_IO_ERROR;
+      LOG_WARN("fail to write snapshot header", K(ret), K(tmp_path), KERRMSG);
+    } else if (items_size > 0 && items_size != ::write(fd, items, items_size)) {
+      ret = OB_IO_ERROR;
+      LOG_WARN("fail to write snapshot items", K(ret), K(tmp_path), K(items_size), KERRMSG);
+    } else if (0 != ::fsync(fd)) {
+      ret = OB_IO_ERROR;
+      LOG_WARN("fail to fsync snapshot file", K(ret), K(tmp_path), KERRMSG);
+    }
+    if (0 != ::close(fd)) {
+      ret = OB_SUCC(ret) ? OB_IO_ERROR : ret;
+      LOG_WARN("fail to close snapshot file", K(ret), K(tmp_path), KERRMSG);
+    }
+  }
+  // replace the old snapshot atomically
+  if (OB_SUCC(ret) && 0 != ::rename(tmp_path, file_path_)) {
+    ret = OB_IO_ERROR;
+    LOG_WARN("fail to rename snapshot file", K(ret), K(tmp_path), K_(file_path), KERRMSG);
+  }
+  return ret;
+}
+
+int ObMicroBlockCacheSnapshot::read_file(ObBlockCacheSnapshotItem*& items, int64_t& item_cnt)
+{
+  int ret = OB_SUCCESS;
+  ObBlockCacheSnapshotHeader header;
+  int fd = -1;
+  items = NULL;
+  item_cnt = 0;
+  if ((fd = ::open(file_path_, O_RDONLY)) < 0) {
+    ret = ENOENT == errno ? OB_ENTRY_NOT_EXIST : OB_IO_ERROR;
+    if (OB_ENTRY_NOT_EXIST != ret) {
+      LOG_WARN("fail to open snapshot file", K(ret), K_(file_path), KERRMSG);
+    }
+  } else {
+    if (static_cast<int64_t>(sizeof(header)) != ::pread(fd, &header, sizeof(header), 0)) {
+      ret = OB_IO_ERROR;
+      LOG_WARN("fail to read snapshot header", K(ret), K_(file_path), KERRMSG);
+    } else if (!header.is_valid()) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("invalid snapshot header", K(ret), K(header));
+    } else if (0 == header.item_cnt_) {
+      // empty block cache
+    } else {
+      const int64_t items_size = sizeof(ObBlockCacheSnapshotItem) * header.item_cnt_;
+      const ObMemAttr attr(OB_SERVER_TENANT_ID, ObModIds::OB_BLOCK_CACHE_SNAPSHOT);
+      if (OB_ISNULL(items = static_cast<ObBlockCacheSnapshotItem*>(ob_malloc(items_size, attr)))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("fail to allocate snapshot items", K(ret), K(header));
+      } else if (items_size != ::pread(fd, items, items_size, sizeof(header))) {
+        ret = OB_IO_ERROR;
+        LOG_WARN("fail to read snapshot items", K(ret), K(header), KERRMSG);
+      } else if (header.items_checksum_ != static_cast<int64_t>(ob_crc64(items, items_size))) {
+        ret = OB_CHECKSUM_ERROR;
+        LOG_WARN("snapshot items checksum error", K(ret), K(header));
+      } else {
+        item_cnt = header.item_cnt_;
+        LOG_INFO("succeed to read block cache snapshot", K(header));
+      }
+      if (OB_FAIL(ret) && NULL != items) {
+        ob_free(items);
+        items = NULL;
+      }
+    }
+    ::close(fd);
+  }
+  return ret;
+}
+
+void ObMicroBlockCacheSnapshot::run1()
+{
+  int ret = OB_SUCCESS;
+  lib::set_thread_name("BlkCacheSnap");
+  while (!has_set_stop()) {
+    const int64_t interval = GCONF._block_cache_snapshot_interval;
+    if (ObTimeUtility::current_time() - last_dump_ts_ >= interval) {
+      if (OB_FAIL(dump())) {
+        LOG_WARN("fail to dump block cache snapshot", K(ret));
+      }
+      last_dump_ts_ = ObTimeUtility::current_time();
+    }
+    usleep(CHECK_INTERVAL_US);
+  }
+}
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
@@ -0,0 +1,130 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_CACHE_SNAPSHOT_H_
+#define OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_CACHE_SNAPSHOT_H_
+
+#include "lib/io/ob_io_manager.h"
+#include "lib/thread/thread_pool.h"
+#include "ob_micro_block_cache.h"
+
+namespace oceanbase {
+namespace blocksstable {
+
+// Header of the snapshot file, followed by %item_cnt_ items in descending order of hotness.
+struct ObBlockCacheSnapshotHeader {
+  static const int32_t SNAPSHOT_MAGIC = 0x42435350;  // "BCSP"
+  static const int32_t SNAPSHOT_VERSION = 1;
+  ObBlockCacheSnapshotHeader();
+  bool is_valid() const
+  {
+    return SNAPSHOT_MAGIC == magic_ && SNAPSHOT_VERSION == version_ && item_cnt_ >= 0;
+  }
+  TO_STRING_KV(K_(magic), K_(version), K_(item_cnt), K_(items_checksum), K_(snapshot_ts));
+
+  int32_t magic_;
+  int32_t version_;
+  int64_t item_cnt_;
+  int64_t items_checksum_;
+  int64_t snapshot_ts_;
+};
+
+// ObMicroBlockCacheKey of a cached micro block and its get count
+struct ObBlockCacheSnapshotItem {
+  ObBlockCacheSnapshotItem() : table_id_(0), block_id_(), file_id_(0), offset_(0), size_(0), get_cnt_(0)
+  {}
+  TO_STRING_KV(K_(table_id), K_(block_id), K_(file_id), K_(offset), K_(size), K_(get_cnt));
+
+  uint64_t table_id_;
+  MacroBlockId block_id_;
+  int64_t file_id_;
+  int64_t offset_;
+  int64_t size_;
+  int64_t get_cnt_;
+};
+
+// Persistent snapshot of the user block cache for warm restart.
+//
+// A background thread periodically writes the keys of the most frequently read micro blocks in the block cache
+// to a local file, only the keys are written, not the data. When the observer restarts, load() reads those
+// micro blocks from the data file with a bounded number of reads in flight and puts them into the block cache
+// before the server starts service. Blocks freed or reused since the snapshot are skipped by checking the
+// macro block header and the micro block record, so a stale snapshot costs some reads but never wrong data.
+class ObMicroBlockCacheSnapshot : public lib::ThreadPool {
+public:
+  static const int64_t LOAD_BATCH_SIZE = 1024;
+  static const int64_t MAX_LOAD_TIME_US = 10L * 60L * 1000L * 1000L;
+  static const int64_t IO_TIMEOUT_MS = 10L * 1000L;
+  static const int64_t MACRO_HEADER_READ_SIZE = DIO_READ_ALIGN_SIZE;
+  static const int64_t CHECK_INTERVAL_US = 1000L * 1000L;
+
+public:
+  ObMicroBlockCacheSnapshot();
+  virtual ~ObMicroBlockCacheSnapshot();
+  int init(const char* file_path, ObMicroBlockCache& block_cache);
+  // write a final snapshot if the snapshot thread has been started
+  void destroy();
+  // Read the micro blocks of the snapshot file into the block cache, then start the snapshot thread. Blocks that
+  // can not be read back are skipped, only failures of the snapshot thread are returned.
+  int load();
+  // write the keys of the hottest micro blocks in the block cache to the snapshot file
+  int dump();
+  virtual void run1() override;
+  inline bool is_inited() const
+  {
+    return is_inited_;
+  }
+  TO_STRING_KV(K_(is_inited), K_(is_started), K_(file_path), K_(load_cnt), K_(skip_cnt), K_(dump_cnt));
+
+private:
+  struct LoadRead {
+    LoadRead() : item_(NULL), io_handle_()
+    {
+      compressor_name_[0] = '\0';
+    }
+    const ObBlockCacheSnapshotItem* item_;
+    char compressor_name_[common::OB_MAX_HEADER_COMPRESSOR_NAME_LENGTH];
+    common::ObIOHandle io_handle_;
+  };
+
+  int read_file(ObBlockCacheSnapshotItem*& items, int64_t& item_cnt);
+  int write_file(const ObBlockCacheSnapshotItem* items, const int64_t item_cnt);
+  int collect_items(const int64_t max_cnt, ObBlockCacheSnapshotItem* items, int64_t& item_cnt);
+  int load_batch(ObBlockCacheSnapshotItem* items, const int64_t item_cnt, LoadRead* reads, const int64_t read_cnt,
+      const int64_t start_ts);
+  // read the table id and compressor of a macro block in use from its header
+  int read_compressor(const MacroBlockId& block_id, uint64_t& table_id, char* compressor_name);
+  int async_read(const MacroBlockId& block_id, const int64_t offset, const int64_t size, common::ObIOHandle& handle);
+  int finish_read(LoadRead& read);
+  int put_block(const ObBlockCacheSnapshotItem& item, const char* compressor_name, const char* buf);
+  bool is_block_in_use(const MacroBlockId& block_id);
+
+private:
+  bool is_inited_;
+  bool is_started_;
+  char file_path_[common::OB_MAX_FILE_NAME_LENGTH];
+  ObMicroBlockCache* block_cache_;
+  ObMacroBlockReader reader_;
+  int64_t last_dump_ts_;
+  // statistics
+  int64_t load_cnt_;
+  int64_t skip_cnt_;
+  int64_t dump_cnt_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObMicroBlockCacheSnapshot);
+};
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
+
+#endif  // OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_CACHE_SNAPSHOT_H_
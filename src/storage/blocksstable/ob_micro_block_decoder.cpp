@@ -0,0 +1,751 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_micro_block_decoder.h"
+#include "lib/container/ob_bitmap.h"
+#include "storage/ob_i_store.h"
+#include "storage/ob_sstable_rowkey_helper.h"
+#include "sql/engine/basic/ob_pushdown_filter.h"
+#include "ob_column_map.h"
+#include "ob_row_reader.h"
+
+namespace oceanbase {
+using namespace common;
+using namespace storage;
+namespace blocksstable {
+/**
+ * -------------------------------------------------------ObColumnDecoder--------------------------------------------------------------
+ */
+ObColumnDecoder::ObColumnDecoder()
+    : header_(NULL),
+      data_(NULL),
+      row_count_(0),
+      offsets_(NULL),
+      values_(NULL),
+      run_starts_(NULL),
+      null_bitmap_(NULL),
+      packed_(NULL),
+      int_base_(0)
+{}
+
+int ObColumnDecoder::init(
+    const char* block_buf, const int64_t block_size, const ObColumnEncodingHeader& header, const int64_t row_count)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(NULL == block_buf || !header.is_valid() || header.offset_ + header.length_ > block_size ||
+                  row_count <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(block_buf), K(block_size), K(header), K(row_count));
+  } else {
+    header_ = &header;
+    data_ = block_buf + header.offset_;
+    row_count_ = row_count;
+    switch (header.type_) {
+      case OB_COLUMN_ENCODING_RAW: {
+        offsets_ = reinterpret_cast<const int32_t*>(data_);
+        values_ = data_ + sizeof(int32_t) * (row_count + 1);
+        break;
+      }
+      case OB_COLUMN_ENCODING_CONST: {
+        values_ = data_;
+        break;
+      }
+      case OB_COLUMN_ENCODING_DICT:
+      case OB_COLUMN_ENCODING_RLE: {
+        offsets_ = reinterpret_cast<const int32_t*>(data_);
+        values_ = data_ + sizeof(int32_t) * (header.count_ + 1);
+        if (OB_COLUMN_ENCODING_RLE == header.type_) {
+          run_starts_ = reinterpret_cast<const int32_t*>(values_ + offsets_[header.count_]);
+          packed_ = reinterpret_cast<const char*>(run_starts_ + header.run_count_);
+        } else {
+          packed_ = values_ + offsets_[header.count_];
+        }
+        break;
+      }
+      case OB_COLUMN_ENCODING_INTEGER: {
+        MEMCPY(&int_base_, data_, sizeof(int_base_));
+        const char* ptr = data_ + sizeof(int_base_);
+        if (header.has_null_) {
+          null_bitmap_ = ptr;
+          ptr += ObNullBitmap::get_size(row_count);
+        }
+        packed_ = ptr;
+        break;
+      }
+      case OB_COLUMN_ENCODING_STRING_PREFIX: {
+        // prefix is at the beginning of column data
+        const char* ptr = data_ + header.count_;
+        if (header.has_null_) {
+          null_bitmap_ = ptr;
+          ptr += ObNullBitmap::get_size(row_count);
+        }
+        offsets_ = reinterpret_cast<const int32_t*>(ptr);
+        values_ = ptr + sizeof(int32_t) * (row_count + 1);
+        break;
+      }
+      default:
+        ret = OB_INVALID_DATA;
+        LOG_WARN("unknown column encoding type", K(ret), K(header));
+    }
+  }
+  return ret;
+}
+
+int64_t ObColumnDecoder::get_ref(const int64_t row_idx) const
+{
+  int64_t ref = 0;
+  if (OB_COLUMN_ENCODING_DICT == header_->type_) {
+    ref = ObBitPacking::unpack(packed_, row_idx, header_->width_);
+  } else if (OB_COLUMN_ENCODING_RLE == header_->type_) {
+    const int64_t run = std::upper_bound(run_starts_, run_starts_ + header_->run_count_, row_idx) - run_starts_ - 1;
+    ref = ObBitPacking::unpack(packed_, run, header_->width_);
+  }
+  return ref;
+}
+
+int ObColumnDecoder::decode_dict(const int64_t dict_idx, ObObj& cell) const
+{
+  int ret = OB_SUCCESS;
+  int64_t pos = 0;
+  if (OB_COLUMN_ENCODING_CONST == header_->type_) {
+    if (OB_FAIL(cell.deserialize(values_, header_->length_, pos))) {
+      LOG_WARN("fail to deserialize const value", K(ret), KPC_(header));
+    }
+  } else if (OB_UNLIKELY(dict_idx < 0 || dict_idx >= header_->count_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid dictionary index", K(ret), K(dict_idx), KPC_(header));
+  } else if (OB_FAIL(cell.deserialize(
+                 values_ + offsets_[dict_idx], offsets_[dict_idx + 1] - offsets_[dict_idx], pos))) {
+    LOG_WARN("fail to deserialize dictionary value", K(ret), K(dict_idx), KPC_(header));
+  }
+  return ret;
+}
+
+int ObColumnDecoder::decode(const int64_t row_idx, ObIAllocator& allocator, ObObj& cell) const
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(row_idx < 0 || row_idx >= row_count_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid row index", K(ret), K(row_idx), K_(row_count));
+  } else {
+    switch (header_->type_) {
+      case OB_COLUMN_ENCODING_RAW: {
+        int64_t pos = 0;
+        if (OB_FAIL(cell.deserialize(values_ + offsets_[row_idx], offsets_[row_idx + 1] - offsets_[row_idx], pos))) {
+          LOG_WARN("fail to deserialize value", K(ret), K(row_idx), KPC_(header));
+        }
+        break;
+      }
+      case OB_COLUMN_ENCODING_CONST:
+      case OB_COLUMN_ENCODING_DICT:
+      case OB_COLUMN_ENCODING_RLE: {
+        if (OB_FAIL(decode_dict(get_ref(row_idx), cell))) {
+          LOG_WARN("fail to decode dictionary value", K(ret), K(row_idx));
+        }
+        break;
+      }
+      case OB_COLUMN_ENCODING_INTEGER: {
+        if (NULL != null_bitmap_ && ObNullBitmap::test(null_bitmap_, row_idx)) {
+          cell.set_null();
+        } else {
+          cell.reset();
+          cell.meta_ = header_->meta_;
+          cell.v_.uint64_ = int_base_ + ObBitPacking::unpack(packed_, row_idx, header_->width_);
+        }
+        break;
+      }
+      case OB_COLUMN_ENCODING_STRING_PREFIX: {
+        if (NULL != null_bitmap_ && ObNullBitmap::test(null_bitmap_, row_idx)) {
+          cell.set_null();
+        } else {
+          const int64_t prefix_len = header_->count_;
+          const int64_t suffix_len = offsets_[row_idx + 1] - offsets_[row_idx];
+          const char* suffix = values_ + offsets_[row_idx];
+          const char* ptr = suffix;
+          if (prefix_len > 0) {
+            char* buf = static_cast<char*>(allocator.alloc(prefix_len + suffix_len));
+            if (OB_ISNULL(buf)) {
+              ret = OB_ALLOCATE_MEMORY_FAILED;
+              LOG_WARN("fail to allocate memory", K(ret), K(prefix_len), K(suffix_len));
+            } else {
+              MEMCPY(buf, data_, prefix_len);
+              MEMCPY(buf + prefix_len, suffix, suffix_len);
+              ptr = buf;
+            }
+          }
+          if (OB_SUCC(ret)) {
+            cell.reset();
+            cell.meta_ = header_->meta_;
+            cell.v_.string_ = ptr;
+            cell.val_len_ = static_cast<int32_t>(prefix_len + suffix_len);
+          }
+        }
+        break;
+      }
+      default:
+        ret = OB_INVALID_DATA;
+        LOG_WARN("unknown column encoding type", K(ret), KPC_(header));
+    }
+  }
+  return ret;
+}
+
+/**
+ * -------------------------------------------------------ObEncodedMicroBlock--------------------------------------------------------------
+ */
+ObEncodedMicroBlock::ObEncodedMicroBlock()
+    : header_(NULL), row_metas_(NULL), same_row_meta_(false), decoders_(NULL)
+{}
+
+void ObEncodedMicroBlock::reset()
+{
+  // decoders are allocated by the allocator of init()
+  header_ = NULL;
+  row_metas_ = NULL;
+  same_row_meta_ = false;
+  decoders_ = NULL;
+}
+
+int ObEncodedMicroBlock::init(const ObMicroBlockData& block_data, ObIAllocator& allocator)
+{
+  int ret = OB_SUCCESS;
+  reset();
+  if (OB_UNLIKELY(!block_data.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(block_data));
+  } else {
+    const char* buf = block_data.get_buf();
+    const int64_t size = block_data.get_buf_size();
+    const ObMicroBlockHeader* header = reinterpret_cast<const ObMicroBlockHeader*>(buf);
+    const int64_t col_headers_size = sizeof(ObColumnEncodingHeader) * header->column_count_;
+    void* decoders_buf = NULL;
+    if (OB_UNLIKELY(!header->is_valid() || header->row_count_ <= 0 || header->column_count_ <= 0 ||
+                    header->header_size_ + col_headers_size > header->row_index_offset_ ||
+                    header->row_index_offset_ >= size)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("invalid encoded micro block header", K(ret), KPC(header), K(size));
+    } else if (OB_ISNULL(
+                   decoders_buf = allocator.alloc(sizeof(ObColumnDecoder) * header->column_count_))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to allocate column decoders", K(ret), KPC(header));
+    } else {
+      const ObColumnEncodingHeader* col_headers =
+          reinterpret_cast<const ObColumnEncodingHeader*>(buf + header->header_size_);
+      ObColumnDecoder* decoders = new (decoders_buf) ObColumnDecoder[header->column_count_];
+      for (int64_t i = 0; OB_SUCC(ret) && i < header->column_count_; ++i) {
+        if (OB_FAIL(decoders[i].init(buf, size, col_headers[i], header->row_count_))) {
+          LOG_WARN("fail to init column decoder", K(ret), K(i));
+        }
+      }
+      if (OB_SUCC(ret)) {
+        header_ = header;
+        same_row_meta_ = 0 != buf[header->row_index_offset_];
+        row_metas_ = reinterpret_cast<const ObEncodedRowMeta*>(buf + header->row_index_offset_ + sizeof(int8_t));
+        decoders_ = decoders;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObEncodedMicroBlock::get_row(
+    const int64_t row_idx, const ObColumnMap* column_map, ObIAllocator& allocator, ObStoreRow& row) const
+{
+  int ret = OB_SUCCESS;
+  const int64_t column_cnt = NULL == column_map ? get_column_count() : column_map->get_request_count();
+  if (OB_ISNULL(header_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(row_idx < 0 || row_idx >= get_row_count() || NULL == row.row_val_.cells_ ||
+                         row.row_val_.count_ < column_cnt)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(row_idx), K(row), K(column_cnt), KPC_(header));
+  } else {
+    const ObEncodedRowMeta& row_meta = get_row_meta(row_idx);
+    row.is_sparse_row_ = false;
+    row.flag_ = row_meta.flag_;
+    row.set_dml_val(row_meta.dml_);
+    row.row_type_flag_.flag_ = row_meta.row_type_flag_;
+    row.row_val_.count_ = column_cnt;
+    if (NULL == column_map) {
+      for (int64_t i = 0; OB_SUCC(ret) && i < column_cnt; ++i) {
+        if (OB_FAIL(decoders_[i].decode(row_idx, allocator, row.row_val_.cells_[i]))) {
+          LOG_WARN("fail to decode cell", K(ret), K(row_idx), K(i));
+        }
+      }
+    } else {
+      const ObColumnIndexItem* column_indexs = column_map->get_column_indexs();
+      for (int64_t i = 0; OB_SUCC(ret) && i < column_cnt; ++i) {
+        const ObColumnIndexItem& item = column_indexs[i];
+        ObObj& cell = row.row_val_.cells_[i];
+        if (item.store_index_ < 0) {
+          cell.set_nop_value();
+        } else if (OB_UNLIKELY(item.store_index_ >= get_column_count())) {
+          ret = OB_ERR_UNEXPECTED;
+          LOG_WARN("store index out of range", K(ret), K(item), KPC_(header));
+        } else if (OB_FAIL(decoders_[item.store_index_].decode(row_idx, allocator, cell))) {
+          LOG_WARN("fail to decode cell", K(ret), K(row_idx), K(item));
+        } else if (!item.is_column_type_matched_ && !cell.is_null() && !cell.is_nop_value() &&
+                   OB_FAIL(ObIRowReader::cast_obj(item.request_column_type_, allocator, cell))) {
+          LOG_WARN("fail to cast cell", K(ret), K(item), K(cell));
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObEncodedMicroBlock::compare_rowkey(const int64_t row_idx, const ObStoreRowkey& rowkey,
+    const ObSSTableRowkeyHelper* rowkey_helper, ObIAllocator& allocator, int32_t& cmp) const
+{
+  int ret = OB_SUCCESS;
+  const int64_t rowkey_cnt = rowkey.get_obj_cnt();
+  const ObObj* rowkey_obj = rowkey.get_obj_ptr();
+  cmp = 0;
+  if (OB_UNLIKELY(rowkey_cnt > get_column_count())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("rowkey has too many columns", K(ret), K(rowkey), KPC_(header));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && 0 == cmp && i < rowkey_cnt; ++i) {
+    ObObj cell;
+    if (OB_FAIL(decoders_[i].decode(row_idx, allocator, cell))) {
+      LOG_WARN("fail to decode rowkey cell", K(ret), K(row_idx), K(i));
+    } else if (OB_NOT_NULL(rowkey_helper)) {
+      if (OB_FAIL(rowkey_helper->compare_rowkey_obj(i, cell, rowkey_obj[i], cmp))) {
+        LOG_ERROR("fail to compare rowkey cell", K(ret), K(i), K(cell), K(rowkey));
+      }
+    } else {
+      cmp = cell.compare(rowkey_obj[i], CS_TYPE_INVALID);
+    }
+  }
+  return ret;
+}
+
+void ObEncodedMicroBlock::fill_row_header(const int64_t row_idx, ObRowHeader& row_header) const
+{
+  const ObEncodedRowMeta& row_meta = get_row_meta(row_idx);
+  row_header.set_row_flag(row_meta.flag_);
+  row_header.set_row_dml(row_meta.dml_);
+  row_header.set_row_type_flag(row_meta.row_type_flag_);
+  row_header.set_version(ObRowHeader::RHV_NO_TRANS_ID);
+  row_header.set_column_index_bytes(0);
+  row_header.set_column_count(static_cast<int16_t>(get_column_count()));
+}
+
+/**
+ * -------------------------------------------------------ObMicroBlockDecoder--------------------------------------------------------------
+ */
+ObMicroBlockDecoder::ObMicroBlockDecoder() : block_(), allocator_(ObModIds::OB_STORE_ROW_GETTER), row_header_()
+{}
+
+ObMicroBlockDecoder::~ObMicroBlockDecoder()
+{
+  reset();
+}
+
+void ObMicroBlockDecoder::reset()
+{
+  ObIMicroBlockReader::reset();
+  block_.reset();
+  allocator_.reuse();
+}
+
+int ObMicroBlockDecoder::init(
+    const ObMicroBlockData& block_data, const ObColumnMap* column_map, const ObRowStoreType out_type)
+{
+  int ret = OB_SUCCESS;
+  if (is_inited_) {
+    reset();
+  }
+  if (OB_UNLIKELY(NULL == column_map || !column_map->is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("column_map is invalid", K(ret), KP(column_map));
+  } else if (OB_UNLIKELY(FLAT_ROW_STORE != out_type)) {
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("encoded micro block can only be read into flat row", K(ret), K(out_type));
+  } else if (OB_FAIL(block_.init(block_data, allocator_))) {
+    LOG_WARN("fail to init encoded micro block", K(ret), K(block_data));
+  } else {
+    column_map_ = column_map;
+    output_row_type_ = out_type;
+    begin_ = 0;
+    end_ = block_.get_row_count();
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::get_row(const int64_t index, ObStoreRow& row)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(index < 0 || index >= end() || !row.row_val_.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(index), K(row.row_val_));
+  } else if (OB_FAIL(block_.get_row(index, column_map_, allocator_, row))) {
+    LOG_WARN("fail to get row", K(ret), K(index));
+  } else if (0 == index) {
+    row.row_pos_flag_.set_micro_first(true);
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::get_rows(const int64_t begin_index, const int64_t end_index, const int64_t row_capacity,
+    ObStoreRow* rows, int64_t& row_count)
+{
+  int ret = OB_SUCCESS;
+  row_count = 0;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY((begin_index == end_index) ||
+                         (begin_index < end_index && !(begin_index >= begin() && end_index <= end())) ||
+                         (begin_index > end_index && !(end_index >= begin() - 1 && begin_index <= end() - 1)) ||
+                         NULL == rows || row_capacity <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(begin_index), K(end_index), K(begin()), K(end()), KP(rows), K(row_capacity));
+  } else {
+    int64_t row_pos = 0;
+    const int64_t step = begin_index < end_index ? 1 : -1;
+    for (int64_t index = begin_index; OB_SUCC(ret) && index != end_index && row_pos < row_capacity; index += step) {
+      if (OB_FAIL(block_.get_row(index, column_map_, allocator_, rows[row_pos]))) {
+        LOG_WARN("fail to get row", K(ret), K(index), K(row_pos));
+      } else {
+        ++row_pos;
+      }
+    }
+    if (OB_SUCC(ret)) {
+      row_count = row_pos;
+      rows[0].row_pos_flag_.reset();
+      if (0 == begin_index) {
+        rows[0].row_pos_flag_.set_micro_first(true);
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::get_row_count(int64_t& row_count)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else {
+    row_count = block_.get_row_count();
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::get_row_header(const int64_t row_idx, const ObRowHeader*& row_header)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(row_idx < 0 || row_idx >= end())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(row_idx), K(end()));
+  } else {
+    block_.fill_row_header(row_idx, row_header_);
+    row_header = &row_header_;
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::get_multi_version_info(const int64_t row_idx, const int64_t version_column_idx,
+    const int64_t sql_sequence_idx, ObMultiVersionRowFlag& flag, transaction::ObTransID& trans_id,
+    int64_t& trans_version, int64_t& sql_sequence)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(row_idx < begin() || row_idx >= end() || version_column_idx < 0 ||
+                         version_column_idx >= block_.get_column_count() ||
+                         sql_sequence_idx >= block_.get_column_count())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(row_idx), K(version_column_idx), K(sql_sequence_idx), K_(block));
+  } else {
+    // rows with trans id are never encoded
+    trans_id.reset();
+    flag.flag_ = block_.get_row_meta(row_idx).row_type_flag_;
+    ObObj cell;
+    if (!flag.is_uncommitted_row()) {
+      sql_sequence = 0;
+      if (OB_FAIL(block_.decode_cell(version_column_idx, row_idx, allocator_, cell))) {
+        LOG_WARN("fail to decode version column", K(ret), K(row_idx), K(version_column_idx));
+      } else if (OB_FAIL(cell.get_int(trans_version))) {
+        LOG_WARN("fail to convert version cell to int", K(ret), K(cell));
+      } else {
+        trans_version = -trans_version;
+      }
+    } else {
+      trans_version = INT64_MAX;
+      if (sql_sequence_idx < 0) {
+        sql_sequence = 0;
+      } else if (OB_FAIL(block_.decode_cell(sql_sequence_idx, row_idx, allocator_, cell))) {
+        LOG_WARN("fail to decode sql sequence column", K(ret), K(row_idx), K(sql_sequence_idx));
+      } else if (OB_FAIL(cell.get_int(sql_sequence))) {
+        LOG_WARN("fail to convert sql sequence cell to int", K(ret), K(cell));
+      } else {
+        sql_sequence = -sql_sequence;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::filter_pushdown_filter(const sql::ObWhiteFilterExecutor& filter, const int64_t col_idx,
+    const int64_t begin_index, const int64_t row_count, ObBitmap& result_bitmap)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(col_idx < 0 || col_idx >= column_map_->get_request_count() || begin_index < begin() ||
+                         row_count < 0 || begin_index + row_count > end() || result_bitmap.size() < row_count)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument",
+        K(ret),
+        K(col_idx),
+        K(begin_index),
+        K(row_count),
+        K(begin()),
+        K(end()),
+        K(result_bitmap.size()));
+  } else {
+    const ObColumnIndexItem& column_index = column_map_->get_column_indexs()[col_idx];
+    if (column_index.store_index_ < 0 || !column_index.is_column_type_matched_) {
+      // column filled by default value or casted after read, can not be filtered by the stored value.
+      result_bitmap.reuse(true);
+    } else {
+      const ObColumnDecoder& decoder = block_.get_decoder(column_index.store_index_);
+      ObObj cell;
+      bool filtered = false;
+      if (decoder.has_dict() && decoder.get_dict_count() <= row_count) {
+        // evaluate each distinct value once, then set the bitmap by the dictionary reference of rows.
+        const int64_t dict_count = decoder.get_dict_count();
+        bool* dict_filtered = static_cast<bool*>(allocator_.alloc(sizeof(bool) * dict_count));
+        if (OB_ISNULL(dict_filtered)) {
+          ret = OB_ALLOCATE_MEMORY_FAILED;
+          LOG_WARN("fail to allocate memory", K(ret), K(dict_count));
+        }
+        for (int64_t i = 0; OB_SUCC(ret) && i < dict_count; ++i) {
+          if (OB_FAIL(decoder.decode_dict(i, cell))) {
+            LOG_WARN("fail to decode dictionary value", K(ret), K(i));
+          } else if (OB_FAIL(filter.filter(cell, dict_filtered[i]))) {
+            LOG_WARN("fail to filter cell", K(ret), K(i), K(cell));
+          }
+        }
+        for (int64_t i = 0; OB_SUCC(ret) && i < row_count; ++i) {
+          if (!dict_filtered[decoder.get_ref(begin_index + i)] && OB_FAIL(result_bitmap.set(i))) {
+            LOG_WARN("fail to set bitmap", K(ret), K(i));
+          }
+        }
+      } else {
+        for (int64_t i = 0; OB_SUCC(ret) && i < row_count; ++i) {
+          if (OB_FAIL(decoder.decode(begin_index + i, allocator_, cell))) {
+            LOG_WARN("fail to decode cell", K(ret), K(begin_index), K(i));
+          } else if (OB_FAIL(filter.filter(cell, filtered))) {
+            LOG_WARN("fail to filter cell", K(ret), K(i), K(cell));
+          } else if (!filtered && OB_FAIL(result_bitmap.set(i))) {
+            LOG_WARN("fail to set bitmap", K(ret), K(i));
+          }
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+class ObEncodedRowkeyCompare {
+public:
+  ObEncodedRowkeyCompare(int& ret, bool& equal, const ObEncodedMicroBlock& block, ObIAllocator& allocator)
+      : ret_(ret), equal_(equal), block_(block), allocator_(allocator)
+  {}
+  inline bool operator()(const int64_t row_idx, const ObStoreRowkey& rowkey)
+  {
+    return compare(row_idx, rowkey, true);
+  }
+  inline bool operator()(const ObStoreRowkey& rowkey, const int64_t row_idx)
+  {
+    return compare(row_idx, rowkey, false);
+  }
+
+private:
+  inline bool compare(const int64_t row_idx, const ObStoreRowkey& rowkey, const bool lower_bound)
+  {
+    bool bret = false;
+    int& ret = ret_;
+    int32_t compare_result = 0;
+    if (OB_FAIL(ret)) {
+      // do nothing
+    } else if (OB_FAIL(block_.compare_rowkey(row_idx, rowkey, NULL, allocator_, compare_result))) {
+      LOG_WARN("fail to compare rowkey", K(ret), K(row_idx), K(rowkey));
+    } else {
+      bret = lower_bound ? compare_result < 0 : compare_result > 0;
+      if (0 == compare_result) {
+        equal_ = true;
+      }
+    }
+    return bret;
+  }
+
+private:
+  int& ret_;
+  bool& equal_;
+  const ObEncodedMicroBlock& block_;
+  ObIAllocator& allocator_;
+};
+
+int ObMicroBlockDecoder::find_bound(const ObStoreRowkey& key, const bool lower_bound, const int64_t begin_idx,
+    const int64_t end_idx, int64_t& row_idx, bool& equal)
+{
+  int ret = OB_SUCCESS;
+  equal = false;
+  row_idx = ObIMicroBlockReader::INVALID_ROW_INDEX;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(!key.is_valid() || begin_idx < begin() || end_idx > end())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(key), K(begin_idx), K(begin()), K(end_idx), K(end()));
+  } else {
+    ObEncodedRowkeyCompare encoded_compare(ret, equal, block_, allocator_);
+    ObRowIndexIterator begin_iter(begin_idx);
+    ObRowIndexIterator end_iter(end_idx);
+    ObRowIndexIterator found_iter;
+    if (lower_bound) {
+      found_iter = std::lower_bound(begin_iter, end_iter, key, encoded_compare);
+    } else {
+      found_iter = std::upper_bound(begin_iter, end_iter, key, encoded_compare);
+    }
+    if (OB_FAIL(ret)) {
+      LOG_WARN("fail to find bound of rowkey", K(ret), K(key));
+    } else {
+      row_idx = *found_iter;
+    }
+  }
+  return ret;
+}
+
+/**
+ * -------------------------------------------------------ObEncodeBlockGetReader--------------------------------------------------------------
+ */
+ObEncodeBlockGetReader::ObEncodeBlockGetReader() : allocator_(ObModIds::OB_STORE_ROW_GETTER), block_()
+{}
+
+ObEncodeBlockGetReader::~ObEncodeBlockGetReader()
+{}
+
+int ObEncodeBlockGetReader::locate_row(const ObMicroBlockData& block_data, const ObStoreRowkey& rowkey,
+    const ObSSTableRowkeyHelper* rowkey_helper, int64_t& row_idx)
+{
+  int ret = OB_SUCCESS;
+  allocator_.reuse();
+  row_idx = -1;
+  if (OB_FAIL(block_.init(block_data, allocator_))) {
+    LOG_WARN("fail to init encoded micro block", K(ret), K(block_data));
+  } else {
+    int64_t low = 0;
+    int64_t high = block_.get_row_count() - 1;
+    int32_t cmp_result = 0;
+    // binary search
+    while (OB_SUCC(ret) && low <= high) {
+      const int64_t middle = (low + high) >> 1;
+      if (OB_FAIL(block_.compare_rowkey(middle, rowkey, rowkey_helper, allocator_, cmp_result))) {
+        LOG_WARN("fail to compare rowkey", K(ret), K(middle), K(rowkey));
+      } else if (cmp_result > 0) {
+        high = middle - 1;
+      } else if (cmp_result < 0) {
+        low = middle + 1;
+      } else {
+        row_idx = middle;
+        break;
+      }
+    }
+    if (OB_SUCC(ret) && row_idx < 0) {
+      ret = OB_BEYOND_THE_RANGE;
+    }
+  }
+  return ret;
+}
+
+int ObEncodeBlockGetReader::get_row(const uint64_t tenant_id, const ObMicroBlockData& block_data,
+    const ObStoreRowkey& rowkey, const ObColumnMap& column_map, const ObFullMacroBlockMeta& macro_meta,
+    const ObSSTableRowkeyHelper* rowkey_helper, ObStoreRow& row)
+{
+  UNUSED(tenant_id);
+  UNUSED(macro_meta);
+  int ret = OB_SUCCESS;
+  int64_t row_idx = -1;
+  if (OB_FAIL(locate_row(block_data, rowkey, rowkey_helper, row_idx))) {
+    if (OB_BEYOND_THE_RANGE != ret) {
+      LOG_WARN("fail to locate row", K(ret), K(rowkey));
+    }
+  } else if (OB_FAIL(block_.get_row(row_idx, &column_map, allocator_, row))) {
+    LOG_WARN("fail to get row", K(ret), K(rowkey), K(row_idx));
+  }
+  return ret;
+}
+
+int ObEncodeBlockGetReader::get_row(const uint64_t tenant_id, const ObMicroBlockData& block_data,
+    const ObStoreRowkey& rowkey, const ObFullMacroBlockMeta& macro_meta, const ObSSTableRowkeyHelper* rowkey_helper,
+    ObStoreRow& row)
+{
+  UNUSED(tenant_id);
+  int ret = OB_SUCCESS;
+  int64_t row_idx = -1;
+  if (OB_FAIL(locate_row(block_data, rowkey, rowkey_helper, row_idx))) {
+    if (OB_BEYOND_THE_RANGE != ret) {
+      LOG_WARN("fail to locate row", K(ret), K(rowkey));
+    }
+  } else if (OB_UNLIKELY(macro_meta.meta_->column_number_ != block_.get_column_count())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("column count mismatch", K(ret), K(macro_meta), K_(block));
+  } else if (FALSE_IT(row.row_val_.count_ = macro_meta.meta_->column_number_)) {
+  } else if (OB_FAIL(block_.get_row(row_idx, NULL, allocator_, row))) {
+    LOG_WARN("fail to get full row", K(ret), K(rowkey), K(row_idx));
+  }
+  return ret;
+}
+
+int ObEncodeBlockGetReader::exist_row(const uint64_t tenant_id, const ObMicroBlockData& block_data,
+    const ObStoreRowkey& rowkey, const ObFullMacroBlockMeta& macro_meta, const ObSSTableRowkeyHelper* rowkey_helper,
+    bool& exist, bool& found)
+{
+  UNUSED(tenant_id);
+  UNUSED(macro_meta);
+  int ret = OB_SUCCESS;
+  int64_t row_idx = -1;
+  exist = false;
+  found = false;
+  if (OB_FAIL(locate_row(block_data, rowkey, rowkey_helper, row_idx))) {
+    if (OB_BEYOND_THE_RANGE == ret) {
+      ret = OB_SUCCESS;
+    } else {
+      LOG_WARN("fail to locate row", K(ret), K(rowkey));
+    }
+  } else {
+    exist = ObActionFlag::OP_DEL_ROW != block_.get_row_meta(row_idx).flag_;
+    found = true;
+  }
+  return ret;
+}
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
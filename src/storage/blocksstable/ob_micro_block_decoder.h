@@ -0,0 +1,166 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_DECODER_H_
+#define OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_DECODER_H_
+
+#include "lib/allocator/page_arena.h"
+#include "ob_block_sstable_struct.h"
+#include "ob_column_encoding.h"
+#include "ob_imicro_block_reader.h"
+
+namespace oceanbase {
+namespace storage {
+class ObStoreRow;
+class ObSSTableRowkeyHelper;
+}  // namespace storage
+namespace blocksstable {
+class ObColumnMap;
+
+// Decoder of one column of encoded micro block.
+class ObColumnDecoder {
+public:
+  ObColumnDecoder();
+  ~ObColumnDecoder()
+  {}
+  int init(const char* block_buf, const int64_t block_size, const ObColumnEncodingHeader& header,
+      const int64_t row_count);
+  // decode the cell of row %row_idx, %allocator is used by STRING_PREFIX encoding only.
+  int decode(const int64_t row_idx, common::ObIAllocator& allocator, common::ObObj& cell) const;
+
+  // CONST, DICT and RLE encoding has dictionary, the cell of each row is a reference of the dictionary.
+  OB_INLINE bool has_dict() const
+  {
+    return OB_COLUMN_ENCODING_CONST == header_->type_ || OB_COLUMN_ENCODING_DICT == header_->type_ ||
+           OB_COLUMN_ENCODING_RLE == header_->type_;
+  }
+  OB_INLINE int64_t get_dict_count() const
+  {
+    return OB_COLUMN_ENCODING_CONST == header_->type_ ? 1 : header_->count_;
+  }
+  int decode_dict(const int64_t dict_idx, common::ObObj& cell) const;
+  int64_t get_ref(const int64_t row_idx) const;
+
+  TO_STRING_KV(KPC_(header), KP_(data), K_(row_count));
+
+private:
+  const ObColumnEncodingHeader* header_;
+  const char* data_;
+  int64_t row_count_;
+  const int32_t* offsets_;  // offsets of RAW values, dictionary or STRING_PREFIX suffixes
+  const char* values_;
+  const int32_t* run_starts_;
+  const char* null_bitmap_;
+  const char* packed_;
+  uint64_t int_base_;
+};
+
+// Parsed encoded micro block, decoders of all columns.
+class ObEncodedMicroBlock {
+public:
+  ObEncodedMicroBlock();
+  ~ObEncodedMicroBlock()
+  {}
+  int init(const ObMicroBlockData& block_data, common::ObIAllocator& allocator);
+  void reset();
+  OB_INLINE int64_t get_row_count() const
+  {
+    return header_->row_count_;
+  }
+  OB_INLINE int64_t get_column_count() const
+  {
+    return header_->column_count_;
+  }
+  OB_INLINE const ObEncodedRowMeta& get_row_meta(const int64_t row_idx) const
+  {
+    return same_row_meta_ ? row_metas_[0] : row_metas_[row_idx];
+  }
+  OB_INLINE const ObColumnDecoder& get_decoder(const int64_t col_idx) const
+  {
+    return decoders_[col_idx];
+  }
+  OB_INLINE int decode_cell(
+      const int64_t col_idx, const int64_t row_idx, common::ObIAllocator& allocator, common::ObObj& cell) const
+  {
+    return decoders_[col_idx].decode(row_idx, allocator, cell);
+  }
+  // read the columns of %column_map, or all stored columns if %column_map is NULL.
+  int get_row(const int64_t row_idx, const ObColumnMap* column_map, common::ObIAllocator& allocator,
+      storage::ObStoreRow& row) const;
+  int compare_rowkey(const int64_t row_idx, const common::ObStoreRowkey& rowkey,
+      const storage::ObSSTableRowkeyHelper* rowkey_helper, common::ObIAllocator& allocator, int32_t& cmp) const;
+  void fill_row_header(const int64_t row_idx, ObRowHeader& row_header) const;
+
+  TO_STRING_KV(KPC_(header), K_(same_row_meta), KP_(decoders));
+
+private:
+  const ObMicroBlockHeader* header_;
+  const ObEncodedRowMeta* row_metas_;
+  bool same_row_meta_;
+  ObColumnDecoder* decoders_;
+};
+
+class ObMicroBlockDecoder : public ObIMicroBlockReader {
+public:
+  ObMicroBlockDecoder();
+  virtual ~ObMicroBlockDecoder();
+  virtual int init(const ObMicroBlockData& block_data, const ObColumnMap* column_map,
+      const common::ObRowStoreType out_type = common::FLAT_ROW_STORE) override;
+  virtual void reset() override;
+  virtual int get_row(const int64_t index, storage::ObStoreRow& row) override;
+  virtual int get_rows(const int64_t begin_index, const int64_t end_index, const int64_t row_capacity,
+      storage::ObStoreRow* rows, int64_t& row_count) override;
+  virtual int get_row_count(int64_t& row_count) override;
+  virtual int get_row_header(const int64_t row_idx, const ObRowHeader*& row_header) override;
+  virtual int get_multi_version_info(const int64_t row_idx, const int64_t version_column_idx,
+      const int64_t sql_sequence_idx, storage::ObMultiVersionRowFlag& flag, transaction::ObTransID& trans_id,
+      int64_t& version, int64_t& sql_sequence) override;
+  // Filter on encoded data: CONST, DICT and RLE columns evaluate the filter once for each dictionary entry.
+  virtual int filter_pushdown_filter(const sql::ObWhiteFilterExecutor& filter, const int64_t col_idx,
+      const int64_t begin_index, const int64_t row_count, common::ObBitmap& result_bitmap) override;
+
+protected:
+  virtual int find_bound(const common::ObStoreRowkey& key, const bool lower_bound, const int64_t begin_idx,
+      const int64_t end_idx, int64_t& row_idx, bool& equal) override;
+
+private:
+  ObEncodedMicroBlock block_;
+  common::ObArenaAllocator allocator_;
+  ObRowHeader row_header_;
+};
+
+class ObEncodeBlockGetReader : public ObIMicroBlockGetReader {
+public:
+  ObEncodeBlockGetReader();
+  virtual ~ObEncodeBlockGetReader();
+  virtual int get_row(const uint64_t tenant_id, const ObMicroBlockData& block_data, const common::ObStoreRowkey& rowkey,
+      const ObColumnMap& column_map, const ObFullMacroBlockMeta& macro_meta,
+      const storage::ObSSTableRowkeyHelper* rowkey_helper, storage::ObStoreRow& row) override;
+  virtual int get_row(const uint64_t tenant_id, const ObMicroBlockData& block_data, const common::ObStoreRowkey& rowkey,
+      const ObFullMacroBlockMeta& macro_meta, const storage::ObSSTableRowkeyHelper* rowkey_helper,
+      storage::ObStoreRow& row) override;
+  virtual int exist_row(const uint64_t tenant_id, const ObMicroBlockData& block_data,
+      const common::ObStoreRowkey& rowkey, const ObFullMacroBlockMeta& macro_meta,
+      const storage::ObSSTableRowkeyHelper* rowkey_helper, bool& exist, bool& found) override;
+
+private:
+  int locate_row(const ObMicroBlockData& block_data, const common::ObStoreRowkey& rowkey,
+      const storage::ObSSTableRowkeyHelper* rowkey_helper, int64_t& row_idx);
+
+private:
+  common::ObArenaAllocator allocator_;
+  ObEncodedMicroBlock block_;
+};
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
+#endif  // OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_DECODER_H_
@@ -0,0 +1,673 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_micro_block_encoder.h"
+#include "common/row/ob_row.h"
+#include "storage/ob_i_store.h"
+
+namespace oceanbase {
+using namespace common;
+using namespace storage;
+namespace blocksstable {
+
+// order of dictionary entries: rows sorted by serialized value
+class ObEncodedValueCompare {
+public:
+  ObEncodedValueCompare(const char* data, const ObArray<int32_t>& offsets) : data_(data), offsets_(offsets)
+  {}
+  OB_INLINE bool operator()(const int64_t l, const int64_t r) const
+  {
+    const ObString lv(offsets_.at(l + 1) - offsets_.at(l), data_ + offsets_.at(l));
+    const ObString rv(offsets_.at(r + 1) - offsets_.at(r), data_ + offsets_.at(r));
+    return lv.compare(rv) < 0;
+  }
+
+private:
+  const char* data_;
+  const ObArray<int32_t>& offsets_;
+};
+
+// reserve zeroed space in %buffer
+static int reserve_zero(ObSelfBufferWriter& buffer, const int64_t size, char*& ptr)
+{
+  int ret = OB_SUCCESS;
+  ptr = NULL;
+  if (buffer.remain() < size && OB_FAIL(buffer.expand(size))) {
+    LOG_WARN("fail to expand buffer", K(ret), K(size));
+  } else {
+    ptr = buffer.current();
+    if (OB_FAIL(buffer.advance_zero(size))) {
+      LOG_WARN("fail to advance buffer", K(ret), K(size));
+    }
+  }
+  return ret;
+}
+
+ObMicroBlockEncoder::ObMicroBlockEncoder()
+    : micro_block_size_limit_(0),
+      rowkey_column_count_(0),
+      column_count_(0),
+      estimate_size_(0),
+      is_built_(false),
+      allocator_(ObModIds::OB_SSTABLE_WRITER),
+      rows_(),
+      row_metas_(),
+      data_buffer_(0, "MicrBlocEncoder", false),
+      value_buffer_(0, "MicrBlocEncoder", false),
+      value_offsets_(),
+      sorted_rows_(),
+      dict_rows_(),
+      refs_(),
+      row_writer_(),
+      last_rowkey_(),
+      is_inited_(false)
+{}
+
+ObMicroBlockEncoder::~ObMicroBlockEncoder()
+{}
+
+int ObMicroBlockEncoder::init(
+    const int64_t micro_block_size_limit, const int64_t rowkey_column_count, const int64_t column_count)
+{
+  int ret = OB_SUCCESS;
+  if (is_inited_) {
+    reset();
+  }
+  if (OB_UNLIKELY(micro_block_size_limit <= 0 || rowkey_column_count <= 0 || column_count < rowkey_column_count)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid micro block encoder input argument",
+        K(ret),
+        K(micro_block_size_limit),
+        K(rowkey_column_count),
+        K(column_count));
+  } else if (OB_FAIL(data_buffer_.ensure_space(DEFAULT_DATA_BUFFER_SIZE))) {
+    LOG_WARN("data buffer fail to ensure space", K(ret));
+  } else {
+    micro_block_size_limit_ = micro_block_size_limit;
+    rowkey_column_count_ = rowkey_column_count;
+    column_count_ = column_count;
+    estimate_size_ = get_header_size();
+    is_built_ = false;
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::append_row(const ObStoreRow& row)
+{
+  int ret = OB_SUCCESS;
+  if (!is_inited_) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("should init encoder before append row", K(ret));
+  } else if (OB_UNLIKELY(!row.is_valid() || row.row_val_.count_ != column_count_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid row", K(ret), K(row), K_(column_count));
+  } else if (OB_UNLIKELY(row.is_sparse_row_ || NULL != row.trans_id_ptr_)) {
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("sparse row or row with trans id can not be encoded", K(ret), K(row));
+  } else if (OB_UNLIKELY(is_built_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("block is built, should reuse before append row", K(ret));
+  } else {
+    int64_t row_size = sizeof(ObEncodedRowMeta);
+    int64_t copy_size = sizeof(ObObj) * column_count_;
+    for (int64_t i = 0; i < column_count_; ++i) {
+      const ObObj& cell = row.row_val_.cells_[i];
+      row_size += cell.get_serialize_size() + OFFSET_SIZE;
+      copy_size += cell.get_deep_copy_size();
+    }
+    if (rows_.count() > 0 && estimate_size_ + row_size > micro_block_size_limit_) {
+      ret = OB_BUF_NOT_ENOUGH;
+      LOG_DEBUG("micro block exceed limit", K(row_size), K_(estimate_size), K_(micro_block_size_limit));
+    } else {
+      char* buf = static_cast<char*>(allocator_.alloc(copy_size));
+      ObObj* cells = reinterpret_cast<ObObj*>(buf);
+      int64_t pos = sizeof(ObObj) * column_count_;
+      ObEncodedRowMeta row_meta;
+      row_meta.flag_ = static_cast<int8_t>(row.flag_);
+      row_meta.dml_ = row.get_dml_val();
+      row_meta.row_type_flag_ = row.row_type_flag_.flag_;
+      if (OB_ISNULL(buf)) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("fail to allocate memory", K(ret), K(copy_size));
+      }
+      for (int64_t i = 0; OB_SUCC(ret) && i < column_count_; ++i) {
+        new (cells + i) ObObj();
+        if (OB_FAIL(cells[i].deep_copy(row.row_val_.cells_[i], buf, copy_size, pos))) {
+          LOG_WARN("fail to deep copy cell", K(ret), K(i), K(row));
+        }
+      }
+      if (OB_FAIL(ret)) {
+      } else if (OB_FAIL(rows_.push_back(cells))) {
+        LOG_WARN("fail to push back row", K(ret));
+      } else if (OB_FAIL(row_metas_.push_back(row_meta))) {
+        LOG_WARN("fail to push back row meta", K(ret));
+        rows_.pop_back();
+      } else {
+        estimate_size_ += row_size;
+        cal_delta(row);
+        if (need_cal_row_checksum()) {
+          micro_block_checksum_ = cal_row_checksum(row, micro_block_checksum_);
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::build_block(char*& buf, int64_t& size)
+{
+  int ret = OB_SUCCESS;
+  const int64_t header_size = sizeof(ObMicroBlockHeader);
+  const int64_t col_header_size = sizeof(ObColumnEncodingHeader);
+  char* ptr = NULL;
+  if (!is_inited_) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("should init encoder before build block", K(ret));
+  } else if (OB_UNLIKELY(rows_.count() <= 0)) {
+    ret = OB_INNER_STAT_ERROR;
+    LOG_WARN("empty micro block", K(ret));
+  } else if (is_built_) {
+    // already built
+  } else if (FALSE_IT(data_buffer_.reuse())) {
+  } else if (OB_FAIL(reserve_zero(data_buffer_, header_size + column_count_ * col_header_size, ptr))) {
+    LOG_WARN("fail to reserve header", K(ret));
+  } else {
+    ObMicroBlockHeader* header = reinterpret_cast<ObMicroBlockHeader*>(ptr);
+    header->header_size_ = static_cast<int32_t>(header_size);
+    header->version_ = MICRO_BLOCK_HEADER_VERSION;
+    header->magic_ = MICRO_BLOCK_HEADER_MAGIC;
+    header->attr_ = 0;
+    header->column_count_ = static_cast<int32_t>(column_count_);
+    header->row_index_offset_ = static_cast<int32_t>(data_buffer_.length());
+    header->row_count_ = static_cast<int32_t>(rows_.count());
+    if (OB_FAIL(write_row_meta())) {
+      LOG_WARN("fail to write row meta", K(ret));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < column_count_; ++i) {
+      ColumnStat stat;
+      ObColumnEncodingHeader col_header;
+      int64_t encoded_size = 0;
+      if (OB_FAIL(calc_column_stat(i, stat))) {
+        LOG_WARN("fail to calc column stat", K(ret), K(i));
+      } else if (OB_FAIL(choose_encoding(stat, col_header, encoded_size))) {
+        LOG_WARN("fail to choose encoding", K(ret), K(i), K(stat));
+      } else if (OB_FAIL(encode_column(i, stat, col_header))) {
+        LOG_WARN("fail to encode column", K(ret), K(i), K(stat), K(col_header));
+      } else {
+        // data buffer may be reallocated while encoding, locate the column header after encoding.
+        MEMCPY(data_buffer_.data() + header_size + i * col_header_size, &col_header, col_header_size);
+        LOG_DEBUG("column encoded", K(i), K(col_header), K(encoded_size));
+      }
+    }
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(write_last_rowkey())) {
+      LOG_WARN("fail to write last rowkey", K(ret));
+    } else {
+      is_built_ = true;
+    }
+  }
+  if (OB_SUCC(ret)) {
+    buf = data_buffer_.data();
+    size = data_buffer_.length();
+  }
+  return ret;
+}
+
+void ObMicroBlockEncoder::reuse()
+{
+  ObIMicroBlockWriter::reuse();
+  rows_.reuse();
+  row_metas_.reuse();
+  allocator_.reuse();
+  data_buffer_.reuse();
+  estimate_size_ = get_header_size();
+  is_built_ = false;
+  last_rowkey_.reset();
+}
+
+void ObMicroBlockEncoder::reset()
+{
+  reuse();
+  micro_block_size_limit_ = 0;
+  rowkey_column_count_ = 0;
+  column_count_ = 0;
+  estimate_size_ = 0;
+  value_buffer_.reset();
+  value_offsets_.reset();
+  sorted_rows_.reset();
+  dict_rows_.reset();
+  refs_.reset();
+  rows_.reset();
+  row_metas_.reset();
+  allocator_.reset();
+  is_inited_ = false;
+}
+
+int ObMicroBlockEncoder::write_row_meta()
+{
+  int ret = OB_SUCCESS;
+  bool all_same = true;
+  for (int64_t i = 1; all_same && i < row_metas_.count(); ++i) {
+    all_same = row_metas_.at(i) == row_metas_.at(0);
+  }
+  if (OB_FAIL(data_buffer_.write(static_cast<int8_t>(all_same)))) {
+    LOG_WARN("fail to write row meta flag", K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < (all_same ? 1 : row_metas_.count()); ++i) {
+    if (OB_FAIL(data_buffer_.write(reinterpret_cast<const char*>(&row_metas_.at(i)), sizeof(ObEncodedRowMeta)))) {
+      LOG_WARN("fail to write row meta", K(ret), K(i));
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::serialize_column(const int64_t col_idx)
+{
+  int ret = OB_SUCCESS;
+  value_buffer_.reuse();
+  value_offsets_.reuse();
+  if (OB_FAIL(value_offsets_.push_back(0))) {
+    LOG_WARN("fail to push back offset", K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < rows_.count(); ++i) {
+    if (OB_FAIL(value_buffer_.write_serialize(rows_.at(i)[col_idx]))) {
+      LOG_WARN("fail to serialize cell", K(ret), K(i), K(col_idx));
+    } else if (OB_FAIL(value_offsets_.push_back(static_cast<int32_t>(value_buffer_.length())))) {
+      LOG_WARN("fail to push back offset", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::build_dict(ColumnStat& stat)
+{
+  int ret = OB_SUCCESS;
+  const int64_t row_count = rows_.count();
+  sorted_rows_.reuse();
+  dict_rows_.reuse();
+  refs_.reuse();
+  if (OB_FAIL(sorted_rows_.reserve(row_count))) {
+    LOG_WARN("fail to reserve array", K(ret), K(row_count));
+  } else if (OB_FAIL(refs_.prepare_allocate(row_count))) {
+    LOG_WARN("fail to allocate refs", K(ret), K(row_count));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < row_count; ++i) {
+    if (OB_FAIL(sorted_rows_.push_back(i))) {
+      LOG_WARN("fail to push back row index", K(ret));
+    }
+  }
+  if (OB_SUCC(ret)) {
+    std::sort(&sorted_rows_.at(0),
+        &sorted_rows_.at(0) + row_count,
+        ObEncodedValueCompare(value_buffer_.data(), value_offsets_));
+    for (int64_t i = 0; OB_SUCC(ret) && i < row_count; ++i) {
+      const int64_t row_idx = sorted_rows_.at(i);
+      if (0 == i || get_value(row_idx) != get_value(sorted_rows_.at(i - 1))) {
+        if (OB_FAIL(dict_rows_.push_back(row_idx))) {
+          LOG_WARN("fail to push back dict row", K(ret));
+        } else {
+          stat.dict_size_ += get_value(row_idx).length();
+        }
+      }
+      refs_.at(row_idx) = static_cast<int32_t>(dict_rows_.count() - 1);
+    }
+    if (OB_SUCC(ret)) {
+      stat.dict_count_ = dict_rows_.count();
+      for (int64_t i = 0; i < row_count; ++i) {
+        if (0 == i || refs_.at(i) != refs_.at(i - 1)) {
+          stat.run_count_++;
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::calc_column_stat(const int64_t col_idx, ColumnStat& stat)
+{
+  int ret = OB_SUCCESS;
+  stat.reset();
+  if (OB_FAIL(serialize_column(col_idx))) {
+    LOG_WARN("fail to serialize column", K(ret), K(col_idx));
+  } else if (OB_FAIL(build_dict(stat))) {
+    LOG_WARN("fail to build dictionary", K(ret), K(col_idx));
+  } else {
+    stat.raw_size_ = value_buffer_.length();
+    stat.same_meta_ = true;
+    const ObObj* first = NULL;
+    for (int64_t i = 0; stat.same_meta_ && i < rows_.count(); ++i) {
+      const ObObj& cell = rows_.at(i)[col_idx];
+      if (cell.is_null()) {
+        stat.null_count_++;
+      } else if (NULL == first) {
+        first = &cell;
+        stat.meta_ = cell.get_meta();
+        stat.same_meta_ = ObIntTC == cell.get_type_class() || ObUIntTC == cell.get_type_class() ||
+                          ObStringTC == cell.get_type_class();
+      } else {
+        stat.same_meta_ = cell.get_meta() == stat.meta_ && cell.get_scale() == stat.meta_.get_scale();
+      }
+    }
+    if (NULL == first) {
+      stat.same_meta_ = false;
+    } else if (stat.same_meta_) {
+      const ObObjTypeClass tc = stat.meta_.get_type_class();
+      uint64_t min = 0;
+      uint64_t max = 0;
+      bool first_value = true;
+      for (int64_t i = 0; i < rows_.count(); ++i) {
+        const ObObj& cell = rows_.at(i)[col_idx];
+        if (cell.is_null()) {
+        } else if (ObStringTC == tc) {
+          const ObString& str = cell.get_string();
+          const ObString& first_str = first->get_string();
+          if (first_value) {
+            stat.prefix_len_ = first_str.length();
+          } else {
+            int64_t len = 0;
+            while (len < stat.prefix_len_ && len < str.length() && str.ptr()[len] == first_str.ptr()[len]) {
+              len++;
+            }
+            stat.prefix_len_ = len;
+          }
+          stat.string_size_ += str.length();
+        } else {
+          // compare in the value domain, delta of int64 is calculated in uint64 without overflow.
+          const uint64_t v = cell.get_uint64();
+          if (first_value) {
+            min = v;
+            max = v;
+          } else if (ObIntTC == tc) {
+            min = static_cast<int64_t>(v) < static_cast<int64_t>(min) ? v : min;
+            max = static_cast<int64_t>(v) > static_cast<int64_t>(max) ? v : max;
+          } else {
+            min = v < min ? v : min;
+            max = v > max ? v : max;
+          }
+        }
+        if (!cell.is_null()) {
+          first_value = false;
+        }
+      }
+      stat.int_base_ = min;
+      stat.int_range_ = max - min;
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::choose_encoding(
+    const ColumnStat& stat, ObColumnEncodingHeader& col_header, int64_t& size) const
+{
+  int ret = OB_SUCCESS;
+  const int64_t row_count = rows_.count();
+  const int64_t dict_width = ObBitPacking::get_width(stat.dict_count_ - 1);
+  const int64_t dict_size = OFFSET_SIZE * (stat.dict_count_ + 1) + stat.dict_size_;
+  const int64_t null_bitmap_size = stat.null_count_ > 0 ? ObNullBitmap::get_size(row_count) : 0;
+  col_header.reset();
+  if (OB_UNLIKELY(stat.dict_count_ <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid column stat", K(ret), K(stat));
+  } else if (1 == stat.dict_count_) {
+    col_header.type_ = OB_COLUMN_ENCODING_CONST;
+    size = stat.dict_size_;
+  } else {
+    col_header.type_ = OB_COLUMN_ENCODING_RAW;
+    size = OFFSET_SIZE * (row_count + 1) + stat.raw_size_;
+
+    const int64_t dict_encoded_size = dict_size + ObBitPacking::get_packed_size(row_count, dict_width);
+    if (dict_encoded_size < size) {
+      col_header.type_ = OB_COLUMN_ENCODING_DICT;
+      size = dict_encoded_size;
+    }
+    const int64_t rle_size =
+        dict_size + OFFSET_SIZE * stat.run_count_ + ObBitPacking::get_packed_size(stat.run_count_, dict_width);
+    if (rle_size < size) {
+      col_header.type_ = OB_COLUMN_ENCODING_RLE;
+      size = rle_size;
+    }
+    if (stat.same_meta_) {
+      const ObObjTypeClass tc = stat.meta_.get_type_class();
+      if (ObIntTC == tc || ObUIntTC == tc) {
+        const int64_t int_size = sizeof(uint64_t) + null_bitmap_size +
+                                 ObBitPacking::get_packed_size(row_count, ObBitPacking::get_width(stat.int_range_));
+        if (int_size < size) {
+          col_header.type_ = OB_COLUMN_ENCODING_INTEGER;
+          size = int_size;
+        }
+      } else if (ObStringTC == tc) {
+        const int64_t prefix_size = stat.prefix_len_ + null_bitmap_size + OFFSET_SIZE * (row_count + 1) +
+                                    stat.string_size_ - (row_count - stat.null_count_) * stat.prefix_len_;
+        if (prefix_size < size) {
+          col_header.type_ = OB_COLUMN_ENCODING_STRING_PREFIX;
+          size = prefix_size;
+        }
+      }
+    }
+  }
+  if (OB_SUCC(ret)) {
+    switch (col_header.type_) {
+      case OB_COLUMN_ENCODING_DICT:
+      case OB_COLUMN_ENCODING_RLE: {
+        col_header.width_ = static_cast<uint8_t>(dict_width);
+        col_header.count_ = static_cast<int32_t>(stat.dict_count_);
+        col_header.run_count_ = static_cast<int32_t>(stat.run_count_);
+        break;
+      }
+      case OB_COLUMN_ENCODING_INTEGER: {
+        col_header.width_ = static_cast<uint8_t>(ObBitPacking::get_width(stat.int_range_));
+        col_header.has_null_ = stat.null_count_ > 0;
+        col_header.meta_ = stat.meta_;
+        break;
+      }
+      case OB_COLUMN_ENCODING_STRING_PREFIX: {
+        col_header.count_ = static_cast<int32_t>(stat.prefix_len_);
+        col_header.has_null_ = stat.null_count_ > 0;
+        col_header.meta_ = stat.meta_;
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::encode_column(
+    const int64_t col_idx, const ColumnStat& stat, ObColumnEncodingHeader& col_header)
+{
+  int ret = OB_SUCCESS;
+  const int64_t offset = data_buffer_.length();
+  switch (col_header.type_) {
+    case OB_COLUMN_ENCODING_RAW: {
+      if (OB_FAIL(data_buffer_.write(
+              reinterpret_cast<const char*>(&value_offsets_.at(0)), OFFSET_SIZE * value_offsets_.count()))) {
+        LOG_WARN("fail to write offsets", K(ret));
+      } else if (OB_FAIL(data_buffer_.write(value_buffer_.data(), value_buffer_.length()))) {
+        LOG_WARN("fail to write values", K(ret));
+      }
+      break;
+    }
+    case OB_COLUMN_ENCODING_CONST: {
+      const ObString value = get_value(dict_rows_.at(0));
+      if (OB_FAIL(data_buffer_.write(value.ptr(), value.length()))) {
+        LOG_WARN("fail to write const value", K(ret));
+      }
+      break;
+    }
+    case OB_COLUMN_ENCODING_DICT:
+    case OB_COLUMN_ENCODING_RLE: {
+      if (OB_FAIL(write_dict(col_header))) {
+        LOG_WARN("fail to write dictionary", K(ret));
+      }
+      break;
+    }
+    case OB_COLUMN_ENCODING_INTEGER: {
+      if (OB_FAIL(write_integer(col_idx, stat, col_header))) {
+        LOG_WARN("fail to write integer", K(ret));
+      }
+      break;
+    }
+    case OB_COLUMN_ENCODING_STRING_PREFIX: {
+      if (OB_FAIL(write_string_prefix(col_idx, stat, col_header))) {
+        LOG_WARN("fail to write string prefix", K(ret));
+      }
+      break;
+    }
+    default:
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("unexpected encoding type", K(ret), K(col_header));
+  }
+  if (OB_SUCC(ret)) {
+    col_header.offset_ = static_cast<int32_t>(offset);
+    col_header.length_ = static_cast<int32_t>(data_buffer_.length() - offset);
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::write_dict(const ObColumnEncodingHeader& col_header)
+{
+  int ret = OB_SUCCESS;
+  const int64_t row_count = rows_.count();
+  const bool is_rle = OB_COLUMN_ENCODING_RLE == col_header.type_;
+  int32_t dict_offset = 0;
+  char* packed = NULL;
+  if (OB_FAIL(data_buffer_.write(dict_offset))) {
+    LOG_WARN("fail to write dictionary offset", K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < dict_rows_.count(); ++i) {
+    dict_offset += get_value(dict_rows_.at(i)).length();
+    if (OB_FAIL(data_buffer_.write(dict_offset))) {
+      LOG_WARN("fail to write dictionary offset", K(ret));
+    }
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < dict_rows_.count(); ++i) {
+    const ObString value = get_value(dict_rows_.at(i));
+    if (OB_FAIL(data_buffer_.write(value.ptr(), value.length()))) {
+      LOG_WARN("fail to write dictionary value", K(ret), K(i));
+    }
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && is_rle && i < row_count; ++i) {
+    if ((0 == i || refs_.at(i) != refs_.at(i - 1)) && OB_FAIL(data_buffer_.write(static_cast<int32_t>(i)))) {
+      LOG_WARN("fail to write run start", K(ret), K(i));
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(reserve_zero(data_buffer_,
+                 ObBitPacking::get_packed_size(is_rle ? col_header.run_count_ : row_count, col_header.width_),
+                 packed))) {
+    LOG_WARN("fail to reserve packed refs", K(ret));
+  } else {
+    int64_t idx = 0;
+    for (int64_t i = 0; i < row_count; ++i) {
+      if (!is_rle || 0 == i || refs_.at(i) != refs_.at(i - 1)) {
+        ObBitPacking::pack(packed, idx++, col_header.width_, refs_.at(i));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::write_integer(
+    const int64_t col_idx, const ColumnStat& stat, const ObColumnEncodingHeader& col_header)
+{
+  int ret = OB_SUCCESS;
+  const int64_t row_count = rows_.count();
+  char* null_bitmap = NULL;
+  char* packed = NULL;
+  if (OB_FAIL(data_buffer_.write(stat.int_base_))) {
+    LOG_WARN("fail to write integer base", K(ret));
+  } else if (col_header.has_null_ &&
+             OB_FAIL(reserve_zero(data_buffer_, ObNullBitmap::get_size(row_count), null_bitmap))) {
+    LOG_WARN("fail to reserve null bitmap", K(ret));
+  } else if (OB_FAIL(reserve_zero(data_buffer_, ObBitPacking::get_packed_size(row_count, col_header.width_), packed))) {
+    LOG_WARN("fail to reserve packed values", K(ret));
+  } else {
+    for (int64_t i = 0; i < row_count; ++i) {
+      const ObObj& cell = rows_.at(i)[col_idx];
+      if (cell.is_null()) {
+        ObNullBitmap::set(null_bitmap, i);
+      } else {
+        ObBitPacking::pack(packed, i, col_header.width_, cell.get_uint64() - stat.int_base_);
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::write_string_prefix(
+    const int64_t col_idx, const ColumnStat& stat, const ObColumnEncodingHeader& col_header)
+{
+  int ret = OB_SUCCESS;
+  const int64_t row_count = rows_.count();
+  char* null_bitmap = NULL;
+  const ObObj* first = NULL;
+  for (int64_t i = 0; NULL == first && i < row_count; ++i) {
+    if (!rows_.at(i)[col_idx].is_null()) {
+      first = &rows_.at(i)[col_idx];
+    }
+  }
+  if (OB_ISNULL(first)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("all values are null", K(ret), K(col_idx));
+  } else if (OB_FAIL(data_buffer_.write(first->get_string().ptr(), stat.prefix_len_))) {
+    LOG_WARN("fail to write prefix", K(ret));
+  } else if (col_header.has_null_ &&
+             OB_FAIL(reserve_zero(data_buffer_, ObNullBitmap::get_size(row_count), null_bitmap))) {
+    LOG_WARN("fail to reserve null bitmap", K(ret));
+  } else {
+    int32_t offset = 0;
+    if (OB_FAIL(data_buffer_.write(offset))) {
+      LOG_WARN("fail to write offset", K(ret));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < row_count; ++i) {
+      const ObObj& cell = rows_.at(i)[col_idx];
+      if (cell.is_null()) {
+        ObNullBitmap::set(null_bitmap, i);
+      } else {
+        offset += static_cast<int32_t>(cell.get_string().length() - stat.prefix_len_);
+      }
+      if (OB_FAIL(data_buffer_.write(offset))) {
+        LOG_WARN("fail to write offset", K(ret));
+      }
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < row_count; ++i) {
+      const ObObj& cell = rows_.at(i)[col_idx];
+      if (!cell.is_null() && OB_FAIL(data_buffer_.write(cell.get_string().ptr() + stat.prefix_len_,
+                                  cell.get_string().length() - stat.prefix_len_))) {
+        LOG_WARN("fail to write suffix", K(ret), K(i));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::write_last_rowkey()
+{
+  int ret = OB_SUCCESS;
+  ObNewRow rowkey;
+  int64_t pos = 0;
+  rowkey.cells_ = rows_.at(rows_.count() - 1);
+  rowkey.count_ = rowkey_column_count_;
+  if (OB_FAIL(row_writer_.write(rowkey, last_rowkey_buf_, OB_MAX_ROW_KEY_LENGTH, FLAT_ROW_STORE, pos))) {
+    LOG_WARN("fail to write last rowkey", K(ret), K(rowkey));
+  } else {
+    last_rowkey_.assign_ptr(last_rowkey_buf_, static_cast<ObString::obstr_size_t>(pos));
+  }
+  return ret;
+}
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
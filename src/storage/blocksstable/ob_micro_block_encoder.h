@@ -0,0 +1,147 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_ENCODER_H_
+#define OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_ENCODER_H_
+
+#include "lib/allocator/page_arena.h"
+#include "lib/container/ob_array.h"
+#include "ob_block_sstable_struct.h"
+#include "ob_data_buffer.h"
+#include "ob_column_encoding.h"
+#include "ob_imicro_block_writer.h"
+#include "ob_row_writer.h"
+
+namespace oceanbase {
+namespace storage {
+class ObStoreRow;
+}
+namespace blocksstable {
+
+// Writer of encoded micro block (see ob_column_encoding.h for the block layout).
+//
+// Rows are buffered (deep copied) until build_block(), then each column is encoded with the
+// encoding of the minimal size: RAW, CONST, DICT, RLE, INTEGER or STRING_PREFIX.
+// The block size before building is estimated by the raw serialize size of the cells,
+// which is the upper bound of the encoded size.
+class ObMicroBlockEncoder : public ObIMicroBlockWriter {
+  static const int64_t DEFAULT_DATA_BUFFER_SIZE = common::OB_DEFAULT_MACRO_BLOCK_SIZE;
+  static const int64_t OFFSET_SIZE = sizeof(int32_t);
+
+public:
+  ObMicroBlockEncoder();
+  virtual ~ObMicroBlockEncoder();
+  int init(const int64_t micro_block_size_limit, const int64_t rowkey_column_count, const int64_t column_count);
+  virtual int append_row(const storage::ObStoreRow& row) override;
+  virtual int build_block(char*& buf, int64_t& size) override;
+  virtual void reuse() override;
+
+  virtual int64_t get_block_size() const override
+  {
+    return is_built_ ? data_buffer_.length() : estimate_size_;
+  }
+  virtual int64_t get_row_count() const override
+  {
+    return rows_.count();
+  }
+  virtual int64_t get_data_size() const override
+  {
+    return get_block_size();
+  }
+  virtual int64_t get_column_count() const override
+  {
+    return column_count_;
+  }
+  virtual common::ObString get_last_rowkey() const override
+  {
+    return last_rowkey_;
+  }
+  void reset();
+
+  INHERIT_TO_STRING_KV("ObIMicroBlockWriter", ObIMicroBlockWriter, K_(micro_block_size_limit),
+      K_(rowkey_column_count), K_(column_count), "row_count", rows_.count(), K_(estimate_size), K_(is_built));
+
+private:
+  // statistics of the column to choose encoding
+  struct ColumnStat {
+    int64_t raw_size_;
+    int64_t null_count_;
+    int64_t dict_count_;
+    int64_t dict_size_;
+    int64_t run_count_;
+    bool same_meta_;
+    common::ObObjMeta meta_;
+    uint64_t int_base_;
+    uint64_t int_range_;
+    int64_t prefix_len_;
+    int64_t string_size_;
+
+    ColumnStat()
+    {
+      reset();
+    }
+    void reset()
+    {
+      MEMSET(this, 0, sizeof(*this));
+    }
+    TO_STRING_KV(K_(raw_size), K_(null_count), K_(dict_count), K_(dict_size), K_(run_count), K_(same_meta), K_(meta),
+        K_(int_base), K_(int_range), K_(prefix_len), K_(string_size));
+  };
+
+  int serialize_column(const int64_t col_idx);
+  int build_dict(ColumnStat& stat);
+  int calc_column_stat(const int64_t col_idx, ColumnStat& stat);
+  int choose_encoding(const ColumnStat& stat, ObColumnEncodingHeader& col_header, int64_t& size) const;
+  int encode_column(const int64_t col_idx, const ColumnStat& stat, ObColumnEncodingHeader& col_header);
+  int write_dict(const ObColumnEncodingHeader& col_header);
+  int write_integer(const int64_t col_idx, const ColumnStat& stat, const ObColumnEncodingHeader& col_header);
+  int write_string_prefix(const int64_t col_idx, const ColumnStat& stat, const ObColumnEncodingHeader& col_header);
+  int write_row_meta();
+  int write_last_rowkey();
+  OB_INLINE int64_t get_header_size() const
+  {
+    // block header, column headers, row meta flag and the first offset of RAW encoding
+    return sizeof(ObMicroBlockHeader) + column_count_ * (sizeof(ObColumnEncodingHeader) + OFFSET_SIZE) +
+           sizeof(int8_t);
+  }
+  OB_INLINE common::ObString get_value(const int64_t row_idx) const
+  {
+    return common::ObString(value_offsets_.at(row_idx + 1) - value_offsets_.at(row_idx),
+        value_buffer_.data() + value_offsets_.at(row_idx));
+  }
+
+private:
+  int64_t micro_block_size_limit_;
+  int64_t rowkey_column_count_;
+  int64_t column_count_;
+  int64_t estimate_size_;
+  bool is_built_;
+  common::ObArenaAllocator allocator_;  // deep copy of row cells
+  common::ObArray<common::ObObj*> rows_;
+  common::ObArray<ObEncodedRowMeta> row_metas_;
+  ObSelfBufferWriter data_buffer_;
+  // serialized values of the column encoding
+  ObSelfBufferWriter value_buffer_;
+  common::ObArray<int32_t> value_offsets_;
+  // row indexes sorted by serialized value, distinct values and dictionary reference of each row
+  common::ObArray<int64_t> sorted_rows_;
+  common::ObArray<int64_t> dict_rows_;
+  common::ObArray<int32_t> refs_;
+  ObRowWriter row_writer_;
+  char last_rowkey_buf_[common::OB_MAX_ROW_KEY_LENGTH];
+  common::ObString last_rowkey_;
+  bool is_inited_;
+};
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
+#endif  // OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_ENCODER_H_
@@ -529,7 +529,7 @@ int ObMicroBlockIndexCache::ObMicroBlockIndexIOCallback::put_cache_and_fetch(
   const int64_t size = transformer.get_transformer_size();
   if (OB_UNLIKELY(OB_SUCCESS == (ret = cache_->get(key_, idx_mgr_, handle_)))) {
     // entry exist, no need to put
-  } else if (OB_FAIL(cache_->alloc(key_.get_tenant_id(), key_.size(), size, kvpair, handle_, inst_handle))) {
+  } else if (OB_FAIL(cache_->alloc(key_.get_tenant_id(), key_.size(), size, kvpair, handle_, inst_handle, &key_))) {
     LOG_WARN("failed to alloc kvcache buf", K(ret));
   } else {
     if (OB_FAIL(key_.deep_copy(reinterpret_cast<char*>(kvpair->key_), key_.size(), kvpair->key_))) {
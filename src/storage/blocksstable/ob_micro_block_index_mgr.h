@@ -176,6 +176,19 @@ public:
       int64_t& logical_row_count, int64_t& physical_row_count, bool& need_check_micro_block) const;
   // calculate row count can be purged in this macro block
   int cal_macro_purged_row_count(int64_t& purged_row_count) const;
+  // zone map section of the macro block, see ObMicroBlockZoneMapReader
+  OB_INLINE bool has_zone_map() const
+  {
+    return NULL != zone_map_ && zone_map_size_ > 0;
+  }
+  OB_INLINE const char* get_zone_map_buf() const
+  {
+    return zone_map_;
+  }
+  OB_INLINE int64_t get_zone_map_size() const
+  {
+    return zone_map_size_;
+  }
 
 private:
   void get_bound(Bound& bound) const;
@@ -204,12 +217,14 @@ private:
   char* extra_space_base_;  // reserved space for deep copy string and number
   bool* mark_deletion_array_;
   int32_t* delta_array_;
+  char* zone_map_;
 
   int32_t micro_index_size_;
   int32_t node_array_size_;
   int32_t extra_space_size_;
   int32_t mark_deletion_flags_size_;
   int32_t delta_size_;
+  int32_t zone_map_size_;
 
   int32_t micro_count_;
   int32_t rowkey_column_count_;
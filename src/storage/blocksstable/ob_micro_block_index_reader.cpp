@@ -99,7 +99,8 @@ int ObMicroBlockIndexReader::init(
 int ObMicroBlockIndexReader::init_row_reader(const ObRowStoreType row_store_type)
 {
   int ret = OB_SUCCESS;
-  if (FLAT_ROW_STORE == row_store_type) {
+  if (FLAT_ROW_STORE == row_store_type || ENCODING_ROW_STORE == row_store_type) {
+    // rowkeys of encoded micro blocks are written by flat row
     row_reader_ = &flat_row_reader_;
   } else if (SPARSE_ROW_STORE == row_store_type) {
     row_reader_ = &sparse_row_reader_;
@@ -57,6 +57,8 @@ ObMicroBlockIndexTransformer::ObMicroBlockIndexTransformer()
    : block_count_(0),
      rowkey_column_count_(0),
      data_offset_(0),
+     zone_map_buf_(NULL),
+     zone_map_size_(0),
      allocator_(ObModIds::OB_SSTABLE_GET_SCAN),
      vec_allocator_(ObModIds::OB_MICRO_INDEX_TRANSFORMER),
      node_vector_(),
@@ -101,6 +103,9 @@ int ObMicroBlockIndexTransformer::transform(const char* index_buf, const ObFullM
     rowkey_column_count_ = meta.rowkey_column_number_;
     node_vector_count_ = rowkey_column_count_;
     data_offset_ = meta.micro_block_data_offset_;
+    zone_map_size_ = meta.get_micro_block_zone_map_size();
+    zone_map_buf_ =
+        0 == zone_map_size_ ? NULL : index_buf + (meta.micro_block_zone_map_offset_ - meta.micro_block_index_offset_);
 
     if (OB_FAIL(index_reader_.init(full_meta, index_buf))) {
       STORAGE_LOG(WARN, "failed to init micro index reader", K(ret));
@@ -119,6 +124,8 @@ void ObMicroBlockIndexTransformer::reuse()
   block_count_ = 0;
   rowkey_column_count_ = 0;
   data_offset_ = 0;
+  zone_map_buf_ = NULL;
+  zone_map_size_ = 0;
   if (vec_inited_) {
     for (int i = 0; i < node_vector_count_; i++) {
       if (OB_NOT_NULL(node_vector_[i])) {
@@ -137,6 +144,8 @@ void ObMicroBlockIndexTransformer::reset()
   block_count_ = 0;
   rowkey_column_count_ = 0;
   data_offset_ = 0;
+  zone_map_buf_ = NULL;
+  zone_map_size_ = 0;
   node_vector_count_ = 0;
   for (int i = 0; i < OB_MAX_ROWKEY_COLUMN_NUMBER; i++) {
     if (OB_NOT_NULL(node_vector_[i])) {
@@ -494,6 +503,19 @@ int ObMicroBlockIndexTransformer::fill_block_index_mgr(char* buffer, int64_t siz
         }
       }
     }
+
+    // zone map
+    if (OB_SUCC(ret)) {
+      if (zone_map_size_ > 0) {
+        if (pos + zone_map_size_ > size) {
+          ret = OB_BUF_NOT_ENOUGH;
+          STORAGE_LOG(WARN, "buffer is not enough for zone map", K(ret), K(pos), K(size), K_(zone_map_size));
+        } else {
+          MEMCPY(buffer + pos, zone_map_buf_, zone_map_size_);
+          pos += zone_map_size_;
+        }
+      }
+    }
   }
   return ret;
 }
@@ -502,7 +524,7 @@ int64_t ObMicroBlockIndexTransformer::get_transformer_size() const
 {
   return sizeof(ObMicroBlockIndexMgr) + (block_count_ + 1) * sizeof(ObMicroBlockIndex) +
          node_array_.get_node_array_size() + node_array_.get_extra_space_size() +
-         index_reader_.get_mark_deletion_flags_size() + index_reader_.get_delta_size();
+         index_reader_.get_mark_deletion_flags_size() + index_reader_.get_delta_size() + zone_map_size_;
 }
 
 }  // end namespace blocksstable
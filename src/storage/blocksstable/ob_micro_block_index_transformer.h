@@ -114,6 +114,8 @@ private:
   int64_t block_count_;  // count of micro blocks
   int64_t rowkey_column_count_;
   int64_t data_offset_;
+  const char* zone_map_buf_;  // zone map section in the index buffer, copied as is
+  int64_t zone_map_size_;
   common::ObArenaAllocator allocator_;
   common::ObArenaAllocator vec_allocator_;
 
@@ -21,6 +21,7 @@
 #include "ob_column_map.h"
 #include "share/ob_force_print_log.h"
 #include "storage/transaction/ob_trans_ctx_mgr.h"
+#include "sql/engine/basic/ob_pushdown_filter.h"
 
 namespace oceanbase {
 using namespace common;
@@ -852,5 +853,56 @@ int ObMicroBlockReader::get_multi_version_info(const int64_t row_idx, const int6
   return ret;
 }
 
+int ObMicroBlockReader::filter_pushdown_filter(const sql::ObWhiteFilterExecutor& filter, const int64_t col_idx,
+    const int64_t begin_index, const int64_t row_count, ObBitmap& result_bitmap)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(col_idx < 0 || col_idx >= column_map_->get_request_count() || begin_index < begin() ||
+                         row_count < 0 || begin_index + row_count > end() || result_bitmap.size() < row_count)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument",
+        K(ret),
+        K(col_idx),
+        K(begin_index),
+        K(row_count),
+        K(begin()),
+        K(end()),
+        K(result_bitmap.size()));
+  } else if (OB_ISNULL(reader_)) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "row reader is null", K(ret), K(reader_));
+  } else {
+    const ObColumnIndexItem& column_index = column_map_->get_column_indexs()[col_idx];
+    if (column_index.store_index_ < 0 || !column_index.is_column_type_matched_) {
+      // column filled by default value or casted after read, can not be filtered by the stored value.
+      result_bitmap.reuse(true);
+    } else {
+      ObObj cell;
+      bool filtered = false;
+      // only read the filter column of each row, other columns are decoded for the rows selected.
+      for (int64_t i = 0; OB_SUCC(ret) && i < row_count; ++i) {
+        const int64_t row_idx = begin_index + i;
+        reader_->reset();
+        if (OB_FAIL(reader_->setup_row(
+                data_begin_, index_data_[row_idx + 1], index_data_[row_idx], column_map_->get_store_count()))) {
+          LOG_WARN("fail to setup row", K(ret), K(row_idx), K(index_data_[row_idx + 1]), K(index_data_[row_idx]));
+        } else if (OB_FAIL(reader_->read_column(
+                       column_index.request_column_type_, allocator_, column_index.store_index_, cell))) {
+          LOG_WARN("fail to read column", K(ret), K(row_idx), K(column_index));
+        } else if (OB_FAIL(filter.filter(cell, filtered))) {
+          LOG_WARN("fail to filter cell", K(ret), K(row_idx), K(cell));
+        } else if (!filtered && OB_FAIL(result_bitmap.set(i))) {
+          LOG_WARN("fail to set bitmap", K(ret), K(i));
+        }
+      }
+      reader_->reset();
+    }
+  }
+  return ret;
+}
+
 }  // end namespace blocksstable
 }  // end namespace oceanbase
@@ -115,6 +115,8 @@ public:
   virtual int get_multi_version_info(const int64_t row_idx, const int64_t version_column_idx,
       const int64_t sql_sequence_idx, storage::ObMultiVersionRowFlag& flag, transaction::ObTransID& trans_id,
       int64_t& version, int64_t& sql_sequence) override;
+  virtual int filter_pushdown_filter(const sql::ObWhiteFilterExecutor& filter, const int64_t col_idx,
+      const int64_t begin_index, const int64_t row_count, common::ObBitmap& result_bitmap) override;
 
 protected:
   int base_init(const ObMicroBlockData& block_data);
@@ -36,6 +36,7 @@ protected:
   ObMicroBlockGetReader* flat_reader_;
   ObMultiVersionBlockGetReader* multi_version_reader_;
   ObSparseMicroBlockGetReader* sparse_reader_;
+  ObEncodeBlockGetReader* encode_reader_;
   bool is_multi_version_;
   bool is_inited_;
 };
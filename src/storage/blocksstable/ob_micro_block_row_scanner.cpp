@@ -17,6 +17,7 @@
 #include "storage/blocksstable/ob_micro_block_reader.h"
 #include "storage/transaction/ob_trans_service.h"
 #include "storage/transaction/ob_trans_part_ctx.h"
+#include "sql/engine/basic/ob_pushdown_filter.h"
 
 using namespace oceanbase;
 using namespace common;
@@ -178,6 +179,10 @@ int ObIMicroBlockRowScanner::set_reader(const ObRowStoreType store_type)
       reader_ = &sparse_reader_;
       break;
     }
+    case ENCODING_ROW_STORE: {
+      reader_ = &decoder_;
+      break;
+    }
     default:
       ret = OB_NOT_SUPPORTED;
       STORAGE_LOG(WARN, "not supported row store type", K(ret), K(store_type));
@@ -454,6 +459,8 @@ int ObMicroBlockRowScanner::init(const ObTableIterParam& param, ObTableAccessCon
                  projector,
                  storage::ObMultiVersionRowkeyHelpper::MVRC_NONE /*multi version col type*/))) {
     STORAGE_LOG(WARN, "Fail to init col map, ", K(ret));
+  } else if (nullptr != param_->pushdown_filter_ && OB_FAIL(init_pushdown_filter_param(*param_->pushdown_filter_))) {
+    STORAGE_LOG(WARN, "Fail to init pushdown filter param", K(ret));
   } else {
     for (int64_t i = 0; i < ObIMicroBlockReader::OB_MAX_BATCH_ROW_COUNT; ++i) {
       ObStoreRow& row = rows_[i];
@@ -461,11 +468,114 @@ int ObMicroBlockRowScanner::init(const ObTableIterParam& param, ObTableAccessCon
       row.row_val_.count_ = OB_ROW_MAX_COLUMNS_COUNT;
       row.capacity_ = OB_ROW_MAX_COLUMNS_COUNT;
     }
+    filter_bitmap_ = nullptr;
+    filter_begin_ = ObIMicroBlockReader::INVALID_ROW_INDEX;
     is_inited_ = true;
   }
   return ret;
 }
 
+int ObMicroBlockRowScanner::init_pushdown_filter_param(sql::ObPushdownFilterExecutor& filter)
+{
+  int ret = OB_SUCCESS;
+  if (filter.is_filter_white_node()) {
+    // the filter executor lives as long as the scan, column offsets are the same for each rescan
+    const ObIArray<share::schema::ObColumnParam*>* out_cols_param = nullptr;
+    if (nullptr != filter.get_col_offsets()) {
+    } else if (OB_FAIL(param_->get_out_cols_param(false /*is get*/, out_cols_param))) {
+      STORAGE_LOG(WARN, "fail to get out cols param", K(ret));
+    } else if (OB_FAIL(filter.init_filter_param(column_map_.get_cols_map(), out_cols_param, false /*padding*/))) {
+      STORAGE_LOG(WARN, "fail to init filter param", K(ret));
+    }
+  } else if (filter.is_logic_op_node()) {
+    for (uint32_t i = 0; OB_SUCC(ret) && i < filter.get_child_count(); i++) {
+      sql::ObPushdownFilterExecutor* child = nullptr;
+      if (OB_FAIL(filter.get_child(i, child))) {
+        STORAGE_LOG(WARN, "fail to get child filter", K(ret), K(i));
+      } else if (OB_ISNULL(child)) {
+        ret = OB_ERR_UNEXPECTED;
+        STORAGE_LOG(WARN, "child filter is null", K(ret), K(i));
+      } else if (OB_FAIL(init_pushdown_filter_param(*child))) {
+        STORAGE_LOG(WARN, "fail to init child filter param", K(ret), K(i));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockRowScanner::filter_micro_block_rows()
+{
+  int ret = OB_SUCCESS;
+  filter_bitmap_ = nullptr;
+  // only flat and encoded rows can be filtered before decoding, rows of sparse blocks are all decoded.
+  if (nullptr == param_->pushdown_filter_ || !context_->enable_pushdown_filter_ ||
+      (reader_ != &flat_reader_ && reader_ != &decoder_) ||
+      ObIMicroBlockReader::INVALID_ROW_INDEX == current_) {
+  } else {
+    ObBitmap* result = nullptr;
+    const int64_t begin = MIN(start_, last_);
+    const int64_t row_count = MAX(start_, last_) - begin + 1;
+    if (OB_FAIL(filter_pushdown_filter(*param_->pushdown_filter_, begin, row_count, result))) {
+      STORAGE_LOG(WARN, "fail to filter micro block rows", K(ret), K(begin), K(row_count), K(macro_id_));
+    } else {
+      filter_bitmap_ = result;
+      filter_begin_ = begin;
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockRowScanner::filter_pushdown_filter(sql::ObPushdownFilterExecutor& filter, const int64_t begin_index,
+    const int64_t row_count, ObBitmap*& result_bitmap)
+{
+  int ret = OB_SUCCESS;
+  result_bitmap = nullptr;
+  if (OB_FAIL(filter.init_bitmap(row_count, result_bitmap))) {
+    STORAGE_LOG(WARN, "fail to init filter bitmap", K(ret), K(row_count));
+  } else if (OB_ISNULL(result_bitmap)) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "filter bitmap is null", K(ret));
+  } else if (filter.is_filter_white_node()) {
+    if (OB_UNLIKELY(1 != filter.get_col_count()) || OB_ISNULL(filter.get_col_offsets())) {
+      ret = OB_ERR_UNEXPECTED;
+      STORAGE_LOG(WARN, "unexpected white filter column", K(ret), K(filter.get_col_count()));
+    } else if (OB_FAIL(reader_->filter_pushdown_filter(static_cast<sql::ObWhiteFilterExecutor&>(filter),
+                   filter.get_col_offsets()[0],
+                   begin_index,
+                   row_count,
+                   *result_bitmap))) {
+      STORAGE_LOG(WARN, "fail to filter micro block", K(ret), K(begin_index), K(row_count));
+    }
+  } else if (filter.is_filter_black_node()) {
+    // black filters are evaluated by the table scan operator after rows fused
+    result_bitmap->reuse(true);
+  } else if (filter.is_logic_op_node()) {
+    // bitmap of AND node is initialized to all true, OR node to all false
+    for (uint32_t i = 0; OB_SUCC(ret) && i < filter.get_child_count(); i++) {
+      sql::ObPushdownFilterExecutor* child = nullptr;
+      ObBitmap* child_bitmap = nullptr;
+      if (OB_FAIL(filter.get_child(i, child))) {
+        STORAGE_LOG(WARN, "fail to get child filter", K(ret), K(i));
+      } else if (OB_ISNULL(child)) {
+        ret = OB_ERR_UNEXPECTED;
+        STORAGE_LOG(WARN, "child filter is null", K(ret), K(i));
+      } else if (OB_FAIL(filter_pushdown_filter(*child, begin_index, row_count, child_bitmap))) {
+        STORAGE_LOG(WARN, "fail to filter child", K(ret), K(i));
+      } else if (filter.is_logic_and_node()) {
+        if (OB_FAIL(result_bitmap->bit_and(*child_bitmap))) {
+          STORAGE_LOG(WARN, "fail to merge child bitmap", K(ret), K(i));
+        }
+      } else if (OB_FAIL(result_bitmap->bit_or(*child_bitmap))) {
+        STORAGE_LOG(WARN, "fail to merge child bitmap", K(ret), K(i));
+      }
+    }
+  } else {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "unexpected filter type", K(ret), K(filter.get_type()));
+  }
+  return ret;
+}
+
 int ObMicroBlockRowScanner::open(const MacroBlockId& macro_id, const ObFullMacroBlockMeta& macro_meta,
     const ObMicroBlockData& block_data, const bool is_left_border, const bool is_right_border)
 {
@@ -476,6 +586,8 @@ int ObMicroBlockRowScanner::open(const MacroBlockId& macro_id, const ObFullMacro
     STORAGE_LOG(WARN, "failed to init micro block reader", K(ret), K(macro_id));
   } else if (OB_FAIL(set_base_scan_param(is_left_border, is_right_border))) {
     STORAGE_LOG(WARN, "failed to set base scan param", K(ret), K(is_left_border), K(is_right_border), K(macro_id));
+  } else if (OB_FAIL(filter_micro_block_rows())) {
+    STORAGE_LOG(WARN, "failed to filter micro block rows", K(ret), K(macro_id));
   }
   return ret;
 }
@@ -494,6 +606,7 @@ int ObMicroBlockRowScanner::inner_get_next_row(const ObStoreRow*& row)
 {
   int ret = OB_SUCCESS;
   row = NULL;
+  skip_filtered_rows();
   if (OB_FAIL(end_of_block())) {
     if (OB_UNLIKELY(OB_ITER_END != ret)) {
       STORAGE_LOG(WARN, "fail to judge end of block or not, ", K(ret));
@@ -524,6 +637,12 @@ int ObMicroBlockRowScanner::inner_get_next_rows(const storage::ObStoreRow*& rows
       if (OB_UNLIKELY(OB_ITER_END != ret)) {
         STORAGE_LOG(WARN, "fail to judge end of block or not, ", K(ret));
       }
+    } else if (nullptr != filter_bitmap_) {
+      if (OB_FAIL(get_filtered_rows(count))) {
+        STORAGE_LOG(WARN, "fail to get filtered rows", K(ret), K(current_), K(start_), K(last_), K(macro_id_));
+      } else if (count > 0) {
+        rows = rows_;
+      }
     } else if (OB_FAIL(reader_->get_rows(
                    current_, last_ + step_, ObIMicroBlockReader::OB_MAX_BATCH_ROW_COUNT, rows_, count))) {
       STORAGE_LOG(WARN, "fail to get rows", K(ret), K(current_), K(start_), K(last_), K(macro_id_), K(*sstable_));
@@ -547,7 +666,33 @@ int ObMicroBlockRowScanner::inner_get_next_rows(const storage::ObStoreRow*& rows
     if (context_->query_flag_.is_multi_version_minor_merge()) {
       compat_old_dump_sstable_row(const_cast<ObStoreRow*>(rows), count);
     }
-    current_ += step_ * count;
+    if (nullptr == filter_bitmap_) {
+      current_ += step_ * count;
+    }
+  }
+  return ret;
+}
+
+// get rows selected by %filter_bitmap_, %current_ is moved to the next row not scanned
+int ObMicroBlockRowScanner::get_filtered_rows(int64_t& count)
+{
+  int ret = OB_SUCCESS;
+  count = 0;
+  while (OB_SUCC(ret) && count < ObIMicroBlockReader::OB_MAX_BATCH_ROW_COUNT) {
+    skip_filtered_rows();
+    if (OB_SUCCESS != end_of_block()) {
+      break;
+    } else {
+      ObStoreRow& row = rows_[count];
+      row.row_val_.count_ = OB_ROW_MAX_COLUMNS_COUNT;
+      row.row_pos_flag_.reset();
+      if (OB_FAIL(reader_->get_row(current_, row))) {
+        STORAGE_LOG(WARN, "micro block reader fail to get row", K(ret), K(current_));
+      } else {
+        current_ += step_;
+        count++;
+      }
+    }
   }
   return ret;
 }
@@ -555,6 +700,8 @@ int ObMicroBlockRowScanner::inner_get_next_rows(const storage::ObStoreRow*& rows
 void ObMicroBlockRowScanner::reset()
 {
   ObIMicroBlockRowScanner::reset();
+  filter_bitmap_ = nullptr;
+  filter_begin_ = ObIMicroBlockReader::INVALID_ROW_INDEX;
 }
 
 int ObMultiVersionMicroBlockRowScanner::init(
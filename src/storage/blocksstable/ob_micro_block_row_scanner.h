@@ -14,6 +14,7 @@
 #define OB_MICRO_BLOCK_ROW_SCANNER_H_
 
 #include "lib/container/ob_raw_se_array.h"
+#include "lib/container/ob_bitmap.h"
 #include "ob_row_queue.h"
 #include "storage/ob_sstable.h"
 #include "storage/ob_row_fuse.h"
@@ -21,6 +22,7 @@
 #include "storage/blocksstable/ob_macro_block_reader.h"
 #include "storage/blocksstable/ob_imicro_block_reader.h"
 #include "storage/blocksstable/ob_sparse_micro_block_reader.h"
+#include "storage/blocksstable/ob_micro_block_decoder.h"
 #include "storage/blocksstable/ob_lob_data_reader.h"
 #include "storage/transaction/ob_trans_define.h"
 
@@ -29,6 +31,9 @@ namespace storage {
 class ObTableIterParam;
 class ObTableAccessContext;
 }  // namespace storage
+namespace sql {
+class ObPushdownFilterExecutor;
+}
 namespace blocksstable {
 
 class ObColumnMap;
@@ -102,6 +107,7 @@ protected:
   ObIMicroBlockReader* reader_;
   ObMicroBlockReader flat_reader_;
   ObSparseMicroBlockReader sparse_reader_;
+  ObMicroBlockDecoder decoder_;
   int64_t current_;  // current cursor
   int64_t start_;    // start of scan, inclusive.
   int64_t last_;     // end of scan, inclusive.
@@ -116,9 +122,14 @@ protected:
 };
 
 // major sstable micro block scanner for query and merge
+//
+// White filters of the pushdown filter (ObTableIterParam::pushdown_filter_) are evaluated when
+// the micro block opened: only the filter column of rows in scan range is read, the results are
+// combined to a bitmap by the logic nodes of the filter tree, black filters select all rows.
+// Only the rows selected by the bitmap are decoded and returned.
 class ObMicroBlockRowScanner : public ObIMicroBlockRowScanner {
 public:
-  ObMicroBlockRowScanner()
+  ObMicroBlockRowScanner() : filter_bitmap_(nullptr), filter_begin_(ObIMicroBlockReader::INVALID_ROW_INDEX)
   {}
   virtual ~ObMicroBlockRowScanner()
   {}
@@ -132,9 +143,21 @@ protected:
   virtual int inner_get_next_row(const storage::ObStoreRow*& row) override;
   virtual int inner_get_next_rows(const storage::ObStoreRow*& rows, int64_t& count) override;
 
+private:
+  int init_pushdown_filter_param(sql::ObPushdownFilterExecutor& filter);
+  int filter_micro_block_rows();
+  int filter_pushdown_filter(sql::ObPushdownFilterExecutor& filter, const int64_t begin_index,
+      const int64_t row_count, common::ObBitmap*& result_bitmap);
+  int get_filtered_rows(int64_t& count);
+  OB_INLINE void skip_filtered_rows();
+
 protected:
   storage::ObStoreRow rows_[ObIMicroBlockReader::OB_MAX_BATCH_ROW_COUNT];
   char obj_buf_[common::OB_ROW_MAX_COLUMNS_COUNT * sizeof(ObObj) * ObIMicroBlockReader::OB_MAX_BATCH_ROW_COUNT];
+  // result of pushdown filter of current micro block, NULL if no filter evaluated.
+  const common::ObBitmap* filter_bitmap_;
+  // row index of the first bit of %filter_bitmap_
+  int64_t filter_begin_;
 };
 
 /*
@@ -354,6 +377,15 @@ OB_INLINE int ObIMicroBlockRowScanner::end_of_block() const
   return ret;
 }
 
+OB_INLINE void ObMicroBlockRowScanner::skip_filtered_rows()
+{
+  if (nullptr != filter_bitmap_) {
+    while (common::OB_SUCCESS == end_of_block() && !filter_bitmap_->test(current_ - filter_begin_)) {
+      current_ += step_;
+    }
+  }
+}
+
 }  // namespace blocksstable
 }  // namespace oceanbase
 
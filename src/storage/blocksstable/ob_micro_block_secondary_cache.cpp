@@ -0,0 +1,693 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+#include "ob_micro_block_secondary_cache.h"
+#include <fcntl.h>
+#include "lib/checksum/ob_crc64.h"
+#include "lib/stat/ob_diagnose_info.h"
+
+namespace oceanbase {
+using namespace common;
+namespace blocksstable {
+/**
+ * ---------------------------------------------ObSecondaryCacheRecordHeader-----------------------------------------------
+ */
+ObSecondaryCacheRecordHeader::ObSecondaryCacheRecordHeader()
+    : magic_(RECORD_MAGIC),
+      data_size_(0),
+      data_checksum_(0),
+      table_id_(0),
+      block_id_(),
+      file_id_(0),
+      offset_(0),
+      size_(0)
+{}
+
+/**
+ * ---------------------------------------------ObSecondaryCacheIOCallback-------------------------------------------------
+ */
+ObSecondaryCacheIOCallback::ObSecondaryCacheIOCallback()
+    : secondary_cache_(NULL),
+      cache_(NULL),
+      put_size_stat_(NULL),
+      allocator_(NULL),
+      key_(),
+      entry_(),
+      is_pinned_(false),
+      use_block_cache_(true),
+      io_buffer_(NULL),
+      data_buffer_(NULL),
+      micro_block_(NULL),
+      handle_()
+{
+  static_assert(sizeof(*this) <= CALLBACK_BUF_SIZE, "IOCallback buf size not enough");
+}
+
+ObSecondaryCacheIOCallback::~ObSecondaryCacheIOCallback()
+{
+  unpin();
+  if (NULL != allocator_) {
+    if (NULL != io_buffer_) {
+      allocator_->free(io_buffer_);
+      io_buffer_ = NULL;
+    }
+    if (!handle_.is_valid() && NULL != micro_block_) {
+      allocator_->free(const_cast<ObMicroBlockCacheValue*>(micro_block_));
+      micro_block_ = NULL;
+    }
+  }
+}
+
+int64_t ObSecondaryCacheIOCallback::size() const
+{
+  return sizeof(*this);
+}
+
+int ObSecondaryCacheIOCallback::alloc_io_buf(char*& io_buf, int64_t& io_buf_size, int64_t& aligned_offset)
+{
+  int ret = OB_SUCCESS;
+  const int64_t record_offset = entry_.region_idx_ * ObMicroBlockSecondaryCache::REGION_SIZE + entry_.offset_;
+  io_buf_size = 0;
+  aligned_offset = 0;
+  common::align_offset_size(record_offset, entry_.record_size_, aligned_offset, io_buf_size);
+  if (OB_UNLIKELY(NULL == secondary_cache_ || NULL == allocator_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("Unexpected error, the callback is not valid", K(ret), KP_(secondary_cache), KP_(allocator));
+  } else if (OB_FAIL(secondary_cache_->pin_region(entry_))) {
+    if (OB_ENTRY_NOT_EXIST != ret) {
+      LOG_WARN("fail to pin region", K(ret), K_(entry));
+    }
+  } else {
+    // the copy in the io request is pinned, the pin is released once the record is copied out
+    is_pinned_ = true;
+    if (OB_ISNULL(io_buffer_ = static_cast<char*>(allocator_->alloc(io_buf_size + DIO_READ_ALIGN_SIZE)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("Fail to allocate memory", K(ret), K(io_buf_size));
+    } else {
+      io_buf = reinterpret_cast<char*>(upper_align(reinterpret_cast<int64_t>(io_buffer_), DIO_READ_ALIGN_SIZE));
+      data_buffer_ = io_buf + (record_offset - aligned_offset);
+    }
+  }
+  return ret;
+}
+
+int ObSecondaryCacheIOCallback::inner_process(const bool is_success)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(NULL == cache_ || NULL == allocator_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("Invalid secondary cache callback", K(ret), KP_(cache), KP_(allocator));
+  } else if (is_success) {
+    const ObSecondaryCacheRecordHeader* header = reinterpret_cast<const ObSecondaryCacheRecordHeader*>(data_buffer_);
+    if (OB_ISNULL(header)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("data buffer is null", K(ret));
+    } else if (OB_FAIL(check_record(*header))) {
+      LOG_ERROR("secondary block cache record is corrupted", K(ret), K_(key), K_(entry), K(*header));
+    } else if (OB_FAIL(put_cache_and_fetch(data_buffer_ + sizeof(ObSecondaryCacheRecordHeader), header->data_size_))) {
+      LOG_WARN("fail to put micro block", K(ret), K_(key));
+    }
+  }
+
+  unpin();
+  if (NULL != allocator_ && NULL != io_buffer_) {
+    allocator_->free(io_buffer_);
+    io_buffer_ = NULL;
+  }
+  return ret;
+}
+
+int ObSecondaryCacheIOCallback::check_record(const ObSecondaryCacheRecordHeader& header) const
+{
+  int ret = OB_SUCCESS;
+  if (!header.is_valid() || header.get_record_size() != entry_.record_size_) {
+    ret = OB_INVALID_DATA;
+  } else if (!(ObMicroBlockCacheKey(header.table_id_, header.block_id_, header.file_id_, header.offset_, header.size_) ==
+                 key_)) {
+    ret = OB_INVALID_DATA;
+  } else if (static_cast<int64_t>(ob_crc64(reinterpret_cast<const char*>(&header) + sizeof(header),
+                 header.data_size_)) != header.data_checksum_) {
+    ret = OB_CHECKSUM_ERROR;
+  }
+  return ret;
+}
+
+int ObSecondaryCacheIOCallback::put_cache_and_fetch(const char* block_buf, const int64_t block_size)
+{
+  int ret = OB_SUCCESS;
+  micro_block_ = NULL;
+  if (use_block_cache_) {
+    ObKVCachePair* kvpair = NULL;
+    ObKVCacheInstHandle inst_handle;
+    const bool overwrite = false;
+    if (OB_SUCCESS == cache_->get(key_, micro_block_, handle_)) {
+      // put by others
+    } else if (OB_FAIL(cache_->alloc(key_.get_tenant_id(),
+                   sizeof(ObMicroBlockCacheKey),
+                   sizeof(ObMicroBlockCacheValue) + block_size,
+                   kvpair,
+                   handle_,
+                   inst_handle,
+                   &key_))) {
+      LOG_WARN("failed to alloc cache buf", K(ret));
+    } else {
+      char* buf = reinterpret_cast<char*>(kvpair->value_) + sizeof(ObMicroBlockCacheValue);
+      MEMCPY(buf, block_buf, block_size);
+      new (kvpair->key_) ObMicroBlockCacheKey(key_);
+      ObMicroBlockCacheValue* cache_value = new (kvpair->value_) ObMicroBlockCacheValue(buf, block_size);
+      if (OB_FAIL(cache_->put_kvpair(inst_handle, kvpair, handle_, overwrite))) {
+        if (OB_ENTRY_EXIST != ret) {
+          LOG_WARN("failed to put micro block cache", K(ret));
+        } else {
+          ret = OB_SUCCESS;
+          micro_block_ = cache_value;
+        }
+      } else {
+        micro_block_ = cache_value;
+        const int64_t put_size = ObKVStoreMemBlock::get_align_size(key_, *cache_value);
+        if (OB_FAIL(put_size_stat_->add_put_size(put_size))) {
+          LOG_WARN("add_put_size failed", K(ret), K(put_size));
+        }
+      }
+      if (OB_FAIL(ret)) {
+        handle_.reset();
+        micro_block_ = NULL;
+      }
+    }
+  }
+
+  if (NULL == micro_block_) {
+    ObMicroBlockCacheValue value(block_buf, block_size);
+    ObIKVCacheValue* value_copy = NULL;
+    char* buf = NULL;
+    const int64_t buf_len = value.size();
+    ret = OB_SUCCESS;
+    handle_.reset();
+    if (OB_ISNULL(buf = static_cast<char*>(allocator_->alloc(buf_len)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("failed to allocate value", K(ret), K(buf_len));
+    } else if (OB_FAIL(value.deep_copy(buf, buf_len, value_copy))) {
+      LOG_WARN("failed to deep copy value", K(ret));
+      allocator_->free(buf);
+    } else {
+      micro_block_ = static_cast<const ObMicroBlockCacheValue*>(value_copy);
+    }
+  }
+  return ret;
+}
+
+int ObSecondaryCacheIOCallback::inner_deep_copy(char* buf, const int64_t buf_len, ObIOCallback*& callback) const
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(NULL == buf || buf_len < size())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid argument, ", KP(buf), K(buf_len), K(ret));
+  } else if (OB_UNLIKELY(NULL == secondary_cache_ || NULL == cache_ || NULL == allocator_)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("The secondary cache io callback is not valid", K(ret), KP_(secondary_cache), KP_(cache), KP_(allocator));
+  } else {
+    ObSecondaryCacheIOCallback* pcallback = new (buf) ObSecondaryCacheIOCallback();
+    pcallback->secondary_cache_ = secondary_cache_;
+    pcallback->cache_ = cache_;
+    pcallback->put_size_stat_ = put_size_stat_;
+    pcallback->allocator_ = allocator_;
+    pcallback->key_ = key_;
+    pcallback->entry_ = entry_;
+    pcallback->use_block_cache_ = use_block_cache_;
+    pcallback->micro_block_ = micro_block_;
+    pcallback->handle_ = handle_;
+    callback = pcallback;
+  }
+  return ret;
+}
+
+const char* ObSecondaryCacheIOCallback::get_data()
+{
+  const char* data = NULL;
+  if (NULL != micro_block_) {
+    data = reinterpret_cast<const char*>(&(micro_block_->get_block_data()));
+  }
+  return data;
+}
+
+void ObSecondaryCacheIOCallback::unpin()
+{
+  if (is_pinned_ && NULL != secondary_cache_) {
+    secondary_cache_->unpin_region(entry_.region_idx_);
+    is_pinned_ = false;
+  }
+}
+
+/**
+ * ---------------------------------------------ObMicroBlockSecondaryCache-------------------------------------------------
+ */
+ObMicroBlockSecondaryCache::ObMicroBlockSecondaryCache()
+    : is_inited_(false),
+      block_cache_(NULL),
+      fd_(),
+      region_cnt_(0),
+      regions_(NULL),
+      next_region_idx_(0),
+      region_seq_(0),
+      entries_(NULL),
+      set_cnt_(0),
+      index_lock_(),
+      buf_lock_(),
+      fill_idx_(0),
+      flush_idx_(0),
+      hit_cnt_(0),
+      miss_cnt_(0),
+      write_cnt_(0),
+      drop_cnt_(0)
+{
+  MEMSET(write_bufs_, 0, sizeof(write_bufs_));
+  MEMSET(write_buf_pos_, 0, sizeof(write_buf_pos_));
+}
+
+ObMicroBlockSecondaryCache::~ObMicroBlockSecondaryCache()
+{
+  destroy();
+}
+
+int ObMicroBlockSecondaryCache::init(const char* file_path, const int64_t file_size, ObMicroBlockCache& block_cache)
+{
+  int ret = OB_SUCCESS;
+  void* buf = NULL;
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("secondary block cache has been inited", K(ret));
+  } else if (OB_ISNULL(file_path) || OB_UNLIKELY(file_size < REGION_SIZE)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(file_path), K(file_size));
+  } else {
+    region_cnt_ = file_size / REGION_SIZE;
+    set_cnt_ = max(1L, region_cnt_ * (REGION_SIZE / AVG_RECORD_SIZE) / INDEX_WAY_CNT);
+    const ObMemAttr attr(OB_SERVER_TENANT_ID, ObModIds::OB_SECONDARY_BLOCK_CACHE);
+    if (OB_ISNULL(buf = ob_malloc(sizeof(ObSecondaryCacheRegion) * region_cnt_, attr))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to allocate regions", K(ret), K_(region_cnt));
+    } else {
+      regions_ = new (buf) ObSecondaryCacheRegion[region_cnt_];
+    }
+    if (OB_FAIL(ret)) {
+    } else if (OB_ISNULL(buf = ob_malloc(sizeof(ObSecondaryCacheEntry) * set_cnt_ * INDEX_WAY_CNT, attr))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to allocate index", K(ret), K_(set_cnt));
+    } else {
+      entries_ = new (buf) ObSecondaryCacheEntry[set_cnt_ * INDEX_WAY_CNT];
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < WRITE_BUF_CNT; ++i) {
+      if (OB_ISNULL(write_bufs_[i] = static_cast<char*>(ob_malloc_align(DIO_ALIGN_SIZE, REGION_SIZE, attr)))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("fail to allocate write buffer", K(ret), K(i));
+      }
+    }
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(index_lock_.init(set_cnt_, ObLatchIds::DEFAULT_BUCKET_LOCK, ObModIds::OB_SECONDARY_BLOCK_CACHE))) {
+      LOG_WARN("fail to init index lock", K(ret), K_(set_cnt));
+    } else if (OB_FAIL(open_file(file_path, region_cnt_ * REGION_SIZE))) {
+      LOG_WARN("fail to open secondary block cache file", K(ret), K(file_path));
+    } else {
+      block_cache_ = &block_cache;
+      is_inited_ = true;
+      if (OB_FAIL(lib::ThreadPool::start())) {
+        LOG_WARN("fail to start flush thread", K(ret));
+      } else if (OB_FAIL(block_cache.set_wash_callback(this))) {
+        LOG_WARN("fail to set wash callback", K(ret));
+      } else {
+        LOG_INFO("secondary block cache inited", K(file_path), K(*this));
+      }
+    }
+  }
+
+  if (OB_FAIL(ret) && OB_INIT_TWICE != ret) {
+    destroy();
+  }
+  return ret;
+}
+
+void ObMicroBlockSecondaryCache::destroy()
+{
+  int ret = OB_SUCCESS;
+  if (NULL != block_cache_) {
+    if (OB_FAIL(block_cache_->set_wash_callback(NULL))) {
+      LOG_WARN("fail to reset wash callback", K(ret));
+    }
+    block_cache_ = NULL;
+  }
+  lib::ThreadPool::stop();
+  lib::ThreadPool::wait();
+  {
+    // wait for the on_wash calls in progress
+    ObSpinLockGuard guard(buf_lock_);
+    is_inited_ = false;
+  }
+  if (fd_.is_valid()) {
+    if (OB_FAIL(ObIOManager::get_instance().delete_disk(fd_))) {
+      LOG_WARN("fail to delete disk", K(ret), K_(fd));
+    }
+    ::close(fd_.fd_);
+    fd_.reset();
+  }
+  for (int64_t i = 0; i < WRITE_BUF_CNT; ++i) {
+    if (NULL != write_bufs_[i]) {
+      ob_free_align(write_bufs_[i]);
+      write_bufs_[i] = NULL;
+    }
+    write_buf_pos_[i] = 0;
+  }
+  if (NULL != entries_) {
+    ob_free(entries_);
+    entries_ = NULL;
+  }
+  if (NULL != regions_) {
+    ob_free(regions_);
+    regions_ = NULL;
+  }
+  index_lock_.destroy();
+  region_cnt_ = 0;
+  set_cnt_ = 0;
+  next_region_idx_ = 0;
+  region_seq_ = 0;
+  fill_idx_ = 0;
+  flush_idx_ = 0;
+}
+
+int ObMicroBlockSecondaryCache::open_file(const char* file_path, const int64_t file_size)
+{
+  int ret = OB_SUCCESS;
+  // the content of the file is not trusted across restarts, it is always rebuilt from scratch
+  if ((fd_.fd_ = ::open(file_path, O_CREAT | O_DIRECT | O_RDWR | O_LARGEFILE, S_IRUSR | S_IWUSR)) < 0) {
+    ret = OB_IO_ERROR;
+    LOG_ERROR("open file error", K(ret), K(file_path), K(errno), KERRMSG);
+  } else if (0 != ::fallocate(fd_.fd_, 0 /*MODE*/, 0 /*offset*/, file_size)) {
+    ret = OB_IO_ERROR;
+    LOG_ERROR("fallocate file error", K(ret), K(file_path), K(file_size), K(errno), KERRMSG);
+  } else {
+    fd_.disk_id_.disk_idx_ = 0;
+    fd_.disk_id_.install_seq_ = 0;
+    if (OB_FAIL(ObIOManager::get_instance().add_disk(fd_, ObDisk::DEFAULT_SYS_IO_PERCENT))) {
+      LOG_WARN("add_disk failed", K(ret), K_(fd));
+    }
+  }
+  if (OB_FAIL(ret) && fd_.fd_ >= 0) {
+    ::close(fd_.fd_);
+    fd_.reset();
+  }
+  return ret;
+}
+
+void ObMicroBlockSecondaryCache::on_wash(const ObIKVCacheKey& key, const ObIKVCacheValue& value)
+{
+  int ret = OB_SUCCESS;
+  const ObMicroBlockCacheKey& block_key = static_cast<const ObMicroBlockCacheKey&>(key);
+  const ObMicroBlockData& block_data = static_cast<const ObMicroBlockCacheValue&>(value).get_block_data();
+  if (OB_UNLIKELY(!is_inited_)) {
+    // not serving
+  } else if (!block_data.is_valid() || block_data.get_extra_size() > 0 ||
+             static_cast<int64_t>(sizeof(ObSecondaryCacheRecordHeader)) + block_data.get_buf_size() > REGION_SIZE) {
+    // abandoned kv pair, or not supported by ObMicroBlockCacheValue::deep_copy
+  } else if (OB_FAIL(append_record(block_key, block_data))) {
+    if (OB_EAGAIN == ret) {
+      ATOMIC_INC(&drop_cnt_);
+    } else if (OB_NOT_INIT != ret) {
+      LOG_WARN("fail to append record", K(ret), K(block_key));
+    }
+  }
+}
+
+int ObMicroBlockSecondaryCache::append_record(const ObMicroBlockCacheKey& key, const ObMicroBlockData& block_data)
+{
+  int ret = OB_SUCCESS;
+  const int64_t data_checksum = static_cast<int64_t>(ob_crc64(block_data.get_buf(), block_data.get_buf_size()));
+  const int64_t record_size =
+      upper_align(sizeof(ObSecondaryCacheRecordHeader) + block_data.get_buf_size(), RECORD_ALIGN_SIZE);
+  ObSpinLockGuard guard(buf_lock_);
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+  } else {
+    int64_t buf_idx = fill_idx_ % WRITE_BUF_CNT;
+    if (write_buf_pos_[buf_idx] + record_size > REGION_SIZE) {
+      if (fill_idx_ + 1 - ATOMIC_LOAD(&flush_idx_) >= WRITE_BUF_CNT) {
+        // all the other buffers are waiting for flush
+        ret = OB_EAGAIN;
+      } else {
+        ATOMIC_INC(&fill_idx_);
+        buf_idx = fill_idx_ % WRITE_BUF_CNT;
+      }
+    }
+    if (OB_SUCC(ret)) {
+      char* buf = write_bufs_[buf_idx] + write_buf_pos_[buf_idx];
+      ObSecondaryCacheRecordHeader* header = new (buf) ObSecondaryCacheRecordHeader();
+      header->data_size_ = static_cast<int32_t>(block_data.get_buf_size());
+      header->data_checksum_ = data_checksum;
+      header->table_id_ = key.table_id_;
+      header->block_id_ = key.block_id_;
+      header->file_id_ = key.file_id_;
+      header->offset_ = key.offset_;
+      header->size_ = key.size_;
+      MEMCPY(buf + sizeof(ObSecondaryCacheRecordHeader), block_data.get_buf(), block_data.get_buf_size());
+      write_buf_pos_[buf_idx] += record_size;
+    }
+  }
+  return ret;
+}
+
+void ObMicroBlockSecondaryCache::run1()
+{
+  int ret = OB_SUCCESS;
+  lib::set_thread_name("SecBlkCacheFlush");
+  while (!has_set_stop()) {
+    if (ATOMIC_LOAD(&flush_idx_) < ATOMIC_LOAD(&fill_idx_)) {
+      const int64_t buf_idx = flush_idx_ % WRITE_BUF_CNT;
+      if (OB_FAIL(flush_write_buf(buf_idx))) {
+        LOG_WARN("fail to flush write buffer", K(ret), K(buf_idx));
+      }
+      // hand the buffer back to on_wash
+      ATOMIC_STORE(&write_buf_pos_[buf_idx], 0);
+      ATOMIC_INC(&flush_idx_);
+    } else {
+      usleep(FLUSH_IDLE_INTERVAL_US);
+    }
+    if (REACH_TIME_INTERVAL(PRINT_STAT_INTERVAL_US)) {
+      LOG_INFO("secondary block cache statistics", K(*this));
+    }
+  }
+}
+
+int ObMicroBlockSecondaryCache::flush_write_buf(const int64_t buf_idx)
+{
+  int ret = OB_SUCCESS;
+  const int64_t region_idx = next_region_idx_;
+  const int64_t region_seq = ATOMIC_AAF(&region_seq_, 1);
+  ObSecondaryCacheRegion& region = regions_[region_idx];
+  next_region_idx_ = (next_region_idx_ + 1) % region_cnt_;
+  // the index entries of the old content turn stale, wait until the reads pinned before are done
+  ATOMIC_STORE(&region.seq_, region_seq);
+  while (ATOMIC_LOAD(&region.ref_cnt_) > 0) {
+    PAUSE();
+  }
+  if (OB_FAIL(write_region(region_idx, write_bufs_[buf_idx]))) {
+    LOG_WARN("fail to write region", K(ret), K(region_idx));
+  } else {
+    build_index(region_idx, region_seq, write_bufs_[buf_idx], write_buf_pos_[buf_idx]);
+    ATOMIC_INC(&write_cnt_);
+  }
+  return ret;
+}
+
+int ObMicroBlockSecondaryCache::write_region(const int64_t region_idx, const char* buf)
+{
+  int ret = OB_SUCCESS;
+  ObIOInfo io_info;
+  io_info.offset_ = region_idx * REGION_SIZE;
+  io_info.size_ = static_cast<int32_t>(REGION_SIZE);
+  io_info.io_desc_.category_ = SYS_IO;
+  io_info.io_desc_.wait_event_no_ = ObWaitEventIds::DB_FILE_COMPACT_WRITE;
+  io_info.io_desc_.mode_ = ObIOMode::IO_MODE_WRITE;
+  io_info.batch_count_ = 1;
+
+  ObIOPoint& io_point = io_info.io_points_[0];
+  io_point.fd_ = fd_;
+  io_point.offset_ = io_info.offset_;
+  io_point.size_ = io_info.size_;
+  io_point.write_buf_ = buf;
+  if (OB_FAIL(ObIOManager::get_instance().write(io_info, IO_TIMEOUT_MS))) {
+    LOG_WARN("fail to write", K(ret), K(io_info));
+  }
+  return ret;
+}
+
+void ObMicroBlockSecondaryCache::build_index(
+    const int64_t region_idx, const int64_t region_seq, const char* buf, const int64_t data_len)
+{
+  int64_t pos = 0;
+  while (pos + static_cast<int64_t>(sizeof(ObSecondaryCacheRecordHeader)) <= data_len) {
+    const ObSecondaryCacheRecordHeader* header = reinterpret_cast<const ObSecondaryCacheRecordHeader*>(buf + pos);
+    const ObMicroBlockCacheKey key(header->table_id_, header->block_id_, header->file_id_, header->offset_, header->size_);
+    ObSecondaryCacheEntry entry;
+    entry.hash_ = get_key_hash(key);
+    entry.region_seq_ = region_seq;
+    entry.region_idx_ = static_cast<int32_t>(region_idx);
+    entry.offset_ = static_cast<int32_t>(pos);
+    entry.record_size_ = static_cast<int32_t>(header->get_record_size());
+    insert_entry(entry);
+    pos += upper_align(header->get_record_size(), RECORD_ALIGN_SIZE);
+  }
+}
+
+void ObMicroBlockSecondaryCache::insert_entry(const ObSecondaryCacheEntry& entry)
+{
+  int ret = OB_SUCCESS;
+  const int64_t set_idx = entry.hash_ % set_cnt_;
+  ObSecondaryCacheEntry* set = entries_ + set_idx * INDEX_WAY_CNT;
+  ObBucketWLockGuard guard(index_lock_, set_idx);
+  if (OB_FAIL(guard.get_ret())) {
+    LOG_WARN("fail to lock index", K(ret), K(set_idx));
+  } else {
+    // replace the entry of the same block, or an empty one, or the oldest one
+    int64_t victim = -1;
+    bool victim_is_free = false;
+    for (int64_t i = 0; i < INDEX_WAY_CNT; ++i) {
+      const bool is_free = 0 == set[i].hash_ || is_stale(set[i]);
+      if (set[i].hash_ == entry.hash_) {
+        victim = i;
+        break;
+      } else if (victim < 0 || (!victim_is_free && (is_free || set[i].region_seq_ < set[victim].region_seq_))) {
+        victim = i;
+        victim_is_free = is_free;
+      }
+    }
+    set[victim] = entry;
+  }
+}
+
+int ObMicroBlockSecondaryCache::get_entry(const ObMicroBlockCacheKey& key, ObSecondaryCacheEntry& entry)
+{
+  int ret = OB_SUCCESS;
+  const uint64_t hash = get_key_hash(key);
+  const int64_t set_idx = hash % set_cnt_;
+  const ObSecondaryCacheEntry* set = entries_ + set_idx * INDEX_WAY_CNT;
+  ObBucketRLockGuard guard(index_lock_, set_idx);
+  if (OB_FAIL(guard.get_ret())) {
+    LOG_WARN("fail to lock index", K(ret), K(set_idx));
+  } else {
+    ret = OB_ENTRY_NOT_EXIST;
+    for (int64_t i = 0; OB_ENTRY_NOT_EXIST == ret && i < INDEX_WAY_CNT; ++i) {
+      if (set[i].hash_ == hash && !is_stale(set[i])) {
+        entry = set[i];
+        ret = OB_SUCCESS;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockSecondaryCache::pin_region(const ObSecondaryCacheEntry& entry)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("secondary block cache not init", K(ret));
+  } else if (OB_UNLIKELY(entry.region_idx_ < 0 || entry.region_idx_ >= region_cnt_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid entry", K(ret), K(entry), K_(region_cnt));
+  } else {
+    ObSecondaryCacheRegion& region = regions_[entry.region_idx_];
+    ATOMIC_INC(&region.ref_cnt_);
+    if (is_stale(entry)) {
+      // the region is being overwritten
+      ATOMIC_DEC(&region.ref_cnt_);
+      ret = OB_ENTRY_NOT_EXIST;
+    }
+  }
+  return ret;
+}
+
+void ObMicroBlockSecondaryCache::unpin_region(const int64_t region_idx)
+{
+  if (NULL != regions_ && region_idx >= 0 && region_idx < region_cnt_) {
+    ATOMIC_DEC(&regions_[region_idx].ref_cnt_);
+  }
+}
+
+uint64_t ObMicroBlockSecondaryCache::get_key_hash(const ObMicroBlockCacheKey& key)
+{
+  const uint64_t hash = key.hash();
+  return 0 == hash ? 1 : hash;
+}
+
+int ObMicroBlockSecondaryCache::prefetch(const ObMicroBlockCacheKey& key, const ObIODesc& io_desc,
+    const bool use_block_cache, ObIMicroBlockCache& block_cache, ObIOHandle& io_handle)
+{
+  int ret = OB_SUCCESS;
+  ObSecondaryCacheEntry entry;
+  ObIMicroBlockCache::BaseBlockCache* cache = NULL;
+  ObIAllocator* allocator = NULL;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("secondary block cache not init", K(ret));
+  } else if (static_cast<ObIMicroBlockCache*>(block_cache_) != &block_cache) {
+    // only the user block cache is backed by the cache file
+    ret = OB_ENTRY_NOT_EXIST;
+  } else if (OB_FAIL(get_entry(key, entry))) {
+    if (OB_ENTRY_NOT_EXIST == ret) {
+      ATOMIC_INC(&miss_cnt_);
+    } else {
+      LOG_WARN("fail to get entry", K(ret), K(key));
+    }
+  } else if (OB_FAIL(block_cache.get_cache(cache))) {
+    LOG_WARN("get_cache failed", K(ret));
+  } else if (OB_FAIL(block_cache.get_allocator(allocator))) {
+    LOG_WARN("get_allocator failed", K(ret));
+  } else {
+    ObSecondaryCacheIOCallback callback;
+    callback.secondary_cache_ = this;
+    callback.cache_ = cache;
+    callback.put_size_stat_ = &block_cache;
+    callback.allocator_ = allocator;
+    callback.key_ = key;
+    callback.entry_ = entry;
+    callback.use_block_cache_ = use_block_cache;
+
+    int64_t aligned_offset = 0;
+    int64_t aligned_size = 0;
+    common::align_offset_size(
+        entry.region_idx_ * REGION_SIZE + entry.offset_, entry.record_size_, aligned_offset, aligned_size);
+    ObIOInfo io_info;
+    io_info.offset_ = aligned_offset;
+    io_info.size_ = static_cast<int32_t>(aligned_size);
+    io_info.io_desc_ = io_desc;
+    io_info.io_desc_.mode_ = ObIOMode::IO_MODE_READ;
+    io_info.batch_count_ = 1;
+    ObIOPoint& io_point = io_info.io_points_[0];
+    io_point.fd_ = fd_;
+    io_point.offset_ = aligned_offset;
+    io_point.size_ = io_info.size_;
+
+    io_handle.reset();
+    if (OB_FAIL(ObIOManager::get_instance().aio_read(io_info, callback, io_handle))) {
+      // the region may be overwritten after the lookup
+      if (OB_ENTRY_NOT_EXIST != ret) {
+        LOG_WARN("fail to aio_read", K(ret), K(io_info));
+      }
+      io_handle.reset();
+    } else {
+      ATOMIC_INC(&hit_cnt_);
+    }
+  }
+  return ret;
+}
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
@@ -0,0 +1,191 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_SECONDARY_CACHE_H_
+#define OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_SECONDARY_CACHE_H_
+
+#include "lib/io/ob_io_manager.h"
+#include "lib/lock/ob_bucket_lock.h"
+#include "lib/lock/ob_spin_lock.h"
+#include "lib/thread/thread_pool.h"
+#include "share/cache/ob_kvcache_struct.h"
+#include "ob_micro_block_cache.h"
+
+namespace oceanbase {
+namespace blocksstable {
+
+// Header of a micro block in the secondary block cache file, followed by the decompressed block data.
+struct ObSecondaryCacheRecordHeader {
+  static const int32_t RECORD_MAGIC = 0x53424352;  // "SBCR"
+  ObSecondaryCacheRecordHeader();
+  bool is_valid() const
+  {
+    return RECORD_MAGIC == magic_ && data_size_ > 0;
+  }
+  int64_t get_record_size() const
+  {
+    return sizeof(ObSecondaryCacheRecordHeader) + data_size_;
+  }
+  TO_STRING_KV(K_(magic), K_(data_size), K_(data_checksum), K_(table_id), K_(block_id), K_(file_id), K_(offset),
+      K_(size));
+
+  int32_t magic_;
+  int32_t data_size_;
+  int64_t data_checksum_;
+  // ObMicroBlockCacheKey of the block
+  uint64_t table_id_;
+  MacroBlockId block_id_;
+  int64_t file_id_;
+  int64_t offset_;
+  int64_t size_;
+};
+
+// Index entry of a micro block, the entry is stale once its region is overwritten.
+struct ObSecondaryCacheEntry {
+  ObSecondaryCacheEntry() : hash_(0), region_seq_(0), region_idx_(0), offset_(0), record_size_(0)
+  {}
+  TO_STRING_KV(K_(hash), K_(region_seq), K_(region_idx), K_(offset), K_(record_size));
+
+  uint64_t hash_;  // hash of the block key, 0 for empty entry
+  int64_t region_seq_;
+  int32_t region_idx_;
+  int32_t offset_;  // offset of the record in the region
+  int32_t record_size_;
+};
+
+struct ObSecondaryCacheRegion {
+  ObSecondaryCacheRegion() : seq_(0), ref_cnt_(0)
+  {}
+  int64_t seq_;      // bumped before the region is overwritten
+  int64_t ref_cnt_;  // number of reads in flight
+};
+
+class ObMicroBlockSecondaryCache;
+
+class ObSecondaryCacheIOCallback : public common::ObIOCallback {
+public:
+  ObSecondaryCacheIOCallback();
+  virtual ~ObSecondaryCacheIOCallback();
+  virtual int64_t size() const;
+  virtual int alloc_io_buf(char*& io_buf, int64_t& io_buf_size, int64_t& aligned_offset);
+  virtual int inner_process(const bool is_success);
+  virtual int inner_deep_copy(char* buf, const int64_t buf_len, ObIOCallback*& callback) const;
+  virtual const char* get_data();
+  TO_STRING_KV(K_(key), K_(entry), K_(is_pinned), KP_(micro_block));
+
+private:
+  friend class ObMicroBlockSecondaryCache;
+  int check_record(const ObSecondaryCacheRecordHeader& header) const;
+  int put_cache_and_fetch(const char* block_buf, const int64_t block_size);
+  void unpin();
+
+private:
+  ObMicroBlockSecondaryCache* secondary_cache_;
+  ObIMicroBlockCache::BaseBlockCache* cache_;
+  ObIPutSizeStat* put_size_stat_;
+  common::ObIAllocator* allocator_;
+  ObMicroBlockCacheKey key_;
+  ObSecondaryCacheEntry entry_;
+  bool is_pinned_;
+  bool use_block_cache_;
+  char* io_buffer_;
+  char* data_buffer_;
+  const ObMicroBlockCacheValue* micro_block_;
+  common::ObKVCacheHandle handle_;
+};
+
+// Second tier of the user block cache on a local SSD file.
+//
+// The micro blocks washed out of the in-memory block cache are appended to a write buffer, full buffers are
+// written by a background thread to the regions of the file in ring order, overwriting the oldest one.
+// A set associative index in memory maps the block key to its record, a block cache miss that hits the index
+// is read from the file instead of the data file. All of it is best effort: washed blocks are dropped when the
+// write buffers are exhausted, and index entries are replaced by newer ones on set conflict.
+class ObMicroBlockSecondaryCache : public common::ObIKVCacheWashCallback, public lib::ThreadPool {
+public:
+  static const int64_t REGION_SIZE = 2L * 1024L * 1024L;
+  static const int64_t WRITE_BUF_CNT = 8;
+  static const int64_t INDEX_WAY_CNT = 4;
+  static const int64_t AVG_RECORD_SIZE = 8L * 1024L;
+  static const int64_t RECORD_ALIGN_SIZE = 8;
+  static const int64_t IO_TIMEOUT_MS = 10L * 1000L;
+  static const int64_t FLUSH_IDLE_INTERVAL_US = 10L * 1000L;
+  static const int64_t PRINT_STAT_INTERVAL_US = 10L * 1000L * 1000L;
+
+public:
+  ObMicroBlockSecondaryCache();
+  virtual ~ObMicroBlockSecondaryCache();
+  int init(const char* file_path, const int64_t file_size, ObMicroBlockCache& block_cache);
+  void destroy();
+  // called with the kv pairs of the block cache washed out of memory
+  virtual void on_wash(const common::ObIKVCacheKey& key, const common::ObIKVCacheValue& value) override;
+  // Asynchronously read the micro block of %key from the cache file and put it into %block_cache, the io
+  // callback fills the same data as ObIMicroBlockCache::prefetch. Return OB_ENTRY_NOT_EXIST if the block is
+  // not in the cache file.
+  int prefetch(const ObMicroBlockCacheKey& key, const common::ObIODesc& io_desc, const bool use_block_cache,
+      ObIMicroBlockCache& block_cache, common::ObIOHandle& io_handle);
+  virtual void run1() override;
+  inline bool is_inited() const
+  {
+    return is_inited_;
+  }
+  TO_STRING_KV(K_(is_inited), K_(fd), K_(region_cnt), K_(set_cnt), K_(fill_idx), K_(flush_idx), K_(hit_cnt),
+      K_(miss_cnt), K_(write_cnt), K_(drop_cnt));
+
+private:
+  friend class ObSecondaryCacheIOCallback;
+  int open_file(const char* file_path, const int64_t file_size);
+  int get_entry(const ObMicroBlockCacheKey& key, ObSecondaryCacheEntry& entry);
+  int pin_region(const ObSecondaryCacheEntry& entry);
+  void unpin_region(const int64_t region_idx);
+  int append_record(const ObMicroBlockCacheKey& key, const ObMicroBlockData& block_data);
+  int flush_write_buf(const int64_t buf_idx);
+  int write_region(const int64_t region_idx, const char* buf);
+  void build_index(const int64_t region_idx, const int64_t region_seq, const char* buf, const int64_t data_len);
+  void insert_entry(const ObSecondaryCacheEntry& entry);
+  static uint64_t get_key_hash(const ObMicroBlockCacheKey& key);
+  inline bool is_stale(const ObSecondaryCacheEntry& entry) const
+  {
+    return ATOMIC_LOAD(&regions_[entry.region_idx_].seq_) != entry.region_seq_;
+  }
+
+private:
+  bool is_inited_;
+  ObMicroBlockCache* block_cache_;
+  common::ObDiskFd fd_;
+  int64_t region_cnt_;
+  ObSecondaryCacheRegion* regions_;
+  int64_t next_region_idx_;  // only touched by the flush thread
+  int64_t region_seq_;
+  ObSecondaryCacheEntry* entries_;
+  int64_t set_cnt_;
+  common::ObBucketLock index_lock_;
+  // write buffers in ring order, [flush_idx_, fill_idx_) are full and waiting for flush, fill_idx_ is being filled
+  common::ObSpinLock buf_lock_;
+  char* write_bufs_[WRITE_BUF_CNT];
+  int64_t write_buf_pos_[WRITE_BUF_CNT];
+  int64_t fill_idx_;
+  int64_t flush_idx_;
+  // statistics
+  int64_t hit_cnt_;
+  int64_t miss_cnt_;
+  int64_t write_cnt_;
+  int64_t drop_cnt_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObMicroBlockSecondaryCache);
+};
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
+
+#endif  // OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_SECONDARY_CACHE_H_
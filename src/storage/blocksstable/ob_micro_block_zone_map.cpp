@@ -0,0 +1,471 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_micro_block_zone_map.h"
+#include "sql/engine/basic/ob_pushdown_filter.h"
+
+namespace oceanbase {
+using namespace common;
+using namespace sql;
+namespace blocksstable {
+
+/**
+ * ---------------------------------------------------------ObMicroBlockZoneMapBuilder--------------------------------------------------------------
+ */
+ObMicroBlockZoneMapBuilder::ObMicroBlockZoneMapBuilder()
+    : is_inited_(false), column_count_(0), row_count_(0), stats_(), entry_buf_(0, "MicrZoneMap")
+{}
+
+ObMicroBlockZoneMapBuilder::~ObMicroBlockZoneMapBuilder()
+{}
+
+int ObMicroBlockZoneMapBuilder::init(const int64_t column_count)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("zone map builder is inited twice", K(ret));
+  } else if (OB_UNLIKELY(column_count <= 0 || column_count > MAX_COLUMN_COUNT)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(column_count));
+  } else if (OB_FAIL(entry_buf_.ensure_space(get_max_entry_size(column_count)))) {
+    LOG_WARN("failed to ensure space for zone map entry", K(ret), K(column_count));
+  } else {
+    column_count_ = column_count;
+    is_inited_ = true;
+    reuse();
+  }
+  return ret;
+}
+
+int ObMicroBlockZoneMapBuilder::update(const ObNewRow& row)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("zone map builder is not inited", K(ret));
+  } else if (OB_UNLIKELY(!row.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(row));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < column_count_; ++i) {
+      if (i >= row.count_) {
+        stats_[i].null_count_ = -1;
+        stats_[i].is_tracked_ = false;
+      } else if (OB_FAIL(update_column(row.cells_[i], stats_[i]))) {
+        LOG_WARN("failed to update column", K(ret), K(i), K(row.cells_[i]));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      ++row_count_;
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockZoneMapBuilder::update_column(const ObObj& obj, ColumnStat& stat)
+{
+  int ret = OB_SUCCESS;
+  int cmp = 0;
+  if (stat.null_count_ < 0) {
+    // column is unknown in this micro block
+  } else if (obj.is_ext()) {
+    // nop value, nothing is known about the column
+    stat.null_count_ = -1;
+    stat.is_tracked_ = false;
+  } else if (obj.is_null()) {
+    ++stat.null_count_;
+  } else if (!stat.is_tracked_) {
+  } else if (ob_is_text_tc(obj.get_type()) || obj.get_deep_copy_size() > MAX_VALUE_SIZE ||
+             obj.get_serialize_size() > MAX_OBJ_SERIALIZE_SIZE) {
+    stat.is_tracked_ = false;
+  } else if (stat.min_.is_null()) {
+    if (OB_FAIL(copy_value(obj, stat.min_buf_, stat.min_))) {
+      LOG_WARN("failed to copy min value", K(ret), K(obj));
+    } else if (OB_FAIL(copy_value(obj, stat.max_buf_, stat.max_))) {
+      LOG_WARN("failed to copy max value", K(ret), K(obj));
+    }
+  } else if (OB_FAIL(obj.compare(stat.min_, cmp))) {
+    LOG_WARN("failed to compare with min value", K(ret), K(obj), K(stat.min_));
+  } else if (cmp < 0) {
+    if (OB_FAIL(copy_value(obj, stat.min_buf_, stat.min_))) {
+      LOG_WARN("failed to copy min value", K(ret), K(obj));
+    }
+  } else if (OB_FAIL(obj.compare(stat.max_, cmp))) {
+    LOG_WARN("failed to compare with max value", K(ret), K(obj), K(stat.max_));
+  } else if (cmp > 0) {
+    if (OB_FAIL(copy_value(obj, stat.max_buf_, stat.max_))) {
+      LOG_WARN("failed to copy max value", K(ret), K(obj));
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockZoneMapBuilder::copy_value(const ObObj& src, char* buf, ObObj& dst)
+{
+  int64_t pos = 0;
+  return dst.deep_copy(src, buf, MAX_VALUE_SIZE, pos);
+}
+
+int ObMicroBlockZoneMapBuilder::build(ObString& entry)
+{
+  int ret = OB_SUCCESS;
+  entry.reset();
+  entry_buf_.reuse();
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("zone map builder is not inited", K(ret));
+  } else if (OB_FAIL(entry_buf_.write(row_count_))) {
+    LOG_WARN("failed to write row count", K(ret), K_(row_count));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < column_count_; ++i) {
+      const ColumnStat& stat = stats_[i];
+      const int8_t has_min_max = stat.is_tracked_ && !stat.min_.is_null() ? 1 : 0;
+      if (OB_FAIL(entry_buf_.write(stat.null_count_))) {
+        LOG_WARN("failed to write null count", K(ret), K(i));
+      } else if (OB_FAIL(entry_buf_.write(has_min_max))) {
+        LOG_WARN("failed to write min max flag", K(ret), K(i));
+      } else if (0 == has_min_max) {
+      } else if (OB_FAIL(entry_buf_.write(stat.min_))) {
+        LOG_WARN("failed to write min value", K(ret), K(i), K(stat.min_));
+      } else if (OB_FAIL(entry_buf_.write(stat.max_))) {
+        LOG_WARN("failed to write max value", K(ret), K(i), K(stat.max_));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      entry.assign_ptr(entry_buf_.data(), static_cast<int32_t>(entry_buf_.length()));
+    }
+  }
+  return ret;
+}
+
+void ObMicroBlockZoneMapBuilder::reuse()
+{
+  row_count_ = 0;
+  for (int64_t i = 0; i < column_count_; ++i) {
+    stats_[i].reuse();
+  }
+  entry_buf_.reuse();
+}
+
+void ObMicroBlockZoneMapBuilder::reset()
+{
+  reuse();
+  is_inited_ = false;
+  column_count_ = 0;
+  entry_buf_.reset();
+}
+
+int64_t ObMicroBlockZoneMapBuilder::get_max_entry_size(const int64_t column_count)
+{
+  return sizeof(int32_t) + column_count * (sizeof(int32_t) + sizeof(int8_t) + 2 * MAX_OBJ_SERIALIZE_SIZE);
+}
+
+/**
+ * ---------------------------------------------------------ObMicroBlockZoneMapWriter--------------------------------------------------------------
+ */
+ObMicroBlockZoneMapWriter::ObMicroBlockZoneMapWriter()
+    : column_count_(0), micro_block_count_(0), offsets_(0, "MicrZoneMap"), entries_(0, "MicrZoneMap")
+{
+  MEMSET(column_ids_, 0, sizeof(column_ids_));
+}
+
+ObMicroBlockZoneMapWriter::~ObMicroBlockZoneMapWriter()
+{}
+
+int ObMicroBlockZoneMapWriter::init(const uint64_t* column_ids, const int64_t column_count)
+{
+  int ret = OB_SUCCESS;
+  reuse();
+  if (OB_UNLIKELY(NULL == column_ids || column_count <= 0 ||
+                  column_count > ObMicroBlockZoneMapBuilder::MAX_COLUMN_COUNT)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(column_ids), K(column_count));
+  } else {
+    for (int64_t i = 0; i < column_count; ++i) {
+      column_ids_[i] = static_cast<uint16_t>(column_ids[i]);
+    }
+    column_count_ = column_count;
+  }
+  return ret;
+}
+
+int ObMicroBlockZoneMapWriter::add_entry(const ObString& entry)
+{
+  int ret = OB_SUCCESS;
+  const int32_t offset = static_cast<int32_t>(entries_.length());
+  if (OB_UNLIKELY(!is_enabled())) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("zone map writer is not inited", K(ret));
+  } else if (OB_FAIL(offsets_.write(offset))) {
+    LOG_WARN("failed to write entry offset", K(ret), K(offset));
+  } else if (!entry.empty() && OB_FAIL(entries_.write(entry.ptr(), entry.length()))) {
+    LOG_WARN("failed to write entry", K(ret), K(entry.length()));
+  } else {
+    ++micro_block_count_;
+  }
+  return ret;
+}
+
+int ObMicroBlockZoneMapWriter::merge(const ObMicroBlockZoneMapWriter& other)
+{
+  int ret = OB_SUCCESS;
+  const int32_t base_offset = static_cast<int32_t>(entries_.length());
+  const int32_t* offsets = reinterpret_cast<const int32_t*>(other.offsets_.data());
+  if (!is_enabled() && !other.is_enabled()) {
+  } else if (OB_UNLIKELY(column_count_ != other.column_count_ ||
+                         0 != MEMCMP(column_ids_, other.column_ids_, sizeof(uint16_t) * column_count_))) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("zone map columns not match", K(ret), K(*this), K(other));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < other.micro_block_count_; ++i) {
+      if (OB_FAIL(offsets_.write(static_cast<int32_t>(base_offset + offsets[i])))) {
+        LOG_WARN("failed to write entry offset", K(ret), K(i));
+      }
+    }
+    if (OB_SUCC(ret) && other.entries_.length() > 0) {
+      if (OB_FAIL(entries_.write(other.entries_.data(), other.entries_.length()))) {
+        LOG_WARN("failed to write entries", K(ret), K(other));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      micro_block_count_ += other.micro_block_count_;
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockZoneMapWriter::build(ObSelfBufferWriter& data) const
+{
+  int ret = OB_SUCCESS;
+  ObMicroBlockZoneMapHeader header;
+  header.column_count_ = static_cast<int16_t>(column_count_);
+  header.micro_block_count_ = micro_block_count_;
+  const int64_t column_ids_size = ObMicroBlockZoneMapHeader::get_column_ids_size(column_count_);
+  const int64_t padding_size = column_ids_size - column_count_ * static_cast<int64_t>(sizeof(uint16_t));
+  const int32_t end_offset = static_cast<int32_t>(entries_.length());
+  if (OB_UNLIKELY(!is_enabled())) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("zone map writer is not inited", K(ret));
+  } else if (OB_UNLIKELY(get_size() > data.remain())) {
+    ret = OB_BUF_NOT_ENOUGH;
+    LOG_WARN("zone map size is larger than data remain size", K(ret), "size", get_size(), K(data.remain()));
+  } else if (OB_FAIL(data.write(header))) {
+    LOG_WARN("failed to write zone map header", K(ret), K(header));
+  } else if (OB_FAIL(data.write(reinterpret_cast<const char*>(column_ids_), column_ids_size - padding_size))) {
+    LOG_WARN("failed to write zone map column ids", K(ret));
+  } else if (OB_FAIL(data.advance_zero(padding_size))) {
+    LOG_WARN("failed to write zone map padding", K(ret), K(padding_size));
+  } else if (OB_FAIL(data.write(offsets_.data(), offsets_.length()))) {
+    LOG_WARN("failed to write zone map offsets", K(ret));
+  } else if (OB_FAIL(data.write(end_offset))) {
+    LOG_WARN("failed to write zone map end offset", K(ret), K(end_offset));
+  } else if (OB_FAIL(data.write(entries_.data(), entries_.length()))) {
+    LOG_WARN("failed to write zone map entries", K(ret));
+  }
+  return ret;
+}
+
+void ObMicroBlockZoneMapWriter::reuse()
+{
+  column_count_ = 0;
+  micro_block_count_ = 0;
+  offsets_.reuse();
+  entries_.reuse();
+}
+
+void ObMicroBlockZoneMapWriter::reset()
+{
+  reuse();
+  offsets_.reset();
+  entries_.reset();
+}
+
+/**
+ * ---------------------------------------------------------ObMicroBlockZoneMapReader--------------------------------------------------------------
+ */
+ObMicroBlockZoneMapReader::ObMicroBlockZoneMapReader()
+    : is_inited_(false),
+      header_(),
+      buf_(NULL),
+      size_(0),
+      column_ids_(NULL),
+      offsets_(NULL),
+      entries_(NULL),
+      columns_()
+{}
+
+ObMicroBlockZoneMapReader::~ObMicroBlockZoneMapReader()
+{}
+
+int ObMicroBlockZoneMapReader::init(const char* buf, const int64_t size)
+{
+  int ret = OB_SUCCESS;
+  is_inited_ = false;
+  if (OB_UNLIKELY(NULL == buf || size < static_cast<int64_t>(sizeof(ObMicroBlockZoneMapHeader)))) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(buf), K(size));
+  } else {
+    int64_t pos = sizeof(ObMicroBlockZoneMapHeader);
+    MEMCPY(&header_, buf, sizeof(ObMicroBlockZoneMapHeader));
+    if (OB_UNLIKELY(!header_.is_valid() || header_.column_count_ > ObMicroBlockZoneMapBuilder::MAX_COLUMN_COUNT)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("invalid zone map header", K(ret), K_(header));
+    } else {
+      column_ids_ = reinterpret_cast<const uint16_t*>(buf + pos);
+      pos += ObMicroBlockZoneMapHeader::get_column_ids_size(header_.column_count_);
+      offsets_ = reinterpret_cast<const int32_t*>(buf + pos);
+      pos += (header_.micro_block_count_ + 1) * static_cast<int64_t>(sizeof(int32_t));
+      if (OB_UNLIKELY(pos > size || offsets_[header_.micro_block_count_] != size - pos)) {
+        ret = OB_INVALID_DATA;
+        LOG_WARN("invalid zone map size", K(ret), K(pos), K(size), K_(header));
+      } else {
+        entries_ = buf + pos;
+        buf_ = buf;
+        size_ = size;
+        is_inited_ = true;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockZoneMapReader::get_entry(
+    const int64_t micro_idx, bool& is_known, int32_t& row_count, ObMicroBlockZoneMapColumn* columns)
+{
+  int ret = OB_SUCCESS;
+  is_known = false;
+  row_count = 0;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("zone map reader is not inited", K(ret));
+  } else if (OB_UNLIKELY(micro_idx < 0 || micro_idx >= header_.micro_block_count_ || NULL == columns)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(micro_idx), K_(header), KP(columns));
+  } else {
+    const int32_t begin = offsets_[micro_idx];
+    const int32_t end = offsets_[micro_idx + 1];
+    if (OB_UNLIKELY(begin < 0 || begin > end || end > offsets_[header_.micro_block_count_])) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("invalid zone map entry offset", K(ret), K(micro_idx), K(begin), K(end));
+    } else if (begin == end) {
+      // micro block without zone map
+    } else {
+      ObBufferReader reader(entries_ + begin, end - begin);
+      if (OB_FAIL(reader.read(row_count))) {
+        LOG_WARN("failed to read row count", K(ret), K(micro_idx));
+      }
+      for (int64_t i = 0; OB_SUCC(ret) && i < header_.column_count_; ++i) {
+        ObMicroBlockZoneMapColumn& column = columns[i];
+        int8_t has_min_max = 0;
+        column.reset();
+        if (OB_FAIL(reader.read(column.null_count_))) {
+          LOG_WARN("failed to read null count", K(ret), K(micro_idx), K(i));
+        } else if (OB_FAIL(reader.read(has_min_max))) {
+          LOG_WARN("failed to read min max flag", K(ret), K(micro_idx), K(i));
+        } else if (0 == has_min_max) {
+        } else if (OB_FAIL(reader.read(column.min_))) {
+          LOG_WARN("failed to read min value", K(ret), K(micro_idx), K(i));
+        } else if (OB_FAIL(reader.read(column.max_))) {
+          LOG_WARN("failed to read max value", K(ret), K(micro_idx), K(i));
+        } else {
+          column.has_min_max_ = true;
+        }
+      }
+      if (OB_SUCC(ret)) {
+        is_known = true;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockZoneMapReader::can_skip(const int64_t micro_idx, ObPushdownFilterExecutor& filter, bool& can_skip)
+{
+  int ret = OB_SUCCESS;
+  bool is_known = false;
+  int32_t row_count = 0;
+  can_skip = false;
+  if (OB_FAIL(get_entry(micro_idx, is_known, row_count, columns_))) {
+    LOG_WARN("failed to get zone map entry", K(ret), K(micro_idx));
+  } else if (!is_known || row_count <= 0) {
+  } else if (OB_FAIL(check_filter(filter, row_count, can_skip))) {
+    LOG_WARN("failed to check filter", K(ret), K(micro_idx));
+  }
+  return ret;
+}
+
+int ObMicroBlockZoneMapReader::check_filter(
+    ObPushdownFilterExecutor& filter, const int32_t row_count, bool& can_skip) const
+{
+  int ret = OB_SUCCESS;
+  can_skip = false;
+  if (filter.is_filter_white_node()) {
+    if (OB_FAIL(check_white_filter(static_cast<ObWhiteFilterExecutor&>(filter), row_count, can_skip))) {
+      LOG_WARN("failed to check white filter", K(ret));
+    }
+  } else if (filter.is_filter_black_node()) {
+    // black filters are evaluated by the table scan operator
+  } else if (filter.is_logic_op_node()) {
+    // AND node can be skipped if any child can be skipped, OR node only if all children can be skipped
+    const bool is_and = filter.is_logic_and_node();
+    can_skip = !is_and && filter.get_child_count() > 0;
+    for (uint32_t i = 0; OB_SUCC(ret) && can_skip != is_and && i < filter.get_child_count(); ++i) {
+      ObPushdownFilterExecutor* child = NULL;
+      if (OB_FAIL(filter.get_child(i, child))) {
+        LOG_WARN("failed to get child filter", K(ret), K(i));
+      } else if (OB_ISNULL(child)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("child filter is null", K(ret), K(i));
+      } else if (OB_FAIL(check_filter(*child, row_count, can_skip))) {
+        LOG_WARN("failed to check child filter", K(ret), K(i));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockZoneMapReader::check_white_filter(
+    ObWhiteFilterExecutor& filter, const int32_t row_count, bool& can_skip) const
+{
+  int ret = OB_SUCCESS;
+  can_skip = false;
+  const ObIArray<uint64_t>& col_ids = filter.get_col_ids();
+  int64_t column_idx = -1;
+  if (1 == col_ids.count()) {
+    for (int64_t i = 0; -1 == column_idx && i < header_.column_count_; ++i) {
+      if (column_ids_[i] == col_ids.at(0)) {
+        column_idx = i;
+      }
+    }
+  }
+  if (column_idx >= 0) {
+    const ObMicroBlockZoneMapColumn& column = columns_[column_idx];
+    const bool is_null_filtered =
+        sql::WHITE_OP_NU != filter.get_white_filter_node().get_op_type() || 0 == column.null_count_;
+    bool is_range_filtered = column.null_count_ == row_count;
+    if (column.null_count_ < 0 || !is_null_filtered) {
+    } else if (is_range_filtered || !column.has_min_max_) {
+      can_skip = is_range_filtered;
+    } else if (OB_FAIL(filter.filter_range(column.min_, column.max_, is_range_filtered))) {
+      LOG_WARN("failed to filter value range", K(ret), K(column));
+    } else {
+      can_skip = is_range_filtered;
+    }
+  }
+  return ret;
+}
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
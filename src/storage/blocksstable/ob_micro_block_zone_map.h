@@ -0,0 +1,196 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_ZONE_MAP_H_
+#define OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_ZONE_MAP_H_
+
+#include "common/object/ob_object.h"
+#include "common/row/ob_row.h"
+#include "lib/string/ob_string.h"
+#include "ob_data_buffer.h"
+
+namespace oceanbase {
+namespace sql {
+class ObPushdownFilterExecutor;
+class ObWhiteFilterExecutor;
+}  // namespace sql
+namespace blocksstable {
+
+// The zone map section is stored at the end of the block index of a macro block:
+//   ObMicroBlockZoneMapHeader | column ids | entry offsets | entries
+// The column ids are the leading %column_count_ columns of the row, padded to 4 bytes. The entry offsets are
+// relative to the first entry, with one more offset for the end of the last entry. An entry is
+//   row count | (null count, has min max, [min, max]) of each column
+// with min and max serialized as ObObj. An empty entry means nothing is known about the micro block.
+struct ObMicroBlockZoneMapHeader {
+  static const int16_t ZONE_MAP_VERSION = 1;
+  ObMicroBlockZoneMapHeader() : version_(ZONE_MAP_VERSION), column_count_(0), micro_block_count_(0)
+  {}
+  bool is_valid() const
+  {
+    return ZONE_MAP_VERSION == version_ && column_count_ > 0 && micro_block_count_ >= 0;
+  }
+  static int64_t get_column_ids_size(const int64_t column_count)
+  {
+    return common::upper_align(column_count * static_cast<int64_t>(sizeof(uint16_t)), sizeof(int32_t));
+  }
+  TO_STRING_KV(K_(version), K_(column_count), K_(micro_block_count));
+
+  int16_t version_;
+  int16_t column_count_;
+  int32_t micro_block_count_;
+};
+
+struct ObMicroBlockZoneMapColumn {
+  ObMicroBlockZoneMapColumn() : null_count_(0), has_min_max_(false), min_(), max_()
+  {}
+  void reset()
+  {
+    null_count_ = 0;
+    has_min_max_ = false;
+    min_.reset();
+    max_.reset();
+  }
+  TO_STRING_KV(K_(null_count), K_(has_min_max), K_(min), K_(max));
+
+  int32_t null_count_;
+  bool has_min_max_;  // false if some values of the column are not tracked
+  common::ObObj min_;
+  common::ObObj max_;
+};
+
+// Collects the zone map entry of the micro block being built.
+class ObMicroBlockZoneMapBuilder {
+public:
+  static const int64_t MAX_COLUMN_COUNT = 64;
+  // leading columns tracked by major sstables, fixed so that all replicas write the same blocks
+  static const int64_t DEFAULT_COLUMN_COUNT = 8;
+  // values longer than this are not tracked, so the entry of a micro block has a bounded size
+  static const int64_t MAX_VALUE_SIZE = 64;
+  static const int64_t MAX_OBJ_SERIALIZE_SIZE = MAX_VALUE_SIZE + 32;
+
+public:
+  ObMicroBlockZoneMapBuilder();
+  ~ObMicroBlockZoneMapBuilder();
+  int init(const int64_t column_count);
+  int update(const common::ObNewRow& row);
+  // build the entry of the rows updated since last reuse, %entry is valid until next call
+  int build(common::ObString& entry);
+  void reuse();
+  void reset();
+  inline bool is_inited() const
+  {
+    return is_inited_;
+  }
+  static int64_t get_max_entry_size(const int64_t column_count);
+  TO_STRING_KV(K_(is_inited), K_(column_count), K_(row_count));
+
+private:
+  struct ColumnStat {
+    ColumnStat() : null_count_(0), is_tracked_(true), min_(), max_()
+    {}
+    void reuse()
+    {
+      null_count_ = 0;
+      is_tracked_ = true;
+      min_.reset();
+      max_.reset();
+    }
+    int32_t null_count_;
+    bool is_tracked_;
+    common::ObObj min_;
+    common::ObObj max_;
+    char min_buf_[MAX_VALUE_SIZE];
+    char max_buf_[MAX_VALUE_SIZE];
+  };
+  int update_column(const common::ObObj& obj, ColumnStat& stat);
+  int copy_value(const common::ObObj& src, char* buf, common::ObObj& dst);
+
+private:
+  bool is_inited_;
+  int64_t column_count_;
+  int32_t row_count_;
+  ColumnStat stats_[MAX_COLUMN_COUNT];
+  ObSelfBufferWriter entry_buf_;
+  DISALLOW_COPY_AND_ASSIGN(ObMicroBlockZoneMapBuilder);
+};
+
+// Collects the zone map entries of the micro blocks of a macro block and writes the zone map section.
+class ObMicroBlockZoneMapWriter {
+public:
+  ObMicroBlockZoneMapWriter();
+  ~ObMicroBlockZoneMapWriter();
+  int init(const uint64_t* column_ids, const int64_t column_count);
+  // an empty %entry is added for micro blocks without zone map
+  int add_entry(const common::ObString& entry);
+  int merge(const ObMicroBlockZoneMapWriter& other);
+  int build(ObSelfBufferWriter& data) const;
+  void reuse();
+  void reset();
+  inline bool is_enabled() const
+  {
+    return column_count_ > 0;
+  }
+  // size of the whole section, 0 if disabled
+  inline int64_t get_size() const
+  {
+    return is_enabled() ? get_fixed_size(column_count_) + offsets_.length() + entries_.length() : 0;
+  }
+  // size of the section without any entry
+  static int64_t get_fixed_size(const int64_t column_count)
+  {
+    return sizeof(ObMicroBlockZoneMapHeader) + ObMicroBlockZoneMapHeader::get_column_ids_size(column_count) +
+           sizeof(int32_t);
+  }
+  TO_STRING_KV(K_(column_count), K_(micro_block_count), "entries_size", entries_.length());
+
+private:
+  int64_t column_count_;
+  int32_t micro_block_count_;
+  uint16_t column_ids_[ObMicroBlockZoneMapBuilder::MAX_COLUMN_COUNT];
+  ObSelfBufferWriter offsets_;
+  ObSelfBufferWriter entries_;
+  DISALLOW_COPY_AND_ASSIGN(ObMicroBlockZoneMapWriter);
+};
+
+// Reads the zone map section of a macro block, the values of entries refer to the section buffer.
+class ObMicroBlockZoneMapReader {
+public:
+  ObMicroBlockZoneMapReader();
+  ~ObMicroBlockZoneMapReader();
+  int init(const char* buf, const int64_t size);
+  // %is_known is false for micro blocks without zone map, %row_count and %columns are filled otherwise
+  int get_entry(const int64_t micro_idx, bool& is_known, int32_t& row_count, ObMicroBlockZoneMapColumn* columns);
+  // %can_skip is true if no row of the micro block can be selected by %filter
+  int can_skip(const int64_t micro_idx, sql::ObPushdownFilterExecutor& filter, bool& can_skip);
+  TO_STRING_KV(K_(is_inited), K_(header), K_(size));
+
+private:
+  int check_filter(sql::ObPushdownFilterExecutor& filter, const int32_t row_count, bool& can_skip) const;
+  int check_white_filter(sql::ObWhiteFilterExecutor& filter, const int32_t row_count, bool& can_skip) const;
+
+private:
+  bool is_inited_;
+  ObMicroBlockZoneMapHeader header_;
+  const char* buf_;
+  int64_t size_;
+  const uint16_t* column_ids_;
+  const int32_t* offsets_;
+  const char* entries_;
+  ObMicroBlockZoneMapColumn columns_[ObMicroBlockZoneMapBuilder::MAX_COLUMN_COUNT];
+  DISALLOW_COPY_AND_ASSIGN(ObMicroBlockZoneMapReader);
+};
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
+
+#endif  // OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_ZONE_MAP_H_
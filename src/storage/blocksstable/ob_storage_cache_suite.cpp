@@ -17,7 +17,14 @@ using namespace oceanbase::common;
 namespace oceanbase {
 namespace blocksstable {
 ObStorageCacheSuite::ObStorageCacheSuite()
-    : block_index_cache_(), user_block_cache_(), user_row_cache_(), bf_cache_(), fuse_row_cache_(), is_inited_(false)
+    : block_index_cache_(),
+      user_block_cache_(),
+      user_row_cache_(),
+      bf_cache_(),
+      fuse_row_cache_(),
+      secondary_block_cache_(),
+      block_cache_snapshot_(),
+      is_inited_(false)
 {}
 
 ObStorageCacheSuite::~ObStorageCacheSuite()
@@ -61,6 +68,48 @@ int ObStorageCacheSuite::init(const int64_t index_cache_priority, const int64_t
   return ret;
 }
 
+int ObStorageCacheSuite::init_secondary_block_cache(const char* file_path, const int64_t file_size)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "The cache suite has not been inited, ", K(ret));
+  } else if (NULL == file_path || '\0' == file_path[0] || file_size <= 0) {
+    STORAGE_LOG(INFO, "secondary block cache is disabled", K(file_path), K(file_size));
+  } else if (OB_FAIL(secondary_block_cache_.init(file_path, file_size, user_block_cache_))) {
+    STORAGE_LOG(ERROR, "init secondary block cache failed, ", K(ret), K(file_path), K(file_size));
+  }
+  return ret;
+}
+
+int ObStorageCacheSuite::init_block_cache_snapshot(const char* file_path)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "The cache suite has not been inited, ", K(ret));
+  } else if (NULL == file_path || '\0' == file_path[0]) {
+    STORAGE_LOG(INFO, "block cache snapshot is disabled");
+  } else if (OB_FAIL(block_cache_snapshot_.init(file_path, user_block_cache_))) {
+    STORAGE_LOG(ERROR, "init block cache snapshot failed, ", K(ret), K(file_path));
+  }
+  return ret;
+}
+
+int ObStorageCacheSuite::load_block_cache_snapshot()
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "The cache suite has not been inited, ", K(ret));
+  } else if (!block_cache_snapshot_.is_inited()) {
+    // disabled
+  } else if (OB_FAIL(block_cache_snapshot_.load())) {
+    STORAGE_LOG(WARN, "load block cache snapshot failed, ", K(ret));
+  }
+  return ret;
+}
+
 int ObStorageCacheSuite::reset_priority(const int64_t index_cache_priority, const int64_t user_block_cache_priority,
     const int64_t user_row_cache_priority, const int64_t fuse_row_cache_priority, const int64_t bf_cache_priority)
 {
@@ -93,6 +142,8 @@ int ObStorageCacheSuite::set_bf_cache_miss_count_threshold(const int64_t bf_cach
 
 void ObStorageCacheSuite::destroy()
 {
+  block_cache_snapshot_.destroy();
+  secondary_block_cache_.destroy();
   block_index_cache_.destroy();
   user_block_cache_.destroy();
   user_row_cache_.destroy();
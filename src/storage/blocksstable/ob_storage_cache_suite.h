@@ -16,6 +16,8 @@
 #include "share/schema/ob_table_schema.h"
 #include "ob_micro_block_index_cache.h"
 #include "ob_micro_block_cache.h"
+#include "ob_micro_block_secondary_cache.h"
+#include "ob_micro_block_cache_snapshot.h"
 #include "ob_block_cache_working_set.h"
 #include "ob_row_cache.h"
 #include "ob_fuse_row_cache.h"
@@ -33,6 +35,12 @@ public:
   int init(const int64_t index_cache_priority, const int64_t user_block_cache_priority,
       const int64_t user_row_cache_priority, const int64_t fuse_row_cache_priority, const int64_t bf_cache_priority,
       const int64_t bf_cache_miss_count_threshold);
+  // the secondary block cache is optional, nothing is done if %file_path is empty or %file_size is 0
+  int init_secondary_block_cache(const char* file_path, const int64_t file_size);
+  // the block cache snapshot is optional, nothing is done if %file_path is empty
+  int init_block_cache_snapshot(const char* file_path);
+  // warm up the block cache with the snapshot written before restart, called before the server starts service
+  int load_block_cache_snapshot();
   int reset_priority(const int64_t index_cache_priority, const int64_t user_block_cache_priority,
       const int64_t user_row_cache_priority, const int64_t fuse_row_cache_priority, const int64_t bf_cache_priority);
   int set_bf_cache_miss_count_threshold(const int64_t bf_cache_miss_count_threshold);
@@ -40,6 +48,10 @@ public:
   {
     return user_block_cache_;
   }
+  ObMicroBlockSecondaryCache& get_secondary_block_cache()
+  {
+    return secondary_block_cache_;
+  }
   ObMicroBlockIndexCache& get_micro_index_cache()
   {
     return block_index_cache_;
@@ -72,6 +84,8 @@ private:
   ObRowCache user_row_cache_;
   ObBloomFilterCache bf_cache_;
   ObFuseRowCache fuse_row_cache_;
+  ObMicroBlockSecondaryCache secondary_block_cache_;
+  ObMicroBlockCacheSnapshot block_cache_snapshot_;
   bool is_inited_;
 
 private:
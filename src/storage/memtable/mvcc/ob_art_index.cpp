@@ -0,0 +1,1465 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "storage/memtable/mvcc/ob_art_index.h"
+
+#include "lib/allocator/ob_malloc.h"
+#include "lib/container/ob_se_array.h"
+
+namespace oceanbase {
+namespace memtable {
+using namespace common;
+
+/*
+ * ------------------------------------------------------------ObArtKey-----------------------------------------------
+ */
+ObArtKey::ObArtKey() : buf_(inline_buf_), len_(0), cap_(INLINE_BUF_SIZE)
+{}
+
+ObArtKey::~ObArtKey()
+{
+  if (buf_ != inline_buf_) {
+    ob_free(buf_);
+  }
+  buf_ = nullptr;
+}
+
+void ObArtKey::reset()
+{
+  len_ = 0;
+}
+
+bool ObArtKey::is_supported(const ObStoreRowkey& rowkey)
+{
+  bool bool_ret = rowkey.get_obj_cnt() > 0;
+  const ObObj* objs = rowkey.get_obj_ptr();
+  for (int64_t i = 0; bool_ret && i < rowkey.get_obj_cnt(); ++i) {
+    const ObObj& obj = objs[i];
+    switch (obj.get_type_class()) {
+      case ObIntTC:
+      case ObUIntTC:
+      case ObDateTimeTC:
+      case ObDateTC:
+      case ObTimeTC:
+      case ObYearTC:
+        break;
+      case ObStringTC:
+        bool_ret = CS_TYPE_BINARY == obj.get_collation_type() || CS_TYPE_UTF8MB4_BIN == obj.get_collation_type();
+        break;
+      default:
+        bool_ret = false;
+        break;
+    }
+  }
+  return bool_ret;
+}
+
+int ObArtKey::reserve(const int64_t size)
+{
+  int ret = OB_SUCCESS;
+  if (size > cap_) {
+    uint8_t* buf = nullptr;
+    const int64_t cap = MAX(size, cap_ * 2);
+    if (OB_ISNULL(buf = static_cast<uint8_t*>(ob_malloc(cap, ObModIds::OB_MEMSTORE)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      TRANS_LOG(WARN, "alloc art key buffer failed", K(ret), K(cap));
+    } else {
+      if (buf_ != inline_buf_) {
+        ob_free(buf_);
+      }
+      buf_ = buf;
+      cap_ = cap;
+    }
+  }
+  return ret;
+}
+
+int ObArtKey::encode(const ObStoreRowkey& rowkey)
+{
+  int ret = OB_SUCCESS;
+  int64_t size = 0;
+  const ObObj* objs = rowkey.get_obj_ptr();
+  len_ = 0;
+  // upper bound of the encoded size, a string is at most 4 times as long after encoding
+  for (int64_t i = 0; i < rowkey.get_obj_cnt(); ++i) {
+    size += 1 + sizeof(uint64_t) + (objs[i].is_string_type() ? 4 * objs[i].get_string_len() : 0);
+  }
+  if (OB_FAIL(reserve(size))) {
+    TRANS_LOG(WARN, "reserve art key buffer failed", K(ret), K(size));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < rowkey.get_obj_cnt(); ++i) {
+    if (OB_FAIL(encode_obj(objs[i]))) {
+      TRANS_LOG(WARN, "encode obj failed", K(ret), K(i), K(rowkey));
+    }
+  }
+  return ret;
+}
+
+int ObArtKey::encode_obj(const ObObj& obj)
+{
+  int ret = OB_SUCCESS;
+  if (obj.is_min_value()) {
+    buf_[len_++] = MIN_TAG;
+  } else if (obj.is_max_value()) {
+    buf_[len_++] = MAX_TAG;
+  } else if (obj.is_null()) {
+    buf_[len_++] = NULL_TAG;
+  } else {
+    buf_[len_++] = VALUE_TAG;
+    switch (obj.get_type_class()) {
+      case ObIntTC:
+        encode_uint64(static_cast<uint64_t>(obj.get_int()) ^ SIGN_BIT);
+        break;
+      case ObUIntTC:
+        encode_uint64(obj.get_uint64());
+        break;
+      case ObDateTimeTC:
+        encode_uint64(static_cast<uint64_t>(obj.get_datetime()) ^ SIGN_BIT);
+        break;
+      case ObDateTC:
+        encode_uint64(static_cast<uint64_t>(static_cast<int64_t>(obj.get_date())) ^ SIGN_BIT);
+        break;
+      case ObTimeTC:
+        encode_uint64(static_cast<uint64_t>(obj.get_time()) ^ SIGN_BIT);
+        break;
+      case ObYearTC:
+        buf_[len_++] = obj.get_year();
+        break;
+      case ObStringTC:
+        if (CS_TYPE_BINARY == obj.get_collation_type()) {
+          encode_binary_string(obj.get_string());
+        } else if (CS_TYPE_UTF8MB4_BIN == obj.get_collation_type()) {
+          encode_pad_space_string(obj.get_string());
+        } else {
+          ret = OB_NOT_SUPPORTED;
+        }
+        break;
+      default:
+        ret = OB_NOT_SUPPORTED;
+        break;
+    }
+    if (OB_NOT_SUPPORTED == ret) {
+      TRANS_LOG(WARN, "obj not supported by art key", K(ret), K(obj));
+    }
+  }
+  return ret;
+}
+
+void ObArtKey::encode_uint64(const uint64_t value)
+{
+  for (int64_t i = sizeof(uint64_t) - 1; i >= 0; --i) {
+    buf_[len_++] = static_cast<uint8_t>(value >> (i * 8));
+  }
+}
+
+void ObArtKey::encode_binary_string(const ObString& str)
+{
+  const uint8_t* ptr = reinterpret_cast<const uint8_t*>(str.ptr());
+  for (int64_t i = 0; i < str.length(); ++i) {
+    buf_[len_++] = ptr[i];
+    if (0 == ptr[i]) {
+      buf_[len_++] = 0xff;
+    }
+  }
+  buf_[len_++] = 0;
+  buf_[len_++] = 0;
+}
+
+// Strings of a PAD SPACE collation compare as if the shorter one were padded with spaces, the order of utf8mb4_bin
+// is otherwise the byte order. After trailing spaces are removed, a run of spaces is always followed by another
+// character c, it is encoded as a space and
+//   0x01 and the run length in 4 bytes big endian if c is less than a space, longer runs are greater
+//   0x03 and the inverted run length if c is greater than a space, longer runs are smaller
+// and the end of the string is a space and 0x02, which sorts between the two like an endless run of spaces.
+void ObArtKey::encode_pad_space_string(const ObString& str)
+{
+  const uint8_t* ptr = reinterpret_cast<const uint8_t*>(str.ptr());
+  int64_t end = str.length();
+  while (end > 0 && ' ' == ptr[end - 1]) {
+    --end;
+  }
+  for (int64_t i = 0; i < end;) {
+    if (' ' != ptr[i]) {
+      buf_[len_++] = ptr[i++];
+    } else {
+      int64_t run = 0;
+      while (' ' == ptr[i + run]) {
+        ++run;
+      }
+      uint32_t run_len = static_cast<uint32_t>(run);
+      buf_[len_++] = ' ';
+      if (ptr[i + run] < ' ') {
+        buf_[len_++] = 0x01;
+      } else {
+        buf_[len_++] = 0x03;
+        run_len = ~run_len;
+      }
+      for (int64_t j = sizeof(uint32_t) - 1; j >= 0; --j) {
+        buf_[len_++] = static_cast<uint8_t>(run_len >> (j * 8));
+      }
+      i += run;
+    }
+  }
+  buf_[len_++] = ' ';
+  buf_[len_++] = 0x02;
+}
+
+int ObArtKey::compare(const ObArtKey& other) const
+{
+  int cmp = MEMCMP(buf_, other.buf_, MIN(len_, other.len_));
+  if (0 == cmp) {
+    cmp = len_ < other.len_ ? -1 : (len_ > other.len_ ? 1 : 0);
+  }
+  return cmp;
+}
+
+/*
+ * ------------------------------------------------------------ObArtNode----------------------------------------------
+ */
+class ObArtNode {
+public:
+  enum NodeType { NODE4 = 0, NODE16 = 1, NODE48 = 2, NODE256 = 3 };
+  static const int64_t MAX_PREFIX_LEN = 8;
+  static const uint64_t OBSOLETE_BIT = 1;
+  static const uint64_t LOCKED_BIT = 2;
+  static const uint64_t LEAF_TAG = 1;
+
+public:
+  explicit ObArtNode(const uint8_t type) : version_(0), prefix_len_(0), count_(0), type_(type)
+  {}
+  // false if the node is obsolete, wait if it is being modified
+  inline bool read_lock(uint64_t& version) const
+  {
+    version = ATOMIC_LOAD(&version_);
+    while (0 != (version & LOCKED_BIT)) {
+      PAUSE();
+      version = ATOMIC_LOAD(&version_);
+    }
+    return 0 == (version & OBSOLETE_BIT);
+  }
+  // false if the node has changed since %version was read
+  inline bool check(const uint64_t version) const
+  {
+    return version == ATOMIC_LOAD(&version_);
+  }
+  inline bool upgrade_lock(const uint64_t version)
+  {
+    return ATOMIC_BCAS(&version_, version, version + LOCKED_BIT);
+  }
+  inline void unlock()
+  {
+    (void)ATOMIC_AAF(&version_, LOCKED_BIT);
+  }
+  inline void unlock_obsolete()
+  {
+    (void)ATOMIC_AAF(&version_, LOCKED_BIT + OBSOLETE_BIT);
+  }
+  // keep the version increasing when the node is reused, so that stale readers can tell
+  void reuse();
+  inline bool is_full() const;
+  inline uint32_t get_prefix_len() const
+  {
+    return ATOMIC_LOAD(&prefix_len_);
+  }
+  inline int64_t get_child_count() const
+  {
+    return ATOMIC_LOAD(&count_);
+  }
+  inline uint8_t get_type() const
+  {
+    return type_;
+  }
+  inline const uint8_t* get_prefix() const
+  {
+    return prefix_;
+  }
+  void set_prefix(const uint8_t* prefix, const uint32_t prefix_len);
+  ObArtNode* find_child(const uint8_t byte) const;
+  // the first child whose byte is not less than %from, or not greater than %from if %is_reverse
+  bool next_child(const int64_t from, const bool is_reverse, uint8_t& byte, ObArtNode*& child) const;
+  inline ObArtNode* first_child() const
+  {
+    uint8_t byte = 0;
+    ObArtNode* child = nullptr;
+    return next_child(0, false, byte, child) ? child : nullptr;
+  }
+  // the node must be locked and not full
+  void add_child(const uint8_t byte, ObArtNode* child);
+  // the node must be locked and has the child
+  void change_child(const uint8_t byte, ObArtNode* child);
+  void copy_to(ObArtNode& other) const;
+  static int64_t get_node_size(const uint8_t type);
+  static ObArtNode* new_node(void* buf, const uint8_t type);
+  static inline bool is_leaf(const ObArtNode* node)
+  {
+    return 0 != (reinterpret_cast<uint64_t>(node) & LEAF_TAG);
+  }
+  static inline const ObArtLeaf* to_leaf(const ObArtNode* node)
+  {
+    return reinterpret_cast<const ObArtLeaf*>(reinterpret_cast<uint64_t>(node) & ~LEAF_TAG);
+  }
+  static inline ObArtNode* from_leaf(const ObArtLeaf* leaf)
+  {
+    return reinterpret_cast<ObArtNode*>(reinterpret_cast<uint64_t>(leaf) | LEAF_TAG);
+  }
+
+public:
+  uint64_t version_;
+  uint32_t prefix_len_;
+  uint16_t count_;
+  uint8_t type_;
+  uint8_t prefix_[MAX_PREFIX_LEN];
+};
+
+// children sorted by their bytes
+template <int64_t CAPACITY>
+class ObArtSortedNode : public ObArtNode {
+public:
+  explicit ObArtSortedNode(const uint8_t type) : ObArtNode(type)
+  {
+    MEMSET(keys_, 0, sizeof(keys_));
+    MEMSET(children_, 0, sizeof(children_));
+  }
+  ObArtNode* find_child(const uint8_t byte) const
+  {
+    ObArtNode* child = nullptr;
+    const int64_t count = MIN(get_child_count(), CAPACITY);
+    for (int64_t i = 0; nullptr == child && i < count; ++i) {
+      if (keys_[i] == byte) {
+        child = ATOMIC_LOAD(&children_[i]);
+      }
+    }
+    return child;
+  }
+  bool next_child(const int64_t from, const bool is_reverse, uint8_t& byte, ObArtNode*& child) const
+  {
+    bool found = false;
+    const int64_t count = MIN(get_child_count(), CAPACITY);
+    if (!is_reverse) {
+      for (int64_t i = 0; !found && i < count; ++i) {
+        if (keys_[i] >= from) {
+          byte = keys_[i];
+          child = ATOMIC_LOAD(&children_[i]);
+          found = true;
+        }
+      }
+    } else {
+      for (int64_t i = count - 1; !found && i >= 0; --i) {
+        if (keys_[i] <= from) {
+          byte = keys_[i];
+          child = ATOMIC_LOAD(&children_[i]);
+          found = true;
+        }
+      }
+    }
+    return found && nullptr != child;
+  }
+  void add_child(const uint8_t byte, ObArtNode* child)
+  {
+    int64_t pos = count_;
+    for (; pos > 0 && keys_[pos - 1] > byte; --pos) {
+      keys_[pos] = keys_[pos - 1];
+      ATOMIC_STORE(&children_[pos], children_[pos - 1]);
+    }
+    keys_[pos] = byte;
+    ATOMIC_STORE(&children_[pos], child);
+    ATOMIC_STORE(&count_, count_ + 1);
+  }
+  void change_child(const uint8_t byte, ObArtNode* child)
+  {
+    for (int64_t i = 0; i < count_; ++i) {
+      if (keys_[i] == byte) {
+        ATOMIC_STORE(&children_[i], child);
+      }
+    }
+  }
+  void reuse()
+  {
+    MEMSET(keys_, 0, sizeof(keys_));
+    MEMSET(children_, 0, sizeof(children_));
+  }
+
+public:
+  uint8_t keys_[CAPACITY];
+  ObArtNode* children_[CAPACITY];
+};
+
+typedef ObArtSortedNode<4> ObArtNode4;
+typedef ObArtSortedNode<16> ObArtNode16;
+
+class ObArtNode48 : public ObArtNode {
+public:
+  static const int64_t CAPACITY = 48;
+  ObArtNode48() : ObArtNode(NODE48)
+  {
+    reuse();
+  }
+  ObArtNode* find_child(const uint8_t byte) const
+  {
+    const uint8_t idx = child_index_[byte];
+    return EMPTY_INDEX == idx ? nullptr : ATOMIC_LOAD(&children_[idx % CAPACITY]);
+  }
+  bool next_child(const int64_t from, const bool is_reverse, uint8_t& byte, ObArtNode*& child) const
+  {
+    child = nullptr;
+    for (int64_t b = from; nullptr == child && b >= 0 && b <= UINT8_MAX; b += is_reverse ? -1 : 1) {
+      if (EMPTY_INDEX != child_index_[b]) {
+        byte = static_cast<uint8_t>(b);
+        child = ATOMIC_LOAD(&children_[child_index_[b] % CAPACITY]);
+      }
+    }
+    return nullptr != child;
+  }
+  void add_child(const uint8_t byte, ObArtNode* child)
+  {
+    // children are never removed, so the slots are taken in order
+    ATOMIC_STORE(&children_[count_], child);
+    child_index_[byte] = static_cast<uint8_t>(count_);
+    ATOMIC_STORE(&count_, count_ + 1);
+  }
+  void change_child(const uint8_t byte, ObArtNode* child)
+  {
+    ATOMIC_STORE(&children_[child_index_[byte]], child);
+  }
+  void reuse()
+  {
+    MEMSET(child_index_, EMPTY_INDEX, sizeof(child_index_));
+    MEMSET(children_, 0, sizeof(children_));
+  }
+
+public:
+  static const uint8_t EMPTY_INDEX = UINT8_MAX;
+  uint8_t child_index_[UINT8_MAX + 1];
+  ObArtNode* children_[CAPACITY];
+};
+
+class ObArtNode256 : public ObArtNode {
+public:
+  ObArtNode256() : ObArtNode(NODE256)
+  {
+    reuse();
+  }
+  ObArtNode* find_child(const uint8_t byte) const
+  {
+    return ATOMIC_LOAD(&children_[byte]);
+  }
+  bool next_child(const int64_t from, const bool is_reverse, uint8_t& byte, ObArtNode*& child) const
+  {
+    child = nullptr;
+    for (int64_t b = from; nullptr == child && b >= 0 && b <= UINT8_MAX; b += is_reverse ? -1 : 1) {
+      if (nullptr != (child = ATOMIC_LOAD(&children_[b]))) {
+        byte = static_cast<uint8_t>(b);
+      }
+    }
+    return nullptr != child;
+  }
+  void add_child(const uint8_t byte, ObArtNode* child)
+  {
+    ATOMIC_STORE(&children_[byte], child);
+    ATOMIC_STORE(&count_, count_ + 1);
+  }
+  void change_child(const uint8_t byte, ObArtNode* child)
+  {
+    ATOMIC_STORE(&children_[byte], child);
+  }
+  void reuse()
+  {
+    MEMSET(children_, 0, sizeof(children_));
+  }
+
+public:
+  ObArtNode* children_[UINT8_MAX + 1];
+};
+
+#define ART_NODE_DISPATCH(node_type, func, args...)                            \
+  switch (node_type) {                                                       \
+    case NODE4:                                                              \
+      return static_cast<ObArtNode4*>(this)->func(args);                     \
+    case NODE16:                                                             \
+      return static_cast<ObArtNode16*>(this)->func(args);                    \
+    case NODE48:                                                             \
+      return static_cast<ObArtNode48*>(this)->func(args);                    \
+    default:                                                                 \
+      return static_cast<ObArtNode256*>(this)->func(args);                   \
+  }
+
+#define ART_CONST_NODE_DISPATCH(node_type, func, args...)                      \
+  switch (node_type) {                                                       \
+    case NODE4:                                                              \
+      return static_cast<const ObArtNode4*>(this)->func(args);               \
+    case NODE16:                                                             \
+      return static_cast<const ObArtNode16*>(this)->func(args);              \
+    case NODE48:                                                             \
+      return static_cast<const ObArtNode48*>(this)->func(args);              \
+    default:                                                                 \
+      return static_cast<const ObArtNode256*>(this)->func(args);             \
+  }
+
+void ObArtNode::reuse()
+{
+  const uint64_t version = ATOMIC_LOAD(&version_);
+  ATOMIC_STORE(&prefix_len_, 0);
+  ATOMIC_STORE(&count_, 0);
+  MEMSET(prefix_, 0, sizeof(prefix_));
+  switch (type_) {
+    case NODE4:
+      static_cast<ObArtNode4*>(this)->reuse();
+      break;
+    case NODE16:
+      static_cast<ObArtNode16*>(this)->reuse();
+      break;
+    case NODE48:
+      static_cast<ObArtNode48*>(this)->reuse();
+      break;
+    default:
+      static_cast<ObArtNode256*>(this)->reuse();
+      break;
+  }
+  ATOMIC_STORE(&version_, (version | LOCKED_BIT | OBSOLETE_BIT) + 1);
+}
+
+bool ObArtNode::is_full() const
+{
+  bool bool_ret = false;
+  switch (type_) {
+    case NODE4:
+      bool_ret = count_ >= 4;
+      break;
+    case NODE16:
+      bool_ret = count_ >= 16;
+      break;
+    case NODE48:
+      bool_ret = count_ >= ObArtNode48::CAPACITY;
+      break;
+    default:
+      bool_ret = false;
+      break;
+  }
+  return bool_ret;
+}
+
+void ObArtNode::set_prefix(const uint8_t* prefix, const uint32_t prefix_len)
+{
+  // %prefix may be part of the prefix of this node
+  MEMMOVE(prefix_, prefix, MIN(prefix_len, MAX_PREFIX_LEN));
+  ATOMIC_STORE(&prefix_len_, prefix_len);
+}
+
+ObArtNode* ObArtNode::find_child(const uint8_t byte) const
+{
+  ART_CONST_NODE_DISPATCH(type_, find_child, byte);
+}
+
+bool ObArtNode::next_child(const int64_t from, const bool is_reverse, uint8_t& byte, ObArtNode*& child) const
+{
+  ART_CONST_NODE_DISPATCH(type_, next_child, from, is_reverse, byte, child);
+}
+
+void ObArtNode::add_child(const uint8_t byte, ObArtNode* child)
+{
+  ART_NODE_DISPATCH(type_, add_child, byte, child);
+}
+
+void ObArtNode::change_child(const uint8_t byte, ObArtNode* child)
+{
+  ART_NODE_DISPATCH(type_, change_child, byte, child);
+}
+
+void ObArtNode::copy_to(ObArtNode& other) const
+{
+  uint8_t byte = 0;
+  ObArtNode* child = nullptr;
+  other.set_prefix(prefix_, prefix_len_);
+  for (int64_t from = 0; from <= UINT8_MAX && next_child(from, false, byte, child); from = byte + 1) {
+    other.add_child(byte, child);
+  }
+}
+
+int64_t ObArtNode::get_node_size(const uint8_t type)
+{
+  int64_t size = 0;
+  switch (type) {
+    case NODE4:
+      size = sizeof(ObArtNode4);
+      break;
+    case NODE16:
+      size = sizeof(ObArtNode16);
+      break;
+    case NODE48:
+      size = sizeof(ObArtNode48);
+      break;
+    default:
+      size = sizeof(ObArtNode256);
+      break;
+  }
+  return size;
+}
+
+ObArtNode* ObArtNode::new_node(void* buf, const uint8_t type)
+{
+  ObArtNode* node = nullptr;
+  switch (type) {
+    case NODE4:
+      node = new (buf) ObArtNode4(NODE4);
+      break;
+    case NODE16:
+      node = new (buf) ObArtNode16(NODE16);
+      break;
+    case NODE48:
+      node = new (buf) ObArtNode48();
+      break;
+    default:
+      node = new (buf) ObArtNode256();
+      break;
+  }
+  return node;
+}
+
+/*
+ * ------------------------------------------------------------ObArtIndex---------------------------------------------
+ */
+struct ObArtIndex::ScanCtx {
+  ScanCtx(const ObArtKey& lower, const bool lower_exclude, const ObArtKey& upper, const bool upper_exclude,
+      const bool is_reverse)
+      : lower_(lower),
+        upper_(upper),
+        lower_exclude_(lower_exclude),
+        upper_exclude_(upper_exclude),
+        is_reverse_(is_reverse),
+        leaves_(nullptr),
+        capacity_(0),
+        count_(0),
+        max_level_(INT64_MAX),
+        entries_(nullptr),
+        leaf_count_(0),
+        leaf_key_()
+  {}
+  inline bool is_full() const
+  {
+    return nullptr != leaves_ && count_ >= capacity_;
+  }
+
+  const ObArtKey& lower_;
+  const ObArtKey& upper_;
+  bool lower_exclude_;
+  bool upper_exclude_;
+  bool is_reverse_;
+  // leaves are collected in scan
+  ObArtLeaf** leaves_;
+  int64_t capacity_;
+  int64_t count_;
+  // inner nodes at %max_level_ and leaves above are collected in estimation
+  int64_t max_level_;
+  ObIArray<const ObArtNode*>* entries_;
+  int64_t leaf_count_;
+  ObArtKey leaf_key_;
+};
+
+// >0 if keys of the subtree are greater than %key, <0 if less, 0 if %key has the prefix
+static int compare_prefix(const uint8_t* prefix, const uint32_t prefix_len, const ObArtKey& key, const int64_t depth)
+{
+  int cmp = 0;
+  const uint8_t* key_ptr = key.get_ptr();
+  for (int64_t i = 0; 0 == cmp && i < prefix_len; ++i) {
+    if (depth + i >= key.get_length()) {
+      cmp = 1;
+    } else if (prefix[i] != key_ptr[depth + i]) {
+      cmp = prefix[i] < key_ptr[depth + i] ? -1 : 1;
+    }
+  }
+  return cmp;
+}
+
+ObArtIndex::ObArtIndex(ObIAllocator& allocator)
+    : is_inited_(false), allocator_(allocator), root_(nullptr), size_(0), alloc_memory_(0), free_lock_()
+{
+  MEMSET(free_lists_, 0, sizeof(free_lists_));
+}
+
+ObArtIndex::~ObArtIndex()
+{
+  destroy();
+}
+
+int ObArtIndex::init()
+{
+  int ret = OB_SUCCESS;
+  if (IS_INIT) {
+    ret = OB_INIT_TWICE;
+    TRANS_LOG(WARN, "art index init twice", K(ret));
+  } else if (OB_ISNULL(root_ = alloc_node(ObArtNode::NODE256))) {
+    // the root is never replaced, so a full node is used
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    TRANS_LOG(WARN, "alloc art root failed", K(ret));
+  } else {
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+void ObArtIndex::destroy()
+{
+  if (OB_NOT_NULL(root_)) {
+    destroy_node(root_);
+    root_ = nullptr;
+  }
+  for (int64_t i = 0; i < NODE_TYPE_COUNT; ++i) {
+    while (OB_NOT_NULL(free_lists_[i])) {
+      ObArtNode* node = free_lists_[i];
+      MEMCPY(&free_lists_[i], node->prefix_, sizeof(ObArtNode*));
+      allocator_.free(node);
+    }
+  }
+  size_ = 0;
+  alloc_memory_ = 0;
+  is_inited_ = false;
+}
+
+void ObArtIndex::destroy_node(ObArtNode* node)
+{
+  uint8_t byte = 0;
+  ObArtNode* child = nullptr;
+  for (int64_t from = 0; from <= UINT8_MAX && node->next_child(from, false, byte, child); from = byte + 1) {
+    if (ObArtNode::is_leaf(child)) {
+      allocator_.free(const_cast<ObArtLeaf*>(ObArtNode::to_leaf(child)));
+    } else {
+      destroy_node(child);
+    }
+  }
+  allocator_.free(node);
+}
+
+ObArtNode* ObArtIndex::alloc_node(const uint8_t type)
+{
+  ObArtNode* node = nullptr;
+  {
+    ObSpinLockGuard guard(free_lock_);
+    if (OB_NOT_NULL(node = free_lists_[type])) {
+      MEMCPY(&free_lists_[type], node->prefix_, sizeof(ObArtNode*));
+    }
+  }
+  if (OB_NOT_NULL(node)) {
+    node->reuse();
+  } else {
+    const int64_t size = ObArtNode::get_node_size(type);
+    void* buf = nullptr;
+    if (OB_NOT_NULL(buf = allocator_.alloc(size))) {
+      node = ObArtNode::new_node(buf, type);
+      (void)ATOMIC_AAF(&alloc_memory_, size);
+    }
+  }
+  return node;
+}
+
+void ObArtIndex::free_node(ObArtNode* node)
+{
+  // the prefix of an obsolete node is not read by anyone, it links the free list
+  ObSpinLockGuard guard(free_lock_);
+  MEMCPY(node->prefix_, &free_lists_[node->get_type()], sizeof(ObArtNode*));
+  free_lists_[node->get_type()] = node;
+}
+
+ObArtLeaf* ObArtIndex::alloc_leaf()
+{
+  ObArtLeaf* leaf = nullptr;
+  if (OB_NOT_NULL(leaf = static_cast<ObArtLeaf*>(allocator_.alloc(sizeof(ObArtLeaf))))) {
+    (void)ATOMIC_AAF(&alloc_memory_, sizeof(ObArtLeaf));
+  }
+  return leaf;
+}
+
+int ObArtIndex::load_min_leaf(const ObArtNode* node, const uint64_t version, const ObArtLeaf*& leaf) const
+{
+  int ret = OB_SUCCESS;
+  const ObArtNode* cur = node;
+  uint64_t cur_version = version;
+  leaf = nullptr;
+  while (OB_SUCC(ret) && nullptr == leaf) {
+    const ObArtNode* child = cur->first_child();
+    uint64_t child_version = 0;
+    if (!cur->check(cur_version) || nullptr == child) {
+      ret = OB_EAGAIN;
+    } else if (ObArtNode::is_leaf(child)) {
+      leaf = ObArtNode::to_leaf(child);
+    } else if (!child->read_lock(child_version) || !cur->check(cur_version)) {
+      ret = OB_EAGAIN;
+    } else {
+      cur = child;
+      cur_version = child_version;
+    }
+  }
+  return ret;
+}
+
+int ObArtIndex::load_prefix(const ObArtNode* node, const uint64_t version, const int64_t depth,
+    const uint32_t prefix_len, ObArtKey& leaf_key, const uint8_t*& prefix) const
+{
+  int ret = OB_SUCCESS;
+  const ObArtLeaf* leaf = nullptr;
+  if (prefix_len <= ObArtNode::MAX_PREFIX_LEN) {
+    prefix = node->get_prefix();
+  } else if (OB_FAIL(load_min_leaf(node, version, leaf))) {
+    // need restart
+  } else if (OB_FAIL(leaf_key.encode(*leaf->rowkey_))) {
+    TRANS_LOG(WARN, "encode leaf key failed", K(ret), K(*leaf->rowkey_));
+  } else if (leaf_key.get_length() < depth + prefix_len) {
+    // the leaf is not under the node any more
+    ret = OB_EAGAIN;
+  } else {
+    prefix = leaf_key.get_ptr() + depth;
+  }
+  return ret;
+}
+
+int ObArtIndex::insert(const ObStoreRowkey* rowkey, ObMvccRow* value)
+{
+  int ret = OB_SUCCESS;
+  ObArtKey key;
+  ObArtLeaf* leaf = nullptr;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    TRANS_LOG(WARN, "art index not init", K(ret));
+  } else if (OB_ISNULL(rowkey) || OB_ISNULL(value)) {
+    ret = OB_INVALID_ARGUMENT;
+    TRANS_LOG(WARN, "invalid argument", K(ret), KP(rowkey), KP(value));
+  } else if (OB_FAIL(key.encode(*rowkey))) {
+    TRANS_LOG(WARN, "encode rowkey failed", K(ret), K(*rowkey));
+  } else if (OB_ISNULL(leaf = alloc_leaf())) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    TRANS_LOG(WARN, "alloc art leaf failed", K(ret));
+  } else {
+    leaf->rowkey_ = rowkey;
+    leaf->value_ = value;
+    do {
+      ret = insert_(key, leaf);
+    } while (OB_EAGAIN == ret);
+    if (OB_SUCC(ret)) {
+      (void)ATOMIC_AAF(&size_, 1);
+    }
+  }
+  if (OB_NOT_NULL(leaf)) {
+    // not linked into the tree
+    allocator_.free(leaf);
+    (void)ATOMIC_SAF(&alloc_memory_, sizeof(ObArtLeaf));
+    leaf = nullptr;
+  }
+  return ret;
+}
+
+// %leaf is reset once it is linked into the tree, OB_EAGAIN means restart from the root
+int ObArtIndex::insert_(const ObArtKey& key, ObArtLeaf*& leaf)
+{
+  int ret = OB_SUCCESS;
+  const uint8_t* key_ptr = key.get_ptr();
+  const int64_t key_len = key.get_length();
+  ObArtKey leaf_key;
+  ObArtNode* parent = nullptr;
+  ObArtNode* node = nullptr;
+  ObArtNode* next = root_;
+  uint64_t parent_version = 0;
+  uint64_t version = 0;
+  uint8_t parent_byte = 0;
+  uint8_t node_byte = 0;
+  int64_t depth = 0;
+  while (OB_SUCC(ret) && OB_NOT_NULL(leaf)) {
+    parent = node;
+    parent_byte = node_byte;
+    node = next;
+    const uint32_t prefix_len = node->get_prefix_len();
+    const uint8_t* prefix = nullptr;
+    uint32_t mismatch = 0;
+    if (!node->read_lock(version)) {
+      ret = OB_EAGAIN;
+    } else if (prefix_len > 0 && OB_FAIL(load_prefix(node, version, depth, prefix_len, leaf_key, prefix))) {
+      // need restart
+    } else {
+      while (mismatch < prefix_len && depth + mismatch < key_len && prefix[mismatch] == key_ptr[depth + mismatch]) {
+        ++mismatch;
+      }
+    }
+    if (OB_FAIL(ret)) {
+    } else if (mismatch < prefix_len) {
+      // split the prefix, the node goes under a new node with the common part of the prefix
+      ObArtNode* new_node = nullptr;
+      if (depth + mismatch >= key_len) {
+        ret = node->check(version) ? OB_ERR_UNEXPECTED : OB_EAGAIN;
+      } else if (!parent->upgrade_lock(parent_version)) {
+        ret = OB_EAGAIN;
+      } else if (!node->upgrade_lock(version)) {
+        parent->unlock();
+        ret = OB_EAGAIN;
+      } else if (OB_ISNULL(new_node = alloc_node(ObArtNode::NODE4))) {
+        parent->unlock();
+        node->unlock();
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+      } else {
+        new_node->set_prefix(prefix, mismatch);
+        new_node->add_child(key_ptr[depth + mismatch], ObArtNode::from_leaf(leaf));
+        new_node->add_child(prefix[mismatch], node);
+        node->set_prefix(prefix + mismatch + 1, prefix_len - mismatch - 1);
+        parent->change_child(parent_byte, new_node);
+        parent->unlock();
+        node->unlock();
+        leaf = nullptr;
+      }
+    } else if (depth + prefix_len >= key_len) {
+      ret = node->check(version) ? OB_ERR_UNEXPECTED : OB_EAGAIN;
+    } else {
+      depth += prefix_len;
+      node_byte = key_ptr[depth];
+      next = node->find_child(node_byte);
+      if (!node->check(version)) {
+        ret = OB_EAGAIN;
+      } else if (nullptr == next) {
+        if (node->is_full()) {
+          // replace the node with a bigger one
+          ObArtNode* new_node = nullptr;
+          if (!parent->upgrade_lock(parent_version)) {
+            ret = OB_EAGAIN;
+          } else if (!node->upgrade_lock(version)) {
+            parent->unlock();
+            ret = OB_EAGAIN;
+          } else if (OB_ISNULL(new_node = alloc_node(static_cast<uint8_t>(node->get_type() + 1)))) {
+            parent->unlock();
+            node->unlock();
+            ret = OB_ALLOCATE_MEMORY_FAILED;
+          } else {
+            node->copy_to(*new_node);
+            new_node->add_child(node_byte, ObArtNode::from_leaf(leaf));
+            parent->change_child(parent_byte, new_node);
+            parent->unlock();
+            node->unlock_obsolete();
+            free_node(node);
+            leaf = nullptr;
+          }
+        } else if (nullptr != parent && !parent->check(parent_version)) {
+          ret = OB_EAGAIN;
+        } else if (!node->upgrade_lock(version)) {
+          ret = OB_EAGAIN;
+        } else {
+          node->add_child(node_byte, ObArtNode::from_leaf(leaf));
+          node->unlock();
+          leaf = nullptr;
+        }
+      } else if (nullptr != parent && !parent->check(parent_version)) {
+        ret = OB_EAGAIN;
+      } else if (ObArtNode::is_leaf(next)) {
+        // split the leaf, both leaves go under a new node with their common bytes as prefix
+        const ObArtLeaf* old_leaf = ObArtNode::to_leaf(next);
+        ObArtNode* new_node = nullptr;
+        int64_t common_len = 0;
+        if (!node->upgrade_lock(version)) {
+          ret = OB_EAGAIN;
+        } else if (OB_FAIL(leaf_key.encode(*old_leaf->rowkey_))) {
+          node->unlock();
+          TRANS_LOG(WARN, "encode leaf key failed", K(ret), K(*old_leaf->rowkey_));
+        } else {
+          const uint8_t* leaf_ptr = leaf_key.get_ptr();
+          const int64_t leaf_len = leaf_key.get_length();
+          const int64_t start = depth + 1;
+          while (start + common_len < key_len && start + common_len < leaf_len &&
+                 key_ptr[start + common_len] == leaf_ptr[start + common_len]) {
+            ++common_len;
+          }
+          if (start + common_len == key_len && start + common_len == leaf_len) {
+            node->unlock();
+            ret = OB_ENTRY_EXIST;
+          } else if (start + common_len >= key_len || start + common_len >= leaf_len) {
+            node->unlock();
+            ret = OB_ERR_UNEXPECTED;
+            TRANS_LOG(ERROR, "art key is prefix of another", K(ret), K(*old_leaf->rowkey_), K(*leaf->rowkey_));
+          } else if (OB_ISNULL(new_node = alloc_node(ObArtNode::NODE4))) {
+            node->unlock();
+            ret = OB_ALLOCATE_MEMORY_FAILED;
+          } else {
+            new_node->set_prefix(key_ptr + start, static_cast<uint32_t>(common_len));
+            new_node->add_child(key_ptr[start + common_len], ObArtNode::from_leaf(leaf));
+            new_node->add_child(leaf_ptr[start + common_len], next);
+            node->change_child(node_byte, new_node);
+            node->unlock();
+            leaf = nullptr;
+          }
+        }
+      } else {
+        ++depth;
+        parent_version = version;
+      }
+    }
+  }
+  if (OB_ERR_UNEXPECTED == ret) {
+    TRANS_LOG(ERROR, "unexpected art key", K(ret), K(key), K(depth));
+  }
+  return ret;
+}
+
+int ObArtIndex::get(const ObArtKey& key, const ObStoreRowkey*& stored_rowkey, ObMvccRow*& value) const
+{
+  int ret = OB_EAGAIN;
+  const uint8_t* key_ptr = key.get_ptr();
+  const int64_t key_len = key.get_length();
+  ObArtKey leaf_key;
+  stored_rowkey = nullptr;
+  value = nullptr;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    TRANS_LOG(WARN, "art index not init", K(ret));
+  }
+  while (OB_EAGAIN == ret) {
+    const ObArtNode* node = root_;
+    uint64_t version = 0;
+    int64_t depth = 0;
+    bool is_done = false;
+    ret = root_->read_lock(version) ? OB_SUCCESS : OB_EAGAIN;
+    while (OB_SUCC(ret) && !is_done) {
+      // bytes of the prefix not kept in the node are checked with the leaf
+      const uint32_t prefix_len = node->get_prefix_len();
+      const uint32_t stored_len = MIN(prefix_len, static_cast<uint32_t>(ObArtNode::MAX_PREFIX_LEN));
+      const uint8_t* prefix = node->get_prefix();
+      const ObArtNode* child = nullptr;
+      uint64_t child_version = 0;
+      uint32_t i = 0;
+      while (i < stored_len && depth + i < key_len && prefix[i] == key_ptr[depth + i]) {
+        ++i;
+      }
+      depth += prefix_len;
+      if (i < stored_len || depth >= key_len) {
+        ret = node->check(version) ? OB_ENTRY_NOT_EXIST : OB_EAGAIN;
+      } else if (FALSE_IT(child = node->find_child(key_ptr[depth]))) {
+      } else if (!node->check(version)) {
+        ret = OB_EAGAIN;
+      } else if (nullptr == child) {
+        ret = OB_ENTRY_NOT_EXIST;
+      } else if (ObArtNode::is_leaf(child)) {
+        const ObArtLeaf* leaf = ObArtNode::to_leaf(child);
+        if (OB_FAIL(leaf_key.encode(*leaf->rowkey_))) {
+          TRANS_LOG(WARN, "encode leaf key failed", K(ret), K(*leaf->rowkey_));
+        } else if (0 != leaf_key.compare(key)) {
+          ret = OB_ENTRY_NOT_EXIST;
+        } else {
+          stored_rowkey = leaf->rowkey_;
+          value = leaf->value_;
+          is_done = true;
+        }
+      } else if (!child->read_lock(child_version) || !node->check(version)) {
+        ret = OB_EAGAIN;
+      } else {
+        node = child;
+        version = child_version;
+        ++depth;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObArtIndex::add_leaf(const ObArtLeaf* leaf, const bool check_lower, const bool check_upper, ScanCtx& ctx) const
+{
+  int ret = OB_SUCCESS;
+  bool in_range = true;
+  if (!check_lower && !check_upper) {
+    // the leaf is strictly within the range
+  } else if (OB_FAIL(ctx.leaf_key_.encode(*leaf->rowkey_))) {
+    TRANS_LOG(WARN, "encode leaf key failed", K(ret), K(*leaf->rowkey_));
+  } else {
+    if (check_lower) {
+      const int cmp = ctx.leaf_key_.compare(ctx.lower_);
+      in_range = cmp > 0 || (0 == cmp && !ctx.lower_exclude_);
+    }
+    if (in_range && check_upper) {
+      const int cmp = ctx.leaf_key_.compare(ctx.upper_);
+      in_range = cmp < 0 || (0 == cmp && !ctx.upper_exclude_);
+    }
+  }
+  if (OB_FAIL(ret) || !in_range) {
+  } else if (nullptr != ctx.leaves_) {
+    ctx.leaves_[ctx.count_++] = const_cast<ObArtLeaf*>(leaf);
+  } else if (OB_NOT_NULL(ctx.entries_) && OB_FAIL(ctx.entries_->push_back(ObArtNode::from_leaf(leaf)))) {
+    TRANS_LOG(WARN, "push back entry failed", K(ret));
+  } else {
+    ++ctx.leaf_count_;
+  }
+  return ret;
+}
+
+// Visit the children of %node within the range in order, the bounds are checked only along their paths.
+// OB_EAGAIN means the nodes have changed and the scan should restart after the leaves collected.
+int ObArtIndex::scan_node(const ObArtNode* node, const uint64_t version, int64_t depth, int64_t level,
+    bool check_lower, bool check_upper, ScanCtx& ctx) const
+{
+  int ret = OB_SUCCESS;
+  bool is_skip = false;
+  const uint32_t prefix_len = node->get_prefix_len();
+  const uint8_t* prefix = nullptr;
+  if (0 == prefix_len || (!check_lower && !check_upper)) {
+  } else if (OB_FAIL(load_prefix(node, version, depth, prefix_len, ctx.leaf_key_, prefix))) {
+    // need restart
+  } else {
+    if (check_lower) {
+      const int cmp = compare_prefix(prefix, prefix_len, ctx.lower_, depth);
+      check_lower = 0 == cmp;
+      is_skip = cmp < 0;
+    }
+    if (!is_skip && check_upper) {
+      const int cmp = compare_prefix(prefix, prefix_len, ctx.upper_, depth);
+      check_upper = 0 == cmp;
+      is_skip = cmp > 0;
+    }
+  }
+  depth += prefix_len;
+  int64_t lower_byte = 0;
+  int64_t upper_byte = UINT8_MAX;
+  if (OB_SUCC(ret) && !is_skip && check_lower) {
+    if (depth >= ctx.lower_.get_length()) {
+      check_lower = false;
+    } else {
+      lower_byte = ctx.lower_.get_ptr()[depth];
+    }
+  }
+  if (OB_SUCC(ret) && !is_skip && check_upper) {
+    if (depth >= ctx.upper_.get_length()) {
+      is_skip = true;
+    } else {
+      upper_byte = ctx.upper_.get_ptr()[depth];
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (is_skip || lower_byte > upper_byte) {
+    if (!node->check(version)) {
+      ret = OB_EAGAIN;
+    }
+  } else {
+    int64_t from = ctx.is_reverse_ ? upper_byte : lower_byte;
+    bool has_next = true;
+    while (OB_SUCC(ret) && has_next && !ctx.is_full()) {
+      uint8_t byte = 0;
+      ObArtNode* child = nullptr;
+      uint64_t child_version = 0;
+      has_next = node->next_child(from, ctx.is_reverse_, byte, child) &&
+                 (ctx.is_reverse_ ? byte >= lower_byte : byte <= upper_byte);
+      if (!node->check(version)) {
+        ret = OB_EAGAIN;
+      } else if (!has_next) {
+      } else {
+        const bool child_check_lower = check_lower && byte == lower_byte;
+        const bool child_check_upper = check_upper && byte == upper_byte;
+        if (ObArtNode::is_leaf(child)) {
+          ret = add_leaf(ObArtNode::to_leaf(child), child_check_lower, child_check_upper, ctx);
+        } else if (level + 1 >= ctx.max_level_) {
+          if (OB_FAIL(ctx.entries_->push_back(child))) {
+            TRANS_LOG(WARN, "push back entry failed", K(ret));
+          }
+        } else if (!child->read_lock(child_version) || !node->check(version)) {
+          ret = OB_EAGAIN;
+        } else {
+          ret = scan_node(child, child_version, depth + 1, level + 1, child_check_lower, child_check_upper, ctx);
+        }
+        from = ctx.is_reverse_ ? byte - 1 : byte + 1;
+        has_next = from >= 0 && from <= UINT8_MAX;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObArtIndex::scan(const ObArtKey& lower, const bool lower_exclude, const ObArtKey& upper, const bool upper_exclude,
+    const bool is_reverse, ObArtLeaf** leaves, const int64_t capacity, int64_t& count, bool& is_end) const
+{
+  int ret = OB_SUCCESS;
+  count = 0;
+  is_end = false;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    TRANS_LOG(WARN, "art index not init", K(ret));
+  } else if (OB_ISNULL(leaves) || capacity <= 0) {
+    ret = OB_INVALID_ARGUMENT;
+    TRANS_LOG(WARN, "invalid argument", K(ret), KP(leaves), K(capacity));
+  } else {
+    ScanCtx ctx(lower, lower_exclude, upper, upper_exclude, is_reverse);
+    ctx.leaves_ = leaves;
+    ctx.capacity_ = capacity;
+    do {
+      uint64_t version = 0;
+      ret = root_->read_lock(version) ? scan_node(root_, version, 0, 0, true, true, ctx) : OB_EAGAIN;
+    } while (OB_EAGAIN == ret && 0 == ctx.count_);
+    if (OB_EAGAIN == ret) {
+      // the leaves collected are in order, the next scan starts after them
+      ret = OB_SUCCESS;
+    } else if (OB_SUCC(ret)) {
+      is_end = !ctx.is_full();
+    }
+    count = ctx.count_;
+  }
+  return ret;
+}
+
+// Collect the subtrees and leaves within the range at the shallowest level where there are enough of them.
+int ObArtIndex::collect_entries(
+    const ObArtKey& lower, const ObArtKey& upper, ObIArray<const ObArtNode*>& entries, int64_t& leaf_count) const
+{
+  int ret = OB_SUCCESS;
+  bool is_done = false;
+  ScanCtx ctx(lower, false, upper, false, false);
+  ctx.entries_ = &entries;
+  for (int64_t level = 1; OB_SUCC(ret) && !is_done && level <= MAX_ESTIMATE_LEVEL; ++level) {
+    int64_t retry_cnt = 0;
+    ctx.max_level_ = level;
+    do {
+      uint64_t version = 0;
+      entries.reuse();
+      ctx.leaf_count_ = 0;
+      ret = root_->read_lock(version) ? scan_node(root_, version, 0, 0, true, true, ctx) : OB_EAGAIN;
+    } while (OB_EAGAIN == ret && ++retry_cnt < MAX_ESTIMATE_RETRY_COUNT);
+    if (OB_SUCC(ret)) {
+      is_done = entries.count() >= ESTIMATE_ENTRY_COUNT_THRESHOLD || entries.count() == ctx.leaf_count_;
+      leaf_count = ctx.leaf_count_;
+    }
+  }
+  return ret;
+}
+
+// estimate the number of leaves under %node by sampling some children at each level
+int ObArtIndex::estimate_subtree(const ObArtNode* node, int64_t& row_count) const
+{
+  int ret = OB_SUCCESS;
+  uint64_t version = 0;
+  row_count = 0;
+  if (!node->read_lock(version)) {
+    ret = OB_EAGAIN;
+  } else {
+    const int64_t child_count = node->get_child_count();
+    const int64_t step = MAX(1, child_count / ESTIMATE_SAMPLE_CHILD_COUNT);
+    int64_t sample_count = 0;
+    int64_t sample_rows = 0;
+    int64_t child_idx = 0;
+    uint8_t byte = 0;
+    ObArtNode* child = nullptr;
+    for (int64_t from = 0; OB_SUCC(ret) && from <= UINT8_MAX && node->next_child(from, false, byte, child);
+         from = byte + 1, ++child_idx) {
+      int64_t child_rows = 0;
+      if (!node->check(version)) {
+        ret = OB_EAGAIN;
+      } else if (0 != child_idx % step) {
+      } else if (ObArtNode::is_leaf(child)) {
+        ++sample_count;
+        ++sample_rows;
+      } else if (OB_SUCC(estimate_subtree(child, child_rows))) {
+        ++sample_count;
+        sample_rows += child_rows;
+      }
+    }
+    if (OB_SUCC(ret) && sample_count > 0) {
+      row_count = sample_rows * child_count / sample_count;
+    }
+  }
+  return ret;
+}
+
+int ObArtIndex::estimate_row_count(
+    const ObArtKey& lower, const ObArtKey& upper, int64_t& branch_count, int64_t& row_count) const
+{
+  int ret = OB_SUCCESS;
+  ObSEArray<const ObArtNode*, 64> entries;
+  int64_t leaf_count = 0;
+  branch_count = 0;
+  row_count = 0;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    TRANS_LOG(WARN, "art index not init", K(ret));
+  } else if (OB_FAIL(collect_entries(lower, upper, entries, leaf_count))) {
+    if (OB_EAGAIN == ret) {
+      // too many concurrent inserts, the size of the whole index is good enough
+      row_count = size();
+      ret = OB_SUCCESS;
+    } else {
+      TRANS_LOG(WARN, "collect art entries failed", K(ret));
+    }
+  } else {
+    const int64_t subtree_count = entries.count() - leaf_count;
+    const int64_t step = MAX(1, subtree_count / ESTIMATE_SAMPLE_COUNT);
+    int64_t sample_count = 0;
+    int64_t sample_rows = 0;
+    for (int64_t i = 0, subtree_idx = 0; i < entries.count(); ++i) {
+      int64_t rows = 0;
+      if (ObArtNode::is_leaf(entries.at(i))) {
+      } else if (0 != subtree_idx++ % step) {
+      } else if (OB_SUCCESS == estimate_subtree(entries.at(i), rows)) {
+        ++sample_count;
+        sample_rows += rows;
+      }
+    }
+    branch_count = entries.count();
+    row_count = leaf_count;
+    if (subtree_count > 0) {
+      row_count += 0 == sample_count ? subtree_count : sample_rows * subtree_count / sample_count;
+    }
+  }
+  return ret;
+}
+
+int ObArtIndex::split_range(const ObArtKey& lower, const ObArtKey& upper, const int64_t part_count,
+    ObIArray<const ObStoreRowkey*>& split_keys) const
+{
+  int ret = OB_SUCCESS;
+  ObSEArray<const ObArtNode*, 64> entries;
+  int64_t leaf_count = 0;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    TRANS_LOG(WARN, "art index not init", K(ret));
+  } else if (part_count < 1) {
+    ret = OB_INVALID_ARGUMENT;
+    TRANS_LOG(WARN, "invalid argument", K(ret), K(part_count));
+  } else if (OB_FAIL(collect_entries(lower, upper, entries, leaf_count))) {
+    TRANS_LOG(WARN, "collect art entries failed", K(ret));
+  } else if (entries.count() <= part_count) {
+    // the first and the last entries may be partly out of the range, they never give split keys
+    ret = OB_ENTRY_NOT_EXIST;
+  } else {
+    // the first key of every %step entries ends a part
+    const int64_t step = entries.count() / part_count;
+    for (int64_t i = 1; OB_SUCC(ret) && i < part_count; ++i) {
+      const ObArtNode* entry = entries.at(i * step);
+      const ObArtLeaf* leaf = nullptr;
+      uint64_t version = 0;
+      if (ObArtNode::is_leaf(entry)) {
+        leaf = ObArtNode::to_leaf(entry);
+      } else if (!entry->read_lock(version)) {
+        ret = OB_EAGAIN;
+      } else {
+        ret = load_min_leaf(entry, version, leaf);
+      }
+      if (OB_FAIL(ret)) {
+        TRANS_LOG(WARN, "load split key failed", K(ret), K(i));
+      } else if (OB_FAIL(split_keys.push_back(leaf->rowkey_))) {
+        TRANS_LOG(WARN, "push back split key failed", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
+void ObArtIndex::dump(FILE* fd) const
+{
+  if (OB_NOT_NULL(fd)) {
+    fprintf(fd, "art_index size=%ld alloc_memory=%ld\n", size(), get_alloc_memory());
+  }
+}
+
+/*
+ * ------------------------------------------------------------ObArtScanHandle----------------------------------------
+ */
+ObArtScanHandle::ObArtScanHandle()
+    : index_(nullptr),
+      is_reverse_(false),
+      lower_exclude_(false),
+      upper_exclude_(false),
+      is_end_(false),
+      leaf_count_(0),
+      leaf_pos_(0),
+      lower_(),
+      upper_()
+{}
+
+ObArtScanHandle::~ObArtScanHandle()
+{
+  reset();
+}
+
+void ObArtScanHandle::reset()
+{
+  index_ = nullptr;
+  is_reverse_ = false;
+  lower_exclude_ = false;
+  upper_exclude_ = false;
+  is_end_ = false;
+  leaf_count_ = 0;
+  leaf_pos_ = 0;
+  lower_.reset();
+  upper_.reset();
+}
+
+int ObArtScanHandle::init(const ObArtIndex& index, const ObStoreRowkey& start, const bool start_exclude,
+    const ObStoreRowkey& end, const bool end_exclude)
+{
+  int ret = OB_SUCCESS;
+  reset();
+  if (OB_FAIL(lower_.encode(start)) || OB_FAIL(upper_.encode(end))) {
+    TRANS_LOG(WARN, "encode scan range failed", K(ret), K(start), K(end));
+  } else if (lower_.compare(upper_) <= 0) {
+    lower_exclude_ = start_exclude;
+    upper_exclude_ = end_exclude;
+  } else if (OB_FAIL(lower_.encode(end)) || OB_FAIL(upper_.encode(start))) {
+    TRANS_LOG(WARN, "encode scan range failed", K(ret), K(start), K(end));
+  } else {
+    is_reverse_ = true;
+    lower_exclude_ = end_exclude;
+    upper_exclude_ = start_exclude;
+  }
+  if (OB_SUCC(ret)) {
+    index_ = &index;
+  }
+  return ret;
+}
+
+int ObArtScanHandle::fetch_batch()
+{
+  int ret = OB_SUCCESS;
+  if (leaf_count_ > 0) {
+    const ObStoreRowkey* last_rowkey = leaves_[leaf_count_ - 1]->rowkey_;
+    if (is_reverse_) {
+      upper_exclude_ = true;
+      ret = upper_.encode(*last_rowkey);
+    } else {
+      lower_exclude_ = true;
+      ret = lower_.encode(*last_rowkey);
+    }
+  }
+  leaf_count_ = 0;
+  leaf_pos_ = 0;
+  if (OB_FAIL(ret)) {
+    TRANS_LOG(WARN, "encode scan bound failed", K(ret));
+  } else if (OB_FAIL(index_->scan(lower_,
+                 lower_exclude_,
+                 upper_,
+                 upper_exclude_,
+                 is_reverse_,
+                 leaves_,
+                 BATCH_SIZE,
+                 leaf_count_,
+                 is_end_))) {
+    TRANS_LOG(WARN, "art index scan failed", K(ret), K(*this));
+  }
+  return ret;
+}
+
+int ObArtScanHandle::get_next(ObStoreRowkeyWrapper& key, ObMvccRow*& value)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(index_)) {
+    ret = OB_ITER_END;
+  } else if (leaf_pos_ < leaf_count_) {
+  } else if (is_end_) {
+    ret = OB_ITER_END;
+  } else if (OB_FAIL(fetch_batch())) {
+    TRANS_LOG(WARN, "fetch art leaves failed", K(ret));
+  } else if (0 == leaf_count_) {
+    ret = OB_ITER_END;
+  }
+  if (OB_SUCC(ret)) {
+    const ObArtLeaf* leaf = leaves_[leaf_pos_++];
+    key.get_rowkey() = const_cast<ObStoreRowkey*>(leaf->rowkey_);
+    value = leaf->value_;
+  }
+  return ret;
+}
+
+}  // namespace memtable
+}  // namespace oceanbase
@@ -0,0 +1,206 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_MEMTABLE_MVCC_OB_ART_INDEX_
+#define OCEANBASE_MEMTABLE_MVCC_OB_ART_INDEX_
+
+#include "lib/container/ob_iarray.h"
+#include "lib/lock/ob_spin_lock.h"
+#include "storage/memtable/ob_memtable_key.h"
+
+namespace oceanbase {
+namespace common {
+class ObIAllocator;
+}
+namespace memtable {
+class ObMvccRow;
+class ObArtNode;
+
+// Memcomparable encoding of a rowkey, the byte-wise order of encoded rowkeys is the order of the rowkeys.
+// Each object is a tag byte (min 0x00, null 0x01, value 0x02, max 0xff) followed by the value:
+//   int, datetime, date, time:  8 bytes big endian with the sign bit flipped
+//   uint:                       8 bytes big endian
+//   year:                       1 byte
+//   binary string:              bytes with 0x00 escaped as 0x00 0xff, terminated by 0x00 0x00
+//   utf8mb4_bin string:         trailing spaces ignored, see encode_pad_space_string()
+// Encoded objects are self-delimiting, so a rowkey prefix encodes to a prefix of the rowkey.
+class ObArtKey {
+public:
+  static const int64_t INLINE_BUF_SIZE = 128;
+
+public:
+  ObArtKey();
+  ~ObArtKey();
+  // whether rowkeys of the same columns as %rowkey can always be encoded, false if %rowkey has null objects
+  // since their types are unknown
+  static bool is_supported(const common::ObStoreRowkey& rowkey);
+  int encode(const common::ObStoreRowkey& rowkey);
+  void reset();
+  inline const uint8_t* get_ptr() const
+  {
+    return buf_;
+  }
+  inline int64_t get_length() const
+  {
+    return len_;
+  }
+  int compare(const ObArtKey& other) const;
+  TO_STRING_KV(K_(len), K_(cap));
+
+private:
+  static const uint8_t MIN_TAG = 0x00;
+  static const uint8_t NULL_TAG = 0x01;
+  static const uint8_t VALUE_TAG = 0x02;
+  static const uint8_t MAX_TAG = 0xff;
+  static const uint64_t SIGN_BIT = 1UL << 63;
+  int reserve(const int64_t size);
+  int encode_obj(const common::ObObj& obj);
+  void encode_uint64(const uint64_t value);
+  void encode_binary_string(const common::ObString& str);
+  void encode_pad_space_string(const common::ObString& str);
+
+private:
+  uint8_t* buf_;
+  int64_t len_;
+  int64_t cap_;
+  uint8_t inline_buf_[INLINE_BUF_SIZE];
+  DISALLOW_COPY_AND_ASSIGN(ObArtKey);
+};
+
+// Rowkeys are not copied into the index, a leaf refers to the rowkey stored in the memtable.
+struct ObArtLeaf {
+  const common::ObStoreRowkey* rowkey_;
+  ObMvccRow* value_;
+};
+
+// Adaptive radix tree over encoded rowkeys, an ordered index of a table in memtable.
+//
+// Inner nodes have 4, 16, 48 or 256 children and grow when full. A node stores the common prefix of its subtree,
+// only the first MAX_PREFIX_LEN bytes are kept in the node and longer prefixes are read from any leaf below it.
+// A leaf is placed at the shallowest depth which tells it from the other keys, so rows are located by the
+// distinguishing bytes of their keys and nothing but a pointer to the rowkey is kept per row. Keys are never
+// removed, rows are purged by the mvcc layer.
+//
+// Concurrency uses optimistic lock coupling: every node has a version, readers never write shared memory and
+// restart once a version they have read changes, writers lock at most the node to change and its parent.
+// Nodes replaced by bigger ones are marked obsolete and reused for nodes of the same type, all memory is
+// returned to the memstore allocator when the memtable is destroyed.
+class ObArtIndex {
+public:
+  static const int64_t ESTIMATE_ENTRY_COUNT_THRESHOLD = 1024;
+
+public:
+  explicit ObArtIndex(common::ObIAllocator& allocator);
+  ~ObArtIndex();
+  int init();
+  void destroy();
+  // OB_ENTRY_EXIST if the rowkey exists, %rowkey must live as long as the index
+  int insert(const common::ObStoreRowkey* rowkey, ObMvccRow* value);
+  // OB_ENTRY_NOT_EXIST if the rowkey does not exist
+  int get(const ObArtKey& key, const common::ObStoreRowkey*& stored_rowkey, ObMvccRow*& value) const;
+  // Collect at most %capacity leaves within the range in order, %is_end is true if there are no more leaves
+  // after them. Fewer leaves than %capacity may be returned if the tree is being modified.
+  int scan(const ObArtKey& lower, const bool lower_exclude, const ObArtKey& upper, const bool upper_exclude,
+      const bool is_reverse, ObArtLeaf** leaves, const int64_t capacity, int64_t& count, bool& is_end) const;
+  // %branch_count is the number of subtrees the range is estimated over
+  int estimate_row_count(
+      const ObArtKey& lower, const ObArtKey& upper, int64_t& branch_count, int64_t& row_count) const;
+  // OB_ENTRY_NOT_EXIST if the range can not be split into %part_count parts
+  int split_range(const ObArtKey& lower, const ObArtKey& upper, const int64_t part_count,
+      common::ObIArray<const common::ObStoreRowkey*>& split_keys) const;
+  void dump(FILE* fd) const;
+  inline int64_t size() const
+  {
+    return ATOMIC_LOAD(&size_);
+  }
+  inline int64_t get_alloc_memory() const
+  {
+    return ATOMIC_LOAD(&alloc_memory_) + sizeof(*this);
+  }
+  TO_STRING_KV(K_(is_inited), K_(size), K_(alloc_memory));
+
+private:
+  struct ScanCtx;
+  static const int64_t MAX_ESTIMATE_RETRY_COUNT = 8;
+  static const int64_t MAX_ESTIMATE_LEVEL = 32;
+  static const int64_t ESTIMATE_SAMPLE_COUNT = 8;
+  static const int64_t ESTIMATE_SAMPLE_CHILD_COUNT = 3;
+  static const int64_t NODE_TYPE_COUNT = 4;
+  int insert_(const ObArtKey& key, ObArtLeaf*& leaf);
+  int scan_node(const ObArtNode* node, const uint64_t version, int64_t depth, int64_t level, bool check_lower,
+      bool check_upper, ScanCtx& ctx) const;
+  int add_leaf(const ObArtLeaf* leaf, const bool check_lower, const bool check_upper, ScanCtx& ctx) const;
+  int collect_entries(const ObArtKey& lower, const ObArtKey& upper, common::ObIArray<const ObArtNode*>& entries,
+      int64_t& leaf_count) const;
+  int estimate_subtree(const ObArtNode* node, int64_t& row_count) const;
+  int load_min_leaf(const ObArtNode* node, const uint64_t version, const ObArtLeaf*& leaf) const;
+  int load_prefix(const ObArtNode* node, const uint64_t version, const int64_t depth, const uint32_t prefix_len,
+      ObArtKey& leaf_key, const uint8_t*& prefix) const;
+  void destroy_node(ObArtNode* node);
+  ObArtNode* alloc_node(const uint8_t type);
+  // obsolete nodes are reused for nodes of the same type, readers holding them find the version changed
+  void free_node(ObArtNode* node);
+  ObArtLeaf* alloc_leaf();
+
+private:
+  bool is_inited_;
+  common::ObIAllocator& allocator_;
+  ObArtNode* root_;
+  int64_t size_;
+  int64_t alloc_memory_;
+  common::ObSpinLock free_lock_;
+  ObArtNode* free_lists_[NODE_TYPE_COUNT];
+  DISALLOW_COPY_AND_ASSIGN(ObArtIndex);
+};
+
+// Range scan over ObArtIndex in the interface of keybtree::TScanHandle, leaves are fetched in batches and the
+// next batch starts after the last leaf returned.
+class ObArtScanHandle {
+public:
+  static const int64_t BATCH_SIZE = 32;
+
+public:
+  ObArtScanHandle();
+  ~ObArtScanHandle();
+  // the scan is reverse if %start is greater than %end
+  int init(const ObArtIndex& index, const common::ObStoreRowkey& start, const bool start_exclude,
+      const common::ObStoreRowkey& end, const bool end_exclude);
+  int get_next(ObStoreRowkeyWrapper& key, ObMvccRow*& value);
+  inline bool is_reverse_scan() const
+  {
+    return is_reverse_;
+  }
+  void reset();
+  TO_STRING_KV(KP_(index), K_(is_reverse), K_(lower_exclude), K_(upper_exclude), K_(is_end), K_(leaf_count),
+      K_(leaf_pos));
+
+private:
+  int fetch_batch();
+
+private:
+  const ObArtIndex* index_;
+  bool is_reverse_;
+  bool lower_exclude_;
+  bool upper_exclude_;
+  bool is_end_;
+  int64_t leaf_count_;
+  int64_t leaf_pos_;
+  ObArtKey lower_;
+  ObArtKey upper_;
+  ObArtLeaf* leaves_[BATCH_SIZE];
+  DISALLOW_COPY_AND_ASSIGN(ObArtScanHandle);
+};
+
+}  // namespace memtable
+}  // namespace oceanbase
+
+#endif  // OCEANBASE_MEMTABLE_MVCC_OB_ART_INDEX_
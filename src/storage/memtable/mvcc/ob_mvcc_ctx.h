@@ -87,6 +87,13 @@ public:  // for mvcc engine invoke
     UNUSED(descriptor);
     return NULL;
   }
+  // whether the holder of a row lock has prepared at a version not greater than the read snapshot,
+  // so that the row written by it is visible to the statement once the lock is released
+  virtual bool is_lock_holder_visible(const uint32_t descriptor)
+  {
+    UNUSED(descriptor);
+    return false;
+  }
   virtual int read_lock_yield()
   {
     return common::OB_SUCCESS;
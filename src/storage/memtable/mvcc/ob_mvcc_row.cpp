@@ -465,14 +465,19 @@ int64_t ObMvccTransNode::to_string(char* buf, const int64_t buf_len) const
 void ObMvccRow::ObMvccRowIndex::reset()
 {
   if (!is_empty_) {
-    MEMSET(&replay_locations_, 0, sizeof(replay_locations_));
+    MEMSET(replay_locations_, 0, slot_count_ * sizeof(ObMvccTransNode*));
     is_empty_ = true;
   }
 }
 
-bool ObMvccRow::ObMvccRowIndex::is_valid_queue_index(const int64_t queue_index)
+bool ObMvccRow::ObMvccRowIndex::is_replay_queue_index(const int64_t queue_index)
 {
-  return (queue_index >= 0 && queue_index < REPLAY_TASK_QUEUE_SIZE);
+  return (queue_index >= 0 && queue_index < MAX_REPLAY_TASK_QUEUE_SIZE);
+}
+
+bool ObMvccRow::ObMvccRowIndex::is_valid_queue_index(const int64_t queue_index) const
+{
+  return (queue_index >= 0 && queue_index < slot_count_);
 }
 
 ObMvccTransNode* ObMvccRow::ObMvccRowIndex::get_index_node(const int64_t index) const
@@ -652,7 +657,7 @@ int ObMvccRow::unlink_trans_node(ObIMvccCtx& ctx, const ObMvccTransNode& node, c
     }
     const_cast<ObMvccTransNode&>(node).set_aborted();
     if (NULL != index_) {
-      for (int64_t i = 0; i < common::REPLAY_TASK_QUEUE_SIZE; ++i) {
+      for (int64_t i = 0; i < index_->get_slot_count(); ++i) {
         if (&node == index_->get_index_node(i)) {
           index_->set_index_node(i, ATOMIC_LOAD(&(node.prev_)));
           if (NULL == node.prev_ && TC_REACH_TIME_INTERVAL(60 * 1000 * 1000)) {
@@ -750,7 +755,7 @@ int ObMvccRow::insert_trans_node(
     next_node = NULL;
     int64_t search_steps = 0;
     const int64_t replay_queue_index = get_replay_queue_index();
-    const bool is_re_thread = ObMvccRowIndex::is_valid_queue_index(replay_queue_index);
+    const bool is_re_thread = ObMvccRowIndex::is_replay_queue_index(replay_queue_index);
     const bool is_follower = ctx.is_for_replay();
     if (!is_re_thread && NULL != index_) {
       if (is_follower && node.is_relocated()) {
@@ -833,11 +838,14 @@ int ObMvccRow::insert_trans_node(
           int tmp_ret = OB_SUCCESS;
           if (NULL != index_ || search_steps > INDEX_TRIGGER_COUNT) {
             if (NULL == index_) {
+              // one slot per replay queue of the partition, a queue without a slot always walks the list
+              const int64_t slot_count =
+                  min(MAX_REPLAY_TASK_QUEUE_SIZE, max(get_replay_queue_count(), replay_queue_index + 1));
               void* buf = NULL;
-              if (OB_UNLIKELY(NULL == (buf = allocator.alloc(sizeof(*index_))))) {
+              if (OB_UNLIKELY(NULL == (buf = allocator.alloc(ObMvccRowIndex::get_alloc_size(slot_count))))) {
                 tmp_ret = OB_ALLOCATE_MEMORY_FAILED;
                 TRANS_LOG(WARN, "failed to alloc ObMvccRowIndex", K(ret));
-              } else if (NULL == (index_ = new (buf) ObMvccRowIndex())) {
+              } else if (NULL == (index_ = new (buf) ObMvccRowIndex(slot_count))) {
                 TRANS_LOG(WARN, "failed to construct ObMvccRowIndex", K(ret));
                 tmp_ret = OB_ALLOCATE_MEMORY_FAILED;
               } else { /*do nothing*/
@@ -1137,6 +1145,9 @@ int ObMvccRow::check_row_locked(
 
     if (cur_ts >= query_abs_lock_wait_timeout) {
       ret = OB_ERR_EXCLUSIVE_LOCK_CONFLICT;
+    } else if (get_global_lock_wait_mgr().is_deadlock_victim(
+                   ctx.get_ctx_descriptor(), static_cast<ObMemtableCtx&>(ctx).get_trans_ctx()->get_trans_id())) {
+      ret = OB_DEAD_LOCK;
     } else {
       ret = OB_TRY_LOCK_ROW_CONFLICT;
 
@@ -1192,6 +1203,19 @@ int ObMvccRow::lock_for_write(const ObMemtableKey* key, ObIMvccCtx& ctx)
   } else {
     const int64_t cur_ts = common::ObClockGenerator::getClock();
     int64_t abs_lock_timeout = MIN(query_abs_lock_wait_timeout, cur_ts);
+    bool wait_in_place = false;
+    if (ctx.is_can_elr() && row_lock_.is_locked() && max_trans_version_ <= ctx.get_read_snapshot() &&
+        max_elr_trans_version_ <= ctx.get_read_snapshot() && get_global_lock_wait_mgr().is_hot_row(*key) &&
+        ctx.is_lock_holder_visible(row_lock_.get_exclusive_uid())) {
+      // The holder of a hot row releases the lock once its commit log is submitted. A writer whose read
+      // snapshot already covers the prepare version of the holder waits for the lock in place and writes on
+      // its snapshot, rather than being requeued in the lock wait mgr and retrying the statement. Others would
+      // only meet transaction set violation after the wait, so they are requeued and get a new snapshot.
+      const int64_t hot_row_lock_wait_time = GCONF._hot_row_lock_wait_time;
+      abs_lock_timeout = MIN(query_abs_lock_wait_timeout, cur_ts + hot_row_lock_wait_time);
+      wait_in_place = true;
+      EVENT_INC(MEMSTORE_HOT_ROW_LOCK_WAIT_COUNT);
+    }
     if (abs_lock_timeout > cur_ts) {
       if (OB_FAIL(row_lock_.exclusive_lock(uid, abs_lock_timeout))) {
         TRANS_LOG(DEBUG, "exclusive lock error", K(ret), K(abs_lock_timeout), K(ctx));
@@ -1206,6 +1230,10 @@ int ObMvccRow::lock_for_write(const ObMemtableKey* key, ObIMvccCtx& ctx)
     if (OB_FAIL(ret)) {
       if (abs_lock_timeout >= query_abs_lock_wait_timeout) {
         ret = OB_ERR_EXCLUSIVE_LOCK_CONFLICT;
+      } else if (get_global_lock_wait_mgr().is_deadlock_victim(
+                     uid, static_cast<ObMemtableCtx&>(ctx).get_trans_ctx()->get_trans_id())) {
+        // the transaction is chosen to break a deadlock, fail the statement instead of waiting for the lock again
+        ret = OB_DEAD_LOCK;
       } else {
         ret = OB_TRY_LOCK_ROW_CONFLICT;
       }
@@ -1218,6 +1246,10 @@ int ObMvccRow::lock_for_write(const ObMemtableKey* key, ObIMvccCtx& ctx)
     } else {
       set_ctx_descriptor(uid);
     }
+    if (wait_in_place && OB_SUCC(ret)) {
+      // a failed wait is counted by post_lock
+      get_global_lock_wait_mgr().on_row_lock_conflict(*key);
+    }
     if (!ctx.is_can_elr()) {
       const int64_t lock_ms = (common::ObClockGenerator::getClock() - cur_ts) / 1000;
       ObWaitEventGuard wait_guard(ObWaitEventIds::MT_WRITE_LOCK_WAIT,
@@ -1264,7 +1296,7 @@ int ObMvccRow::lock_for_write(const ObMemtableKey* key, ObIMvccCtx& ctx)
         ctx.set_lock_wait_start_ts(lock_wait_start_ts);
       }
       ctx.set_lock_wait_start_ts(lock_wait_start_ts);
-    } else if (OB_ERR_EXCLUSIVE_LOCK_CONFLICT == ret) {
+    } else if (OB_ERR_EXCLUSIVE_LOCK_CONFLICT == ret || OB_DEAD_LOCK == ret) {
       TRANS_LOG(WARN, "lock_for_write fail", K(ret), K(ctx), K(*key), K(conflict_id));
     } else {
       // do nothing
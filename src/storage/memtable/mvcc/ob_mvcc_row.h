@@ -178,24 +178,35 @@ private:
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 struct ObMvccRow {
+  // one replay location per replay task queue of the partition, allocated with get_alloc_size(slot_count)
   struct ObMvccRowIndex {
   public:
-    ObMvccRowIndex() : is_empty_(true)
+    explicit ObMvccRowIndex(const int64_t slot_count) : is_empty_(true), slot_count_(static_cast<int32_t>(slot_count))
     {
-      MEMSET(&replay_locations_, 0, sizeof(replay_locations_));
+      MEMSET(replay_locations_, 0, slot_count_ * sizeof(ObMvccTransNode*));
     }
     ~ObMvccRowIndex()
     {
       reset();
     }
+    static int64_t get_alloc_size(const int64_t slot_count)
+    {
+      return sizeof(ObMvccRowIndex) + slot_count * sizeof(ObMvccTransNode*);
+    }
     void reset();
-    static bool is_valid_queue_index(const int64_t index);
+    static bool is_replay_queue_index(const int64_t index);
+    bool is_valid_queue_index(const int64_t index) const;
+    int64_t get_slot_count() const
+    {
+      return slot_count_;
+    }
     ObMvccTransNode* get_index_node(const int64_t index) const;
     void set_index_node(const int64_t index, ObMvccTransNode* node);
 
   public:
     bool is_empty_;
-    ObMvccTransNode* replay_locations_[common::REPLAY_TASK_QUEUE_SIZE];
+    int32_t slot_count_;
+    ObMvccTransNode* replay_locations_[0];
   };
   static const uint8_t F_INIT = 0x0;
   static const uint8_t F_HASH_INDEX = 0x1;
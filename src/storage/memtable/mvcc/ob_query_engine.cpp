@@ -14,6 +14,9 @@
 
 #include "common/cell/ob_cell_reader.h"
 #include "common/cell/ob_cell_writer.h"
+#include "lib/container/ob_se_array.h"
+#include "share/config/ob_server_config.h"
+#include "share/ob_get_compat_mode.h"
 #include "storage/memtable/ob_memtable_data.h"
 
 namespace oceanbase {
@@ -28,7 +31,9 @@ int ObQueryEngine::TableIndexNode::init()
   if (OB_UNLIKELY(is_inited_)) {
     ret = OB_INIT_TWICE;
     TRANS_LOG(WARN, "init twice", K(this));
-  } else if (OB_FAIL(keybtree_.init())) {
+  } else if (is_art_ && OB_FAIL(art_.init())) {
+    TRANS_LOG(WARN, "art index init fail", KR(ret));
+  } else if (!is_art_ && OB_FAIL(keybtree_.init())) {
     TRANS_LOG(WARN, "keybtree init fail", KR(ret));
   } else {
     is_inited_ = true;
@@ -43,71 +48,94 @@ void ObQueryEngine::TableIndexNode::destroy()
 {
   is_inited_ = false;
   keybtree_.destroy();
+  art_.destroy();
+}
+
+template <typename ScanHandle>
+int ObQueryEngine::TableIndexNode::dump_rows(Iterator<ScanHandle>& iter, FILE* fd)
+{
+  int ret = OB_SUCCESS;
+  fprintf(fd, "table_id=%lu\n", table_id_);
+  for (int64_t row_idx = 0; OB_SUCC(ret) && OB_SUCC(iter.next_internal(true)); row_idx++) {
+    const ObMemtableKey* key = iter.get_key();
+    ObMvccRow* row = iter.get_value();
+    if (OB_ISNULL(key) || OB_ISNULL(row)) {
+      ret = OB_ERR_UNEXPECTED;
+      TRANS_LOG(ERROR, "iter NULL value", K(key), K(row));
+    } else {
+      fprintf(fd,
+          "row_idx=%ld %s %s purged=%d\n",
+          row_idx,
+          to_cstring(*key),
+          to_cstring(*row),
+          iter.get_iter_flag() & ~STORE_ITER_ROW_PARTIAL);
+      for (ObMvccTransNode* node = row->get_list_head(); OB_SUCC(ret) && OB_NOT_NULL(node); node = node->prev_) {
+        const ObMemtableDataHeader* mtd = reinterpret_cast<const ObMemtableDataHeader*>(node->buf_);
+        ObCellReader cci;
+        if (OB_ISNULL(mtd)) {
+          ret = OB_ERR_UNEXPECTED;
+          TRANS_LOG(ERROR, "iter NULL trans_node");
+        } else if (OB_FAIL(cci.init(mtd->buf_, mtd->buf_len_, SPARSE))) {
+          TRANS_LOG(WARN, "cci.init fail", KR(ret));
+        } else {
+          fprintf(fd, "\t%s dml=%d size=%ld\n", to_cstring(*node), mtd->dml_type_, mtd->buf_len_);
+        }
+        while (OB_SUCC(ret) && OB_SUCC(cci.next_cell())) {
+          uint64_t column_id = OB_INVALID_ID;
+          const ObObj* value = NULL;
+          if (OB_FAIL(cci.get_cell(column_id, value))) {
+            TRANS_LOG(WARN, "get_cell fail", KR(ret));
+          } else if (NULL == value) {
+            ret = OB_ERR_UNEXPECTED;
+            TRANS_LOG(WARN, "get_cell fail, value=NULL", KR(ret));
+          } else if (ObExtendType == value->get_type() && ObActionFlag::OP_END_FLAG == value->get_ext()) {
+            ret = OB_ITER_END;
+          } else {
+            fprintf(fd, "\tcid=%ld val=%s\n", column_id, to_cstring(*value));
+          }
+        }
+        if (OB_ITER_END == ret) {
+          ret = OB_SUCCESS;
+        }
+      }
+    }
+  }
+  return ret;
 }
 
 void ObQueryEngine::TableIndexNode::dump2text(FILE* fd)
 {
   int ret = OB_SUCCESS;
-  Iterator<keybtree::TScanHandle> iter;
   ObStoreRowkeyWrapper scan_start_key_wrapper(&ObStoreRowkey::MIN_STORE_ROWKEY);
   ObStoreRowkeyWrapper scan_end_key_wrapper(&ObStoreRowkey::MAX_STORE_ROWKEY);
-  iter.reset();
-  const_cast<ObMemtableKey*>(iter.get_key())->encode(table_id_, nullptr);
   if (IS_NOT_INIT) {
     TRANS_LOG(WARN, "not init", "this", this);
   } else if (OB_ISNULL(fd)) {
     TRANS_LOG(ERROR, "invalid argument");
-  } else if (OB_FAIL(keybtree_.set_key_range(
-                 iter.get_read_handle(), scan_start_key_wrapper, 1, scan_end_key_wrapper, 1, INT64_MAX))) {
-    TRANS_LOG(ERROR, "set key range to btree scan handle fail", KR(ret));
+  } else if (is_art_) {
+    Iterator<ObArtScanHandle> iter;
+    iter.reset();
+    const_cast<ObMemtableKey*>(iter.get_key())->encode(table_id_, nullptr);
+    if (OB_FAIL(iter.get_read_handle().init(
+            art_, ObStoreRowkey::MIN_STORE_ROWKEY, true, ObStoreRowkey::MAX_STORE_ROWKEY, true))) {
+      TRANS_LOG(ERROR, "init art scan handle fail", KR(ret));
+    } else {
+      (void)dump_rows(iter, fd);
+      art_.dump(fd);
+      fprintf(fd, "--------------------------\n");
+    }
   } else {
-    fprintf(fd, "table_id=%lu\n", table_id_);
-    for (int64_t row_idx = 0; OB_SUCC(ret) && OB_SUCC(iter.next_internal(true)); row_idx++) {
-      const ObMemtableKey* key = iter.get_key();
-      ObMvccRow* row = iter.get_value();
-      if (OB_ISNULL(key) || OB_ISNULL(row)) {
-        ret = OB_ERR_UNEXPECTED;
-        TRANS_LOG(ERROR, "iter NULL value", K(key), K(row));
-      } else {
-        fprintf(fd,
-            "row_idx=%ld %s %s purged=%d\n",
-            row_idx,
-            to_cstring(*key),
-            to_cstring(*row),
-            iter.get_iter_flag() & ~STORE_ITER_ROW_PARTIAL);
-        for (ObMvccTransNode* node = row->get_list_head(); OB_SUCC(ret) && OB_NOT_NULL(node); node = node->prev_) {
-          const ObMemtableDataHeader* mtd = reinterpret_cast<const ObMemtableDataHeader*>(node->buf_);
-          ObCellReader cci;
-          if (OB_ISNULL(mtd)) {
-            ret = OB_ERR_UNEXPECTED;
-            TRANS_LOG(ERROR, "iter NULL trans_node");
-          } else if (OB_FAIL(cci.init(mtd->buf_, mtd->buf_len_, SPARSE))) {
-            TRANS_LOG(WARN, "cci.init fail", KR(ret));
-          } else {
-            fprintf(fd, "\t%s dml=%d size=%ld\n", to_cstring(*node), mtd->dml_type_, mtd->buf_len_);
-          }
-          while (OB_SUCC(ret) && OB_SUCC(cci.next_cell())) {
-            uint64_t column_id = OB_INVALID_ID;
-            const ObObj* value = NULL;
-            if (OB_FAIL(cci.get_cell(column_id, value))) {
-              TRANS_LOG(WARN, "get_cell fail", KR(ret));
-            } else if (NULL == value) {
-              ret = OB_ERR_UNEXPECTED;
-              TRANS_LOG(WARN, "get_cell fail, value=NULL", KR(ret));
-            } else if (ObExtendType == value->get_type() && ObActionFlag::OP_END_FLAG == value->get_ext()) {
-              ret = OB_ITER_END;
-            } else {
-              fprintf(fd, "\tcid=%ld val=%s\n", column_id, to_cstring(*value));
-            }
-          }
-          if (OB_ITER_END == ret) {
-            ret = OB_SUCCESS;
-          }
-        }
-      }
+    Iterator<keybtree::TScanHandle> iter;
+    iter.reset();
+    const_cast<ObMemtableKey*>(iter.get_key())->encode(table_id_, nullptr);
+    if (OB_FAIL(keybtree_.set_key_range(
+            iter.get_read_handle(), scan_start_key_wrapper, 1, scan_end_key_wrapper, 1, INT64_MAX))) {
+      TRANS_LOG(ERROR, "set key range to btree scan handle fail", KR(ret));
+    } else {
+      (void)dump_rows(iter, fd);
+      keybtree_.dump(fd);
+      fprintf(fd, "--------------------------\n");
     }
-    keybtree_.dump(fd);
-    fprintf(fd, "--------------------------\n");
   }
 }
 
@@ -243,7 +271,11 @@ int ObQueryEngine::TableIndex::dump_keybtree(FILE* fd)
     node = ATOMIC_LOAD(base_ + i);
     if (OB_NOT_NULL(node)) {
       fprintf(fd, "table_id=%lu\n", node->get_table_id());
-      node->get_keybtree().dump(fd);
+      if (node->is_art()) {
+        node->get_art().dump(fd);
+      } else {
+        node->get_keybtree().dump(fd);
+      }
     }
   }
   return OB_SUCCESS;
@@ -256,7 +288,7 @@ int64_t ObQueryEngine::TableIndex::btree_size() const
     TableIndexNode* node = nullptr;
     node = ATOMIC_LOAD(base_ + i);
     if (OB_NOT_NULL(node)) {
-      obj_cnt += node->get_keybtree().size();
+      obj_cnt += node->is_art() ? node->get_art().size() : node->get_keybtree().size();
     }
   }
   return obj_cnt;
@@ -269,7 +301,7 @@ int64_t ObQueryEngine::TableIndex::btree_alloc_memory() const
     TableIndexNode* node = nullptr;
     node = ATOMIC_LOAD(base_ + i);
     if (OB_NOT_NULL(node)) {
-      alloc_mem += sizeof(keybtree::ObKeyBtree);
+      alloc_mem += node->is_art() ? node->get_art().get_alloc_memory() : sizeof(keybtree::ObKeyBtree);
     }
   }
   return alloc_mem + btree_allocator_.get_allocated();
@@ -319,7 +351,8 @@ int ObQueryEngine::TableIndex::get(const uint64_t table_id, TableIndexNode*& ret
   return ret;
 }
 
-int ObQueryEngine::TableIndex::set(const uint64_t table_id, const int64_t obj_cnt, TableIndexNode*& return_ptr)
+int ObQueryEngine::TableIndex::set(
+    const uint64_t table_id, const int64_t obj_cnt, TableIndexNode*& return_ptr, const bool use_art)
 {
   int ret = OB_SUCCESS;
   uint64_t i = table_id % capacity_;
@@ -349,7 +382,8 @@ int ObQueryEngine::TableIndex::set(const uint64_t table_id, const int64_t obj_cn
         // hold the empty slot successfully
         if (OB_NOT_NULL(
                 new_node = reinterpret_cast<TableIndexNode*>(memstore_allocator_.alloc(sizeof(TableIndexNode)))) &&
-            OB_NOT_NULL(new (new_node) TableIndexNode(btree_allocator_, memstore_allocator_, table_id, obj_cnt))) {
+            OB_NOT_NULL(new (new_node)
+                            TableIndexNode(btree_allocator_, memstore_allocator_, table_id, obj_cnt, use_art))) {
           if (OB_FAIL(new_node->init())) {
             ret = OB_INIT_FAIL;
             TRANS_LOG(ERROR, "table_index_node init failed", KR(ret), K(table_id), K(new_node));
@@ -408,6 +442,17 @@ int ObQueryEngine::init(const uint64_t tenant_id)
     ret = OB_INIT_TWICE;
   } else {
     tenant_id_ = tenant_id;
+    use_art_ = false;
+    if (GCONF._enable_memtable_art_index) {
+      // the encoding of rowkeys follows the comparison of mysql mode
+      share::ObWorker::CompatMode mode = share::ObWorker::CompatMode::INVALID;
+      int tmp_ret = OB_SUCCESS;
+      if (OB_SUCCESS != (tmp_ret = share::ObCompatModeGetter::get_tenant_mode(tenant_id, mode))) {
+        TRANS_LOG(WARN, "get compat mode fail, art index is not used", K(tmp_ret), K(tenant_id));
+      } else {
+        use_art_ = share::ObWorker::CompatMode::MYSQL == mode;
+      }
+    }
     is_inited_ = true;
   }
   if (OB_FAIL(ret) && IS_NOT_INIT) {
@@ -441,9 +486,19 @@ int ObQueryEngine::set(const ObMemtableKey* key, ObMvccRow* value)
   } else {
     TableIndexNode* node_ptr = nullptr;
     if (OB_UNLIKELY(OB_TABLE_NOT_EXIST == (ret = (get_table_index_node(key->get_table_id(), node_ptr))))) {
-      ret = set_table_index_node(key->get_table_id(), key->get_rowkey()->get_obj_cnt(), node_ptr);
+      ret = set_table_index_node(key->get_table_id(), key->get_rowkey()->get_obj_cnt(), node_ptr, can_use_art(key));
     }
-    if (OB_SUCC(ret) && OB_NOT_NULL(node_ptr)) {
+    if (OB_FAIL(ret) || OB_ISNULL(node_ptr)) {
+    } else if (node_ptr->is_art()) {
+      if (OB_FAIL(hash_ret = node_ptr->get_art().insert(key->get_rowkey(), value))) {
+        if (OB_ENTRY_EXIST != hash_ret) {
+          TRANS_LOG(WARN, "put to art index fail", "hash_ret", hash_ret, "key", key);
+        }
+        ret = hash_ret;
+      } else {
+        value->set_hash_indexed();
+      }
+    } else {
       ObStoreRowkeyWrapper key_wrapper(key->get_rowkey());
       if (OB_FAIL(hash_ret = node_ptr->get_keyhash().insert(&key_wrapper, value))) {
         if (OB_ENTRY_EXIST != hash_ret) {
@@ -479,6 +534,19 @@ int ObQueryEngine::get(const ObMemtableKey* parameter_key, ObMvccRow*& row, ObMe
     } else if (OB_ISNULL(node_ptr)) {
       ret = OB_ERR_UNEXPECTED;
       TRANS_LOG(ERROR, "node_ptr is nullptr", K(*parameter_key));
+    } else if (node_ptr->is_art()) {
+      ObArtKey art_key;
+      const ObStoreRowkey* stored_rowkey = nullptr;
+      if (OB_FAIL(art_key.encode(*parameter_key->get_rowkey()))) {
+        TRANS_LOG(WARN, "encode art key fail", KR(ret), K(*parameter_key));
+      } else if (OB_FAIL(node_ptr->get_art().get(art_key, stored_rowkey, row))) {
+        if (OB_ENTRY_NOT_EXIST != ret) {
+          TRANS_LOG(WARN, "get from art index fail", KR(ret), K(*parameter_key));
+        }
+        row = nullptr;
+      } else {
+        ret = returned_key->encode(parameter_key->get_table_id(), stored_rowkey);
+      }
     } else {
       const ObStoreRowkeyWrapper parameter_key_wrapper(parameter_key->get_rowkey());
       const ObStoreRowkeyWrapper* copy_inner_key_wrapper = nullptr;
@@ -510,9 +578,15 @@ int ObQueryEngine::ensure(const ObMemtableKey* key, ObMvccRow* value)
   } else {
     TableIndexNode* node_ptr = nullptr;
     if (OB_UNLIKELY(OB_TABLE_NOT_EXIST == (ret = get_table_index_node(key->get_table_id(), node_ptr)))) {
-      ret = set_table_index_node(key->get_table_id(), key->get_rowkey()->get_obj_cnt(), node_ptr);
+      ret = set_table_index_node(key->get_table_id(), key->get_rowkey()->get_obj_cnt(), node_ptr, can_use_art(key));
     }
-    if (OB_SUCC(ret) && OB_NOT_NULL(node_ptr)) {
+    if (OB_FAIL(ret) || OB_ISNULL(node_ptr)) {
+    } else if (node_ptr->is_art()) {
+      // the row has been ordered by the art index since set
+      if (!value->is_btree_indexed()) {
+        value->set_btree_indexed();
+      }
+    } else {
       if (value->is_btree_indexed()) {
         if (value->is_btree_tag_del()) {
           ObStoreRowkeyWrapper key_wrapper(key->get_rowkey());
@@ -548,6 +622,9 @@ int ObQueryEngine::skip_gap(
     } else if (OB_ISNULL(node_ptr)) {
       ret = OB_ERR_UNEXPECTED;
       TRANS_LOG(ERROR, "node_ptr is nullptr", K(*start));
+    } else if (node_ptr->is_art()) {
+      // no gap is recorded in art index
+      ret = OB_ENTRY_NOT_EXIST;
     } else {
       ObStoreRowkeyWrapper start_btk(start->get_rowkey());
       ObStoreRowkeyWrapper end_btk;
@@ -576,7 +653,9 @@ int ObQueryEngine::check_and_purge(const ObMemtableKey* key, ObMvccRow* row, int
     } else if (row->is_btree_tag_del()) {
       // do nothing
     } else if (OB_SUCCESS != (tmp_ret = purge(key, version))) {
-      TRANS_LOG(WARN, "purge from keybtree fail", K(tmp_ret), K(*key), K(version));
+      if (OB_ENTRY_NOT_EXIST != tmp_ret) {
+        TRANS_LOG(WARN, "purge from keybtree fail", K(tmp_ret), K(*key), K(version));
+      }
     } else {
       purged = true;
     }
@@ -600,6 +679,8 @@ int ObQueryEngine::get_sdr(
     } else if (OB_ISNULL(node_ptr)) {
       ret = OB_ERR_UNEXPECTED;
       TRANS_LOG(ERROR, "node_ptr is nullptr", K(*key), K(*start_key), K(*end_key));
+    } else if (node_ptr->is_art()) {
+      ret = OB_ENTRY_NOT_EXIST;
     } else {
       ObStoreRowkeyWrapper btk(key->get_rowkey());
       ObStoreRowkeyWrapper start_btk;
@@ -630,6 +711,9 @@ int ObQueryEngine::purge(const ObMemtableKey* key, int64_t version)
     } else if (OB_ISNULL(node_ptr)) {
       ret = OB_ERR_UNEXPECTED;
       TRANS_LOG(ERROR, "node_ptr is nullptr", K(*key));
+    } else if (node_ptr->is_art()) {
+      // keys are never removed from art index
+      ret = OB_ENTRY_NOT_EXIST;
     } else {
       ObStoreRowkeyWrapper key_wrapper(key->get_rowkey());
       if (OB_FAIL(node_ptr->get_keybtree().del(key_wrapper, value, version))) {
@@ -649,30 +733,50 @@ int ObQueryEngine::scan(const ObMemtableKey* start_key, const int start_exclude,
     const int end_exclude, const int64_t version, ObIQueryEngineIterator*& ret_iter)
 {
   int ret = OB_SUCCESS;
-  Iterator<keybtree::TScanHandle>* iter = nullptr;
+  ObIQueryEngineIterator* iter = nullptr;
+  TableIndexNode* node_ptr = nullptr;
   if (IS_NOT_INIT) {
     TRANS_LOG(WARN, "not init", "this", this);
     ret = OB_NOT_INIT;
   } else if (OB_ISNULL(start_key) || OB_ISNULL(end_key)) {
     ret = OB_INVALID_ARGUMENT;
     TRANS_LOG(WARN, "invalid param", KR(ret));
-  } else if (OB_ISNULL(iter = iter_alloc_.alloc())) {
-    TRANS_LOG(WARN, "alloc iter fail");
-    ret = OB_ALLOCATE_MEMORY_FAILED;
+  } else if (OB_SUCCESS != get_table_index_node(start_key->get_table_id(), node_ptr)) {
+    // FIXME  : to keep compatibility, return old version ret.
+    if (OB_ISNULL(iter = iter_alloc_.alloc())) {
+      TRANS_LOG(WARN, "alloc iter fail");
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+    }
+  } else if (OB_ISNULL(node_ptr)) {
+    ret = OB_ERR_UNEXPECTED;
+    TRANS_LOG(ERROR, "node_ptr is nullptr", K(*start_key), K(*end_key));
+  } else if (node_ptr->is_art()) {
+    Iterator<ObArtScanHandle>* art_iter = nullptr;
+    if (OB_ISNULL(iter = art_iter = art_iter_alloc_.alloc())) {
+      TRANS_LOG(WARN, "alloc art iter fail");
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+    } else {
+      art_iter->reset();
+      const_cast<ObMemtableKey*>(art_iter->get_key())->encode(start_key->get_table_id(), nullptr);
+      if (OB_FAIL(art_iter->get_read_handle().init(node_ptr->get_art(),
+              *start_key->get_rowkey(),
+              start_exclude,
+              *end_key->get_rowkey(),
+              end_exclude))) {
+        TRANS_LOG(WARN, "init art scan handle fail", KR(ret));
+      }
+    }
   } else {
-    TableIndexNode* node_ptr = nullptr;
-    if (OB_FAIL(get_table_index_node(start_key->get_table_id(), node_ptr))) {
-      // FIXME  : to keep compatibility, return old version ret.
-      ret = OB_SUCCESS;
-    } else if (OB_ISNULL(node_ptr)) {
-      ret = OB_ERR_UNEXPECTED;
-      TRANS_LOG(ERROR, "node_ptr is nullptr", K(*start_key), K(*end_key));
+    Iterator<keybtree::TScanHandle>* btree_iter = nullptr;
+    if (OB_ISNULL(iter = btree_iter = iter_alloc_.alloc())) {
+      TRANS_LOG(WARN, "alloc iter fail");
+      ret = OB_ALLOCATE_MEMORY_FAILED;
     } else {
       ObStoreRowkeyWrapper scan_start_key_wrapper(start_key->get_rowkey());
       ObStoreRowkeyWrapper scan_end_key_wrapper(end_key->get_rowkey());
-      iter->reset();
-      const_cast<ObMemtableKey*>(iter->get_key())->encode(start_key->get_table_id(), nullptr);
-      if (OB_FAIL(node_ptr->get_keybtree().set_key_range(iter->get_read_handle(),
+      btree_iter->reset();
+      const_cast<ObMemtableKey*>(btree_iter->get_key())->encode(start_key->get_table_id(), nullptr);
+      if (OB_FAIL(node_ptr->get_keybtree().set_key_range(btree_iter->get_read_handle(),
               scan_start_key_wrapper,
               start_exclude,
               scan_end_key_wrapper,
@@ -681,17 +785,17 @@ int ObQueryEngine::scan(const ObMemtableKey* start_key, const int start_exclude,
         ret = OB_ERR_UNEXPECTED;
         TRANS_LOG(ERROR, "set key range to btree scan handle fail", KR(ret));
       }
-      TRANS_LOG(DEBUG,
-          "[BTREE_SCAN_PARAM]",
-          "start_key",
-          start_key,
-          "start_exclude",
-          start_exclude,
-          "end_key",
-          end_key,
-          "end_exclude",
-          end_exclude);
     }
+    TRANS_LOG(DEBUG,
+        "[BTREE_SCAN_PARAM]",
+        "start_key",
+        start_key,
+        "start_exclude",
+        start_exclude,
+        "end_key",
+        end_key,
+        "end_exclude",
+        end_exclude);
   }
   if (OB_FAIL(ret)) {
     TRANS_LOG(WARN,
@@ -713,13 +817,18 @@ int ObQueryEngine::scan(const ObMemtableKey* start_key, const int start_exclude,
 
 void ObQueryEngine::revert_iter(ObIQueryEngineIterator* iter)
 {
-  iter_alloc_.free((Iterator<keybtree::TScanHandle>*)iter);
+  if (OB_ISNULL(iter)) {
+  } else if (iter->is_art_scan()) {
+    art_iter_alloc_.free(static_cast<Iterator<ObArtScanHandle>*>(iter));
+  } else {
+    iter_alloc_.free(static_cast<Iterator<keybtree::TScanHandle>*>(iter));
+  }
   iter = NULL;
 }
 
-int ObQueryEngine::sample_rows(Iterator<keybtree::TScanRawHandle>* iter, const ObMemtableKey* start_key,
-    const int start_exclude, const ObMemtableKey* end_key, const int end_exclude, int64_t& logical_row_count,
-    int64_t& physical_row_count, double& ratio)
+template <typename ScanHandle>
+int ObQueryEngine::sample_iter_rows(
+    Iterator<ScanHandle>* iter, int64_t& logical_row_count, int64_t& physical_row_count, double& ratio)
 {
   int ret = OB_SUCCESS;
   ObMvccRow* value = nullptr;
@@ -731,64 +840,41 @@ int ObQueryEngine::sample_rows(Iterator<keybtree::TScanRawHandle>* iter, const O
   physical_row_count = 0;
   ratio = 1.5;
   const bool skip_purge_memtable = false;
-  TableIndexNode* node_ptr = nullptr;
-  TRANS_LOG(DEBUG, "estimate row count, key range", K(*start_key), K(*end_key));
-  iter->reset();
-  if (OB_FAIL(get_table_index_node(start_key->get_table_id(), node_ptr))) {
-    // FIXME  : to keep compatibility, return old version ret.
-    ret = OB_ITER_END;
-  } else if (OB_ISNULL(node_ptr)) {
-    ret = OB_ERR_UNEXPECTED;
-    TRANS_LOG(ERROR, "node_ptr is nullptr", K(*start_key), K(*end_key));
-  } else {
-    ObStoreRowkeyWrapper scan_start_key_wrapper(start_key->get_rowkey());
-    ObStoreRowkeyWrapper scan_end_key_wrapper(end_key->get_rowkey());
-    if (OB_FAIL(node_ptr->get_keybtree().set_key_range(iter->get_read_handle(),
-            scan_start_key_wrapper,
-            start_exclude,
-            scan_end_key_wrapper,
-            end_exclude,
-            0 /*unused version*/))) {
-      TRANS_LOG(WARN, "set key range to btree scan handle failed", KR(ret));
+  while (OB_SUCC(ret)) {
+    if (OB_FAIL(iter->next(skip_purge_memtable))) {
+      if (OB_ITER_END != ret) {
+        TRANS_LOG(WARN, "query engine iter next fail", KR(ret));
+      }
+    } else if (OB_ISNULL(value = iter->get_value())) {
+      TRANS_LOG(ERROR, "unexpected value null pointer");
+      ret = OB_ERR_UNEXPECTED;
     } else {
-      // sample
-      while (OB_SUCC(ret)) {
-        if (OB_FAIL(iter->next(skip_purge_memtable))) {
-          if (OB_ITER_END != ret) {
-            TRANS_LOG(WARN, "query engine iter next fail", KR(ret));
-          }
-        } else if (OB_ISNULL(value = iter->get_value())) {
-          TRANS_LOG(ERROR, "unexpected value null pointer");
-          ret = OB_ERR_UNEXPECTED;
+      ++sample_row_count;
+      ++physical_row_count;
+      if (value->is_btree_tag_del()) {
+        ++gap_size;
+      } else {
+        if (gap_size >= OB_SKIP_RANGE_LIMIT) {
+          physical_row_count -= 2 * gap_size;
+        }
+        gap_size = 0;
+      }
+      if (storage::T_DML_INSERT == value->first_dml_ && storage::T_DML_DELETE != value->last_dml_) {
+        // insert new row
+        ++logical_row_count;
+      } else if (storage::T_DML_DELETE == value->last_dml_) {
+        if (storage::T_DML_INSERT != value->first_dml_) {
+          // delete existent row
+          --logical_row_count;
+          ++delete_row_count;
         } else {
-          ++sample_row_count;
-          ++physical_row_count;
-          if (value->is_btree_tag_del()) {
-            ++gap_size;
-          } else {
-            if (gap_size >= OB_SKIP_RANGE_LIMIT) {
-              physical_row_count -= 2 * gap_size;
-            }
-            gap_size = 0;
-          }
-          if (storage::T_DML_INSERT == value->first_dml_ && storage::T_DML_DELETE != value->last_dml_) {
-            // insert new row
-            ++logical_row_count;
-          } else if (storage::T_DML_DELETE == value->last_dml_) {
-            if (storage::T_DML_INSERT != value->first_dml_) {
-              // delete existent row
-              --logical_row_count;
-              ++delete_row_count;
-            } else {
-              ++empty_delete_row_count;
-            }
-          } else {
-            // existent row, not change estimation total row count
-          }
-          if (sample_row_count >= MAX_SAMPLE_ROW_COUNT) {
-            break;
-          }
+          ++empty_delete_row_count;
         }
+      } else {
+        // existent row, not change estimation total row count
+      }
+      if (sample_row_count >= MAX_SAMPLE_ROW_COUNT) {
+        break;
       }
     }
   }
@@ -813,6 +899,40 @@ int ObQueryEngine::sample_rows(Iterator<keybtree::TScanRawHandle>* iter, const O
   return ret;
 }
 
+int ObQueryEngine::sample_rows(Iterator<keybtree::TScanRawHandle>* iter, const ObMemtableKey* start_key,
+    const int start_exclude, const ObMemtableKey* end_key, const int end_exclude, int64_t& logical_row_count,
+    int64_t& physical_row_count, double& ratio)
+{
+  int ret = OB_SUCCESS;
+  TableIndexNode* node_ptr = nullptr;
+  logical_row_count = 0;
+  physical_row_count = 0;
+  ratio = 1.5;
+  TRANS_LOG(DEBUG, "estimate row count, key range", K(*start_key), K(*end_key));
+  iter->reset();
+  if (OB_FAIL(get_table_index_node(start_key->get_table_id(), node_ptr))) {
+    // FIXME  : to keep compatibility, return old version ret.
+    ret = OB_ITER_END;
+  } else if (OB_ISNULL(node_ptr)) {
+    ret = OB_ERR_UNEXPECTED;
+    TRANS_LOG(ERROR, "node_ptr is nullptr", K(*start_key), K(*end_key));
+  } else {
+    ObStoreRowkeyWrapper scan_start_key_wrapper(start_key->get_rowkey());
+    ObStoreRowkeyWrapper scan_end_key_wrapper(end_key->get_rowkey());
+    if (OB_FAIL(node_ptr->get_keybtree().set_key_range(iter->get_read_handle(),
+            scan_start_key_wrapper,
+            start_exclude,
+            scan_end_key_wrapper,
+            end_exclude,
+            0 /*unused version*/))) {
+      TRANS_LOG(WARN, "set key range to btree scan handle failed", KR(ret));
+    } else {
+      ret = sample_iter_rows(iter, logical_row_count, physical_row_count, ratio);
+    }
+  }
+  return ret;
+}
+
 int ObQueryEngine::prefix_exist(const ObMemtableKey* prefix_key, bool& may_exist)
 {
   int ret = OB_SUCCESS;
@@ -846,6 +966,8 @@ int ObQueryEngine::prefix_exist(const ObMemtableKey* prefix_key, bool& may_exist
     } else if (OB_ISNULL(node_ptr)) {
       ret = OB_ERR_UNEXPECTED;
       TRANS_LOG(ERROR, "node_ptr is nullptr", K(*prefix_key));
+    } else if (node_ptr->is_art()) {
+      ret = art_prefix_exist(node_ptr, prefix_key, may_exist);
     } else if (OB_FAIL(node_ptr->get_keybtree().set_key_range(iter->get_read_handle(),
                    scan_start_key_wrapper,
                    1,
@@ -915,36 +1037,50 @@ int ObQueryEngine::estimate_size(const ObMemtableKey* start_key, const ObMemtabl
 {
   int ret = OB_SUCCESS;
   Iterator<keybtree::TScanRawHandle>* iter = nullptr;
+  TableIndexNode* node_ptr = nullptr;
   branch_count = 0;
-  for (level = 0; branch_count < ESTIMATE_CHILD_COUNT_THRESHOLD && OB_SUCC(ret);) {
-    level++;
-    if (OB_FAIL(init_raw_iter_for_estimate(iter, start_key, end_key))) {
-      TRANS_LOG(WARN, "init raw iter fail", K(ret), K(*start_key), K(*end_key));
-    } else if (OB_ISNULL(iter)) {
-      ret = OB_ERR_UNEXPECTED;
-    } else if (OB_FAIL(iter->get_read_handle().estimate_key_count(level, branch_count, total_rows))) {
-      if (OB_ENTRY_NOT_EXIST != ret) {
-        TRANS_LOG(WARN, "estimate key count fail", K(ret), K(*start_key), K(*end_key));
+  if (is_art_table(start_key->get_table_id(), node_ptr)) {
+    ObArtKey lower;
+    ObArtKey upper;
+    level = 1;
+    if (OB_FAIL(lower.encode(*start_key->get_rowkey())) || OB_FAIL(upper.encode(*end_key->get_rowkey()))) {
+      TRANS_LOG(WARN, "encode art key fail", K(ret), K(*start_key), K(*end_key));
+    } else if (OB_FAIL(node_ptr->get_art().estimate_row_count(lower, upper, branch_count, total_rows))) {
+      TRANS_LOG(WARN, "estimate art row count fail", K(ret), K(*start_key), K(*end_key));
+    } else {
+      total_bytes = total_rows * ART_ESTIMATE_ROW_SIZE;
+    }
+  } else {
+    for (level = 0; branch_count < ESTIMATE_CHILD_COUNT_THRESHOLD && OB_SUCC(ret);) {
+      level++;
+      if (OB_FAIL(init_raw_iter_for_estimate(iter, start_key, end_key))) {
+        TRANS_LOG(WARN, "init raw iter fail", K(ret), K(*start_key), K(*end_key));
+      } else if (OB_ISNULL(iter)) {
+        ret = OB_ERR_UNEXPECTED;
+      } else if (OB_FAIL(iter->get_read_handle().estimate_key_count(level, branch_count, total_rows))) {
+        if (OB_ENTRY_NOT_EXIST != ret) {
+          TRANS_LOG(WARN, "estimate key count fail", K(ret), K(*start_key), K(*end_key));
+        }
+      }
+      if (OB_NOT_NULL(iter)) {
+        iter->reset();
+        raw_iter_alloc_.free(iter);
+        iter = NULL;
       }
     }
-    if (OB_NOT_NULL(iter)) {
-      iter->reset();
-      raw_iter_alloc_.free(iter);
-      iter = NULL;
+    if (OB_SUCC(ret)) {
+      int64_t per_row_size = 0;
+      if (OB_FAIL(iter->get_read_handle().estimate_row_size(per_row_size))) {
+        TRANS_LOG(WARN, "estimate row size fail", K(ret));
+      } else {
+        total_bytes = total_rows * per_row_size;
+      }
+    } else if (OB_ENTRY_NOT_EXIST == ret) {
+      ret = OB_SUCCESS;
+      total_bytes = 0;
+      total_rows = 0;
     }
   }
-  if (OB_SUCC(ret)) {
-    int64_t per_row_size = 0;
-    if (OB_FAIL(iter->get_read_handle().estimate_row_size(per_row_size))) {
-      TRANS_LOG(WARN, "estimate row size fail", K(ret));
-    } else {
-      total_bytes = total_rows * per_row_size;
-    }
-  } else if (OB_ENTRY_NOT_EXIST == ret) {
-    ret = OB_SUCCESS;
-    total_bytes = 0;
-    total_rows = 0;
-  }
   return ret;
 }
 
@@ -957,9 +1093,12 @@ int ObQueryEngine::split_range(const ObMemtableKey* start_key, const ObMemtableK
   int64_t branch_count = 0;
   int64_t total_bytes = 0;
   int64_t total_rows = 0;
+  TableIndexNode* node_ptr = nullptr;
   ObStoreRowkeyWrapper key_array[MAX_RANGE_SPLIT_COUNT];
   if (part_count < 1 || part_count > MAX_RANGE_SPLIT_COUNT) {
     TRANS_LOG(WARN, "part count should be greater than 1 if you try to split range", K(part_count));
+  } else if (is_art_table(start_key->get_table_id(), node_ptr)) {
+    ret = art_split_range(node_ptr, start_key, end_key, part_count, range_array);
   } else if (OB_FAIL(estimate_size(start_key, end_key, level, branch_count, total_bytes, total_rows)) &&
              OB_ENTRY_NOT_EXIST != ret) {
     TRANS_LOG(WARN, "estimate size fail", K(ret), K(*start_key), K(*end_key));
@@ -1017,6 +1156,27 @@ int ObQueryEngine::split_range(const ObMemtableKey* start_key, const ObMemtableK
 
 int ObQueryEngine::estimate_row_count(const ObMemtableKey* start_key, const int start_exclude,
     const ObMemtableKey* end_key, const int end_exclude, int64_t& logical_row_count, int64_t& physical_row_count)
+{
+  int ret = OB_SUCCESS;
+  TableIndexNode* node_ptr = nullptr;
+  if (IS_NOT_INIT) {
+    TRANS_LOG(WARN, "not init", "this", this);
+    ret = OB_NOT_INIT;
+  } else if (OB_ISNULL(start_key) || OB_ISNULL(end_key)) {
+    ret = OB_INVALID_ARGUMENT;
+    TRANS_LOG(WARN, "invalid param", KR(ret));
+  } else if (is_art_table(start_key->get_table_id(), node_ptr)) {
+    ret = art_estimate_row_count(
+        node_ptr, start_key, start_exclude, end_key, end_exclude, logical_row_count, physical_row_count);
+  } else {
+    ret = btree_estimate_row_count(
+        start_key, start_exclude, end_key, end_exclude, logical_row_count, physical_row_count);
+  }
+  return ret;
+}
+
+int ObQueryEngine::btree_estimate_row_count(const ObMemtableKey* start_key, const int start_exclude,
+    const ObMemtableKey* end_key, const int end_exclude, int64_t& logical_row_count, int64_t& physical_row_count)
 {
   int ret = OB_SUCCESS;
   Iterator<keybtree::TScanRawHandle>* iter = nullptr;
@@ -1119,7 +1279,8 @@ int ObQueryEngine::get_table_index_node(const uint64_t table_id, TableIndexNode*
   return ret;
 }
 
-int ObQueryEngine::set_table_index_node(const uint64_t table_id, const int64_t obj_cnt, TableIndexNode*& return_ptr)
+int ObQueryEngine::set_table_index_node(
+    const uint64_t table_id, const int64_t obj_cnt, TableIndexNode*& return_ptr, const bool use_art)
 {
   int ret = OB_SUCCESS;
   if (IS_NOT_INIT) {
@@ -1132,7 +1293,7 @@ int ObQueryEngine::set_table_index_node(const uint64_t table_id, const int64_t o
       if (OB_ISNULL(index)) {
         ret = OB_ARRAY_OUT_OF_RANGE;
       } else {
-        ret = index->set(table_id, obj_cnt, return_ptr);
+        ret = index->set(table_id, obj_cnt, return_ptr, use_art);
       }
 
       if (OB_UNLIKELY(OB_ARRAY_OUT_OF_RANGE == ret)) {
@@ -1182,6 +1343,144 @@ int ObQueryEngine::expand_index(TableIndex* old_index)
   return ret;
 }
 
+bool ObQueryEngine::can_use_art(const ObMemtableKey* key) const
+{
+  // a table is indexed by art only if its first row tells the types of all rowkey columns
+  return use_art_ && ObArtKey::is_supported(*key->get_rowkey());
+}
+
+bool ObQueryEngine::is_art_table(const uint64_t table_id, TableIndexNode*& node_ptr)
+{
+  return OB_SUCCESS == get_table_index_node(table_id, node_ptr) && OB_NOT_NULL(node_ptr) && node_ptr->is_art();
+}
+
+int ObQueryEngine::art_prefix_exist(TableIndexNode* node_ptr, const ObMemtableKey* prefix_key, bool& may_exist)
+{
+  int ret = OB_SUCCESS;
+  Iterator<ObArtScanHandle>* iter = nullptr;
+  const ObMemtableKey* iter_key = nullptr;
+  int cmp = 0;
+  may_exist = true;
+  if (OB_ISNULL(iter = art_iter_alloc_.alloc())) {
+    TRANS_LOG(WARN, "alloc art iter fail");
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+  } else {
+    iter->reset();
+    const_cast<ObMemtableKey*>(iter->get_key())->encode(prefix_key->get_table_id(), nullptr);
+    if (OB_FAIL(iter->get_read_handle().init(
+            node_ptr->get_art(), *prefix_key->get_rowkey(), true, ObStoreRowkey::MAX_STORE_ROWKEY, true))) {
+      TRANS_LOG(WARN, "init art scan handle fail", KR(ret), K(*prefix_key));
+    } else if (OB_FAIL(iter->next(false /*skip_purge_memtable*/))) {
+      if (OB_ITER_END != ret) {
+        TRANS_LOG(WARN, "query engine iter next fail", KR(ret));
+      } else {
+        ret = OB_SUCCESS;
+        may_exist = false;
+      }
+    } else if (OB_ISNULL(iter_key = iter->get_key())) {
+      ret = OB_ERR_UNEXPECTED;
+      TRANS_LOG(WARN, "Unexpected null iter memtable key", KR(ret));
+    } else if (OB_FAIL(prefix_key->get_rowkey()->compare_prefix(*(iter_key->get_rowkey()), cmp))) {
+      TRANS_LOG(ERROR, "failed to compare", KR(ret), K(prefix_key->get_rowkey()), K(*(iter_key->get_rowkey())));
+    } else if (cmp < 0) {
+      may_exist = false;
+    }
+  }
+  if (OB_NOT_NULL(iter)) {
+    art_iter_alloc_.free(iter);
+    iter = NULL;
+  }
+  return ret;
+}
+
+// The number of rows is estimated with the art index, the logical row count is scaled from the sampled rows.
+int ObQueryEngine::art_estimate_row_count(TableIndexNode* node_ptr, const ObMemtableKey* start_key,
+    const int start_exclude, const ObMemtableKey* end_key, const int end_exclude, int64_t& logical_row_count,
+    int64_t& physical_row_count)
+{
+  int ret = OB_SUCCESS;
+  Iterator<ObArtScanHandle>* iter = nullptr;
+  ObArtKey lower;
+  ObArtKey upper;
+  int64_t branch_count = 0;
+  int64_t row_count = 0;
+  double ratio = 1.5;
+  logical_row_count = 0;
+  physical_row_count = 0;
+  if (OB_FAIL(lower.encode(*start_key->get_rowkey())) || OB_FAIL(upper.encode(*end_key->get_rowkey()))) {
+    TRANS_LOG(WARN, "encode art key fail", KR(ret), K(*start_key), K(*end_key));
+  } else if (lower.compare(upper) > 0) {
+    // reverse range, nothing to estimate
+  } else if (OB_FAIL(node_ptr->get_art().estimate_row_count(lower, upper, branch_count, row_count))) {
+    TRANS_LOG(WARN, "estimate art row count fail", KR(ret), K(*start_key), K(*end_key));
+  } else if (OB_ISNULL(iter = art_iter_alloc_.alloc())) {
+    TRANS_LOG(WARN, "alloc art iter fail");
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+  } else {
+    iter->reset();
+    const_cast<ObMemtableKey*>(iter->get_key())->encode(start_key->get_table_id(), nullptr);
+    if (OB_FAIL(iter->get_read_handle().init(
+            node_ptr->get_art(), *start_key->get_rowkey(), start_exclude, *end_key->get_rowkey(), end_exclude))) {
+      TRANS_LOG(WARN, "init art scan handle fail", KR(ret));
+    } else if (OB_FAIL(sample_iter_rows(iter, logical_row_count, physical_row_count, ratio))) {
+      if (OB_ITER_END == ret) {
+        // all rows of the range are sampled
+        ret = OB_SUCCESS;
+      } else {
+        TRANS_LOG(WARN, "failed to sample rows", KR(ret), K(*start_key), K(*end_key));
+      }
+    } else if (physical_row_count > 0 && row_count > physical_row_count) {
+      logical_row_count = static_cast<int64_t>(static_cast<double>(logical_row_count) *
+                                               static_cast<double>(row_count) /
+                                               static_cast<double>(physical_row_count));
+      physical_row_count = row_count;
+    }
+  }
+  if (OB_NOT_NULL(iter)) {
+    art_iter_alloc_.free(iter);
+    iter = NULL;
+  }
+  return ret;
+}
+
+int ObQueryEngine::art_split_range(TableIndexNode* node_ptr, const ObMemtableKey* start_key,
+    const ObMemtableKey* end_key, int64_t part_count, ObIArray<ObStoreRange>& range_array)
+{
+  int ret = OB_SUCCESS;
+  ObArtKey lower;
+  ObArtKey upper;
+  ObSEArray<const ObStoreRowkey*, 64> split_keys;
+  if (OB_FAIL(lower.encode(*start_key->get_rowkey())) || OB_FAIL(upper.encode(*end_key->get_rowkey()))) {
+    TRANS_LOG(WARN, "encode art key fail", K(ret), K(*start_key), K(*end_key));
+  } else if (OB_FAIL(node_ptr->get_art().split_range(lower, upper, part_count, split_keys))) {
+    if (OB_ENTRY_NOT_EXIST == ret) {
+      TRANS_LOG(WARN, "range too small, not enough rows to split", K(ret), K(*start_key), K(*end_key), K(part_count));
+    } else {
+      TRANS_LOG(WARN, "split art range fail", K(ret), K(*start_key), K(*end_key), K(part_count));
+    }
+  } else {
+    ObStoreRange merge_range;
+    for (int64_t i = 0; OB_SUCC(ret) && i < part_count; i++) {
+      if (0 == i) {
+        merge_range.set_start_key(ObStoreRowkey::MIN_STORE_ROWKEY);
+      } else {
+        merge_range.set_start_key(*split_keys.at(i - 1));
+      }
+      if (i == part_count - 1) {
+        merge_range.set_end_key(ObStoreRowkey::MAX_STORE_ROWKEY);
+      } else {
+        merge_range.set_end_key(*split_keys.at(i));
+      }
+      merge_range.set_left_open();
+      merge_range.set_right_closed();
+      if (OB_FAIL(range_array.push_back(merge_range))) {
+        TRANS_LOG(WARN, "Failed to push back the merge range to array", K(ret), K(merge_range));
+      }
+    }
+  }
+  return ret;
+}
+
 int ObQueryEngine::get_active_table_ids(common::ObIArray<uint64_t>& table_ids)
 {
   int ret = OB_SUCCESS;
@@ -13,9 +13,11 @@
 #ifndef OCEANBASE_MEMTABLE_MVCC_OB_QUERY_ENGINE_
 #define OCEANBASE_MEMTABLE_MVCC_OB_QUERY_ENGINE_
 
+#include <type_traits>
 #include "lib/container/ob_iarray.h"
 #include "lib/oblog/ob_log_module.h"
 #include "lib/objectpool/ob_concurrency_objpool.h"
+#include "storage/memtable/mvcc/ob_art_index.h"
 #include "storage/memtable/mvcc/ob_keybtree.h"
 #include "storage/memtable/ob_memtable_key.h"
 #include "storage/memtable/ob_mt_hash.h"
@@ -43,6 +45,7 @@ public:
   virtual void set_version(int64_t version) = 0;
   virtual uint8_t get_iter_flag() const = 0;
   virtual bool is_reverse_scan() const = 0;
+  virtual bool is_art_scan() const = 0;
 };
 
 class ObQueryEngine {
@@ -101,6 +104,10 @@ public:
     {
       return btree_iter_.is_reverse_scan();
     }
+    bool is_art_scan() const
+    {
+      return std::is_same<BtreeScanHandle, ObArtScanHandle>::value;
+    }
     ObMvccRow* get_value() const
     {
       return value_;
@@ -155,13 +162,16 @@ public:
     DISALLOW_COPY_AND_ASSIGN(IteratorAlloc);
   };
 
+  // Rows of a table are indexed by either the keyhash and the keybtree, or an adaptive radix tree alone.
   class TableIndexNode {
   public:
     explicit TableIndexNode(keybtree::BtreeNodeAllocator& btree_allocator, common::ObIAllocator& memstore_allocator,
-        const uint64_t table_id, int64_t obj_cnt)
+        const uint64_t table_id, int64_t obj_cnt, const bool is_art = false)
         : is_inited_(false),
+          is_art_(is_art),
           keybtree_(btree_allocator),
           keyhash_(memstore_allocator),
+          art_(memstore_allocator),
           table_id_(table_id),
           obj_cnt_(obj_cnt)
     {}
@@ -180,6 +190,14 @@ public:
     {
       return keyhash_;
     }
+    ObArtIndex& get_art()
+    {
+      return art_;
+    }
+    bool is_art() const
+    {
+      return is_art_;
+    }
     uint64_t get_table_id()
     {
       return table_id_;
@@ -189,11 +207,17 @@ public:
       return obj_cnt_;
     }
 
+  private:
+    template <typename ScanHandle>
+    int dump_rows(Iterator<ScanHandle>& iter, FILE* fd);
+
   private:
     DISALLOW_COPY_AND_ASSIGN(TableIndexNode);
     bool is_inited_;
+    bool is_art_;
     KeyBtree keybtree_;
     KeyHash keyhash_;
+    ObArtIndex art_;
     uint64_t table_id_;
     int64_t obj_cnt_;
   };
@@ -245,7 +269,7 @@ public:
      *   OB_ALLOCATE_MEMORY_FAILED : memory reach limit
      *   OB_SUCCESS                : return_ptr is valid
      **/
-    int set(const uint64_t table_id, const int64_t obj_cnt, TableIndexNode*& return_ptr);
+    int set(const uint64_t table_id, const int64_t obj_cnt, TableIndexNode*& return_ptr, const bool use_art = false);
     int get_active_table_ids(common::ObIArray<uint64_t>& table_ids);
 
   private:
@@ -259,10 +283,11 @@ public:
   };
 
 public:
-  enum { ESTIMATE_CHILD_COUNT_THRESHOLD = 1024, MAX_RANGE_SPLIT_COUNT = 1024 };
+  enum { ESTIMATE_CHILD_COUNT_THRESHOLD = 1024, MAX_RANGE_SPLIT_COUNT = 1024, ART_ESTIMATE_ROW_SIZE = 100 };
   explicit ObQueryEngine(ObIAllocator& memstore_allocator)
       : is_inited_(false),
         is_expanding_(false),
+        use_art_(false),
         tenant_id_(common::OB_SERVER_TENANT_ID),
         index_(nullptr),
         memstore_allocator_(memstore_allocator),
@@ -322,7 +347,9 @@ public:
   void dump2text(FILE* fd, const uint64_t table_id);
   void dump2text(FILE* fd);
   int get_table_index_node(const uint64_t table_id, TableIndexNode*& return_ptr);
-  int set_table_index_node(const uint64_t table_id, const int64_t obj_cnt, TableIndexNode*& return_ptr);
+  // the table is indexed by an adaptive radix tree if %use_art is true
+  int set_table_index_node(
+      const uint64_t table_id, const int64_t obj_cnt, TableIndexNode*& return_ptr, const bool use_art = false);
   int expand_index(TableIndex* old_index);
   int get_active_table_ids(common::ObIArray<uint64_t>& table_ids);
 
@@ -330,19 +357,34 @@ private:
   int sample_rows(Iterator<keybtree::TScanRawHandle>* iter, const ObMemtableKey* start_key, const int start_exclude,
       const ObMemtableKey* end_key, const int end_exclude, int64_t& logical_row_count, int64_t& physical_row_count,
       double& ratio);
+  template <typename ScanHandle>
+  int sample_iter_rows(
+      Iterator<ScanHandle>* iter, int64_t& logical_row_count, int64_t& physical_row_count, double& ratio);
   int init_raw_iter_for_estimate(
       Iterator<keybtree::TScanRawHandle>*& iter, const ObMemtableKey* start_key, const ObMemtableKey* end_key);
+  int btree_estimate_row_count(const ObMemtableKey* start_key, const int start_exclude, const ObMemtableKey* end_key,
+      const int end_exclude, int64_t& logical_row_count, int64_t& physical_row_count);
+  bool can_use_art(const ObMemtableKey* key) const;
+  bool is_art_table(const uint64_t table_id, TableIndexNode*& node_ptr);
+  int art_prefix_exist(TableIndexNode* node_ptr, const ObMemtableKey* prefix_key, bool& may_exist);
+  int art_estimate_row_count(TableIndexNode* node_ptr, const ObMemtableKey* start_key, const int start_exclude,
+      const ObMemtableKey* end_key, const int end_exclude, int64_t& logical_row_count, int64_t& physical_row_count);
+  int art_split_range(TableIndexNode* node_ptr, const ObMemtableKey* start_key, const ObMemtableKey* end_key,
+      int64_t part_count, common::ObIArray<common::ObStoreRange>& range_array);
 
 private:
   DISALLOW_COPY_AND_ASSIGN(ObQueryEngine);
   bool is_inited_;
   bool is_expanding_;
+  // new tables are indexed by adaptive radix trees, decided when the memtable is created
+  bool use_art_;
   uint64_t tenant_id_;
   TableIndex* index_;
   ObIAllocator& memstore_allocator_;
   keybtree::BtreeNodeAllocator btree_allocator_;
   IteratorAlloc<keybtree::TScanHandle> iter_alloc_;
   IteratorAlloc<keybtree::TScanRawHandle> raw_iter_alloc_;
+  IteratorAlloc<ObArtScanHandle> art_iter_alloc_;
 };
 
 }  // namespace memtable
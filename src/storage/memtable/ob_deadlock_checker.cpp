@@ -0,0 +1,640 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "ob_deadlock_checker.h"
+
+#include <algorithm>
+#include <sys/prctl.h>
+#include "lib/allocator/ob_malloc.h"
+#include "share/config/ob_server_config.h"
+#include "share/rpc/ob_batch_rpc.h"
+#include "storage/memtable/ob_lock_wait_mgr.h"
+#include "storage/memtable/ob_memtable_context.h"
+#include "storage/transaction/ob_trans_ctx.h"
+
+namespace oceanbase {
+
+using namespace common;
+using namespace transaction;
+
+namespace memtable {
+
+void ObDeadLockEdge::reset()
+{
+  waiter_.reset();
+  holder_.reset();
+  reporter_.reset();
+  waiter_ctx_desc_ = 0;
+  sessid_ = 0;
+  table_id_ = OB_INVALID_ID;
+  lock_ts_ = 0;
+  row_key_[0] = '\0';
+}
+
+void ObDeadLockEdge::set_row_key(const char* row_key)
+{
+  snprintf(row_key_, sizeof(row_key_), "%s", row_key);
+}
+
+OB_DEF_SERIALIZE(ObDeadLockEdge)
+{
+  int ret = OB_SUCCESS;
+  const ObString row_key(row_key_);
+  LST_DO_CODE(OB_UNIS_ENCODE, waiter_, holder_, reporter_, waiter_ctx_desc_, sessid_, table_id_, lock_ts_, row_key);
+  return ret;
+}
+
+OB_DEF_DESERIALIZE(ObDeadLockEdge)
+{
+  int ret = OB_SUCCESS;
+  ObString row_key;
+  LST_DO_CODE(OB_UNIS_DECODE, waiter_, holder_, reporter_, waiter_ctx_desc_, sessid_, table_id_, lock_ts_, row_key);
+  if (OB_SUCC(ret)) {
+    const int64_t len = std::min(static_cast<int64_t>(row_key.length()), ROW_KEY_SIZE - 1);
+    MEMCPY(row_key_, row_key.ptr(), len);
+    row_key_[len] = '\0';
+  }
+  return ret;
+}
+
+OB_DEF_SERIALIZE_SIZE(ObDeadLockEdge)
+{
+  int64_t len = 0;
+  const ObString row_key(row_key_);
+  LST_DO_CODE(OB_UNIS_ADD_LEN, waiter_, holder_, reporter_, waiter_ctx_desc_, sessid_, table_id_, lock_ts_, row_key);
+  return len;
+}
+
+OB_SERIALIZE_MEMBER(ObDeadLockMsg, msg_type_, edges_);
+
+int ObDeadLockMsg::assign(const ObDeadLockMsg& other)
+{
+  int ret = OB_SUCCESS;
+  if (this != &other) {
+    if (OB_FAIL(edges_.assign(other.edges_))) {
+      TRANS_LOG(WARN, "assign edges failed", K(ret));
+    } else {
+      msg_type_ = other.msg_type_;
+    }
+  }
+  return ret;
+}
+
+ObDeadLockChecker::ObDeadLockChecker()
+    : is_inited_(false),
+      self_addr_(),
+      batch_rpc_(NULL),
+      msg_queue_(),
+      edges_(),
+      edge_index_(),
+      history_lock_(),
+      cycle_count_(0)
+{}
+
+ObDeadLockChecker::~ObDeadLockChecker()
+{
+  destroy();
+}
+
+int ObDeadLockChecker::init(const ObAddr& self_addr, obrpc::ObBatchRpc* batch_rpc)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    TRANS_LOG(WARN, "deadlock checker init twice", K(ret));
+  } else if (OB_UNLIKELY(!self_addr.is_valid()) || OB_ISNULL(batch_rpc)) {
+    ret = OB_INVALID_ARGUMENT;
+    TRANS_LOG(WARN, "invalid argument", K(ret), K(self_addr), KP(batch_rpc));
+  } else if (OB_FAIL(msg_queue_.init(MSG_QUEUE_SIZE, ObModIds::OB_DEADLOCK_CHECKER))) {
+    TRANS_LOG(WARN, "init msg queue failed", K(ret));
+  } else if (OB_FAIL(
+                 edge_index_.create(MAX_EDGE_COUNT, ObModIds::OB_DEADLOCK_CHECKER, ObModIds::OB_DEADLOCK_CHECKER))) {
+    TRANS_LOG(WARN, "create edge index failed", K(ret));
+    msg_queue_.destroy();
+  } else {
+    self_addr_ = self_addr;
+    batch_rpc_ = batch_rpc;
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+void ObDeadLockChecker::destroy()
+{
+  if (is_inited_) {
+    clear_queued_msgs();
+    msg_queue_.destroy();
+    edges_.reset();
+    edge_index_.destroy();
+    batch_rpc_ = NULL;
+    is_inited_ = false;
+  }
+}
+
+void ObDeadLockChecker::run1()
+{
+  int ret = OB_SUCCESS;
+  (void)prctl(PR_SET_NAME, "DeadLockChecker", 0, 0, 0);
+  while (!has_set_stop()) {
+    const int64_t round_ts = ObTimeUtility::current_time();
+    const int64_t interval = GCONF._deadlock_detect_interval;
+    if (!GCONF._enable_deadlock_detect) {
+      reset_edges();
+    } else if (OB_FAIL(check_round())) {
+      TRANS_LOG(WARN, "check deadlock failed", K(ret));
+    }
+    handle_queued_msgs(round_ts + interval);
+  }
+  clear_queued_msgs();
+}
+
+int ObDeadLockChecker::handle_msg(const int64_t msg_type, const char* buf, const int64_t size)
+{
+  int ret = OB_SUCCESS;
+  ObDeadLockMsg msg;
+  int64_t pos = 0;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+  } else if (!GCONF._enable_deadlock_detect) {
+    // drop the message
+  } else if (OB_ISNULL(buf) || OB_UNLIKELY(size <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    TRANS_LOG(WARN, "invalid argument", K(ret), KP(buf), K(size));
+  } else if (OB_FAIL(msg.deserialize(buf, size, pos))) {
+    TRANS_LOG(WARN, "deserialize deadlock msg failed", K(ret), K(msg_type), K(size));
+  } else if (OB_UNLIKELY(!msg.is_valid() || msg.msg_type_ != msg_type)) {
+    ret = OB_INVALID_ARGUMENT;
+    TRANS_LOG(WARN, "invalid deadlock msg", K(ret), K(msg_type), K(msg));
+  } else if (OB_FAIL(push_msg(msg))) {
+    TRANS_LOG(WARN, "push deadlock msg failed", K(ret), K(msg));
+  }
+  return ret;
+}
+
+void ObDeadLockChecker::get_cycle_id_range(int64_t& start_id, int64_t& end_id)
+{
+  ObSpinLockGuard guard(history_lock_);
+  end_id = cycle_count_;
+  start_id = std::max(0L, cycle_count_ - HISTORY_CYCLE_COUNT);
+}
+
+int ObDeadLockChecker::get_cycle(const int64_t cycle_id, ObDeadLockCycle& cycle)
+{
+  int ret = OB_SUCCESS;
+  ObSpinLockGuard guard(history_lock_);
+  if (cycle_id < 0 || cycle_id >= cycle_count_ || cycle_id < cycle_count_ - HISTORY_CYCLE_COUNT) {
+    ret = OB_ENTRY_NOT_EXIST;
+  } else {
+    cycle = history_[cycle_id % HISTORY_CYCLE_COUNT];
+  }
+  return ret;
+}
+
+int ObDeadLockChecker::check_round()
+{
+  int ret = OB_SUCCESS;
+  LocalEdgeArray edges;
+  expire_edges(ObTimeUtility::current_time());
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+  } else if (OB_FAIL(collect_local_edges(edges))) {
+    TRANS_LOG(WARN, "collect local edges failed", K(ret));
+  } else if (OB_FAIL(report_edges(edges))) {
+    TRANS_LOG(WARN, "report edges failed", K(ret));
+  } else if (OB_FAIL(send_probes())) {
+    TRANS_LOG(WARN, "send probes failed", K(ret));
+  }
+  return ret;
+}
+
+void ObDeadLockChecker::handle_queued_msgs(const int64_t abs_timeout)
+{
+  static const int64_t MAX_POP_TIMEOUT_US = 100 * 1000;
+  int64_t timeout = 0;
+  while (!has_set_stop() && (timeout = abs_timeout - ObTimeUtility::current_time()) > 0) {
+    void* ptr = NULL;
+    if (OB_SUCCESS == msg_queue_.pop(ptr, std::min(timeout, MAX_POP_TIMEOUT_US)) && NULL != ptr) {
+      ObDeadLockMsg* msg = static_cast<ObDeadLockMsg*>(ptr);
+      if (GCONF._enable_deadlock_detect) {
+        (void)process_msg(*msg);
+      }
+      OB_DELETE(ObDeadLockMsg, ObModIds::OB_DEADLOCK_CHECKER, msg);
+    }
+  }
+}
+
+bool ObDeadLockChecker::is_younger(const ObTransID& left, const ObTransID& right)
+{
+  return left.get_timestamp() > right.get_timestamp() ||
+         (left.get_timestamp() == right.get_timestamp() && left.compare(right) > 0);
+}
+
+int ObDeadLockChecker::collect_local_edges(LocalEdgeArray& edges)
+{
+  int ret = OB_SUCCESS;
+  struct LockWait {
+    uint32_t holder_ctx_desc_;
+    ObDeadLockEdge edge_;
+  };
+  ObSEArray<LockWait, 16> lock_waits;
+  ObLockWaitMgr& lock_wait_mgr = get_global_lock_wait_mgr();
+  const int64_t max_lock_ts = ObTimeUtility::current_time() - GCONF._deadlock_detect_interval;
+  {
+    CriticalGuard(lock_wait_mgr.get_qs());
+    ObLockWaitMgr::Node* iter = NULL;
+    while (OB_SUCC(ret) && lock_waits.count() < MAX_EDGE_COUNT &&
+           NULL != (iter = lock_wait_mgr.hash_.quick_next(iter))) {
+      // short waits are not worth checking, most of them end soon
+      if (0 != iter->ctx_desc_ && 0 != iter->holder_ctx_desc_ && iter->ctx_desc_ != iter->holder_ctx_desc_ &&
+          iter->lock_ts_ < max_lock_ts) {
+        LockWait lock_wait;
+        lock_wait.holder_ctx_desc_ = iter->holder_ctx_desc_;
+        lock_wait.edge_.waiter_ctx_desc_ = iter->ctx_desc_;
+        lock_wait.edge_.sessid_ = iter->sessid_;
+        lock_wait.edge_.table_id_ = iter->table_id_;
+        lock_wait.edge_.lock_ts_ = iter->lock_ts_;
+        lock_wait.edge_.set_row_key(iter->key_);
+        if (OB_FAIL(lock_waits.push_back(lock_wait))) {
+          TRANS_LOG(WARN, "push back lock wait failed", K(ret));
+        }
+      }
+    }
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < lock_waits.count(); ++i) {
+    ObDeadLockEdge& edge = lock_waits.at(i).edge_;
+    edge.reporter_ = self_addr_;
+    if (OB_SUCCESS != get_trans_id(edge.waiter_ctx_desc_, edge.waiter_) ||
+        OB_SUCCESS != get_trans_id(lock_waits.at(i).holder_ctx_desc_, edge.holder_)) {
+      // the transaction has ended, so has the wait
+    } else if (!edge.is_valid() || edge.waiter_ == edge.holder_) {
+      // skip
+    } else if (OB_FAIL(edges.push_back(edge))) {
+      TRANS_LOG(WARN, "push back edge failed", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObDeadLockChecker::get_trans_id(const uint32_t ctx_desc, ObTransID& trans_id)
+{
+  int ret = OB_SUCCESS;
+  MemtableIDMap* id_map = get_global_lock_wait_mgr().mt_id_map_;
+  ObIMemtableCtx* mt_ctx = NULL;
+  ObTransCtx* trans_ctx = NULL;
+  if (OB_ISNULL(id_map)) {
+    ret = OB_NOT_INIT;
+  } else if (OB_ISNULL(mt_ctx = id_map->fetch(ctx_desc))) {
+    ret = OB_ENTRY_NOT_EXIST;
+  } else {
+    if (OB_ISNULL(trans_ctx = mt_ctx->get_trans_ctx())) {
+      ret = OB_ENTRY_NOT_EXIST;
+    } else {
+      trans_id = trans_ctx->get_trans_id();
+    }
+    id_map->revert(ctx_desc);
+  }
+  return ret;
+}
+
+int ObDeadLockChecker::report_edges(LocalEdgeArray& edges)
+{
+  int ret = OB_SUCCESS;
+  ObDeadLockMsg msg;
+  msg.msg_type_ = DEADLOCK_MSG_EDGE_REPORT;
+  if (edges.count() > 1) {
+    std::sort(&edges.at(0), &edges.at(0) + edges.count(), [](const ObDeadLockEdge& left, const ObDeadLockEdge& right) {
+      return left.waiter_.get_server() < right.waiter_.get_server();
+    });
+  }
+  // edges of the waiters scheduled by the same server are reported in batches
+  for (int64_t i = 0; OB_SUCC(ret) && i < edges.count(); ++i) {
+    const ObAddr& server = edges.at(i).waiter_.get_server();
+    if (OB_FAIL(msg.edges_.push_back(edges.at(i)))) {
+      TRANS_LOG(WARN, "push back edge failed", K(ret));
+    } else if (i + 1 == edges.count() || msg.edges_.count() >= ObDeadLockMsg::MAX_EDGE_COUNT ||
+               edges.at(i + 1).waiter_.get_server() != server) {
+      (void)post_msg(server, msg);
+      msg.edges_.reuse();
+    }
+  }
+  return ret;
+}
+
+void ObDeadLockChecker::expire_edges(const int64_t cur_ts)
+{
+  int64_t count = 0;
+  for (int64_t i = 0; i < edges_.count(); ++i) {
+    if (edges_.at(i).expire_ts_ > cur_ts) {
+      if (count != i) {
+        edges_.at(count) = edges_.at(i);
+      }
+      ++count;
+    }
+  }
+  if (count < edges_.count()) {
+    while (edges_.count() > count) {
+      edges_.pop_back();
+    }
+    rebuild_edge_index();
+  }
+}
+
+int ObDeadLockChecker::send_probes()
+{
+  int ret = OB_SUCCESS;
+  ObDeadLockMsg msg;
+  msg.msg_type_ = DEADLOCK_MSG_PROBE;
+  for (int64_t i = 0; OB_SUCC(ret) && i < edges_.count(); ++i) {
+    const ObDeadLockEdge& edge = edges_.at(i).edge_;
+    // a cycle is only chased by its youngest transaction
+    if (is_younger(edge.waiter_, edge.holder_)) {
+      msg.edges_.reuse();
+      if (OB_FAIL(msg.edges_.push_back(edge))) {
+        TRANS_LOG(WARN, "push back edge failed", K(ret));
+      } else {
+        (void)post_msg(edge.holder_.get_server(), msg);
+      }
+    }
+  }
+  return ret;
+}
+
+int ObDeadLockChecker::process_msg(const ObDeadLockMsg& msg)
+{
+  int ret = OB_SUCCESS;
+  switch (msg.msg_type_) {
+    case DEADLOCK_MSG_EDGE_REPORT:
+      ret = handle_edge_report(msg);
+      break;
+    case DEADLOCK_MSG_PROBE:
+      ret = handle_probe(msg);
+      break;
+    case DEADLOCK_MSG_CYCLE:
+      ret = handle_cycle(msg);
+      break;
+    case DEADLOCK_MSG_KILL:
+      ret = handle_kill(msg);
+      break;
+    default:
+      ret = OB_ERR_UNEXPECTED;
+      TRANS_LOG(WARN, "unknown deadlock msg type", K(ret), K(msg));
+      break;
+  }
+  if (OB_FAIL(ret)) {
+    TRANS_LOG(WARN, "process deadlock msg failed", K(ret), K(msg));
+  }
+  return ret;
+}
+
+int ObDeadLockChecker::handle_edge_report(const ObDeadLockMsg& msg)
+{
+  int ret = OB_SUCCESS;
+  const int64_t expire_ts = ObTimeUtility::current_time() + EDGE_EXPIRE_ROUND * GCONF._deadlock_detect_interval;
+  for (int64_t i = 0; OB_SUCC(ret) && i < msg.edges_.count(); ++i) {
+    if (OB_FAIL(add_edge(msg.edges_.at(i), expire_ts))) {
+      TRANS_LOG(WARN, "add edge failed", K(ret), "edge", msg.edges_.at(i));
+    }
+  }
+  return ret;
+}
+
+int ObDeadLockChecker::handle_probe(const ObDeadLockMsg& msg)
+{
+  int ret = OB_SUCCESS;
+  const ObTransID& initiator = msg.edges_.at(0).waiter_;
+  const ObTransID& target = msg.edges_.at(msg.edges_.count() - 1).holder_;
+  ObDeadLockMsg next_msg;
+  int64_t idx = -1;
+  if (OB_FAIL(get_first_edge(target, idx))) {
+    TRANS_LOG(WARN, "get first edge failed", K(ret), K(target));
+  }
+  for (; OB_SUCC(ret) && idx >= 0; idx = edges_.at(idx).next_) {
+    const ObDeadLockEdge& edge = edges_.at(idx).edge_;
+    bool on_path = false;
+    for (int64_t j = 0; !on_path && j < msg.edges_.count(); ++j) {
+      on_path = (msg.edges_.at(j).waiter_ == edge.holder_);
+    }
+    if (edge.holder_ == initiator) {
+      // the probe comes back, the initiator is the youngest transaction of the cycle
+      if (OB_FAIL(next_msg.assign(msg))) {
+        TRANS_LOG(WARN, "assign msg failed", K(ret));
+      } else if (OB_FAIL(next_msg.edges_.push_back(edge))) {
+        TRANS_LOG(WARN, "push back edge failed", K(ret));
+      } else {
+        next_msg.msg_type_ = DEADLOCK_MSG_CYCLE;
+        TRANS_LOG(INFO, "deadlock detected", "victim", initiator, "cycle", next_msg.edges_);
+        (void)post_msg(initiator.get_server(), next_msg);
+      }
+    } else if (on_path || !is_younger(initiator, edge.holder_) ||
+               msg.edges_.count() >= ObDeadLockMsg::MAX_EDGE_COUNT) {
+      // a cycle not passing the initiator is chased by its own youngest transaction
+    } else if (OB_FAIL(next_msg.assign(msg))) {
+      TRANS_LOG(WARN, "assign msg failed", K(ret));
+    } else if (OB_FAIL(next_msg.edges_.push_back(edge))) {
+      TRANS_LOG(WARN, "push back edge failed", K(ret));
+    } else {
+      (void)post_msg(edge.holder_.get_server(), next_msg);
+    }
+  }
+  return ret;
+}
+
+int ObDeadLockChecker::handle_cycle(const ObDeadLockMsg& msg)
+{
+  int ret = OB_SUCCESS;
+  const ObTransID& victim = msg.edges_.at(0).waiter_;
+  ObDeadLockMsg kill_msg;
+  kill_msg.msg_type_ = DEADLOCK_MSG_KILL;
+  int64_t idx = -1;
+  if (OB_FAIL(get_first_edge(victim, idx))) {
+    TRANS_LOG(WARN, "get first edge failed", K(ret), K(victim));
+  } else if (idx >= 0) {
+    for (; OB_SUCC(ret) && idx >= 0; idx = edges_.at(idx).next_) {
+      kill_msg.edges_.reuse();
+      if (OB_FAIL(kill_msg.edges_.push_back(edges_.at(idx).edge_))) {
+        TRANS_LOG(WARN, "push back edge failed", K(ret));
+      } else {
+        (void)post_msg(edges_.at(idx).edge_.reporter_, kill_msg);
+      }
+    }
+    if (OB_SUCC(ret)) {
+      // the out edges of the victim are dropped, so the cycle is handled once even if it is found again before
+      // the victim wakes up
+      int64_t count = 0;
+      for (int64_t i = 0; i < edges_.count(); ++i) {
+        if (edges_.at(i).edge_.waiter_ != victim) {
+          if (count != i) {
+            edges_.at(count) = edges_.at(i);
+          }
+          ++count;
+        }
+      }
+      while (edges_.count() > count) {
+        edges_.pop_back();
+      }
+      rebuild_edge_index();
+      record_cycle(msg);
+    }
+  }
+  return ret;
+}
+
+int ObDeadLockChecker::handle_kill(const ObDeadLockMsg& msg)
+{
+  int ret = OB_SUCCESS;
+  for (int64_t i = 0; OB_SUCC(ret) && i < msg.edges_.count(); ++i) {
+    const ObDeadLockEdge& edge = msg.edges_.at(i);
+    ObTransID trans_id;
+    if (OB_SUCCESS != get_trans_id(edge.waiter_ctx_desc_, trans_id) || trans_id != edge.waiter_) {
+      // the victim has ended
+    } else if (OB_FAIL(get_global_lock_wait_mgr().abort_deadlock_victim(edge.waiter_ctx_desc_, edge.waiter_))) {
+      TRANS_LOG(WARN, "abort deadlock victim failed", K(ret), K(edge));
+    } else {
+      TRANS_LOG(INFO, "abort deadlock victim", K(edge));
+    }
+  }
+  return ret;
+}
+
+int ObDeadLockChecker::add_edge(const ObDeadLockEdge& edge, const int64_t expire_ts)
+{
+  int ret = OB_SUCCESS;
+  bool found = false;
+  int64_t head = -1;
+  if (OB_FAIL(get_first_edge(edge.waiter_, head))) {
+    TRANS_LOG(WARN, "get first edge failed", K(ret), K(edge));
+  }
+  for (int64_t i = head; OB_SUCC(ret) && !found && i >= 0; i = edges_.at(i).next_) {
+    if (edges_.at(i).edge_.is_same(edge)) {
+      edges_.at(i).edge_ = edge;
+      edges_.at(i).expire_ts_ = expire_ts;
+      found = true;
+    }
+  }
+  if (OB_SUCC(ret) && !found) {
+    EdgeItem item;
+    item.edge_ = edge;
+    item.expire_ts_ = expire_ts;
+    item.next_ = head;
+    const int overwrite = 1;
+    if (OB_UNLIKELY(edges_.count() >= MAX_EDGE_COUNT)) {
+      ret = OB_SIZE_OVERFLOW;
+    } else if (OB_FAIL(edges_.push_back(item))) {
+      TRANS_LOG(WARN, "push back edge failed", K(ret));
+    } else if (OB_FAIL(edge_index_.set_refactored(edge.waiter_, edges_.count() - 1, overwrite))) {
+      TRANS_LOG(WARN, "set edge index failed", K(ret), K(edge));
+      edges_.pop_back();
+    }
+  }
+  return ret;
+}
+
+int ObDeadLockChecker::get_first_edge(const ObTransID& waiter, int64_t& idx) const
+{
+  int ret = OB_SUCCESS;
+  idx = -1;
+  if (OB_FAIL(edge_index_.get_refactored(waiter, idx))) {
+    if (OB_HASH_NOT_EXIST == ret) {
+      idx = -1;
+      ret = OB_SUCCESS;
+    }
+  }
+  return ret;
+}
+
+void ObDeadLockChecker::rebuild_edge_index()
+{
+  int ret = OB_SUCCESS;
+  const int overwrite = 1;
+  if (OB_FAIL(edge_index_.reuse())) {
+    TRANS_LOG(WARN, "reuse edge index failed", K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < edges_.count(); ++i) {
+    EdgeItem& item = edges_.at(i);
+    if (OB_FAIL(get_first_edge(item.edge_.waiter_, item.next_))) {
+      TRANS_LOG(WARN, "get first edge failed", K(ret), K(item));
+    } else if (OB_FAIL(edge_index_.set_refactored(item.edge_.waiter_, i, overwrite))) {
+      TRANS_LOG(WARN, "set edge index failed", K(ret), K(item));
+    }
+  }
+  if (OB_FAIL(ret)) {
+    // the edges are reported again in the following rounds
+    reset_edges();
+  }
+}
+
+void ObDeadLockChecker::reset_edges()
+{
+  edges_.reset();
+  (void)edge_index_.reuse();
+}
+
+void ObDeadLockChecker::record_cycle(const ObDeadLockMsg& msg)
+{
+  ObSpinLockGuard guard(history_lock_);
+  ObDeadLockCycle& cycle = history_[cycle_count_ % HISTORY_CYCLE_COUNT];
+  cycle.cycle_id_ = cycle_count_;
+  cycle.detect_ts_ = ObTimeUtility::current_time();
+  cycle.edge_count_ = std::min(msg.edges_.count(), ObDeadLockMsg::MAX_EDGE_COUNT);
+  for (int64_t i = 0; i < cycle.edge_count_; ++i) {
+    cycle.edges_[i] = msg.edges_.at(i);
+  }
+  ++cycle_count_;
+}
+
+int ObDeadLockChecker::post_msg(const ObAddr& server, const ObDeadLockMsg& msg)
+{
+  int ret = OB_SUCCESS;
+  const ObPartitionKey unused_pkey;
+  if (server == self_addr_) {
+    ret = push_msg(msg);
+  } else if (OB_FAIL(batch_rpc_->post(OB_SERVER_TENANT_ID,
+                 server,
+                 obrpc::ObRpcNetHandler::CLUSTER_ID,
+                 obrpc::DEADLOCK_BATCH_REQ,
+                 static_cast<uint32_t>(msg.msg_type_),
+                 unused_pkey,
+                 msg))) {
+    TRANS_LOG(WARN, "post deadlock msg failed", K(ret), K(server), K(msg));
+  }
+  return ret;
+}
+
+int ObDeadLockChecker::push_msg(const ObDeadLockMsg& msg)
+{
+  int ret = OB_SUCCESS;
+  ObDeadLockMsg* copy = NULL;
+  if (OB_ISNULL(copy = OB_NEW(ObDeadLockMsg, ObModIds::OB_DEADLOCK_CHECKER))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    TRANS_LOG(WARN, "alloc deadlock msg failed", K(ret));
+  } else if (OB_FAIL(copy->assign(msg))) {
+    TRANS_LOG(WARN, "assign deadlock msg failed", K(ret));
+  } else if (OB_FAIL(msg_queue_.push(copy))) {
+    TRANS_LOG(WARN, "push deadlock msg failed", K(ret));
+  }
+  if (OB_FAIL(ret) && NULL != copy) {
+    OB_DELETE(ObDeadLockMsg, ObModIds::OB_DEADLOCK_CHECKER, copy);
+  }
+  return ret;
+}
+
+void ObDeadLockChecker::clear_queued_msgs()
+{
+  void* ptr = NULL;
+  while (msg_queue_.size() > 0 && OB_SUCCESS == msg_queue_.pop(ptr) && NULL != ptr) {
+    ObDeadLockMsg* msg = static_cast<ObDeadLockMsg*>(ptr);
+    OB_DELETE(ObDeadLockMsg, ObModIds::OB_DEADLOCK_CHECKER, msg);
+  }
+}
+
+}  // end namespace memtable
+}  // end namespace oceanbase
@@ -0,0 +1,228 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_MEMTABLE_OB_DEADLOCK_CHECKER_H_
+#define OCEANBASE_MEMTABLE_OB_DEADLOCK_CHECKER_H_
+
+#include "lib/container/ob_se_array.h"
+#include "lib/hash/ob_hashmap.h"
+#include "lib/lock/ob_spin_lock.h"
+#include "lib/net/ob_addr.h"
+#include "lib/queue/ob_lighty_queue.h"
+#include "share/ob_thread_pool.h"
+#include "share/rpc/ob_batch_proxy.h"
+#include "storage/transaction/ob_trans_define.h"
+
+namespace oceanbase {
+namespace obrpc {
+class ObBatchRpc;
+}
+namespace memtable {
+
+// Transaction %waiter_ waits for a lock held by transaction %holder_, the wait is found by the lock wait mgr of
+// server %reporter_ where the waiter has ctx descriptor %waiter_ctx_desc_.
+struct ObDeadLockEdge {
+  OB_UNIS_VERSION(1);
+
+public:
+  static const int64_t ROW_KEY_SIZE = 128;
+  ObDeadLockEdge()
+  {
+    reset();
+  }
+  void reset();
+  bool is_valid() const
+  {
+    return waiter_.is_valid() && holder_.is_valid() && reporter_.is_valid();
+  }
+  bool is_same(const ObDeadLockEdge& other) const
+  {
+    return waiter_ == other.waiter_ && holder_ == other.holder_ && reporter_ == other.reporter_;
+  }
+  void set_row_key(const char* row_key);
+  TO_STRING_KV(K_(waiter), K_(holder), K_(reporter), K_(waiter_ctx_desc), K_(sessid), K_(table_id), K_(lock_ts),
+      K_(row_key));
+
+  transaction::ObTransID waiter_;
+  transaction::ObTransID holder_;
+  common::ObAddr reporter_;
+  uint32_t waiter_ctx_desc_;
+  uint32_t sessid_;
+  uint64_t table_id_;
+  int64_t lock_ts_;
+  char row_key_[ROW_KEY_SIZE];
+};
+
+enum ObDeadLockMsgType {
+  // edges reported to the scheduler server of their waiters
+  DEADLOCK_MSG_EDGE_REPORT = 0,
+  // a path of edges sent to the scheduler server of the holder of its last edge
+  DEADLOCK_MSG_PROBE = 1,
+  // a cycle sent to the scheduler server of its victim
+  DEADLOCK_MSG_CYCLE = 2,
+  // an edge of the victim sent to its reporter to wake up the waiting victim
+  DEADLOCK_MSG_KILL = 3,
+  DEADLOCK_MSG_TYPE_COUNT
+};
+
+struct ObDeadLockMsg : public obrpc::ObIFill {
+  OB_UNIS_VERSION(1);
+
+public:
+  static const int64_t MAX_EDGE_COUNT = 16;
+  typedef common::ObSEArray<ObDeadLockEdge, MAX_EDGE_COUNT> EdgeArray;
+  ObDeadLockMsg() : msg_type_(DEADLOCK_MSG_TYPE_COUNT), edges_()
+  {}
+  ~ObDeadLockMsg()
+  {}
+  void reset()
+  {
+    msg_type_ = DEADLOCK_MSG_TYPE_COUNT;
+    edges_.reset();
+  }
+  int assign(const ObDeadLockMsg& other);
+  bool is_valid() const
+  {
+    return msg_type_ >= 0 && msg_type_ < DEADLOCK_MSG_TYPE_COUNT && edges_.count() > 0;
+  }
+  virtual int fill_buffer(char* buf, int64_t size, int64_t& filled_size) const
+  {
+    filled_size = 0;
+    return serialize(buf, size, filled_size);
+  }
+  virtual int64_t get_req_size() const
+  {
+    return get_serialize_size();
+  }
+  TO_STRING_KV(K_(msg_type), K_(edges));
+
+  int64_t msg_type_;
+  EdgeArray edges_;
+};
+
+// A deadlock found, the victim is the waiter of the first edge.
+struct ObDeadLockCycle {
+  ObDeadLockCycle() : cycle_id_(0), detect_ts_(0), edge_count_(0)
+  {}
+  TO_STRING_KV(K_(cycle_id), K_(detect_ts), K_(edge_count));
+
+  int64_t cycle_id_;
+  int64_t detect_ts_;
+  int64_t edge_count_;
+  ObDeadLockEdge edges_[ObDeadLockMsg::MAX_EDGE_COUNT];
+};
+
+// Distributed deadlock detection over the wait-for graph of transactions.
+//
+// Every _deadlock_detect_interval, the lock waits of the local lock wait mgr lasting more than the interval are
+// reported as edges to the scheduler servers of their waiters, so all the out edges of a transaction are known
+// by its scheduler server. Edges not reported again are expired after a few rounds.
+//
+// Cycles are found by edge chasing. Transactions are ordered by their start time, a younger transaction has a
+// higher priority. For an edge whose waiter is younger than its holder, a probe with the edge is sent to the
+// scheduler server of the holder, which extends the probe with the out edges of the holder and forwards it to the
+// scheduler servers of their holders, as long as the holders are older than the initiator of the probe. A probe
+// coming back to its initiator finds a cycle, the initiator is the youngest transaction in the cycle and chosen as
+// the victim, so a cycle is found by one probe path only and exactly one transaction of it is rolled back.
+//
+// The cycle is sent to the scheduler server of the victim, which drops the out edges of the victim, records the
+// cycle for __all_virtual_deadlock_stat and sends the edges to their reporters. The lock wait mgr of a reporter
+// marks the victim and wakes up its waiting requests, which fail with OB_DEAD_LOCK on the next lock conflict and
+// roll back the statement.
+class ObDeadLockChecker : public share::ObThreadPool {
+public:
+  static const int64_t HISTORY_CYCLE_COUNT = 64;
+  // rounds an edge is kept without being reported again
+  static const int64_t EDGE_EXPIRE_ROUND = 3;
+  static const int64_t MAX_EDGE_COUNT = 16 * 1024;
+  static const int64_t MSG_QUEUE_SIZE = 16 * 1024;
+
+public:
+  ObDeadLockChecker();
+  ~ObDeadLockChecker();
+  int init(const common::ObAddr& self_addr, obrpc::ObBatchRpc* batch_rpc);
+  void destroy();
+  void run1();
+  void wait()
+  {
+    share::ObThreadPool::wait();
+  }
+  // deadlock messages from other servers, processed by the checker thread
+  int handle_msg(const int64_t msg_type, const char* buf, const int64_t size);
+  // ids of the cycles kept in history are in [%start_id, %end_id)
+  void get_cycle_id_range(int64_t& start_id, int64_t& end_id);
+  // OB_ENTRY_NOT_EXIST if the cycle has been overwritten
+  int get_cycle(const int64_t cycle_id, ObDeadLockCycle& cycle);
+  // check the local lock waits and send probes, called by the checker thread every round
+  int check_round();
+  // process the queued messages until %abs_timeout
+  void handle_queued_msgs(const int64_t abs_timeout);
+
+private:
+  struct EdgeItem {
+    EdgeItem() : edge_(), expire_ts_(0), next_(-1)
+    {}
+    TO_STRING_KV(K_(edge), K_(expire_ts), K_(next));
+    ObDeadLockEdge edge_;
+    int64_t expire_ts_;
+    // index of the next out edge of the same waiter in %edges_, -1 for the last one
+    int64_t next_;
+  };
+  typedef common::ObSEArray<ObDeadLockEdge, 64> LocalEdgeArray;
+  // waiter -> index of its first out edge in %edges_
+  typedef common::hash::ObHashMap<transaction::ObTransID, int64_t, common::hash::NoPthreadDefendMode> EdgeIndex;
+  static bool is_younger(const transaction::ObTransID& left, const transaction::ObTransID& right);
+  int collect_local_edges(LocalEdgeArray& edges);
+  int get_trans_id(const uint32_t ctx_desc, transaction::ObTransID& trans_id);
+  int report_edges(LocalEdgeArray& edges);
+  void expire_edges(const int64_t cur_ts);
+  int send_probes();
+  int process_msg(const ObDeadLockMsg& msg);
+  int handle_edge_report(const ObDeadLockMsg& msg);
+  int handle_probe(const ObDeadLockMsg& msg);
+  int handle_cycle(const ObDeadLockMsg& msg);
+  int handle_kill(const ObDeadLockMsg& msg);
+  int add_edge(const ObDeadLockEdge& edge, const int64_t expire_ts);
+  // %idx is -1 if %waiter has no out edge
+  int get_first_edge(const transaction::ObTransID& waiter, int64_t& idx) const;
+  // called after edges are removed from %edges_, the edges are dropped if the index can not be rebuilt
+  void rebuild_edge_index();
+  void reset_edges();
+  void record_cycle(const ObDeadLockMsg& msg);
+  int post_msg(const common::ObAddr& server, const ObDeadLockMsg& msg);
+  int push_msg(const ObDeadLockMsg& msg);
+  void clear_queued_msgs();
+
+private:
+  bool is_inited_;
+  common::ObAddr self_addr_;
+  obrpc::ObBatchRpc* batch_rpc_;
+  common::ObLightyQueue msg_queue_;
+  // out edges of the transactions scheduled by this server, only accessed by the checker thread
+  common::ObSEArray<EdgeItem, 64> edges_;
+  EdgeIndex edge_index_;
+  common::ObSpinLock history_lock_;
+  int64_t cycle_count_;
+  ObDeadLockCycle history_[HISTORY_CYCLE_COUNT];
+  DISALLOW_COPY_AND_ASSIGN(ObDeadLockChecker);
+};
+
+inline ObDeadLockChecker& get_global_deadlock_checker()
+{
+  static ObDeadLockChecker deadlock_checker;
+  return deadlock_checker;
+}
+
+}  // end namespace memtable
+}  // end namespace oceanbase
+
+#endif  // OCEANBASE_MEMTABLE_OB_DEADLOCK_CHECKER_H_
@@ -50,9 +50,11 @@ static inline uint64_t hash_trans(const uint32_t ctx_desc)
   return (murmurhash(&ctx_desc, sizeof(ctx_desc), 0) | TRANS_MARK) | 1;
 }
 
-ObLockWaitMgr::ObLockWaitMgr() : is_inited_(false), hash_(hash_buf_, sizeof(hash_buf_)), mt_id_map_(NULL)
+ObLockWaitMgr::ObLockWaitMgr()
+    : is_inited_(false), hash_(hash_buf_, sizeof(hash_buf_)), victim_lock_(), victim_count_(0), mt_id_map_(NULL)
 {
   memset(sequence_, 0, sizeof(sequence_));
+  memset(hot_row_stats_, 0, sizeof(hot_row_stats_));
 }
 
 ObLockWaitMgr::~ObLockWaitMgr()
@@ -403,6 +405,10 @@ int ObLockWaitMgr::post_lock(int tmp_ret, ObRowLock& lock, const Key& key, int64
   int ret = OB_SUCCESS;
   Node* node = get_thread_node();
 
+  if (OB_TRY_LOCK_ROW_CONFLICT == tmp_ret) {
+    on_row_lock_conflict(hash_rowkey(key));
+  }
+
   if (node != nullptr) {
     uint64_t& hold_key = get_thread_hold_key();
     if (hold_key == hash_rowkey(key)) {
@@ -426,6 +432,7 @@ int ObLockWaitMgr::post_lock(int tmp_ret, ObRowLock& lock, const Key& key, int64
             total_trans_node_cnt,
             to_cstring(key),
             ctx_desc);
+        node->set_holder_ctx_desc(lock.get_exclusive_uid());
 
         if (lock.is_locked()) {
           node->set_need_wait();
@@ -467,6 +474,7 @@ int ObLockWaitMgr::post_lock(int tmp_ret, const ObIMvccCtx& ctx, const uint64_t
 
       node->set(
           (void*)node, hash_trx, get_seq(hash_trx), timeout, table_id, total_trans_node_cnt, to_cstring(key), ctx_desc);
+      node->set_holder_ctx_desc(owner_desc);
 
       if (!ctx.is_rowlocks_released()) {
         node->set_need_wait();
@@ -490,6 +498,7 @@ int ObLockWaitMgr::delegate_waiting_querys_to_trx(const Key& key, const ObIMvccC
   Node* node = NULL;
   while (NULL != (node = fetch_waiter(hash_row))) {
     node->change_hash(hash_trx, lock_seq);
+    node->set_holder_ctx_desc(ctx_desc);
 
     if (!wait(node)) {
       repost(node);
@@ -512,6 +521,133 @@ void ObLockWaitMgr::wakeup(const uint32_t ctx_desc)
   wakeup(hash_trans(ctx_desc));
 }
 
+void ObLockWaitMgr::on_row_lock_conflict(const Key& key)
+{
+  on_row_lock_conflict(hash_rowkey(key));
+}
+
+void ObLockWaitMgr::on_row_lock_conflict(uint64_t hash)
+{
+  HotRowStat& stat = hot_row_stats_[(hash >> 1) % LOCK_BUCKET_COUNT];
+  const int64_t cur_ts = ObClockGenerator::getClock();
+  const int64_t window_start_ts = ATOMIC_LOAD(&stat.window_start_ts_);
+  if (cur_ts - window_start_ts < HOT_ROW_WINDOW_US) {
+    ATOMIC_INC(&stat.conflict_count_);
+  } else if (ATOMIC_BCAS(&stat.window_start_ts_, window_start_ts, cur_ts)) {
+    // the statistics are only a hint, conflicts counted by others while switching the window may be lost
+    const int64_t conflict_count = ATOMIC_LOAD(&stat.conflict_count_);
+    ATOMIC_STORE(&stat.last_conflict_count_, cur_ts - window_start_ts < 2 * HOT_ROW_WINDOW_US ? conflict_count : 0);
+    ATOMIC_STORE(&stat.conflict_count_, 1);
+  } else {
+    ATOMIC_INC(&stat.conflict_count_);
+  }
+}
+
+bool ObLockWaitMgr::is_hot_row(const Key& key)
+{
+  bool bool_ret = false;
+  const int64_t threshold = GCONF._hot_row_conflict_threshold;
+  if (threshold > 0) {
+    const HotRowStat& stat = hot_row_stats_[(hash_rowkey(key) >> 1) % LOCK_BUCKET_COUNT];
+    const int64_t elapsed_time = ObClockGenerator::getClock() - ATOMIC_LOAD(&stat.window_start_ts_);
+    if (elapsed_time < HOT_ROW_WINDOW_US) {
+      bool_ret =
+          ATOMIC_LOAD(&stat.conflict_count_) >= threshold || ATOMIC_LOAD(&stat.last_conflict_count_) >= threshold;
+    } else if (elapsed_time < 2 * HOT_ROW_WINDOW_US) {
+      bool_ret = ATOMIC_LOAD(&stat.conflict_count_) >= threshold;
+    } else {
+      // no conflict recently
+    }
+  }
+  return bool_ret;
+}
+
+int ObLockWaitMgr::abort_deadlock_victim(const uint32_t ctx_desc, const ObTransID& trans_id)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    TRANS_LOG(WARN, "lock wait mgr not inited", K(ret));
+  } else if (OB_UNLIKELY(0 == ctx_desc || !trans_id.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    TRANS_LOG(WARN, "invalid argument", K(ret), K(ctx_desc), K(trans_id));
+  } else {
+    const int64_t cur_ts = ObClockGenerator::getClock();
+    {
+      ObSpinLockGuard guard(victim_lock_);
+      int64_t pos = -1;
+      for (int64_t i = 0; i < victim_count_ && pos < 0; ++i) {
+        if (victims_[i].ctx_desc_ == ctx_desc || victims_[i].expire_ts_ < cur_ts) {
+          pos = i;
+        }
+      }
+      if (pos < 0) {
+        if (victim_count_ < MAX_DEADLOCK_VICTIM_COUNT) {
+          pos = victim_count_;
+          ATOMIC_STORE(&victim_count_, victim_count_ + 1);
+        } else {
+          ret = OB_SIZE_OVERFLOW;
+          TRANS_LOG(WARN, "too many deadlock victims", K(ret), K(ctx_desc), K(trans_id));
+        }
+      }
+      if (OB_SUCC(ret)) {
+        victims_[pos].ctx_desc_ = ctx_desc;
+        victims_[pos].trans_id_ = trans_id;
+        victims_[pos].expire_ts_ = cur_ts + DEADLOCK_VICTIM_EXPIRE_US;
+      }
+    }
+    if (OB_SUCC(ret)) {
+      ObLink* tail = NULL;
+      Node* iter = NULL;
+      Node* node2del = NULL;
+      {
+        CriticalGuard(get_qs());
+        while (NULL != (iter = hash_.quick_next(iter))) {
+          if (NULL != node2del) {
+            retire_node(tail, node2del);
+            node2del = NULL;
+          }
+          if (iter->ctx_desc_ == ctx_desc) {
+            node2del = iter;
+          }
+        }
+        if (NULL != node2del) {
+          retire_node(tail, node2del);
+        }
+      }
+      if (NULL != tail) {
+        WaitQuiescent(get_qs());
+      }
+      while (NULL != tail) {
+        Node* cur = CONTAINER_OF(tail, Node, retire_link_);
+        tail = tail->next_;
+        TRANS_LOG(INFO, "LOCK_MGR: wake up deadlock victim", K(*cur));
+        (void)repost(cur);
+      }
+    }
+  }
+  return ret;
+}
+
+bool ObLockWaitMgr::is_deadlock_victim(const uint32_t ctx_desc, const ObTransID& trans_id)
+{
+  bool bool_ret = false;
+  if (0 != ATOMIC_LOAD(&victim_count_)) {
+    const int64_t cur_ts = ObClockGenerator::getClock();
+    ObSpinLockGuard guard(victim_lock_);
+    for (int64_t i = victim_count_ - 1; i >= 0; --i) {
+      if (victims_[i].ctx_desc_ == ctx_desc || victims_[i].expire_ts_ < cur_ts) {
+        // a mark left for an ended transaction is dropped without failing the new one on the descriptor
+        bool_ret = bool_ret || (victims_[i].ctx_desc_ == ctx_desc && victims_[i].trans_id_ == trans_id &&
+                                   victims_[i].expire_ts_ >= cur_ts);
+        victims_[i] = victims_[victim_count_ - 1];
+        ATOMIC_STORE(&victim_count_, victim_count_ - 1);
+      }
+    }
+  }
+  return bool_ret;
+}
+
 int ObLockWaitMgr::fullfill_row_key(uint64_t hash, char* row_key, int64_t length)
 {
   int ret = OB_SUCCESS;
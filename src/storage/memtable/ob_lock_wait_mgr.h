@@ -15,6 +15,7 @@
 
 #include "lib/allocator/ob_mod_define.h"
 #include "lib/allocator/ob_qsync.h"
+#include "lib/lock/ob_spin_lock.h"
 #include "lib/oblog/ob_log_module.h"
 #include "lib/stat/ob_diagnose_info.h"
 #include "mvcc/ob_row_lock.h"
@@ -38,6 +39,11 @@ public:
 
 public:
   enum { LOCK_BUCKET_COUNT = 65536 };
+  // lock conflicts of a row are counted in windows of this length to detect hot rows
+  static const int64_t HOT_ROW_WINDOW_US = 100 * 1000;
+  static const int64_t MAX_DEADLOCK_VICTIM_COUNT = 64;
+  // a victim not running into lock conflicts again within this time is forgotten
+  static const int64_t DEADLOCK_VICTIM_EXPIRE_US = 1000 * 1000;
   typedef ObMemtableKey Key;
   typedef rpc::ObLockWaitNode Node;
   typedef FixedHash2<Node> Hash;
@@ -84,6 +90,16 @@ public:
   void wakeup(const Key& key);
   // wakeup the request waiting on the transaction
   void wakeup(const uint32_t ctx_desc);
+  // count a lock conflict on the row for hot row detection
+  void on_row_lock_conflict(const Key& key);
+  // whether the row has more than _hot_row_conflict_threshold lock conflicts in the current or last window,
+  // rows of the same bucket share the statistics
+  bool is_hot_row(const Key& key);
+  // mark the transaction as a deadlock victim and wake up its waiting requests
+  int abort_deadlock_victim(const uint32_t ctx_desc, const transaction::ObTransID& trans_id);
+  // whether the transaction is marked as a deadlock victim, the mark is cleared once checked, so only the statement
+  // which is waiting is rolled back
+  bool is_deadlock_victim(const uint32_t ctx_desc, const transaction::ObTransID& trans_id);
 
 protected:
   // obtain the request waiting on the row or transaction
@@ -148,10 +164,30 @@ private:
     return ATOMIC_LOAD(&sequence_[(hash >> 1) % LOCK_BUCKET_COUNT]);
   }
 
+private:
+  struct HotRowStat {
+    int64_t window_start_ts_;
+    int64_t conflict_count_;
+    int64_t last_conflict_count_;
+  };
+  void on_row_lock_conflict(uint64_t hash);
+  // the ctx descriptor is reused once the transaction ends, the victim is identified by the trans id
+  struct DeadLockVictim {
+    DeadLockVictim() : ctx_desc_(0), trans_id_(), expire_ts_(0)
+    {}
+    uint32_t ctx_desc_;
+    transaction::ObTransID trans_id_;
+    int64_t expire_ts_;
+  };
+
 private:
   bool is_inited_;
   Hash hash_;
   int64_t sequence_[LOCK_BUCKET_COUNT];
+  HotRowStat hot_row_stats_[LOCK_BUCKET_COUNT];
+  common::ObSpinLock victim_lock_;
+  int64_t victim_count_;
+  DeadLockVictim victims_[MAX_DEADLOCK_VICTIM_COUNT];
   char hash_buf_[sizeof(SpHashNode) * LOCK_BUCKET_COUNT];
 
 public:
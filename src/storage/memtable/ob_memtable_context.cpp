@@ -1132,6 +1132,25 @@ const char* ObMemtableCtx::log_conflict_ctx(const uint32_t descriptor)
   return ret;
 }
 
+bool ObMemtableCtx::is_lock_holder_visible(const uint32_t descriptor)
+{
+  bool bool_ret = false;
+  ObIMemtableCtx* ctx = NULL;
+  if (NULL == ctx_map_) {
+  } else if (0 == descriptor || UID_FOR_PURGE == descriptor || descriptor == get_ctx_descriptor()) {
+  } else if (NULL == (ctx = ctx_map_->fetch(descriptor))) {
+  } else {
+    // 0 means the prepare version is being generated
+    const int64_t prepare_version = ctx->get_trans_version();
+    bool_ret = prepare_version > 0 && prepare_version <= get_read_snapshot();
+  }
+  if (NULL != ctx) {
+    ctx_map_->revert(descriptor);
+    ctx = NULL;
+  }
+  return bool_ret;
+}
+
 int ObMemtableCtx::stmt_data_relocate(const int data_relocate_type, ObMemtable* memstore, bool& relocated)
 {
   int ret = OB_SUCCESS;
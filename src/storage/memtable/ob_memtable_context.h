@@ -307,6 +307,7 @@ public:
   virtual void inc_lock_for_read_retry_count() override;
   virtual int row_compact(ObMvccRow* value, const int64_t snapshot_version) override;
   virtual const char* log_conflict_ctx(const uint32_t descriptor) override;
+  virtual bool is_lock_holder_visible(const uint32_t descriptor) override;
   virtual int read_lock_yield() override;
   virtual int write_lock_yield() override;
 
@@ -31,6 +31,7 @@ int ObRow2ExprsProjector::init(
     // first traverse, treat MapConvert::start_ as count
     for (int64_t i = 0; i < exprs.count(); i++) {
       sql::ObExpr* e = exprs.at(i);
+      has_batch_result_ = has_batch_result_ || e->batch_result_;
       // output should always be T_COLUMN_REF, only virtual column has argument.
       if (e->arg_cnt_ > 0) {
         has_virtual_ = true;
@@ -58,6 +59,10 @@ int ObRow2ExprsProjector::init(
     if (OB_FAIL(outputs_.prepare_allocate(exprs.count()))) {
       LOG_WARN("array prepare allocate failed", K(ret));
     } else {
+      // locate the first row of batch result expression
+      sql::ObEvalCtx::BatchInfoScopeGuard batch_info_guard(eval_ctx);
+      batch_info_guard.set_batch_idx(0);
+      eval_ctx_ = &eval_ctx;
       int64_t other_end = other_idx_;
       // second traverse, setup MapConvert::end_ && outputs_
       for (int64_t i = 0; i < exprs.count(); i++) {
@@ -82,8 +87,10 @@ int ObRow2ExprsProjector::init(
         item.obj_idx_ = obj_idx;
         item.expr_idx_ = i;
         item.datum_ = &e->locate_datum_for_write(eval_ctx);
-        item.eval_info_ = &e->get_eval_info(eval_ctx);
+        item.eval_info_ = e->batch_result_ ? NULL : &e->get_eval_info(eval_ctx);
         item.data_ = item.datum_->ptr_;
+        item.batch_idx_mask_ = e->batch_idx_mask_;
+        item.data_step_ = e->res_buf_stride_;
       }
     }
   }
@@ -95,32 +102,74 @@ int ObRow2ExprsProjector::project(
 {
   // performance critical, no parameter validity check.
   int ret = OB_SUCCESS;
-  num_.project(outputs_.get_data(), cells, nop_pos, nop_cnt);
-  str_.project(outputs_.get_data(), cells, nop_pos, nop_cnt);
-  int_.project(outputs_.get_data(), cells, nop_pos, nop_cnt);
+  const int64_t batch_idx = eval_ctx_->get_batch_idx();
+  num_.project(outputs_.get_data(), cells, batch_idx, nop_pos, nop_cnt);
+  str_.project(outputs_.get_data(), cells, batch_idx, nop_pos, nop_cnt);
+  int_.project(outputs_.get_data(), cells, batch_idx, nop_pos, nop_cnt);
 
   for (int64_t i = other_idx_; OB_SUCC(ret) && i < outputs_.count(); i++) {
     const Item& item = outputs_.at(i);
     const ObObj* cell = NULL;
+    ObDatum* datum = item.locate_datum(batch_idx);
     if (OB_UNLIKELY(item.obj_idx_ < 0 || (cell = &cells[item.obj_idx_])->is_nop_value()) || (cell->is_urowid())) {
       // need to calc urowid col every time. otherwise may get old value.
       nop_pos[nop_cnt++] = item.expr_idx_;
     } else if (OB_UNLIKELY(cell->is_null())) {
-      item.datum_->set_null();
-      item.eval_info_->evaluated_ = true;
+      datum->set_null();
+      if (NULL != item.eval_info_) {
+        item.eval_info_->evaluated_ = true;
+      }
     } else {
-      if (OB_UNLIKELY(item.datum_->ptr_ != item.data_)) {
-        item.datum_->ptr_ = item.data_;
+      const char* data = item.locate_data(batch_idx);
+      if (OB_UNLIKELY(datum->ptr_ != data)) {
+        datum->ptr_ = data;
       }
-      if (OB_FAIL(item.datum_->from_obj(*cell, exprs.at(item.expr_idx_)->obj_datum_map_))) {
+      if (OB_FAIL(datum->from_obj(*cell, exprs.at(item.expr_idx_)->obj_datum_map_))) {
         LOG_WARN("convert obj to datum failed");
-      } else {
+      } else if (NULL != item.eval_info_) {
         // the other items may contain virtual columns, set evaluated flag.
+        // (virtual column of batch result expression is evaluated again, evaluated flag of
+        // batch result is for the whole batch)
         item.eval_info_->evaluated_ = true;
       }
     }
   }
+  if (OB_SUCC(ret) && has_batch_result_) {
+    if (OB_FAIL(deep_copy_batch_strings(exprs, cells, batch_idx))) {
+      LOG_WARN("deep copy batch strings failed", K(ret), K(batch_idx));
+    }
+  }
+
+  return ret;
+}
 
+// Only the items of string group and the other items (e.g.: virtual column) may reference storage memory.
+int ObRow2ExprsProjector::deep_copy_batch_strings(
+    const sql::ObExprPtrIArray& exprs, const common::ObObj* cells, const int64_t batch_idx)
+{
+  int ret = OB_SUCCESS;
+  const int64_t ranges[][2] = {{str_.start_, str_.end_}, {other_idx_, outputs_.count()}};
+  for (int64_t r = 0; OB_SUCC(ret) && r < ARRAYSIZEOF(ranges); r++) {
+    for (int64_t i = ranges[r][0]; OB_SUCC(ret) && i < ranges[r][1]; i++) {
+      const Item& item = outputs_.at(i);
+      const sql::ObExpr* e = exprs.at(item.expr_idx_);
+      ObDatum* datum = item.locate_datum(batch_idx);
+      if (0 == item.batch_idx_mask_ || common::OBJ_DATUM_STRING != e->obj_datum_map_ || item.obj_idx_ < 0 ||
+          cells[item.obj_idx_].is_nop_value() || cells[item.obj_idx_].is_urowid() || datum->null_ ||
+          0 == datum->len_) {
+        // not projected from storage (calculated later)
+      } else {
+        char* buf = e->get_str_res_mem(*eval_ctx_, datum->len_);
+        if (OB_ISNULL(buf)) {
+          ret = OB_ALLOCATE_MEMORY_FAILED;
+          LOG_WARN("allocate memory failed", K(ret), K(datum->len_));
+        } else {
+          MEMMOVE(buf, datum->ptr_, datum->len_);
+          datum->ptr_ = buf;
+        }
+      }
+    }
+  }
   return ret;
 }
 
@@ -182,7 +231,7 @@ DEF_TO_STRING(ObRow2ExprsProjector::Item)
 {
   int64_t pos = 0;
   J_OBJ_START();
-  J_KV(K(obj_idx_), K(expr_idx_), K(datum_), K(eval_info_), K(data_));
+  J_KV(K(obj_idx_), K(expr_idx_), K(datum_), K(eval_info_), K(data_), K(batch_idx_mask_), K(data_step_));
   J_OBJ_END();
   return pos;
 }
@@ -46,11 +46,17 @@ class ObIPartitionGroupGuard;
 // We introduce ObRow2ExprsProjector for optimization:
 // 1. Save datum pointer of expression, locate datum once for each expression.
 // 2. Project number, string, integer (OBJ_DATUM_8BYTE_DATA) by groups, to reduce type detection.
+//
+// For vectorized execution, row is projected to the datum of current batch index
+// (ObEvalCtx::batch_idx_) of the batch result expression. The strings of batch rows are copied
+// to the result memory of the row, since the storage memory they point to is reused by the following rows.
 class ObRow2ExprsProjector {
 public:
   explicit ObRow2ExprsProjector(common::ObIAllocator& alloc)
       : other_idx_(0),
         has_virtual_(false),
+        has_batch_result_(false),
+        eval_ctx_(NULL),
         outputs_(common::OB_MALLOC_NORMAL_BLOCK_SIZE, common::ModulePageAllocator(alloc))
   {}
   ~ObRow2ExprsProjector()
@@ -75,11 +81,25 @@ private:
   struct Item {
     int32_t obj_idx_;
     int32_t expr_idx_;
+    // datum and reserved buffer of the first row for batch result expression.
     sql::ObDatum* datum_;
+    // NULL for batch result expression, evaluated flag not set in projection.
     sql::ObEvalInfo* eval_info_;
     const char* data_;
+    // copy of ObExpr::batch_idx_mask_ and ObExpr::res_buf_stride_
+    uint64_t batch_idx_mask_;
+    uint32_t data_step_;
 
     Item() = default;
+
+    OB_INLINE sql::ObDatum* locate_datum(const int64_t batch_idx) const
+    {
+      return datum_ + (batch_idx & batch_idx_mask_);
+    }
+    OB_INLINE const char* locate_data(const int64_t batch_idx) const
+    {
+      return data_ + (batch_idx & batch_idx_mask_) * data_step_;
+    }
     DECLARE_TO_STRING;
   };
 
@@ -92,23 +112,26 @@ private:
     MapConvert() : start_(0), end_(0)
     {}
 
-    OB_INLINE void project(const Item* items, const common::ObObj* cells, int16_t* nop_pos, int64_t& nop_cnt) const
+    OB_INLINE void project(const Item* items, const common::ObObj* cells, const int64_t batch_idx, int16_t* nop_pos,
+        int64_t& nop_cnt) const
     {
       // performance critical, no parameter validity check.
       for (int32_t i = start_; i < end_; i++) {
         const Item& item = items[i];
         const common::ObObj& cell = cells[item.obj_idx_];
+        sql::ObDatum* datum = item.locate_datum(batch_idx);
         if (OB_UNLIKELY(cell.is_nop_value())) {
           nop_pos[nop_cnt++] = item.expr_idx_;
         } else if (OB_UNLIKELY(cell.is_null())) {
-          item.datum_->set_null();
+          datum->set_null();
         } else {
           if (NEED_RESET_PTR) {
-            if (OB_UNLIKELY(item.datum_->ptr_ != item.data_)) {
-              item.datum_->ptr_ = item.data_;
+            const char* data = item.locate_data(batch_idx);
+            if (OB_UNLIKELY(datum->ptr_ != data)) {
+              datum->ptr_ = data;
             }
           }
-          item.datum_->obj2datum<OBJ_DATUM_MAP_TYPE>(cell);
+          datum->obj2datum<OBJ_DATUM_MAP_TYPE>(cell);
         }
       }
     }
@@ -117,8 +140,12 @@ private:
   MapConvert<common::OBJ_DATUM_NUMBER, true> num_;
   MapConvert<common::OBJ_DATUM_STRING, false> str_;
   MapConvert<common::OBJ_DATUM_8BYTE_DATA, true> int_;
+  int deep_copy_batch_strings(const sql::ObExprPtrIArray& exprs, const common::ObObj* cells, const int64_t batch_idx);
+
   int32_t other_idx_;
-  bool has_virtual_;  // has virtual column
+  bool has_virtual_;       // has virtual column
+  bool has_batch_result_;  // has batch result expression
+  sql::ObEvalCtx* eval_ctx_;
   common::ObSEArray<Item, 4> outputs_;
 };
 
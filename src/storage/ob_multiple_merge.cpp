@@ -17,6 +17,7 @@
 #include "common/object/ob_obj_compare.h"
 #include "storage/ob_multiple_merge.h"
 #include "storage/memtable/ob_memtable_context.h"
+#include "storage/memtable/ob_memtable.h"
 #include "storage/ob_store_row_filter.h"
 #include "storage/ob_partition_store.h"
 #include "storage/ob_partition_service.h"
@@ -927,9 +928,40 @@ int ObMultipleMerge::prepare_read_tables()
       }
     }
   }
+  if (OB_SUCC(ret)) {
+    access_ctx_->enable_pushdown_filter_ = can_pushdown_filter();
+  }
   return ret;
 }
 
+// Rows of major sstable can be skipped by the pushdown filter before fuse only if there is
+// no incremental data, otherwise a newer version in memtable or minor sstable may need to fuse
+// with the skipped row. Memtable is empty means no data visible to the read snapshot,
+// rows written later are committed after the snapshot.
+bool ObMultipleMerge::can_pushdown_filter() const
+{
+  bool bret = false;
+  if (nullptr != access_param_->iter_param_.pushdown_filter_) {
+    const ObIArray<ObITable*>& tables = tables_handle_.get_tables();
+    int64_t major_cnt = 0;
+    bret = true;
+    for (int64_t i = 0; bret && i < tables.count(); ++i) {
+      const ObITable* table = tables.at(i);
+      if (OB_ISNULL(table)) {
+        bret = false;
+      } else if (table->is_major_sstable()) {
+        bret = 0 == major_cnt++;
+      } else if (table->is_memtable()) {
+        bret = 0 == static_cast<const memtable::ObMemtable*>(table)->get_btree_item_count();
+      } else {
+        bret = false;
+      }
+    }
+    bret = bret && 1 == major_cnt;
+  }
+  return bret;
+}
+
 int ObMultipleMerge::refresh_table_on_demand()
 {
   int ret = OB_SUCCESS;
@@ -195,48 +195,68 @@ int ObParallelMergeCtx::init_parallel_mini_merge(ObSSTableMergeCtx& merge_ctx)
     STORAGE_LOG(WARN, "Invalid argument to init parallel mini minor merge", K(ret), K(merge_ctx));
   } else {
     const int64_t tablet_size = merge_ctx.table_schema_->get_tablet_size();
-    memtable::ObMemtable* memtable = nullptr;
-    if (OB_FAIL(merge_ctx.tables_handle_.get_first_memtable(memtable))) {
-      STORAGE_LOG(WARN, "failed to get first memtable", K(ret), "merge tables", merge_ctx.tables_handle_);
-    } else {
-      int64_t total_bytes = 0;
-      int64_t total_rows = 0;
-      if (OB_FAIL(memtable->estimate_phy_size(
-              merge_ctx.table_schema_->get_table_id(), nullptr, nullptr, total_bytes, total_rows))) {
-        STORAGE_LOG(WARN, "Failed to get estimate size from memtable", K(ret));
+    const uint64_t table_id = merge_ctx.table_schema_->get_table_id();
+    ObSEArray<memtable::ObMemtable*, MAX_MEMSTORE_CNT_IN_STORAGE> memtables;
+    // the memtable with the most data of the table, whose keys are sampled to split the ranges
+    memtable::ObMemtable* split_memtable = nullptr;
+    int64_t split_memtable_bytes = 0;
+    int64_t total_bytes = 0;
+    if (OB_FAIL(merge_ctx.tables_handle_.get_all_memtables(memtables))) {
+      STORAGE_LOG(WARN, "failed to get all memtables", K(ret), "merge tables", merge_ctx.tables_handle_);
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < memtables.count(); i++) {
+      int64_t memtable_bytes = 0;
+      int64_t memtable_rows = 0;
+      if (OB_ISNULL(memtables.at(i))) {
+        ret = OB_ERR_UNEXPECTED;
+        STORAGE_LOG(WARN, "Unexpected null memtable", K(ret), K(i), "merge tables", merge_ctx.tables_handle_);
+      } else if (OB_FAIL(memtables.at(i)->estimate_phy_size(
+                     table_id, nullptr, nullptr, memtable_bytes, memtable_rows))) {
+        STORAGE_LOG(WARN, "Failed to get estimate size from memtable", K(ret), K(i));
       } else {
-        int64_t mini_merge_thread = GCONF._mini_merge_concurrency;
-        ObArray<ObStoreRange> store_ranges;
-        mini_merge_thread = MAX(mini_merge_thread, PARALLEL_MERGE_TARGET_TASK_CNT);
-        concurrent_cnt_ = MIN((total_bytes + tablet_size - 1) / tablet_size, mini_merge_thread);
-        if (concurrent_cnt_ <= 1) {
+        total_bytes += memtable_bytes;
+        if (nullptr == split_memtable || memtable_bytes > split_memtable_bytes) {
+          split_memtable = memtables.at(i);
+          split_memtable_bytes = memtable_bytes;
+        }
+      }
+    }
+    if (OB_SUCC(ret)) {
+      ObArray<ObStoreRange> store_ranges;
+      if (OB_FAIL(calc_mini_parallel_degree(tablet_size, total_bytes, concurrent_cnt_))) {
+        STORAGE_LOG(WARN, "Failed to calc mini parallel degree", K(ret), K(tablet_size), K(total_bytes));
+      } else if (nullptr == split_memtable || concurrent_cnt_ <= 1) {
+        if (OB_FAIL(init_serial_merge())) {
+          STORAGE_LOG(WARN, "Failed to init serialize merge", K(ret));
+        }
+      } else if (OB_FAIL(get_memtable_split_ranges(*split_memtable, table_id, concurrent_cnt_, store_ranges))) {
+        if (OB_ENTRY_NOT_EXIST == ret) {
           if (OB_FAIL(init_serial_merge())) {
             STORAGE_LOG(WARN, "Failed to init serialize merge", K(ret));
           }
-        } else if (OB_FAIL(memtable->get_split_ranges(
-                       merge_ctx.table_schema_->get_table_id(), nullptr, nullptr, concurrent_cnt_, store_ranges))) {
-          if (OB_ENTRY_NOT_EXIST == ret) {
-            if (OB_FAIL(init_serial_merge())) {
-              STORAGE_LOG(WARN, "Failed to init serialize merge", K(ret));
-            }
-          } else {
-            STORAGE_LOG(WARN, "Failed to get split ranges from memtable", K(ret));
-          }
-        } else if (OB_UNLIKELY(store_ranges.count() != concurrent_cnt_)) {
-          ret = OB_ERR_UNEXPECTED;
-          STORAGE_LOG(WARN, "Unexpected range array and concurrent_cnt", K(ret), K_(concurrent_cnt), K(store_ranges));
         } else {
-          for (int64_t i = 0; OB_SUCC(ret) && i < store_ranges.count(); i++) {
-            ObExtStoreRange ext_range(store_ranges.at(i));
-            if (OB_FAIL(ext_range.to_collation_free_range_on_demand_and_cutoff_range(allocator_))) {
-              STORAGE_LOG(WARN, "Failed to transform and cut off range", K(ret));
-            } else if (OB_FAIL(range_array_.push_back(ext_range))) {
-              STORAGE_LOG(WARN, "Failed to push back merge range to array", K(ret), K(ext_range));
-            }
+          STORAGE_LOG(WARN, "Failed to get split ranges from memtable", K(ret));
+        }
+      } else if (OB_UNLIKELY(store_ranges.count() != concurrent_cnt_)) {
+        ret = OB_ERR_UNEXPECTED;
+        STORAGE_LOG(WARN, "Unexpected range array and concurrent_cnt", K(ret), K_(concurrent_cnt), K(store_ranges));
+      } else {
+        for (int64_t i = 0; OB_SUCC(ret) && i < store_ranges.count(); i++) {
+          ObExtStoreRange ext_range(store_ranges.at(i));
+          if (OB_FAIL(ext_range.to_collation_free_range_on_demand_and_cutoff_range(allocator_))) {
+            STORAGE_LOG(WARN, "Failed to transform and cut off range", K(ret));
+          } else if (OB_FAIL(range_array_.push_back(ext_range))) {
+            STORAGE_LOG(WARN, "Failed to push back merge range to array", K(ret), K(ext_range));
           }
-          parallel_type_ = PARALLEL_MINI;
-          STORAGE_LOG(INFO, "Succ to get parallel mini merge ranges", K_(concurrent_cnt), K_(range_array));
         }
+        parallel_type_ = PARALLEL_MINI;
+        STORAGE_LOG(INFO,
+            "Succ to get parallel mini merge ranges",
+            K_(concurrent_cnt),
+            K(total_bytes),
+            "memtable_count",
+            memtables.count(),
+            K_(range_array));
       }
     }
   }
@@ -244,6 +264,24 @@ int ObParallelMergeCtx::init_parallel_mini_merge(ObSSTableMergeCtx& merge_ctx)
   return ret;
 }
 
+int ObParallelMergeCtx::calc_mini_parallel_degree(
+    const int64_t tablet_size, const int64_t total_size, int64_t& parallel_degree)
+{
+  int ret = OB_SUCCESS;
+
+  if (OB_UNLIKELY(tablet_size <= 0 || total_size < 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "Invalid argument to calc mini parallel degree", K(ret), K(tablet_size), K(total_size));
+  } else {
+    // all frozen memtables are merged together, so the degree follows the total size of them
+    int64_t mini_merge_thread = GCONF._mini_merge_concurrency;
+    parallel_degree =
+        MIN(MAX(mini_merge_thread, PARALLEL_MERGE_TARGET_TASK_CNT), (total_size + tablet_size - 1) / tablet_size);
+  }
+
+  return ret;
+}
+
 int ObParallelMergeCtx::init_parallel_mini_minor_merge(ObSSTableMergeCtx& merge_ctx)
 {
   int ret = OB_SUCCESS;
@@ -317,10 +355,10 @@ int ObParallelMergeCtx::calc_mini_minor_parallel_degree(
         K(total_size),
         K(sstable_count));
   } else {
+    // every row of the input sstables is read and merged, so the degree follows the total size of them
     int64_t minor_merge_thread = GCONF.minor_merge_concurrency;
-    int64_t avg_sstable_size = total_size / sstable_count;
-    parallel_degree = MIN(
-        MAX(minor_merge_thread, PARALLEL_MERGE_TARGET_TASK_CNT), (avg_sstable_size + tablet_size - 1) / tablet_size);
+    parallel_degree =
+        MIN(MAX(minor_merge_thread, PARALLEL_MERGE_TARGET_TASK_CNT), (total_size + tablet_size - 1) / tablet_size);
   }
 
   return ret;
@@ -19,6 +19,9 @@
 #include "common/rowkey/ob_rowkey.h"
 
 namespace oceanbase {
+namespace memtable {
+class ObMemtable;
+}
 namespace storage {
 class ObSSTableMergeCtx;
 
@@ -53,6 +56,12 @@ private:
   int init_parallel_mini_merge(ObSSTableMergeCtx& merge_ctx);
   int init_parallel_mini_minor_merge(ObSSTableMergeCtx& merge_ctx);
   int init_parallel_major_merge(ObSSTableMergeCtx& merge_ctx);
+  // %parallel_degree is decreased to the number of ranges the memtable can be split into,
+  // OB_ENTRY_NOT_EXIST if the memtable can not be split
+  template <typename Memtable>
+  static int get_memtable_split_ranges(Memtable& memtable, const uint64_t table_id, int64_t& parallel_degree,
+      common::ObIArray<common::ObStoreRange>& store_ranges);
+  static int calc_mini_parallel_degree(const int64_t tablet_size, const int64_t total_size, int64_t& parallel_degree);
   int calc_mini_minor_parallel_degree(
       const int64_t tablet_size, const int64_t total_size, const int64_t sstable_count, int64_t& parallel_degree);
 
@@ -65,6 +74,28 @@ private:
   bool is_inited_;
 };
 
+template <typename Memtable>
+int ObParallelMergeCtx::get_memtable_split_ranges(Memtable& memtable, const uint64_t table_id,
+    int64_t& parallel_degree, common::ObIArray<common::ObStoreRange>& store_ranges)
+{
+  int ret = common::OB_ENTRY_NOT_EXIST;
+
+  // keys are sampled on one level of the btree, whose fan out may be less than the parallel degree,
+  // so try less ranges until the memtable can be split
+  while (common::OB_ENTRY_NOT_EXIST == ret && parallel_degree > 1) {
+    store_ranges.reuse();
+    if (OB_FAIL(memtable.get_split_ranges(table_id, nullptr, nullptr, parallel_degree, store_ranges))) {
+      if (common::OB_ENTRY_NOT_EXIST == ret) {
+        parallel_degree /= 2;
+      } else {
+        STORAGE_LOG(WARN, "Failed to get split ranges from memtable", K(ret), K(table_id), K(parallel_degree));
+      }
+    }
+  }
+
+  return ret;
+}
+
 }  // namespace storage
 }  // namespace oceanbase
 #endif  // OB_PARTITION_PARALLEL_MERGE_CTX_H
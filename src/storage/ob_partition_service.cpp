@@ -27,6 +27,7 @@
 #include "lib/stat/ob_diagnose_info.h"
 #include "lib/utility/ob_tracepoint.h"
 #include "lib/thread/thread_mgr.h"
+#include "memtable/ob_deadlock_checker.h"
 #include "memtable/ob_lock_wait_mgr.h"
 #include "ob_table_mgr.h"
 #include "ob_warm_up_request.h"
@@ -408,6 +409,11 @@ int ObPartitionService::init(const blocksstable::ObStorageEnv& env, const ObAddr
                  env.bf_cache_priority_,
                  env.bf_cache_miss_count_threshold_))) {
     STORAGE_LOG(WARN, "Fail to init OB_STORE_CACHE, ", K(ret), K(env.data_dir_));
+  } else if (OB_FAIL(OB_STORE_CACHE.init_secondary_block_cache(
+                 env.secondary_block_cache_file_, env.secondary_block_cache_size_))) {
+    STORAGE_LOG(WARN, "Fail to init secondary block cache, ", K(ret), K(env.secondary_block_cache_file_));
+  } else if (OB_FAIL(OB_STORE_CACHE.init_block_cache_snapshot(env.block_cache_snapshot_file_))) {
+    STORAGE_LOG(WARN, "Fail to init block cache snapshot, ", K(ret), K(env.block_cache_snapshot_file_));
   } else if (OB_FAIL(ObStoreFileSystemWrapper::init(env, *this))) {
     STORAGE_LOG(WARN, "init store file system failed.", K(ret), K(env));
   } else if (OB_FAIL(OB_SERVER_FILE_MGR.init())) {
@@ -432,6 +438,8 @@ int ObPartitionService::init(const blocksstable::ObStorageEnv& env, const ObAddr
     STORAGE_LOG(WARN, "create transaction service failed", K(ret));
   } else if (OB_FAIL(memtable::get_global_lock_wait_mgr().init())) {
     STORAGE_LOG(WARN, "create lock wait mgr failed", K(ret));
+  } else if (OB_FAIL(memtable::get_global_deadlock_checker().init(self_addr, batch_rpc))) {
+    STORAGE_LOG(WARN, "create deadlock checker failed", K(ret));
   } else if (NULL == (clog_mgr_ = cp_fty->get_clog_mgr())) {
     ret = OB_ALLOCATE_MEMORY_FAILED;
     STORAGE_LOG(ERROR, "create clog manager object failed.", K(ret));
@@ -888,6 +896,8 @@ int ObPartitionService::start()
     STORAGE_LOG(ERROR, "fail to start transaction service", K(ret));
   } else if (OB_FAIL(memtable::get_global_lock_wait_mgr().start())) {
     STORAGE_LOG(WARN, "lock_wait_mgr start fail", K(ret));
+  } else if (OB_FAIL(memtable::get_global_deadlock_checker().start())) {
+    STORAGE_LOG(WARN, "deadlock_checker start fail", K(ret));
   } else if (OB_FAIL(election_mgr_->start())) {
     STORAGE_LOG(ERROR, "election_mgr start all fail", K(ret));
   } else if (OB_FAIL(FILE_MANAGER_INSTANCE_V2.start())) {
@@ -1016,6 +1026,7 @@ int ObPartitionService::stop()
     } else {
       STORAGE_LOG(ERROR, "null ptr");
     }
+    memtable::get_global_deadlock_checker().stop();
     memtable::get_global_lock_wait_mgr().stop();
     if (txs_) {
       txs_->stop();
@@ -1080,6 +1091,7 @@ int ObPartitionService::wait()
   }
   TG_WAIT(lib::TGDefIDs::Blacklist);
   TG_WAIT(lib::TGDefIDs::BRPC);
+  memtable::get_global_deadlock_checker().wait();
   memtable::get_global_lock_wait_mgr().wait();
   TG_WAIT(lib::TGDefIDs::PartSerMigRetryQt);
   TG_WAIT(lib::TGDefIDs::PartSerCb);
@@ -15,6 +15,7 @@
 #include "lib/stat/ob_session_stat.h"
 #include "share/ob_errno.h"
 #include "share/ob_tenant_mgr.h"
+#include "share/config/ob_server_config.h"
 #include "share/allocator/ob_tenant_mutil_allocator.h"
 #include "share/allocator/ob_tenant_mutil_allocator_mgr.h"
 #include "storage/ob_partition_service.h"
@@ -325,6 +326,8 @@ ObReplayStatus::ObReplayStatus()
       offline_partition_log_id_(OB_INVALID_ID),
       offline_partition_task_submitted_(false),
       rp_eg_(NULL),
+      task_queues_(NULL),
+      task_queue_count_(0),
       submit_log_info_rwlock_(),
       allocator_(NULL),
       last_replay_log_id_(common::OB_INVALID_ID)
@@ -341,6 +344,7 @@ void ObReplayStatus::destroy()
   timeguard.click();
   WLockGuard wlock_guard(get_rwlock());
   reset();
+  free_task_queues_();
   timeguard.click();
 }
 
@@ -357,10 +361,12 @@ int ObReplayStatus::init(const uint64_t tenant_id, replayengine::ObILogReplayEng
     REPLAY_LOG(WARN, "allocator_ is NULL", K(ret), K(tenant_id), KP(allocator_));
   } else if (OB_FAIL(submit_log_task_.init(this))) {
     REPLAY_LOG(WARN, "failed to init submit_log_task", K(ret));
+  } else if (NULL == task_queues_ && OB_FAIL(alloc_task_queues_())) {
+    REPLAY_LOG(WARN, "failed to alloc task queues", K(ret), K(tenant_id));
   } else {
     rp_eg_ = rp_eg;
     safe_ref_ = safe_ref;
-    for (int64_t i = 0; OB_SUCC(ret) && i < REPLAY_TASK_QUEUE_SIZE; ++i) {
+    for (int64_t i = 0; OB_SUCC(ret) && i < task_queue_count_; ++i) {
       if (OB_FAIL(task_queues_[i].init(this, i))) {
         REPLAY_LOG(WARN, "failed to init task_queue", K(ret));
       }
@@ -404,11 +410,51 @@ void ObReplayStatus::reset()
     allocator_ = NULL;
   }
 
-  for (int64_t i = 0; i < REPLAY_TASK_QUEUE_SIZE; ++i) {
+  for (int64_t i = 0; i < task_queue_count_; ++i) {
     task_queues_[i].reset();
   }
 }
 
+int64_t ObReplayStatus::get_server_task_queue_count()
+{
+  // fixed for the process lifetime, the replay engine queue is preallocated for the queues of all
+  // partitions and must never overflow
+  static const int64_t queue_count =
+      min(max(static_cast<int64_t>(GCONF._replay_task_queue_count), 1L), MAX_REPLAY_TASK_QUEUE_SIZE);
+  return queue_count;
+}
+
+int ObReplayStatus::alloc_task_queues_()
+{
+  int ret = OB_SUCCESS;
+  const int64_t queue_count = get_server_task_queue_count();
+  ObMemAttr attr(OB_SERVER_TENANT_ID, "ReplayTaskQueue");
+  void* buf = NULL;
+  if (NULL == (buf = ob_malloc(queue_count * sizeof(ObReplayLogTaskQueue), attr))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    REPLAY_LOG(WARN, "failed to alloc task queues", K(ret), K(queue_count));
+  } else {
+    task_queues_ = static_cast<ObReplayLogTaskQueue*>(buf);
+    for (int64_t i = 0; i < queue_count; ++i) {
+      new (task_queues_ + i) ObReplayLogTaskQueue();
+    }
+    task_queue_count_ = queue_count;
+  }
+  return ret;
+}
+
+void ObReplayStatus::free_task_queues_()
+{
+  if (NULL != task_queues_) {
+    for (int64_t i = 0; i < task_queue_count_; ++i) {
+      task_queues_[i].~ObReplayLogTaskQueue();
+    }
+    ob_free(task_queues_);
+    task_queues_ = NULL;
+    task_queue_count_ = 0;
+  }
+}
+
 // The caller is responsible for locking
 void ObReplayStatus::reuse()
 {
@@ -438,7 +484,7 @@ void ObReplayStatus::reuse()
   if (OB_ISNULL(allocator_)) {
     REPLAY_LOG(ERROR, "allocator_ is NULL");
   }
-  for (int64_t i = 0; i < REPLAY_TASK_QUEUE_SIZE; ++i) {
+  for (int64_t i = 0; i < task_queue_count_; ++i) {
     task_queues_[i].reuse();
   }
 }
@@ -549,7 +595,7 @@ void ObReplayStatus::get_min_unreplay_log(uint64_t& unreplay_log_id, int64_t& ti
     }
   }
 
-  for (int64_t i = 0; i < REPLAY_TASK_QUEUE_SIZE; ++i) {
+  for (int64_t i = 0; i < task_queue_count_; ++i) {
     ObReplayLogTask* replay_task = NULL;
     task_queues_[i].acquire_ref();
     // pop() return OB_EAGAIN only when the queue is empty.
@@ -845,12 +891,11 @@ int ObReplayStatus::push_task(ObReplayLogTask& task, uint64_t task_sign)
 int ObReplayStatus::push_(ObReplayLogTask& task, uint64_t task_sign)
 {
   int ret = OB_SUCCESS;
-  uint64_t queue_idx = task_sign % REPLAY_TASK_QUEUE_SIZE;
-  ObReplayLogTaskQueue& target_queue = task_queues_[queue_idx];
-  if (OB_ISNULL(rp_eg_)) {
+  if (OB_ISNULL(rp_eg_) || OB_ISNULL(task_queues_)) {
     ret = OB_NOT_INIT;
-    REPLAY_LOG(ERROR, "replay engine is NULL", K(task), K(ret));
+    REPLAY_LOG(ERROR, "replay engine or task queues is NULL", K(task), K(ret));
   } else {
+    ObReplayLogTaskQueue& target_queue = task_queues_[task_sign % task_queue_count_];
     target_queue.push(&task);
     if (target_queue.acquire_lease()) {
       /* The thread that gets the lease is responsible for encapsulating the task queue as a request
@@ -1052,7 +1097,7 @@ int ObReplayStatus::set_pending(const int64_t timeout)
 bool ObReplayStatus::need_wait_schema_refresh_() const
 {
   bool need_wait = false;
-  for (int64_t i = 0; !need_wait && i < REPLAY_TASK_QUEUE_SIZE; ++i) {
+  for (int64_t i = 0; !need_wait && i < task_queue_count_; ++i) {
     if (OB_TRANS_WAIT_SCHEMA_REFRESH == task_queues_[i].fail_info_.ret_code_) {
       need_wait = true;
     }
@@ -549,6 +549,13 @@ public:
   {
     return pending_task_count_;
   }
+  int64_t get_task_queue_count() const
+  {
+    return task_queue_count_;
+  }
+  // queue count of the partitions of this server, _replay_task_queue_count at the first call, also
+  // sizes the queue of replay engine threads
+  static int64_t get_server_task_queue_count();
   int64_t get_retried_task_count() const
   {
     return eagain_count_;
@@ -712,7 +719,7 @@ public:
   TO_STRING_KV(K(ref_cnt_), K(replay_err_info_), K(last_task_info_), K(post_barrier_status_), K(pending_task_count_),
       K(pending_abort_task_count_), K(pending_task_mutator_size_), K(eagain_count_), K(eagain_start_ts_),
       K(total_submitted_task_num_), K(total_replayed_task_num_), K(is_enabled_), K(is_pending_), K(can_receive_log_),
-      K(offline_partition_log_id_), K(offline_partition_task_submitted_), K(submit_log_task_));
+      K(offline_partition_log_id_), K(offline_partition_task_submitted_), K(task_queue_count_), K(submit_log_task_));
 
 private:
   int check_barrier_(const ObStorageLogType log_type, const common::ObPartitionKey& pkey);
@@ -731,6 +738,8 @@ private:
 
   int push_(ObReplayLogTask& task, uint64_t task_sign);
   bool is_tenant_out_of_memory_() const;
+  int alloc_task_queues_();
+  void free_task_queues_();
 
 private:
   static const int64_t PENDING_COUNT_THRESHOLD = 100;
@@ -767,7 +776,10 @@ private:
   replayengine::ObILogReplayEngine* rp_eg_;
   // be sure to clear these queues when the partition is offline to prevent old replay task is replayed in situation of
   // migrating out and then migrating in
-  ObReplayLogTaskQueue task_queues_[common::REPLAY_TASK_QUEUE_SIZE];  // queues of replay task
+  // Logs of a transaction always go to the same queue, logs of different transactions are replayed in parallel
+  // over the queues, the count is get_server_task_queue_count().
+  ObReplayLogTaskQueue* task_queues_;  // queues of replay task
+  int64_t task_queue_count_;
 
   RWLock submit_log_info_rwlock_;  // protect submit_log_info
   ObSubmitReplayLogTask submit_log_task_;
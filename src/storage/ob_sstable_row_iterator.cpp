@@ -15,6 +15,7 @@
 #include "share/config/ob_server_config.h"
 #include "lib/stat/ob_diagnose_info.h"
 #include "blocksstable/ob_lob_data_reader.h"
+#include "blocksstable/ob_micro_block_zone_map.h"
 #include "storage/ob_file_system_util.h"
 
 using namespace oceanbase::common;
@@ -158,6 +159,11 @@ int ObSSTableMicroBlockInfoIterator::open(ObSSTableRowIterator* iter, ObSSTableR
       if (OB_BEYOND_THE_RANGE != ret) {
         STORAGE_LOG(WARN, "Fail to search blocks, ", K(ret), K(read_handle));
       }
+    } else if (OB_FAIL(iter->filter_micro_blocks(*handle, micro_block_infos_))) {
+      STORAGE_LOG(WARN, "Fail to filter micro blocks, ", K(ret), K(read_handle));
+    } else if (0 == micro_block_infos_.count()) {
+      // all micro blocks are filtered out, skip the macro block
+      ret = OB_BEYOND_THE_RANGE;
     }
   }
 
@@ -403,6 +409,7 @@ ObSSTableRowIterator::ObSSTableRowIterator()
       table_store_stat_(),
       skip_ctx_(),
       storage_file_(nullptr),
+      is_seq_scan_(false),
       is_opened_(false),
       is_base_(false),
       block_cache_(NULL),
@@ -428,7 +435,10 @@ ObSSTableRowIterator::ObSSTableRowIterator()
       io_micro_infos_(),
       micro_info_iter_(),
       prefetch_handle_depth_(DEFAULT_PREFETCH_HANDLE_DEPTH),
-      prefetch_micro_depth_(DEFAULT_PREFETCH_MICRO_DEPTH)
+      prefetch_micro_depth_(DEFAULT_PREFETCH_MICRO_DEPTH),
+      last_read_micro_ts_(0),
+      avg_consume_us_(0),
+      avg_io_rt_us_(0)
 {}
 
 ObSSTableRowIterator::~ObSSTableRowIterator()
@@ -636,8 +646,12 @@ void ObSSTableRowIterator::reset()
   table_store_stat_.reset();
   skip_ctx_.reset();
   storage_file_ = nullptr;
+  is_seq_scan_ = false;
   prefetch_handle_depth_ = DEFAULT_PREFETCH_HANDLE_DEPTH;
   prefetch_micro_depth_ = DEFAULT_PREFETCH_MICRO_DEPTH;
+  last_read_micro_ts_ = 0;
+  avg_consume_us_ = 0;
+  avg_io_rt_us_ = 0;
 }
 
 void ObSSTableRowIterator::reuse()
@@ -669,8 +683,12 @@ void ObSSTableRowIterator::reuse()
   table_store_stat_.reuse();
   skip_ctx_.reset();
   storage_file_ = nullptr;
+  is_seq_scan_ = false;
   prefetch_handle_depth_ = DEFAULT_PREFETCH_HANDLE_DEPTH;
   prefetch_micro_depth_ = DEFAULT_PREFETCH_MICRO_DEPTH;
+  last_read_micro_ts_ = 0;
+  avg_consume_us_ = 0;
+  avg_io_rt_us_ = 0;
 }
 
 int ObSSTableRowIterator::get_read_handle(const ObExtStoreRowkey& ext_rowkey, ObSSTableReadHandle& read_handle)
@@ -832,7 +850,10 @@ int ObSSTableRowIterator::prefetch()
           0 == prefetching_micro_handle_cnt || 0 == prefetching_micro_cnt) {
         // prefetching micro count is less than free micro count and prefetch micro depth
         prefetch_micro_cnt = std::min(micro_handle_cnt_ - prefetching_micro_cnt, prefetch_micro_depth_);
-        prefetch_micro_depth_ = min(micro_handle_cnt_, prefetch_micro_depth_ * 2);
+        if (!is_seq_scan_ || 0 == avg_io_rt_us_) {
+          // the depth of sequential scans follows the scan speed and io latency once known
+          prefetch_micro_depth_ = min(micro_handle_cnt_, prefetch_micro_depth_ * 2);
+        }
       }
     }
     STORAGE_LOG(DEBUG,
@@ -948,15 +969,16 @@ int ObSSTableRowIterator::prefetch_block(const int64_t sstable_micro_cnt)
   int32_t gap_size = 0;
   int32_t read_size = 0;
   int64_t multiblock_read_gap_size_threshold = GCONF.multiblock_read_gap_size.get_value();
-  int64_t multiblock_read_size_threshold = GCONF.multiblock_read_size.get_value();
-  bool use_multiblock_io = false;
+  int64_t multiblock_read_size_threshold = is_seq_scan_ ? SEQ_SCAN_READ_SIZE : GCONF.multiblock_read_size.get_value();
+  // sequential scans always coalesce the reads of adjacent micro blocks
+  bool use_multiblock_io = is_seq_scan_;
 
   if (sstable_micro_cnt > 0) {
     // sort micro info
     cur_prefetch_micro_pos_ = sstable_micro_infos_[sstable_micro_cnt - 1].micro_idx_ + 1;
     std::sort(
         &sorted_sstable_micro_infos_[0], &sorted_sstable_micro_infos_[sstable_micro_cnt], ObSSTableMicroBlockInfoCmp());
-    for (int64_t i = 0; OB_SUCC(ret) && i < sstable_micro_cnt; ++i) {
+    for (int64_t i = 0; OB_SUCC(ret) && !use_multiblock_io && i < sstable_micro_cnt; ++i) {
       const ObSSTableMicroBlockInfo& sstable_micro = sstable_micro_infos_[i];
       if (last_macro_ctx.get_macro_block_id() == sstable_micro.macro_ctx_.get_macro_block_id()) {
         read_size += sstable_micro.micro_info_.size_ + (sstable_micro.micro_info_.offset_ - prev_offset);
@@ -1177,15 +1199,62 @@ int ObSSTableRowIterator::get_block_data(const int64_t micro_block_idx, ObMicroB
         K(ret),
         K(micro_block_idx),
         K_(cur_prefetch_micro_pos));
-  } else if (OB_FAIL(micro_handles_[micro_block_idx % micro_handle_cnt_].get_block_data(
-                 block_reader_, storage_file_, block_data))) {
-    STORAGE_LOG(WARN, "Fail to get block data, ", K(ret), K(micro_block_idx));
   } else {
-    cur_read_micro_pos_ = micro_block_idx;
+    ObMicroBlockDataHandle& micro_handle = micro_handles_[micro_block_idx % micro_handle_cnt_];
+    if (is_seq_scan_) {
+      update_read_ahead_depth(micro_handle, ObTimeUtility::current_time());
+    }
+    if (OB_FAIL(micro_handle.get_block_data(block_reader_, storage_file_, block_data))) {
+      STORAGE_LOG(WARN, "Fail to get block data, ", K(ret), K(micro_block_idx));
+    } else {
+      cur_read_micro_pos_ = micro_block_idx;
+      if (is_seq_scan_) {
+        last_read_micro_ts_ = ObTimeUtility::current_time();
+      }
+    }
   }
   return ret;
 }
 
+void ObSSTableRowIterator::update_read_ahead_depth(ObMicroBlockDataHandle& micro_handle, const int64_t fetch_begin_ts)
+{
+  if (ObSSTableMicroBlockState::IN_BLOCK_IO == micro_handle.block_state_) {
+    // count a coalesced read once, at its first micro block
+    adapt_read_ahead_depth(
+        fetch_begin_ts, micro_handle.io_handle_.get_io_handle().get_rt(), micro_handle.block_index_ <= 0);
+  } else {
+    adapt_read_ahead_depth(fetch_begin_ts, 0 /*io_rt_us*/, false /*count_io_rt*/);
+  }
+}
+
+void ObSSTableRowIterator::adapt_read_ahead_depth(
+    const int64_t fetch_begin_ts, const int64_t io_rt_us, const bool count_io_rt)
+{
+  // time spent on the rows of the last micro block, not including the wait for its read
+  if (last_read_micro_ts_ > 0 && fetch_begin_ts > last_read_micro_ts_) {
+    const int64_t consume_us = fetch_begin_ts - last_read_micro_ts_;
+    avg_consume_us_ = 0 == avg_consume_us_ ? consume_us : (avg_consume_us_ * 7 + consume_us) / 8;
+  }
+  bool is_waiting = false;
+  if (io_rt_us < 0) {
+    // the read has not finished, the scan is faster than the read ahead
+    is_waiting = true;
+    prefetch_micro_depth_ = min(micro_handle_cnt_, prefetch_micro_depth_ * 2);
+  } else if (count_io_rt) {
+    avg_io_rt_us_ = 0 == avg_io_rt_us_ ? io_rt_us : (avg_io_rt_us_ * 7 + io_rt_us) / 8;
+  }
+  if (!is_waiting && avg_consume_us_ > 0 && avg_io_rt_us_ > 0) {
+    // keep the micro blocks scanned during two reads in flight, shrink slowly as the reads may be bursty
+    const int64_t target_depth = max(static_cast<int64_t>(DEFAULT_PREFETCH_MICRO_DEPTH),
+        min(micro_handle_cnt_, 2 * avg_io_rt_us_ / avg_consume_us_));
+    if (target_depth > prefetch_micro_depth_) {
+      prefetch_micro_depth_ = target_depth;
+    } else if (target_depth < prefetch_micro_depth_) {
+      prefetch_micro_depth_ = max(target_depth, prefetch_micro_depth_ - max(1L, prefetch_micro_depth_ / 8));
+    }
+  }
+}
+
 int ObSSTableRowIterator::exist_block_row(ObSSTableReadHandle& read_handle, ObStoreRow& store_row)
 {
   int ret = OB_SUCCESS;
@@ -1523,6 +1592,46 @@ int ObSSTableRowIterator::get_cur_micro_idx_in_macro(int64_t& micro_idx)
   return ret;
 }
 
+int ObSSTableRowIterator::filter_micro_blocks(ObMicroBlockIndexHandle& handle, ObIArray<ObMicroBlockInfo>& infos)
+{
+  int ret = OB_SUCCESS;
+  const ObMicroBlockIndexMgr* block_idx_mgr = NULL;
+  if (OB_ISNULL(iter_param_) || OB_ISNULL(access_ctx_)) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "unexpected null param", K(ret), KP_(iter_param), KP_(access_ctx));
+  } else if (NULL == iter_param_->pushdown_filter_ || !access_ctx_->enable_pushdown_filter_ || 0 == infos.count()) {
+    // no filter to prune with
+  } else if (OB_FAIL(handle.get_block_index_mgr(block_idx_mgr))) {
+    STORAGE_LOG(WARN, "Fail to get block index mgr", K(ret));
+  } else if (!block_idx_mgr->has_zone_map()) {
+    // macro blocks written without zone map
+  } else {
+    ObMicroBlockZoneMapReader reader;
+    int64_t keep_cnt = 0;
+    if (OB_FAIL(reader.init(block_idx_mgr->get_zone_map_buf(), block_idx_mgr->get_zone_map_size()))) {
+      STORAGE_LOG(WARN, "Fail to init zone map reader", K(ret));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < infos.count(); ++i) {
+      bool can_skip = false;
+      if (OB_FAIL(reader.can_skip(infos.at(i).index_, *iter_param_->pushdown_filter_, can_skip))) {
+        STORAGE_LOG(WARN, "Fail to check zone map", K(ret), K(i), K(infos.at(i)));
+      } else if (!can_skip) {
+        if (keep_cnt != i) {
+          infos.at(keep_cnt) = infos.at(i);
+        }
+        ++keep_cnt;
+      }
+    }
+    if (OB_SUCC(ret) && keep_cnt < infos.count()) {
+      STORAGE_LOG(DEBUG, "micro blocks pruned by zone map", "total_cnt", infos.count(), K(keep_cnt));
+      while (infos.count() > keep_cnt) {
+        infos.pop_back();
+      }
+    }
+  }
+  return ret;
+}
+
 int ObSSTableRowIterator::get_cur_micro_row_count(int64_t& row_count)
 {
   int ret = OB_SUCCESS;
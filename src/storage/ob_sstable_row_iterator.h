@@ -331,6 +331,8 @@ public:
   int get_cur_read_handle(ObSSTableReadHandle*& read_handle);
   int get_cur_micro_idx_in_macro(int64_t& micro_idx);
   int check_row_locked(ObSSTableReadHandle& read_handle, ObStoreRowLockState& lock_state);
+  // remove the micro blocks in which no row can pass the pushdown filter according to their zone maps
+  int filter_micro_blocks(ObMicroBlockIndexHandle& handle, common::ObIArray<blocksstable::ObMicroBlockInfo>& infos);
   virtual OB_INLINE bool is_base_sstable_iter() const override
   {
     return is_base_;
@@ -369,12 +371,18 @@ private:
   int init_handle_mgr(const ObTableIterParam& iter_param, ObTableAccessContext& access_ctx, const void* query_range);
   int set_row_scn(const ObStoreRow*& store_row);
   int check_block_row_lock(ObSSTableReadHandle& read_handle, ObStoreRowLockState& lock_state);
+  void update_read_ahead_depth(ObMicroBlockDataHandle& micro_handle, const int64_t fetch_begin_ts);
+  // %io_rt_us is negative if the read of the micro block has not finished, %count_io_rt is false if the micro
+  // block is not read from disk or the read is already counted
+  void adapt_read_ahead_depth(const int64_t fetch_begin_ts, const int64_t io_rt_us, const bool count_io_rt);
 
 protected:
   static const int64_t USE_HANDLE_CACHE_RANGE_COUNT_THRESHOLD = 300;
   static const int64_t LIMIT_PREFETCH_BLOCK_CACHE_THRESHOLD = 100;
   static const int64_t DEFAULT_PREFETCH_HANDLE_DEPTH = 4;
   static const int64_t DEFAULT_PREFETCH_MICRO_DEPTH = 4;
+  // max size of a coalesced read of sequential scans, the micro blocks of a read are in one macro block
+  static const int64_t SEQ_SCAN_READ_SIZE = common::OB_DEFAULT_MACRO_BLOCK_SIZE;
   const ObTableIterParam* iter_param_;
   ObTableAccessContext* access_ctx_;
   ObSSTable* sstable_;
@@ -394,6 +402,8 @@ protected:
   ObTableStoreStat table_store_stat_;
   ObSSTableSkipRangeCtx skip_ctx_;
   blocksstable::ObStorageFile* storage_file_;
+  // set by long range scans before open, micro blocks are read ahead with an adaptive depth
+  bool is_seq_scan_;
 
 private:
   bool is_opened_;
@@ -423,6 +433,10 @@ private:
   ObSSTableMicroBlockInfoIterator micro_info_iter_;
   int64_t prefetch_handle_depth_;
   int64_t prefetch_micro_depth_;
+  // statistics of sequential scans to adapt prefetch_micro_depth_
+  int64_t last_read_micro_ts_;
+  int64_t avg_consume_us_;
+  int64_t avg_io_rt_us_;
 };
 
 }  // namespace storage
@@ -41,6 +41,12 @@ void ObSSTableRowMultiScanner::reuse()
   orig_ranges_ = NULL;
 }
 
+int ObSSTableRowMultiScanner::inner_open(
+    const ObTableIterParam& iter_param, ObTableAccessContext& access_ctx, ObITable* table, const void* query_range)
+{
+  return ObSSTableRowIterator::inner_open(iter_param, access_ctx, table, query_range);
+}
+
 int ObSSTableRowMultiScanner::get_handle_cnt(
     const void* query_range, int64_t& read_handle_cnt, int64_t& micro_handle_cnt)
 {
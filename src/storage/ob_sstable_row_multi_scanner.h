@@ -27,6 +27,9 @@ public:
   virtual int skip_range(int64_t range_idx, const common::ObStoreRowkey* gap_key, const bool include_gap_key) override;
 
 protected:
+  // multiple ranges are not read ahead
+  virtual int inner_open(const ObTableIterParam& iter_param, ObTableAccessContext& access_ctx, ObITable* table,
+      const void* query_range) override;
   virtual int get_handle_cnt(const void* query_range, int64_t& read_handle_cnt, int64_t& micro_handle_cnt);
   virtual int prefetch_read_handle(ObSSTableReadHandle& read_handle);
   virtual int fetch_row(ObSSTableReadHandle& read_handle, const ObStoreRow*& store_row);
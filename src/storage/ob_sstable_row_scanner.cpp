@@ -11,6 +11,7 @@
  */
 
 #include "ob_sstable_row_scanner.h"
+#include "share/config/ob_server_config.h"
 
 using namespace oceanbase::common;
 using namespace oceanbase::blocksstable;
@@ -64,12 +65,43 @@ void ObSSTableRowScanner::reuse()
   curr_row_ = NULL;
 }
 
+int ObSSTableRowScanner::inner_open(
+    const ObTableIterParam& iter_param, ObTableAccessContext& access_ctx, ObITable* table, const void* query_range)
+{
+  int ret = OB_SUCCESS;
+  const int64_t read_ahead_macro_cnt = GCONF._sstable_read_ahead_macro_block_count;
+  is_seq_scan_ = false;
+  if (OB_UNLIKELY(NULL == query_range || NULL == table)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "Invalid argument, ", K(ret), KP(query_range), KP(table));
+  } else if (read_ahead_macro_cnt > 0 &&
+             static_cast<ObSSTable*>(table)->get_macro_block_count() >= read_ahead_macro_cnt) {
+    // locate the macro blocks of the range before open, long scans need more handles to read ahead
+    if (OB_FAIL(find_macro_blocks(*static_cast<ObSSTable*>(table),
+            *static_cast<const ObExtStoreRange*>(query_range),
+            access_ctx.query_flag_.is_reverse_scan()))) {
+      STORAGE_LOG(WARN, "Fail to find macro blocks, ", K(ret));
+    } else {
+      is_seq_scan_ = macro_block_cnt_ >= read_ahead_macro_cnt;
+    }
+  }
+  if (OB_SUCC(ret)) {
+    if (OB_FAIL(ObSSTableRowIterator::inner_open(iter_param, access_ctx, table, query_range))) {
+      STORAGE_LOG(WARN, "Fail to open sstable row iterator, ", K(ret));
+    }
+  }
+  return ret;
+}
+
 int ObSSTableRowScanner::get_handle_cnt(const void* query_range, int64_t& read_handle_cnt, int64_t& micro_handle_cnt)
 {
   int ret = OB_SUCCESS;
   if (NULL == query_range) {
     ret = OB_INVALID_ARGUMENT;
     STORAGE_LOG(WARN, "Invalid argument, ", K(ret));
+  } else if (is_seq_scan_) {
+    read_handle_cnt = SEQ_SCAN_READ_HANDLE_CNT;
+    micro_handle_cnt = SEQ_SCAN_MICRO_HANDLE_CNT;
   } else {
     read_handle_cnt = SCAN_READ_HANDLE_CNT;
     micro_handle_cnt = SCAN_MICRO_HANDLE_CNT;
@@ -77,6 +109,22 @@ int ObSSTableRowScanner::get_handle_cnt(const void* query_range, int64_t& read_h
   return ret;
 }
 
+int ObSSTableRowScanner::find_macro_blocks(ObSSTable& sstable, const ObExtStoreRange& ext_range, const bool is_reverse)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(macro_block_iter_.open(sstable, ext_range, is_reverse))) {
+    STORAGE_LOG(WARN, "Fail to find macros, ", K(ret), K(ext_range));
+  } else if (OB_FAIL(macro_block_iter_.get_macro_block_count(macro_block_cnt_))) {
+    STORAGE_LOG(WARN, "Fail to get macro block count, ", K(ret), K(ext_range));
+  } else {
+    has_find_macro_ = true;
+    prefetch_macro_idx_ = is_reverse ? macro_block_cnt_ - 1 : 0;
+    prefetch_macro_order_ = 0;
+    STORAGE_LOG(DEBUG, "find macro count", K(macro_block_cnt_), KP(this));
+  }
+  return ret;
+}
+
 int ObSSTableRowScanner::prefetch_read_handle(ObSSTableReadHandle& read_handle)
 {
   return prefetch_range(0L /*prefetch range idx*/, *range_, read_handle);
@@ -101,15 +149,8 @@ int ObSSTableRowScanner::prefetch_range(
 
   if (!has_find_macro_) {
     // try find macro
-    if (OB_FAIL(macro_block_iter_.open(*sstable_, ext_range, access_ctx_->query_flag_.is_reverse_scan()))) {
-      STORAGE_LOG(WARN, "Fail to find macros, ", K(ret), K(ext_range));
-    } else if (OB_FAIL(macro_block_iter_.get_macro_block_count(macro_block_cnt_))) {
-      STORAGE_LOG(WARN, "Fail to get macro block count, ", K(ret), K(ext_range));
-    } else {
-      has_find_macro_ = true;
-      prefetch_macro_idx_ = access_ctx_->query_flag_.is_reverse_scan() ? macro_block_cnt_ - 1 : 0;
-      prefetch_macro_order_ = 0;
-      STORAGE_LOG(DEBUG, "find macro count", K(macro_block_cnt_), KP(this));
+    if (OB_FAIL(find_macro_blocks(*sstable_, ext_range, access_ctx_->query_flag_.is_reverse_scan()))) {
+      STORAGE_LOG(WARN, "Fail to find macro blocks, ", K(ret), K(ext_range));
     }
   }
 
@@ -397,7 +438,10 @@ int ObSSTableRowScanner::check_can_skip_range(const int64_t range_idx, const ObS
   int ret = OB_SUCCESS;
   ObStoreRowkey compare_rowkey;
   int32_t compare_result = 0;
-  if (range_idx > get_cur_range_idx()) {
+  if (access_ctx_->enable_pushdown_filter_) {
+    // micro blocks may be pruned by zone map, the micro block indexes of the range are not continuous
+    can_skip = false;
+  } else if (range_idx > get_cur_range_idx()) {
     can_skip = true;
   } else if (NULL == curr_row_) {
     can_skip = false;
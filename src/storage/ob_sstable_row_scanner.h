@@ -35,6 +35,8 @@ public:
   int get_row_iter_flag_impl(uint8_t& flag);
 
 protected:
+  virtual int inner_open(const ObTableIterParam& iter_param, ObTableAccessContext& access_ctx, ObITable* table,
+      const void* query_range) override;
   virtual int get_handle_cnt(const void* query_range, int64_t& read_handle_cnt, int64_t& micro_handle_cnt);
   virtual int prefetch_read_handle(ObSSTableReadHandle& read_handle);
   virtual int fetch_row(ObSSTableReadHandle& read_handle, const ObStoreRow*& store_row);
@@ -46,12 +48,15 @@ protected:
   virtual int get_range_count(const void* query_range, int64_t& range_count) const;
 
 private:
+  int find_macro_blocks(ObSSTable& sstable, const common::ObExtStoreRange& ext_range, const bool is_reverse);
   int skip_batch_rows(
       const int64_t range_idx, const ObStoreRowkey& gap_key, const bool include_gap_key, bool& need_actual_skip);
 
 protected:
   static const int64_t SCAN_READ_HANDLE_CNT = 4;
   static const int64_t SCAN_MICRO_HANDLE_CNT = 32;
+  static const int64_t SEQ_SCAN_READ_HANDLE_CNT = 8;
+  static const int64_t SEQ_SCAN_MICRO_HANDLE_CNT = 256;
   static const int64_t SCAN_DEFAULT_MACRO_BLOCK_CNT = 2;
   bool has_find_macro_;
   int64_t prefetch_macro_idx_;
@@ -20,6 +20,7 @@
 #include "storage/ob_index_merge.h"
 #include "storage/ob_partition_store.h"
 #include "storage/ob_store_row_filter.h"
+#include "sql/engine/ob_operator.h"
 #include "ob_warm_up.h"
 #include <sys/time.h>
 #include <sys/resource.h>
@@ -527,6 +528,38 @@ int ObTableScanStoreRowIterator::get_next_row(ObStoreRow*& cur_row)
   return ret;
 }
 
+// Rows are projected to the output expressions by ObRow2ExprsProjector in storage, set the batch index of
+// the eval context to project each row to its own datum of batch.
+int ObTableScanStoreRowIterator::get_next_rows(int64_t& count, const int64_t capacity)
+{
+  int ret = OB_SUCCESS;
+  count = 0;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "The ObTableScanStoreRowIterator has not been inited, ", K(ret));
+  } else if (OB_ISNULL(scan_param_->op_) || OB_ISNULL(scan_param_->output_exprs_)) {
+    ret = OB_NOT_SUPPORTED;
+    STORAGE_LOG(WARN, "batch iteration is only supported by static typing engine", K(ret));
+  } else {
+    sql::ObEvalCtx::BatchInfoScopeGuard batch_info_guard(scan_param_->op_->get_eval_ctx());
+    ObStoreRow* row = NULL;
+    while (OB_SUCC(ret) && count < capacity) {
+      batch_info_guard.set_batch_idx(count);
+      if (OB_FAIL(get_next_row(row))) {
+        if (OB_ITER_END != ret) {
+          STORAGE_LOG(WARN, "fail to get next row", K(ret), K(count));
+        }
+      } else {
+        count++;
+      }
+    }
+    if (OB_ITER_END == ret && count > 0) {
+      ret = OB_SUCCESS;
+    }
+  }
+  return ret;
+}
+
 int ObTableScanStoreRowIterator::switch_iterator(const int64_t range_array_idx)
 {
   int ret = OB_SUCCESS;
@@ -706,6 +739,21 @@ int ObTableScanIterIterator::get_next_iter(common::ObNewRowIterator*& iter)
   return ret;
 }
 
+// The rows of all ranges are returned by the store row iterator in order if there is only one range array.
+int ObTableScanIterIterator::get_next_rows(int64_t& count, const int64_t capacity)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(range_array_cnt_ > 1)) {
+    ret = OB_NOT_SUPPORTED;
+    STORAGE_LOG(WARN, "batch iteration of range array is not supported", K(ret), K_(range_array_cnt));
+  } else if (OB_FAIL(store_row_iter_.get_next_rows(count, capacity))) {
+    if (OB_ITER_END != ret) {
+      STORAGE_LOG(WARN, "fail to get next rows", K(ret));
+    }
+  }
+  return ret;
+}
+
 int ObTableScanIterIterator::init(transaction::ObTransService& trans_service, const ObStoreCtx& ctx,
     ObTableScanParam& scan_param, ObPartitionStore& partition_store)
 {
@@ -807,6 +855,25 @@ int ObTableScanIterator::get_next_row(common::ObNewRow*& row)
   return ret;
 }
 
+int ObTableScanIterator::get_next_rows(int64_t& count, int64_t capacity)
+{
+  int ret = OB_SUCCESS;
+  count = 0;
+  // switch to the first range like get_next_row()
+  if (NULL == row_iter_ && OB_FAIL(iter_.get_next_iter(row_iter_))) {
+    if (OB_ITER_END != ret) {
+      STORAGE_LOG(WARN, "fail to get next iterator", K(ret));
+    }
+  } else if (OB_FAIL(iter_.get_next_rows(count, capacity))) {
+    if (OB_ITER_END != ret) {
+      STORAGE_LOG(WARN, "fail to get next rows", K(ret), K(capacity));
+    } else {
+      STORAGE_LOG(DEBUG, "table scan iterator reaches end");
+    }
+  }
+  return ret;
+}
+
 int ObTableScanIterator::init(transaction::ObTransService& trans_service, const ObStoreCtx& ctx,
     ObTableScanParam& scan_param, ObPartitionStore& partition_store)
 {
@@ -44,6 +44,7 @@ public:
   int init(transaction::ObTransService& trans_service, const ObStoreCtx& ctx, ObTableScanParam& scan_param,
       ObPartitionStore& partition_store);
   virtual int get_next_row(ObStoreRow*& row);
+  int get_next_rows(int64_t& count, const int64_t capacity);
   virtual void reset();
   int rescan(const ObRangeArray& key_ranges, const ObPosArray& range_array_pos);
   int switch_iterator(const int64_t range_array_idx);
@@ -118,6 +119,7 @@ public:
   ObTableScanIterIterator();
   virtual ~ObTableScanIterIterator();
   virtual int get_next_iter(common::ObNewRowIterator*& iter);
+  int get_next_rows(int64_t& count, const int64_t capacity);
   int init(transaction::ObTransService& trans_service, const ObStoreCtx& ctx, ObTableScanParam& scan_param,
       ObPartitionStore& partition_store);
   int rescan(ObTableScanParam& scan_param);
@@ -148,6 +150,8 @@ public:
     common::ObNewRow* r = NULL;
     return get_next_row(r);
   }
+  // only the scan without range array (array binding) is supported
+  virtual int get_next_rows(int64_t& count, int64_t capacity) override;
   int init(transaction::ObTransService& trans_service, const ObStoreCtx& ctx, ObTableScanParam& scan_param,
       ObPartitionStore& partition_store);
   int rescan(ObTableScanParam& scan_param);
@@ -886,6 +886,7 @@ int ObLogReplayEngine::do_replay_task(storage::ObIPartitionGroup* partition, ObR
     } else {
       if (ObStorageLogTypeChecker::is_trans_log(log_type)) {
         get_replay_queue_index() = replay_queue_index;
+        get_replay_queue_count() = replay_status->get_task_queue_count();
         const int64_t trans_replay_start_time = common::ObTimeUtility::fast_current_time();
         int tmp_ret = OB_SUCCESS;
         int64_t safe_slave_read_timestamp = 0;
@@ -924,6 +925,7 @@ int ObLogReplayEngine::do_replay_task(storage::ObIPartitionGroup* partition, ObR
         }
         // reset to -1
         get_replay_queue_index() = -1;
+        get_replay_queue_count() = 0;
       } else if (ObStorageLogTypeChecker::is_partition_meta_log(log_type)) {
         REPLAY_LOG(INFO, "begin to replay partition meta log", K(ret), K(*replay_task));
         if (OB_SUCC(partition_service_->replay(replay_task->pk_,
@@ -428,6 +428,26 @@ int ObCoordTransCtx::handle_batch_commit_()
   return ret;
 }
 
+int ObCoordTransCtx::handle_batch_commit_prepared_()
+{
+  int ret = OB_SUCCESS;
+
+  // the prepare logs of all participants are durable and carry the whole participant list, so the
+  // transaction is committed with the max prepare version no matter what happens to the coordinator,
+  // the scheduler is answered before the commit and clear logs are written.
+  if (OB_FAIL(check_and_response_scheduler_(OB_TRANS_COMMIT_RESPONSE))) {
+    TRANS_LOG(WARN, "check and response scheduler error", KR(ret), "context", *this);
+  } else if (OB_FAIL(switch_state_(Ob2PCState::CLEAR))) {
+    TRANS_LOG(WARN, "switch to clear fail", KR(ret), "context", *this);
+  } else if (OB_FAIL(post_2pc_request_(participants_, OB_TRANS_2PC_COMMIT_CLEAR_REQUEST))) {
+    TRANS_LOG(WARN, "post commit clear request to participants fail", KR(ret), K(participants_));
+  } else {
+    // do nothing
+  }
+
+  return ret;
+}
+
 int ObCoordTransCtx::batch_submit_log_over_(const bool submit_log_succ)
 {
   int ret = OB_SUCCESS;
@@ -1401,12 +1421,8 @@ int ObCoordTransCtx::handle_2pc_prepare_response_raw_(const int64_t msg_type, co
             }
           } else {
             if (batch_commit_trans_) {
-              if (OB_FAIL(switch_state_(Ob2PCState::CLEAR))) {
-                TRANS_LOG(WARN, "switch to pre_commit fail", KR(ret));
-              } else if (OB_FAIL(post_2pc_request_(participants_, OB_TRANS_2PC_COMMIT_CLEAR_REQUEST))) {
-                TRANS_LOG(WARN, "post pre-commit request to participants fail", KR(ret), K(participants_));
-              } else {
-                // do nothing
+              if (OB_FAIL(handle_batch_commit_prepared_())) {
+                TRANS_LOG(WARN, "handle batch commit prepared error", KR(ret), "context", *this);
               }
             } else if (enable_new_1pc_) {
               if (OB_FAIL(switch_state_(Ob2PCState::COMMIT))) {
@@ -3495,14 +3511,8 @@ int ObCoordTransCtx::gts_elapse_callback(const MonotonicTs srr, const int64_t gt
             // do nothing
           }
         } else if (batch_commit_trans_) {
-          if (OB_FAIL(check_and_response_scheduler_(OB_TRANS_COMMIT_RESPONSE))) {
-            TRANS_LOG(WARN, "check and response scheduler error", K(ret), "context", *this);
-          } else if (OB_FAIL(switch_state_(Ob2PCState::CLEAR))) {
-            TRANS_LOG(WARN, "switch to pre_commit fail", K(ret), "context", *this);
-          } else if (OB_FAIL(post_2pc_request_(participants_, OB_TRANS_2PC_COMMIT_CLEAR_REQUEST))) {
-            TRANS_LOG(WARN, "post pre-commit request to participants fail", KR(ret), K(participants_));
-          } else {
-            // do nothing
+          if (OB_FAIL(handle_batch_commit_prepared_())) {
+            TRANS_LOG(WARN, "handle batch commit prepared error", KR(ret), "context", *this);
           }
         } else {
           if (OB_FAIL(switch_state_(Ob2PCState::PRE_COMMIT))) {
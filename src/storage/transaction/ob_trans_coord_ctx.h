@@ -161,6 +161,8 @@ private:
     return global_trans_version_;
   }
   int handle_batch_commit_();
+  // the prepare logs of all batch committed participants are durable and the gts has passed the commit version
+  int handle_batch_commit_prepared_();
   int batch_submit_log_over_(const bool submit_log_succ);
   bool is_pre_preparing_() const;
   int collect_partition_log_info_(const ObPartitionKey& partition, const uint64_t log_id, const int64_t log_timestamp);
@@ -52,7 +52,7 @@ int ObPartitionTransCtxMgr::init_trans_result_info_mgr_()
 }
 
 int ObPartitionTransCtxMgr::init(const ObPartitionKey& partition, const int64_t ctx_type, ObITsMgr* ts_mgr,
-    storage::ObPartitionService* partition_service, CtxMap* ctx_map)
+    storage::ObPartitionService* partition_service, CtxMap* ctx_maps, const int64_t ctx_map_count)
 {
   int ret = OB_SUCCESS;
 
@@ -60,10 +60,17 @@ int ObPartitionTransCtxMgr::init(const ObPartitionKey& partition, const int64_t
     TRANS_LOG(WARN, "ObPartitionTransCtxMgr inited twice");
     ret = OB_INIT_TWICE;
   } else if (OB_UNLIKELY(!partition.is_valid()) || OB_UNLIKELY(!ObTransCtxType::is_valid(ctx_type)) ||
-             OB_ISNULL(ts_mgr) || OB_ISNULL(partition_service) || OB_ISNULL(ctx_map)) {
-    TRANS_LOG(WARN, "invalid argument", K(partition), K(ctx_type), KP(ts_mgr), KP(partition_service));
+             OB_ISNULL(ts_mgr) || OB_ISNULL(partition_service) || OB_ISNULL(ctx_maps) || ctx_map_count <= 0) {
+    TRANS_LOG(WARN,
+        "invalid argument",
+        K(partition),
+        K(ctx_type),
+        KP(ts_mgr),
+        KP(partition_service),
+        KP(ctx_maps),
+        K(ctx_map_count));
     ret = OB_INVALID_ARGUMENT;
-  } else if (OB_FAIL(ctx_map_mgr_.init(partition, ctx_map))) {
+  } else if (OB_FAIL(ctx_map_mgr_.init(partition, ctx_maps, ctx_map_count))) {
     TRANS_LOG(WARN, "ctx_map_mgr init fail", KR(ret));
   } else {
     if (ObTransCtxType::PARTICIPANT == ctx_type) {
@@ -673,25 +680,21 @@ int ObPartitionTransCtxMgr::stop(const bool graceful)
   ObTimeGuard timeguard("ctxmgr stop");
   {
     WLockGuard guard(rwlock_);
-    if (OB_FAIL(cb_array.reserve(ctx_map_mgr_.estimate_count()))) {
-      TRANS_LOG(WARN, "reserve callback array error", KR(ret));
-    } else {
-      {
-        WLockGuard guard(minor_merge_lock_);
-        if (OB_FAIL(state_helper.switch_state(Ops::STOP))) {
-          TRANS_LOG(WARN, "switch state error", KR(ret), "manager", *this);
-        }
+    {
+      WLockGuard guard(minor_merge_lock_);
+      if (OB_FAIL(state_helper.switch_state(Ops::STOP))) {
+        TRANS_LOG(WARN, "switch state error", KR(ret), "manager", *this);
       }
+    }
 
-      if (OB_SUCC(ret)) {
-        KillTransCtxFunctor fn(arg, cb_array);
-        fn.set_release_audit_mgr_lock(true);
-        if (OB_FAIL(ctx_map_mgr_.foreach_ctx(fn))) {
-          TRANS_LOG(WARN, "for each transaction context error", KR(ret), "manager", *this);
-        }
-        if (OB_FAIL(ret)) {
-          state_helper.restore_state();
-        }
+    if (OB_SUCC(ret)) {
+      KillTransCtxFunctor fn(arg, cb_array);
+      fn.set_release_audit_mgr_lock(true);
+      if (OB_FAIL(ctx_map_mgr_.foreach_ctx(fn, &cb_array))) {
+        TRANS_LOG(WARN, "for each transaction context error", KR(ret), "manager", *this);
+      }
+      if (OB_FAIL(ret)) {
+        state_helper.restore_state();
       }
     }
   }
@@ -714,11 +717,9 @@ int ObPartitionTransCtxMgr::inactive_tenant(const uint64_t tenant_id)
     if (OB_UNLIKELY(!is_valid_tenant_id(tenant_id))) {
       TRANS_LOG(WARN, "invalid argument", K(tenant_id));
       ret = OB_INVALID_ARGUMENT;
-    } else if (OB_FAIL(cb_array.reserve(ctx_map_mgr_.estimate_count()))) {
-      TRANS_LOG(WARN, "reserve callback array error", KR(ret));
     } else {
       InactiveCtxFunctor fn(tenant_id, cb_array);
-      if (OB_FAIL(ctx_map_mgr_.foreach_ctx(fn))) {
+      if (OB_FAIL(ctx_map_mgr_.foreach_ctx(fn, &cb_array))) {
         TRANS_LOG(WARN, "for each transaction context error", KR(ret), "manager", *this);
       }
     }
@@ -901,9 +902,6 @@ int ObPartitionTransCtxMgr::leader_revoke(const bool first_check)
       //} else if (is_stopped_()) {
       //  TRANS_LOG(WARN, "partition is stopped", K_(partition));
       //  ret = OB_PARTITION_IS_STOPPED;
-    } else if (OB_FAIL(cb_array.reserve(ctx_map_mgr_.estimate_count()))) {
-      TRANS_LOG(WARN, "reserve callback array error", KR(ret));
-      ret = OB_EAGAIN;
     } else if (OB_FAIL(state_helper.switch_state(Ops::LEADER_REVOKE))) {
       TRANS_LOG(WARN, "switch state error", KR(ret), "manager", *this);
     } else {
@@ -915,8 +913,11 @@ int ObPartitionTransCtxMgr::leader_revoke(const bool first_check)
       }
       print_all_ctx_(MAX_HASH_ITEM_PRINT, verbose);
       LeaderRevokeFunctor fn(first_check, *this, cb_array, retry_count);
-      if (OB_FAIL(ctx_map_mgr_.remove_if((fn)))) {
+      if (OB_FAIL(ctx_map_mgr_.remove_if(fn, &cb_array))) {
         TRANS_LOG(WARN, "for each transaction context error", KR(ret), "manager", *this);
+        if (OB_ALLOCATE_MEMORY_FAILED == ret) {
+          ret = OB_EAGAIN;
+        }
       } else if (0 < retry_count) {
         TRANS_LOG(WARN, "partition leader revoke need retry", "manager", *this, K(first_check), K(retry_count));
         ret = OB_EAGAIN;
@@ -1765,26 +1766,36 @@ int ObPartitionTransCtxMgr::init_dup_table_mgr()
   return ret;
 }
 
-int ObPartitionTransCtxMgr::CtxMapMgr::init(const ObPartitionKey& partition, CtxMap* ctx_map)
+int ObPartitionTransCtxMgr::CtxMapMgr::init(const ObPartitionKey& partition, CtxMap* ctx_maps,
+    const int64_t ctx_map_count)
 {
   partition_ = partition;
-  ctx_map_ = ctx_map;
+  // the same map must not be taken twice, or the contexts in it are iterated twice. The count is fixed for the
+  // life of the partition, since it decides which map a trans id is routed to
+  shard_count_ = min(min(static_cast<int64_t>(SHARD_COUNT), ctx_map_count),
+      max(static_cast<int64_t>(GCONF._trans_ctx_map_shard_count), static_cast<int64_t>(1)));
+  const uint64_t start = partition.hash();
+  for (int64_t i = 0; i < shard_count_; ++i) {
+    ctx_maps_[i] = ctx_maps + ((start + i) % ctx_map_count);
+  }
   return OB_SUCCESS;
 }
 
 void ObPartitionTransCtxMgr::CtxMapMgr::destroy()
 {
-  if (OB_NOT_NULL(ctx_map_)) {
-    ctx_map_ = nullptr;
+  if (shard_count_ > 0) {
+    memset(ctx_maps_, 0, sizeof(ctx_maps_));
+    shard_count_ = 0;
   }
 }
 
 void ObPartitionTransCtxMgr::CtxMapMgr::reset()
 {
-  if (OB_NOT_NULL(ctx_map_)) {
+  if (shard_count_ > 0) {
     ObRemoveAllCtxFunctor fn;
     remove_if(fn);
-    ctx_map_ = nullptr;
+    memset(ctx_maps_, 0, sizeof(ctx_maps_));
+    shard_count_ = 0;
   }
 }
 
@@ -1828,8 +1839,8 @@ bool ObPartitionTransCtxMgr::CtxMapMgr::ObPartitionRemoveIfFilterFunctor<Fn>::op
 int ObPartitionTransCtxMgr::CtxMapMgr::get(const ObTransID& trans_id, ObTransCtx*& ctx)
 {
   int ret = OB_SUCCESS;
-  if (OB_NOT_NULL(ctx_map_)) {
-    ret = ctx_map_->get(ObTransKey(partition_, trans_id), ctx);
+  if (shard_count_ > 0) {
+    ret = get_ctx_map_(trans_id)->get(ObTransKey(partition_, trans_id), ctx);
   } else {
     ret = OB_NOT_INIT;
   }
@@ -1839,8 +1850,8 @@ int ObPartitionTransCtxMgr::CtxMapMgr::get(const ObTransID& trans_id, ObTransCtx
 int ObPartitionTransCtxMgr::CtxMapMgr::insert_and_get(const ObTransID& trans_id, ObTransCtx* ctx)
 {
   int ret = OB_SUCCESS;
-  if (OB_NOT_NULL(ctx_map_)) {
-    ret = ctx_map_->insert_and_get(ObTransKey(partition_, trans_id), ctx);
+  if (shard_count_ > 0) {
+    ret = get_ctx_map_(trans_id)->insert_and_get(ObTransKey(partition_, trans_id), ctx);
   } else {
     ret = OB_NOT_INIT;
   }
@@ -1849,16 +1860,18 @@ int ObPartitionTransCtxMgr::CtxMapMgr::insert_and_get(const ObTransID& trans_id,
 
 void ObPartitionTransCtxMgr::CtxMapMgr::revert(ObTransCtx* ctx)
 {
-  if (OB_NOT_NULL(ctx_map_)) {
-    ctx_map_->revert(ctx);
+  // the ref count lives in the hash node of the context, any map of the partition can release it, even if the
+  // context is not inited and its trans id is not known yet
+  if (shard_count_ > 0) {
+    ctx_maps_[0]->revert(ctx);
   }
 }
 
 int ObPartitionTransCtxMgr::CtxMapMgr::del(const ObTransID& trans_id)
 {
   int ret = OB_SUCCESS;
-  if (OB_NOT_NULL(ctx_map_)) {
-    ret = ctx_map_->del(ObTransKey(partition_, trans_id));
+  if (shard_count_ > 0) {
+    ret = get_ctx_map_(trans_id)->del(ObTransKey(partition_, trans_id));
   } else {
     ret = OB_NOT_INIT;
   }
@@ -2229,7 +2242,8 @@ int ObTransCtxMgrImpl::add_partition(const ObPartitionKey& partition)
                  ctx_type_,
                  ts_mgr_,
                  partition_service_,
-                 ctx_map_ + (partition.hash() % CONTEXT_MAP_COUNT)))) {
+                 ctx_map_,
+                 CONTEXT_MAP_COUNT))) {
     TRANS_LOG(WARN, "partition transaction context manager inited error", KR(ret), K(partition));
     ObPartitionTransCtxMgrFactory::release(ctx_mgr);
     ctx_mgr = NULL;
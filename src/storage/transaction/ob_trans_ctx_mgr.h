@@ -130,7 +130,7 @@ public:
     destroy();
   }
   int init(const common::ObPartitionKey& partition, const int64_t ctx_type, ObITsMgr* ts_mgr,
-      storage::ObPartitionService* partition_service, CtxMap* ctx_map);
+      storage::ObPartitionService* partition_service, CtxMap* ctx_maps, const int64_t ctx_map_count);
   void destroy();
   void reset();
 
@@ -418,17 +418,25 @@ public:
   static const int64_t MAX_HASH_ITEM_PRINT = 16;
 
 private:
+  // The contexts of a partition are spread over _trans_ctx_map_shard_count (at most SHARD_COUNT) of the ctx
+  // maps of the server by the hash of the trans id, so that the creation and erasure of contexts of a hot
+  // partition do not all land on the same map. Iterating a partition visits each of its maps once, and each map
+  // holds the contexts of other partitions too, so a scan costs about shard count times more than on one map.
   class CtxMapMgr {
   public:
-    CtxMapMgr() : ctx_map_(nullptr)
+    static const int64_t SHARD_COUNT = 8;
+
+  public:
+    CtxMapMgr() : shard_count_(0)
     {
+      memset(ctx_maps_, 0, sizeof(ctx_maps_));
       reset();
     }
     ~CtxMapMgr()
     {
       destroy();
     }
-    int init(const ObPartitionKey& partition, CtxMap* ctx_map);
+    int init(const ObPartitionKey& partition, CtxMap* ctx_maps, const int64_t ctx_map_count);
     void destroy();
     void reset();
     // it is used to filter partition
@@ -464,18 +472,19 @@ private:
     int insert_and_get(const ObTransID& trans_id, ObTransCtx* ctx);
     void revert(ObTransCtx* ctx);
     int del(const ObTransID& trans_id);
-    int64_t estimate_count()
-    {
-      return ctx_map_->count();
-    }
-    // if true is returned, continue to iterate; otherwise, stop the iteration
+    // if true is returned, continue to iterate; otherwise, stop the iteration.
+    // cb_array, if given, is reserved for the contexts of each map before the map is iterated
     template <typename Fn>
-    int foreach_ctx(Fn& fn)
+    int foreach_ctx(Fn& fn, ObEndTransCallbackArray* cb_array = NULL)
     {
       int ret = OB_SUCCESS;
-      if (OB_NOT_NULL(ctx_map_)) {
+      if (shard_count_ > 0) {
         ObPartitionForEachFilterFunctor<Fn> filter_fn(partition_, fn);
-        ret = ctx_map_->for_each(filter_fn);
+        for (int64_t i = 0; OB_SUCC(ret) && i < shard_count_; ++i) {
+          if (OB_SUCC(reserve_callback_array_(ctx_maps_[i], cb_array))) {
+            ret = ctx_maps_[i]->for_each(filter_fn);
+          }
+        }
       } else {
         ret = OB_NOT_INIT;
       }
@@ -484,21 +493,41 @@ private:
     // if true is returned, it indicates that it should be removed;
     // otherwise, it should not be removed
     template <typename Fn>
-    int remove_if(Fn& fn)
+    int remove_if(Fn& fn, ObEndTransCallbackArray* cb_array = NULL)
     {
       int ret = OB_SUCCESS;
-      if (OB_NOT_NULL(ctx_map_)) {
+      if (shard_count_ > 0) {
         ObPartitionRemoveIfFilterFunctor<Fn> filter_fn(partition_, fn);
-        ret = ctx_map_->remove_if(filter_fn);
+        for (int64_t i = 0; OB_SUCC(ret) && i < shard_count_; ++i) {
+          if (OB_SUCC(reserve_callback_array_(ctx_maps_[i], cb_array))) {
+            ret = ctx_maps_[i]->remove_if(filter_fn);
+          }
+        }
       } else {
         ret = OB_NOT_INIT;
       }
       return ret;
     }
 
+  private:
+    CtxMap* get_ctx_map_(const ObTransID& trans_id) const
+    {
+      return ctx_maps_[trans_id.hash() % shard_count_];
+    }
+    // the map is shared with other partitions, so its count bounds the callbacks it can add
+    static int reserve_callback_array_(CtxMap* ctx_map, ObEndTransCallbackArray* cb_array)
+    {
+      int ret = OB_SUCCESS;
+      if (NULL != cb_array && OB_FAIL(cb_array->reserve(cb_array->count() + ctx_map->count()))) {
+        TRANS_LOG(WARN, "reserve callback array error", KR(ret), "count", cb_array->count());
+      }
+      return ret;
+    }
+
   private:
     ObPartitionKey partition_;
-    CtxMap* ctx_map_;
+    CtxMap* ctx_maps_[SHARD_COUNT];
+    int64_t shard_count_;
   };
   class State {
   public:
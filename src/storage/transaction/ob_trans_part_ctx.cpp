@@ -11235,6 +11235,8 @@ int ObPartTransCtx::check_row_locked(const ObStoreRowkey& key, ObIMvccCtx& ctx,
 
     if (cur_ts >= query_abs_lock_wait_timeout) {
       ret = OB_ERR_EXCLUSIVE_LOCK_CONFLICT;
+    } else if (get_global_lock_wait_mgr().is_deadlock_victim(ctx.get_ctx_descriptor(), read_trans_id)) {
+      ret = OB_DEAD_LOCK;
     } else {
       ret = OB_TRY_LOCK_ROW_CONFLICT;
 
@@ -0,0 +1,102 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "clog/ob_clog_group_commit_ctrl.h"
+#include "clog/ob_clog_config.h"
+
+#include <gtest/gtest.h>
+
+namespace oceanbase {
+using namespace common;
+using namespace clog;
+namespace unittest {
+
+static void feed_arrivals(ObClogGroupCommitCtrl& ctrl, const int64_t interval, const int64_t size)
+{
+  int64_t ts = 1000 * 1000;
+  for (int64_t i = 0; i < 64; i++) {
+    ctrl.record_arrival(ts, size);
+    ts += interval;
+  }
+}
+
+TEST(test_clog_group_commit_ctrl, moving_average)
+{
+  ObClogGroupCommitCtrl ctrl;
+  feed_arrivals(ctrl, 100, 200);
+  EXPECT_EQ(100, ctrl.get_arrival_interval());
+  EXPECT_EQ(200, ctrl.get_log_size());
+
+  // an idle gap is capped
+  ctrl.record_arrival(100 * 1000 * 1000, 200);
+  EXPECT_EQ(100 + (ObClogGroupCommitCtrl::MAX_ARRIVAL_INTERVAL - 100) / 8, ctrl.get_arrival_interval());
+
+  ObClogGroupCommitCtrl::reset_fsync_latency();
+  for (int64_t i = 0; i < 64; i++) {
+    ObClogGroupCommitCtrl::record_fsync_latency(500);
+  }
+  EXPECT_EQ(500, ObClogGroupCommitCtrl::get_fsync_latency());
+}
+
+TEST(test_clog_group_commit_ctrl, flush_window)
+{
+  ObClogGroupCommitCtrl::reset_fsync_latency();
+  ObClogGroupCommitCtrl::record_fsync_latency(500);
+
+  // no arrival observed yet
+  ObClogGroupCommitCtrl ctrl;
+  EXPECT_EQ(0, ctrl.calc_flush_window(2000));
+
+  // busy partition, wait about one fsync
+  feed_arrivals(ctrl, 100, 200);
+  EXPECT_EQ(500, ctrl.calc_flush_window(2000));
+  EXPECT_EQ(500, ctrl.get_flush_window());
+
+  // the budget left by the fsync bounds the window
+  EXPECT_EQ(300, ctrl.calc_flush_window(800));
+
+  // the fsync alone exceeds the target
+  EXPECT_EQ(0, ctrl.calc_flush_window(400));
+
+  // the next log is not expected within the budget
+  ObClogGroupCommitCtrl idle_ctrl;
+  feed_arrivals(idle_ctrl, 5000, 200);
+  EXPECT_EQ(0, idle_ctrl.calc_flush_window(2000));
+
+  // fast disk, the fsync is shorter than the arrival interval, wait for the next log
+  ObClogGroupCommitCtrl::reset_fsync_latency();
+  ObClogGroupCommitCtrl::record_fsync_latency(50);
+  EXPECT_EQ(100, ctrl.calc_flush_window(2000));
+
+  // large logs fill up the buffer before the fsync window ends
+  ObClogGroupCommitCtrl::reset_fsync_latency();
+  ObClogGroupCommitCtrl::record_fsync_latency(5000);
+  ObClogGroupCommitCtrl big_ctrl;
+  const int64_t log_size = AGGRE_BUFFER_LIMIT / 4;
+  feed_arrivals(big_ctrl, 100, log_size);
+  EXPECT_EQ(100 * (AGGRE_BUFFER_LIMIT / log_size), big_ctrl.calc_flush_window(20000));
+
+  EXPECT_EQ(3, ctrl.get_delay_count());
+  EXPECT_EQ(2, ctrl.get_immediate_count());
+}
+
+}  // namespace unittest
+}  // namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  OB_LOGGER.set_file_name("test_clog_group_commit_ctrl.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  CLOG_LOG(INFO, "begin unittest::test_clog_group_commit_ctrl");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
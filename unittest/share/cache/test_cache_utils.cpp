@@ -136,6 +136,36 @@ TEST(TestFixArray, basic)
   }
 }
 
+TEST(TestFrequencySketch, basic)
+{
+  ObFrequencySketch sketch;
+  ASSERT_EQ(OB_INVALID_ARGUMENT, sketch.init(0, "1"));
+  ASSERT_EQ(OB_SUCCESS, sketch.init(1024, "1"));
+  ASSERT_EQ(OB_INIT_TWICE, sketch.init(1024, "1"));
+  ASSERT_EQ(0, sketch.frequency(1));
+  for (int64_t i = 0; i < 3; ++i) {
+    sketch.increment(1);
+  }
+  ASSERT_EQ(3, sketch.frequency(1));
+  ASSERT_EQ(0, sketch.frequency(2));
+  for (int64_t i = 0; i < 100; ++i) {
+    sketch.increment(1);
+  }
+  ASSERT_EQ(ObFrequencySketch::MAX_FREQUENCY, sketch.frequency(1));
+
+  // counters are halved after sample_size_ increments
+  bool halved = false;
+  for (uint64_t hash = 2; !halved; ++hash) {
+    const int64_t size = sketch.size_;
+    sketch.increment(hash);
+    halved = sketch.size_ < size;
+  }
+  ASSERT_GT(ObFrequencySketch::MAX_FREQUENCY, sketch.frequency(1));
+  ASSERT_LE(ObFrequencySketch::MAX_FREQUENCY / 2, sketch.frequency(1));
+  sketch.destroy();
+  ASSERT_EQ(0, sketch.frequency(1));
+}
+
 }  // end namespace share
 }  // end namespace oceanbase
 
@@ -352,6 +352,65 @@ TEST_F(TestKVCache, test_wash)
   ASSERT_TRUE(cache.size(tenant_id_) < upper_mem_limit_);
 }
 
+class TestWashCallback : public ObIKVCacheWashCallback {
+public:
+  TestWashCallback() : wash_cnt_(0)
+  {}
+  virtual void on_wash(const ObIKVCacheKey& key, const ObIKVCacheValue& value) override
+  {
+    UNUSED(key);
+    UNUSED(value);
+    ATOMIC_INC(&wash_cnt_);
+  }
+  int64_t wash_cnt_;
+};
+
+TEST_F(TestKVCache, test_wash_callback)
+{
+  static const int64_t K_SIZE = 16;
+  static const int64_t V_SIZE = 2 * 1024 * 1024;
+  typedef TestKVCacheKey<K_SIZE> TestKey;
+  typedef TestKVCacheValue<V_SIZE> TestValue;
+
+  int ret = OB_SUCCESS;
+  ObKVCache<TestKey, TestValue> cache;
+  TestWashCallback callback;
+  TestKey key;
+  TestValue value;
+  key.tenant_id_ = tenant_id_;
+  value.v_ = 4321;
+
+  ret = cache.set_wash_callback(&callback);
+  ASSERT_NE(OB_SUCCESS, ret);
+  ret = cache.init("test");
+  ASSERT_EQ(OB_SUCCESS, ret);
+  ret = cache.set_wash_callback(&callback);
+  ASSERT_EQ(OB_SUCCESS, ret);
+
+  // the kv pairs washed out are passed to the callback
+  const int64_t put_cnt = upper_mem_limit_ / V_SIZE * 10;
+  for (int64_t i = 0; i < put_cnt; ++i) {
+    key.v_ = i;
+    ret = cache.put(key, value);
+    ASSERT_EQ(OB_SUCCESS, ret);
+  }
+  sleep(1);
+  ASSERT_TRUE(ATOMIC_LOAD(&callback.wash_cnt_) > 0);
+  ASSERT_TRUE(ATOMIC_LOAD(&callback.wash_cnt_) <= put_cnt);
+
+  // no more notification after unset
+  ret = cache.set_wash_callback(NULL);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  const int64_t wash_cnt = ATOMIC_LOAD(&callback.wash_cnt_);
+  for (int64_t i = put_cnt; i < 2 * put_cnt; ++i) {
+    key.v_ = i;
+    ret = cache.put(key, value);
+    ASSERT_EQ(OB_SUCCESS, ret);
+  }
+  sleep(1);
+  ASSERT_EQ(wash_cnt, ATOMIC_LOAD(&callback.wash_cnt_));
+}
+
 TEST_F(TestKVCache, test_hold_size)
 {
   static const int64_t K_SIZE = 16;
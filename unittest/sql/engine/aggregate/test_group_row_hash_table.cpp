@@ -0,0 +1,217 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "lib/hash_func/murmur_hash.h"
+#include "sql/engine/aggregate/ob_aggregate_processor.h"
+#include "sql/engine/ob_exec_context.h"
+
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+
+// Group rows of one int64 group by column, the column is a frame datum without eval function,
+// so the probe key is set to the frame datum directly.
+class TestGroupRowHashTable : public ::testing::Test {
+public:
+  const static int64_t ROW_CNT = 10000;
+
+  TestGroupRowHashTable()
+      : alloc_(ObModIds::TEST),
+        exec_ctx_(),
+        eval_ctx_(exec_ctx_, alloc_, alloc_),
+        exprs_(alloc_),
+        cmp_funcs_(alloc_),
+        mem_attr_(OB_SERVER_TENANT_ID, ObModIds::TEST)
+  {}
+  virtual void SetUp();
+  virtual void TearDown();
+
+protected:
+  static int cmp_int(const ObDatum& l, const ObDatum& r)
+  {
+    return l.get_int() < r.get_int() ? -1 : (l.get_int() > r.get_int() ? 1 : 0);
+  }
+  static uint64_t hash_int(const int64_t key)
+  {
+    return murmurhash(&key, sizeof(key), 0);
+  }
+  // build the item of group row with %key
+  void make_item(const int64_t idx, const int64_t key, const uint64_t hash);
+  // item to probe %key, the key is set to the datum of the group by expression
+  ObGroupRowItem& probe(const int64_t key, const uint64_t hash);
+
+protected:
+  ObArenaAllocator alloc_;
+  ObExecContext exec_ctx_;
+  ObEvalCtx eval_ctx_;
+  char frame_[sizeof(ObDatum) + sizeof(ObEvalInfo)];
+  char* frames_[1];
+  ObExpr expr_;
+  ExprFixedArray exprs_;
+  ObCmpFuncs cmp_funcs_;
+  oceanbase::lib::ObMemAttr mem_attr_;
+  int64_t keys_[ROW_CNT];
+  ObAggregateProcessor::GroupRow rows_[ROW_CNT];
+  ObGroupRowItem items_[ROW_CNT];
+  int64_t probe_key_;
+  ObGroupRowItem probe_item_;
+  ObGroupRowHashTable table_;
+};
+
+void TestGroupRowHashTable::SetUp()
+{
+  memset(frame_, 0, sizeof(frame_));
+  frames_[0] = frame_;
+  eval_ctx_.frames_ = frames_;
+  expr_.frame_idx_ = 0;
+  expr_.datum_off_ = 0;
+  expr_.eval_info_off_ = sizeof(ObDatum);
+  ObCmpFunc cmp_func;
+  cmp_func.cmp_func_ = cmp_int;
+  ASSERT_EQ(OB_SUCCESS, exprs_.init(1));
+  ASSERT_EQ(OB_SUCCESS, exprs_.push_back(&expr_));
+  ASSERT_EQ(OB_SUCCESS, cmp_funcs_.init(1));
+  ASSERT_EQ(OB_SUCCESS, cmp_funcs_.push_back(cmp_func));
+  probe_item_.group_exprs_ = &exprs_;
+  ASSERT_EQ(OB_SUCCESS, table_.init(&alloc_, mem_attr_, &eval_ctx_, &cmp_funcs_, 2));
+}
+
+void TestGroupRowHashTable::TearDown()
+{
+  table_.destroy();
+  alloc_.reset();
+}
+
+void TestGroupRowHashTable::make_item(const int64_t idx, const int64_t key, const uint64_t hash)
+{
+  void* buf = alloc_.alloc(sizeof(ObChunkDatumStore::StoredRow) + sizeof(ObDatum));
+  ASSERT_TRUE(NULL != buf);
+  ObChunkDatumStore::StoredRow* sr = new (buf) ObChunkDatumStore::StoredRow();
+  sr->cnt_ = 1;
+  keys_[idx] = key;
+  sr->cells()[0].ptr_ = reinterpret_cast<const char*>(&keys_[idx]);
+  sr->cells()[0].pack_ = sizeof(int64_t);
+  rows_[idx].groupby_store_row_ = sr;
+  items_[idx].group_id_ = idx;
+  items_[idx].group_row_ = &rows_[idx];
+  items_[idx].groupby_datums_hash_ = hash;
+}
+
+ObGroupRowItem& TestGroupRowHashTable::probe(const int64_t key, const uint64_t hash)
+{
+  probe_key_ = key;
+  ObDatum* datum = reinterpret_cast<ObDatum*>(frame_);
+  datum->ptr_ = reinterpret_cast<const char*>(&probe_key_);
+  datum->pack_ = sizeof(int64_t);
+  probe_item_.groupby_datums_hash_ = hash;
+  return probe_item_;
+}
+
+TEST_F(TestGroupRowHashTable, set_get)
+{
+  for (int64_t i = 0; i < ROW_CNT; i++) {
+    ASSERT_TRUE(NULL == table_.get(probe(i * 3, hash_int(i * 3))));
+    make_item(i, i * 3, hash_int(i * 3));
+    ASSERT_EQ(OB_SUCCESS, table_.set(items_[i]));
+  }
+  ASSERT_EQ(ROW_CNT, table_.size());
+  // buckets are doubled when half filled
+  ASSERT_EQ(next_pow2(table_.get_bucket_num()), table_.get_bucket_num());
+  ASSERT_GE(table_.get_bucket_num(), ROW_CNT * ObGroupRowHashTable::SIZE_BUCKET_SCALE);
+  for (int64_t i = 0; i < ROW_CNT; i++) {
+    const ObGroupRowItem* item = table_.get(probe(i * 3, hash_int(i * 3)));
+    ASSERT_TRUE(NULL != item);
+    ASSERT_EQ(i, item->group_id_);
+    ASSERT_TRUE(NULL == table_.get(probe(i * 3 + 1, hash_int(i * 3 + 1))));
+  }
+}
+
+TEST_F(TestGroupRowHashTable, hash_collision)
+{
+  // equal hash values, compared by group by column
+  const int64_t cnt = 100;
+  const uint64_t hash = 7;
+  for (int64_t i = 0; i < cnt; i++) {
+    make_item(i, i, hash);
+    ASSERT_EQ(OB_SUCCESS, table_.set(items_[i]));
+  }
+  // hash values of the same bucket, probing goes through the following buckets
+  const int64_t bucket_num = table_.get_bucket_num();
+  for (int64_t i = cnt; i < 2 * cnt; i++) {
+    make_item(i, i, hash + bucket_num * i);
+    ASSERT_EQ(OB_SUCCESS, table_.set(items_[i]));
+  }
+  ASSERT_EQ(2 * cnt, table_.size());
+  for (int64_t i = 0; i < cnt; i++) {
+    const ObGroupRowItem* item = table_.get(probe(i, hash));
+    ASSERT_TRUE(NULL != item);
+    ASSERT_EQ(i, item->group_id_);
+    ASSERT_TRUE(NULL == table_.get(probe(i + cnt, hash)));
+  }
+  for (int64_t i = cnt; i < 2 * cnt; i++) {
+    const ObGroupRowItem* item = table_.get(probe(i, hash + bucket_num * i));
+    ASSERT_TRUE(NULL != item);
+    ASSERT_EQ(i, item->group_id_);
+  }
+  ASSERT_TRUE(NULL == table_.get(probe(2 * cnt, hash)));
+}
+
+TEST_F(TestGroupRowHashTable, foreach_reuse_resize)
+{
+  const int64_t cnt = 1000;
+  for (int64_t i = 0; i < cnt; i++) {
+    make_item(i, i, hash_int(i));
+    ASSERT_EQ(OB_SUCCESS, table_.set(items_[i]));
+  }
+  int64_t visited = 0;
+  int64_t id_sum = 0;
+  auto cb = [&](ObGroupRowItem& item) {
+    visited += 1;
+    id_sum += item.group_id_;
+    return OB_SUCCESS;
+  };
+  ASSERT_EQ(OB_SUCCESS, table_.foreach (cb));
+  ASSERT_EQ(cnt, visited);
+  ASSERT_EQ(cnt * (cnt - 1) / 2, id_sum);
+
+  // reuse keeps the buckets
+  const int64_t bucket_num = table_.get_bucket_num();
+  table_.reuse();
+  ASSERT_EQ(0, table_.size());
+  ASSERT_EQ(bucket_num, table_.get_bucket_num());
+  ASSERT_TRUE(NULL == table_.get(probe(0, hash_int(0))));
+
+  // resize to much less buckets rebuilds the table
+  ASSERT_EQ(OB_SUCCESS, table_.resize(&alloc_, 16));
+  ASSERT_EQ(0, table_.size());
+  ASSERT_GT(bucket_num, table_.get_bucket_num());
+  for (int64_t i = 0; i < cnt; i++) {
+    ASSERT_EQ(OB_SUCCESS, table_.set(items_[i]));
+  }
+  ASSERT_EQ(cnt, table_.size());
+  visited = 0;
+  id_sum = 0;
+  ASSERT_EQ(OB_SUCCESS, table_.foreach (cb));
+  ASSERT_EQ(cnt, visited);
+  for (int64_t i = 0; i < cnt; i++) {
+    const ObGroupRowItem* item = table_.get(probe(i, hash_int(i)));
+    ASSERT_TRUE(NULL != item);
+    ASSERT_EQ(i, item->group_id_);
+  }
+}
+
+int main(int argc, char** argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
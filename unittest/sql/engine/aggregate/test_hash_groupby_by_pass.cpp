@@ -0,0 +1,98 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL
+
+#include <gtest/gtest.h>
+
+#define private public
+#define protected public
+
+#include "sql/engine/aggregate/ob_hash_groupby_op.h"
+#include "sql/engine/ob_exec_context.h"
+#include "sql/session/ob_sql_session_info.h"
+#include "sql/ob_sql_init.h"
+
+namespace oceanbase {
+namespace sql {
+using namespace common;
+
+class TestHashGroupByByPass : public ::testing::Test {
+public:
+  TestHashGroupByByPass() : eval_ctx_(exec_ctx_, eval_res_, eval_tmp_), spec_(alloc_, PHY_HASH_GROUP_BY)
+  {}
+  virtual void SetUp() override
+  {
+    ASSERT_EQ(OB_SUCCESS, session_.test_init(0, 0, 0, NULL));
+    exec_ctx_.set_my_session(&session_);
+    exec_ctx_.eval_ctx_ = &eval_ctx_;
+  }
+
+protected:
+  ObSQLSessionInfo session_;
+  ObArenaAllocator alloc_;
+  ObArenaAllocator eval_res_;
+  ObArenaAllocator eval_tmp_;
+  ObExecContext exec_ctx_;
+  ObEvalCtx eval_ctx_;
+  ObHashGroupBySpec spec_;
+};
+
+TEST_F(TestHashGroupByByPass, need_by_pass)
+{
+  const int64_t rows = ObHashGroupByOp::BY_PASS_SAMPLE_ROWS;
+  const int64_t percent = ObHashGroupByOp::BY_PASS_GROUP_PERCENT;
+  int64_t group_percent = -1;
+  // every sampled row is a new group
+  ASSERT_TRUE(ObHashGroupByOp::need_by_pass(rows, rows, group_percent));
+  ASSERT_EQ(100, group_percent);
+  // groups at the threshold
+  ASSERT_TRUE(ObHashGroupByOp::need_by_pass(rows, rows * percent / 100, group_percent));
+  ASSERT_EQ(percent, group_percent);
+  // aggregation reduces rows
+  ASSERT_FALSE(ObHashGroupByOp::need_by_pass(rows, rows * percent / 100 - 1, group_percent));
+  ASSERT_EQ(percent - 1, group_percent);
+  ASSERT_FALSE(ObHashGroupByOp::need_by_pass(rows, 1, group_percent));
+  ASSERT_EQ(0, group_percent);
+  // not enough rows sampled
+  ASSERT_FALSE(ObHashGroupByOp::need_by_pass(rows / 2, rows / 2, group_percent));
+  ASSERT_EQ(100, group_percent);
+  ASSERT_FALSE(ObHashGroupByOp::need_by_pass(0, 0, group_percent));
+  ASSERT_EQ(0, group_percent);
+}
+
+// By pass is decided for each iteration, the state is cleared by rescan.
+TEST_F(TestHashGroupByByPass, reset)
+{
+  spec_.by_pass_enabled_ = true;
+  ObHashGroupByOp op(exec_ctx_, spec_, NULL);
+  ASSERT_FALSE(op.by_pass_);
+  op.by_pass_ = true;
+  op.by_pass_row_cnt_ = 100;
+  op.curr_group_id_ = 10;
+  op.reset();
+  ASSERT_FALSE(op.by_pass_);
+  ASSERT_EQ(0, op.by_pass_row_cnt_);
+  ASSERT_TRUE(NULL == op.by_pass_group_row_);
+  ASSERT_EQ(OB_INVALID_INDEX, op.curr_group_id_);
+}
+
+}  // namespace sql
+}  // namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  oceanbase::sql::init_sql_factories();
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -787,6 +787,35 @@ TEST_F(TestChunkDatumStore, test_only_disk_data1)
   rs.reset();
 }
 
+TEST_F(TestChunkDatumStore, compressed_disk_data)
+{
+  const char* compress_funcs[] = {"lz4_1.0", "zstd_1.3.8"};
+  for (int64_t i = 0; i < ARRAYSIZEOF(compress_funcs); i++) {
+    GCONF._temp_store_compress_func.set_value(compress_funcs[i]);
+    int64_t cnt = 10000;
+    ObChunkDatumStore rs;
+    ASSERT_EQ(OB_SUCCESS, rs.alloc_dir_id());
+    ObChunkDatumStore::Iterator it;
+    ASSERT_EQ(OB_SUCCESS, rs.init(0, tenant_id_, ctx_id_, label_));
+    rs.set_mem_limit(1L << 30);
+    // disk data
+    CALL(append_rows, rs, cnt);
+    ASSERT_EQ(OB_SUCCESS, rs.dump(false, true));
+    // memory data
+    CALL(append_rows, rs, cnt);
+    rs.finish_add_row(false);
+    ASSERT_TRUE(rs.is_compressed());
+    LOG_INFO("compressed file size", K(compress_funcs[i]), K(rs.get_file_size()), K(rs.get_row_cnt_on_disk()));
+
+    CALL(verify_n_rows, rs, it, rs.get_row_cnt(), true);
+    it.reset();
+    CALL(verify_n_rows, rs, it, rs.get_row_cnt(), true, ObChunkDatumStore::BLOCK_SIZE);
+    it.reset();
+    rs.reset();
+  }
+  GCONF._temp_store_compress_func.set_value("none");
+}
+
 }  // end namespace sql
 }  // end namespace oceanbase
 
@@ -0,0 +1,143 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <math.h>
+
+#include "sql/engine/expr/ob_batch_eval_util.h"
+
+namespace oceanbase {
+namespace sql {
+using namespace common;
+
+class ObBatchKernelTest : public ::testing::Test {
+public:
+  // odd count to cover the scalar tail of vectorized kernels.
+  const static int64_t CNT = 103;
+
+  virtual void SetUp()
+  {
+    for (int64_t i = 0; i < CNT; i++) {
+      li_[i] = (i % 7) * 1000 - 3000 + i;
+      ri_[i] = (i % 5) * 1000 - 2000 + i;
+      ld_[i] = static_cast<double>(li_[i]) / 3;
+      rd_[i] = static_cast<double>(ri_[i]) / 3;
+    }
+    li_[0] = INT64_MAX;
+    ri_[0] = 1;
+    ld_[1] = NAN;
+    rd_[2] = NAN;
+    ld_[3] = NAN;
+    rd_[3] = NAN;
+  }
+
+protected:
+  int64_t li_[CNT];
+  int64_t ri_[CNT];
+  double ld_[CNT];
+  double rd_[CNT];
+};
+
+TEST_F(ObBatchKernelTest, arith)
+{
+  int64_t res_i[CNT];
+  double res_d[CNT];
+  ObBatchKernel::add_int(li_, ri_, res_i, CNT);
+  // overflow is wrapped around
+  EXPECT_EQ(INT64_MIN, res_i[0]);
+  for (int64_t i = 1; i < CNT; i++) {
+    ASSERT_EQ(li_[i] + ri_[i], res_i[i]);
+  }
+  ObBatchKernel::sub_int(li_, ri_, res_i, CNT);
+  for (int64_t i = 1; i < CNT; i++) {
+    ASSERT_EQ(li_[i] - ri_[i], res_i[i]);
+  }
+  ObBatchKernel::mul_int(li_, ri_, res_i, CNT);
+  for (int64_t i = 1; i < CNT; i++) {
+    ASSERT_EQ(li_[i] * ri_[i], res_i[i]);
+  }
+
+  ObBatchKernel::add_double(ld_, rd_, res_d, CNT);
+  for (int64_t i = 4; i < CNT; i++) {
+    ASSERT_EQ(ld_[i] + rd_[i], res_d[i]);
+  }
+  EXPECT_TRUE(isnan(res_d[1]));
+  ObBatchKernel::sub_double(ld_, rd_, res_d, CNT);
+  for (int64_t i = 4; i < CNT; i++) {
+    ASSERT_EQ(ld_[i] - rd_[i], res_d[i]);
+  }
+  ObBatchKernel::mul_double(ld_, rd_, res_d, CNT);
+  for (int64_t i = 4; i < CNT; i++) {
+    ASSERT_EQ(ld_[i] * rd_[i], res_d[i]);
+  }
+}
+
+// same with ObDatumCmpHelperByTC::cmp()
+template <typename T>
+int64_t expect_cmp(const ObCmpOp op, const T l, const T r)
+{
+  const int cmp = (l == r ? 0 : (l < r ? -1 : 1));
+  int64_t res = 0;
+  switch (op) {
+    case CO_EQ:
+      res = (0 == cmp);
+      break;
+    case CO_NE:
+      res = (0 != cmp);
+      break;
+    case CO_LT:
+      res = (cmp < 0);
+      break;
+    case CO_LE:
+      res = (cmp <= 0);
+      break;
+    case CO_GT:
+      res = (cmp > 0);
+      break;
+    case CO_GE:
+      res = (cmp >= 0);
+      break;
+    default:
+      break;
+  }
+  return res;
+}
+
+TEST_F(ObBatchKernelTest, compare)
+{
+  int64_t res[CNT];
+  const ObCmpOp ops[] = {CO_EQ, CO_NE, CO_LT, CO_LE, CO_GT, CO_GE};
+  // make some equal values
+  for (int64_t i = 10; i < CNT; i += 3) {
+    ri_[i] = li_[i];
+    rd_[i] = ld_[i];
+  }
+  for (int64_t k = 0; k < ARRAYSIZEOF(ops); k++) {
+    ObBatchKernel::cmp_int(ops[k], li_, ri_, res, CNT);
+    for (int64_t i = 0; i < CNT; i++) {
+      ASSERT_EQ(expect_cmp(ops[k], li_[i], ri_[i]), res[i]) << "op: " << ops[k] << " idx: " << i;
+    }
+    ObBatchKernel::cmp_double(ops[k], ld_, rd_, res, CNT);
+    for (int64_t i = 0; i < CNT; i++) {
+      ASSERT_EQ(expect_cmp(ops[k], ld_[i], rd_[i]), res[i]) << "op: " << ops[k] << " idx: " << i;
+    }
+  }
+}
+
+}  // end namespace sql
+}  // end namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
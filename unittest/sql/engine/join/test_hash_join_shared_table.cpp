@@ -0,0 +1,160 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL
+
+#include <gtest/gtest.h>
+#include <thread>
+
+#define private public
+#define protected public
+
+#include "sql/engine/join/ob_hash_join_op.h"
+#include "sql/engine/ob_exec_context.h"
+#include "sql/engine/ob_physical_plan_ctx.h"
+#include "sql/session/ob_sql_session_info.h"
+#include "sql/ob_sql_init.h"
+
+namespace oceanbase {
+namespace sql {
+using namespace common;
+
+typedef ObHashJoinSharedTableInfo SharedInfo;
+
+// One PX task of the shared hash join, only the sync steps are exercised.
+class SharedHashJoinTask {
+public:
+  SharedHashJoinTask(ObSQLSessionInfo& session, SharedInfo& info)
+      : eval_ctx_(exec_ctx_, eval_res_, eval_tmp_), spec_(alloc_, PHY_HASH_JOIN), op_(NULL)
+  {
+    exec_ctx_.set_my_session(&session);
+    exec_ctx_.eval_ctx_ = &eval_ctx_;
+    if (OB_SUCCESS == exec_ctx_.create_physical_plan_ctx()) {
+      exec_ctx_.get_physical_plan_ctx()->set_timeout_timestamp(ObTimeUtility::current_time() + 10 * 1000 * 1000);
+    }
+    op_ = new ObHashJoinOp(exec_ctx_, spec_, NULL);
+    op_->shared_info_ = &info;
+    op_->sync_step_ = SharedInfo::SYNC_ROW_CNT;
+  }
+  ~SharedHashJoinTask()
+  {
+    op_->shared_info_ = NULL;
+    delete op_;
+  }
+  ObHashJoinOp& op()
+  {
+    return *op_;
+  }
+
+private:
+  ObArenaAllocator alloc_;
+  ObArenaAllocator eval_res_;
+  ObArenaAllocator eval_tmp_;
+  ObExecContext exec_ctx_;
+  ObEvalCtx eval_ctx_;
+  ObHashJoinSpec spec_;
+  ObHashJoinOp* op_;
+};
+
+class TestHashJoinSharedTable : public ::testing::Test {
+public:
+  virtual void SetUp() override
+  {
+    ASSERT_EQ(OB_SUCCESS, session_.test_init(0, 0, 0, NULL));
+  }
+
+protected:
+  ObSQLSessionInfo session_;
+};
+
+TEST_F(TestHashJoinSharedTable, sync_steps)
+{
+  SharedInfo info(2);
+  SharedHashJoinTask t1(session_, info);
+  SharedHashJoinTask t2(session_, info);
+  int ret1 = OB_SUCCESS;
+  int ret2 = OB_SUCCESS;
+  std::thread th([&]() {
+    if (OB_SUCCESS == (ret1 = t1.op().sync_shared_hash_table(SharedInfo::SYNC_ROW_CNT))) {
+      ret1 = t1.op().sync_shared_hash_table(SharedInfo::SYNC_BUILD);
+    }
+  });
+  if (OB_SUCCESS == (ret2 = t2.op().sync_shared_hash_table(SharedInfo::SYNC_ROW_CNT))) {
+    ret2 = t2.op().sync_shared_hash_table(SharedInfo::SYNC_BUILD);
+  }
+  th.join();
+  ASSERT_EQ(OB_SUCCESS, ret1);
+  ASSERT_EQ(OB_SUCCESS, ret2);
+  ASSERT_TRUE(info.all_arrived(SharedInfo::SYNC_BUILD));
+  ASSERT_FALSE(info.all_arrived(SharedInfo::SYNC_CLOSE));
+
+  // both tasks built the table, close is not an error
+  t1.op().close_shared_hash_table();
+  ASSERT_FALSE(info.all_arrived(SharedInfo::SYNC_CLOSE));
+  t2.op().close_shared_hash_table();
+  ASSERT_TRUE(info.all_arrived(SharedInfo::SYNC_CLOSE));
+  ASSERT_EQ(OB_SUCCESS, info.get_error());
+}
+
+// A task closed before its build rows are inserted, e.g. its join is never pulled,
+// must not let the others probe a hash table without its rows.
+TEST_F(TestHashJoinSharedTable, close_before_build)
+{
+  SharedInfo info(2);
+  SharedHashJoinTask t1(session_, info);
+  SharedHashJoinTask t2(session_, info);
+  t1.op().close_shared_hash_table();
+  ASSERT_EQ(OB_ERR_UNEXPECTED, info.get_error());
+  ASSERT_FALSE(info.all_arrived(SharedInfo::SYNC_ROW_CNT));
+  ASSERT_EQ(OB_ERR_UNEXPECTED, t2.op().sync_shared_hash_table(SharedInfo::SYNC_ROW_CNT));
+  ASSERT_TRUE(info.all_arrived(SharedInfo::SYNC_ROW_CNT));
+  t2.op().close_shared_hash_table();
+  ASSERT_TRUE(info.all_arrived(SharedInfo::SYNC_CLOSE));
+
+  // the task waiting for the others quits with the error too
+  SharedInfo info2(2);
+  SharedHashJoinTask t3(session_, info2);
+  SharedHashJoinTask t4(session_, info2);
+  int ret = OB_SUCCESS;
+  std::thread th([&]() { ret = t3.op().sync_shared_hash_table(SharedInfo::SYNC_ROW_CNT); });
+  usleep(10 * 1000);
+  t4.op().close_shared_hash_table();
+  th.join();
+  ASSERT_EQ(OB_ERR_UNEXPECTED, ret);
+  t3.op().close_shared_hash_table();
+  ASSERT_TRUE(info2.all_arrived(SharedInfo::SYNC_CLOSE));
+}
+
+// Drain of a task which has built the table does not build it again.
+TEST_F(TestHashJoinSharedTable, drain_after_build)
+{
+  SharedInfo info(1);
+  SharedHashJoinTask t1(session_, info);
+  t1.op().opened_ = true;
+  ASSERT_EQ(OB_SUCCESS, t1.op().sync_shared_hash_table(SharedInfo::SYNC_ROW_CNT));
+  ASSERT_EQ(OB_SUCCESS, t1.op().sync_shared_hash_table(SharedInfo::SYNC_BUILD));
+  ASSERT_EQ(OB_SUCCESS, t1.op().drain_exch());
+  ASSERT_TRUE(t1.op().exch_drained_);
+  t1.op().close_shared_hash_table();
+  ASSERT_EQ(OB_SUCCESS, info.get_error());
+}
+
+}  // namespace sql
+}  // namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  oceanbase::sql::init_sql_factories();
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,113 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+#include <gtest/gtest.h>
+
+#include "lib/allocator/page_arena.h"
+#include "lib/hash_func/murmur_hash.h"
+#include "sql/engine/px/ob_px_bloom_filter.h"
+
+using namespace oceanbase;
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+
+class ObPxBloomFilterTest : public ::testing::Test {
+public:
+  const static int64_t KEY_CNT = 10000;
+  static uint64_t hash(const int64_t key)
+  {
+    return murmurhash64A(&key, sizeof(key), 0);
+  }
+
+protected:
+  ObArenaAllocator alloc_;
+};
+
+TEST_F(ObPxBloomFilterTest, basic)
+{
+  ObPxBloomFilter filter;
+  ASSERT_FALSE(filter.is_inited());
+  ASSERT_EQ(OB_INVALID_ARGUMENT, filter.init(1000, alloc_));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, filter.init(32, alloc_));
+  ASSERT_EQ(OB_SUCCESS, filter.init(ObPxBloomFilter::calc_bit_cnt(KEY_CNT), alloc_));
+  for (int64_t i = 0; i < KEY_CNT; i++) {
+    filter.put(hash(i));
+  }
+  // no false negative
+  for (int64_t i = 0; i < KEY_CNT; i++) {
+    ASSERT_TRUE(filter.might_contain(hash(i)));
+  }
+  int64_t false_positive = 0;
+  for (int64_t i = KEY_CNT; i < 2 * KEY_CNT; i++) {
+    false_positive += filter.might_contain(hash(i));
+  }
+  LOG_INFO("false positive", K(false_positive), K(filter));
+  ASSERT_LT(false_positive, KEY_CNT / 10);
+}
+
+TEST_F(ObPxBloomFilterTest, merge_and_serialize)
+{
+  const int64_t bit_cnt = ObPxBloomFilter::calc_bit_cnt(KEY_CNT);
+  ObPxBloomFilter f1;
+  ObPxBloomFilter f2;
+  ObPxBloomFilter f3;
+  ASSERT_EQ(OB_SUCCESS, f1.init(bit_cnt, alloc_));
+  ASSERT_EQ(OB_SUCCESS, f2.init(bit_cnt, alloc_));
+  ASSERT_EQ(OB_SUCCESS, f3.init(bit_cnt * 2, alloc_));
+  for (int64_t i = 0; i < KEY_CNT; i++) {
+    (i % 2 ? f1 : f2).put(hash(i));
+  }
+  ASSERT_EQ(OB_INVALID_ARGUMENT, f1.merge(f3));
+  ASSERT_EQ(OB_SUCCESS, f1.merge(f2));
+
+  const int64_t len = f1.get_serialize_size();
+  char* buf = static_cast<char*>(alloc_.alloc(len));
+  ASSERT_TRUE(NULL != buf);
+  int64_t pos = 0;
+  ASSERT_EQ(OB_SUCCESS, f1.serialize(buf, len, pos));
+  ASSERT_EQ(len, pos);
+
+  ObPxBloomFilter res;
+  res.set_allocator(&alloc_);
+  // deserialize twice, the second reuse the memory of the first.
+  for (int64_t round = 0; round < 2; round++) {
+    pos = 0;
+    ASSERT_EQ(OB_SUCCESS, res.deserialize(buf, len, pos));
+    ASSERT_EQ(len, pos);
+    ASSERT_EQ(bit_cnt, res.get_bit_cnt());
+    for (int64_t i = 0; i < KEY_CNT; i++) {
+      ASSERT_TRUE(res.might_contain(hash(i)));
+    }
+  }
+
+  ObPxBloomFilter copy;
+  ASSERT_EQ(OB_SUCCESS, copy.assign(res, alloc_));
+  for (int64_t i = 0; i < KEY_CNT; i++) {
+    ASSERT_TRUE(copy.might_contain(hash(i)));
+  }
+}
+
+TEST_F(ObPxBloomFilterTest, calc_bit_cnt)
+{
+  ASSERT_EQ(ObPxBloomFilter::MIN_BIT_CNT, ObPxBloomFilter::calc_bit_cnt(0));
+  ASSERT_EQ(ObPxBloomFilter::MIN_BIT_CNT, ObPxBloomFilter::calc_bit_cnt(100));
+  ASSERT_EQ(1L << 17, ObPxBloomFilter::calc_bit_cnt(10000));
+  ASSERT_EQ(ObPxBloomFilter::MAX_BIT_CNT, ObPxBloomFilter::calc_bit_cnt(INT32_MAX));
+}
+
+int main(int argc, char** argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
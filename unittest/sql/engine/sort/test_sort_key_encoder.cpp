@@ -0,0 +1,170 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+
+#include <gtest/gtest.h>
+#include "sql/engine/sort/ob_sort_op_impl.h"
+#include "share/datum/ob_datum_funcs.h"
+
+using namespace oceanbase;
+using namespace oceanbase::sql;
+using namespace oceanbase::common;
+
+class TestSortKeyEncoder : public ::testing::Test {
+public:
+  const static int64_t MAX_CNT = 64;
+  const static int64_t BUF_SIZE = 64;
+
+  virtual void SetUp()
+  {
+    cnt_ = 0;
+  }
+
+  ObDatum& next_datum()
+  {
+    ObDatum& d = datums_[cnt_];
+    d.ptr_ = bufs_[cnt_];
+    cnt_++;
+    return d;
+  }
+
+  void add_null()
+  {
+    next_datum().set_null();
+  }
+
+  void add_int(const int64_t v)
+  {
+    next_datum().set_int(v);
+  }
+
+  void add_number(const char* str)
+  {
+    number::ObNumber num;
+    ASSERT_EQ(OB_SUCCESS, num.from(str, alloc_));
+    next_datum().set_number(num);
+  }
+
+  void add_string(const char* str, const int64_t len)
+  {
+    ObDatum& d = next_datum();
+    MEMCPY(bufs_[cnt_ - 1], str, len);
+    d.pack_ = static_cast<uint32_t>(len);
+  }
+
+  void add_string(const char* str)
+  {
+    add_string(str, strlen(str));
+  }
+
+  // a < b => key(a) <= key(b) and a == b => key(a) == key(b)
+  void check_order(const ObObjType type, const ObCollationType cs_type)
+  {
+    const bool ascs[] = {true, false};
+    const ObCmpNullPos null_poses[] = {NULL_FIRST, NULL_LAST};
+    for (int64_t a = 0; a < ARRAYSIZEOF(ascs); a++) {
+      for (int64_t n = 0; n < ARRAYSIZEOF(null_poses); n++) {
+        ObSortFieldCollation collation(0, cs_type, ascs[a], null_poses[n]);
+        ObSortKeyEncoder encoder;
+        encoder.init(collation, ObDatumMeta(type, cs_type, 0));
+        ASSERT_TRUE(encoder.is_valid());
+        ObDatumCmpFuncType cmp_func = ObDatumFuncs::get_nullsafe_cmp_func(type, type, null_poses[n], cs_type, false);
+        ASSERT_TRUE(NULL != cmp_func);
+        for (int64_t i = 0; i < cnt_; i++) {
+          for (int64_t j = 0; j < cnt_; j++) {
+            uint64_t ki = 0;
+            uint64_t kj = 0;
+            ASSERT_TRUE(encoder.encode(datums_[i], ki));
+            ASSERT_TRUE(encoder.encode(datums_[j], kj));
+            int cmp = cmp_func(datums_[i], datums_[j]);
+            cmp = ascs[a] ? cmp : -cmp;
+            if (cmp < 0) {
+              ASSERT_LE(ki, kj) << "i: " << i << " j: " << j;
+            } else if (0 == cmp) {
+              ASSERT_EQ(ki, kj) << "i: " << i << " j: " << j;
+            }
+          }
+        }
+      }
+    }
+  }
+
+protected:
+  ObArenaAllocator alloc_;
+  int64_t cnt_;
+  ObDatum datums_[MAX_CNT];
+  char bufs_[MAX_CNT][BUF_SIZE];
+};
+
+TEST_F(TestSortKeyEncoder, int)
+{
+  add_null();
+  add_int(INT64_MIN);
+  add_int(INT64_MIN + 1);
+  add_int(-1);
+  add_int(0);
+  add_int(1);
+  add_int(INT64_MAX);
+  check_order(ObIntType, CS_TYPE_BINARY);
+}
+
+TEST_F(TestSortKeyEncoder, number)
+{
+  add_null();
+  add_number("0");
+  add_number("1");
+  add_number("-1");
+  add_number("0.5");
+  add_number("-0.5");
+  add_number("1000000000");
+  add_number("1000000001");
+  add_number("-1000000001");
+  add_number("123456789.123456789");
+  add_number("123456789.123456788");
+  add_number("123456789.1234567891");
+  add_number("-123456789.123456789");
+  add_number("-123456789.1234567891");
+  add_number("0.000000000001");
+  add_number("-0.000000000001");
+  check_order(ObNumberType, CS_TYPE_BINARY);
+}
+
+TEST_F(TestSortKeyEncoder, string)
+{
+  const ObCollationType cs_types[] = {CS_TYPE_UTF8MB4_GENERAL_CI, CS_TYPE_UTF8MB4_BIN, CS_TYPE_BINARY};
+  for (int64_t i = 0; i < ARRAYSIZEOF(cs_types); i++) {
+    SetUp();
+    add_null();
+    add_string("");
+    add_string(" ");
+    add_string("a");
+    add_string("A");
+    add_string("a ");
+    add_string("a\x01");
+    add_string("a\0", 2);
+    add_string("abcdefgh");
+    add_string("abcdefghi");
+    add_string("ABCDEFGH");
+    add_string("abcdefg\xc3\xa9");  // e with acute accent
+    add_string("abcdefgZ");
+    add_string("\xe4\xb8\xad\xe6\x96\x87\xe4\xb8\xad\xe6\x96\x87");
+    add_string("\xe4\xb8\xad\xe6\x96\x87\xe4\xb8\xad\xe6\x96\x88");
+    check_order(ObVarcharType, cs_types[i]);
+  }
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
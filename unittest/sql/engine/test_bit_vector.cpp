@@ -0,0 +1,94 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+
+#include "sql/engine/ob_bit_vector.h"
+#include "lib/allocator/page_arena.h"
+
+namespace oceanbase {
+namespace sql {
+
+TEST(ObTestBitVector, basic)
+{
+  common::ObArenaAllocator alloc;
+  const int64_t size = 200;
+  ObBitVector* bv = to_bit_vector(alloc.alloc(ObBitVector::memory_size(size)));
+  ASSERT_TRUE(NULL != bv);
+  EXPECT_EQ(4 * sizeof(uint64_t), ObBitVector::memory_size(size));
+
+  bv->reset(size);
+  EXPECT_EQ(0, bv->accumulate_bit_cnt(size));
+  EXPECT_FALSE(bv->is_all_true(size));
+
+  bv->set(0);
+  bv->set(63);
+  bv->set(64);
+  bv->set(199);
+  EXPECT_TRUE(bv->at(0));
+  EXPECT_TRUE(bv->at(63));
+  EXPECT_TRUE(bv->at(64));
+  EXPECT_FALSE(bv->at(65));
+  EXPECT_TRUE(bv->at(199));
+  EXPECT_EQ(4, bv->accumulate_bit_cnt(size));
+  EXPECT_EQ(2, bv->accumulate_bit_cnt(64));
+
+  bv->unset(63);
+  EXPECT_FALSE(bv->at(63));
+  EXPECT_EQ(3, bv->accumulate_bit_cnt(size));
+
+  bv->set_all(size);
+  EXPECT_TRUE(bv->is_all_true(size));
+  EXPECT_TRUE(bv->is_all_true(100));
+  EXPECT_EQ(size, bv->accumulate_bit_cnt(size));
+  bv->unset(150);
+  EXPECT_FALSE(bv->is_all_true(size));
+  EXPECT_TRUE(bv->is_all_true(150));
+}
+
+TEST(ObTestBitVector, copy_and_or)
+{
+  common::ObArenaAllocator alloc;
+  const int64_t size = 100;
+  ObBitVector* a = to_bit_vector(alloc.alloc(ObBitVector::memory_size(size)));
+  ObBitVector* b = to_bit_vector(alloc.alloc(ObBitVector::memory_size(size)));
+  ASSERT_TRUE(NULL != a && NULL != b);
+  a->reset(size);
+  b->reset(size);
+  for (int64_t i = 0; i < size; i += 2) {
+    a->set(i);
+  }
+  b->deep_copy(*a, size);
+  EXPECT_EQ(size / 2, b->accumulate_bit_cnt(size));
+  b->reset(size);
+  for (int64_t i = 1; i < size; i += 2) {
+    b->set(i);
+  }
+  a->bit_or(*b, size);
+  EXPECT_TRUE(a->is_all_true(size));
+
+  b->bit_not(*b, size);
+  EXPECT_EQ(size / 2, b->accumulate_bit_cnt(size));
+  EXPECT_TRUE(b->at(0));
+  EXPECT_FALSE(b->at(1));
+  EXPECT_EQ(size / 2, b->accumulate_bit_cnt(ObBitVector::word_count(size) * ObBitVector::WORD_BITS));
+}
+
+}  // namespace sql
+}  // namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  int ret = RUN_ALL_TESTS();
+  return ret;
+}
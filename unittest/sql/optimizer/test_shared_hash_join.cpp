@@ -0,0 +1,144 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_OPT
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "sql/optimizer/ob_log_plan.h"
+#include "sql/optimizer/ob_select_log_plan.h"
+#include "sql/optimizer/ob_log_join.h"
+#include "sql/optimizer/ob_log_table_scan.h"
+#include "sql/optimizer/ob_log_group_by.h"
+#include "sql/optimizer/ob_log_subplan_filter.h"
+#include "sql/session/ob_sql_session_info.h"
+#include "sql/optimizer/ob_optimizer.h"
+#include "sql/ob_sql_context.h"
+
+using namespace oceanbase::sql;
+using namespace oceanbase::common;
+
+namespace test {
+class TestSharedHashJoin : public ::testing::Test {
+public:
+  TestSharedHashJoin()
+      : mempool_(ObModIds::OB_SQL_COMPILE, OB_MALLOC_NORMAL_BLOCK_SIZE),
+        expr_factory_(mempool_),
+        ctx_(&session_info_, &exec_ctx_, NULL, NULL, NULL, NULL, static_cast<ObIAllocator&>(mempool_), NULL, NULL,
+            addr_, NULL, OB_MERGED_VERSION_INIT, query_hint_, expr_factory_, NULL),
+        plan_(ctx_, NULL)
+  {}
+  virtual void SetUp() override
+  {
+    ASSERT_EQ(OB_SUCCESS, session_info_.test_init(0, 0, 0, NULL));
+  }
+
+  ObLogicalOperator* alloc_op(const log_op_def::ObLogOpType type)
+  {
+    return plan_.log_op_factory_.allocate(plan_, type);
+  }
+  // shared hash table candidate: inner hash join with broadcast of the left side
+  ObLogJoin* alloc_hash_join()
+  {
+    ObLogJoin* join = static_cast<ObLogJoin*>(alloc_op(log_op_def::LOG_JOIN));
+    join->set_join_algo(HASH_JOIN);
+    join->set_join_type(INNER_JOIN);
+    join->set_join_distributed_method(DIST_BROADCAST_NONE);
+    add_child(join, alloc_op(log_op_def::LOG_TABLE_SCAN));
+    ObLogicalOperator* right = alloc_op(log_op_def::LOG_TABLE_SCAN);
+    right->get_sharding_info().set_location_type(OB_TBL_LOCATION_DISTRIBUTED);
+    add_child(join, right);
+    return join;
+  }
+  ObLogJoin* alloc_nl_join(ObLogicalOperator* left, ObLogicalOperator* right)
+  {
+    ObLogJoin* join = static_cast<ObLogJoin*>(alloc_op(log_op_def::LOG_JOIN));
+    join->set_join_algo(NESTED_LOOP_JOIN);
+    join->set_join_type(INNER_JOIN);
+    add_child(join, left);
+    add_child(join, right);
+    return join;
+  }
+  void add_child(ObLogicalOperator* parent, ObLogicalOperator* child)
+  {
+    parent->set_child(parent->get_num_of_child(), child);
+    child->set_parent(parent);
+  }
+
+protected:
+  ObSQLSessionInfo session_info_;
+  ObArenaAllocator mempool_;
+  ObExecContext exec_ctx_;
+  ObAddr addr_;
+  ObQueryHint query_hint_;
+  ObRawExprFactory expr_factory_;
+  ObOptimizerContext ctx_;
+  ObSelectLogPlan plan_;
+};
+
+TEST_F(TestSharedHashJoin, not_rescanned)
+{
+  // group by -> NLJ(HJ, scan)
+  ObLogJoin* hj = alloc_hash_join();
+  ObLogJoin* nlj = alloc_nl_join(hj, alloc_op(log_op_def::LOG_TABLE_SCAN));
+  ObLogicalOperator* group_by = alloc_op(log_op_def::LOG_GROUP_BY);
+  add_child(group_by, nlj);
+  ASSERT_FALSE(hj->is_rescanned());
+
+  // SPF(HJ, scan)
+  ObLogJoin* hj2 = alloc_hash_join();
+  ObLogicalOperator* spf = alloc_op(log_op_def::LOG_SUBPLAN_FILTER);
+  add_child(spf, hj2);
+  add_child(spf, alloc_op(log_op_def::LOG_TABLE_SCAN));
+  ASSERT_FALSE(hj2->is_rescanned());
+
+  // hash join of hash join is never rescanned
+  ObLogJoin* hj3 = alloc_hash_join();
+  ObLogJoin* top = static_cast<ObLogJoin*>(alloc_op(log_op_def::LOG_JOIN));
+  top->set_join_algo(HASH_JOIN);
+  add_child(top, alloc_op(log_op_def::LOG_TABLE_SCAN));
+  add_child(top, hj3);
+  ASSERT_FALSE(hj3->is_rescanned());
+}
+
+TEST_F(TestSharedHashJoin, rescanned)
+{
+  // NLJ(scan, group by -> HJ)
+  ObLogJoin* hj = alloc_hash_join();
+  ObLogicalOperator* group_by = alloc_op(log_op_def::LOG_GROUP_BY);
+  add_child(group_by, hj);
+  alloc_nl_join(alloc_op(log_op_def::LOG_TABLE_SCAN), group_by);
+  ASSERT_TRUE(hj->is_rescanned());
+  ASSERT_FALSE(hj->can_use_shared_hash_table(*hj->get_child(ObLogicalOperator::second_child)));
+
+  // SPF(scan, HJ)
+  ObLogJoin* hj2 = alloc_hash_join();
+  ObLogicalOperator* spf = alloc_op(log_op_def::LOG_SUBPLAN_FILTER);
+  add_child(spf, alloc_op(log_op_def::LOG_TABLE_SCAN));
+  add_child(spf, hj2);
+  ASSERT_TRUE(hj2->is_rescanned());
+  ASSERT_FALSE(hj2->can_use_shared_hash_table(*hj2->get_child(ObLogicalOperator::second_child)));
+
+  // left side of NLJ which is the right side of another NLJ
+  ObLogJoin* hj3 = alloc_hash_join();
+  ObLogJoin* inner_nlj = alloc_nl_join(hj3, alloc_op(log_op_def::LOG_TABLE_SCAN));
+  alloc_nl_join(alloc_op(log_op_def::LOG_TABLE_SCAN), inner_nlj);
+  ASSERT_TRUE(hj3->is_rescanned());
+}
+
+}  // namespace test
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,376 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <fcntl.h>
+#define private public
+#define protected public
+#include "lib/checksum/ob_crc64.h"
+#include "storage/blocksstable/ob_micro_block_cache_snapshot.h"
+#include "storage/blocksstable/ob_macro_block_writer.h"
+#include "storage/blocksstable/ob_storage_cache_suite.h"
+#include "storage/blocksstable/slog/ob_base_storage_logger.h"
+#include "share/schema/ob_table_schema.h"
+#include "ob_row_generate.h"
+#include "ob_data_file_prepare.h"
+
+namespace oceanbase {
+using namespace common;
+using namespace blocksstable;
+using namespace storage;
+using namespace share::schema;
+
+namespace unittest {
+static const char* SNAPSHOT_FILE = "test_micro_block_cache_snapshot.snap";
+
+// snapshot file format, no block cache or data file is needed
+class TestBlockCacheSnapshotFile : public ::testing::Test {
+public:
+  virtual void SetUp() override
+  {
+    ::unlink(SNAPSHOT_FILE);
+    ASSERT_EQ(OB_SUCCESS, snapshot_.init(SNAPSHOT_FILE, block_cache_));
+    for (int64_t i = 0; i < ITEM_CNT; ++i) {
+      items_[i].table_id_ = combine_id(1, 3001);
+      items_[i].block_id_ = MacroBlockId(i + 2);
+      items_[i].offset_ = i * 4096;
+      items_[i].size_ = 4096;
+      items_[i].get_cnt_ = ITEM_CNT - i;
+    }
+  }
+  virtual void TearDown() override
+  {
+    snapshot_.destroy();
+    ::unlink(SNAPSHOT_FILE);
+  }
+  void write_at(const int64_t offset, const void* buf, const int64_t size)
+  {
+    int fd = ::open(SNAPSHOT_FILE, O_WRONLY);
+    ASSERT_TRUE(fd >= 0);
+    ASSERT_EQ(size, ::pwrite(fd, buf, size, offset));
+    ::close(fd);
+  }
+
+protected:
+  static const int64_t ITEM_CNT = 16;
+  ObMicroBlockCache block_cache_;
+  ObMicroBlockCacheSnapshot snapshot_;
+  ObBlockCacheSnapshotItem items_[ITEM_CNT];
+};
+
+TEST_F(TestBlockCacheSnapshotFile, round_trip)
+{
+  ObBlockCacheSnapshotItem* items = NULL;
+  int64_t item_cnt = 0;
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, snapshot_.read_file(items, item_cnt));
+
+  ASSERT_EQ(OB_SUCCESS, snapshot_.write_file(items_, ITEM_CNT));
+  ASSERT_EQ(OB_SUCCESS, snapshot_.read_file(items, item_cnt));
+  ASSERT_EQ(ITEM_CNT, item_cnt);
+  ASSERT_TRUE(NULL != items);
+  ASSERT_EQ(0, MEMCMP(items_, items, sizeof(items_)));
+  ob_free(items);
+  items = NULL;
+
+  // an empty block cache
+  ASSERT_EQ(OB_SUCCESS, snapshot_.write_file(items_, 0));
+  ASSERT_EQ(OB_SUCCESS, snapshot_.read_file(items, item_cnt));
+  ASSERT_EQ(0, item_cnt);
+  ASSERT_TRUE(NULL == items);
+}
+
+TEST_F(TestBlockCacheSnapshotFile, corrupted)
+{
+  ObBlockCacheSnapshotItem* items = NULL;
+  int64_t item_cnt = 0;
+  const int64_t header_size = sizeof(ObBlockCacheSnapshotHeader);
+
+  // a flipped byte in the items
+  ASSERT_EQ(OB_SUCCESS, snapshot_.write_file(items_, ITEM_CNT));
+  const char byte = 0x5a;
+  write_at(header_size + sizeof(ObBlockCacheSnapshotItem) + 3, &byte, 1);
+  ASSERT_EQ(OB_CHECKSUM_ERROR, snapshot_.read_file(items, item_cnt));
+  ASSERT_TRUE(NULL == items);
+  ASSERT_EQ(0, item_cnt);
+
+  // a checksum which does not match the items
+  ASSERT_EQ(OB_SUCCESS, snapshot_.write_file(items_, ITEM_CNT));
+  ObBlockCacheSnapshotHeader header;
+  header.item_cnt_ = ITEM_CNT;
+  header.items_checksum_ = static_cast<int64_t>(ob_crc64(items_, sizeof(items_))) + 1;
+  write_at(0, &header, header_size);
+  ASSERT_EQ(OB_CHECKSUM_ERROR, snapshot_.read_file(items, item_cnt));
+  ASSERT_TRUE(NULL == items);
+
+  // a bad magic or version
+  header.items_checksum_ = static_cast<int64_t>(ob_crc64(items_, sizeof(items_)));
+  header.magic_ = 0;
+  write_at(0, &header, header_size);
+  ASSERT_EQ(OB_INVALID_DATA, snapshot_.read_file(items, item_cnt));
+  header.magic_ = ObBlockCacheSnapshotHeader::SNAPSHOT_MAGIC;
+  header.version_ = ObBlockCacheSnapshotHeader::SNAPSHOT_VERSION + 1;
+  write_at(0, &header, header_size);
+  ASSERT_EQ(OB_INVALID_DATA, snapshot_.read_file(items, item_cnt));
+  ASSERT_TRUE(NULL == items);
+}
+
+TEST_F(TestBlockCacheSnapshotFile, truncated)
+{
+  ObBlockCacheSnapshotItem* items = NULL;
+  int64_t item_cnt = 0;
+  const int64_t header_size = sizeof(ObBlockCacheSnapshotHeader);
+
+  // the last item is lost
+  ASSERT_EQ(OB_SUCCESS, snapshot_.write_file(items_, ITEM_CNT));
+  ASSERT_EQ(0, ::truncate(SNAPSHOT_FILE, header_size + sizeof(items_) - 1));
+  ASSERT_EQ(OB_IO_ERROR, snapshot_.read_file(items, item_cnt));
+  ASSERT_TRUE(NULL == items);
+  ASSERT_EQ(0, item_cnt);
+
+  // the header is lost
+  ASSERT_EQ(0, ::truncate(SNAPSHOT_FILE, header_size - 1));
+  ASSERT_EQ(OB_IO_ERROR, snapshot_.read_file(items, item_cnt));
+  ASSERT_TRUE(NULL == items);
+}
+
+// collecting and loading the micro blocks of the user block cache
+class TestMicroBlockCacheSnapshot : public TestDataFilePrepare {
+public:
+  TestMicroBlockCacheSnapshot();
+  virtual ~TestMicroBlockCacheSnapshot();
+  virtual void SetUp();
+  virtual void TearDown();
+
+protected:
+  static const int64_t TEST_COLUMN_CNT = 3;
+  void prepare_schema();
+  void prepare_macro_block();
+  ObMicroBlockCache& block_cache()
+  {
+    return OB_STORE_CACHE.get_block_cache();
+  }
+  ObTableSchema table_schema_;
+  ObRowGenerate row_generate_;
+  ObMacroBlockWriter writer_;
+  MacroBlockId block_id_;
+  int64_t micro_offset_;
+  int64_t micro_size_;
+  ObMicroBlockCacheSnapshot snapshot_;
+};
+
+TestMicroBlockCacheSnapshot::TestMicroBlockCacheSnapshot()
+    : TestDataFilePrepare("TestMicroBlockCacheSnapshot"), micro_offset_(0), micro_size_(0)
+{
+  ObAddr self;
+  rpc::frame::ObReqTransport req_transport(NULL, NULL);
+  obrpc::ObSrvRpcProxy rpc_proxy;
+  obrpc::ObCommonRpcProxy common_rpc;
+  share::ObRsMgr rs_mgr;
+  int64_t tenant_id = 1;
+  self.set_ip_addr("127.0.0.1", 8086);
+  ObTenantManager::get_instance().init(
+      self, rpc_proxy, common_rpc, rs_mgr, &req_transport, &ObServerConfig::get_instance());
+  ObTenantManager::get_instance().add_tenant(tenant_id);
+  ObTenantManager::get_instance().set_tenant_mem_limit(
+      tenant_id, 2L * 1024L * 1024L * 1024L, 4L * 1024L * 1024L * 1024L);
+}
+
+TestMicroBlockCacheSnapshot::~TestMicroBlockCacheSnapshot()
+{}
+
+void TestMicroBlockCacheSnapshot::SetUp()
+{
+  TestDataFilePrepare::SetUp();
+  ::unlink(SNAPSHOT_FILE);
+  ASSERT_EQ(OB_SUCCESS, snapshot_.init(SNAPSHOT_FILE, block_cache()));
+  prepare_schema();
+  prepare_macro_block();
+}
+
+void TestMicroBlockCacheSnapshot::TearDown()
+{
+  snapshot_.destroy();
+  writer_.reset();
+  ::unlink(SNAPSHOT_FILE);
+  TestDataFilePrepare::TearDown();
+}
+
+void TestMicroBlockCacheSnapshot::prepare_schema()
+{
+  ObColumnSchemaV2 column;
+  char name[OB_MAX_FILE_NAME_LENGTH];
+  table_schema_.reset();
+  ASSERT_EQ(OB_SUCCESS, table_schema_.set_table_name("test_micro_block_cache_snapshot"));
+  table_schema_.set_tenant_id(1);
+  table_schema_.set_tablegroup_id(1);
+  table_schema_.set_database_id(1);
+  table_schema_.set_table_id(combine_id(1, TABLE_ID));
+  table_schema_.set_rowkey_column_num(1);
+  table_schema_.set_max_used_column_id(TEST_COLUMN_CNT + OB_APP_MIN_COLUMN_ID);
+  table_schema_.set_block_size(8 * 1024);
+  table_schema_.set_compress_func_name("none");
+  table_schema_.set_storage_format_version(OB_STORAGE_FORMAT_VERSION_V4);
+  for (int64_t i = 0; i < TEST_COLUMN_CNT; ++i) {
+    column.reset();
+    column.set_table_id(combine_id(1, TABLE_ID));
+    column.set_column_id(i + OB_APP_MIN_COLUMN_ID);
+    sprintf(name, "c%ld", i);
+    ASSERT_EQ(OB_SUCCESS, column.set_column_name(name));
+    column.set_data_type(ObIntType);
+    column.set_collation_type(CS_TYPE_BINARY);
+    column.set_rowkey_position(0 == i ? 1 : 0);
+    ASSERT_EQ(OB_SUCCESS, table_schema_.add_column(column));
+  }
+}
+
+// one macro block holding a single micro block
+void TestMicroBlockCacheSnapshot::prepare_macro_block()
+{
+  const int64_t data_version = 1;
+  ObMacroDataSeq start_seq(0);
+  ObDataStoreDesc desc;
+  ObStoreRow row;
+  ObObj cells[TEST_COLUMN_CNT];
+  row.row_val_.assign(cells, TEST_COLUMN_CNT);
+
+  ObPGKey pg_key(combine_id(1, table_schema_.get_tablegroup_id()), 1, table_schema_.get_partition_cnt());
+  ObIPartitionGroupGuard pg_guard;
+  ObStorageFile* file = NULL;
+  ASSERT_EQ(OB_SUCCESS, ObFileSystemUtil::get_pg_file_with_guard(pg_key, pg_guard, file));
+  ASSERT_EQ(OB_SUCCESS,
+      desc.init(table_schema_,
+          data_version,
+          NULL,
+          1,
+          MAJOR_MERGE,
+          true,
+          true,
+          pg_key,
+          pg_guard.get_partition_group()->get_storage_file_handle()));
+  ASSERT_EQ(OB_SUCCESS, writer_.open(desc, start_seq));
+  ASSERT_EQ(OB_SUCCESS, SLOGGER.begin(OB_LOG_CS_DAILY_MERGE));
+  ASSERT_EQ(OB_SUCCESS, row_generate_.init(table_schema_));
+  for (int64_t seed = 0; seed < 16; ++seed) {
+    ASSERT_EQ(OB_SUCCESS, row_generate_.get_next_row(seed, row));
+    ASSERT_EQ(OB_SUCCESS, writer_.append_row(row));
+  }
+  ASSERT_EQ(OB_SUCCESS, writer_.close());
+  int64_t lsn = 0;
+  ASSERT_EQ(OB_SUCCESS, SLOGGER.commit(lsn));
+
+  const ObMacroBlocksWriteCtx& write_ctx = writer_.get_macro_block_write_ctx();
+  ASSERT_EQ(1, write_ctx.get_macro_block_count());
+  const ObMacroBlockMetaV2* meta = write_ctx.macro_block_meta_list_.at(0).meta_;
+  ASSERT_TRUE(NULL != meta);
+  ASSERT_EQ(1, meta->micro_block_count_);
+  block_id_ = write_ctx.macro_block_list_.at(0);
+  micro_offset_ = meta->micro_block_data_offset_;
+  micro_size_ = meta->micro_block_index_offset_ - meta->micro_block_data_offset_;
+}
+
+TEST_F(TestMicroBlockCacheSnapshot, top_k_by_get_count)
+{
+  static const int64_t KEY_CNT = 20;
+  static const int64_t MAX_CNT = 4;
+  const uint64_t table_id = combine_id(1, TABLE_ID);
+  char data[64] = "micro block";
+  const ObMicroBlockCacheValue value(data, sizeof(data));
+  // key i is read i times, the trimming at twice MAX_CNT happens while iterating
+  for (int64_t i = 0; i < KEY_CNT; ++i) {
+    const ObMicroBlockCacheKey key(table_id, MacroBlockId(i + 2), 0, 0, sizeof(data));
+    ASSERT_EQ(OB_SUCCESS, block_cache().put(key, value));
+    for (int64_t j = 0; j < i; ++j) {
+      const ObMicroBlockCacheValue* pvalue = NULL;
+      ObKVCacheHandle handle;
+      ASSERT_EQ(OB_SUCCESS, block_cache().get(key, pvalue, handle));
+    }
+  }
+
+  ObBlockCacheSnapshotItem items[MAX_CNT * 2];
+  int64_t item_cnt = 0;
+  ASSERT_EQ(OB_SUCCESS, snapshot_.collect_items(MAX_CNT, items, item_cnt));
+  ASSERT_EQ(MAX_CNT, item_cnt);
+  for (int64_t i = 0; i < item_cnt; ++i) {
+    const int64_t expect_key = KEY_CNT - 1 - i;
+    ASSERT_EQ(expect_key, items[i].get_cnt_);
+    ASSERT_EQ(expect_key + 2, items[i].block_id_.block_index());
+    ASSERT_EQ(table_id, items[i].table_id_);
+    ASSERT_EQ(static_cast<int64_t>(sizeof(data)), items[i].size_);
+  }
+
+  // the whole cache fits
+  ObBlockCacheSnapshotItem all_items[KEY_CNT * 2];
+  ASSERT_EQ(OB_SUCCESS, snapshot_.collect_items(KEY_CNT, all_items, item_cnt));
+  ASSERT_EQ(KEY_CNT, item_cnt);
+  for (int64_t i = 0; i < item_cnt; ++i) {
+    ASSERT_EQ(KEY_CNT - 1 - i, all_items[i].get_cnt_);
+  }
+}
+
+TEST_F(TestMicroBlockCacheSnapshot, skip_freed_and_reused_blocks)
+{
+  const uint64_t table_id = combine_id(1, TABLE_ID);
+  char compressor_name[OB_MAX_HEADER_COMPRESSOR_NAME_LENGTH];
+  uint64_t block_table_id = OB_INVALID_ID;
+  ObBlockCacheSnapshotItem items[4];
+  ObMicroBlockCacheSnapshot::LoadRead reads[2];
+
+  // the micro block written above
+  items[0].table_id_ = table_id;
+  items[0].block_id_ = block_id_;
+  items[0].offset_ = micro_offset_;
+  items[0].size_ = micro_size_;
+  // a free macro block
+  items[1] = items[0];
+  items[1].block_id_ = MacroBlockId(block_id_.block_index() + 10);
+  // a stale micro block of the table which used the macro block before
+  items[2] = items[0];
+  items[2].table_id_ = combine_id(1, TABLE_ID + 1);
+  // the macro block has been rewritten, no micro block at the offset any more
+  items[3] = items[0];
+  items[3].offset_ = 0;
+
+  ASSERT_EQ(OB_SUCCESS, snapshot_.read_compressor(block_id_, block_table_id, compressor_name));
+  ASSERT_EQ(table_id, block_table_id);
+  ASSERT_EQ(0, STRCMP("none", compressor_name));
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, snapshot_.read_compressor(items[1].block_id_, block_table_id, compressor_name));
+
+  ASSERT_EQ(OB_SUCCESS, snapshot_.load_batch(items, 4, reads, 2, ObTimeUtility::current_time()));
+  ASSERT_EQ(1, snapshot_.load_cnt_);
+  ASSERT_EQ(3, snapshot_.skip_cnt_);
+
+  const ObMicroBlockCacheValue* value = NULL;
+  ObKVCacheHandle handle;
+  const ObMicroBlockCacheKey loaded_key(table_id, block_id_, 0, micro_offset_, micro_size_);
+  ASSERT_EQ(OB_SUCCESS, block_cache().get(loaded_key, value, handle));
+  ASSERT_TRUE(NULL != value);
+  handle.reset();
+  const ObMicroBlockCacheKey freed_key(table_id, MacroBlockId(block_id_.block_index() + 10), 0, micro_offset_,
+      micro_size_);
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, block_cache().get(freed_key, value, handle));
+  const ObMicroBlockCacheKey stale_key(combine_id(1, TABLE_ID + 1), block_id_, 0, micro_offset_, micro_size_);
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, block_cache().get(stale_key, value, handle));
+  const ObMicroBlockCacheKey rewritten_key(table_id, block_id_, 0, 0, micro_size_);
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, block_cache().get(rewritten_key, value, handle));
+}
+
+}  // end namespace unittest
+}  // end namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  system("rm -f test_micro_block_cache_snapshot.log*");
+  OB_LOGGER.set_file_name("test_micro_block_cache_snapshot.log", true, true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,310 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+
+#define private public
+#define protected public
+#include "storage/blocksstable/ob_micro_block_encoder.h"
+#include "storage/blocksstable/ob_micro_block_decoder.h"
+#include "storage/ob_i_store.h"
+#include "ob_row_generate.h"
+#include "storage/blocksstable/ob_column_map.h"
+#include "common/rowkey/ob_rowkey.h"
+
+namespace oceanbase {
+using namespace common;
+using namespace blocksstable;
+using namespace storage;
+using namespace share::schema;
+
+namespace unittest {
+class TestMicroBlockEncoder : public ::testing::Test {
+public:
+  static const int64_t rowkey_column_count = 2;
+  // Every ObObjType from ObTinyIntType to ObHexStringType inclusive.
+  static const int64_t column_num = ObHexStringType;
+  static const int64_t macro_block_size = 2L * 1024 * 1024L;
+  static const int64_t test_row_num = 100;
+
+public:
+  TestMicroBlockEncoder() : allocator_(ObModIds::TEST)
+  {}
+  void SetUp();
+  virtual void TearDown()
+  {}
+  void reset_row()
+  {
+    row_.row_val_.cells_ = reinterpret_cast<ObObj*>(obj_buf_);
+    row_.row_val_.count_ = column_num;
+  }
+  void init_column_map();
+  // build encoded block of test_row_num rows, non-rowkey columns only have %distinct_cnt values if > 0.
+  void build_block(const int64_t distinct_cnt, ObMicroBlockEncoder& encoder, char*& buf, int64_t& size);
+  void check_rows(const int64_t distinct_cnt, ObMicroBlockDecoder& decoder);
+
+protected:
+  ObRowGenerate row_generate_;
+  ObColumnMap column_map_;
+  ObArenaAllocator allocator_;
+  ObStoreRow row_;
+  char obj_buf_[common::OB_ROW_MAX_COLUMNS_COUNT * sizeof(ObObj)];
+};
+
+void TestMicroBlockEncoder::SetUp()
+{
+  const int64_t table_id = 3001;
+  ObTableSchema table_schema;
+  ObColumnSchemaV2 column;
+  table_schema.reset();
+  ASSERT_EQ(OB_SUCCESS, table_schema.set_table_name("test_micro_block_encoder"));
+  table_schema.set_tenant_id(1);
+  table_schema.set_tablegroup_id(1);
+  table_schema.set_database_id(1);
+  table_schema.set_table_id(table_id);
+  table_schema.set_rowkey_column_num(rowkey_column_count);
+  table_schema.set_max_used_column_id(column_num);
+  char name[OB_MAX_FILE_NAME_LENGTH];
+  memset(name, 0, sizeof(name));
+  // rowkey columns (ObIntType, ObUTinyIntType) are stored first, the same as rows of sstable
+  ObObjType obj_types[column_num];
+  obj_types[0] = ObIntType;
+  obj_types[1] = ObUTinyIntType;
+  for (int64_t i = 0, pos = rowkey_column_count; i < column_num; ++i) {
+    const ObObjType obj_type = static_cast<ObObjType>(i + 1);
+    if (ObIntType != obj_type && ObUTinyIntType != obj_type) {
+      obj_types[pos++] = obj_type;
+    }
+  }
+  for (int64_t i = 0; i < column_num; ++i) {
+    ObObjType obj_type = obj_types[i];
+    column.reset();
+    column.set_table_id(table_id);
+    column.set_column_id(i + OB_APP_MIN_COLUMN_ID);
+    sprintf(name, "test%020ld", i);
+    ASSERT_EQ(OB_SUCCESS, column.set_column_name(name));
+    column.set_collation_type(common::CS_TYPE_UTF8MB4_GENERAL_CI);
+    column.set_data_type(obj_type);
+    if (obj_type == common::ObIntType) {
+      column.set_rowkey_position(1);
+    } else if (obj_type == common::ObUTinyIntType) {
+      column.set_rowkey_position(2);
+    } else {
+      column.set_rowkey_position(0);
+    }
+    ASSERT_EQ(OB_SUCCESS, table_schema.add_column(column));
+  }
+  ASSERT_EQ(OB_SUCCESS, row_generate_.init(table_schema));
+  init_column_map();
+}
+
+void TestMicroBlockEncoder::init_column_map()
+{
+  ObArray<ObColDesc> columns;
+  ASSERT_EQ(OB_SUCCESS, row_generate_.get_schema().get_column_ids(columns));
+  ASSERT_EQ(OB_SUCCESS,
+      column_map_.init(allocator_,
+          row_generate_.get_schema().get_schema_version(),
+          row_generate_.get_schema().get_rowkey_column_num(),
+          column_num,
+          columns));
+}
+
+void TestMicroBlockEncoder::build_block(
+    const int64_t distinct_cnt, ObMicroBlockEncoder& encoder, char*& buf, int64_t& size)
+{
+  ObObj objs[column_num];
+  ObObj value_objs[column_num];
+  ObStoreRow row;
+  ObStoreRow value_row;
+  ASSERT_EQ(OB_SUCCESS, encoder.init(macro_block_size, rowkey_column_count, column_num));
+  for (int64_t i = 0; i < test_row_num; ++i) {
+    row.row_val_.cells_ = objs;
+    row.row_val_.count_ = column_num;
+    ASSERT_EQ(OB_SUCCESS, row_generate_.get_next_row(i, row));
+    if (distinct_cnt > 0) {
+      value_row.row_val_.cells_ = value_objs;
+      value_row.row_val_.count_ = column_num;
+      ASSERT_EQ(OB_SUCCESS, row_generate_.get_next_row(i % distinct_cnt, value_row));
+      for (int64_t j = 0; j < column_num; ++j) {
+        if (ObIntType != objs[j].get_type() && ObUTinyIntType != objs[j].get_type()) {
+          objs[j] = value_objs[j];
+        }
+      }
+    }
+    ASSERT_EQ(OB_SUCCESS, encoder.append_row(row));
+  }
+  ASSERT_EQ(test_row_num, encoder.get_row_count());
+  ASSERT_EQ(OB_SUCCESS, encoder.build_block(buf, size));
+  ASSERT_EQ(size, encoder.get_block_size());
+}
+
+void TestMicroBlockEncoder::check_rows(const int64_t distinct_cnt, ObMicroBlockDecoder& decoder)
+{
+  ObObj objs[column_num];
+  ObStoreRow row;
+  row.row_val_.cells_ = objs;
+  for (int64_t i = 0; i < test_row_num; ++i) {
+    reset_row();
+    ASSERT_EQ(OB_SUCCESS, decoder.get_row(i, row_));
+    row.row_val_.count_ = column_num;
+    ASSERT_EQ(OB_SUCCESS, row_generate_.get_next_row(i, row));
+    ObObj value_objs[column_num];
+    ObStoreRow value_row;
+    value_row.row_val_.cells_ = value_objs;
+    value_row.row_val_.count_ = column_num;
+    ASSERT_EQ(OB_SUCCESS, row_generate_.get_next_row(distinct_cnt > 0 ? i % distinct_cnt : i, value_row));
+    for (int64_t j = 0; j < column_num; ++j) {
+      const ObObj& expect = (ObIntType == objs[j].get_type() || ObUTinyIntType == objs[j].get_type())
+                                ? objs[j]
+                                : value_objs[j];
+      ASSERT_TRUE(row_.row_val_.cells_[j] == expect)
+          << "\n i: " << i << " j: " << j << "\n decoder:  " << to_cstring(row_.row_val_.cells_[j])
+          << "\n expect:  " << to_cstring(expect);
+    }
+  }
+}
+
+TEST_F(TestMicroBlockEncoder, test_encode_decode)
+{
+  ObMicroBlockEncoder encoder;
+  char* buf = NULL;
+  int64_t size = 0;
+  build_block(0, encoder, buf, size);
+
+  ObMicroBlockDecoder decoder;
+  ObMicroBlockData block(buf, size);
+  ASSERT_EQ(OB_SUCCESS, decoder.init(block, &column_map_));
+  int64_t row_count = 0;
+  ASSERT_EQ(OB_SUCCESS, decoder.get_row_count(row_count));
+  ASSERT_EQ(test_row_num, row_count);
+  check_rows(0, decoder);
+
+  // find bound of every rowkey
+  ObObj objs[column_num];
+  ObStoreRow row;
+  for (int64_t i = 0; i < test_row_num; ++i) {
+    row.row_val_.cells_ = objs;
+    row.row_val_.count_ = column_num;
+    ASSERT_EQ(OB_SUCCESS, row_generate_.get_next_row(i, row));
+    ObStoreRowkey rowkey(objs, rowkey_column_count);
+    int64_t row_idx = ObIMicroBlockReader::INVALID_ROW_INDEX;
+    bool equal = false;
+    ASSERT_EQ(OB_SUCCESS, decoder.find_bound(rowkey, true, decoder.begin(), decoder.end(), row_idx, equal));
+    ASSERT_EQ(i, row_idx);
+    ASSERT_TRUE(equal);
+    ASSERT_EQ(OB_SUCCESS, decoder.find_bound(rowkey, false, decoder.begin(), decoder.end(), row_idx, equal));
+    ASSERT_EQ(i + 1, row_idx);
+  }
+
+  // batch get rows
+  const int64_t batch_row_capacity = ObIMicroBlockReader::OB_MAX_BATCH_ROW_COUNT;
+  ObStoreRow batch_rows[batch_row_capacity];
+  ObObj* batch_objs = reinterpret_cast<ObObj*>(allocator_.alloc(batch_row_capacity * column_num * sizeof(ObObj)));
+  ASSERT_TRUE(NULL != batch_objs);
+  for (int64_t i = 0; i < batch_row_capacity; ++i) {
+    batch_rows[i].row_val_.cells_ = batch_objs + column_num * i;
+    batch_rows[i].row_val_.count_ = column_num;
+  }
+  int64_t batch_count = 0;
+  ASSERT_EQ(OB_SUCCESS, decoder.get_rows(0, test_row_num, batch_row_capacity, batch_rows, batch_count));
+  ASSERT_EQ(MIN(batch_row_capacity, test_row_num), batch_count);
+  for (int64_t i = 0; i < batch_count; ++i) {
+    bool exist = false;
+    ASSERT_EQ(OB_SUCCESS, row_generate_.check_one_row(batch_rows[i], exist));
+    ASSERT_TRUE(exist) << "i: " << i;
+  }
+}
+
+TEST_F(TestMicroBlockEncoder, test_repeated_values)
+{
+  const int64_t distinct_cnt = 3;
+  ObMicroBlockEncoder encoder;
+  char* buf = NULL;
+  int64_t size = 0;
+  build_block(distinct_cnt, encoder, buf, size);
+
+  ObMicroBlockDecoder decoder;
+  ObMicroBlockData block(buf, size);
+  ASSERT_EQ(OB_SUCCESS, decoder.init(block, &column_map_));
+  check_rows(distinct_cnt, decoder);
+
+  // columns with few distinct values are encoded with dictionary
+  int64_t dict_column_cnt = 0;
+  for (int64_t j = 0; j < column_num; ++j) {
+    const ObColumnDecoder& column_decoder = decoder.block_.get_decoder(j);
+    if (column_decoder.has_dict()) {
+      ++dict_column_cnt;
+      ASSERT_LE(column_decoder.get_dict_count(), distinct_cnt);
+      for (int64_t i = 0; i < test_row_num; ++i) {
+        ObObj dict_cell;
+        ObObj cell;
+        ASSERT_EQ(OB_SUCCESS, column_decoder.decode_dict(column_decoder.get_ref(i), dict_cell));
+        ASSERT_EQ(OB_SUCCESS, column_decoder.decode(i, allocator_, cell));
+        ASSERT_TRUE(dict_cell == cell);
+      }
+    }
+  }
+  ASSERT_LT(0, dict_column_cnt);
+}
+
+TEST_F(TestMicroBlockEncoder, test_const_and_integer)
+{
+  ObMicroBlockEncoder encoder;
+  ASSERT_EQ(OB_SUCCESS, encoder.init(macro_block_size, 1, 3));
+  ObObj objs[3];
+  ObStoreRow row;
+  row.row_val_.cells_ = objs;
+  row.row_val_.count_ = 3;
+  row.flag_ = ObActionFlag::OP_ROW_EXIST;
+  for (int64_t i = 0; i < test_row_num; ++i) {
+    objs[0].set_int(1000 + i);
+    objs[1].set_int(7);
+    if (0 == i % 10) {
+      objs[2].set_null();
+    } else {
+      objs[2].set_int(-i);
+    }
+    ASSERT_EQ(OB_SUCCESS, encoder.append_row(row));
+  }
+  char* buf = NULL;
+  int64_t size = 0;
+  ASSERT_EQ(OB_SUCCESS, encoder.build_block(buf, size));
+
+  ObEncodedMicroBlock block;
+  ASSERT_EQ(OB_SUCCESS, block.init(ObMicroBlockData(buf, size), allocator_));
+  ASSERT_EQ(OB_COLUMN_ENCODING_INTEGER, block.get_decoder(0).header_->type_);
+  ASSERT_EQ(OB_COLUMN_ENCODING_CONST, block.get_decoder(1).header_->type_);
+  for (int64_t i = 0; i < test_row_num; ++i) {
+    ObObj cell;
+    ASSERT_EQ(OB_SUCCESS, block.decode_cell(0, i, allocator_, cell));
+    ASSERT_EQ(1000 + i, cell.get_int());
+    ASSERT_EQ(OB_SUCCESS, block.decode_cell(1, i, allocator_, cell));
+    ASSERT_EQ(7, cell.get_int());
+    ASSERT_EQ(OB_SUCCESS, block.decode_cell(2, i, allocator_, cell));
+    if (0 == i % 10) {
+      ASSERT_TRUE(cell.is_null());
+    } else {
+      ASSERT_EQ(-i, cell.get_int());
+    }
+  }
+}
+
+}  // end namespace unittest
+}  // end namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
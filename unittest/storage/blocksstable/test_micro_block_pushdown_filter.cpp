@@ -0,0 +1,428 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+
+#define private public
+#define protected public
+#include "sql/engine/basic/ob_pushdown_filter.h"
+#include "storage/blocksstable/ob_micro_block_writer.h"
+#include "storage/blocksstable/ob_micro_block_reader.h"
+#include "storage/blocksstable/ob_micro_block_row_scanner.h"
+#include "storage/blocksstable/ob_column_map.h"
+#include "storage/ob_i_store.h"
+#include "lib/container/ob_bitmap.h"
+
+namespace oceanbase {
+using namespace common;
+using namespace blocksstable;
+using namespace storage;
+using namespace share::schema;
+using namespace sql;
+
+namespace unittest {
+static const int64_t rowkey_column_count = 1;
+static const int64_t column_num = 2;
+static const int64_t macro_block_size = 2L * 1024 * 1024;
+static const int64_t block_row_count = 10;
+static const uint64_t filter_column_id = OB_APP_MIN_COLUMN_ID + 1;
+
+// c1 int primary key, c2 int, c2 is NULL in every 5th row and i otherwise
+class TestMicroBlockPushdownFilter : public ::testing::Test {
+public:
+  TestMicroBlockPushdownFilter() : allocator_(ObModIds::TEST)
+  {}
+  virtual void SetUp();
+  virtual void TearDown()
+  {}
+
+protected:
+  void build_block(const int64_t start_row, ObMicroBlockData& block);
+  ObWhiteFilterExecutor* make_white_filter(const ObWhiteFilterOperatorType op_type, const int64_t* params,
+      const int64_t param_count, const bool null_param = false);
+  ObPushdownFilterExecutor* make_logic_filter(
+      const bool is_and, ObPushdownFilterExecutor* left, ObPushdownFilterExecutor* right);
+  void check_filter(const ObWhiteFilterExecutor& filter, const ObObj& obj, const bool expect_filtered);
+  void check_bitmap(ObPushdownFilterExecutor& filter, const ObMicroBlockData& block, const int64_t start_row,
+      const int64_t* expect_rows, const int64_t expect_count);
+  static bool is_null_row(const int64_t i)
+  {
+    return 4 == i % 5;
+  }
+
+protected:
+  ObArenaAllocator allocator_;
+  ObColumnMap column_map_;
+  ObSEArray<ObColumnParam*, 1> col_params_;
+};
+
+void TestMicroBlockPushdownFilter::SetUp()
+{
+  ObSEArray<ObColDesc, column_num> cols;
+  for (int64_t i = 0; i < column_num; ++i) {
+    ObColDesc col;
+    col.col_id_ = OB_APP_MIN_COLUMN_ID + i;
+    col.col_type_.set_int();
+    col.col_order_ = ObOrderType::ASC;
+    ASSERT_EQ(OB_SUCCESS, cols.push_back(col));
+  }
+  ASSERT_EQ(OB_SUCCESS, column_map_.init(allocator_, 1 /*schema version*/, rowkey_column_count, column_num, cols));
+}
+
+void TestMicroBlockPushdownFilter::build_block(const int64_t start_row, ObMicroBlockData& block)
+{
+  ObMicroBlockWriter* writer = OB_NEWx(ObMicroBlockWriter, (&allocator_));
+  ASSERT_TRUE(nullptr != writer);
+  ASSERT_EQ(OB_SUCCESS, writer->init(macro_block_size, rowkey_column_count, column_num));
+  ObObj cells[column_num];
+  ObStoreRow row;
+  row.flag_ = ObActionFlag::OP_ROW_EXIST;
+  row.row_val_.cells_ = cells;
+  row.row_val_.count_ = column_num;
+  for (int64_t i = start_row; i < start_row + block_row_count; ++i) {
+    cells[0].set_int(i);
+    if (is_null_row(i)) {
+      cells[1].set_null();
+    } else {
+      cells[1].set_int(i);
+    }
+    ASSERT_EQ(OB_SUCCESS, writer->append_row(row));
+  }
+  char* buf = nullptr;
+  int64_t size = 0;
+  ASSERT_EQ(OB_SUCCESS, writer->build_block(buf, size));
+  block = ObMicroBlockData(buf, size);
+}
+
+ObWhiteFilterExecutor* TestMicroBlockPushdownFilter::make_white_filter(
+    const ObWhiteFilterOperatorType op_type, const int64_t* params, const int64_t param_count, const bool null_param)
+{
+  ObPushdownWhiteFilterNode* node = OB_NEWx(ObPushdownWhiteFilterNode, (&allocator_), allocator_);
+  ObWhiteFilterExecutor* filter = nullptr;
+  if (nullptr != node) {
+    node->set_type(PushdownFilterType::WHITE_FILTER);
+    node->op_type_ = op_type;
+    if (OB_SUCCESS != node->col_ids_.init(1) || OB_SUCCESS != node->col_ids_.push_back(filter_column_id)) {
+    } else if (nullptr != (filter = OB_NEWx(ObWhiteFilterExecutor, (&allocator_), allocator_, *node))) {
+      filter->set_type(WHITE_FILTER_EXECUTOR);
+      filter->cs_type_ = CS_TYPE_BINARY;
+      EXPECT_EQ(OB_SUCCESS, filter->params_.init(param_count + (null_param ? 1 : 0)));
+      for (int64_t i = 0; i < param_count; ++i) {
+        ObObj param;
+        param.set_int(params[i]);
+        EXPECT_EQ(OB_SUCCESS, filter->params_.push_back(param));
+      }
+      if (null_param) {
+        ObObj param;
+        param.set_null();
+        EXPECT_EQ(OB_SUCCESS, filter->params_.push_back(param));
+      }
+    }
+  }
+  return filter;
+}
+
+ObPushdownFilterExecutor* TestMicroBlockPushdownFilter::make_logic_filter(
+    const bool is_and, ObPushdownFilterExecutor* left, ObPushdownFilterExecutor* right)
+{
+  ObPushdownFilterExecutor* filter = nullptr;
+  ObPushdownFilterExecutor** childs =
+      static_cast<ObPushdownFilterExecutor**>(allocator_.alloc(2 * sizeof(ObPushdownFilterExecutor*)));
+  if (nullptr == childs) {
+  } else if (is_and) {
+    ObPushdownAndFilterNode* node = OB_NEWx(ObPushdownAndFilterNode, (&allocator_), allocator_);
+    filter = OB_NEWx(ObAndFilterExecutor, (&allocator_), allocator_, *node);
+    filter->set_type(AND_FILTER_EXECUTOR);
+  } else {
+    ObPushdownOrFilterNode* node = OB_NEWx(ObPushdownOrFilterNode, (&allocator_), allocator_);
+    filter = OB_NEWx(ObOrFilterExecutor, (&allocator_), allocator_, *node);
+    filter->set_type(OR_FILTER_EXECUTOR);
+  }
+  if (nullptr != filter) {
+    childs[0] = left;
+    childs[1] = right;
+    filter->childs_ = childs;
+    filter->n_child_ = 2;
+  }
+  return filter;
+}
+
+void TestMicroBlockPushdownFilter::check_filter(
+    const ObWhiteFilterExecutor& filter, const ObObj& obj, const bool expect_filtered)
+{
+  bool filtered = !expect_filtered;
+  ASSERT_EQ(OB_SUCCESS, filter.filter(obj, filtered));
+  ASSERT_EQ(expect_filtered, filtered) << "filter: " << to_cstring(filter) << " obj: " << to_cstring(obj);
+}
+
+void TestMicroBlockPushdownFilter::check_bitmap(ObPushdownFilterExecutor& filter, const ObMicroBlockData& block,
+    const int64_t start_row, const int64_t* expect_rows, const int64_t expect_count)
+{
+  ObMicroBlockReader reader;
+  ObBitmap bitmap(allocator_);
+  ASSERT_EQ(OB_SUCCESS, reader.init(block, &column_map_));
+  ASSERT_EQ(OB_SUCCESS, filter.init_filter_param(column_map_.get_cols_map(), &col_params_, false));
+  ASSERT_EQ(OB_SUCCESS, bitmap.init(block_row_count));
+  ASSERT_EQ(OB_SUCCESS,
+      reader.filter_pushdown_filter(
+          static_cast<ObWhiteFilterExecutor&>(filter), filter.get_col_offsets()[0], 0, block_row_count, bitmap));
+  int64_t idx = 0;
+  for (int64_t i = 0; i < block_row_count; ++i) {
+    const bool expect_selected = idx < expect_count && expect_rows[idx] == start_row + i;
+    ASSERT_EQ(expect_selected, bitmap.test(i)) << "row: " << start_row + i;
+    if (expect_selected) {
+      ++idx;
+    }
+  }
+  ASSERT_EQ(expect_count, idx);
+}
+
+TEST_F(TestMicroBlockPushdownFilter, white_filter_ops)
+{
+  ObObj null_obj;
+  ObObj nop_obj;
+  ObObj obj;
+  null_obj.set_null();
+  nop_obj.set_nop_value();
+  const int64_t one_param[] = {5};
+  const int64_t bt_params[] = {3, 6};
+  const int64_t in_params[] = {2, 7, 9};
+
+  ObWhiteFilterExecutor* eq = make_white_filter(WHITE_OP_EQ, one_param, 1);
+  ObWhiteFilterExecutor* le = make_white_filter(WHITE_OP_LE, one_param, 1);
+  ObWhiteFilterExecutor* lt = make_white_filter(WHITE_OP_LT, one_param, 1);
+  ObWhiteFilterExecutor* ge = make_white_filter(WHITE_OP_GE, one_param, 1);
+  ObWhiteFilterExecutor* gt = make_white_filter(WHITE_OP_GT, one_param, 1);
+  ObWhiteFilterExecutor* bt = make_white_filter(WHITE_OP_BT, bt_params, 2);
+  ObWhiteFilterExecutor* in = make_white_filter(WHITE_OP_IN, in_params, 3);
+  ObWhiteFilterExecutor* nu = make_white_filter(WHITE_OP_NU, nullptr, 0);
+  ASSERT_TRUE(nullptr != eq && nullptr != le && nullptr != lt && nullptr != ge && nullptr != gt);
+  ASSERT_TRUE(nullptr != bt && nullptr != in && nullptr != nu);
+
+  for (int64_t v = 0; v <= 10; ++v) {
+    obj.set_int(v);
+    check_filter(*eq, obj, !(v == 5));
+    check_filter(*le, obj, !(v <= 5));
+    check_filter(*lt, obj, !(v < 5));
+    check_filter(*ge, obj, !(v >= 5));
+    check_filter(*gt, obj, !(v > 5));
+    check_filter(*bt, obj, !(v >= 3 && v <= 6));
+    check_filter(*in, obj, !(v == 2 || v == 7 || v == 9));
+    check_filter(*nu, obj, true);
+  }
+
+  // NULL column value is only selected by IS NULL
+  check_filter(*eq, null_obj, true);
+  check_filter(*le, null_obj, true);
+  check_filter(*lt, null_obj, true);
+  check_filter(*ge, null_obj, true);
+  check_filter(*gt, null_obj, true);
+  check_filter(*bt, null_obj, true);
+  check_filter(*in, null_obj, true);
+  check_filter(*nu, null_obj, false);
+
+  // column not stored, its value is filled after scan
+  check_filter(*eq, nop_obj, false);
+  check_filter(*nu, nop_obj, false);
+
+  // compare with NULL is never true
+  ObWhiteFilterExecutor* eq_null = make_white_filter(WHITE_OP_EQ, nullptr, 0, true);
+  ASSERT_TRUE(nullptr != eq_null);
+  obj.set_int(5);
+  check_filter(*eq_null, obj, true);
+  check_filter(*eq_null, null_obj, true);
+  const int64_t bt_low[] = {3};
+  ObWhiteFilterExecutor* bt_null = make_white_filter(WHITE_OP_BT, bt_low, 1, true);
+  ASSERT_TRUE(nullptr != bt_null);
+  check_filter(*bt_null, obj, true);
+  // NULL in the IN list is skipped, other values still match
+  ObWhiteFilterExecutor* in_null = make_white_filter(WHITE_OP_IN, in_params, 3, true);
+  ASSERT_TRUE(nullptr != in_null);
+  obj.set_int(7);
+  check_filter(*in_null, obj, false);
+  obj.set_int(8);
+  check_filter(*in_null, obj, true);
+
+  // string compared with the collation of the column
+  ObWhiteFilterExecutor* str_eq = make_white_filter(WHITE_OP_EQ, nullptr, 0);
+  ASSERT_TRUE(nullptr != str_eq);
+  ObObj str_param;
+  str_param.set_varchar("abc");
+  str_param.set_collation_type(CS_TYPE_UTF8MB4_GENERAL_CI);
+  ASSERT_EQ(OB_SUCCESS, str_eq->params_.init(1));
+  ASSERT_EQ(OB_SUCCESS, str_eq->params_.push_back(str_param));
+  str_eq->cs_type_ = CS_TYPE_UTF8MB4_GENERAL_CI;
+  obj.set_varchar("ABC");
+  obj.set_collation_type(CS_TYPE_UTF8MB4_GENERAL_CI);
+  check_filter(*str_eq, obj, false);
+  obj.set_varchar("abd");
+  check_filter(*str_eq, obj, true);
+}
+
+TEST_F(TestMicroBlockPushdownFilter, reader_bitmap)
+{
+  ObMicroBlockData block;
+  build_block(0, block);
+
+  const int64_t one_param[] = {5};
+  const int64_t expect_gt[] = {6, 7, 8};
+  check_bitmap(*make_white_filter(WHITE_OP_GT, one_param, 1), block, 0, expect_gt, 3);
+  const int64_t expect_le[] = {0, 1, 2, 3, 5};
+  check_bitmap(*make_white_filter(WHITE_OP_LE, one_param, 1), block, 0, expect_le, 5);
+  const int64_t in_params[] = {4, 8, 11};
+  const int64_t expect_in[] = {8};
+  check_bitmap(*make_white_filter(WHITE_OP_IN, in_params, 3), block, 0, expect_in, 1);
+  const int64_t expect_nu[] = {4, 9};
+  check_bitmap(*make_white_filter(WHITE_OP_NU, nullptr, 0), block, 0, expect_nu, 2);
+  check_bitmap(*make_white_filter(WHITE_OP_EQ, nullptr, 0, true), block, 0, nullptr, 0);
+}
+
+// scans micro blocks the way ObSSTableRowIterator does, without a sstable
+class TestFilterRowScanner : public ObMicroBlockRowScanner {
+public:
+  int init(ObTableIterParam& param, ObTableAccessContext& context, ObColumnMap& column_map)
+  {
+    int ret = OB_SUCCESS;
+    param_ = &param;
+    context_ = &context;
+    for (int64_t i = 0; i < ObIMicroBlockReader::OB_MAX_BATCH_ROW_COUNT; ++i) {
+      ObStoreRow& row = rows_[i];
+      row.row_val_.cells_ = reinterpret_cast<ObObj*>(obj_buf_) + i * OB_ROW_MAX_COLUMNS_COUNT;
+      row.row_val_.count_ = OB_ROW_MAX_COLUMNS_COUNT;
+      row.capacity_ = OB_ROW_MAX_COLUMNS_COUNT;
+    }
+    if (OB_FAIL(init_filter_param(*param.pushdown_filter_, column_map))) {
+    } else {
+      column_map_ptr_ = &column_map;
+      is_inited_ = true;
+    }
+    return ret;
+  }
+  int open_block(const ObMicroBlockData& block, const bool reverse)
+  {
+    int ret = OB_SUCCESS;
+    if (OB_FAIL(set_reader(FLAT_ROW_STORE))) {
+    } else if (OB_FAIL(flat_reader_.init(block, column_map_ptr_))) {
+    } else {
+      reverse_scan_ = reverse;
+      step_ = reverse ? -1 : 1;
+      start_ = reverse ? flat_reader_.end() - 1 : flat_reader_.begin();
+      last_ = reverse ? flat_reader_.begin() : flat_reader_.end() - 1;
+      current_ = start_;
+      ret = filter_micro_block_rows();
+    }
+    return ret;
+  }
+
+private:
+  int init_filter_param(ObPushdownFilterExecutor& filter, ObColumnMap& column_map)
+  {
+    int ret = OB_SUCCESS;
+    ObSEArray<ObColumnParam*, 1> col_params;
+    if (filter.is_filter_white_node()) {
+      ret = filter.init_filter_param(column_map.get_cols_map(), &col_params, false);
+    } else {
+      for (uint32_t i = 0; OB_SUCC(ret) && i < filter.n_child_; ++i) {
+        ret = init_filter_param(*filter.childs_[i], column_map);
+      }
+    }
+    return ret;
+  }
+
+private:
+  ObColumnMap* column_map_ptr_;
+};
+
+TEST_F(TestMicroBlockPushdownFilter, skip_rows_across_micro_blocks)
+{
+  ObMicroBlockData blocks[2];
+  build_block(0, blocks[0]);
+  build_block(block_row_count, blocks[1]);
+
+  // c2 = 3 or c2 between 12 and 16: the tail of the first block and the head of the second are skipped,
+  // the NULL row 14 is not selected
+  const int64_t eq_param[] = {3};
+  const int64_t bt_params[] = {12, 16};
+  ObPushdownFilterExecutor* filter = make_logic_filter(
+      false, make_white_filter(WHITE_OP_EQ, eq_param, 1), make_white_filter(WHITE_OP_BT, bt_params, 2));
+  // and c2 >= 0, which selects all rows but NULL
+  const int64_t ge_param[] = {0};
+  filter = make_logic_filter(true, filter, make_white_filter(WHITE_OP_GE, ge_param, 1));
+  ASSERT_TRUE(nullptr != filter);
+
+  ObTableIterParam param;
+  ObTableAccessContext context;
+  param.pushdown_filter_ = filter;
+  context.enable_pushdown_filter_ = true;
+  TestFilterRowScanner* scanner = OB_NEWx(TestFilterRowScanner, (&allocator_));
+  ASSERT_TRUE(nullptr != scanner);
+  ASSERT_EQ(OB_SUCCESS, scanner->init(param, context, column_map_));
+
+  const int64_t expect_rows[] = {3, 12, 13, 15, 16};
+  const int64_t expect_count = sizeof(expect_rows) / sizeof(expect_rows[0]);
+  // row by row
+  int64_t idx = 0;
+  for (int64_t b = 0; b < 2; ++b) {
+    ASSERT_EQ(OB_SUCCESS, scanner->open_block(blocks[b], false));
+    const ObStoreRow* row = nullptr;
+    int ret = OB_SUCCESS;
+    while (OB_SUCC(scanner->get_next_row(row))) {
+      ASSERT_LT(idx, expect_count);
+      ASSERT_EQ(expect_rows[idx++], row->row_val_.cells_[0].get_int());
+    }
+    ASSERT_EQ(OB_ITER_END, ret);
+  }
+  ASSERT_EQ(expect_count, idx);
+
+  // in batch
+  idx = 0;
+  for (int64_t b = 0; b < 2; ++b) {
+    ASSERT_EQ(OB_SUCCESS, scanner->open_block(blocks[b], false));
+    const ObStoreRow* rows = nullptr;
+    int64_t count = 0;
+    int ret = OB_SUCCESS;
+    while (OB_SUCC(scanner->get_next_rows(rows, count))) {
+      ASSERT_LT(0, count);
+      for (int64_t i = 0; i < count; ++i) {
+        ASSERT_LT(idx, expect_count);
+        ASSERT_EQ(expect_rows[idx++], rows[i].row_val_.cells_[0].get_int());
+      }
+    }
+    ASSERT_EQ(OB_ITER_END, ret);
+  }
+  ASSERT_EQ(expect_count, idx);
+
+  // reverse scan
+  idx = expect_count - 1;
+  for (int64_t b = 1; b >= 0; --b) {
+    ASSERT_EQ(OB_SUCCESS, scanner->open_block(blocks[b], true));
+    const ObStoreRow* row = nullptr;
+    int ret = OB_SUCCESS;
+    while (OB_SUCC(scanner->get_next_row(row))) {
+      ASSERT_LE(0, idx);
+      ASSERT_EQ(expect_rows[idx--], row->row_val_.cells_[0].get_int());
+    }
+    ASSERT_EQ(OB_ITER_END, ret);
+  }
+  ASSERT_EQ(-1, idx);
+}
+
+}  // end namespace unittest
+}  // end namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_file_name("test_micro_block_pushdown_filter.log", true);
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,284 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <fcntl.h>
+#define private public
+#define protected public
+#include "lib/checksum/ob_crc64.h"
+#include "storage/blocksstable/ob_micro_block_secondary_cache.h"
+#include "storage/blocksstable/ob_storage_cache_suite.h"
+#include "ob_data_file_prepare.h"
+
+namespace oceanbase {
+using namespace common;
+using namespace blocksstable;
+using namespace storage;
+
+namespace unittest {
+static const char* CACHE_FILE = "test_micro_block_secondary_cache.data";
+
+// The user block cache backed by a cache file of a few regions, micro blocks are washed into it by hand.
+class TestMicroBlockSecondaryCache : public TestDataFilePrepare {
+public:
+  static const int64_t REGION_SIZE = ObMicroBlockSecondaryCache::REGION_SIZE;
+  static const int64_t REGION_CNT = 2;
+  // a few large blocks per region, so that the index sets never overflow
+  static const int64_t BLOCK_SIZE = 255L * 1024L;
+  static const int64_t BLOCK_CNT = 64;
+  static const int64_t WAIT_TIMEOUT_US = 10L * 1000L * 1000L;
+
+  TestMicroBlockSecondaryCache();
+  virtual ~TestMicroBlockSecondaryCache();
+  virtual void SetUp();
+  virtual void TearDown();
+
+protected:
+  ObMicroBlockCache& block_cache()
+  {
+    return OB_STORE_CACHE.get_block_cache();
+  }
+  static int64_t get_blocks_per_region()
+  {
+    const int64_t record_size = upper_align(sizeof(ObSecondaryCacheRecordHeader) + BLOCK_SIZE,
+        ObMicroBlockSecondaryCache::RECORD_ALIGN_SIZE);
+    return REGION_SIZE / record_size;
+  }
+  ObMicroBlockCacheKey get_key(const int64_t idx) const
+  {
+    return ObMicroBlockCacheKey(combine_id(1, 3001), MacroBlockId(idx + 2), 0, 0, BLOCK_SIZE);
+  }
+  char* get_block(const int64_t idx)
+  {
+    MEMSET(block_buf_, static_cast<int>('a' + idx % 26), BLOCK_SIZE);
+    MEMCPY(block_buf_, &idx, sizeof(idx));
+    return block_buf_;
+  }
+  void wash(const int64_t start_idx, const int64_t end_idx);
+  void wait_flush(const int64_t write_cnt);
+  void check_read(const int64_t idx, const int expect_ret);
+
+protected:
+  char* block_buf_;
+  ObMicroBlockSecondaryCache secondary_cache_;
+};
+
+TestMicroBlockSecondaryCache::TestMicroBlockSecondaryCache()
+    : TestDataFilePrepare("TestMicroBlockSecondaryCache"), block_buf_(NULL)
+{
+  ObAddr self;
+  rpc::frame::ObReqTransport req_transport(NULL, NULL);
+  obrpc::ObSrvRpcProxy rpc_proxy;
+  obrpc::ObCommonRpcProxy common_rpc;
+  share::ObRsMgr rs_mgr;
+  int64_t tenant_id = 1;
+  self.set_ip_addr("127.0.0.1", 8086);
+  ObTenantManager::get_instance().init(
+      self, rpc_proxy, common_rpc, rs_mgr, &req_transport, &ObServerConfig::get_instance());
+  ObTenantManager::get_instance().add_tenant(tenant_id);
+  ObTenantManager::get_instance().set_tenant_mem_limit(
+      tenant_id, 2L * 1024L * 1024L * 1024L, 4L * 1024L * 1024L * 1024L);
+}
+
+TestMicroBlockSecondaryCache::~TestMicroBlockSecondaryCache()
+{}
+
+void TestMicroBlockSecondaryCache::SetUp()
+{
+  TestDataFilePrepare::SetUp();
+  ::unlink(CACHE_FILE);
+  block_buf_ = static_cast<char*>(ob_malloc(BLOCK_SIZE, ObModIds::TEST));
+  ASSERT_TRUE(NULL != block_buf_);
+  ASSERT_EQ(OB_SUCCESS, secondary_cache_.init(CACHE_FILE, REGION_CNT * REGION_SIZE, block_cache()));
+}
+
+void TestMicroBlockSecondaryCache::TearDown()
+{
+  secondary_cache_.destroy();
+  if (NULL != block_buf_) {
+    ob_free(block_buf_);
+    block_buf_ = NULL;
+  }
+  ::unlink(CACHE_FILE);
+  TestDataFilePrepare::TearDown();
+}
+
+void TestMicroBlockSecondaryCache::wash(const int64_t start_idx, const int64_t end_idx)
+{
+  for (int64_t i = start_idx; i < end_idx; ++i) {
+    const ObMicroBlockCacheKey key = get_key(i);
+    const ObMicroBlockCacheValue value(get_block(i), BLOCK_SIZE);
+    secondary_cache_.on_wash(key, value);
+  }
+  ASSERT_EQ(0, secondary_cache_.drop_cnt_);
+}
+
+void TestMicroBlockSecondaryCache::wait_flush(const int64_t write_cnt)
+{
+  const int64_t begin_ts = ObTimeUtility::current_time();
+  while (ATOMIC_LOAD(&secondary_cache_.write_cnt_) < write_cnt &&
+         ObTimeUtility::current_time() - begin_ts < WAIT_TIMEOUT_US) {
+    usleep(1000);
+  }
+  ASSERT_EQ(write_cnt, ATOMIC_LOAD(&secondary_cache_.write_cnt_));
+}
+
+void TestMicroBlockSecondaryCache::check_read(const int64_t idx, const int expect_ret)
+{
+  const ObMicroBlockCacheKey key = get_key(idx);
+  ObIODesc io_desc;
+  io_desc.category_ = USER_IO;
+  io_desc.wait_event_no_ = ObWaitEventIds::DB_FILE_DATA_READ;
+  ObIOHandle io_handle;
+  const ObMicroBlockCacheValue* value = NULL;
+  ObKVCacheHandle handle;
+  int ret = secondary_cache_.prefetch(key, io_desc, true, block_cache(), io_handle);
+  if (OB_SUCC(ret)) {
+    ret = io_handle.wait(ObMicroBlockSecondaryCache::IO_TIMEOUT_MS);
+  }
+  ASSERT_EQ(expect_ret, ret);
+  if (OB_SUCCESS == expect_ret) {
+    const ObMicroBlockData* block_data = reinterpret_cast<const ObMicroBlockData*>(io_handle.get_buffer());
+    ASSERT_TRUE(NULL != block_data);
+    ASSERT_EQ(BLOCK_SIZE, block_data->get_buf_size());
+    ASSERT_EQ(0, MEMCMP(get_block(idx), block_data->get_buf(), BLOCK_SIZE));
+    // put back into the memory tier
+    ASSERT_EQ(OB_SUCCESS, block_cache().get(key, value, handle));
+    ASSERT_EQ(0, MEMCMP(get_block(idx), value->get_block_data().get_buf(), BLOCK_SIZE));
+  } else {
+    ASSERT_EQ(OB_ENTRY_NOT_EXIST, block_cache().get(key, value, handle));
+  }
+}
+
+TEST_F(TestMicroBlockSecondaryCache, append_and_read_back)
+{
+  const int64_t block_cnt = get_blocks_per_region();
+  ASSERT_GT(block_cnt, 1);
+  // blocks are written once a region is filled
+  wash(0, block_cnt);
+  check_read(0, OB_ENTRY_NOT_EXIST);
+  ASSERT_EQ(0, secondary_cache_.write_cnt_);
+  wash(block_cnt, block_cnt + 1);
+  wait_flush(1);
+  for (int64_t i = 0; i < block_cnt; ++i) {
+    check_read(i, OB_SUCCESS);
+  }
+  ASSERT_EQ(block_cnt, secondary_cache_.hit_cnt_);
+  // still in the write buffer
+  check_read(block_cnt, OB_ENTRY_NOT_EXIST);
+  // never washed
+  check_read(BLOCK_CNT, OB_ENTRY_NOT_EXIST);
+
+  // abandoned blocks are not appended
+  const int64_t buf_idx = secondary_cache_.fill_idx_ % ObMicroBlockSecondaryCache::WRITE_BUF_CNT;
+  const int64_t buf_pos = secondary_cache_.write_buf_pos_[buf_idx];
+  const ObMicroBlockCacheValue empty_value(NULL, 0);
+  secondary_cache_.on_wash(get_key(BLOCK_CNT), empty_value);
+  ASSERT_EQ(buf_pos, secondary_cache_.write_buf_pos_[buf_idx]);
+}
+
+TEST_F(TestMicroBlockSecondaryCache, overwrite_invalidation)
+{
+  const int64_t block_cnt = get_blocks_per_region();
+  // the third region of blocks overwrites the first one in ring order
+  wash(0, REGION_CNT * block_cnt + block_cnt + 1);
+  wait_flush(REGION_CNT + 1);
+  for (int64_t i = 0; i < block_cnt; ++i) {
+    ObSecondaryCacheEntry entry;
+    ASSERT_EQ(OB_ENTRY_NOT_EXIST, secondary_cache_.get_entry(get_key(i), entry));
+    check_read(i, OB_ENTRY_NOT_EXIST);
+  }
+  for (int64_t i = block_cnt; i < (REGION_CNT + 1) * block_cnt; ++i) {
+    check_read(i, OB_SUCCESS);
+  }
+
+  // reads pin the region of a live entry, which holds off the overwrite, a stale entry can not be pinned
+  ObSecondaryCacheEntry entry;
+  ASSERT_EQ(OB_SUCCESS, secondary_cache_.get_entry(get_key(block_cnt), entry));
+  ASSERT_EQ(OB_SUCCESS, secondary_cache_.pin_region(entry));
+  ASSERT_EQ(1, secondary_cache_.regions_[entry.region_idx_].ref_cnt_);
+  secondary_cache_.unpin_region(entry.region_idx_);
+  ASSERT_EQ(0, secondary_cache_.regions_[entry.region_idx_].ref_cnt_);
+  entry.region_seq_ -= 1;
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, secondary_cache_.pin_region(entry));
+  ASSERT_EQ(0, secondary_cache_.regions_[entry.region_idx_].ref_cnt_);
+}
+
+TEST_F(TestMicroBlockSecondaryCache, reject_corrupted_record)
+{
+  const int64_t block_cnt = get_blocks_per_region();
+  wash(0, block_cnt + 1);
+  wait_flush(1);
+
+  // a flipped byte in the data of the first record
+  ObSecondaryCacheEntry entry;
+  ASSERT_EQ(OB_SUCCESS, secondary_cache_.get_entry(get_key(0), entry));
+  int fd = ::open(CACHE_FILE, O_WRONLY);
+  ASSERT_TRUE(fd >= 0);
+  const char byte = 0x5a;
+  const int64_t offset = entry.region_idx_ * REGION_SIZE + entry.offset_ + sizeof(ObSecondaryCacheRecordHeader) + 100;
+  ASSERT_EQ(1, ::pwrite(fd, &byte, 1, offset));
+  ::close(fd);
+  check_read(0, OB_CHECKSUM_ERROR);
+  ASSERT_EQ(0, secondary_cache_.regions_[entry.region_idx_].ref_cnt_);
+  check_read(1, OB_SUCCESS);
+}
+
+TEST_F(TestMicroBlockSecondaryCache, check_record)
+{
+  const int64_t data_size = 128;
+  char buf[sizeof(ObSecondaryCacheRecordHeader) + data_size];
+  char* data = buf + sizeof(ObSecondaryCacheRecordHeader);
+  const ObMicroBlockCacheKey key = get_key(0);
+  ObSecondaryCacheRecordHeader* header = new (buf) ObSecondaryCacheRecordHeader();
+  MEMSET(data, 'x', data_size);
+  header->data_size_ = data_size;
+  header->data_checksum_ = static_cast<int64_t>(ob_crc64(data, data_size));
+  header->table_id_ = key.table_id_;
+  header->block_id_ = key.block_id_;
+  header->file_id_ = key.file_id_;
+  header->offset_ = key.offset_;
+  header->size_ = key.size_;
+
+  ObSecondaryCacheIOCallback callback;
+  callback.key_ = key;
+  callback.entry_.record_size_ = static_cast<int32_t>(sizeof(buf));
+  ASSERT_EQ(OB_SUCCESS, callback.check_record(*header));
+
+  // the record of another block
+  callback.key_ = get_key(1);
+  ASSERT_EQ(OB_INVALID_DATA, callback.check_record(*header));
+  callback.key_ = key;
+  // the record does not match the index entry
+  callback.entry_.record_size_ += 8;
+  ASSERT_EQ(OB_INVALID_DATA, callback.check_record(*header));
+  callback.entry_.record_size_ -= 8;
+  // not a record
+  header->magic_ = 0;
+  ASSERT_EQ(OB_INVALID_DATA, callback.check_record(*header));
+  header->magic_ = ObSecondaryCacheRecordHeader::RECORD_MAGIC;
+  // corrupted data
+  data[data_size / 2] ^= 0x1;
+  ASSERT_EQ(OB_CHECKSUM_ERROR, callback.check_record(*header));
+}
+
+}  // end namespace unittest
+}  // end namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  system("rm -f test_micro_block_secondary_cache.log*");
+  OB_LOGGER.set_file_name("test_micro_block_secondary_cache.log", true, true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,266 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+
+#define private public
+#define protected public
+#include "sql/engine/basic/ob_pushdown_filter.h"
+#include "storage/blocksstable/ob_micro_block_zone_map.h"
+
+namespace oceanbase {
+using namespace common;
+using namespace blocksstable;
+using namespace sql;
+
+namespace unittest {
+static const int64_t column_num = 2;
+static const int64_t block_row_count = 10;
+static const uint64_t filter_column_id = OB_APP_MIN_COLUMN_ID + 1;
+
+// c1 int, c2 int, the zone map covers both columns and the filters are on c2
+class TestMicroBlockZoneMap : public ::testing::Test {
+public:
+  enum BlockType {
+    NO_NULL = 0,     // c2 in [10, 19]
+    SOME_NULL = 1,   // c2 in [10, 19] and NULL in two rows
+    NULL_ONLY = 2,   // c2 is NULL in every row, c1 is not
+    ALL_NULL = 3,    // every column of every row is NULL
+    NO_ENTRY = 4,    // micro block without zone map
+    UNTRACKED = 5,   // c2 has a nop value
+    BLOCK_COUNT = 6
+  };
+
+public:
+  TestMicroBlockZoneMap() : allocator_(ObModIds::TEST), data_(0, "TestZoneMap")
+  {}
+  virtual void SetUp();
+  virtual void TearDown()
+  {}
+
+protected:
+  void build_entry(const BlockType type, ObMicroBlockZoneMapBuilder& builder, ObString& entry);
+  ObWhiteFilterExecutor* make_white_filter(const ObWhiteFilterOperatorType op_type, const int64_t* params,
+      const int64_t param_count, const bool null_param = false);
+  // check can_skip of every micro block, bit i of %skip_mask is the expectation of block i
+  void check_skip(ObPushdownFilterExecutor& filter, const int64_t skip_mask);
+
+protected:
+  ObArenaAllocator allocator_;
+  ObSelfBufferWriter data_;
+  ObMicroBlockZoneMapReader reader_;
+};
+
+void TestMicroBlockZoneMap::SetUp()
+{
+  const uint64_t column_ids[column_num] = {OB_APP_MIN_COLUMN_ID, filter_column_id};
+  ObMicroBlockZoneMapBuilder builder;
+  ObMicroBlockZoneMapWriter writer;
+  ObMicroBlockZoneMapWriter other_writer;
+  ObString entry;
+  ASSERT_EQ(OB_SUCCESS, builder.init(column_num));
+  ASSERT_EQ(OB_SUCCESS, writer.init(column_ids, column_num));
+  ASSERT_EQ(OB_SUCCESS, other_writer.init(column_ids, column_num));
+  // the last blocks come from another macro block writer, as in parallel merge
+  for (int64_t i = 0; i < BLOCK_COUNT; ++i) {
+    build_entry(static_cast<BlockType>(i), builder, entry);
+    ASSERT_EQ(OB_SUCCESS, (i < NO_ENTRY ? writer : other_writer).add_entry(entry));
+  }
+  ASSERT_EQ(OB_SUCCESS, writer.merge(other_writer));
+  ASSERT_EQ(OB_SUCCESS, data_.ensure_space(writer.get_size()));
+  ASSERT_EQ(OB_SUCCESS, writer.build(data_));
+  ASSERT_EQ(writer.get_size(), data_.length());
+  ASSERT_EQ(OB_SUCCESS, reader_.init(data_.data(), data_.length()));
+  ASSERT_EQ(BLOCK_COUNT, reader_.header_.micro_block_count_);
+}
+
+void TestMicroBlockZoneMap::build_entry(const BlockType type, ObMicroBlockZoneMapBuilder& builder, ObString& entry)
+{
+  ObObj cells[column_num];
+  ObNewRow row(cells, column_num);
+  builder.reuse();
+  entry.reset();
+  if (NO_ENTRY != type) {
+    for (int64_t i = 0; i < block_row_count; ++i) {
+      cells[0].set_int(i);
+      cells[1].set_int(10 + i);
+      if (ALL_NULL == type) {
+        cells[0].set_null();
+        cells[1].set_null();
+      } else if (NULL_ONLY == type || (SOME_NULL == type && 0 == i % 5)) {
+        cells[1].set_null();
+      } else if (UNTRACKED == type && 5 == i) {
+        cells[1].set_nop_value();
+      }
+      ASSERT_EQ(OB_SUCCESS, builder.update(row));
+    }
+    ASSERT_EQ(OB_SUCCESS, builder.build(entry));
+  }
+}
+
+ObWhiteFilterExecutor* TestMicroBlockZoneMap::make_white_filter(
+    const ObWhiteFilterOperatorType op_type, const int64_t* params, const int64_t param_count, const bool null_param)
+{
+  ObPushdownWhiteFilterNode* node = OB_NEWx(ObPushdownWhiteFilterNode, (&allocator_), allocator_);
+  ObWhiteFilterExecutor* filter = nullptr;
+  if (nullptr != node) {
+    node->set_type(PushdownFilterType::WHITE_FILTER);
+    node->op_type_ = op_type;
+    if (OB_SUCCESS != node->col_ids_.init(1) || OB_SUCCESS != node->col_ids_.push_back(filter_column_id)) {
+    } else if (nullptr != (filter = OB_NEWx(ObWhiteFilterExecutor, (&allocator_), allocator_, *node))) {
+      filter->set_type(WHITE_FILTER_EXECUTOR);
+      filter->cs_type_ = CS_TYPE_BINARY;
+      EXPECT_EQ(OB_SUCCESS, filter->params_.init(param_count + (null_param ? 1 : 0)));
+      for (int64_t i = 0; i < param_count; ++i) {
+        ObObj param;
+        param.set_int(params[i]);
+        EXPECT_EQ(OB_SUCCESS, filter->params_.push_back(param));
+      }
+      if (null_param) {
+        ObObj param;
+        param.set_null();
+        EXPECT_EQ(OB_SUCCESS, filter->params_.push_back(param));
+      }
+    }
+  }
+  return filter;
+}
+
+void TestMicroBlockZoneMap::check_skip(ObPushdownFilterExecutor& filter, const int64_t skip_mask)
+{
+  for (int64_t i = 0; i < BLOCK_COUNT; ++i) {
+    bool can_skip = false;
+    ASSERT_EQ(OB_SUCCESS, reader_.can_skip(i, filter, can_skip));
+    ASSERT_EQ(0 != (skip_mask & (1 << i)), can_skip) << "micro block " << i;
+  }
+}
+
+#define SKIP(type) (1 << TestMicroBlockZoneMap::type)
+// blocks whose c2 has neither a value nor an unknown row can be skipped by any comparison
+static const int64_t SKIP_NULL = SKIP(NULL_ONLY) | SKIP(ALL_NULL);
+static const int64_t SKIP_RANGE = SKIP(NO_NULL) | SKIP(SOME_NULL) | SKIP_NULL;
+
+TEST_F(TestMicroBlockZoneMap, entries)
+{
+  bool is_known = false;
+  int32_t row_count = 0;
+  ObMicroBlockZoneMapColumn columns[column_num];
+
+  ASSERT_EQ(OB_SUCCESS, reader_.get_entry(SOME_NULL, is_known, row_count, columns));
+  ASSERT_TRUE(is_known);
+  ASSERT_EQ(block_row_count, row_count);
+  ASSERT_EQ(0, columns[0].null_count_);
+  ASSERT_EQ(0, columns[0].min_.get_int());
+  ASSERT_EQ(block_row_count - 1, columns[0].max_.get_int());
+  ASSERT_EQ(2, columns[1].null_count_);
+  ASSERT_TRUE(columns[1].has_min_max_);
+  ASSERT_EQ(11, columns[1].min_.get_int());
+  ASSERT_EQ(19, columns[1].max_.get_int());
+
+  ASSERT_EQ(OB_SUCCESS, reader_.get_entry(NULL_ONLY, is_known, row_count, columns));
+  ASSERT_TRUE(is_known);
+  ASSERT_TRUE(columns[0].has_min_max_);
+  ASSERT_EQ(block_row_count, columns[1].null_count_);
+  ASSERT_FALSE(columns[1].has_min_max_);
+
+  ASSERT_EQ(OB_SUCCESS, reader_.get_entry(ALL_NULL, is_known, row_count, columns));
+  ASSERT_TRUE(is_known);
+  for (int64_t i = 0; i < column_num; ++i) {
+    ASSERT_EQ(block_row_count, columns[i].null_count_);
+    ASSERT_FALSE(columns[i].has_min_max_);
+  }
+
+  ASSERT_EQ(OB_SUCCESS, reader_.get_entry(NO_ENTRY, is_known, row_count, columns));
+  ASSERT_FALSE(is_known);
+
+  ASSERT_EQ(OB_SUCCESS, reader_.get_entry(UNTRACKED, is_known, row_count, columns));
+  ASSERT_TRUE(is_known);
+  ASSERT_EQ(-1, columns[1].null_count_);
+
+  ASSERT_EQ(OB_INVALID_ARGUMENT, reader_.get_entry(BLOCK_COUNT, is_known, row_count, columns));
+}
+
+TEST_F(TestMicroBlockZoneMap, white_filters)
+{
+  // the min of SOME_NULL is 11 as c2 of its first row is NULL
+  const int64_t p5[] = {5};
+  const int64_t p10[] = {10};
+  const int64_t p15[] = {15};
+  const int64_t p19[] = {19};
+  const int64_t p25[] = {25};
+  check_skip(*make_white_filter(WHITE_OP_EQ, p5, 1), SKIP_RANGE);
+  check_skip(*make_white_filter(WHITE_OP_EQ, p10, 1), SKIP(SOME_NULL) | SKIP_NULL);
+  check_skip(*make_white_filter(WHITE_OP_EQ, p15, 1), SKIP_NULL);
+  check_skip(*make_white_filter(WHITE_OP_EQ, p25, 1), SKIP_RANGE);
+
+  check_skip(*make_white_filter(WHITE_OP_LT, p10, 1), SKIP_RANGE);
+  check_skip(*make_white_filter(WHITE_OP_LT, p15, 1), SKIP_NULL);
+  check_skip(*make_white_filter(WHITE_OP_LE, p10, 1), SKIP(SOME_NULL) | SKIP_NULL);
+
+  check_skip(*make_white_filter(WHITE_OP_GT, p19, 1), SKIP_RANGE);
+  check_skip(*make_white_filter(WHITE_OP_GT, p15, 1), SKIP_NULL);
+  check_skip(*make_white_filter(WHITE_OP_GE, p19, 1), SKIP_NULL);
+
+  const int64_t bt_below[] = {0, 9};
+  const int64_t bt_above[] = {20, 30};
+  const int64_t bt_overlap[] = {5, 10};
+  const int64_t bt_inside[] = {12, 13};
+  check_skip(*make_white_filter(WHITE_OP_BT, bt_below, 2), SKIP_RANGE);
+  check_skip(*make_white_filter(WHITE_OP_BT, bt_above, 2), SKIP_RANGE);
+  check_skip(*make_white_filter(WHITE_OP_BT, bt_overlap, 2), SKIP(SOME_NULL) | SKIP_NULL);
+  check_skip(*make_white_filter(WHITE_OP_BT, bt_inside, 2), SKIP_NULL);
+
+  const int64_t in_outside[] = {1, 2, 30};
+  const int64_t in_hit[] = {1, 15, 30};
+  check_skip(*make_white_filter(WHITE_OP_IN, in_outside, 3), SKIP_RANGE);
+  check_skip(*make_white_filter(WHITE_OP_IN, in_hit, 3), SKIP_NULL);
+
+  // IS NULL can only skip blocks without NULL
+  check_skip(*make_white_filter(WHITE_OP_NU, nullptr, 0), SKIP(NO_NULL));
+}
+
+TEST_F(TestMicroBlockZoneMap, null_params)
+{
+  // comparing with NULL selects nothing
+  const int64_t p15[] = {15};
+  const int64_t in_outside[] = {1, 2, 30};
+  check_skip(*make_white_filter(WHITE_OP_EQ, nullptr, 0, true), SKIP_RANGE);
+  check_skip(*make_white_filter(WHITE_OP_BT, p15, 1, true), SKIP_RANGE);
+  check_skip(*make_white_filter(WHITE_OP_IN, in_outside, 3, true), SKIP_RANGE);
+  check_skip(*make_white_filter(WHITE_OP_IN, p15, 1, true), SKIP_NULL);
+}
+
+TEST_F(TestMicroBlockZoneMap, invalid_section)
+{
+  ObMicroBlockZoneMapReader reader;
+  ObMicroBlockZoneMapHeader header;
+  ASSERT_EQ(OB_INVALID_ARGUMENT, reader.init(NULL, data_.length()));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, reader.init(data_.data(), sizeof(header) - 1));
+  // truncated entries
+  ASSERT_EQ(OB_INVALID_DATA, reader.init(data_.data(), data_.length() - 1));
+  MEMCPY(&header, data_.data(), sizeof(header));
+  header.version_ = ObMicroBlockZoneMapHeader::ZONE_MAP_VERSION + 1;
+  MEMCPY(data_.data(), &header, sizeof(header));
+  ASSERT_EQ(OB_INVALID_DATA, reader.init(data_.data(), data_.length()));
+}
+
+}  // end namespace unittest
+}  // end namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  system("rm -f test_micro_block_zone_map.log*");
+  OB_LOGGER.set_file_name("test_micro_block_zone_map.log", true, true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
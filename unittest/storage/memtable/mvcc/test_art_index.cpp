@@ -0,0 +1,221 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "storage/memtable/mvcc/ob_art_index.h"
+
+#include "storage/memtable/mvcc/ob_mvcc_row.h"
+#include "storage/memtable/ob_memtable_key.h"
+
+#include "../utils_rowkey_builder.h"
+#include "../utils_mod_allocator.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace oceanbase {
+namespace unittest {
+using namespace oceanbase::common;
+using namespace oceanbase::memtable;
+
+static const int64_t TABLE_ID = 1000;
+
+TEST(TestObArtIndex, encode_order)
+{
+  static const int64_t R_COUNT = 12;
+  ObModAllocator allocator;
+  ObMemtableKey* mtk[R_COUNT];
+  INIT_MTK(allocator, mtk[0], TABLE_ID, I(INT64_MIN), V("", 0));
+  INIT_MTK(allocator, mtk[1], TABLE_ID, I(-1024), V("a", 1));
+  INIT_MTK(allocator, mtk[2], TABLE_ID, I(-1), V("a\x01", 2));
+  INIT_MTK(allocator, mtk[3], TABLE_ID, I(0), V("a  \x01", 4));
+  INIT_MTK(allocator, mtk[4], TABLE_ID, I(0), V("a \x01", 3));
+  INIT_MTK(allocator, mtk[5], TABLE_ID, I(0), V("a  ", 3));
+  INIT_MTK(allocator, mtk[6], TABLE_ID, I(0), V("a  b", 4));
+  INIT_MTK(allocator, mtk[7], TABLE_ID, I(0), V("a b", 3));
+  INIT_MTK(allocator, mtk[8], TABLE_ID, I(0), V("ab", 2));
+  INIT_MTK(allocator, mtk[9], TABLE_ID, I(1), V("\x00", 1, CS_TYPE_BINARY));
+  INIT_MTK(allocator, mtk[10], TABLE_ID, I(1), V("\x00\x00", 2, CS_TYPE_BINARY));
+  INIT_MTK(allocator, mtk[11], TABLE_ID, I(INT64_MAX), V("\x01", 1, CS_TYPE_BINARY));
+
+  for (int64_t i = 0; i < R_COUNT; ++i) {
+    EXPECT_TRUE(ObArtKey::is_supported(*mtk[i]->get_rowkey()));
+    for (int64_t j = 0; j < R_COUNT; ++j) {
+      ObArtKey key_i;
+      ObArtKey key_j;
+      int cmp = 0;
+      EXPECT_EQ(OB_SUCCESS, key_i.encode(*mtk[i]->get_rowkey()));
+      EXPECT_EQ(OB_SUCCESS, key_j.encode(*mtk[j]->get_rowkey()));
+      EXPECT_EQ(OB_SUCCESS, mtk[i]->get_rowkey()->compare(*mtk[j]->get_rowkey(), cmp));
+      EXPECT_EQ(cmp < 0, key_i.compare(key_j) < 0) << i << " " << j;
+      EXPECT_EQ(cmp > 0, key_i.compare(key_j) > 0) << i << " " << j;
+    }
+  }
+
+  ObMemtableKey* unsupported = nullptr;
+  INIT_MTK(allocator, unsupported, TABLE_ID, I(0), N("1234567890.01234567890"));
+  EXPECT_FALSE(ObArtKey::is_supported(*unsupported->get_rowkey()));
+  INIT_MTK(allocator, unsupported, TABLE_ID, I(0), U());
+  EXPECT_FALSE(ObArtKey::is_supported(*unsupported->get_rowkey()));
+}
+
+TEST(TestObArtIndex, insert_get_scan)
+{
+  static const int64_t R_COUNT = 2000;
+  ObModAllocator allocator;
+  ObArtIndex art(allocator);
+  ObMemtableKey* mtk[R_COUNT];
+  ObMvccRow* rows = new ObMvccRow[R_COUNT];
+
+  ASSERT_EQ(OB_SUCCESS, art.init());
+  for (int64_t i = 0; i < R_COUNT; ++i) {
+    INIT_MTK(allocator, mtk[i], TABLE_ID, I(i / 100 - 10), V("row", 3), I(i % 100));
+  }
+  // insert in an order different from the rowkeys
+  for (int64_t i = 0; i < R_COUNT; ++i) {
+    const int64_t idx = (i * 7) % R_COUNT;
+    EXPECT_EQ(OB_SUCCESS, art.insert(mtk[idx]->get_rowkey(), &rows[idx]));
+  }
+  EXPECT_EQ(OB_ENTRY_EXIST, art.insert(mtk[0]->get_rowkey(), &rows[1]));
+  EXPECT_EQ(R_COUNT, art.size());
+
+  for (int64_t i = 0; i < R_COUNT; ++i) {
+    ObArtKey key;
+    const ObStoreRowkey* stored_rowkey = nullptr;
+    ObMvccRow* value = nullptr;
+    EXPECT_EQ(OB_SUCCESS, key.encode(*mtk[i]->get_rowkey()));
+    EXPECT_EQ(OB_SUCCESS, art.get(key, stored_rowkey, value));
+    EXPECT_EQ(mtk[i]->get_rowkey(), stored_rowkey);
+    EXPECT_EQ(&rows[i], value);
+  }
+  ObMemtableKey* missing = nullptr;
+  INIT_MTK(allocator, missing, TABLE_ID, I(0), V("row", 3), I(100));
+  {
+    ObArtKey key;
+    const ObStoreRowkey* stored_rowkey = nullptr;
+    ObMvccRow* value = nullptr;
+    EXPECT_EQ(OB_SUCCESS, key.encode(*missing->get_rowkey()));
+    EXPECT_EQ(OB_ENTRY_NOT_EXIST, art.get(key, stored_rowkey, value));
+  }
+
+  auto test_scan = [&](int64_t start, bool include_start, int64_t end, bool include_end) {
+    ObArtScanHandle handle;
+    memtable::ObStoreRowkeyWrapper key;
+    ObMvccRow* value = nullptr;
+    EXPECT_EQ(OB_SUCCESS,
+        handle.init(art, *mtk[start]->get_rowkey(), !include_start, *mtk[end]->get_rowkey(), !include_end));
+    if (start <= end) {
+      for (int64_t i = (include_start ? start : (start + 1)); i <= (include_end ? end : (end - 1)); i++) {
+        EXPECT_EQ(OB_SUCCESS, handle.get_next(key, value));
+        EXPECT_EQ(mtk[i]->get_rowkey(), key.get_rowkey());
+        EXPECT_EQ(&rows[i], value);
+      }
+    } else {
+      EXPECT_TRUE(handle.is_reverse_scan());
+      for (int64_t i = (include_start ? start : (start - 1)); i >= (include_end ? end : (end + 1)); i--) {
+        EXPECT_EQ(OB_SUCCESS, handle.get_next(key, value));
+        EXPECT_EQ(mtk[i]->get_rowkey(), key.get_rowkey());
+        EXPECT_EQ(&rows[i], value);
+      }
+    }
+    EXPECT_EQ(OB_ITER_END, handle.get_next(key, value));
+  };
+  test_scan(0, true, R_COUNT - 1, true);
+  test_scan(0, false, R_COUNT - 1, false);
+  test_scan(R_COUNT - 1, true, 0, true);
+  test_scan(R_COUNT - 1, false, 0, false);
+  test_scan(150, true, 1234, false);
+  test_scan(1234, false, 150, true);
+  test_scan(999, true, 999, true);
+  test_scan(999, false, 999, false);
+
+  int64_t branch_count = 0;
+  int64_t row_count = 0;
+  ObArtKey lower;
+  ObArtKey upper;
+  EXPECT_EQ(OB_SUCCESS, lower.encode(ObStoreRowkey::MIN_STORE_ROWKEY));
+  EXPECT_EQ(OB_SUCCESS, upper.encode(ObStoreRowkey::MAX_STORE_ROWKEY));
+  EXPECT_EQ(OB_SUCCESS, art.estimate_row_count(lower, upper, branch_count, row_count));
+  EXPECT_GT(branch_count, 0);
+  EXPECT_GT(row_count, R_COUNT / 2);
+  EXPECT_LT(row_count, R_COUNT * 2);
+
+  ObSEArray<const ObStoreRowkey*, 16> split_keys;
+  EXPECT_EQ(OB_SUCCESS, art.split_range(lower, upper, 4, split_keys));
+  EXPECT_EQ(3, split_keys.count());
+  for (int64_t i = 1; i < split_keys.count(); ++i) {
+    int cmp = 0;
+    EXPECT_EQ(OB_SUCCESS, split_keys.at(i - 1)->compare(*split_keys.at(i), cmp));
+    EXPECT_LT(cmp, 0);
+  }
+
+  art.destroy();
+  delete[] rows;
+}
+
+TEST(TestObArtIndex, concurrent_insert)
+{
+  static const int64_t THREAD_COUNT = 8;
+  static const int64_t R_COUNT = 4000;
+  ObModAllocator allocator;
+  ObArtIndex art(allocator);
+  ObMemtableKey* mtk[R_COUNT];
+  ObMvccRow* rows = new ObMvccRow[R_COUNT];
+
+  ASSERT_EQ(OB_SUCCESS, art.init());
+  for (int64_t i = 0; i < R_COUNT; ++i) {
+    INIT_MTK(allocator, mtk[i], TABLE_ID, I(i * 1000003 % 65536), V("concurrent", 10));
+  }
+  std::thread threads[THREAD_COUNT];
+  for (int64_t t = 0; t < THREAD_COUNT; ++t) {
+    threads[t] = std::thread([&, t]() {
+      for (int64_t i = t; i < R_COUNT; i += THREAD_COUNT) {
+        EXPECT_EQ(OB_SUCCESS, art.insert(mtk[i]->get_rowkey(), &rows[i]));
+      }
+    });
+  }
+  for (int64_t t = 0; t < THREAD_COUNT; ++t) {
+    threads[t].join();
+  }
+  EXPECT_EQ(R_COUNT, art.size());
+
+  ObArtScanHandle handle;
+  memtable::ObStoreRowkeyWrapper key;
+  const ObStoreRowkey* last_rowkey = nullptr;
+  ObMvccRow* value = nullptr;
+  int64_t count = 0;
+  EXPECT_EQ(OB_SUCCESS,
+      handle.init(art, ObStoreRowkey::MIN_STORE_ROWKEY, true, ObStoreRowkey::MAX_STORE_ROWKEY, true));
+  while (OB_SUCCESS == handle.get_next(key, value)) {
+    if (OB_NOT_NULL(last_rowkey)) {
+      int cmp = 0;
+      EXPECT_EQ(OB_SUCCESS, last_rowkey->compare(*key.get_rowkey(), cmp));
+      EXPECT_LT(cmp, 0);
+    }
+    last_rowkey = key.get_rowkey();
+    ++count;
+  }
+  EXPECT_EQ(R_COUNT, count);
+
+  art.destroy();
+  delete[] rows;
+}
+
+}  // namespace unittest
+}  // namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_file_name("test_art_index.log", true);
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,260 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+
+#define private public
+#define protected public
+
+#include "storage/memtable/mvcc/ob_mvcc_row.h"
+#include "storage/memtable/ob_memtable_context.h"
+#include "storage/memtable/ob_memtable_interface.h"
+#include "storage/memtable/ob_lock_wait_mgr.h"
+#include "storage/transaction/ob_trans_part_ctx.h"
+#include "share/config/ob_server_config.h"
+
+namespace oceanbase {
+namespace unittest {
+using namespace oceanbase::common;
+using namespace oceanbase::memtable;
+
+class TestObMvccRow : public ::testing::Test {
+public:
+  virtual void TearDown() override
+  {
+    set_replay_queue(-1, 0);
+  }
+  void set_replay_queue(const int64_t index, const int64_t count)
+  {
+    get_replay_queue_index() = index;
+    get_replay_queue_count() = count;
+  }
+  ObMvccTransNode* insert(const int64_t trans_version)
+  {
+    ObMvccTransNode* node = new (allocator_.alloc(sizeof(ObMvccTransNode))) ObMvccTransNode();
+    ObMvccTransNode* next_node = NULL;
+    node->trans_version_ = trans_version;
+    EXPECT_EQ(OB_SUCCESS, row_.insert_trans_node(ctx_, *node, allocator_, next_node));
+    return node;
+  }
+  // builds the index by a replay insert below more than INDEX_TRIGGER_COUNT nodes
+  void build_index(const int64_t queue_index, const int64_t queue_count)
+  {
+    for (int64_t i = 0; i <= ObMvccRow::INDEX_TRIGGER_COUNT; ++i) {
+      insert(10000 + i);
+    }
+    set_replay_queue(queue_index, queue_count);
+    insert(100);
+  }
+
+protected:
+  ObArenaAllocator allocator_;
+  ObMemtableCtx ctx_;
+  ObMvccRow row_;
+};
+
+// default four queues keep the size of the index
+TEST_F(TestObMvccRow, default_queue_count)
+{
+  build_index(3, REPLAY_TASK_QUEUE_SIZE);
+  ASSERT_TRUE(NULL != row_.index_);
+  ASSERT_EQ(REPLAY_TASK_QUEUE_SIZE, row_.index_->get_slot_count());
+  ASSERT_EQ(static_cast<int64_t>(sizeof(ObMvccRow::ObMvccRowIndex) + 4 * sizeof(ObMvccTransNode*)),
+      ObMvccRow::ObMvccRowIndex::get_alloc_size(REPLAY_TASK_QUEUE_SIZE));
+  ASSERT_EQ(100, row_.index_->get_index_node(3)->trans_version_);
+  ASSERT_TRUE(NULL == row_.index_->get_index_node(4));
+}
+
+// queues beyond the fourth get their own slot
+TEST_F(TestObMvccRow, more_queues)
+{
+  const int64_t queue_count = 8;
+  build_index(5, queue_count);
+  ASSERT_TRUE(NULL != row_.index_);
+  ASSERT_EQ(queue_count, row_.index_->get_slot_count());
+  ObMvccTransNode* node100 = row_.index_->get_index_node(5);
+  ASSERT_EQ(100, node100->trans_version_);
+
+  // inserted after the index node of its queue
+  ObMvccTransNode* node200 = insert(200);
+  ASSERT_EQ(node200, row_.index_->get_index_node(5));
+  ASSERT_EQ(node100, node200->prev_);
+
+  // another queue starts from the list and then keeps its own slot
+  set_replay_queue(7, queue_count);
+  ObMvccTransNode* node150 = insert(150);
+  ASSERT_EQ(node150, row_.index_->get_index_node(7));
+  ASSERT_EQ(node200, row_.index_->get_index_node(5));
+  ObMvccTransNode* node300 = insert(300);
+  ASSERT_EQ(node300, row_.index_->get_index_node(7));
+  const int64_t versions[] = {100, 150, 200, 300, 10000};
+  ObMvccTransNode* iter = node100;
+  for (int64_t i = 0; i < 5; ++i, iter = iter->next_) {
+    ASSERT_TRUE(NULL != iter);
+    ASSERT_EQ(versions[i], iter->trans_version_);
+  }
+  ASSERT_EQ(ObMvccRow::INDEX_TRIGGER_COUNT + 4, row_.total_trans_node_cnt_);
+
+  // unlink moves the slot to the previous node
+  ASSERT_EQ(OB_SUCCESS, row_.unlink_trans_node(ctx_, *node300, row_));
+  ASSERT_EQ(node200, row_.index_->get_index_node(7));
+  ASSERT_EQ(10000, node200->next_->trans_version_);
+}
+
+// a queue without a slot walks the list and leaves the index to the others
+TEST_F(TestObMvccRow, queue_without_slot)
+{
+  build_index(1, 2);
+  ASSERT_EQ(2, row_.index_->get_slot_count());
+  ObMvccTransNode* node100 = row_.index_->get_index_node(1);
+
+  set_replay_queue(12, 2);
+  ObMvccTransNode* node50 = insert(50);
+  ASSERT_TRUE(NULL == row_.index_->get_index_node(12));
+  ASSERT_EQ(node100, row_.index_->get_index_node(1));
+  ASSERT_EQ(node100, node50->next_);
+  ASSERT_TRUE(NULL == node50->prev_);
+
+  // a write which is not replayed resets the index
+  set_replay_queue(-1, 0);
+  insert(20000);
+  ASSERT_TRUE(row_.index_->is_empty_);
+  ASSERT_TRUE(NULL == row_.index_->get_index_node(1));
+  ASSERT_EQ(20000, row_.list_head_->trans_version_);
+}
+
+// a read committed transaction with early lock release
+class ElrWriter {
+public:
+  ElrWriter(ObMemtableCtxFactory& factory, const int64_t snapshot) : factory_(factory), mem_ctx_(NULL)
+  {
+    const int64_t timeout = ObTimeUtility::current_time() + 10 * 1000 * 1000;
+    mem_ctx_ = static_cast<ObMemtableCtx*>(factory_.alloc());
+    part_ctx_.can_elr_ = true;
+    mem_ctx_->ctx_ = &part_ctx_;
+    mem_ctx_->trans_begin();
+    mem_ctx_->sub_trans_begin(snapshot, timeout);
+    mem_ctx_->set_abs_lock_wait_timeout(timeout);
+  }
+  ~ElrWriter()
+  {
+    mem_ctx_->ctx_ = NULL;
+    factory_.free(mem_ctx_);
+  }
+  uint32_t get_uid() const
+  {
+    return mem_ctx_->get_ctx_descriptor();
+  }
+  ObMemtableCtx& ctx()
+  {
+    return *mem_ctx_;
+  }
+
+private:
+  ObMemtableCtxFactory& factory_;
+  transaction::ObPartTransCtx part_ctx_;
+  ObMemtableCtx* mem_ctx_;
+};
+
+class TestObMvccRowHotRow : public ::testing::Test {
+public:
+  TestObMvccRowHotRow() : rowkey_(&obj_, 1), key_(combine_id(1, 3001), &rowkey_)
+  {
+    obj_.set_int(1);
+  }
+  virtual void SetUp() override
+  {
+    ASSERT_TRUE(GCONF._hot_row_conflict_threshold.set_value("1"));
+    ASSERT_TRUE(GCONF._hot_row_lock_wait_time.set_value("100ms"));
+    get_global_lock_wait_mgr().on_row_lock_conflict(key_);
+    ASSERT_TRUE(get_global_lock_wait_mgr().is_hot_row(key_));
+  }
+  virtual void TearDown() override
+  {
+    ASSERT_TRUE(GCONF._hot_row_conflict_threshold.set_value("0"));
+  }
+  // the holder prepares at the version and releases the lock early after a while
+  std::thread elr_release(ElrWriter& holder, const int64_t prepare_version)
+  {
+    holder.ctx().set_prepare_version(prepare_version);
+    return std::thread([this, &holder, prepare_version]() {
+      usleep(10 * 1000);
+      ATOMIC_STORE(&row_.max_elr_trans_version_, prepare_version);
+      row_.row_lock_.revert_lock(holder.get_uid());
+    });
+  }
+
+protected:
+  ObObj obj_;
+  ObStoreRowkey rowkey_;
+  ObMemtableKey key_;
+  ObMemtableCtxFactory factory_;
+  ObMvccRow row_;
+};
+
+// writers whose snapshot covers the prepared holder wait in place and get the lock one after another
+TEST_F(TestObMvccRowHotRow, elr_writers_wait_in_place)
+{
+  ElrWriter w1(factory_, 100);
+  ASSERT_EQ(OB_SUCCESS, row_.lock_for_write(&key_, w1.ctx()));
+
+  ElrWriter w2(factory_, 300);
+  std::thread release1 = elr_release(w1, 200);
+  ASSERT_EQ(OB_SUCCESS, row_.lock_for_write(&key_, w2.ctx()));
+  release1.join();
+  ASSERT_TRUE(row_.row_lock_.is_exclusive_locked_by(w2.get_uid()));
+
+  ElrWriter w3(factory_, 500);
+  std::thread release2 = elr_release(w2, 400);
+  ASSERT_EQ(OB_SUCCESS, row_.lock_for_write(&key_, w3.ctx()));
+  release2.join();
+  ASSERT_TRUE(row_.row_lock_.is_exclusive_locked_by(w3.get_uid()));
+  row_.row_lock_.revert_lock(w3.get_uid());
+}
+
+// a writer whose snapshot does not cover the holder would meet transaction set violation after the wait,
+// so it does not wait in place and is retried with a new snapshot
+TEST_F(TestObMvccRowHotRow, stale_snapshot_not_wait)
+{
+  ElrWriter w1(factory_, 100);
+  ASSERT_EQ(OB_SUCCESS, row_.lock_for_write(&key_, w1.ctx()));
+
+  // the holder is not prepared yet
+  ElrWriter w2(factory_, 300);
+  int64_t start_ts = ObTimeUtility::current_time();
+  ASSERT_EQ(OB_TRY_LOCK_ROW_CONFLICT, row_.lock_for_write(&key_, w2.ctx()));
+  ASSERT_GT(50 * 1000, ObTimeUtility::current_time() - start_ts);
+
+  // the holder prepares after the snapshot
+  w1.ctx().set_prepare_version(400);
+  start_ts = ObTimeUtility::current_time();
+  ASSERT_EQ(OB_TRY_LOCK_ROW_CONFLICT, row_.lock_for_write(&key_, w2.ctx()));
+  ASSERT_GT(50 * 1000, ObTimeUtility::current_time() - start_ts);
+
+  // the retry with a new snapshot gets the lock released early
+  row_.max_elr_trans_version_ = 400;
+  row_.row_lock_.revert_lock(w1.get_uid());
+  ElrWriter w2_retry(factory_, 500);
+  ASSERT_EQ(OB_SUCCESS, row_.lock_for_write(&key_, w2_retry.ctx()));
+  row_.row_lock_.revert_lock(w2_retry.get_uid());
+}
+
+}  // namespace unittest
+}  // namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,219 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+
+#define private public
+#define protected public
+#include "storage/memtable/ob_deadlock_checker.h"
+
+#include "share/config/ob_server_config.h"
+#include "share/rpc/ob_batch_rpc.h"
+
+namespace oceanbase {
+namespace unittest {
+using namespace oceanbase::common;
+using namespace oceanbase::memtable;
+using namespace oceanbase::transaction;
+
+class TestDeadLockChecker : public ObDeadLockChecker {
+public:
+  // process the messages queued, including those posted while processing
+  void process_msgs()
+  {
+    has_set_stop() = false;
+    handle_queued_msgs(ObTimeUtility::current_time() + 50 * 1000);
+    has_set_stop() = true;
+  }
+  // holders of the out edges of %waiter found through the edge index
+  int64_t out_edge_count(const ObTransID& waiter)
+  {
+    int64_t count = 0;
+    int64_t idx = -1;
+    EXPECT_EQ(OB_SUCCESS, get_first_edge(waiter, idx));
+    for (; idx >= 0; idx = edges_.at(idx).next_) {
+      EXPECT_EQ(waiter, edges_.at(idx).edge_.waiter_);
+      ++count;
+    }
+    return count;
+  }
+};
+
+static ObDeadLockEdge make_edge(const ObTransID& waiter, const ObTransID& holder, const ObAddr& reporter)
+{
+  ObDeadLockEdge edge;
+  edge.waiter_ = waiter;
+  edge.holder_ = holder;
+  edge.reporter_ = reporter;
+  edge.waiter_ctx_desc_ = static_cast<uint32_t>(waiter.get_inc_num());
+  edge.sessid_ = 1;
+  edge.table_id_ = 1100611139403777L;
+  edge.lock_ts_ = ObTimeUtility::current_time();
+  edge.set_row_key("{\"BIGINT\":1}");
+  return edge;
+}
+
+static int report_edges(ObDeadLockChecker& checker, const ObIArray<ObDeadLockEdge>& edges)
+{
+  int ret = OB_SUCCESS;
+  ObDeadLockMsg msg;
+  char buf[16 * 1024];
+  int64_t pos = 0;
+  msg.msg_type_ = DEADLOCK_MSG_EDGE_REPORT;
+  if (OB_FAIL(msg.edges_.assign(edges))) {
+  } else if (OB_FAIL(msg.serialize(buf, sizeof(buf), pos))) {
+  } else {
+    ret = checker.handle_msg(msg.msg_type_, buf, pos);
+  }
+  return ret;
+}
+
+TEST(TestObDeadLockChecker, serialize)
+{
+  ObAddr addr(ObAddr::IPV4, "127.0.0.1", 2882);
+  ObDeadLockEdge edge = make_edge(ObTransID(addr, 1, 1000), ObTransID(addr, 2, 2000), addr);
+  char row_key[ObDeadLockEdge::ROW_KEY_SIZE * 2];
+  memset(row_key, 'k', sizeof(row_key) - 1);
+  row_key[sizeof(row_key) - 1] = '\0';
+  edge.set_row_key(row_key);
+  EXPECT_EQ(ObDeadLockEdge::ROW_KEY_SIZE - 1, static_cast<int64_t>(strlen(edge.row_key_)));
+
+  ObDeadLockMsg msg;
+  msg.msg_type_ = DEADLOCK_MSG_PROBE;
+  ASSERT_EQ(OB_SUCCESS, msg.edges_.push_back(edge));
+  ASSERT_EQ(OB_SUCCESS, msg.edges_.push_back(make_edge(edge.holder_, edge.waiter_, addr)));
+  char buf[4096];
+  int64_t pos = 0;
+  ASSERT_EQ(OB_SUCCESS, msg.serialize(buf, sizeof(buf), pos));
+  EXPECT_EQ(msg.get_serialize_size(), pos);
+
+  ObDeadLockMsg msg2;
+  int64_t pos2 = 0;
+  ASSERT_EQ(OB_SUCCESS, msg2.deserialize(buf, pos, pos2));
+  EXPECT_EQ(pos, pos2);
+  EXPECT_TRUE(msg2.is_valid());
+  EXPECT_EQ(DEADLOCK_MSG_PROBE, msg2.msg_type_);
+  ASSERT_EQ(2, msg2.edges_.count());
+  EXPECT_TRUE(msg2.edges_.at(0).is_same(edge));
+  EXPECT_EQ(edge.waiter_ctx_desc_, msg2.edges_.at(0).waiter_ctx_desc_);
+  EXPECT_EQ(edge.table_id_, msg2.edges_.at(0).table_id_);
+  EXPECT_EQ(edge.lock_ts_, msg2.edges_.at(0).lock_ts_);
+  EXPECT_STREQ(edge.row_key_, msg2.edges_.at(0).row_key_);
+  EXPECT_EQ(msg.edges_.at(1).waiter_, msg2.edges_.at(1).waiter_);
+}
+
+TEST(TestObDeadLockChecker, edge_index)
+{
+  ObAddr self(ObAddr::IPV4, "127.0.0.1", 2882);
+  obrpc::ObBatchRpc batch_rpc;
+  TestDeadLockChecker* checker = new TestDeadLockChecker();
+  ASSERT_EQ(OB_SUCCESS, checker->init(self, &batch_rpc));
+  ObTransID t1(self, 1, 1000);
+  ObTransID t2(self, 2, 2000);
+  ObTransID t3(self, 3, 3000);
+  ObTransID t4(self, 4, 4000);
+
+  // t1 waits for t2 and t3, the edge reported twice is kept once
+  const int64_t cur_ts = ObTimeUtility::current_time();
+  ASSERT_EQ(OB_SUCCESS, checker->add_edge(make_edge(t1, t2, self), cur_ts + 1000));
+  ASSERT_EQ(OB_SUCCESS, checker->add_edge(make_edge(t2, t3, self), cur_ts + 1000));
+  ASSERT_EQ(OB_SUCCESS, checker->add_edge(make_edge(t1, t3, self), cur_ts + 2000));
+  ASSERT_EQ(OB_SUCCESS, checker->add_edge(make_edge(t1, t2, self), cur_ts + 2000));
+  ASSERT_EQ(3, checker->edges_.count());
+  EXPECT_EQ(2, checker->out_edge_count(t1));
+  EXPECT_EQ(1, checker->out_edge_count(t2));
+  EXPECT_EQ(0, checker->out_edge_count(t3));
+
+  // the index follows the edges moved by expiration
+  checker->expire_edges(cur_ts + 1500);
+  ASSERT_EQ(2, checker->edges_.count());
+  EXPECT_EQ(2, checker->out_edge_count(t1));
+  EXPECT_EQ(0, checker->out_edge_count(t2));
+  ASSERT_EQ(OB_SUCCESS, checker->add_edge(make_edge(t4, t1, self), cur_ts + 2000));
+  EXPECT_EQ(1, checker->out_edge_count(t4));
+  checker->expire_edges(cur_ts + 2500);
+  ASSERT_EQ(0, checker->edges_.count());
+  EXPECT_EQ(0, checker->out_edge_count(t1));
+  EXPECT_EQ(0, checker->out_edge_count(t4));
+
+  checker->destroy();
+  delete checker;
+}
+
+TEST(TestObDeadLockChecker, detect_cycle)
+{
+  ASSERT_EQ(true, GCONF._enable_deadlock_detect.set_value("True"));
+  // keep the edges reported during the test
+  ASSERT_EQ(true, GCONF._deadlock_detect_interval.set_value("1s"));
+  ObAddr self(ObAddr::IPV4, "127.0.0.1", 2882);
+  obrpc::ObBatchRpc batch_rpc;
+  TestDeadLockChecker* checker = new TestDeadLockChecker();
+  ASSERT_EQ(OB_SUCCESS, checker->init(self, &batch_rpc));
+
+  // t1 -> t2 -> t3 -> t1 is a cycle, t4 waits for t1 but is not part of it
+  ObTransID t1(self, 1, 1000);
+  ObTransID t2(self, 2, 2000);
+  ObTransID t3(self, 3, 3000);
+  ObTransID t4(self, 4, 4000);
+  ObSEArray<ObDeadLockEdge, 4> edges;
+  ASSERT_EQ(OB_SUCCESS, edges.push_back(make_edge(t1, t2, self)));
+  ASSERT_EQ(OB_SUCCESS, edges.push_back(make_edge(t2, t3, self)));
+  ASSERT_EQ(OB_SUCCESS, edges.push_back(make_edge(t4, t1, self)));
+  ASSERT_EQ(OB_SUCCESS, report_edges(*checker, edges));
+  checker->process_msgs();
+  ASSERT_EQ(OB_SUCCESS, checker->check_round());
+  checker->process_msgs();
+  int64_t start_id = 0;
+  int64_t end_id = 0;
+  checker->get_cycle_id_range(start_id, end_id);
+  EXPECT_EQ(0, end_id);
+
+  edges.reset();
+  ASSERT_EQ(OB_SUCCESS, edges.push_back(make_edge(t3, t1, self)));
+  ASSERT_EQ(OB_SUCCESS, report_edges(*checker, edges));
+  checker->process_msgs();
+  ASSERT_EQ(OB_SUCCESS, checker->check_round());
+  checker->process_msgs();
+  checker->get_cycle_id_range(start_id, end_id);
+  EXPECT_EQ(0, start_id);
+  ASSERT_EQ(1, end_id);
+  ObDeadLockCycle cycle;
+  ASSERT_EQ(OB_SUCCESS, checker->get_cycle(0, cycle));
+  ASSERT_EQ(3, cycle.edge_count_);
+  // the youngest transaction is the victim
+  EXPECT_EQ(t3, cycle.edges_[0].waiter_);
+  EXPECT_EQ(t1, cycle.edges_[0].holder_);
+  EXPECT_EQ(t1, cycle.edges_[1].waiter_);
+  EXPECT_EQ(t2, cycle.edges_[2].waiter_);
+  EXPECT_EQ(t3, cycle.edges_[2].holder_);
+  EXPECT_EQ(OB_ENTRY_NOT_EXIST, checker->get_cycle(1, cycle));
+
+  // the out edges of the victim are dropped, the cycle is not found again
+  ASSERT_EQ(OB_SUCCESS, checker->check_round());
+  checker->process_msgs();
+  checker->get_cycle_id_range(start_id, end_id);
+  EXPECT_EQ(1, end_id);
+
+  checker->destroy();
+  delete checker;
+}
+
+}  // namespace unittest
+}  // namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_file_name("test_deadlock_checker.log", true);
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,160 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "storage/ob_partition_parallel_merge_ctx.h"
+#include "share/config/ob_server_config.h"
+
+namespace oceanbase {
+using namespace storage;
+using namespace common;
+namespace unittest {
+
+// Memtable whose btree level fans out %fan_out_ keys.
+class MockSplitMemtable {
+public:
+  explicit MockSplitMemtable(const int64_t fan_out) : fan_out_(fan_out), split_cnt_(0), ret_(OB_SUCCESS)
+  {}
+  int get_split_ranges(const uint64_t table_id, const ObStoreRowkey* start_key, const ObStoreRowkey* end_key,
+      const int64_t part_cnt, ObIArray<ObStoreRange>& range_array)
+  {
+    int ret = ret_;
+    UNUSED(table_id);
+    UNUSED(start_key);
+    UNUSED(end_key);
+    split_cnt_++;
+    if (OB_FAIL(ret)) {
+    } else if (part_cnt > fan_out_) {
+      ret = OB_ENTRY_NOT_EXIST;
+    } else {
+      ObStoreRange range;
+      range.set_whole_range();
+      for (int64_t i = 0; OB_SUCC(ret) && i < part_cnt; i++) {
+        ret = range_array.push_back(range);
+      }
+    }
+    return ret;
+  }
+
+  int64_t fan_out_;
+  int64_t split_cnt_;
+  int ret_;
+};
+
+class TestParallelMiniMerge : public ::testing::Test {
+public:
+  static const int64_t TABLET_SIZE = 2 << 20;
+  static const int64_t TABLE_ID = 3001;
+  static const int64_t TARGET_TASK_CNT = ObParallelMergeCtx::PARALLEL_MERGE_TARGET_TASK_CNT;
+
+  virtual void SetUp() override
+  {
+    GCONF._mini_merge_concurrency = 5;
+    GCONF.minor_merge_concurrency = 0;
+  }
+};
+
+TEST_F(TestParallelMiniMerge, mini_parallel_degree)
+{
+  int64_t degree = 0;
+  // one memtable of two tablets
+  ASSERT_EQ(OB_SUCCESS, ObParallelMergeCtx::calc_mini_parallel_degree(TABLET_SIZE, 2 * TABLET_SIZE, degree));
+  ASSERT_EQ(2, degree);
+  // frozen memtables of three tablets in total
+  ASSERT_EQ(OB_SUCCESS, ObParallelMergeCtx::calc_mini_parallel_degree(TABLET_SIZE, 2 * TABLET_SIZE + 1, degree));
+  ASSERT_EQ(3, degree);
+  ASSERT_EQ(OB_SUCCESS, ObParallelMergeCtx::calc_mini_parallel_degree(TABLET_SIZE, 1, degree));
+  ASSERT_EQ(1, degree);
+  ASSERT_EQ(OB_SUCCESS, ObParallelMergeCtx::calc_mini_parallel_degree(TABLET_SIZE, 0, degree));
+  ASSERT_EQ(0, degree);
+  // bounded by the target task count, or by the mini merge concurrency if larger
+  ASSERT_EQ(OB_SUCCESS, ObParallelMergeCtx::calc_mini_parallel_degree(TABLET_SIZE, 100 * TABLET_SIZE, degree));
+  ASSERT_EQ(TARGET_TASK_CNT, degree);
+  GCONF._mini_merge_concurrency = TARGET_TASK_CNT + 10;
+  ASSERT_EQ(OB_SUCCESS, ObParallelMergeCtx::calc_mini_parallel_degree(TABLET_SIZE, 100 * TABLET_SIZE, degree));
+  ASSERT_EQ(TARGET_TASK_CNT + 10, degree);
+
+  ASSERT_EQ(OB_INVALID_ARGUMENT, ObParallelMergeCtx::calc_mini_parallel_degree(0, TABLET_SIZE, degree));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, ObParallelMergeCtx::calc_mini_parallel_degree(TABLET_SIZE, -1, degree));
+}
+
+TEST_F(TestParallelMiniMerge, mini_minor_parallel_degree)
+{
+  ObParallelMergeCtx ctx;
+  int64_t degree = 0;
+  // the degree follows the total size of the sstables rather than the average
+  ASSERT_EQ(OB_SUCCESS, ctx.calc_mini_minor_parallel_degree(TABLET_SIZE, 6 * TABLET_SIZE, 3, degree));
+  ASSERT_EQ(6, degree);
+  ASSERT_EQ(OB_SUCCESS, ctx.calc_mini_minor_parallel_degree(TABLET_SIZE, 100 * TABLET_SIZE, 3, degree));
+  ASSERT_EQ(TARGET_TASK_CNT, degree);
+  ASSERT_EQ(OB_INVALID_ARGUMENT, ctx.calc_mini_minor_parallel_degree(TABLET_SIZE, TABLET_SIZE, 1, degree));
+}
+
+TEST_F(TestParallelMiniMerge, split_memtable)
+{
+  ObArray<ObStoreRange> ranges;
+  // split on the parallel degree at once
+  MockSplitMemtable memtable(32);
+  int64_t degree = 16;
+  ASSERT_EQ(OB_SUCCESS, ObParallelMergeCtx::get_memtable_split_ranges(memtable, TABLE_ID, degree, ranges));
+  ASSERT_EQ(16, degree);
+  ASSERT_EQ(16, ranges.count());
+  ASSERT_EQ(1, memtable.split_cnt_);
+
+  // btree level fans out less than the degree, halved until split instead of merging serially
+  memtable.fan_out_ = 5;
+  memtable.split_cnt_ = 0;
+  degree = 20;
+  ASSERT_EQ(OB_SUCCESS, ObParallelMergeCtx::get_memtable_split_ranges(memtable, TABLE_ID, degree, ranges));
+  ASSERT_EQ(5, degree);
+  ASSERT_EQ(5, ranges.count());
+  ASSERT_EQ(3, memtable.split_cnt_);
+}
+
+TEST_F(TestParallelMiniMerge, split_memtable_fail)
+{
+  ObArray<ObStoreRange> ranges;
+  // memtable can not be split at all
+  MockSplitMemtable memtable(1);
+  int64_t degree = 8;
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, ObParallelMergeCtx::get_memtable_split_ranges(memtable, TABLE_ID, degree, ranges));
+  ASSERT_EQ(1, degree);
+  ASSERT_EQ(3, memtable.split_cnt_);
+  ASSERT_EQ(0, ranges.count());
+
+  // nothing to split
+  memtable.split_cnt_ = 0;
+  degree = 1;
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, ObParallelMergeCtx::get_memtable_split_ranges(memtable, TABLE_ID, degree, ranges));
+  ASSERT_EQ(0, memtable.split_cnt_);
+
+  // other errors are returned at once
+  memtable.fan_out_ = 32;
+  memtable.ret_ = OB_ALLOCATE_MEMORY_FAILED;
+  degree = 8;
+  ASSERT_EQ(
+      OB_ALLOCATE_MEMORY_FAILED, ObParallelMergeCtx::get_memtable_split_ranges(memtable, TABLE_ID, degree, ranges));
+  ASSERT_EQ(8, degree);
+  ASSERT_EQ(1, memtable.split_cnt_);
+}
+
+}  // namespace unittest
+}  // namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,144 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "storage/ob_sstable_row_scanner.h"
+
+namespace oceanbase {
+using namespace storage;
+using namespace common;
+namespace unittest {
+
+// Adaptive prefetch depth of sequential sstable scans.
+class TestSSTableReadAhead : public ::testing::Test {
+public:
+  static const int64_t MICRO_HANDLE_CNT = 256;
+  static const int64_t DEFAULT_DEPTH = ObSSTableRowIterator::DEFAULT_PREFETCH_MICRO_DEPTH;
+
+  virtual void SetUp() override
+  {
+    scanner_.is_seq_scan_ = true;
+    scanner_.micro_handle_cnt_ = MICRO_HANDLE_CNT;
+    ASSERT_EQ(DEFAULT_DEPTH, scanner_.prefetch_micro_depth_);
+  }
+
+protected:
+  // the scan spends %consume_us on a micro block, then fetches the next one
+  void fetch_next(const int64_t consume_us, const int64_t io_rt_us, const bool count_io_rt)
+  {
+    now_ += consume_us;
+    scanner_.adapt_read_ahead_depth(now_, io_rt_us, count_io_rt);
+    scanner_.last_read_micro_ts_ = now_;
+  }
+
+protected:
+  ObSSTableRowScanner scanner_;
+  int64_t now_ = 1000 * 1000;
+};
+
+TEST_F(TestSSTableReadAhead, double_when_waiting)
+{
+  scanner_.last_read_micro_ts_ = now_;
+  int64_t depth = DEFAULT_DEPTH;
+  while (depth < MICRO_HANDLE_CNT) {
+    fetch_next(100, -1, false);
+    depth = std::min(MICRO_HANDLE_CNT, depth * 2);
+    ASSERT_EQ(depth, scanner_.prefetch_micro_depth_);
+  }
+  // bounded by micro handles
+  fetch_next(100, -1, false);
+  ASSERT_EQ(MICRO_HANDLE_CNT, scanner_.prefetch_micro_depth_);
+  // the wait is not counted as io latency
+  ASSERT_EQ(0, scanner_.avg_io_rt_us_);
+}
+
+TEST_F(TestSSTableReadAhead, follow_io_latency)
+{
+  // the first micro block has no consume time
+  fetch_next(0, 1000, true);
+  ASSERT_EQ(0, scanner_.avg_consume_us_);
+  ASSERT_EQ(1000, scanner_.avg_io_rt_us_);
+  ASSERT_EQ(DEFAULT_DEPTH, scanner_.prefetch_micro_depth_);
+
+  // micro blocks scanned during two reads: 2 * 1000 / 100
+  fetch_next(100, 1000, true);
+  ASSERT_EQ(100, scanner_.avg_consume_us_);
+  ASSERT_EQ(20, scanner_.prefetch_micro_depth_);
+
+  // the other micro blocks of a coalesced read and cached micro blocks don't count the latency
+  fetch_next(100, 5000, false);
+  fetch_next(100, 0, false);
+  ASSERT_EQ(1000, scanner_.avg_io_rt_us_);
+  ASSERT_EQ(20, scanner_.prefetch_micro_depth_);
+
+  // slower reads grow the depth at once
+  for (int64_t i = 0; i < 64; ++i) {
+    fetch_next(100, 4000, true);
+  }
+  ASSERT_GT(scanner_.avg_io_rt_us_, 3900);
+  ASSERT_EQ(2 * scanner_.avg_io_rt_us_ / 100, scanner_.prefetch_micro_depth_);
+
+  // very slow reads are bounded by micro handles
+  for (int64_t i = 0; i < 64; ++i) {
+    fetch_next(100, 100000, true);
+  }
+  ASSERT_EQ(MICRO_HANDLE_CNT, scanner_.prefetch_micro_depth_);
+}
+
+TEST_F(TestSSTableReadAhead, shrink_slowly)
+{
+  scanner_.prefetch_micro_depth_ = 200;
+  scanner_.last_read_micro_ts_ = now_;
+  // target depth is 2 * 1000 / 100, shrink by 1/8 of the depth each time
+  fetch_next(100, 1000, true);
+  ASSERT_EQ(200 - 200 / 8, scanner_.prefetch_micro_depth_);
+  int64_t last_depth = scanner_.prefetch_micro_depth_;
+  for (int64_t i = 0; i < 100; ++i) {
+    fetch_next(100, 1000, true);
+    ASSERT_LE(scanner_.prefetch_micro_depth_, last_depth);
+    ASSERT_GE(scanner_.prefetch_micro_depth_, 20);
+    last_depth = scanner_.prefetch_micro_depth_;
+  }
+  ASSERT_EQ(20, scanner_.prefetch_micro_depth_);
+
+  // fast reads keep at least the default depth
+  for (int64_t i = 0; i < 100; ++i) {
+    fetch_next(1000, 10, true);
+  }
+  ASSERT_EQ(DEFAULT_DEPTH, scanner_.prefetch_micro_depth_);
+}
+
+TEST_F(TestSSTableReadAhead, reset)
+{
+  scanner_.last_read_micro_ts_ = now_;
+  fetch_next(100, 1000, true);
+  fetch_next(100, -1, false);
+  ASSERT_NE(DEFAULT_DEPTH, scanner_.prefetch_micro_depth_);
+  scanner_.reuse();
+  ASSERT_FALSE(scanner_.is_seq_scan_);
+  ASSERT_EQ(DEFAULT_DEPTH, scanner_.prefetch_micro_depth_);
+  ASSERT_EQ(0, scanner_.last_read_micro_ts_);
+  ASSERT_EQ(0, scanner_.avg_consume_us_);
+  ASSERT_EQ(0, scanner_.avg_io_rt_us_);
+}
+
+}  // namespace unittest
+}  // namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
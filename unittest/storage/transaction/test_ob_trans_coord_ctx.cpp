@@ -0,0 +1,158 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "share/ob_errno.h"
+#include "lib/oblog/ob_log.h"
+#include "storage/transaction/ob_trans_coord_ctx.h"
+#include "storage/transaction/ob_trans_service.h"
+#include "storage/transaction/ob_trans_rpc.h"
+#include "../mockcontainer/mock_ob_trans_service.h"
+
+namespace oceanbase {
+using namespace common;
+using namespace transaction;
+namespace unittest {
+
+// record the messages posted by the coordinator
+class MockObTransRpc : public ObITransRpc {
+public:
+  MockObTransRpc()
+  {}
+  virtual ~MockObTransRpc()
+  {}
+  int start()
+  {
+    return OB_SUCCESS;
+  }
+  void stop()
+  {}
+  void wait()
+  {}
+  void destroy()
+  {}
+  int post_trans_msg(const uint64_t tenant_id, const ObAddr& server, const ObTransMsg& msg, const int64_t msg_type)
+  {
+    UNUSED(tenant_id);
+    UNUSED(msg);
+    servers_.push_back(server);
+    return msg_types_.push_back(msg_type);
+  }
+  int post_trans_msg(const uint64_t tenant_id, const ObAddr& server, const ObTrxMsgBase& msg, const int64_t msg_type)
+  {
+    UNUSED(tenant_id);
+    UNUSED(msg);
+    servers_.push_back(server);
+    return msg_types_.push_back(msg_type);
+  }
+  int post_trans_resp_msg(const uint64_t tenant_id, const ObAddr& server, const ObTransMsg& msg)
+  {
+    UNUSED(tenant_id);
+    UNUSED(server);
+    UNUSED(msg);
+    return OB_SUCCESS;
+  }
+
+public:
+  ObSEArray<ObAddr, 4> servers_;
+  ObSEArray<int64_t, 4> msg_types_;
+};
+
+// Batch committed coordinator whose participants have all written the prepare logs.
+class TestObTransCoordCtx : public ::testing::Test {
+public:
+  static const int64_t TENANT_ID = 1001;
+  static const uint64_t TABLE_ID = 1;
+
+  TestObTransCoordCtx() : ts_mgr_(lts_source_)
+  {}
+  virtual void SetUp() override
+  {
+    const ObAddr local(ObAddr::IPV4, "127.0.0.1", 8080);
+    const ObAddr scheduler(ObAddr::IPV4, "127.0.0.2", 8080);
+    const ObPartitionKey pkey(combine_id(TENANT_ID, TABLE_ID), 1, 100);
+    int64_t publish_version = 0;
+    trans_service_.ts_mgr_ = &ts_mgr_;
+    ASSERT_EQ(OB_SUCCESS, ts_mgr_.update_publish_version(TENANT_ID, ObTimeUtility::current_time(), false));
+    ASSERT_EQ(OB_SUCCESS, ts_mgr_.get_publish_version(TENANT_ID, publish_version));
+
+    ObStartTransParam& trans_param = ctx_.trans_param_;
+    ASSERT_EQ(OB_SUCCESS, trans_param.set_access_mode(ObTransAccessMode::READ_WRITE));
+    ASSERT_EQ(OB_SUCCESS, trans_param.set_type(ObTransType::TRANS_USER));
+    ASSERT_EQ(OB_SUCCESS, trans_param.set_isolation(ObTransIsolation::READ_COMMITED));
+    // the commit-clear round can not be started without a transaction timer
+    ctx_.is_inited_ = true;
+    ctx_.tenant_id_ = TENANT_ID;
+    ctx_.trans_id_ = ObTransID(scheduler);
+    ctx_.trans_expired_time_ = ObTimeUtility::current_time() + 100 * 1000 * 1000;
+    ctx_.self_ = pkey;
+    ctx_.addr_ = local;
+    ctx_.scheduler_ = scheduler;
+    ctx_.trans_service_ = &trans_service_;
+    ctx_.rpc_ = &rpc_;
+    ctx_.batch_commit_trans_ = true;
+    ctx_.global_trans_version_ = publish_version;
+    ctx_.set_state_(Ob2PCState::PREPARE);
+    ASSERT_EQ(OB_SUCCESS, ctx_.participants_.push_back(pkey));
+  }
+  virtual void TearDown() override
+  {
+    ctx_.is_inited_ = false;
+  }
+
+protected:
+  ObLtsSource lts_source_;
+  MockObTsMgr ts_mgr_;
+  ObTransService trans_service_;
+  MockObTransRpc rpc_;
+  ObCoordTransCtx ctx_;
+};
+
+TEST_F(TestObTransCoordCtx, response_before_commit_clear)
+{
+  ASSERT_NE(OB_SUCCESS, ctx_.handle_batch_commit_prepared_());
+  // the scheduler is answered although the commit and clear logs are not written
+  ASSERT_TRUE(ctx_.already_response_);
+  ASSERT_EQ(1, rpc_.msg_types_.count());
+  ASSERT_EQ(OB_TRANS_COMMIT_RESPONSE, rpc_.msg_types_.at(0));
+  ASSERT_EQ(ctx_.scheduler_, rpc_.servers_.at(0));
+  ASSERT_EQ(Ob2PCState::PREPARE, ctx_.state_.get_state());
+}
+
+TEST_F(TestObTransCoordCtx, response_once)
+{
+  ctx_.already_response_ = true;
+  ASSERT_NE(OB_SUCCESS, ctx_.handle_batch_commit_prepared_());
+  ASSERT_EQ(0, rpc_.msg_types_.count());
+}
+
+TEST_F(TestObTransCoordCtx, publish_version_not_passed)
+{
+  // the commit version is not readable yet, the scheduler is not answered
+  ctx_.global_trans_version_ += 1000 * 1000 * 1000;
+  ASSERT_EQ(OB_ERR_UNEXPECTED, ctx_.handle_batch_commit_prepared_());
+  ASSERT_FALSE(ctx_.already_response_);
+  ASSERT_EQ(0, rpc_.msg_types_.count());
+  ASSERT_EQ(Ob2PCState::PREPARE, ctx_.state_.get_state());
+}
+
+}  // namespace unittest
+}  // namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
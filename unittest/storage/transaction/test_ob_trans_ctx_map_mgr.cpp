@@ -0,0 +1,306 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+#define private public
+#define protected public
+#include "storage/transaction/ob_trans_ctx_mgr.h"
+#include "storage/transaction/ob_trans_factory.h"
+#include "storage/transaction/ob_trans_part_ctx.h"
+#include "share/config/ob_server_config.h"
+#include "share/ob_errno.h"
+#include "lib/oblog/ob_log.h"
+#include "lib/time/ob_time_utility.h"
+#include "common/ob_partition_key.h"
+
+namespace oceanbase {
+using namespace common;
+using namespace transaction;
+namespace unittest {
+typedef ObPartitionTransCtxMgr::CtxMapMgr CtxMapMgr;
+
+class CountCtxFunctor {
+public:
+  explicit CountCtxFunctor(const int64_t stop_count = INT64_MAX) : stop_count_(stop_count), count_(0)
+  {}
+  bool operator()(const ObTransID& trans_id, ObTransCtx* ctx)
+  {
+    UNUSED(trans_id);
+    UNUSED(ctx);
+    return ++count_ < stop_count_;
+  }
+
+public:
+  int64_t stop_count_;
+  int64_t count_;
+};
+
+class RemoveOddCtxFunctor {
+public:
+  RemoveOddCtxFunctor() : count_(0)
+  {}
+  bool operator()(const ObTransID& trans_id, ObTransCtx* ctx)
+  {
+    UNUSED(ctx);
+    const bool need_remove = (1 == trans_id.get_inc_num() % 2);
+    count_ += need_remove ? 1 : 0;
+    return need_remove;
+  }
+
+public:
+  int64_t count_;
+};
+
+class TestObTransCtxMapMgr : public ::testing::Test {
+public:
+  virtual void SetUp()
+  {
+    ASSERT_TRUE(self_.set_ip_addr("127.0.0.1", 8080));
+    ctx_maps_ = static_cast<CtxMap*>(ob_malloc(sizeof(CtxMap) * CTX_MAP_COUNT, ObModIds::OB_HASH_BUCKET_TRANS_CTX));
+    ASSERT_TRUE(NULL != ctx_maps_);
+    for (int64_t i = 0; i < CTX_MAP_COUNT; ++i) {
+      new (ctx_maps_ + i) CtxMap(1 << 10);
+      ASSERT_EQ(OB_SUCCESS, ctx_maps_[i].init(ObModIds::OB_HASH_BUCKET_TRANS_CTX));
+    }
+  }
+  virtual void TearDown()
+  {
+    for (int64_t i = 0; i < CTX_MAP_COUNT; ++i) {
+      ctx_maps_[i].destroy();
+      ctx_maps_[i].~CtxMap();
+    }
+    ob_free(ctx_maps_);
+    ctx_maps_ = NULL;
+    GCONF._trans_ctx_map_shard_count.set_value("1");
+  }
+  void init_mgr(CtxMapMgr& mgr, const ObPartitionKey& partition, const char* shard_count)
+  {
+    GCONF._trans_ctx_map_shard_count.set_value(shard_count);
+    ASSERT_EQ(OB_SUCCESS, mgr.init(partition, ctx_maps_, CTX_MAP_COUNT));
+  }
+  // trans ids are kept for the later lookup, the contexts are owned by the maps
+  void insert_ctxs(CtxMapMgr& mgr, const int64_t count, ObTransID* trans_ids = NULL)
+  {
+    for (int64_t i = 0; i < count; ++i) {
+      ObTransID trans_id(self_);
+      ObTransCtx* ctx = ObTransCtxFactory::alloc(ObTransCtxType::PARTICIPANT);
+      ASSERT_TRUE(NULL != ctx);
+      ASSERT_EQ(OB_SUCCESS, mgr.insert_and_get(trans_id, ctx));
+      mgr.revert(ctx);
+      if (NULL != trans_ids) {
+        trans_ids[i] = trans_id;
+      }
+    }
+  }
+  int64_t count_ctx(CtxMapMgr& mgr)
+  {
+    CountCtxFunctor fn;
+    EXPECT_EQ(OB_SUCCESS, mgr.foreach_ctx(fn));
+    return fn.count_;
+  }
+
+public:
+  static const int64_t CTX_MAP_COUNT = 64;
+  ObAddr self_;
+  CtxMap* ctx_maps_;
+};
+
+TEST_F(TestObTransCtxMapMgr, shard_count)
+{
+  ObPartitionKey partition(1100611139453777, 1, 1);
+  CtxMapMgr default_mgr;
+  init_mgr(default_mgr, partition, "1");
+  EXPECT_EQ(1, default_mgr.shard_count_);
+
+  CtxMapMgr sharded_mgr;
+  init_mgr(sharded_mgr, partition, "8");
+  EXPECT_EQ(CtxMapMgr::SHARD_COUNT, sharded_mgr.shard_count_);
+  for (int64_t i = 0; i < sharded_mgr.shard_count_; ++i) {
+    for (int64_t j = i + 1; j < sharded_mgr.shard_count_; ++j) {
+      EXPECT_NE(sharded_mgr.ctx_maps_[i], sharded_mgr.ctx_maps_[j]);
+    }
+  }
+
+  // a map is never taken twice, even if there are fewer maps than shards
+  CtxMapMgr small_mgr;
+  ASSERT_EQ(OB_SUCCESS, small_mgr.init(partition, ctx_maps_, 2));
+  EXPECT_EQ(2, small_mgr.shard_count_);
+  EXPECT_NE(small_mgr.ctx_maps_[0], small_mgr.ctx_maps_[1]);
+}
+
+TEST_F(TestObTransCtxMapMgr, foreach_across_shards)
+{
+  const int64_t CTX_COUNT = 256;
+  ObPartitionKey partition(1100611139453777, 1, 1);
+  ObPartitionKey other_partition(1100611139453777, 2, 1);
+  CtxMapMgr mgr;
+  CtxMapMgr other_mgr;
+  init_mgr(mgr, partition, "8");
+  init_mgr(other_mgr, other_partition, "8");
+  ObTransID trans_ids[CTX_COUNT];
+  insert_ctxs(mgr, CTX_COUNT, trans_ids);
+  insert_ctxs(other_mgr, CTX_COUNT / 2);
+
+  // every shard holds some of the contexts, and each of them is visited exactly once
+  for (int64_t i = 0; i < mgr.shard_count_; ++i) {
+    EXPECT_LT(0, mgr.ctx_maps_[i]->count());
+  }
+  EXPECT_EQ(CTX_COUNT, count_ctx(mgr));
+  EXPECT_EQ(CTX_COUNT / 2, count_ctx(other_mgr));
+
+  for (int64_t i = 0; i < CTX_COUNT; ++i) {
+    ObTransCtx* ctx = NULL;
+    ASSERT_EQ(OB_SUCCESS, mgr.get(trans_ids[i], ctx));
+    mgr.revert(ctx);
+    EXPECT_EQ(OB_ENTRY_NOT_EXIST, other_mgr.get(trans_ids[i], ctx));
+  }
+
+  // the callback array is reserved for all the contexts the maps may hold
+  ObEndTransCallbackArray cb_array;
+  CountCtxFunctor fn;
+  EXPECT_EQ(OB_SUCCESS, mgr.foreach_ctx(fn, &cb_array));
+  EXPECT_LE(CTX_COUNT + CTX_COUNT / 2, cb_array.get_capacity());
+
+  ASSERT_EQ(OB_SUCCESS, mgr.del(trans_ids[0]));
+  EXPECT_EQ(OB_ENTRY_NOT_EXIST, mgr.del(trans_ids[0]));
+  EXPECT_EQ(CTX_COUNT - 1, count_ctx(mgr));
+}
+
+TEST_F(TestObTransCtxMapMgr, foreach_stop_across_shards)
+{
+  const int64_t CTX_COUNT = 256;
+  ObPartitionKey partition(1100611139453777, 1, 1);
+  CtxMapMgr mgr;
+  init_mgr(mgr, partition, "8");
+  insert_ctxs(mgr, CTX_COUNT);
+
+  // the iteration stops at once, the later shards are not visited
+  CountCtxFunctor stop_at_first(1);
+  EXPECT_EQ(OB_EAGAIN, mgr.foreach_ctx(stop_at_first));
+  EXPECT_EQ(1, stop_at_first.count_);
+
+  // stop in a shard other than the first one
+  const int64_t stop_count = mgr.ctx_maps_[0]->count() + 1;
+  CountCtxFunctor stop_in_second(stop_count);
+  EXPECT_EQ(OB_EAGAIN, mgr.foreach_ctx(stop_in_second));
+  EXPECT_EQ(stop_count, stop_in_second.count_);
+}
+
+TEST_F(TestObTransCtxMapMgr, remove_if_across_shards)
+{
+  const int64_t CTX_COUNT = 256;
+  ObPartitionKey partition(1100611139453777, 1, 1);
+  ObPartitionKey other_partition(1100611139453777, 2, 1);
+  CtxMapMgr mgr;
+  CtxMapMgr other_mgr;
+  init_mgr(mgr, partition, "8");
+  init_mgr(other_mgr, other_partition, "8");
+  ObTransID trans_ids[CTX_COUNT];
+  insert_ctxs(mgr, CTX_COUNT, trans_ids);
+  insert_ctxs(other_mgr, CTX_COUNT);
+
+  int64_t odd_count = 0;
+  for (int64_t i = 0; i < CTX_COUNT; ++i) {
+    odd_count += trans_ids[i].get_inc_num() % 2;
+  }
+  RemoveOddCtxFunctor fn;
+  EXPECT_EQ(OB_SUCCESS, mgr.remove_if(fn));
+  EXPECT_EQ(odd_count, fn.count_);
+  EXPECT_EQ(CTX_COUNT - odd_count, count_ctx(mgr));
+  for (int64_t i = 0; i < CTX_COUNT; ++i) {
+    ObTransCtx* ctx = NULL;
+    if (1 == trans_ids[i].get_inc_num() % 2) {
+      EXPECT_EQ(OB_ENTRY_NOT_EXIST, mgr.get(trans_ids[i], ctx));
+    } else {
+      ASSERT_EQ(OB_SUCCESS, mgr.get(trans_ids[i], ctx));
+      mgr.revert(ctx);
+    }
+  }
+  // the contexts of the other partition in the same maps are untouched
+  EXPECT_EQ(CTX_COUNT, count_ctx(other_mgr));
+
+  mgr.reset();
+  EXPECT_EQ(CTX_COUNT, count_ctx(other_mgr));
+}
+
+// Not a correctness test: it prints the cost of a scan of a partition and the cost of the concurrent creation
+// and erasure of contexts of a hot partition, with the contexts on one map and spread over all shards.
+TEST_F(TestObTransCtxMapMgr, shard_cost)
+{
+  const int64_t HOT_CTX_COUNT = 20000;
+  const int64_t SCAN_COUNT = 100;
+  const int64_t THREAD_COUNT = 8;
+  const int64_t OP_COUNT = 20000;
+  const char* shard_counts[] = {"1", "8"};
+  for (int64_t s = 0; s < 2; ++s) {
+    ObPartitionKey hot_partition(1100611139453777, 1, 1);
+    ObPartitionKey cold_partition(1100611139453777, 2, 1);
+    CtxMapMgr hot_mgr;
+    CtxMapMgr cold_mgr;
+    init_mgr(hot_mgr, hot_partition, shard_counts[s]);
+    init_mgr(cold_mgr, cold_partition, shard_counts[s]);
+    insert_ctxs(hot_mgr, HOT_CTX_COUNT);
+    insert_ctxs(cold_mgr, 16);
+
+    int64_t start_ts = ObTimeUtility::current_time();
+    for (int64_t i = 0; i < SCAN_COUNT; ++i) {
+      EXPECT_EQ(16, count_ctx(cold_mgr));
+    }
+    const int64_t scan_us = (ObTimeUtility::current_time() - start_ts) / SCAN_COUNT;
+
+    start_ts = ObTimeUtility::current_time();
+    std::thread threads[THREAD_COUNT];
+    for (int64_t t = 0; t < THREAD_COUNT; ++t) {
+      threads[t] = std::thread([&]() {
+        for (int64_t i = 0; i < OP_COUNT; ++i) {
+          ObTransID trans_id(self_);
+          ObTransCtx* ctx = ObTransCtxFactory::alloc(ObTransCtxType::PARTICIPANT);
+          ASSERT_TRUE(NULL != ctx);
+          ASSERT_EQ(OB_SUCCESS, hot_mgr.insert_and_get(trans_id, ctx));
+          hot_mgr.revert(ctx);
+          ASSERT_EQ(OB_SUCCESS, hot_mgr.del(trans_id));
+        }
+      });
+    }
+    for (int64_t t = 0; t < THREAD_COUNT; ++t) {
+      threads[t].join();
+    }
+    const int64_t op_us = ObTimeUtility::current_time() - start_ts;
+    fprintf(stdout,
+        "shard_count=%s scan_cold_partition=%ldus insert_del_hot_partition=%ldus (%ld threads x %ld)\n",
+        shard_counts[s],
+        scan_us,
+        op_us,
+        THREAD_COUNT,
+        OP_COUNT);
+    hot_mgr.reset();
+    cold_mgr.reset();
+  }
+}
+
+}  // namespace unittest
+}  // namespace oceanbase
+
+using namespace oceanbase;
+using namespace oceanbase::common;
+
+int main(int argc, char** argv)
+{
+  int ret = 1;
+  ObLogger& logger = ObLogger::get_logger();
+  logger.set_file_name("test_ob_trans_ctx_map_mgr.log", true);
+  logger.set_log_level(OB_LOG_LEVEL_INFO);
+  testing::InitGoogleTest(&argc, argv);
+  ret = RUN_ALL_TESTS();
+  return ret;
+}